@@ -1,5 +1,8 @@
 #include <GxBase/CommandLine.hxx>
 #include <GxAssetsBase/AssetsPipeline/AssetProcessorFactory.hxx>
+#include <GxAssetsBase/AssetsPipeline/AssetBatch.hxx>
+#include <GxAssetsBase/AssetsPipeline/AssetDependencyDatabase.hxx>
+#include <GxAssetsBase/AssetsPipeline/DerivedDataCache.hxx>
 #include <GxBase/Modules.hxx>
 
 GX_DECLARE_LOG_CATEGORY(LogAssetsCompiler, Trace, Trace);
@@ -27,9 +30,616 @@ Graphyte::App::ApplicationDescriptor GraphyteApp{
 #include <GxBase/System/Process.hxx>
 #include <GxBase/System/Library.hxx>
 #include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/FileWatcher.hxx>
+#include <GxBase/Storage/PackageWriter.hxx>
+#include <GxBase/Converter.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/String.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Stopwatch.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Threading/TaskDispatcher.hxx>
 
 #include <GxBase/Diagnostics.hxx>
 
+namespace
+{
+    class PackageContentVisitor final : public Graphyte::Storage::IDirectoryVisitor
+    {
+    public:
+        std::vector<std::string> Files;
+
+    public:
+        virtual Graphyte::Status Visit(
+            std::string_view path,
+            bool is_directory) noexcept override
+        {
+            if (!is_directory)
+            {
+                Files.emplace_back(path);
+            }
+
+            return Graphyte::Status::Success;
+        }
+    };
+
+    std::optional<Graphyte::Compression::CompressionMethod> ParseCompressionMethod(
+        std::string_view value,
+        bool& valid) noexcept
+    {
+        using Graphyte::Compression::CompressionMethod;
+
+        valid = true;
+
+        std::optional<CompressionMethod> method{};
+
+        if (value.empty() || value == "lz4")
+        {
+            method = CompressionMethod::LZ4;
+        }
+        else if (value == "lz4hc")
+        {
+            method = CompressionMethod::LZ4HC;
+        }
+        else if (value == "zlib")
+        {
+            method = CompressionMethod::ZLib;
+        }
+        else if (value == "zstd")
+        {
+            method = CompressionMethod::Zstd;
+        }
+        else if (value != "none")
+        {
+            valid = false;
+        }
+
+        //
+        // Methods compiled out of this build would store every entry uncompressed.
+        //
+
+        if (method.has_value() && !Graphyte::Compression::IsSupported(*method))
+        {
+            valid = false;
+            return std::nullopt;
+        }
+
+        return method;
+    }
+
+    //
+    // Packs all files from directory into single package file.
+    //
+    //  --pack <directory> --output <file> [--compression lz4|lz4hc|zlib|zstd|none]
+    //  [--alignment <bytes>]
+    //
+
+    bool PackContent(
+        std::string_view source,
+        std::string_view output) noexcept
+    {
+        using namespace Graphyte;
+
+        bool valid{};
+        auto const method = ParseCompressionMethod(CommandLine::Get("--compression").value_or(std::string_view{}), valid);
+
+        if (!valid)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Unknown or unsupported compression method `{}`\n", CommandLine::Get("--compression").value_or(std::string_view{}));
+            return false;
+        }
+
+        Storage::PackageWriterOptions options{};
+
+        if (auto const alignment = CommandLine::Get("--alignment"); alignment.has_value())
+        {
+            uint32_t value{};
+
+            if (!Converter<uint32_t>::FromString(value, alignment.value()) || !std::has_single_bit(value))
+            {
+                GX_LOG_ERROR(LogAssetsCompiler, "Alignment must be power of two\n");
+                return false;
+            }
+
+            options.Alignment = value;
+        }
+
+        std::string root = Storage::NormalizedPath(source);
+        Storage::RemoveDirectorySeparator(root);
+
+        PackageContentVisitor visitor{};
+
+        if (Storage::IFileSystem::GetPlatformNative().EnumerateRecursive(root, visitor) != Status::Success)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Failed to enumerate `{}`\n", root);
+            return false;
+        }
+
+        //
+        // Sorted input makes package content independent of directory enumeration order.
+        //
+
+        std::sort(visitor.Files.begin(), visitor.Files.end());
+
+        std::unique_ptr<Storage::PackageWriter> writer{};
+
+        if (Storage::PackageWriter::Create(writer, output, options) != Status::Success)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Failed to create package `{}`\n", output);
+            return false;
+        }
+
+        for (std::string const& file : visitor.Files)
+        {
+            std::string_view const path = std::string_view{ file }.substr(root.size() + 1);
+
+            if (Status const status = writer->AddFile(path, file, method); status != Status::Success)
+            {
+                GX_LOG_ERROR(LogAssetsCompiler, "Failed to add `{}` to package: {}\n", path, status);
+                return false;
+            }
+        }
+
+        if (writer->Finish() != Status::Success)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Failed to write package `{}`\n", output);
+            return false;
+        }
+
+        GX_LOG_INFO(LogAssetsCompiler, "Packed {} files into `{}` ({} bytes)\n", writer->GetEntryCount(), output, writer->GetSize());
+        return true;
+    }
+
+    //
+    // Configures derived data cache used by processors.
+    //
+    //  [--ddc <directory>] [--ddc-size <MiB>] [--ddc-shared <directory>] [--no-ddc]
+    //
+
+    constexpr const uint64_t DefaultDerivedDataCacheSize = 10240;
+
+    bool ConfigureDerivedDataCache() noexcept
+    {
+        using namespace Graphyte;
+        using namespace Graphyte::AssetsPipeline;
+
+        if (CommandLine::Get("--no-ddc").has_value())
+        {
+            return true;
+        }
+
+        uint64_t size = DefaultDerivedDataCacheSize;
+
+        if (auto const value = CommandLine::Get("--ddc-size"); value.has_value())
+        {
+            if (!Converter<uint64_t>::FromString(size, value.value()))
+            {
+                GX_LOG_ERROR(LogAssetsCompiler, "Invalid derived data cache size\n");
+                return false;
+            }
+        }
+
+        std::string local = Storage::CombinePath(Storage::GetProjectIntermediateDirectory(), "DerivedDataCache");
+
+        if (auto const value = CommandLine::Get("--ddc"); value.has_value() && !value->empty())
+        {
+            local = value.value();
+        }
+
+        DerivedDataCache& cache = DerivedDataCache::Get();
+        cache.SetLocalStore(std::make_unique<DirectoryDerivedDataStore>(local, size << 20));
+
+        if (auto const value = CommandLine::Get("--ddc-shared"); value.has_value() && !value->empty())
+        {
+            //
+            // Shared store is not evicted locally, because other compilers may use it concurrently.
+            //
+
+            cache.SetSharedStore(std::make_unique<DirectoryDerivedDataStore>(value.value(), 0));
+        }
+
+        return true;
+    }
+
+    void ShutdownDerivedDataCache() noexcept
+    {
+        using namespace Graphyte::AssetsPipeline;
+
+        DerivedDataCache& cache = DerivedDataCache::Get();
+
+        if (cache.IsEnabled())
+        {
+            DerivedDataStatistics const stats = cache.GetStatistics();
+
+            GX_LOG_INFO(LogAssetsCompiler,
+                "Derived data cache: {} local hits, {} shared hits, {} misses, {} bytes read, {} bytes written\n",
+                stats.LocalHits,
+                stats.SharedHits,
+                stats.Misses,
+                stats.BytesRead,
+                stats.BytesWritten);
+        }
+
+        //
+        // Stores persist their state when released.
+        //
+
+        cache.SetLocalStore(nullptr);
+        cache.SetSharedStore(nullptr);
+    }
+
+    void PrintBatchReport(
+        std::vector<Graphyte::AssetsPipeline::AssetBatchRecord> const& records,
+        double elapsed) noexcept
+    {
+        using Graphyte::AssetsPipeline::AssetBatchRecord;
+        using Graphyte::AssetsPipeline::AssetBatchResult;
+
+        //
+        // Slowest assets are reported first, as they bound duration of rebuild.
+        //
+
+        std::vector<AssetBatchRecord const*> sorted{};
+        sorted.reserve(records.size());
+
+        for (AssetBatchRecord const& record : records)
+        {
+            sorted.push_back(&record);
+        }
+
+        std::sort(sorted.begin(), sorted.end(), [](AssetBatchRecord const* lhs, AssetBatchRecord const* rhs) {
+            return lhs->ProcessTime > rhs->ProcessTime;
+        });
+
+        size_t succeeded{};
+        size_t failed{};
+        size_t skipped{};
+        size_t unchanged{};
+        double total{};
+
+        fmt::print("{:>10} {:>10}  {:<8} {:<12} {}\n", "time [ms]", "wait [ms]", "result", "processor", "asset");
+
+        for (AssetBatchRecord const* record : sorted)
+        {
+            std::string_view result{};
+
+            switch (record->Result)
+            {
+                case AssetBatchResult::UpToDate:
+                    ++unchanged;
+                    continue;
+
+                case AssetBatchResult::Succeeded:
+                    result = "ok";
+                    ++succeeded;
+                    break;
+
+                case AssetBatchResult::Failed:
+                    result = "failed";
+                    ++failed;
+                    break;
+
+                case AssetBatchResult::Skipped:
+                    result = "skipped";
+                    ++skipped;
+                    break;
+            }
+
+            total += record->ProcessTime;
+
+            fmt::print("{:>10.2f} {:>10.2f}  {:<8} {:<12} {}\n",
+                record->ProcessTime * 1000.0,
+                record->WaitTime * 1000.0,
+                result,
+                record->Processor,
+                record->Name);
+
+            if (record->Result != AssetBatchResult::Succeeded)
+            {
+                for (std::string const& line : record->Log)
+                {
+                    fmt::print("{:>35}{}\n", "", line);
+                }
+            }
+        }
+
+        fmt::print("{} assets: {} succeeded, {} failed, {} skipped, {} up to date\n", records.size(), succeeded, failed, skipped, unchanged);
+        fmt::print("Elapsed {:.3f} s, processing {:.3f} s, speedup {:.2f}x\n",
+            elapsed,
+            total,
+            (elapsed > 0.0) ? (total / elapsed) : 0.0);
+    }
+
+    bool LoadBatch(
+        Graphyte::AssetsPipeline::AssetBatchBuilder& builder,
+        std::string_view manifest) noexcept
+    {
+        using namespace Graphyte;
+        using namespace Graphyte::AssetsPipeline;
+
+        std::string content{};
+
+        if (Storage::ReadText(content, std::string{ manifest }) != Status::Success)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Cannot read manifest `{}`\n", manifest);
+            return false;
+        }
+
+        std::vector<AssetBatchItem> items{};
+
+        if (ParseAssetBatchManifest(items, content, Storage::GetPath(manifest)) != Status::Success)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Invalid manifest `{}`\n", manifest);
+            return false;
+        }
+
+        if (builder.SetItems(std::move(items)) != Status::Success)
+        {
+            GX_LOG_ERROR(LogAssetsCompiler, "Invalid dependencies in manifest `{}`\n", manifest);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RunBatch(
+        Graphyte::AssetsPipeline::AssetBatchBuilder& builder,
+        Graphyte::AssetsPipeline::AssetDependencyDatabase& database,
+        std::string_view database_path,
+        uint64_t budget) noexcept
+    {
+        using namespace Graphyte;
+        using namespace Graphyte::AssetsPipeline;
+
+        std::vector<AssetBatchRecord> records{};
+
+        Diagnostics::Stopwatch watch{};
+        watch.Restart();
+        Status const status = builder.Build(Threading::TaskDispatcher::GetInstance(), budget, records, &database);
+        watch.Stop();
+
+        PrintBatchReport(records, watch.GetElapsedTime<double>());
+
+        if (database.Save(database_path) != Status::Success)
+        {
+            GX_LOG_WARN(LogAssetsCompiler, "Cannot save dependency database `{}`\n", database_path);
+        }
+
+        return status == Status::Success;
+    }
+
+    //
+    // Changes are collected until none arrives within this interval, in milliseconds, because
+    // editors often save files in several steps.
+    //
+
+    constexpr const uint32_t WatchDebounceInterval = 10;
+
+    //
+    // Resolves path against current directory and removes `.` and `..` components, so paths
+    // reported by file watcher can be compared with paths given on command line.
+    //
+
+    std::string GetWatchedPath(
+        std::string_view path) noexcept
+    {
+        using namespace Graphyte;
+
+        std::string normalized = Storage::NormalizedPath(path);
+
+        bool const absolute = Storage::IsAbsolutePath(normalized) || (normalized.size() >= 2 && normalized[1] == ':');
+
+        if (std::string current{}; !absolute && System::GetCurrentDirectory(current) == Status::Success)
+        {
+            normalized = Storage::CombinePath(Storage::NormalizedPath(current), normalized);
+        }
+
+        std::vector<std::string_view> parts{};
+
+        for (std::string_view const part : Split(normalized, Storage::DirectorySeparator, false))
+        {
+            if (part == "." || (part.empty() && !parts.empty()))
+            {
+                continue;
+            }
+
+            if (part == ".." && parts.size() > 1)
+            {
+                parts.pop_back();
+                continue;
+            }
+
+            parts.push_back(part);
+        }
+
+        return Join(parts, std::string_view{ &Storage::DirectorySeparator, 1 });
+    }
+
+    //
+    // Rebuilds assets affected by changes of watched files, until process is terminated.
+    //
+
+    bool WatchBatch(
+        Graphyte::AssetsPipeline::AssetBatchBuilder& builder,
+        Graphyte::AssetsPipeline::AssetDependencyDatabase& database,
+        std::string_view database_path,
+        std::string_view manifest,
+        uint64_t budget) noexcept
+    {
+        using namespace Graphyte;
+        using namespace Graphyte::AssetsPipeline;
+
+        Storage::FileWatcher watcher{};
+
+        auto const watch_inputs = [&]() {
+            std::vector<std::string> directories{};
+            database.GetInputDirectories(directories);
+
+            //
+            // Sources of assets which failed are not in database, but are watched too.
+            //
+
+            for (AssetBatchItem const& item : builder.GetItems())
+            {
+                directories.emplace_back(Storage::GetPath(item.Request.SourcePath));
+            }
+
+            directories.emplace_back(Storage::GetPath(manifest));
+
+            for (std::string const& directory : directories)
+            {
+                if (Status const status = watcher.Add(directory.empty() ? "." : directory); status != Status::Success)
+                {
+                    GX_LOG_WARN(LogAssetsCompiler, "Cannot watch `{}`: {}\n", directory, status);
+                }
+            }
+        };
+
+        watch_inputs();
+
+        std::string const manifest_path = GetWatchedPath(manifest);
+
+        GX_LOG_INFO(LogAssetsCompiler, "Watching for changes using {} backend\n", watcher.GetBackendName());
+
+        std::vector<Storage::FileChange> changes{};
+        std::vector<Storage::FileChange> pending{};
+
+        for (;;)
+        {
+            Status status = watcher.Wait(changes, UINT32_MAX);
+
+            while (status == Status::Success)
+            {
+                std::move(changes.begin(), changes.end(), std::back_inserter(pending));
+                status = watcher.Wait(changes, WatchDebounceInterval);
+            }
+
+            if (status != Status::Timeout)
+            {
+                if (status == Status::Cancelled)
+                {
+                    return true;
+                }
+
+                GX_LOG_ERROR(LogAssetsCompiler, "Cannot watch for changes: {}\n", status);
+                return false;
+            }
+
+            bool reload = false;
+
+            for (Storage::FileChange const& change : pending)
+            {
+                //
+                // Lost changes are recovered by comparing modification times of all inputs.
+                //
+
+                if (change.Type == Storage::FileChangeType::Overflow)
+                {
+                    continue;
+                }
+
+                if (GetWatchedPath(change.Path) == manifest_path)
+                {
+                    reload = true;
+                }
+
+                database.Invalidate(change.Path);
+            }
+
+            pending.clear();
+
+            if (reload && !LoadBatch(builder, manifest))
+            {
+                continue;
+            }
+
+            [[maybe_unused]] bool const succeeded = RunBatch(builder, database, database_path, budget);
+
+            watch_inputs();
+        }
+    }
+
+    //
+    // Builds assets from manifest, running independent processors concurrently. Only assets changed
+    // since last build are built, unless full build is requested.
+    //
+    //  --batch <manifest> [--memory-budget <MiB>] [--full] [--watch]
+    //
+
+    bool BuildBatch(
+        std::string_view manifest) noexcept
+    {
+        using namespace Graphyte;
+        using namespace Graphyte::AssetsPipeline;
+
+        //
+        // Processors are not expected to use more than half of physical memory by default.
+        //
+
+        uint64_t budget = System::GetMemoryProperties().TotalPhysical / 2;
+
+        if (auto const value = CommandLine::Get("--memory-budget"); value.has_value())
+        {
+            if (!Converter<uint64_t>::FromString(budget, value.value()))
+            {
+                GX_LOG_ERROR(LogAssetsCompiler, "Invalid memory budget\n");
+                return false;
+            }
+
+            budget <<= 20;
+        }
+
+        AssetBatchBuilder builder{};
+
+        if (!LoadBatch(builder, manifest))
+        {
+            return false;
+        }
+
+        if (!ConfigureDerivedDataCache())
+        {
+            return false;
+        }
+
+        //
+        // Each manifest has its own dependency database.
+        //
+
+        std::string const normalized = Storage::NormalizedPath(manifest);
+
+        std::string const database_path = Storage::CombinePath(
+            Storage::GetProjectIntermediateDirectory(),
+            "AssetDependencies",
+            fmt::format("{:016x}.deps", Hash::XXHash64::Hash(normalized.data(), normalized.size(), 0)));
+
+        AssetDependencyDatabase database{};
+
+        if (!CommandLine::Get("--full").has_value())
+        {
+            if (Status const status = database.Load(database_path); status != Status::Success && status != Status::NotFound)
+            {
+                GX_LOG_WARN(LogAssetsCompiler, "Cannot load dependency database `{}`, building all assets\n", database_path);
+            }
+        }
+
+        GX_LOG_INFO(LogAssetsCompiler, "Building {} assets on {} workers, memory budget {} MiB\n",
+            builder.GetSize(),
+            Threading::TaskDispatcher::GetInstance().GetWorkerCount(),
+            budget >> 20);
+
+        bool succeeded = RunBatch(builder, database, database_path, budget);
+
+        if (CommandLine::Get("--watch").has_value())
+        {
+            succeeded = WatchBatch(builder, database, database_path, manifest, budget);
+        }
+
+        ShutdownDerivedDataCache();
+
+        return succeeded;
+    }
+}
+
 int GraphyteMain([[maybe_unused]] int argc, [[maybe_unused]] char** argv) noexcept
 {
     using namespace Graphyte;
@@ -43,6 +653,34 @@ int GraphyteMain([[maybe_unused]] int argc, [[maybe_unused]] char** argv) noexce
     {
         fmt::print("This is assets compiler\n");
     }
+    else if (auto pack = Graphyte::CommandLine::Get("--pack"); pack.has_value())
+    {
+        auto const output = Graphyte::CommandLine::Get("--output");
+
+        if (!output.has_value() || output->empty() || pack->empty())
+        {
+            fmt::print("Usage: --pack <directory> --output <file> [--compression lz4|lz4hc|zlib|zstd|none] [--alignment <bytes>]\n");
+            return 1;
+        }
+
+        if (!PackContent(pack.value(), output.value()))
+        {
+            return 1;
+        }
+    }
+    else if (auto batch = Graphyte::CommandLine::Get("--batch"); batch.has_value())
+    {
+        if (batch->empty())
+        {
+            fmt::print("Usage: --batch <manifest> [--memory-budget <MiB>] [--full] [--watch]\n");
+            return 1;
+        }
+
+        if (!BuildBatch(batch.value()))
+        {
+            return 1;
+        }
+    }
     else if (auto processor = Graphyte::CommandLine::Get("--processor"); processor.has_value())
     {
         std::string_view value = processor.value();
@@ -62,10 +700,17 @@ int GraphyteMain([[maybe_unused]] int argc, [[maybe_unused]] char** argv) noexce
             auto instance = AssetsPipeline::AssetProcessorFactory::Get().ActivateInstance(value);
             if (instance != nullptr)
             {
+                if (!ConfigureDerivedDataCache())
+                {
+                    return 1;
+                }
+
                 if (!instance->Process())
                 {
                     fmt::print("Processor failed\n");
                 }
+
+                ShutdownDerivedDataCache();
             }
             else
             {
@@ -75,7 +720,7 @@ int GraphyteMain([[maybe_unused]] int argc, [[maybe_unused]] char** argv) noexce
     }
     else
     {
-        fmt::print("Accepted params are --help or --processor\n");
+        fmt::print("Accepted params are --help, --pack, --batch or --processor\n");
     }
 
     return 0;
@@ -0,0 +1,21 @@
+using Neobyte.Build.Framework;
+
+namespace Graphyte
+{
+    [ModuleRules]
+    public class DevLogDecode
+        : ModuleRules
+    {
+        public DevLogDecode(TargetRules target)
+            : base(target)
+        {
+            this.Type = ModuleType.Application;
+            this.Kind = ModuleKind.Developer;
+            this.Language = ModuleLanguage.CPlusPlus;
+
+            this.PrivateDependencies.AddRange(new[] {
+                typeof(GxLaunch),
+            });
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/CommandLine.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+
+GX_DECLARE_LOG_CATEGORY(LogDecodeTool, Trace, Trace);
+GX_DEFINE_LOG_CATEGORY(LogDecodeTool);
+
+#include <GxBase/App.hxx>
+
+Graphyte::App::ApplicationDescriptor GraphyteApp{
+    .Name       = "Graphyte Log Decoder",
+    .Id         = "log.decode",
+    .Company    = "Graphyte",
+    .Type       = Graphyte::App::ApplicationType::ConsoleTool,
+    .AppVersion = Graphyte::Version{ 1, 0, 0, 0 },
+};
+
+#include <GxLaunch/Main.hxx>
+
+int GraphyteMain([[maybe_unused]] int argc, [[maybe_unused]] char** argv) noexcept
+{
+    using namespace Graphyte;
+
+    auto const input = CommandLine::Get("--input");
+
+    if (!input.has_value() || CommandLine::Get("--help").has_value())
+    {
+        fmt::print("Usage: --input=<file.gxlog> [--output=<file.log>] [--timestamps]\n");
+        return 1;
+    }
+
+    std::vector<std::byte> content{};
+
+    if (Status const status = Storage::ReadBinary(content, input.value()); status != Status::Success)
+    {
+        GX_LOG_ERROR(LogDecodeTool, "Cannot read `{}`: {}\n", input.value(), status);
+        return 1;
+    }
+
+    std::string output{};
+
+    Status const decoded = Diagnostics::DecodeBinaryLog(output, content, CommandLine::Get("--timestamps").has_value());
+
+    if (decoded == Status::EndOfStream)
+    {
+        GX_LOG_WARN(LogDecodeTool, "Log `{}` is truncated\n", input.value());
+    }
+    else if (decoded != Status::Success)
+    {
+        GX_LOG_ERROR(LogDecodeTool, "Cannot decode `{}`: {}\n", input.value(), decoded);
+        return 1;
+    }
+
+    if (auto const path = CommandLine::Get("--output"); path.has_value())
+    {
+        if (Status const status = Storage::WriteText(output, path.value()); status != Status::Success)
+        {
+            GX_LOG_ERROR(LogDecodeTool, "Cannot write `{}`: {}\n", path.value(), status);
+            return 1;
+        }
+    }
+    else
+    {
+        fmt::print("{}", output);
+    }
+
+    return 0;
+}
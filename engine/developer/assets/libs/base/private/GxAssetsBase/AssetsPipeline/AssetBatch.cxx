@@ -0,0 +1,608 @@
+#include <GxAssetsBase/AssetsPipeline/AssetBatch.hxx>
+#include <GxAssetsBase/AssetsPipeline/AssetDependencyDatabase.hxx>
+#include <GxAssetsBase/AssetsPipeline/AssetProcessorFactory.hxx>
+#include <GxBase/Converter.hxx>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Stopwatch.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/String.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Threading/TaskGraph.hxx>
+
+GX_DECLARE_LOG_CATEGORY(LogAssetBatch, Trace, Trace);
+GX_DEFINE_LOG_CATEGORY(LogAssetBatch);
+
+namespace Graphyte::AssetsPipeline::Impl
+{
+    //
+    // Processors of unknown memory usage are assumed to need few times size of their source.
+    //
+
+    constexpr const uint64_t AssetBatchMemoryEstimateFactor = 4;
+
+    //
+    // Tracks memory used by running processors. Request exceeding whole budget is admitted when
+    // nothing else runs. Not thread safe, guarded by lock of scheduler.
+    //
+
+    class AssetBatchMemoryBudget final
+    {
+    private:
+        uint64_t m_Budget;
+        uint64_t m_Used;
+
+    public:
+        explicit AssetBatchMemoryBudget(
+            uint64_t budget) noexcept
+            : m_Budget{ budget }
+            , m_Used{ 0 }
+        {
+        }
+
+    public:
+        [[nodiscard]] bool TryAcquire(
+            uint64_t size) noexcept
+        {
+            if (m_Budget == 0)
+            {
+                return true;
+            }
+
+            if (m_Used != 0 && (m_Used + size) > m_Budget)
+            {
+                return false;
+            }
+
+            m_Used += size;
+            return true;
+        }
+
+        void Release(
+            uint64_t size) noexcept
+        {
+            if (m_Budget == 0)
+            {
+                return;
+            }
+
+            GX_ASSERT(m_Used >= size);
+            m_Used -= size;
+        }
+    };
+
+    //
+    // Dispatches items once all their dependencies completed and their memory estimate fits in
+    // budget. Ready items wait in queue instead of blocking worker threads, so tasks of batch never
+    // block and nested waits of processors may safely execute them.
+    //
+
+    class AssetBatchScheduler final
+    {
+    private:
+        Threading::TaskDispatcher& m_Dispatcher;
+        std::span<const AssetBatchItem> m_Items;
+        std::span<const std::vector<uint32_t>> m_Dependencies;
+        std::span<const uint8_t> m_Dirty;
+        std::span<AssetBatchRecord> m_Records;
+
+        Threading::CriticalSection m_Lock;
+        AssetBatchMemoryBudget m_Budget;
+        std::vector<uint64_t> m_Memory;
+        std::vector<std::vector<uint32_t>> m_Successors;
+        std::vector<uint32_t> m_Pending;
+        std::vector<Diagnostics::Stopwatch> m_Waiting;
+        std::deque<uint32_t> m_Queue;
+        std::vector<uint32_t> m_Resolved;
+        size_t m_Remaining;
+        Threading::TaskHandle m_Completion;
+
+    public:
+        AssetBatchScheduler(
+            Threading::TaskDispatcher& dispatcher,
+            std::span<const AssetBatchItem> items,
+            std::span<const std::vector<uint32_t>> dependencies,
+            std::span<const uint8_t> dirty,
+            std::span<AssetBatchRecord> records,
+            uint64_t memory_budget) noexcept
+            : m_Dispatcher{ dispatcher }
+            , m_Items{ items }
+            , m_Dependencies{ dependencies }
+            , m_Dirty{ dirty }
+            , m_Records{ records }
+            , m_Lock{}
+            , m_Budget{ memory_budget }
+            , m_Memory(items.size())
+            , m_Successors(items.size())
+            , m_Pending(items.size())
+            , m_Waiting(items.size())
+            , m_Queue{}
+            , m_Resolved{}
+            , m_Remaining{ items.size() }
+            , m_Completion{}
+        {
+            for (size_t i = 0; i < m_Items.size(); ++i)
+            {
+                m_Pending[i] = static_cast<uint32_t>(m_Dependencies[i].size());
+
+                for (uint32_t const dependency : m_Dependencies[i])
+                {
+                    m_Successors[dependency].push_back(static_cast<uint32_t>(i));
+                }
+
+                uint64_t memory = m_Items[i].MemoryEstimate;
+
+                if (int64_t size{}; memory == 0 && Storage::IFileSystem::GetPlatformNative().GetFileSize(size, m_Items[i].Request.SourcePath) == Status::Success)
+                {
+                    memory = static_cast<uint64_t>(size) * AssetBatchMemoryEstimateFactor;
+                }
+
+                m_Memory[i] = memory;
+            }
+        }
+
+    public:
+        void Run() noexcept
+        {
+            m_Completion = Threading::TaskHandle{ Threading::BaseTask::Create<Threading::Impl::TaskState>(m_Dispatcher) };
+
+            bool completed{};
+
+            {
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+                //
+                // Pending counters change while items are resolved in place, so roots are
+                // identified by their dependencies.
+                //
+
+                for (uint32_t i = 0; i < m_Items.size(); ++i)
+                {
+                    if (m_Dependencies[i].empty() && !Enqueue(i))
+                    {
+                        Complete(i);
+                    }
+                }
+
+                Admit();
+
+                completed = (m_Remaining == 0);
+            }
+
+            if (completed)
+            {
+                m_Completion.GetState()->ResolveDependency();
+            }
+
+            //
+            // Waiting thread helps executing tasks, batch items included.
+            //
+
+            m_Completion.Wait();
+        }
+
+    private:
+        void Execute(
+            uint32_t index) noexcept
+        {
+            AssetBatchItem const& item = m_Items[index];
+            AssetBatchRecord& record   = m_Records[index];
+
+            Diagnostics::Stopwatch watch{};
+            watch.Restart();
+
+            bool succeeded = false;
+
+            if (auto processor = AssetProcessorFactory::Get().ActivateInstance(item.Processor); processor != nullptr)
+            {
+                AssetProcessorResponse response{};
+                succeeded           = processor->Process(item.Request, response);
+                record.Log          = std::move(response.Log);
+                record.Dependencies = std::move(response.Dependencies);
+                record.Outputs      = std::move(response.Outputs);
+            }
+            else
+            {
+                record.Log.push_back(fmt::format("Unknown processor `{}`", item.Processor));
+            }
+
+            watch.Stop();
+
+            record.ProcessTime = watch.GetElapsedTime<double>();
+            record.Result      = succeeded ? AssetBatchResult::Succeeded : AssetBatchResult::Failed;
+
+            bool completed{};
+
+            {
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+                m_Budget.Release(m_Memory[index]);
+                Complete(index);
+                Admit();
+
+                completed = (m_Remaining == 0);
+            }
+
+            //
+            // Scheduler may be destroyed as soon as completion task executes.
+            //
+
+            if (completed)
+            {
+                m_Completion.GetState()->ResolveDependency();
+            }
+        }
+
+        // Must be called with lock held. Returns false when item is resolved without processor.
+        bool Enqueue(
+            uint32_t index) noexcept
+        {
+            AssetBatchRecord& record = m_Records[index];
+
+            if (m_Dirty[index] == 0)
+            {
+                record.Result = AssetBatchResult::UpToDate;
+                return false;
+            }
+
+            for (uint32_t const dependency : m_Dependencies[index])
+            {
+                AssetBatchResult const result = m_Records[dependency].Result;
+
+                if (result != AssetBatchResult::Succeeded && result != AssetBatchResult::UpToDate)
+                {
+                    record.Log.push_back(fmt::format("Dependency `{}` was not built", m_Items[dependency].Name));
+                    return false;
+                }
+            }
+
+            m_Waiting[index].Restart();
+            m_Queue.push_back(index);
+            return true;
+        }
+
+        // Must be called with lock held.
+        void Complete(
+            uint32_t index) noexcept
+        {
+            //
+            // Items resolved without processor complete their successors in place. Explicit stack
+            // keeps long chains of up to date items from recursing.
+            //
+
+            m_Resolved.push_back(index);
+
+            while (!m_Resolved.empty())
+            {
+                uint32_t const current = m_Resolved.back();
+                m_Resolved.pop_back();
+
+                GX_ASSERT(m_Remaining != 0);
+                --m_Remaining;
+
+                for (uint32_t const successor : m_Successors[current])
+                {
+                    if (--m_Pending[successor] == 0 && !Enqueue(successor))
+                    {
+                        m_Resolved.push_back(successor);
+                    }
+                }
+            }
+        }
+
+        // Must be called with lock held.
+        void Admit() noexcept
+        {
+            //
+            // Items are admitted in order they became ready, so large items are not starved by
+            // smaller ones.
+            //
+
+            while (!m_Queue.empty() && m_Budget.TryAcquire(m_Memory[m_Queue.front()]))
+            {
+                uint32_t const index = m_Queue.front();
+                m_Queue.pop_front();
+
+                m_Waiting[index].Stop();
+                m_Records[index].WaitTime = m_Waiting[index].GetElapsedTime<double>();
+
+                m_Dispatcher.Dispatch([this, index]() {
+                    Execute(index);
+                });
+            }
+        }
+    };
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    Status ParseAssetBatchManifest(
+        std::vector<AssetBatchItem>& result,
+        std::string_view content,
+        std::string_view base_directory) noexcept
+    {
+        result.clear();
+
+        size_t line_number = 0;
+
+        for (std::string_view line : Split(content, '\n', false))
+        {
+            ++line_number;
+
+            line = Trim(line);
+
+            if (line.empty() || line.starts_with('#') || line.starts_with(';'))
+            {
+                continue;
+            }
+
+            if (line.starts_with('['))
+            {
+                std::string_view const name = line.ends_with(']')
+                                                  ? Trim(line.substr(1, line.size() - 2))
+                                                  : std::string_view{};
+
+                if (name.empty())
+                {
+                    GX_LOG_ERROR(LogAssetBatch, "Manifest line {}: invalid section\n", line_number);
+                    return Status::InvalidFormat;
+                }
+
+                AssetBatchItem& item = result.emplace_back();
+                item.Name            = name;
+                item.MemoryEstimate  = 0;
+                continue;
+            }
+
+            size_t const separator = line.find('=');
+
+            if (separator == std::string_view::npos || result.empty())
+            {
+                GX_LOG_ERROR(LogAssetBatch, "Manifest line {}: expected `key = value` inside section\n", line_number);
+                return Status::InvalidFormat;
+            }
+
+            std::string_view const key   = Trim(line.substr(0, separator));
+            std::string_view const value = Trim(line.substr(separator + 1));
+
+            AssetBatchItem& item = result.back();
+
+            if (key == "processor")
+            {
+                item.Processor = value;
+            }
+            else if (key == "source")
+            {
+                item.Request.SourcePath = (base_directory.empty() || Storage::IsAbsolutePath(value))
+                                              ? std::string{ value }
+                                              : Storage::CombinePath(base_directory, value);
+            }
+            else if (key == "output")
+            {
+                item.Request.DestinationPath = value;
+            }
+            else if (key == "depends")
+            {
+                for (std::string_view dependency : Split(value, ','))
+                {
+                    dependency = Trim(dependency);
+
+                    if (!dependency.empty())
+                    {
+                        item.Dependencies.emplace_back(dependency);
+                    }
+                }
+            }
+            else if (key == "memory")
+            {
+                uint64_t size{};
+
+                if (!Converter<uint64_t>::FromString(size, value))
+                {
+                    GX_LOG_ERROR(LogAssetBatch, "Manifest line {}: invalid memory estimate `{}`\n", line_number, value);
+                    return Status::InvalidFormat;
+                }
+
+                item.MemoryEstimate = size << 20;
+            }
+            else
+            {
+                item.Request.Options.insert_or_assign(std::string{ key }, std::string{ value });
+            }
+        }
+
+        for (AssetBatchItem const& item : result)
+        {
+            if (item.Processor.empty())
+            {
+                GX_LOG_ERROR(LogAssetBatch, "Asset `{}` does not specify processor\n", item.Name);
+                return Status::InvalidFormat;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    AssetBatchBuilder::AssetBatchBuilder() noexcept
+        : m_Items{}
+        , m_Dependencies{}
+        , m_Order{}
+    {
+    }
+
+    AssetBatchBuilder::~AssetBatchBuilder() noexcept = default;
+
+    Status AssetBatchBuilder::SetItems(
+        std::vector<AssetBatchItem> items) noexcept
+    {
+        m_Items = std::move(items);
+        m_Dependencies.clear();
+        m_Dependencies.resize(m_Items.size());
+        m_Order.clear();
+
+        Status status = Status::Success;
+
+        std::unordered_map<std::string_view, uint32_t> names{};
+        names.reserve(m_Items.size());
+
+        for (size_t i = 0; i < m_Items.size(); ++i)
+        {
+            if (!names.emplace(m_Items[i].Name, static_cast<uint32_t>(i)).second)
+            {
+                GX_LOG_ERROR(LogAssetBatch, "Duplicate asset `{}`\n", m_Items[i].Name);
+                status = Status::InvalidArgument;
+            }
+        }
+
+        for (size_t i = 0; i < m_Items.size() && status == Status::Success; ++i)
+        {
+            for (std::string const& dependency : m_Items[i].Dependencies)
+            {
+                auto const it = names.find(dependency);
+
+                if (it == names.end())
+                {
+                    GX_LOG_ERROR(LogAssetBatch, "Asset `{}` depends on unknown asset `{}`\n", m_Items[i].Name, dependency);
+                    status = Status::NotFound;
+                    break;
+                }
+
+                m_Dependencies[i].push_back(it->second);
+            }
+        }
+
+        if (status == Status::Success)
+        {
+            //
+            // Task graph must not contain cycles, so dependencies are sorted topologically first.
+            // Order is kept to propagate dirty state of items.
+            //
+
+            std::vector<uint32_t> pending(m_Items.size());
+            std::vector<std::vector<uint32_t>> successors(m_Items.size());
+            std::vector<uint32_t> ready{};
+
+            for (size_t i = 0; i < m_Items.size(); ++i)
+            {
+                pending[i] = static_cast<uint32_t>(m_Dependencies[i].size());
+
+                for (uint32_t const dependency : m_Dependencies[i])
+                {
+                    successors[dependency].push_back(static_cast<uint32_t>(i));
+                }
+
+                if (pending[i] == 0)
+                {
+                    ready.push_back(static_cast<uint32_t>(i));
+                }
+            }
+
+            while (!ready.empty())
+            {
+                uint32_t const current = ready.back();
+                ready.pop_back();
+                m_Order.push_back(current);
+
+                for (uint32_t const successor : successors[current])
+                {
+                    if (--pending[successor] == 0)
+                    {
+                        ready.push_back(successor);
+                    }
+                }
+            }
+
+            if (m_Order.size() != m_Items.size())
+            {
+                for (size_t i = 0; i < m_Items.size(); ++i)
+                {
+                    if (pending[i] != 0)
+                    {
+                        GX_LOG_ERROR(LogAssetBatch, "Asset `{}` is part of dependency cycle\n", m_Items[i].Name);
+                    }
+                }
+
+                status = Status::InvalidArgument;
+            }
+        }
+
+        if (status != Status::Success)
+        {
+            m_Items.clear();
+            m_Dependencies.clear();
+            m_Order.clear();
+        }
+
+        return status;
+    }
+
+    Status AssetBatchBuilder::Build(
+        Threading::TaskDispatcher& dispatcher,
+        uint64_t memory_budget,
+        std::vector<AssetBatchRecord>& records,
+        AssetDependencyDatabase* database) noexcept
+    {
+        records.clear();
+        records.resize(m_Items.size());
+
+        //
+        // Item is dirty when it changed itself or any of its dependencies is dirty. Dependencies are
+        // visited first, so inputs of items depending on dirty ones are not hashed.
+        //
+
+        std::vector<uint8_t> dirty(m_Items.size(), 1);
+
+        if (database != nullptr)
+        {
+            database->Retain(m_Items);
+
+            for (uint32_t const i : m_Order)
+            {
+                bool const affected = std::any_of(m_Dependencies[i].begin(), m_Dependencies[i].end(), [&](uint32_t dependency) {
+                    return dirty[dependency] != 0;
+                });
+
+                dirty[i] = (affected || database->IsDirty(m_Items[i])) ? 1 : 0;
+            }
+        }
+
+        for (size_t i = 0; i < m_Items.size(); ++i)
+        {
+            records[i].Name        = m_Items[i].Name;
+            records[i].Processor   = m_Items[i].Processor;
+            records[i].Result      = AssetBatchResult::Skipped;
+            records[i].WaitTime    = 0.0;
+            records[i].ProcessTime = 0.0;
+        }
+
+        Impl::AssetBatchScheduler scheduler{ dispatcher, m_Items, m_Dependencies, dirty, records, memory_budget };
+        scheduler.Run();
+
+        if (database != nullptr)
+        {
+            for (size_t i = 0; i < m_Items.size(); ++i)
+            {
+                switch (records[i].Result)
+                {
+                    case AssetBatchResult::Succeeded:
+                        database->Update(m_Items[i], records[i]);
+                        break;
+
+                    case AssetBatchResult::Failed:
+                    case AssetBatchResult::Skipped:
+                        database->Remove(m_Items[i].Name);
+                        break;
+
+                    case AssetBatchResult::UpToDate:
+                        break;
+                }
+            }
+        }
+
+        bool const succeeded = std::all_of(records.begin(), records.end(), [](AssetBatchRecord const& record) {
+            return record.Result == AssetBatchResult::Succeeded || record.Result == AssetBatchResult::UpToDate;
+        });
+
+        return succeeded ? Status::Success : Status::Failure;
+    }
+}
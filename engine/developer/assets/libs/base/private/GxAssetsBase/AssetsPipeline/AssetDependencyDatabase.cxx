@@ -0,0 +1,419 @@
+#include <GxAssetsBase/AssetsPipeline/AssetDependencyDatabase.hxx>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/Storage/VersionedArchive.hxx>
+
+GX_DECLARE_LOG_CATEGORY(LogAssetDependencies, Trace, Trace);
+GX_DEFINE_LOG_CATEGORY(LogAssetDependencies);
+
+namespace Graphyte::AssetsPipeline::Impl
+{
+    constexpr const uint64_t AssetDependencyHashSeed = 0;
+
+    //
+    // Persisted form of database.
+    //
+
+    struct AssetDependencyInputEntry final
+    {
+        std::string Path;
+        uint64_t Hash;
+    };
+
+    struct AssetDependencyAssetEntry final
+    {
+        std::string Name;
+        uint64_t SettingsHash;
+        std::vector<AssetDependencyInputEntry> Inputs;
+        std::vector<std::string> Outputs;
+    };
+
+    struct AssetDependencyFileEntry final
+    {
+        std::string Path;
+        int64_t ModificationTime;
+        int64_t Size;
+        uint64_t Hash;
+    };
+
+    struct AssetDependencyDatabaseContent final
+    {
+        std::vector<AssetDependencyAssetEntry> Assets;
+        std::vector<AssetDependencyFileEntry> Files;
+    };
+
+    void Serialize(Storage::VersionedArchive& archive, AssetDependencyInputEntry& value) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, value.Path);
+        archive.Field(2, value.Hash);
+    }
+
+    void Serialize(Storage::VersionedArchive& archive, AssetDependencyAssetEntry& value) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, value.Name);
+        archive.Field(2, value.SettingsHash);
+        archive.Field(3, value.Inputs);
+        archive.Field(4, value.Outputs);
+    }
+
+    void Serialize(Storage::VersionedArchive& archive, AssetDependencyFileEntry& value) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, value.Path);
+        archive.Field(2, value.ModificationTime);
+        archive.Field(3, value.Size);
+        archive.Field(4, value.Hash);
+    }
+
+    void Serialize(Storage::VersionedArchive& archive, AssetDependencyDatabaseContent& value) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, value.Assets);
+        archive.Field(2, value.Files);
+    }
+
+    Status HashFile(
+        uint64_t& result,
+        std::string_view path) noexcept
+    {
+        std::unique_ptr<Storage::IStream> stream{};
+
+        if (Status const status = Storage::IFileSystem::GetPlatformNative().OpenRead(stream, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        Hash::XXHash64 hash{ AssetDependencyHashSeed };
+
+        std::array<std::byte, 64 << 10> buffer{};
+
+        for (;;)
+        {
+            size_t processed{};
+            Status const status = stream->Read(buffer, processed);
+
+            hash.Update(buffer.data(), processed);
+
+            if (status == Status::EndOfStream)
+            {
+                break;
+            }
+
+            if (status != Status::Success)
+            {
+                return status;
+            }
+        }
+
+        result = hash.GetValue();
+        return Status::Success;
+    }
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    AssetDependencyDatabase::AssetDependencyDatabase() noexcept
+        : m_Assets{}
+        , m_Files{}
+    {
+    }
+
+    AssetDependencyDatabase::~AssetDependencyDatabase() noexcept = default;
+
+    Status AssetDependencyDatabase::Load(
+        std::string_view path) noexcept
+    {
+        m_Assets.clear();
+        m_Files.clear();
+
+        if (Storage::IFileSystem::GetPlatformNative().Exists(path) != Status::Success)
+        {
+            return Status::NotFound;
+        }
+
+        std::vector<std::byte> data{};
+
+        if (Status const status = Storage::ReadBinary(data, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        Impl::AssetDependencyDatabaseContent content{};
+
+        if (Status const status = Storage::VersionedArchive::Load(data, content); status != Status::Success)
+        {
+            GX_LOG_WARN(LogAssetDependencies, "Ignoring corrupted database `{}`\n", path);
+            return status;
+        }
+
+        for (Impl::AssetDependencyAssetEntry& asset : content.Assets)
+        {
+            AssetDependencyRecord record{};
+            record.SettingsHash = asset.SettingsHash;
+            record.Outputs      = std::move(asset.Outputs);
+            record.Inputs.reserve(asset.Inputs.size());
+
+            for (Impl::AssetDependencyInputEntry& input : asset.Inputs)
+            {
+                record.Inputs.push_back(AssetDependencyInput{ std::move(input.Path), input.Hash });
+            }
+
+            m_Assets.insert_or_assign(std::move(asset.Name), std::move(record));
+        }
+
+        for (Impl::AssetDependencyFileEntry& file : content.Files)
+        {
+            m_Files.insert_or_assign(std::move(file.Path), FileState{ file.ModificationTime, file.Size, file.Hash });
+        }
+
+        return Status::Success;
+    }
+
+    Status AssetDependencyDatabase::Save(
+        std::string_view path) const noexcept
+    {
+        Impl::AssetDependencyDatabaseContent content{};
+        content.Assets.reserve(m_Assets.size());
+        content.Files.reserve(m_Files.size());
+
+        for (auto const& [name, record] : m_Assets)
+        {
+            Impl::AssetDependencyAssetEntry& asset = content.Assets.emplace_back();
+            asset.Name         = name;
+            asset.SettingsHash = record.SettingsHash;
+            asset.Outputs      = record.Outputs;
+            asset.Inputs.reserve(record.Inputs.size());
+
+            for (AssetDependencyInput const& input : record.Inputs)
+            {
+                asset.Inputs.push_back(Impl::AssetDependencyInputEntry{ input.Path, input.Hash });
+            }
+        }
+
+        for (auto const& [file, state] : m_Files)
+        {
+            content.Files.push_back(Impl::AssetDependencyFileEntry{ file, state.ModificationTime, state.Size, state.Hash });
+        }
+
+        std::vector<std::byte> data{};
+
+        if (Status const status = Storage::VersionedArchive::Save(data, content); status != Status::Success)
+        {
+            return status;
+        }
+
+        if (Status const status = Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(Storage::GetPath(path)); status != Status::Success)
+        {
+            return status;
+        }
+
+        return Storage::WriteBinary(data, path);
+    }
+
+    uint64_t AssetDependencyDatabase::GetSettingsHash(
+        const AssetBatchItem& item) noexcept
+    {
+        Hash::XXHash64 hash{ Impl::AssetDependencyHashSeed };
+
+        //
+        // Strings are hashed with their lengths, so adjacent values produce distinct hashes.
+        //
+
+        auto const append = [&](std::string_view value) {
+            uint64_t const size = value.size();
+            hash.Update(&size, sizeof(size));
+            hash.Update(value.data(), value.size());
+        };
+
+        append(item.Processor);
+        append(item.Request.SourcePath);
+        append(item.Request.DestinationPath);
+
+        for (auto const& [key, value] : item.Request.Options)
+        {
+            append(key);
+            append(value);
+        }
+
+        return hash.GetValue();
+    }
+
+    bool AssetDependencyDatabase::IsDirty(
+        const AssetBatchItem& item) noexcept
+    {
+        auto const it = m_Assets.find(item.Name);
+
+        if (it == m_Assets.end())
+        {
+            return true;
+        }
+
+        AssetDependencyRecord const& record = it->second;
+
+        if (record.SettingsHash != GetSettingsHash(item))
+        {
+            return true;
+        }
+
+        for (AssetDependencyInput const& input : record.Inputs)
+        {
+            uint64_t hash{};
+
+            if (GetFileHash(hash, input.Path) != Status::Success || hash != input.Hash)
+            {
+                GX_LOG_TRACE(LogAssetDependencies, "Asset `{}` is dirty: `{}` changed\n", item.Name, input.Path);
+                return true;
+            }
+        }
+
+        for (std::string const& output : record.Outputs)
+        {
+            if (Storage::IFileSystem::GetPlatformNative().Exists(output) != Status::Success)
+            {
+                GX_LOG_TRACE(LogAssetDependencies, "Asset `{}` is dirty: `{}` is missing\n", item.Name, output);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void AssetDependencyDatabase::Update(
+        const AssetBatchItem& item,
+        const AssetBatchRecord& record) noexcept
+    {
+        AssetDependencyRecord result{};
+        result.SettingsHash = GetSettingsHash(item);
+        result.Outputs      = record.Outputs;
+        result.Inputs.reserve(record.Dependencies.size() + 1);
+
+        auto const add = [&](std::string_view path) {
+            //
+            // Input which cannot be hashed gets zero hash, so asset is dirty until it's readable.
+            //
+
+            uint64_t hash{};
+
+            if (GetFileHash(hash, path) != Status::Success)
+            {
+                hash = 0;
+            }
+
+            result.Inputs.push_back(AssetDependencyInput{ std::string{ path }, hash });
+        };
+
+        add(item.Request.SourcePath);
+
+        for (std::string const& dependency : record.Dependencies)
+        {
+            add(dependency);
+        }
+
+        m_Assets.insert_or_assign(item.Name, std::move(result));
+    }
+
+    void AssetDependencyDatabase::Remove(
+        std::string_view name) noexcept
+    {
+        if (auto const it = m_Assets.find(name); it != m_Assets.end())
+        {
+            m_Assets.erase(it);
+        }
+    }
+
+    void AssetDependencyDatabase::Retain(
+        std::span<const AssetBatchItem> items) noexcept
+    {
+        std::set<std::string_view> names{};
+
+        for (AssetBatchItem const& item : items)
+        {
+            names.insert(item.Name);
+        }
+
+        std::erase_if(m_Assets, [&](auto const& entry) {
+            return !names.contains(entry.first);
+        });
+
+        //
+        // States of files no longer used by any asset are dropped too.
+        //
+
+        std::set<std::string_view> inputs{};
+
+        for (auto const& [name, record] : m_Assets)
+        {
+            for (AssetDependencyInput const& input : record.Inputs)
+            {
+                inputs.insert(input.Path);
+            }
+        }
+
+        std::erase_if(m_Files, [&](auto const& entry) {
+            return !inputs.contains(entry.first);
+        });
+    }
+
+    void AssetDependencyDatabase::Invalidate(
+        std::string_view path) noexcept
+    {
+        if (auto const it = m_Files.find(path); it != m_Files.end())
+        {
+            m_Files.erase(it);
+        }
+    }
+
+    void AssetDependencyDatabase::GetInputDirectories(
+        std::vector<std::string>& result) const noexcept
+    {
+        std::set<std::string_view> directories{};
+
+        for (auto const& [name, record] : m_Assets)
+        {
+            for (AssetDependencyInput const& input : record.Inputs)
+            {
+                directories.insert(Storage::GetPath(input.Path));
+            }
+        }
+
+        result.assign(directories.begin(), directories.end());
+    }
+
+    Status AssetDependencyDatabase::GetFileHash(
+        uint64_t& result,
+        std::string_view path) noexcept
+    {
+        Storage::FileInfo info{};
+
+        if (Status const status = Storage::IFileSystem::GetPlatformNative().GetFileInfo(info, path); status != Status::Success)
+        {
+            Invalidate(path);
+            return status;
+        }
+
+        if (auto const it = m_Files.find(path); it != m_Files.end())
+        {
+            FileState const& state = it->second;
+
+            if (state.ModificationTime == info.ModificationTime.Value && state.Size == info.FileSize)
+            {
+                result = state.Hash;
+                return Status::Success;
+            }
+        }
+
+        if (Status const status = Impl::HashFile(result, path); status != Status::Success)
+        {
+            Invalidate(path);
+            return status;
+        }
+
+        m_Files.insert_or_assign(std::string{ path }, FileState{ info.ModificationTime.Value, info.FileSize, result });
+        return Status::Success;
+    }
+}
@@ -0,0 +1,656 @@
+#include <GxAssetsBase/AssetsPipeline/DerivedDataCache.hxx>
+#include <GxAssetsBase/AssetsPipeline/PlatformToolchain.hxx>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+
+GX_DECLARE_LOG_CATEGORY(LogDerivedDataCache, Trace, Trace);
+GX_DEFINE_LOG_CATEGORY(LogDerivedDataCache);
+
+// =================================================================================================
+//
+// Derived data entry format.
+//
+//  entry:  signature (u32), format version (u32), key (2 x u64), payload size (u64),
+//          payload hash (u64), payload
+//
+//  index:  signature (u32), format version (u32), count (u64), entries of key (2 x u64),
+//          ordered from most recently used
+//
+
+namespace Graphyte::AssetsPipeline::Impl
+{
+    constexpr const uint32_t DerivedDataEntrySignature = 0x43444447;
+    constexpr const uint32_t DerivedDataIndexSignature = 0x49444447;
+    constexpr const uint32_t DerivedDataFormatVersion  = 1;
+
+    constexpr const uint64_t DerivedDataHashSeed = 0;
+
+    constexpr const std::string_view DerivedDataEntryExtension = ".ddc";
+    constexpr const std::string_view DerivedDataIndexName      = "index.bin";
+
+    struct DerivedDataEntryHeader final
+    {
+        uint32_t Signature;
+        uint32_t Version;
+        uint64_t KeyHigh;
+        uint64_t KeyLow;
+        uint64_t Size;
+        uint64_t Hash;
+    };
+
+    static_assert(sizeof(DerivedDataEntryHeader) == 40);
+
+    struct DerivedDataIndexHeader final
+    {
+        uint32_t Signature;
+        uint32_t Version;
+        uint64_t Count;
+    };
+
+    static_assert(sizeof(DerivedDataIndexHeader) == 16);
+
+    class DerivedDataEntryVisitor final : public Storage::IDirectoryVisitor
+    {
+    public:
+        std::unordered_map<std::string, uint64_t> Files;
+
+    public:
+        virtual Status Visit(
+            std::string_view path,
+            bool is_directory) noexcept override
+        {
+            if (!is_directory && Storage::GetExtension(path, true) == DerivedDataEntryExtension)
+            {
+                int64_t size{};
+
+                if (Storage::IFileSystem::GetPlatformNative().GetFileSize(size, path) == Status::Success)
+                {
+                    Files.emplace(Storage::GetBaseFilename(path), static_cast<uint64_t>(size));
+                }
+            }
+
+            return Status::Success;
+        }
+    };
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    std::string DerivedDataKey::ToString() const noexcept
+    {
+        return fmt::format("{:016x}{:016x}", High, Low);
+    }
+
+    bool DerivedDataKey::FromString(
+        DerivedDataKey& result,
+        std::string_view value) noexcept
+    {
+        if (value.size() != 32)
+        {
+            return false;
+        }
+
+        auto parse = [](uint64_t& part, std::string_view text) noexcept -> bool {
+            auto const [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), part, 16);
+            return ec == std::errc{} && ptr == text.data() + text.size();
+        };
+
+        return parse(result.High, value.substr(0, 16))
+               && parse(result.Low, value.substr(16, 16));
+    }
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    DerivedDataKeyBuilder::DerivedDataKeyBuilder(
+        std::string_view processor,
+        uint32_t version) noexcept
+        : m_High{ 0x9e3779b97f4a7c15 }
+        , m_Low{ 0xc2b2ae3d27d4eb4f }
+    {
+        Append(processor);
+        Append(version);
+    }
+
+    DerivedDataKeyBuilder& DerivedDataKeyBuilder::Append(
+        std::span<const std::byte> value) noexcept
+    {
+        m_High.Update(value.data(), value.size());
+        m_Low.Update(value.data(), value.size());
+        return *this;
+    }
+
+    DerivedDataKeyBuilder& DerivedDataKeyBuilder::Append(
+        std::string_view value) noexcept
+    {
+        Append(static_cast<uint64_t>(value.size()));
+        return Append(std::as_bytes(std::span{ value.data(), value.size() }));
+    }
+
+    Status DerivedDataKeyBuilder::AppendFile(
+        std::string_view path) noexcept
+    {
+        std::unique_ptr<Storage::IStream> stream{};
+
+        if (Status const status = Storage::IFileSystem::GetPlatformNative().OpenRead(stream, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        std::array<std::byte, 64 << 10> buffer{};
+        uint64_t total{};
+
+        for (;;)
+        {
+            size_t processed{};
+            Status const status = stream->Read(buffer, processed);
+
+            Append(std::span{ buffer.data(), processed });
+            total += processed;
+
+            if (status == Status::EndOfStream)
+            {
+                break;
+            }
+
+            if (status != Status::Success)
+            {
+                return status;
+            }
+        }
+
+        Append(total);
+        return Status::Success;
+    }
+
+    DerivedDataKeyBuilder& DerivedDataKeyBuilder::AppendToolchain() noexcept
+    {
+        return Append(PlatformToolchain::GetFingerprint());
+    }
+
+    DerivedDataKey DerivedDataKeyBuilder::GetKey() const noexcept
+    {
+        return DerivedDataKey{
+            .High = m_High.GetValue(),
+            .Low  = m_Low.GetValue(),
+        };
+    }
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    DirectoryDerivedDataStore::DirectoryDerivedDataStore(
+        std::string_view root,
+        uint64_t max_size) noexcept
+        : m_Lock{}
+        , m_Root{ Storage::NormalizedPath(root) }
+        , m_MaxSize{ max_size }
+        , m_Size{}
+        , m_Evictions{}
+        , m_Entries{}
+        , m_Index{}
+    {
+        Storage::RemoveDirectorySeparator(m_Root);
+
+        if (Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(m_Root) != Status::Success)
+        {
+            GX_LOG_ERROR(LogDerivedDataCache, "Cannot create directory `{}`\n", m_Root);
+        }
+
+        if (m_MaxSize != 0)
+        {
+            LoadIndex();
+            Evict();
+        }
+    }
+
+    DirectoryDerivedDataStore::~DirectoryDerivedDataStore() noexcept
+    {
+        if (m_MaxSize != 0)
+        {
+            [[maybe_unused]] Status const status = SaveIndex();
+        }
+    }
+
+    Status DirectoryDerivedDataStore::Get(
+        const DerivedDataKey& key,
+        std::vector<std::byte>& data) noexcept
+    {
+        std::string const path = GetEntryPath(key);
+
+        if (Storage::IFileSystem::GetPlatformNative().Exists(path) != Status::Success)
+        {
+            Forget(key);
+            return Status::NotFound;
+        }
+
+        if (Status const status = Storage::ReadBinary(data, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        //
+        // Entry is validated, because store may be shared or modified outside of compiler.
+        //
+
+        Impl::DerivedDataEntryHeader header{};
+
+        bool valid = data.size() >= sizeof(header);
+
+        if (valid)
+        {
+            std::memcpy(&header, data.data(), sizeof(header));
+
+            std::span<const std::byte> const payload = std::span{ data }.subspan(sizeof(header));
+
+            valid = header.Signature == Impl::DerivedDataEntrySignature
+                    && header.Version == Impl::DerivedDataFormatVersion
+                    && header.KeyHigh == key.High
+                    && header.KeyLow == key.Low
+                    && header.Size == payload.size()
+                    && header.Hash == Hash::XXHash64::Hash(payload.data(), payload.size(), Impl::DerivedDataHashSeed);
+        }
+
+        if (!valid)
+        {
+            GX_LOG_WARN(LogDerivedDataCache, "Removing corrupted entry `{}`\n", path);
+
+            data.clear();
+            [[maybe_unused]] Status const status = Storage::IFileSystem::GetPlatformNative().FileDelete(path);
+            Forget(key);
+            return Status::InvalidFormat;
+        }
+
+        uint64_t const size = data.size();
+        data.erase(data.begin(), data.begin() + sizeof(header));
+
+        Touch(key, size);
+        return Status::Success;
+    }
+
+    Status DirectoryDerivedDataStore::Put(
+        const DerivedDataKey& key,
+        std::span<const std::byte> data) noexcept
+    {
+        Storage::IFileSystem& fs = Storage::IFileSystem::GetPlatformNative();
+
+        std::string const path      = GetEntryPath(key);
+        std::string const directory{ Storage::GetPath(path) };
+
+        if (Status const status = fs.DirectoryTreeCreate(directory); status != Status::Success)
+        {
+            return status;
+        }
+
+        Impl::DerivedDataEntryHeader const header{
+            .Signature = Impl::DerivedDataEntrySignature,
+            .Version   = Impl::DerivedDataFormatVersion,
+            .KeyHigh   = key.High,
+            .KeyLow    = key.Low,
+            .Size      = data.size(),
+            .Hash      = Hash::XXHash64::Hash(data.data(), data.size(), Impl::DerivedDataHashSeed),
+        };
+
+        //
+        // Readers never observe partially written entry.
+        //
+
+        std::string const temporary = Storage::CreateTemporaryFilePath(directory, "entry", ".tmp");
+
+        {
+            std::unique_ptr<Storage::IStream> stream{};
+
+            if (Status const status = fs.OpenWrite(stream, temporary); status != Status::Success)
+            {
+                return status;
+            }
+
+            std::array<std::span<const std::byte>, 2> const buffers{
+                std::as_bytes(std::span{ &header, 1 }),
+                data,
+            };
+
+            size_t processed{};
+
+            Status status = stream->WriteGather(buffers, processed);
+
+            if (status == Status::Success && processed != (sizeof(header) + data.size()))
+            {
+                //
+                // Short write must not be moved into place as valid entry.
+                //
+
+                GX_LOG_ERROR(LogDerivedDataCache, "Short write of entry `{}`: {} of {} bytes\n", temporary, processed, sizeof(header) + data.size());
+                status = Status::WriteFault;
+            }
+
+            if (status != Status::Success)
+            {
+                stream = nullptr;
+                [[maybe_unused]] Status const cleanup = fs.FileDelete(temporary);
+                return status;
+            }
+        }
+
+        if (Status const status = fs.FileMove(path, temporary); status != Status::Success)
+        {
+            [[maybe_unused]] Status const cleanup = fs.FileDelete(temporary);
+
+            //
+            // Entry could be stored concurrently by another compiler.
+            //
+
+            if (fs.Exists(path) != Status::Success)
+            {
+                return status;
+            }
+        }
+
+        Touch(key, sizeof(header) + data.size());
+        Evict();
+
+        return Status::Success;
+    }
+
+    uint64_t DirectoryDerivedDataStore::GetSize() noexcept
+    {
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+        return m_Size;
+    }
+
+    uint64_t DirectoryDerivedDataStore::GetEvictions() noexcept
+    {
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+        return m_Evictions;
+    }
+
+    Status DirectoryDerivedDataStore::SaveIndex() noexcept
+    {
+        std::vector<std::byte> content{};
+
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            Impl::DerivedDataIndexHeader const header{
+                .Signature = Impl::DerivedDataIndexSignature,
+                .Version   = Impl::DerivedDataFormatVersion,
+                .Count     = m_Entries.size(),
+            };
+
+            content.reserve(sizeof(header) + m_Entries.size() * sizeof(DerivedDataKey));
+
+            auto const append = [&](const auto& value) {
+                auto const bytes = std::as_bytes(std::span{ &value, 1 });
+                content.insert(content.end(), bytes.begin(), bytes.end());
+            };
+
+            append(header);
+
+            for (Entry const& entry : m_Entries)
+            {
+                append(entry.Key);
+            }
+        }
+
+        return Storage::WriteBinary(content, Storage::CombinePath(m_Root, Impl::DerivedDataIndexName));
+    }
+
+    std::string DirectoryDerivedDataStore::GetEntryPath(
+        const DerivedDataKey& key) const noexcept
+    {
+        std::string const name = key.ToString();
+
+        //
+        // Entries are spread over 256 directories to keep directory listings short.
+        //
+
+        std::string result = m_Root;
+        Storage::AppendPath(result, std::string_view{ name }.substr(0, 2));
+        Storage::AppendPath(result, name);
+        result.append(Impl::DerivedDataEntryExtension);
+        return result;
+    }
+
+    void DirectoryDerivedDataStore::LoadIndex() noexcept
+    {
+        //
+        // Directory content is authoritative, index only provides order of use.
+        //
+
+        Impl::DerivedDataEntryVisitor visitor{};
+
+        if (Storage::IFileSystem::GetPlatformNative().EnumerateRecursive(m_Root, visitor) != Status::Success)
+        {
+            GX_LOG_WARN(LogDerivedDataCache, "Cannot enumerate `{}`\n", m_Root);
+            return;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        auto const add = [&](const DerivedDataKey& key, uint64_t size) {
+            auto const it = m_Entries.insert(m_Entries.end(), Entry{ .Key = key, .Size = size });
+            m_Index.emplace(key, it);
+            m_Size += size;
+        };
+
+        std::vector<std::byte> content{};
+
+        if (Storage::ReadBinary(content, Storage::CombinePath(m_Root, Impl::DerivedDataIndexName)) == Status::Success
+            && content.size() >= sizeof(Impl::DerivedDataIndexHeader))
+        {
+            Impl::DerivedDataIndexHeader header{};
+            std::memcpy(&header, content.data(), sizeof(header));
+
+            size_t const available = (content.size() - sizeof(header)) / sizeof(DerivedDataKey);
+
+            if (header.Signature == Impl::DerivedDataIndexSignature
+                && header.Version == Impl::DerivedDataFormatVersion
+                && header.Count <= available)
+            {
+                for (size_t i = 0; i < header.Count; ++i)
+                {
+                    DerivedDataKey key{};
+                    std::memcpy(&key, content.data() + sizeof(header) + i * sizeof(key), sizeof(key));
+
+                    if (auto const file = visitor.Files.find(key.ToString()); file != visitor.Files.end())
+                    {
+                        add(key, file->second);
+                        visitor.Files.erase(file);
+                    }
+                }
+            }
+        }
+
+        //
+        // Entries missing in index are considered least recently used.
+        //
+
+        for (auto const& [name, size] : visitor.Files)
+        {
+            DerivedDataKey key{};
+
+            if (DerivedDataKey::FromString(key, name) && !m_Index.contains(key))
+            {
+                add(key, size);
+            }
+        }
+    }
+
+    void DirectoryDerivedDataStore::Touch(
+        const DerivedDataKey& key,
+        uint64_t size) noexcept
+    {
+        if (m_MaxSize == 0)
+        {
+            return;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (auto const it = m_Index.find(key); it != m_Index.end())
+        {
+            m_Size -= it->second->Size;
+            it->second->Size = size;
+            m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+        }
+        else
+        {
+            m_Entries.push_front(Entry{ .Key = key, .Size = size });
+            m_Index.emplace(key, m_Entries.begin());
+        }
+
+        m_Size += size;
+    }
+
+    void DirectoryDerivedDataStore::Forget(
+        const DerivedDataKey& key) noexcept
+    {
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (auto const it = m_Index.find(key); it != m_Index.end())
+        {
+            m_Size -= it->second->Size;
+            m_Entries.erase(it->second);
+            m_Index.erase(it);
+        }
+    }
+
+    void DirectoryDerivedDataStore::Evict() noexcept
+    {
+        if (m_MaxSize == 0)
+        {
+            return;
+        }
+
+        std::vector<std::string> evicted{};
+
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            //
+            // Most recently used entry is kept even when it alone exceeds limit.
+            //
+
+            while (m_Size > m_MaxSize && m_Entries.size() > 1)
+            {
+                Entry const& entry = m_Entries.back();
+
+                evicted.push_back(GetEntryPath(entry.Key));
+
+                m_Size -= entry.Size;
+                m_Index.erase(entry.Key);
+                m_Entries.pop_back();
+                ++m_Evictions;
+            }
+        }
+
+        for (std::string const& path : evicted)
+        {
+            [[maybe_unused]] Status const status = Storage::IFileSystem::GetPlatformNative().FileDelete(path);
+        }
+    }
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    DerivedDataCache::DerivedDataCache() noexcept
+        : m_Local{}
+        , m_Shared{}
+        , m_LocalHits{}
+        , m_SharedHits{}
+        , m_Misses{}
+        , m_Puts{}
+        , m_BytesRead{}
+        , m_BytesWritten{}
+    {
+    }
+
+    DerivedDataCache::~DerivedDataCache() noexcept = default;
+
+    DerivedDataCache& DerivedDataCache::Get() noexcept
+    {
+        static DerivedDataCache instance{};
+        return instance;
+    }
+
+    void DerivedDataCache::SetLocalStore(
+        std::unique_ptr<IDerivedDataStore> store) noexcept
+    {
+        m_Local = std::move(store);
+    }
+
+    void DerivedDataCache::SetSharedStore(
+        std::unique_ptr<IDerivedDataStore> store) noexcept
+    {
+        m_Shared = std::move(store);
+    }
+
+    bool DerivedDataCache::Get(
+        const DerivedDataKey& key,
+        std::vector<std::byte>& data) noexcept
+    {
+        if (m_Local != nullptr && m_Local->Get(key, data) == Status::Success)
+        {
+            m_LocalHits.fetch_add(1, std::memory_order_relaxed);
+            m_BytesRead.fetch_add(data.size(), std::memory_order_relaxed);
+            return true;
+        }
+
+        if (m_Shared != nullptr && m_Shared->Get(key, data) == Status::Success)
+        {
+            m_SharedHits.fetch_add(1, std::memory_order_relaxed);
+            m_BytesRead.fetch_add(data.size(), std::memory_order_relaxed);
+
+            if (m_Local != nullptr)
+            {
+                if (Status const status = m_Local->Put(key, data); status != Status::Success)
+                {
+                    GX_LOG_WARN(LogDerivedDataCache, "Cannot copy `{}` to local store: {}\n", key.ToString(), status);
+                }
+            }
+
+            return true;
+        }
+
+        m_Misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void DerivedDataCache::Put(
+        const DerivedDataKey& key,
+        std::span<const std::byte> data) noexcept
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        m_Puts.fetch_add(1, std::memory_order_relaxed);
+        m_BytesWritten.fetch_add(data.size(), std::memory_order_relaxed);
+
+        for (IDerivedDataStore* store : { m_Local.get(), m_Shared.get() })
+        {
+            if (store != nullptr)
+            {
+                if (Status const status = store->Put(key, data); status != Status::Success)
+                {
+                    GX_LOG_WARN(LogDerivedDataCache, "Cannot store `{}`: {}\n", key.ToString(), status);
+                }
+            }
+        }
+    }
+
+    DerivedDataStatistics DerivedDataCache::GetStatistics() const noexcept
+    {
+        return DerivedDataStatistics{
+            .LocalHits    = m_LocalHits.load(std::memory_order_relaxed),
+            .SharedHits   = m_SharedHits.load(std::memory_order_relaxed),
+            .Misses       = m_Misses.load(std::memory_order_relaxed),
+            .Puts         = m_Puts.load(std::memory_order_relaxed),
+            .BytesRead    = m_BytesRead.load(std::memory_order_relaxed),
+            .BytesWritten = m_BytesWritten.load(std::memory_order_relaxed),
+        };
+    }
+}
@@ -104,4 +104,15 @@ namespace Graphyte::AssetsPipeline
 
         return path;
     }
+
+    std::string PlatformToolchain::GetFingerprint() noexcept
+    {
+        static std::string const fingerprint = fmt::format(
+            "windows-sdk={};{};vulkan-sdk={}",
+            GetWindowsSdkVersion(),
+            GetWindowsSdkBinary(),
+            GetVulkanSdkLocation());
+
+        return fingerprint;
+    }
 }
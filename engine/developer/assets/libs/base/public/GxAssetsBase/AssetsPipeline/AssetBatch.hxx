@@ -0,0 +1,148 @@
+#pragma once
+#include <GxAssetsBase/AssetsPipeline/AssetProcessor.hxx>
+#include <GxBase/Status.hxx>
+
+namespace Graphyte::Threading
+{
+    class TaskDispatcher;
+}
+
+namespace Graphyte::AssetsPipeline
+{
+    class AssetDependencyDatabase;
+
+    /// @brief Describes single asset built in batch.
+    struct AssetBatchItem final
+    {
+        /// @brief Unique name of asset, referenced by dependent assets.
+        std::string Name;
+
+        /// @brief Name of processor used to build asset.
+        std::string Processor;
+
+        /// @brief Request passed to processor.
+        AssetProcessorRequest Request;
+
+        /// @brief Names of assets which must be built first.
+        std::vector<std::string> Dependencies;
+
+        /// @brief Estimated peak memory used by processor, in bytes. Zero means estimate from size
+        ///        of source file.
+        uint64_t MemoryEstimate;
+    };
+
+    /// @brief Parses batch manifest.
+    ///
+    /// Manifest consists of sections, one per asset:
+    ///
+    ///     # comment
+    ///     [shaders/basic.vs]
+    ///     processor = shader
+    ///     source = shaders/basic.hlsl
+    ///     output = basic
+    ///     depends = textures/noise, textures/ramp
+    ///     memory = 64
+    ///     stage = vs
+    ///
+    /// Value of `memory` is expressed in MiB. Keys not recognized by manifest are passed to
+    /// processor as request options.
+    ///
+    /// @param result         Returns parsed items.
+    /// @param content        Provides content of manifest.
+    /// @param base_directory Provides directory against which relative source paths are resolved.
+    ///
+    /// @return The status code.
+    [[nodiscard]] ASSETS_BASE_API Status ParseAssetBatchManifest(
+        std::vector<AssetBatchItem>& result,
+        std::string_view content,
+        std::string_view base_directory) noexcept;
+
+    enum class AssetBatchResult : uint8_t
+    {
+        Succeeded,
+        Failed,
+
+        /// @brief Asset was not built because one of its dependencies failed.
+        Skipped,
+
+        /// @brief Asset was not built because neither it nor its dependencies changed.
+        UpToDate,
+    };
+
+    /// @brief Provides result of single asset built in batch.
+    struct AssetBatchRecord final
+    {
+        std::string Name;
+        std::string Processor;
+        AssetBatchResult Result;
+
+        /// @brief Time spent waiting for memory budget, in seconds.
+        double WaitTime;
+
+        /// @brief Time spent in processor, in seconds.
+        double ProcessTime;
+
+        std::vector<std::string> Log;
+
+        /// @brief Files read by processor in addition to source file.
+        std::vector<std::string> Dependencies;
+
+        /// @brief Files written by processor.
+        std::vector<std::string> Outputs;
+    };
+
+    /// @brief Builds assets concurrently, respecting dependencies between them.
+    ///
+    /// Each asset is processed by its own processor instance on task dispatcher workers. Processors
+    /// start only when sum of their memory estimates fits in memory budget. Single asset exceeding
+    /// whole budget still runs, but alone.
+    ///
+    /// When dependency database is provided, only dirty assets and assets depending on them are
+    /// built.
+    class ASSETS_BASE_API AssetBatchBuilder final
+    {
+    private:
+        std::vector<AssetBatchItem> m_Items;
+        std::vector<std::vector<uint32_t>> m_Dependencies;
+        std::vector<uint32_t> m_Order;
+
+    public:
+        AssetBatchBuilder() noexcept;
+        ~AssetBatchBuilder() noexcept;
+
+    public:
+        /// @brief Sets items to build.
+        ///
+        /// @param items Provides items to build.
+        ///
+        /// @return Status::InvalidArgument when names of items are not unique or dependencies form
+        ///         cycle, Status::NotFound when dependency does not exist, or Status::Success.
+        Status SetItems(
+            std::vector<AssetBatchItem> items) noexcept;
+
+        [[nodiscard]] size_t GetSize() const noexcept
+        {
+            return m_Items.size();
+        }
+
+        [[nodiscard]] std::span<const AssetBatchItem> GetItems() const noexcept
+        {
+            return m_Items;
+        }
+
+        /// @brief Builds all items.
+        ///
+        /// @param dispatcher    Provides dispatcher executing processors.
+        /// @param memory_budget Provides memory budget, in bytes. Zero disables limit.
+        /// @param records       Returns records of built items, in order of items.
+        /// @param database      Provides optional dependency database, updated with built items.
+        ///
+        /// @return Status::Success when all items were built or up to date, Status::Failure
+        ///         otherwise.
+        Status Build(
+            Threading::TaskDispatcher& dispatcher,
+            uint64_t memory_budget,
+            std::vector<AssetBatchRecord>& records,
+            AssetDependencyDatabase* database = nullptr) noexcept;
+    };
+}
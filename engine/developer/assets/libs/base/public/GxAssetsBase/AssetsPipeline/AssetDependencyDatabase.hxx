@@ -0,0 +1,106 @@
+#pragma once
+#include <GxAssetsBase/AssetsPipeline/AssetBatch.hxx>
+#include <GxBase/Status.hxx>
+
+namespace Graphyte::AssetsPipeline
+{
+    /// @brief Describes file from which asset was built.
+    struct AssetDependencyInput final
+    {
+        std::string Path;
+
+        /// @brief Hash of file content at time asset was built.
+        uint64_t Hash;
+    };
+
+    /// @brief Describes how asset was built last time.
+    struct AssetDependencyRecord final
+    {
+        /// @brief Hash of processor name, paths and options of asset.
+        uint64_t SettingsHash;
+
+        std::vector<AssetDependencyInput> Inputs;
+        std::vector<std::string> Outputs;
+    };
+
+    /// @brief Tracks inputs of built assets, so only assets affected by changes are built again.
+    ///
+    /// Asset is dirty when its settings changed, content of any of its inputs changed, or any of its
+    /// outputs is missing. Content hashes of files are cached along with modification time and size,
+    /// so unchanged files are not read again.
+    ///
+    /// @remarks Database is not thread safe.
+    class ASSETS_BASE_API AssetDependencyDatabase final
+    {
+    private:
+        struct FileState final
+        {
+            int64_t ModificationTime;
+            int64_t Size;
+            uint64_t Hash;
+        };
+
+    private:
+        std::map<std::string, AssetDependencyRecord, std::less<>> m_Assets;
+        std::map<std::string, FileState, std::less<>> m_Files;
+
+    public:
+        AssetDependencyDatabase() noexcept;
+        ~AssetDependencyDatabase() noexcept;
+
+    public:
+        /// @brief Loads database from file.
+        ///
+        /// @return Status::NotFound when file does not exist, or other status code.
+        Status Load(
+            std::string_view path) noexcept;
+
+        /// @brief Saves database to file.
+        ///
+        /// @return The status code.
+        Status Save(
+            std::string_view path) const noexcept;
+
+        [[nodiscard]] size_t GetSize() const noexcept
+        {
+            return m_Assets.size();
+        }
+
+        /// @brief Computes hash of settings of item.
+        [[nodiscard]] static uint64_t GetSettingsHash(
+            const AssetBatchItem& item) noexcept;
+
+        /// @brief Determines whether item must be built again.
+        [[nodiscard]] bool IsDirty(
+            const AssetBatchItem& item) noexcept;
+
+        /// @brief Records inputs and outputs of successfully built item.
+        void Update(
+            const AssetBatchItem& item,
+            const AssetBatchRecord& record) noexcept;
+
+        /// @brief Forgets item, so it's built again.
+        void Remove(
+            std::string_view name) noexcept;
+
+        /// @brief Forgets all assets not present in items.
+        void Retain(
+            std::span<const AssetBatchItem> items) noexcept;
+
+        /// @brief Forgets cached state of file, so its content is hashed again.
+        ///
+        /// @remarks Used when file is known to be changed, even if its modification time and size
+        ///          did not change.
+        void Invalidate(
+            std::string_view path) noexcept;
+
+        /// @brief Gets directories containing inputs of assets.
+        void GetInputDirectories(
+            std::vector<std::string>& result) const noexcept;
+
+    private:
+        Status GetFileHash(
+            uint64_t& result,
+            std::string_view path) noexcept;
+    };
+}
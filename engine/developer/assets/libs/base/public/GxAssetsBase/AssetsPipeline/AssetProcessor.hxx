@@ -9,11 +9,19 @@ namespace Graphyte::AssetsPipeline
         std::string SourcePath;
         std::string DestinationPath;
         Uuid AssetId;
+        std::map<std::string, std::string, std::less<>> Options;
     };
 
     struct AssetProcessorResponse
     {
         std::vector<std::string> Log;
+
+        /// @brief Files read by processor in addition to source file, for example included files.
+        std::vector<std::string> Dependencies;
+
+        /// @brief Files written by processor.
+        std::vector<std::string> Outputs;
+
         bool Success;
     };
 
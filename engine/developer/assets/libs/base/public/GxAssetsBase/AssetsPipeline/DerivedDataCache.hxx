@@ -0,0 +1,247 @@
+#pragma once
+#include <GxAssetsBase/Assets.Base.module.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Status.hxx>
+#include <GxBase/Threading/Sync.hxx>
+
+namespace Graphyte::AssetsPipeline
+{
+    /// @brief Identifies derived data by hash of everything it was produced from.
+    struct DerivedDataKey final
+    {
+        uint64_t High;
+        uint64_t Low;
+
+        [[nodiscard]] constexpr bool operator==(const DerivedDataKey& other) const noexcept = default;
+
+        /// @brief Converts key to hexadecimal string.
+        [[nodiscard]] ASSETS_BASE_API std::string ToString() const noexcept;
+
+        /// @brief Parses key from hexadecimal string.
+        [[nodiscard]] ASSETS_BASE_API static bool FromString(
+            DerivedDataKey& result,
+            std::string_view value) noexcept;
+    };
+
+    /// @brief Computes derived data key.
+    ///
+    /// Key covers processor name and version, so bumping version invalidates all data produced by
+    /// older implementation of processor.
+    class ASSETS_BASE_API DerivedDataKeyBuilder final
+    {
+    private:
+        Hash::XXHash64 m_High;
+        Hash::XXHash64 m_Low;
+
+    public:
+        DerivedDataKeyBuilder(
+            std::string_view processor,
+            uint32_t version) noexcept;
+
+    public:
+        /// @brief Appends raw bytes to key.
+        DerivedDataKeyBuilder& Append(
+            std::span<const std::byte> value) noexcept;
+
+        /// @brief Appends string to key.
+        ///
+        /// @remarks Length is hashed too, so sequences of strings produce distinct keys.
+        DerivedDataKeyBuilder& Append(
+            std::string_view value) noexcept;
+
+        template <typename T>
+            requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        DerivedDataKeyBuilder& Append(
+            T value) noexcept
+        {
+            return Append(std::as_bytes(std::span{ &value, 1 }));
+        }
+
+        /// @brief Appends content of file to key.
+        ///
+        /// @return The status code.
+        Status AppendFile(
+            std::string_view path) noexcept;
+
+        /// @brief Appends settings of platform toolchain used to produce data.
+        DerivedDataKeyBuilder& AppendToolchain() noexcept;
+
+        [[nodiscard]] DerivedDataKey GetKey() const noexcept;
+    };
+
+    /// @brief Represents storage of derived data.
+    struct IDerivedDataStore
+    {
+        virtual ~IDerivedDataStore() noexcept = default;
+
+        /// @brief Gets data stored under key.
+        ///
+        /// @param key  Provides key of data.
+        /// @param data Returns stored data.
+        ///
+        /// @return Status::Success when data was found, Status::NotFound when store does not have
+        ///         data for key, or error status otherwise.
+        virtual Status Get(
+            const DerivedDataKey& key,
+            std::vector<std::byte>& data) noexcept = 0;
+
+        /// @brief Stores data under key.
+        ///
+        /// @param key  Provides key of data.
+        /// @param data Provides data to store.
+        ///
+        /// @return The status code.
+        virtual Status Put(
+            const DerivedDataKey& key,
+            std::span<const std::byte> data) noexcept = 0;
+    };
+
+    /// @brief Stores derived data as files in directory.
+    ///
+    /// Data is written to temporary file and moved in place, so same directory may be shared by
+    /// concurrent compilers, for example on network drive. When size limit is specified, least
+    /// recently used entries are evicted. Order of use is persisted in index file in directory.
+    class ASSETS_BASE_API DirectoryDerivedDataStore final : public IDerivedDataStore
+    {
+    private:
+        struct Entry final
+        {
+            DerivedDataKey Key;
+            uint64_t Size;
+        };
+
+        struct KeyHash final
+        {
+            size_t operator()(const DerivedDataKey& key) const noexcept
+            {
+                return static_cast<size_t>(key.High ^ key.Low);
+            }
+        };
+
+    private:
+        Threading::CriticalSection m_Lock;
+        std::string m_Root;
+        uint64_t m_MaxSize;
+        uint64_t m_Size;
+        uint64_t m_Evictions;
+        std::list<Entry> m_Entries;
+        std::unordered_map<DerivedDataKey, std::list<Entry>::iterator, KeyHash> m_Index;
+
+    public:
+        /// @brief Creates store in directory.
+        ///
+        /// @param root     Provides directory of store.
+        /// @param max_size Provides size limit of stored data, in bytes. Zero disables eviction.
+        DirectoryDerivedDataStore(
+            std::string_view root,
+            uint64_t max_size) noexcept;
+
+        virtual ~DirectoryDerivedDataStore() noexcept;
+
+    public:
+        virtual Status Get(
+            const DerivedDataKey& key,
+            std::vector<std::byte>& data) noexcept override;
+
+        virtual Status Put(
+            const DerivedDataKey& key,
+            std::span<const std::byte> data) noexcept override;
+
+    public:
+        [[nodiscard]] uint64_t GetSize() noexcept;
+
+        [[nodiscard]] uint64_t GetEvictions() noexcept;
+
+        /// @brief Writes index of entries in order of use.
+        ///
+        /// @return The status code.
+        Status SaveIndex() noexcept;
+
+    private:
+        std::string GetEntryPath(
+            const DerivedDataKey& key) const noexcept;
+
+        void LoadIndex() noexcept;
+
+        void Touch(
+            const DerivedDataKey& key,
+            uint64_t size) noexcept;
+
+        void Forget(
+            const DerivedDataKey& key) noexcept;
+
+        void Evict() noexcept;
+    };
+
+    /// @brief Provides statistics of derived data cache.
+    struct DerivedDataStatistics final
+    {
+        uint64_t LocalHits;
+        uint64_t SharedHits;
+        uint64_t Misses;
+        uint64_t Puts;
+        uint64_t BytesRead;
+        uint64_t BytesWritten;
+    };
+
+    /// @brief Caches data produced by asset processors.
+    ///
+    /// Lookups check local store first, then shared store. Data found in shared store is copied to
+    /// local one. New data is written to both stores.
+    class ASSETS_BASE_API DerivedDataCache final
+    {
+    private:
+        std::unique_ptr<IDerivedDataStore> m_Local;
+        std::unique_ptr<IDerivedDataStore> m_Shared;
+        std::atomic<uint64_t> m_LocalHits;
+        std::atomic<uint64_t> m_SharedHits;
+        std::atomic<uint64_t> m_Misses;
+        std::atomic<uint64_t> m_Puts;
+        std::atomic<uint64_t> m_BytesRead;
+        std::atomic<uint64_t> m_BytesWritten;
+
+    public:
+        DerivedDataCache() noexcept;
+        ~DerivedDataCache() noexcept;
+
+        static DerivedDataCache& Get() noexcept;
+
+    public:
+        /// @brief Sets local store.
+        ///
+        /// @remarks Must not be called while cache is used.
+        void SetLocalStore(
+            std::unique_ptr<IDerivedDataStore> store) noexcept;
+
+        /// @brief Sets shared store.
+        ///
+        /// @remarks Must not be called while cache is used.
+        void SetSharedStore(
+            std::unique_ptr<IDerivedDataStore> store) noexcept;
+
+        [[nodiscard]] bool IsEnabled() const noexcept
+        {
+            return m_Local != nullptr || m_Shared != nullptr;
+        }
+
+        /// @brief Gets cached data.
+        ///
+        /// @param key  Provides key of data.
+        /// @param data Returns cached data.
+        ///
+        /// @return The value indicating whether data was found.
+        bool Get(
+            const DerivedDataKey& key,
+            std::vector<std::byte>& data) noexcept;
+
+        /// @brief Stores data in cache.
+        ///
+        /// @param key  Provides key of data.
+        /// @param data Provides data to store.
+        void Put(
+            const DerivedDataKey& key,
+            std::span<const std::byte> data) noexcept;
+
+        [[nodiscard]] DerivedDataStatistics GetStatistics() const noexcept;
+    };
+}
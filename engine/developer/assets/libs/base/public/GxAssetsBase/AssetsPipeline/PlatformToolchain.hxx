@@ -19,5 +19,12 @@ namespace Graphyte::AssetsPipeline
     public:
         static std::string GetVulkanSdkLocation() noexcept;
         static std::string GetVulkanSdkBinary() noexcept;
+
+        //
+        // Derived data
+        //
+    public:
+        /// @brief Gets string identifying toolchain used to produce derived data.
+        static std::string GetFingerprint() noexcept;
     };
 }
@@ -2,6 +2,9 @@
 #include <GxBase/Storage/FileManager.hxx>
 #include <GxBase/Storage/Path.hxx>
 #include <GxBase/Storage/ArchiveMemoryReader.hxx>
+#include <GxBase/Storage/ArchiveMemoryWriter.hxx>
+#include <GxBase/Storage/ArchiveFileWriter.hxx>
+#include <GxAssetsBase/AssetsPipeline/DerivedDataCache.hxx>
 #include <GxGeometry/Geometry/Model.hxx>
 #include "Formats/E3DImporter.hxx"
 
@@ -9,6 +12,12 @@ namespace Graphyte::AssetsPipeline
 {
     GX_DEFINE_LOG_CATEGORY(LogMeshProcessor);
 
+    //
+    // Bump when cooked output changes, to invalidate cached data.
+    //
+
+    constexpr const uint32_t MeshProcessorVersion = 1;
+
     MeshProcessor::MeshProcessor() noexcept
     {
     }
@@ -17,43 +26,84 @@ namespace Graphyte::AssetsPipeline
     {
     }
 
-    bool MeshProcessor::Process([[maybe_unused]] const AssetProcessorRequest& request, [[maybe_unused]] AssetProcessorResponse& response) noexcept
+    bool MeshProcessor::Process(const AssetProcessorRequest& request, AssetProcessorResponse& response) noexcept
     {
-        return false;
-    }
+        response.Success = false;
 
-    bool MeshProcessor::Process() noexcept
-    {
-        auto mesh = std::make_unique<Graphyte::Geometry::Model>();
+        std::string_view const path = request.SourcePath;
+
+        //
+        // Relative destination is placed in project content directory.
+        //
 
-        auto path = Graphyte::Storage::GetProjectContentDirectory();
-        Graphyte::Storage::AppendPath(path, "models/201e.e3d");
+        std::string destination = Graphyte::Storage::IsAbsolutePath(request.DestinationPath)
+                                      ? request.DestinationPath
+                                      : Graphyte::Storage::CombinePath(Graphyte::Storage::GetProjectContentDirectory(), request.DestinationPath);
 
         std::vector<std::byte> content{};
 
         if (Graphyte::Storage::ReadBinary(content, path) == Status::Success)
         {
-            Graphyte::Storage::ArchiveMemoryReader reader{ content };
-            Meshes::E3DImporter importer{};
-            Geometry::Model model{};
-            //std::vector<Geometry::Mesh> meshes{};
+            //
+            // Cooked model depends only on source file content.
+            //
+
+            DerivedDataKey const key = DerivedDataKeyBuilder{ "mesh", MeshProcessorVersion }
+                                           .Append(content)
+                                           .GetKey();
+
+            std::vector<std::byte> cooked{};
 
-            if (importer.Load(reader, model))
+            if (DerivedDataCache::Get().Get(key, cooked))
             {
-                GX_LOG_INFO(LogMeshProcessor, "Loaded successfully\n");
+                GX_LOG_INFO(LogMeshProcessor, "Using cached `{}`\n", path);
             }
             else
             {
-                GX_LOG_ERROR(LogMeshProcessor, "Failed to parse `{}`\n", path);
+                Graphyte::Storage::ArchiveMemoryReader reader{ content };
+                Meshes::E3DImporter importer{};
+                Geometry::Model model{};
+                //std::vector<Geometry::Mesh> meshes{};
+
+                if (importer.Load(reader, model))
+                {
+                    GX_LOG_INFO(LogMeshProcessor, "Loaded successfully\n");
+                }
+                else
+                {
+                    GX_LOG_ERROR(LogMeshProcessor, "Failed to parse `{}`\n", path);
+                    response.Log.push_back(fmt::format("Failed to parse `{}`", path));
+                    return false;
+                }
+
+                {
+                    Graphyte::Storage::ArchiveMemoryWriter writer{ cooked };
+                    writer << model;
+                }
+
+                DerivedDataCache::Get().Put(key, cooked);
             }
 
-            auto destination = Graphyte::Storage::GetProjectContentDirectory();
-            Graphyte::Storage::AppendPath(destination, "models/111a28.mesh");
             {
+                //
+                // Cooked output is large and can be regenerated, so it is written behind with large
+                // buffer and synchronized once.
+                //
+
+                Graphyte::Storage::ArchiveFileWriterOptions const options{
+                    .BufferSize  = 4 << 20,
+                    .WriteBehind = true,
+                    .BufferSync  = Graphyte::Storage::StreamSync::Writeback,
+                    .FlushSync   = Graphyte::Storage::StreamSync::Data,
+                };
+
                 std::unique_ptr<Graphyte::Storage::Archive> writer{};
-                if (Graphyte::Storage::CreateWriter(writer, destination) == Status::Success)
+                if (Graphyte::Storage::CreateWriter(writer, destination, options) == Status::Success)
                 {
-                    *writer << model;
+                    writer->Serialize(cooked.data(), cooked.size());
+                    writer->Flush();
+                    response.Success = !writer->IsError();
+                    response.Outputs.push_back(destination);
                 }
             }
             if constexpr (false)
@@ -75,7 +125,26 @@ namespace Graphyte::AssetsPipeline
                 }
             }
         }
+        else
+        {
+            GX_LOG_ERROR(LogMeshProcessor, "Cannot read `{}`\n", path);
+        }
+
+        if (!response.Success)
+        {
+            response.Log.push_back(fmt::format("Cannot process `{}`", path));
+        }
+
+        return response.Success;
+    }
+
+    bool MeshProcessor::Process() noexcept
+    {
+        AssetProcessorRequest request{};
+        request.SourcePath      = Graphyte::Storage::CombinePath(Graphyte::Storage::GetProjectContentDirectory(), "models/201e.e3d");
+        request.DestinationPath = "models/111a28.mesh";
 
-        return false;
+        AssetProcessorResponse response{};
+        return Process(request, response);
     }
 }
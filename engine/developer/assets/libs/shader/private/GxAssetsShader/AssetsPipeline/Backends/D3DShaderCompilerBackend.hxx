@@ -28,6 +28,11 @@ namespace Graphyte::AssetsPipeline
 
         bool IsSupported(ShaderCompilerInput& input) const noexcept override;
         bool Compile(ShaderCompilerInput& input, ShaderCompilerOutput& output) const noexcept override;
+
+        std::string_view GetName() const noexcept override
+        {
+            return "d3dcompiler";
+        }
     };
 }
 
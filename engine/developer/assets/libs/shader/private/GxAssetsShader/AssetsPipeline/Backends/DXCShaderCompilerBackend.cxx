@@ -32,6 +32,7 @@ namespace Graphyte::AssetsPipeline
         , m_LibDxil{}
         , m_DxcLibrary{}
         , m_DxcCompiler{}
+        , m_Lock{}
     {
         auto sdk_path = PlatformToolchain::GetWindowsSdkBinary();
 
@@ -127,6 +128,8 @@ namespace Graphyte::AssetsPipeline
 
     bool DXCShaderCompilerBackend::Compile(ShaderCompilerInput& input, ShaderCompilerOutput& output) const noexcept
     {
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
         Microsoft::WRL::ComPtr<IDxcBlobEncoding> source_blob{};
         if (FAILED(m_DxcLibrary->CreateBlobWithEncodingFromPinned(std::data(input.Source), static_cast<UINT32>(std::size(input.Source)), CP_UTF8, source_blob.GetAddressOf())))
         {
@@ -1,6 +1,7 @@
 #pragma once
 #include <GxAssetsShader/AssetsPipeline/ShaderProcessor.hxx>
 #include <GxBase/System/Library.hxx>
+#include <GxBase/Threading/Sync.hxx>
 
 #include <Unknwn.h>
 #include <dxcapi.h>
@@ -18,6 +19,12 @@ namespace Graphyte::AssetsPipeline
         Microsoft::WRL::ComPtr<IDxcLibrary> m_DxcLibrary;
         Microsoft::WRL::ComPtr<IDxcCompiler> m_DxcCompiler;
 
+        //
+        // Compiler instance is not thread safe, but permutations are compiled concurrently.
+        //
+
+        mutable Threading::CriticalSection m_Lock;
+
     public:
         DXCShaderCompilerBackend() noexcept;
         virtual ~DXCShaderCompilerBackend() noexcept;
@@ -25,6 +32,11 @@ namespace Graphyte::AssetsPipeline
         bool IsSupported(ShaderCompilerInput& input) const noexcept override;
         bool Compile(ShaderCompilerInput& input, ShaderCompilerOutput& output) const noexcept override;
 
+        std::string_view GetName() const noexcept override
+        {
+            return "dxc";
+        }
+
     private:
         static std::vector<const wchar_t*> GetCompilerOptions(const ShaderCompilerInput& input) noexcept;
         static std::vector<DxcDefine> GetCompilerDefinitions(const std::vector<std::pair<std::wstring, std::wstring>>& definitions) noexcept;
@@ -92,9 +92,15 @@ namespace Graphyte::AssetsPipeline
             return false;
         }
 
-        auto source_temp = fmt::format("{}{:x}.tmp.shader",
+        //
+        // Same input may be compiled concurrently with different definitions, so temporary files
+        // get unique names.
+        //
+
+        auto source_temp = Storage::CreateTemporaryFilePath(
             temp_directory,
-            input.GetHash());
+            fmt::format("{:x}.", input.GetHash()),
+            ".tmp.shader");
 
         if (Storage::WriteText(input.Source, source_temp) != Status::Success)
         {
@@ -90,15 +90,18 @@ namespace Graphyte::AssetsPipeline
             return false;
         }
 
-        auto source_temp = fmt::format(
-            "{}{:x}.tmp.shader.input",
-            temp_directory,
-            input.GetHash());
+        //
+        // Same input may be compiled concurrently with different definitions, so temporary files
+        // get unique names.
+        //
 
-        auto target_temp = fmt::format(
-            "{}{:x}.tmp.shader.output",
+        auto const temp_base = Storage::CreateTemporaryFilePath(
             temp_directory,
-            input.GetHash());
+            fmt::format("{:x}.", input.GetHash()),
+            ".tmp.shader");
+
+        auto source_temp = temp_base + ".input";
+        auto target_temp = temp_base + ".output";
 
         if (Storage::WriteText(input.Source, source_temp) != Status::Success)
         {
@@ -1,11 +1,16 @@
 #include <GxAssetsBase/AssetsPipeline/AssetProcessor.hxx>
 #include <GxAssetsBase/AssetsPipeline/AssetProcessorFactory.hxx>
+#include <GxAssetsBase/AssetsPipeline/DerivedDataCache.hxx>
 #include <GxBase/Storage/Path.hxx>
 #include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/ArchiveFileWriter.hxx>
 #include <GxGraphics/Graphics/ShaderBytecode.hxx>
+#include <GxGraphics/Graphics/ShaderLibrary.hxx>
 #include <GxBase/Storage/IFileSystem.hxx>
 #include <GxBase/Hash/XXHash.hxx>
 #include <GxBase/CommandLine.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+#include <GxBase/String.hxx>
 
 #if GX_PLATFORM_WINDOWS || GX_PLATFORM_UWP
 #include "Backends/D3DShaderCompilerBackend.hxx"
@@ -223,6 +228,205 @@ namespace Graphyte::AssetsPipeline
 
     IShaderCompilerBackend::~IShaderCompilerBackend() noexcept = default;
 
+    namespace
+    {
+        //
+        // Bump when compiled output changes, to invalidate cached data.
+        //
+
+        constexpr const uint32_t ShaderProcessorVersion = 1;
+
+        DerivedDataKey GetDerivedDataKey(
+            const ShaderCompilerInput& input,
+            const IShaderCompilerBackend& backend) noexcept
+        {
+            DerivedDataKeyBuilder builder{ "shader", ShaderProcessorVersion };
+
+            builder.Append(backend.GetName());
+            builder.Append(input.GetHash());
+            builder.Append(input.Source);
+
+            for (auto const& [name, value] : input.Definitions)
+            {
+                builder.Append(name);
+                builder.Append(value);
+            }
+
+            //
+            // Included files change compiled output as much as source does.
+            //
+
+            for (std::string const& include : input.Includes)
+            {
+                builder.Append(include);
+
+                [[maybe_unused]] Status const status = builder.AppendFile(include);
+            }
+
+            builder.AppendToolchain();
+
+            return builder.GetKey();
+        }
+
+        //
+        // Collects files included by source. Includes are resolved against directory of including
+        // file first, then against shared shaders directory, same as compilers do. Preprocessor
+        // conditions and comments are not evaluated, so scan may report more files than compiler
+        // reads, which only causes extra rebuilds.
+        //
+
+        void ScanIncludes(
+            std::vector<std::string>& result,
+            std::string_view source,
+            std::string_view directory,
+            std::string_view include_directory) noexcept
+        {
+            for (std::string_view line : Split(source, '\n'))
+            {
+                line = TrimLeft(line);
+
+                if (!line.starts_with('#'))
+                {
+                    continue;
+                }
+
+                line = TrimLeft(line.substr(1));
+
+                if (!line.starts_with("include"))
+                {
+                    continue;
+                }
+
+                line = TrimLeft(line.substr(7));
+
+                if (line.size() < 2 || (line.front() != '"' && line.front() != '<'))
+                {
+                    continue;
+                }
+
+                char const terminator = (line.front() == '"') ? '"' : '>';
+                size_t const end      = line.find(terminator, 1);
+
+                if (end == std::string_view::npos)
+                {
+                    continue;
+                }
+
+                std::string_view const name = line.substr(1, end - 1);
+
+                std::string path = Storage::CombinePath(directory, name);
+
+                if (Storage::IFileSystem::GetPlatformNative().Exists(path) != Status::Success)
+                {
+                    path = Storage::CombinePath(include_directory, name);
+
+                    if (Storage::IFileSystem::GetPlatformNative().Exists(path) != Status::Success)
+                    {
+                        //
+                        // Compiler reports missing files.
+                        //
+
+                        continue;
+                    }
+                }
+
+                if (std::find(result.begin(), result.end(), path) != result.end())
+                {
+                    continue;
+                }
+
+                std::string content{};
+
+                if (Storage::ReadText(content, path) != Status::Success)
+                {
+                    continue;
+                }
+
+                result.push_back(path);
+
+                ScanIncludes(result, content, Storage::GetPath(path), include_directory);
+            }
+        }
+
+        //
+        // Compiles shader, reusing cached bytecode when available.
+        //
+
+        bool CompileCached(
+            const IShaderCompilerBackend& backend,
+            ShaderCompilerInput& input,
+            ShaderCompilerOutput& output) noexcept
+        {
+            DerivedDataKey const key = GetDerivedDataKey(input, backend);
+
+            if (DerivedDataCache::Get().Get(key, output.Bytecode))
+            {
+                GX_LOG_INFO(LogShaderCompilerFrontend, "Using cached `{}` ({})\n", input.FileName, backend.GetName());
+                return true;
+            }
+
+            if (!backend.Compile(input, output))
+            {
+                return false;
+            }
+
+            DerivedDataCache::Get().Put(key, output.Bytecode);
+            return true;
+        }
+
+        //
+        // Permutations are expanded for every subset of defines, so their number grows quickly.
+        //
+
+        constexpr const size_t ShaderMaxPermutationDefines = 12;
+
+        struct ShaderTarget final
+        {
+            Graphics::GpuRenderAPI RenderAPI;
+            Graphics::GpuShaderProfile Profile;
+            IShaderCompilerBackend const* Backend;
+        };
+
+        struct ShaderPermutationJob final
+        {
+            ShaderTarget const* Target;
+            uint64_t Permutation;
+            ShaderCompilerOutput Output;
+            bool Succeeded;
+        };
+
+        //
+        // Parses list of targets, for example `vulkan:spirv_1_0, opengl:glsl_4_50`.
+        //
+
+        bool ParseShaderTargets(
+            std::vector<ShaderTarget>& result,
+            std::string_view value) noexcept
+        {
+            for (std::string_view target : Split(value, ','))
+            {
+                target = Trim(target);
+
+                size_t const separator = target.find(':');
+
+                if (separator == std::string_view::npos)
+                {
+                    return false;
+                }
+
+                ShaderTarget& current = result.emplace_back();
+                current.Backend       = nullptr;
+
+                if (!FromString(current.RenderAPI, Trim(target.substr(0, separator))) || !FromString(current.Profile, Trim(target.substr(separator + 1))))
+                {
+                    return false;
+                }
+            }
+
+            return !result.empty();
+        }
+    }
+
     ShaderProcessor::ShaderProcessor() noexcept
         : m_Backends{}
     {
@@ -238,155 +442,403 @@ namespace Graphyte::AssetsPipeline
 
     bool ShaderProcessor::Process(const AssetProcessorRequest& request, AssetProcessorResponse& response) noexcept
     {
-        (void)request;
-        (void)response;
-        return false;
-    }
+        response.Success = false;
 
-    bool ShaderProcessor::Process() noexcept
-    {
-        std::string_view path{};
-        std::string_view outputFilename{};
+        auto const report = [&](std::string message) {
+            GX_LOG_ERROR(LogShaderCompilerFrontend, "{}\n", message);
+            response.Log.push_back(std::move(message));
+            return false;
+        };
+
+        std::string_view const path           = request.SourcePath;
+        std::string_view const outputFilename = request.DestinationPath;
 
         ShaderCompilerInput input{};
         input.Platform  = System::PlatformType::Windows;
         input.RenderAPI = Graphics::GpuRenderAPI::OpenGL;
         input.Profile   = Graphics::GpuShaderProfile::GLSL_4_50;
 
-        if (auto option = CommandLine::Get("--input"); option.has_value())
+        if (auto option = request.Options.find("stage"); option != request.Options.end())
         {
-            path = option.value();
+            if (!FromString(input.Stage, option->second))
+            {
+                return report(fmt::format("Invalid stage type: {}", option->second));
+            }
         }
 
-        if (auto option = CommandLine::Get("--output"); option.has_value())
+        if (auto option = request.Options.find("platform"); option != request.Options.end())
         {
-            outputFilename = option.value();
+            if (!FromString(input.Platform, option->second))
+            {
+                return report(fmt::format("Invalid platform type: {}", option->second));
+            }
         }
 
-        if (auto option = CommandLine::Get("--stage"); option.has_value())
+        if (auto option = request.Options.find("render"); option != request.Options.end())
         {
-            auto value = option.value();
-
-            if (!FromString(input.Stage, value))
+            if (!FromString(input.RenderAPI, option->second))
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Invalid stage type: {}\n", value);
+                return report(fmt::format("Invalid render api type: {}", option->second));
             }
         }
 
-        if (auto option = CommandLine::Get("--platform"); option.has_value())
+        if (auto option = request.Options.find("profile"); option != request.Options.end())
         {
-            auto value = option.value();
+            if (!FromString(input.Profile, option->second))
+            {
+                return report(fmt::format("Invalid profile name: {}", option->second));
+            }
+        }
 
-            if (!FromString(input.Platform, value))
+        input.Definitions["ENABLE_ERROR"] = "1";
+
+        if (!path.empty())
+        {
+            if (Storage::ReadText(input.Source, std::string{ path }) != Status::Success)
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Invalid platform type: {}\n", value);
+                return report(fmt::format("Cannot read shader file: {}", path));
             }
         }
+        else
+        {
+            return report("Shader file not provided");
+        }
+
+        if (outputFilename.empty())
+        {
+            return report("Output file name not provided");
+        }
+
+        input.FileName = Storage::GetFilename(path);
 
-        if (auto option = CommandLine::Get("--render"); option.has_value())
+        ScanIncludes(
+            input.Includes,
+            input.Source,
+            Storage::GetPath(path),
+            Storage::CombinePath(Storage::GetProjectContentDirectory(), "shaders"));
+
+        response.Dependencies = input.Includes;
+
+        if (request.Options.contains("defines") || request.Options.contains("targets"))
         {
-            auto value = option.value();
+            return ProcessPermutations(input, request, response);
+        }
+
+        IShaderCompilerBackend const* backend = FindBackend(input);
 
-            if (!FromString(input.RenderAPI, value))
+        if (backend == nullptr)
+        {
+            return report(fmt::format("Cannot compile shader: `{}`", path));
+        }
+
+        ShaderCompilerOutput output{};
+
+        if (!CompileCached(*backend, input, output))
+        {
+            GX_LOG_ERROR(LogShaderCompilerFrontend, "Cannot compile shader: `{}`\n", path);
+
+            for (auto&& line : output.Log)
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Invalid render api type: {}\n", value);
+                GX_LOG_ERROR(LogShaderCompilerFrontend, "`{}`\n", line);
             }
+
+            response.Log = std::move(output.Log);
+            return false;
+        }
+
+        output.FileName = Storage::GetBaseFilename(outputFilename);
+        output.FileName += '.';
+        output.FileName += ToString(input.Stage);
+        output.FileName += ".shader";
+
+        Graphics::ShaderBytecode bytecode{};
+        bytecode.Bytecode  = output.Bytecode;
+        bytecode.Platform  = input.Platform;
+        bytecode.RenderAPI = input.RenderAPI;
+        bytecode.Profile   = input.Profile;
+        bytecode.Stage     = input.Stage;
+        bytecode.Flags     = input.EnableDebugInfo ? Graphics::ShaderBytecodeFlags::Debug : Graphics::ShaderBytecodeFlags::None;
+
+        auto content_path = Storage::CombinePath(
+            Storage::GetProjectContentDirectory(),
+            "shaders_compiled/",
+            ToString(input.Platform),
+            ToString(input.RenderAPI));
+
+        if (Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(content_path) != Status::Success)
+        {
+            return report(fmt::format("Cannot create directory: `{}`", content_path));
         }
 
-        if (auto option = CommandLine::Get("--profile"); option.has_value())
+        Storage::ArchiveFileWriterOptions const options{
+            .FlushSync = Storage::StreamSync::Data,
+        };
+
+        std::unique_ptr<Storage::Archive> writer{};
+
+        std::string output_path = Storage::CombinePath(content_path, output.FileName);
+
+        if (Storage::CreateWriter(writer, output_path, options) == Status::Success)
         {
-            auto value = option.value();
+            *writer << bytecode;
+            response.Outputs.push_back(std::move(output_path));
+            response.Success = true;
+            return true;
+        }
+
+        return report(fmt::format("Cannot write shader: `{}`", output.FileName));
+    }
+
+    bool ShaderProcessor::ProcessPermutations(
+        const ShaderCompilerInput& input,
+        const AssetProcessorRequest& request,
+        AssetProcessorResponse& response) noexcept
+    {
+        auto const report = [&](std::string message) {
+            GX_LOG_ERROR(LogShaderCompilerFrontend, "{}\n", message);
+            response.Log.push_back(std::move(message));
+            return false;
+        };
 
-            if (!FromString(input.Profile, value))
+        std::vector<std::string> defines{};
+
+        if (auto option = request.Options.find("defines"); option != request.Options.end())
+        {
+            for (std::string_view define : Split(option->second, ','))
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Invalid profile name: {}\n", value);
+                define = Trim(define);
+
+                if (!define.empty())
+                {
+                    defines.emplace_back(define);
+                }
             }
         }
 
-        input.Definitions["ENABLE_ERROR"] = "1";
+        if (defines.size() > ShaderMaxPermutationDefines)
+        {
+            return report(fmt::format("Too many permutation defines: {}, limit is {}", defines.size(), ShaderMaxPermutationDefines));
+        }
 
-        if (!path.empty())
+        std::vector<ShaderTarget> targets{};
+
+        if (auto option = request.Options.find("targets"); option != request.Options.end())
         {
-            if (Storage::ReadText(input.Source, std::string{ path }) != Status::Success)
+            if (!ParseShaderTargets(targets, option->second))
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Cannot read shader file: {}\n", path);
-                return false;
+                return report(fmt::format("Invalid targets: {}", option->second));
             }
         }
         else
         {
-            GX_LOG_ERROR(LogShaderCompilerFrontend, "Shader file not provided\n");
-            return false;
+            targets.push_back(ShaderTarget{ input.RenderAPI, input.Profile, nullptr });
         }
 
-        if (outputFilename.empty())
+        for (ShaderTarget& target : targets)
         {
-            GX_LOG_ERROR(LogShaderCompilerFrontend, "Output file name not provided\n");
-            return false;
+            ShaderCompilerInput probe{};
+            probe.Platform  = input.Platform;
+            probe.RenderAPI = target.RenderAPI;
+            probe.Profile   = target.Profile;
+            probe.Stage     = input.Stage;
+
+            target.Backend = FindBackend(probe);
+
+            if (target.Backend == nullptr)
+            {
+                return report(fmt::format("No backend supports {}:{}", ToString(target.RenderAPI), ToString(target.Profile)));
+            }
         }
 
-        input.FileName = Storage::GetFilename(path);
+        //
+        // Every permutation of every target is compiled independently. Jobs are expanded upfront,
+        // so results are collected in deterministic order regardless of scheduling.
+        //
+
+        uint64_t const permutations = uint64_t{ 1 } << defines.size();
 
-        for (auto&& backend : m_Backends)
+        std::vector<ShaderPermutationJob> jobs{};
+        jobs.reserve(targets.size() * permutations);
+
+        for (ShaderTarget const& target : targets)
         {
-            if (!backend->IsSupported(input))
+            for (uint64_t permutation = 0; permutation < permutations; ++permutation)
             {
-                continue;
+                jobs.push_back(ShaderPermutationJob{ &target, permutation, {}, false });
             }
+        }
 
-            ShaderCompilerOutput output{};
+        Threading::ParallelForRange(0, jobs.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                ShaderPermutationJob& job = jobs[i];
 
-            if (!backend->Compile(input, output))
+                ShaderCompilerInput variant = input;
+                variant.RenderAPI           = job.Target->RenderAPI;
+                variant.Profile             = job.Target->Profile;
+
+                for (size_t define = 0; define < defines.size(); ++define)
+                {
+                    if ((job.Permutation & (uint64_t{ 1 } << define)) != 0)
+                    {
+                        variant.Definitions[defines[define]] = "1";
+                    }
+                }
+
+                job.Succeeded = CompileCached(*job.Target->Backend, variant, job.Output);
+            }
+        },
+            1);
+
+        Graphics::ShaderLibrary library{};
+        library.Platform = input.Platform;
+        library.Flags    = input.EnableDebugInfo ? Graphics::ShaderBytecodeFlags::Debug : Graphics::ShaderBytecodeFlags::None;
+
+        [[maybe_unused]] Status const status = library.SetDefines(defines);
+        GX_ASSERT(status == Status::Success);
+
+        bool succeeded = true;
+
+        for (ShaderPermutationJob& job : jobs)
+        {
+            if (!job.Succeeded)
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Cannot compile shader: `{}`\n", path);
+                std::string enabled{};
 
-                for (auto&& line : output.Log)
+                for (size_t define = 0; define < defines.size(); ++define)
                 {
-                    GX_LOG_ERROR(LogShaderCompilerFrontend, "`{}`\n", line);
+                    if ((job.Permutation & (uint64_t{ 1 } << define)) != 0)
+                    {
+                        enabled += ' ';
+                        enabled += defines[define];
+                    }
                 }
 
-                return false;
+                report(fmt::format("Cannot compile `{}` for {}:{} with defines:{}",
+                    request.SourcePath,
+                    ToString(job.Target->RenderAPI),
+                    ToString(job.Target->Profile),
+                    enabled.empty() ? std::string_view{ " none" } : std::string_view{ enabled }));
+
+                for (std::string& line : job.Output.Log)
+                {
+                    response.Log.push_back(std::move(line));
+                }
+
+                succeeded = false;
+                continue;
             }
 
-            output.FileName = Storage::GetBaseFilename(outputFilename);
-            output.FileName += '.';
-            output.FileName += ToString(input.Stage);
-            output.FileName += ".shader";
-
-            Graphics::ShaderBytecode bytecode{};
-            bytecode.Bytecode  = output.Bytecode;
-            bytecode.Platform  = input.Platform;
-            bytecode.RenderAPI = input.RenderAPI;
-            bytecode.Profile   = input.Profile;
-            bytecode.Stage     = input.Stage;
-            bytecode.Flags     = input.EnableDebugInfo ? Graphics::ShaderBytecodeFlags::Debug : Graphics::ShaderBytecodeFlags::None;
-
-            auto content_path = Storage::CombinePath(
-                Storage::GetProjectContentDirectory(),
-                "shaders_compiled/",
-                ToString(input.Platform),
-                ToString(input.RenderAPI));
-
-            if (Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(content_path) != Status::Success)
+            //
+            // Library rejects duplicated targets and bytecode exceeding its pool size.
+            //
+
+            if (Status const added = library.Add(
+                    job.Permutation,
+                    job.Target->RenderAPI,
+                    job.Target->Profile,
+                    input.Stage,
+                    job.Output.Bytecode);
+                added != Status::Success)
             {
-                GX_LOG_ERROR(LogShaderCompilerFrontend, "Cannot create directory: `{}`\n", content_path);
-                return false;
+                report(fmt::format("Cannot add permutation {:#x} of `{}` for {}:{} to library: {}",
+                    job.Permutation,
+                    request.SourcePath,
+                    ToString(job.Target->RenderAPI),
+                    ToString(job.Target->Profile),
+                    added));
+
+                succeeded = false;
             }
+        }
+
+        if (!succeeded)
+        {
+            return false;
+        }
+
+        GX_LOG_INFO(LogShaderCompilerFrontend, "Compiled `{}`: {} permutations, {} unique blobs, {} bytes\n",
+            request.SourcePath,
+            library.GetEntries().size(),
+            library.GetBlobCount(),
+            library.GetBlobsSize());
+
+        auto content_path = Storage::CombinePath(
+            Storage::GetProjectContentDirectory(),
+            "shaders_compiled/",
+            ToString(input.Platform));
+
+        if (Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(content_path) != Status::Success)
+        {
+            return report(fmt::format("Cannot create directory: `{}`", content_path));
+        }
+
+        std::string output_path = Storage::CombinePath(
+            content_path,
+            fmt::format("{}.{}.shaderlib", Storage::GetBaseFilename(request.DestinationPath), ToString(input.Stage)));
+
+        Storage::ArchiveFileWriterOptions const options{
+            .FlushSync = Storage::StreamSync::Data,
+        };
+
+        std::unique_ptr<Storage::Archive> writer{};
+
+        if (Storage::CreateWriter(writer, output_path, options) != Status::Success)
+        {
+            return report(fmt::format("Cannot write shader library: `{}`", output_path));
+        }
 
-            std::unique_ptr<Storage::Archive> writer{};
+        *writer << library;
+        writer->Flush();
+
+        if (writer->IsError())
+        {
+            return report(fmt::format("Cannot write shader library: `{}`", output_path));
+        }
+
+        response.Outputs.push_back(std::move(output_path));
+        response.Success = true;
+        return true;
+    }
 
-            if (Storage::CreateWriter(writer, Storage::CombinePath(content_path, output.FileName)) == Status::Success)
+    IShaderCompilerBackend const* ShaderProcessor::FindBackend(
+        ShaderCompilerInput& input) const noexcept
+    {
+        for (auto const& backend : m_Backends)
+        {
+            if (backend->IsSupported(input))
             {
-                *writer << bytecode;
-                return true;
+                return backend.get();
             }
+        }
 
+        return nullptr;
+    }
 
-            return false;
+    bool ShaderProcessor::Process() noexcept
+    {
+        AssetProcessorRequest request{};
+
+        if (auto option = CommandLine::Get("--input"); option.has_value())
+        {
+            request.SourcePath = option.value();
         }
 
-        GX_LOG_ERROR(LogShaderCompilerFrontend, "Cannot compile shader: `{}`\n", path);
-        return false;
+        if (auto option = CommandLine::Get("--output"); option.has_value())
+        {
+            request.DestinationPath = option.value();
+        }
+
+        for (std::string_view name : { "stage", "platform", "render", "profile" })
+        {
+            if (auto option = CommandLine::Get(fmt::format("--{}", name)); option.has_value())
+            {
+                request.Options.emplace(name, option.value());
+            }
+        }
+
+        AssetProcessorResponse response{};
+        return Process(request, response);
     }
 
     //bool ShaderProcessor::Serialize(Serialization::Writer::Value& value) noexcept
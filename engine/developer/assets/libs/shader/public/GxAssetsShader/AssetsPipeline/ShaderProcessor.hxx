@@ -35,6 +35,9 @@ namespace Graphyte::AssetsPipeline
         std::string EntryName;
         std::map<std::string, std::string> Definitions;
 
+        /// @brief Paths of files included by source, directly or indirectly.
+        std::vector<std::string> Includes;
+
         System::PlatformType Platform;
         Graphics::GpuRenderAPI RenderAPI;
         Graphics::GpuShaderProfile Profile;
@@ -75,7 +78,12 @@ namespace Graphyte::AssetsPipeline
 
         virtual bool IsSupported(ShaderCompilerInput& input) const noexcept = 0;
 
+        /// @brief Compiles shader.
+        ///
+        /// @remarks Called concurrently when permutations are compiled in parallel.
         virtual bool Compile(ShaderCompilerInput& input, ShaderCompilerOutput& output) const noexcept = 0;
+
+        virtual std::string_view GetName() const noexcept = 0;
     };
 
     class ShaderProcessor final : public IAssetProcessor
@@ -91,6 +99,20 @@ namespace Graphyte::AssetsPipeline
 
         bool Process() noexcept override;
 
+    private:
+        /// @brief Compiles all permutations of defines for all targets into shader library.
+        ///
+        /// Manifest options:
+        ///     `defines = A, B` - names of permutation defines; every subset of them is compiled.
+        ///     `targets = vulkan:spirv_1_0, opengl:glsl_4_50` - render api and profile pairs.
+        bool ProcessPermutations(
+            const ShaderCompilerInput& input,
+            const AssetProcessorRequest& request,
+            AssetProcessorResponse& response) noexcept;
+
+        IShaderCompilerBackend const* FindBackend(
+            ShaderCompilerInput& input) const noexcept;
+
     public:
         //bool Serialize(Serialization::Writer::Value& value) noexcept override;
         //bool Deserialize(Serialization::Reader::Value& value) noexcept override;
@@ -0,0 +1,24 @@
+using Neobyte.Build.Framework;
+
+namespace Graphyte
+{
+    [ModuleRules]
+    public class TestGxAssetsBase
+        : ModuleRules
+    {
+        public TestGxAssetsBase(TargetRules target)
+            : base(target)
+        {
+            this.Type = ModuleType.Application;
+            this.Kind = ModuleKind.Test;
+            this.Language = ModuleLanguage.CPlusPlus;
+
+            this.PrivateDependencies.AddRange(new[]
+            {
+                typeof(GxBase),
+                typeof(GxAssetsBase),
+                typeof(GxTestExecutor),
+            });
+        }
+    }
+}
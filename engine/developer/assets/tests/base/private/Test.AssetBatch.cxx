@@ -0,0 +1,326 @@
+#include <catch2/catch.hpp>
+#include <GxAssetsBase/AssetsPipeline/AssetBatch.hxx>
+#include <GxAssetsBase/AssetsPipeline/AssetProcessorFactory.hxx>
+#include <GxBase/Threading.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Threading/TaskDispatcher.hxx>
+
+namespace
+{
+    //
+    // Records order and concurrency of processed assets.
+    //
+
+    struct TestProcessorState final
+    {
+        Graphyte::Threading::CriticalSection Lock{};
+        std::vector<std::string> Order{};
+        std::atomic<int> Running{};
+        std::atomic<int> Peak{};
+
+        void Reset() noexcept
+        {
+            Order.clear();
+            Running = 0;
+            Peak    = 0;
+        }
+
+        void Enter() noexcept
+        {
+            int const running = ++Running;
+            int peak          = Peak.load();
+
+            while (running > peak && !Peak.compare_exchange_weak(peak, running))
+            {
+            }
+        }
+
+        void Leave(std::string_view name) noexcept
+        {
+            {
+                Graphyte::Threading::ScopedLock<Graphyte::Threading::CriticalSection> lock{ Lock };
+                Order.emplace_back(name);
+            }
+
+            --Running;
+        }
+
+        size_t GetPosition(std::string_view name) noexcept
+        {
+            return static_cast<size_t>(std::find(Order.begin(), Order.end(), name) - Order.begin());
+        }
+    };
+
+    TestProcessorState g_TestProcessorState{};
+
+    class TestAssetProcessor final : public Graphyte::AssetsPipeline::IAssetProcessor
+    {
+    public:
+        bool Process(
+            const Graphyte::AssetsPipeline::AssetProcessorRequest& request,
+            Graphyte::AssetsPipeline::AssetProcessorResponse& response) noexcept override
+        {
+            g_TestProcessorState.Enter();
+            Graphyte::Threading::SleepThread(10);
+            g_TestProcessorState.Leave(request.DestinationPath);
+
+            if (request.Options.contains("fail"))
+            {
+                response.Log.emplace_back("failed on request");
+                return false;
+            }
+
+            return true;
+        }
+
+        bool Process() noexcept override
+        {
+            return false;
+        }
+    };
+
+    //
+    // Compiles permutations in parallel while holding memory budget, like shader processor does.
+    // Waiting for permutations executes other pending tasks on same thread.
+    //
+
+    class TestPermutationProcessor final : public Graphyte::AssetsPipeline::IAssetProcessor
+    {
+    public:
+        bool Process(
+            const Graphyte::AssetsPipeline::AssetProcessorRequest& request,
+            Graphyte::AssetsPipeline::AssetProcessorResponse& response) noexcept override
+        {
+            g_TestProcessorState.Enter();
+
+            std::atomic<size_t> compiled{};
+
+            Graphyte::Threading::ParallelForRange(0, 16, [&](size_t begin, size_t end) {
+                Graphyte::Threading::SleepThread(1);
+                compiled += end - begin;
+            },
+                1);
+
+            g_TestProcessorState.Leave(request.DestinationPath);
+
+            response.Outputs.push_back(request.DestinationPath);
+            return compiled == 16;
+        }
+
+        bool Process() noexcept override
+        {
+            return false;
+        }
+    };
+
+    std::unique_ptr<Graphyte::AssetsPipeline::IAssetProcessor> CreateTestAssetProcessor() noexcept
+    {
+        return std::make_unique<TestAssetProcessor>();
+    }
+
+    std::unique_ptr<Graphyte::AssetsPipeline::IAssetProcessor> CreateTestPermutationProcessor() noexcept
+    {
+        return std::make_unique<TestPermutationProcessor>();
+    }
+}
+
+TEST_CASE("Asset batch / manifest")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    std::vector<AssetBatchItem> items{};
+
+    SECTION("Valid manifest")
+    {
+        std::string_view const manifest = "# comment\n"
+                                          "[textures/noise]\n"
+                                          "processor = texture\n"
+                                          "source = textures/noise.png\n"
+                                          "output = noise\n"
+                                          "memory = 16\n"
+                                          "\n"
+                                          "; another comment\n"
+                                          "[shaders/basic]\n"
+                                          "processor=shader\n"
+                                          "source=/absolute/basic.hlsl\n"
+                                          "depends = textures/noise, , textures/ramp\n"
+                                          "stage = vs\n";
+
+        REQUIRE(ParseAssetBatchManifest(items, manifest, "content") == Status::Success);
+        REQUIRE(items.size() == 2);
+
+        CHECK(items[0].Name == "textures/noise");
+        CHECK(items[0].Processor == "texture");
+        CHECK(items[0].Request.SourcePath == "content/textures/noise.png");
+        CHECK(items[0].Request.DestinationPath == "noise");
+        CHECK(items[0].MemoryEstimate == (uint64_t{ 16 } << 20));
+        CHECK(items[0].Dependencies.empty());
+
+        CHECK(items[1].Name == "shaders/basic");
+        CHECK(items[1].Request.SourcePath == "/absolute/basic.hlsl");
+        CHECK(items[1].MemoryEstimate == 0);
+        CHECK(items[1].Dependencies == std::vector<std::string>{ "textures/noise", "textures/ramp" });
+        CHECK(items[1].Request.Options.at("stage") == "vs");
+    }
+
+    SECTION("Invalid manifests")
+    {
+        CHECK(ParseAssetBatchManifest(items, "key = outside section\n", "") == Status::InvalidFormat);
+        CHECK(ParseAssetBatchManifest(items, "[]\nprocessor = shader\n", "") == Status::InvalidFormat);
+        CHECK(ParseAssetBatchManifest(items, "[unterminated\nprocessor = shader\n", "") == Status::InvalidFormat);
+        CHECK(ParseAssetBatchManifest(items, "[asset]\nno separator\n", "") == Status::InvalidFormat);
+        CHECK(ParseAssetBatchManifest(items, "[asset]\nsource = file\n", "") == Status::InvalidFormat);
+        CHECK(ParseAssetBatchManifest(items, "[asset]\nprocessor = shader\nmemory = lots\n", "") == Status::InvalidFormat);
+    }
+}
+
+TEST_CASE("Asset batch / validation")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    std::vector<AssetBatchItem> items{};
+    AssetBatchBuilder builder{};
+
+    SECTION("Duplicated names")
+    {
+        REQUIRE(ParseAssetBatchManifest(items, "[a]\nprocessor = test\n[a]\nprocessor = test\n", "") == Status::Success);
+        CHECK(builder.SetItems(items) == Status::InvalidArgument);
+        CHECK(builder.GetSize() == 0);
+    }
+
+    SECTION("Unknown dependency")
+    {
+        REQUIRE(ParseAssetBatchManifest(items, "[a]\nprocessor = test\ndepends = b\n", "") == Status::Success);
+        CHECK(builder.SetItems(items) == Status::NotFound);
+        CHECK(builder.GetSize() == 0);
+    }
+
+    SECTION("Dependency cycle")
+    {
+        REQUIRE(ParseAssetBatchManifest(items, "[a]\nprocessor = test\ndepends = c\n[b]\nprocessor = test\ndepends = a\n[c]\nprocessor = test\ndepends = b\n[d]\nprocessor = test\n", "") == Status::Success);
+        CHECK(builder.SetItems(items) == Status::InvalidArgument);
+        CHECK(builder.GetSize() == 0);
+    }
+
+    SECTION("Self dependency")
+    {
+        REQUIRE(ParseAssetBatchManifest(items, "[a]\nprocessor = test\ndepends = a\n", "") == Status::Success);
+        CHECK(builder.SetItems(items) == Status::InvalidArgument);
+    }
+}
+
+TEST_CASE("Asset batch / build")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    auto& factory = AssetProcessorFactory::Get();
+    REQUIRE(factory.Register("test", AssetProcessorFactory::ActivateInstanceDelegate::Make<&CreateTestAssetProcessor>()));
+
+    g_TestProcessorState.Reset();
+
+    std::string manifest = "[texture]\nprocessor = test\noutput = texture\nmemory = 1\n"
+                           "[shader]\nprocessor = test\noutput = shader\ndepends = texture\nmemory = 1\n"
+                           "[material]\nprocessor = test\noutput = material\ndepends = shader, texture\nmemory = 1\n"
+                           "[broken]\nprocessor = test\noutput = broken\nfail = 1\nmemory = 1\n"
+                           "[dependent]\nprocessor = test\noutput = dependent\ndepends = broken\nmemory = 1\n"
+                           "[transitive]\nprocessor = test\noutput = transitive\ndepends = dependent\nmemory = 1\n"
+                           "[unknown]\nprocessor = missing\nmemory = 1\n";
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        manifest += fmt::format("[independent{0}]\nprocessor = test\noutput = independent{0}\nmemory = 1\n", i);
+    }
+
+    std::vector<AssetBatchItem> items{};
+    REQUIRE(ParseAssetBatchManifest(items, manifest, "") == Status::Success);
+
+    AssetBatchBuilder builder{};
+    REQUIRE(builder.SetItems(items) == Status::Success);
+
+    std::vector<AssetBatchRecord> records{};
+    CHECK(builder.Build(Threading::TaskDispatcher::GetInstance(), uint64_t{ 3 } << 20, records) == Status::Failure);
+    REQUIRE(records.size() == items.size());
+
+    SECTION("Dependencies are built first")
+    {
+        CHECK(g_TestProcessorState.GetPosition("texture") < g_TestProcessorState.GetPosition("shader"));
+        CHECK(g_TestProcessorState.GetPosition("shader") < g_TestProcessorState.GetPosition("material"));
+        CHECK(records[2].Result == AssetBatchResult::Succeeded);
+        CHECK(records[2].ProcessTime > 0.0);
+    }
+
+    SECTION("Failed dependency skips dependent assets")
+    {
+        CHECK(records[3].Result == AssetBatchResult::Failed);
+        CHECK(records[3].Log == std::vector<std::string>{ "failed on request" });
+        CHECK(records[4].Result == AssetBatchResult::Skipped);
+        CHECK(records[5].Result == AssetBatchResult::Skipped);
+        CHECK(g_TestProcessorState.GetPosition("dependent") == g_TestProcessorState.Order.size());
+        CHECK(g_TestProcessorState.GetPosition("transitive") == g_TestProcessorState.Order.size());
+    }
+
+    SECTION("Unknown processor fails asset")
+    {
+        CHECK(records[6].Result == AssetBatchResult::Failed);
+        CHECK_FALSE(records[6].Log.empty());
+    }
+
+    SECTION("Memory budget limits concurrency")
+    {
+        CHECK(g_TestProcessorState.Peak <= 3);
+
+        g_TestProcessorState.Reset();
+
+        items.erase(items.begin() + 3, items.begin() + 7);
+        REQUIRE(builder.SetItems(items) == Status::Success);
+        CHECK(builder.Build(Threading::TaskDispatcher::GetInstance(), 0, records) == Status::Success);
+        CHECK(g_TestProcessorState.Order.size() == items.size());
+    }
+
+    REQUIRE(factory.Unregister("test"));
+}
+
+TEST_CASE("Asset batch / nested waits with small memory budget")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    //
+    // Budget admits single asset at time. Waiting for permutations of one asset may pick up tasks
+    // of other assets on same thread; these must not block on budget held by their caller.
+    //
+
+    auto& factory = AssetProcessorFactory::Get();
+    REQUIRE(factory.Register("permutations", AssetProcessorFactory::ActivateInstanceDelegate::Make<&CreateTestPermutationProcessor>()));
+
+    g_TestProcessorState.Reset();
+
+    std::string manifest{};
+
+    for (size_t i = 0; i < 32; ++i)
+    {
+        manifest += fmt::format("[shader{0}]\nprocessor = permutations\noutput = shader{0}\nmemory = 1\n", i);
+    }
+
+    std::vector<AssetBatchItem> items{};
+    REQUIRE(ParseAssetBatchManifest(items, manifest, "") == Status::Success);
+
+    AssetBatchBuilder builder{};
+    REQUIRE(builder.SetItems(items) == Status::Success);
+
+    std::vector<AssetBatchRecord> records{};
+    CHECK(builder.Build(Threading::TaskDispatcher::GetInstance(), uint64_t{ 1 } << 20, records) == Status::Success);
+
+    //
+    // Assets waiting for budget are not dispatched, so nested waits never start another asset.
+    //
+
+    CHECK(g_TestProcessorState.Order.size() == items.size());
+    CHECK(g_TestProcessorState.Peak == 1);
+
+    REQUIRE(factory.Unregister("permutations"));
+}
@@ -0,0 +1,287 @@
+#include <catch2/catch.hpp>
+#include <GxAssetsBase/AssetsPipeline/AssetDependencyDatabase.hxx>
+#include <GxAssetsBase/AssetsPipeline/AssetProcessorFactory.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Threading/TaskDispatcher.hxx>
+
+namespace
+{
+    //
+    // Copies source to destination, reading optional `include` file as additional dependency.
+    //
+
+    std::atomic<int> g_CopyAssetProcessorCount{};
+
+    class CopyAssetProcessor final : public Graphyte::AssetsPipeline::IAssetProcessor
+    {
+    public:
+        bool Process(
+            const Graphyte::AssetsPipeline::AssetProcessorRequest& request,
+            Graphyte::AssetsPipeline::AssetProcessorResponse& response) noexcept override
+        {
+            using namespace Graphyte;
+
+            ++g_CopyAssetProcessorCount;
+
+            std::string content{};
+
+            if (Storage::ReadText(content, request.SourcePath) != Status::Success)
+            {
+                return false;
+            }
+
+            if (auto const include = request.Options.find("include"); include != request.Options.end())
+            {
+                std::string included{};
+
+                if (Storage::ReadText(included, include->second) != Status::Success)
+                {
+                    return false;
+                }
+
+                content += included;
+                response.Dependencies.push_back(include->second);
+            }
+
+            response.Outputs.push_back(request.DestinationPath);
+            return Storage::WriteText(content, request.DestinationPath) == Status::Success;
+        }
+
+        bool Process() noexcept override
+        {
+            return false;
+        }
+    };
+
+    std::unique_ptr<Graphyte::AssetsPipeline::IAssetProcessor> CreateCopyAssetProcessor() noexcept
+    {
+        return std::make_unique<CopyAssetProcessor>();
+    }
+
+    Graphyte::AssetsPipeline::AssetBatchItem MakeCopyAssetItem(
+        std::string_view root,
+        std::string_view name) noexcept
+    {
+        using namespace Graphyte;
+
+        AssetsPipeline::AssetBatchItem item{};
+        item.Name                    = name;
+        item.Processor               = "copy";
+        item.Request.SourcePath      = Storage::CombinePath(root, fmt::format("{}.txt", name));
+        item.Request.DestinationPath = Storage::CombinePath(root, fmt::format("{}.out", name));
+        item.MemoryEstimate          = 0;
+        return item;
+    }
+}
+
+TEST_CASE("Asset dependency database")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+    std::string const root = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.deps.", "");
+    REQUIRE(fs.DirectoryTreeCreate(root) == Status::Success);
+
+    AssetBatchItem item = MakeCopyAssetItem(root, "first");
+    std::string const include = Storage::CombinePath(root, "include.txt");
+
+    REQUIRE(Storage::WriteText("source", item.Request.SourcePath) == Status::Success);
+    REQUIRE(Storage::WriteText("include", include) == Status::Success);
+    REQUIRE(Storage::WriteText("output", item.Request.DestinationPath) == Status::Success);
+
+    AssetBatchRecord record{};
+    record.Name         = item.Name;
+    record.Result       = AssetBatchResult::Succeeded;
+    record.Dependencies = { include };
+    record.Outputs      = { item.Request.DestinationPath };
+
+    AssetDependencyDatabase database{};
+    CHECK(database.IsDirty(item));
+
+    database.Update(item, record);
+    REQUIRE(database.GetSize() == 1);
+    CHECK_FALSE(database.IsDirty(item));
+
+    SECTION("Changed settings")
+    {
+        item.Request.Options.insert_or_assign("stage", "vs");
+        CHECK(database.IsDirty(item));
+    }
+
+    SECTION("Changed source")
+    {
+        //
+        // Content of same size may keep modification time, so cached hash is dropped explicitly.
+        //
+
+        REQUIRE(Storage::WriteText("SOURCE", item.Request.SourcePath) == Status::Success);
+        database.Invalidate(item.Request.SourcePath);
+        CHECK(database.IsDirty(item));
+    }
+
+    SECTION("Unchanged content of invalidated source")
+    {
+        database.Invalidate(item.Request.SourcePath);
+        CHECK_FALSE(database.IsDirty(item));
+    }
+
+    SECTION("Changed dependency")
+    {
+        REQUIRE(Storage::WriteText("changed include", include) == Status::Success);
+        database.Invalidate(include);
+        CHECK(database.IsDirty(item));
+    }
+
+    SECTION("Missing dependency")
+    {
+        REQUIRE(fs.FileDelete(include) == Status::Success);
+        CHECK(database.IsDirty(item));
+    }
+
+    SECTION("Missing output")
+    {
+        REQUIRE(fs.FileDelete(item.Request.DestinationPath) == Status::Success);
+        CHECK(database.IsDirty(item));
+    }
+
+    SECTION("Removed asset")
+    {
+        database.Remove(item.Name);
+        CHECK(database.GetSize() == 0);
+        CHECK(database.IsDirty(item));
+    }
+
+    SECTION("Retained assets")
+    {
+        AssetBatchItem other = MakeCopyAssetItem(root, "second");
+        REQUIRE(Storage::WriteText("other", other.Request.SourcePath) == Status::Success);
+
+        database.Update(other, AssetBatchRecord{});
+        CHECK(database.GetSize() == 2);
+
+        std::vector<std::string> directories{};
+        database.GetInputDirectories(directories);
+        CHECK(directories == std::vector<std::string>{ std::string{ Storage::GetPath(item.Request.SourcePath) } });
+
+        database.Retain(std::span{ &other, 1 });
+        CHECK(database.GetSize() == 1);
+        CHECK(database.IsDirty(item));
+        CHECK_FALSE(database.IsDirty(other));
+    }
+
+    SECTION("Persistence")
+    {
+        std::string const path = Storage::CombinePath(root, "database", "assets.deps");
+
+        AssetDependencyDatabase loaded{};
+        CHECK(loaded.Load(path) == Status::NotFound);
+
+        REQUIRE(database.Save(path) == Status::Success);
+        REQUIRE(loaded.Load(path) == Status::Success);
+        CHECK(loaded.GetSize() == 1);
+        CHECK_FALSE(loaded.IsDirty(item));
+
+        REQUIRE(Storage::WriteText("garbage", path) == Status::Success);
+        CHECK(loaded.Load(path) != Status::Success);
+        CHECK(loaded.GetSize() == 0);
+    }
+
+    [[maybe_unused]] auto status = fs.DirectoryTreeDelete(root);
+}
+
+TEST_CASE("Asset batch / incremental build")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    auto& fs      = Storage::IFileSystem::GetPlatformNative();
+    auto& factory = AssetProcessorFactory::Get();
+
+    REQUIRE(factory.Register("copy", AssetProcessorFactory::ActivateInstanceDelegate::Make<&CreateCopyAssetProcessor>()));
+
+    std::string const root = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.batch.", "");
+    REQUIRE(fs.DirectoryTreeCreate(root) == Status::Success);
+
+    //
+    // Material depends on shader, which includes common file.
+    //
+
+    std::string const common = Storage::CombinePath(root, "common.txt");
+
+    std::vector<AssetBatchItem> items{
+        MakeCopyAssetItem(root, "texture"),
+        MakeCopyAssetItem(root, "shader"),
+        MakeCopyAssetItem(root, "material"),
+    };
+
+    items[1].Request.Options.insert_or_assign("include", common);
+    items[2].Dependencies.push_back("shader");
+
+    for (AssetBatchItem const& item : items)
+    {
+        REQUIRE(Storage::WriteText(item.Name, item.Request.SourcePath) == Status::Success);
+    }
+
+    REQUIRE(Storage::WriteText("common", common) == Status::Success);
+
+    AssetBatchBuilder builder{};
+    REQUIRE(builder.SetItems(items) == Status::Success);
+
+    AssetDependencyDatabase database{};
+    std::vector<AssetBatchRecord> records{};
+
+    auto const build = [&]() {
+        g_CopyAssetProcessorCount = 0;
+        return builder.Build(Threading::TaskDispatcher::GetInstance(), 0, records, &database);
+    };
+
+    REQUIRE(build() == Status::Success);
+    CHECK(g_CopyAssetProcessorCount == 3);
+
+    SECTION("Nothing changed")
+    {
+        REQUIRE(build() == Status::Success);
+        CHECK(g_CopyAssetProcessorCount == 0);
+
+        for (AssetBatchRecord const& record : records)
+        {
+            CHECK(record.Result == AssetBatchResult::UpToDate);
+        }
+    }
+
+    SECTION("Changed include rebuilds dependent assets")
+    {
+        REQUIRE(Storage::WriteText("changed common", common) == Status::Success);
+        database.Invalidate(common);
+
+        REQUIRE(build() == Status::Success);
+        CHECK(g_CopyAssetProcessorCount == 2);
+        CHECK(records[0].Result == AssetBatchResult::UpToDate);
+        CHECK(records[1].Result == AssetBatchResult::Succeeded);
+        CHECK(records[2].Result == AssetBatchResult::Succeeded);
+    }
+
+    SECTION("Failed asset is built again")
+    {
+        REQUIRE(fs.FileDelete(common) == Status::Success);
+
+        CHECK(build() == Status::Failure);
+        CHECK(records[1].Result == AssetBatchResult::Failed);
+        CHECK(records[2].Result == AssetBatchResult::Skipped);
+
+        REQUIRE(Storage::WriteText("common", common) == Status::Success);
+
+        REQUIRE(build() == Status::Success);
+        CHECK(g_CopyAssetProcessorCount == 2);
+        CHECK(records[0].Result == AssetBatchResult::UpToDate);
+    }
+
+    [[maybe_unused]] auto status = fs.DirectoryTreeDelete(root);
+
+    REQUIRE(factory.Unregister("copy"));
+}
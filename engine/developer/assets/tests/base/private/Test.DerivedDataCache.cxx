@@ -0,0 +1,150 @@
+#include <catch2/catch.hpp>
+#include <GxAssetsBase/AssetsPipeline/DerivedDataCache.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+
+TEST_CASE("Derived data / keys")
+{
+    using namespace Graphyte::AssetsPipeline;
+
+    DerivedDataKey const first  = DerivedDataKeyBuilder{ "shader", 1 }.Append(std::string_view{ "source" }).GetKey();
+    DerivedDataKey const second = DerivedDataKeyBuilder{ "shader", 1 }.Append(std::string_view{ "other" }).GetKey();
+    DerivedDataKey const third  = DerivedDataKeyBuilder{ "shader", 2 }.Append(std::string_view{ "source" }).GetKey();
+    DerivedDataKey const fourth = DerivedDataKeyBuilder{ "mesh", 1 }.Append(std::string_view{ "source" }).GetKey();
+
+    CHECK(first == DerivedDataKeyBuilder{ "shader", 1 }.Append(std::string_view{ "source" }).GetKey());
+    CHECK_FALSE(first == second);
+    CHECK_FALSE(first == third);
+    CHECK_FALSE(first == fourth);
+
+    //
+    // Order of appended values matters.
+    //
+
+    CHECK_FALSE(DerivedDataKeyBuilder{ "x", 1 }.Append(1).Append(2).GetKey() == DerivedDataKeyBuilder{ "x", 1 }.Append(2).Append(1).GetKey());
+
+    DerivedDataKey parsed{};
+    REQUIRE(DerivedDataKey::FromString(parsed, first.ToString()));
+    CHECK(parsed == first);
+    CHECK_FALSE(DerivedDataKey::FromString(parsed, "not a key"));
+}
+
+TEST_CASE("Derived data / directory store")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::AssetsPipeline;
+
+    auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+    std::string const root = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.ddc.", "");
+
+    std::vector<std::byte> const payload(1000, std::byte{ 0x2A });
+
+    //
+    // Each entry takes 40 bytes of header and 1000 bytes of payload.
+    //
+
+    constexpr uint64_t EntrySize = 1040;
+
+    DerivedDataKey const first  = DerivedDataKeyBuilder{ "test", 1 }.Append(1).GetKey();
+    DerivedDataKey const second = DerivedDataKeyBuilder{ "test", 1 }.Append(2).GetKey();
+    DerivedDataKey const third  = DerivedDataKeyBuilder{ "test", 1 }.Append(3).GetKey();
+
+    SECTION("Least recently used entries are evicted")
+    {
+        DirectoryDerivedDataStore store{ root, EntrySize * 2 + 100 };
+
+        std::vector<std::byte> data{};
+        CHECK(store.Get(first, data) == Status::NotFound);
+
+        REQUIRE(store.Put(first, payload) == Status::Success);
+        REQUIRE(store.Put(second, payload) == Status::Success);
+        CHECK(store.GetSize() == EntrySize * 2);
+
+        REQUIRE(store.Get(first, data) == Status::Success);
+        CHECK(data == payload);
+
+        REQUIRE(store.Put(third, payload) == Status::Success);
+        CHECK(store.GetEvictions() == 1);
+        CHECK(store.GetSize() == EntrySize * 2);
+
+        CHECK(store.Get(second, data) == Status::NotFound);
+        CHECK(store.Get(first, data) == Status::Success);
+        CHECK(store.Get(third, data) == Status::Success);
+    }
+
+    SECTION("Order of use persists in index")
+    {
+        {
+            DirectoryDerivedDataStore store{ root, EntrySize * 3 };
+            REQUIRE(store.Put(first, payload) == Status::Success);
+            REQUIRE(store.Put(second, payload) == Status::Success);
+            REQUIRE(store.Put(third, payload) == Status::Success);
+
+            std::vector<std::byte> data{};
+            REQUIRE(store.Get(first, data) == Status::Success);
+        }
+
+        //
+        // Reopened store evicts second entry, because first one was used after it.
+        //
+
+        DirectoryDerivedDataStore store{ root, EntrySize * 2 };
+        CHECK(store.GetSize() == EntrySize * 2);
+        CHECK(store.GetEvictions() == 1);
+
+        std::vector<std::byte> data{};
+        CHECK(store.Get(second, data) == Status::NotFound);
+        CHECK(store.Get(first, data) == Status::Success);
+        CHECK(store.Get(third, data) == Status::Success);
+    }
+
+    SECTION("Corrupted entry is removed")
+    {
+        DirectoryDerivedDataStore store{ root, 0 };
+        REQUIRE(store.Put(first, payload) == Status::Success);
+
+        std::string const name = first.ToString();
+        std::string path       = Storage::CombinePath(root, std::string_view{ name }.substr(0, 2));
+        Storage::AppendPath(path, name);
+        path.append(".ddc");
+
+        std::vector<std::byte> content{};
+        REQUIRE(Storage::ReadBinary(content, path) == Status::Success);
+        content.back() ^= std::byte{ 0xFF };
+        REQUIRE(Storage::WriteBinary(content, path) == Status::Success);
+
+        std::vector<std::byte> data{};
+        CHECK(store.Get(first, data) == Status::InvalidFormat);
+        CHECK(data.empty());
+        CHECK(fs.Exists(path) != Status::Success);
+        CHECK(store.Get(first, data) == Status::NotFound);
+    }
+
+    SECTION("Cache prefers local store and fills it from shared store")
+    {
+        {
+            DirectoryDerivedDataStore shared{ root, 0 };
+            REQUIRE(shared.Put(first, payload) == Status::Success);
+        }
+
+        DerivedDataCache cache{};
+        cache.SetLocalStore(std::make_unique<DirectoryDerivedDataStore>(Storage::CombinePath(root, "local"), 0));
+        cache.SetSharedStore(std::make_unique<DirectoryDerivedDataStore>(root, 0));
+
+        std::vector<std::byte> data{};
+        CHECK(cache.Get(first, data));
+        CHECK(cache.Get(first, data));
+        CHECK(data == payload);
+        CHECK_FALSE(cache.Get(second, data));
+
+        DerivedDataStatistics const statistics = cache.GetStatistics();
+        CHECK(statistics.SharedHits == 1);
+        CHECK(statistics.LocalHits == 1);
+        CHECK(statistics.Misses == 1);
+    }
+
+    [[maybe_unused]] auto status = fs.DirectoryTreeDelete(root);
+}
@@ -9,6 +9,11 @@
 #include <zlib.h>
 #endif
 
+#if GX_SDKS_WITH_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
 
 #if GX_SDKS_WITH_ZLIB
 namespace Graphyte::Compression::Impl
@@ -37,7 +42,8 @@ namespace Graphyte::Compression::Impl
             size_t& compressed_size,
             const void* decompressed_buffer,
             size_t decompressed_size,
-            size_t bit_window) noexcept
+            size_t bit_window,
+            int level) noexcept
         {
             auto z_compressed_size   = static_cast<uLongf>(compressed_size);
             auto z_decompressed_size = static_cast<uLongf>(decompressed_size);
@@ -46,11 +52,12 @@ namespace Graphyte::Compression::Impl
 
             if (bit_window == ZlibHelper::DEFAULT_BIT_WINDOW)
             {
-                result = compress(
+                result = compress2(
                              reinterpret_cast<Bytef*>(compressed_buffer),
                              &z_compressed_size,
                              reinterpret_cast<const Bytef*>(decompressed_buffer),
-                             z_decompressed_size)
+                             z_decompressed_size,
+                             level)
                          == Z_OK;
             }
             else
@@ -67,7 +74,7 @@ namespace Graphyte::Compression::Impl
 
                 int status = deflateInit2_(
                     &stream,
-                    Z_DEFAULT_COMPRESSION,
+                    level,
                     Z_DEFLATED,
                     static_cast<int>(bit_window),
                     MAX_MEM_LEVEL,
@@ -165,10 +172,177 @@ namespace Graphyte::Compression::Impl
 }
 #endif
 
+#if GX_SDKS_WITH_ZSTD
+namespace Graphyte::Compression::Impl
+{
+    struct CompressionDictionaryState final
+    {
+        ZSTD_CDict* Compress;
+        ZSTD_DDict* Decompress;
+    };
+
+    //
+    // Creating Zstd contexts is expensive. Contexts are cached per thread and reused.
+    //
+
+    class ZstdHelper final
+    {
+    private:
+        ZSTD_CCtx* m_Compress{};
+        ZSTD_DCtx* m_Decompress{};
+
+    public:
+        ~ZstdHelper() noexcept
+        {
+            ZSTD_freeCCtx(m_Compress);
+            ZSTD_freeDCtx(m_Decompress);
+        }
+
+    private:
+        static ZstdHelper& Get() noexcept
+        {
+            thread_local ZstdHelper t_Helper{};
+            return t_Helper;
+        }
+
+    public:
+        static bool CompressMemory(
+            void* compressed_buffer,
+            size_t& compressed_size,
+            const void* decompressed_buffer,
+            size_t decompressed_size,
+            const CompressionParameters& parameters,
+            const CompressionDictionaryState* dictionary) noexcept
+        {
+            ZstdHelper& helper = Get();
+
+            if (helper.m_Compress == nullptr)
+            {
+                helper.m_Compress = ZSTD_createCCtx();
+
+                if (helper.m_Compress == nullptr)
+                {
+                    return false;
+                }
+            }
+
+            size_t result{};
+
+            if (dictionary != nullptr)
+            {
+                result = ZSTD_compress_usingCDict(
+                    helper.m_Compress,
+                    compressed_buffer,
+                    compressed_size,
+                    decompressed_buffer,
+                    decompressed_size,
+                    dictionary->Compress);
+            }
+            else
+            {
+                ZSTD_CCtx_reset(helper.m_Compress, ZSTD_reset_session_and_parameters);
+
+                ZSTD_CCtx_setParameter(
+                    helper.m_Compress,
+                    ZSTD_c_compressionLevel,
+                    (parameters.Level != 0) ? parameters.Level : ZSTD_CLEVEL_DEFAULT);
+
+                if (parameters.LongDistanceMatching)
+                {
+                    ZSTD_CCtx_setParameter(helper.m_Compress, ZSTD_c_enableLongDistanceMatching, 1);
+                }
+
+                if (parameters.WindowLog != 0)
+                {
+                    ZSTD_CCtx_setParameter(helper.m_Compress, ZSTD_c_windowLog, static_cast<int>(parameters.WindowLog));
+                }
+
+                result = ZSTD_compress2(
+                    helper.m_Compress,
+                    compressed_buffer,
+                    compressed_size,
+                    decompressed_buffer,
+                    decompressed_size);
+            }
+
+            if (ZSTD_isError(result))
+            {
+                compressed_size = 0;
+                return false;
+            }
+
+            compressed_size = result;
+            return true;
+        }
+
+        static bool DecompressMemory(
+            void* decompressed_buffer,
+            size_t decompressed_size,
+            const void* compressed_buffer,
+            size_t compressed_size,
+            const CompressionDictionaryState* dictionary) noexcept
+        {
+            ZstdHelper& helper = Get();
+
+            if (helper.m_Decompress == nullptr)
+            {
+                helper.m_Decompress = ZSTD_createDCtx();
+
+                if (helper.m_Decompress == nullptr)
+                {
+                    return false;
+                }
+
+                //
+                // Blocks compressed with long distance matching may use windows larger than
+                // default decoder limit.
+                //
+
+                ZSTD_DCtx_setParameter(
+                    helper.m_Decompress,
+                    ZSTD_d_windowLogMax,
+                    ZSTD_dParam_getBounds(ZSTD_d_windowLogMax).upperBound);
+            }
+
+            size_t result{};
+
+            if (dictionary != nullptr)
+            {
+                result = ZSTD_decompress_usingDDict(
+                    helper.m_Decompress,
+                    decompressed_buffer,
+                    decompressed_size,
+                    compressed_buffer,
+                    compressed_size,
+                    dictionary->Decompress);
+            }
+            else
+            {
+                result = ZSTD_decompressDCtx(
+                    helper.m_Decompress,
+                    decompressed_buffer,
+                    decompressed_size,
+                    compressed_buffer,
+                    compressed_size);
+            }
+
+            return !ZSTD_isError(result) && (result == decompressed_size);
+        }
+    };
+}
+#else
+namespace Graphyte::Compression::Impl
+{
+    struct CompressionDictionaryState final
+    {
+    };
+}
+#endif
+
 namespace Graphyte::Compression
 {
 #if GX_SDKS_WITH_ZLIB
-    constexpr const int BitWindow = ZlibHelper::DEFAULT_BIT_WINDOW;
+    constexpr const int BitWindow = Impl::ZlibHelper::DEFAULT_BIT_WINDOW;
 #endif
 
     size_t MemoryBound(
@@ -188,9 +362,9 @@ namespace Graphyte::Compression
                 break;
             }
 #if GX_SDKS_WITH_ZLIB
-            case CompressionMethod::Zlib:
+            case CompressionMethod::ZLib:
             {
-                if constexpr (BitWindow == ZlibHelper::DEFAULT_BIT_WINDOW)
+                if constexpr (BitWindow == Impl::ZlibHelper::DEFAULT_BIT_WINDOW)
                 {
                     return static_cast<size_t>(compressBound(static_cast<uLong>(size)));
                 }
@@ -199,6 +373,12 @@ namespace Graphyte::Compression
                     return size + ((size + 7U) >> 3U) + ((size + 63U) >> 6U) + 5U + 6U;
                 }
             }
+#endif
+#if GX_SDKS_WITH_ZSTD
+            case CompressionMethod::Zstd:
+            {
+                return ZSTD_compressBound(size);
+            }
 #endif
             default:
             {
@@ -210,8 +390,50 @@ namespace Graphyte::Compression
         return 0;
     }
 
+    bool IsSupported(
+        CompressionMethod method) noexcept
+    {
+        switch (method)
+        {
+            case CompressionMethod::LZ4:
+            case CompressionMethod::LZ4HC:
+#if GX_SDKS_WITH_ZLIB
+            case CompressionMethod::ZLib:
+#endif
+#if GX_SDKS_WITH_ZSTD
+            case CompressionMethod::Zstd:
+#endif
+            {
+                return true;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        return false;
+    }
+
+    bool CompressBlock(
+        CompressionMethod method,
+        void* output_buffer,
+        size_t& output_size,
+        const void* input_buffer,
+        size_t input_size) noexcept
+    {
+        return Compression::CompressBlock(
+            method,
+            CompressionParameters{},
+            output_buffer,
+            output_size,
+            input_buffer,
+            input_size);
+    }
+
     bool CompressBlock(
         CompressionMethod method,
+        const CompressionParameters& parameters,
         void* output_buffer,
         size_t& output_size,
         const void* input_buffer,
@@ -236,7 +458,7 @@ namespace Graphyte::Compression
                         static_cast<char*>(output_buffer),
                         static_cast<int>(input_size),
                         static_cast<int>(output_size),
-                        LZ4HC_CLEVEL_OPT_MIN);
+                        (parameters.Level != 0) ? parameters.Level : LZ4HC_CLEVEL_OPT_MIN);
                 }
                 else
                 {
@@ -256,14 +478,27 @@ namespace Graphyte::Compression
                 break;
             }
 #if GX_SDKS_WITH_ZLIB
-            case CompressionMethod::Zlib:
+            case CompressionMethod::ZLib:
             {
-                return ZlibHelper::CompressMemory(
+                return Impl::ZlibHelper::CompressMemory(
                     output_buffer,
                     output_size,
                     input_buffer,
                     input_size,
-                    BitWindow);
+                    BitWindow,
+                    (parameters.Level != 0) ? parameters.Level : Z_DEFAULT_COMPRESSION);
+            }
+#endif
+#if GX_SDKS_WITH_ZSTD
+            case CompressionMethod::Zstd:
+            {
+                return Impl::ZstdHelper::CompressMemory(
+                    output_buffer,
+                    output_size,
+                    input_buffer,
+                    input_size,
+                    parameters,
+                    nullptr);
             }
 #endif
             default:
@@ -308,15 +543,26 @@ namespace Graphyte::Compression
                 break;
             }
 #if GX_SDKS_WITH_ZLIB
-            case CompressionMethod::Zlib:
+            case CompressionMethod::ZLib:
             {
-                return ZlibHelper::DecompressMemory(
+                return Impl::ZlibHelper::DecompressMemory(
                     output_buffer,
                     output_size,
                     input_buffer,
                     input_size,
                     BitWindow);
             }
+#endif
+#if GX_SDKS_WITH_ZSTD
+            case CompressionMethod::Zstd:
+            {
+                return Impl::ZstdHelper::DecompressMemory(
+                    output_buffer,
+                    output_size,
+                    input_buffer,
+                    input_size,
+                    nullptr);
+            }
 #endif
             default:
             {
@@ -424,4 +670,166 @@ namespace Graphyte::Compression
             std::data(input),
             std::size(input));
     }
+
+    CompressionDictionary::CompressionDictionary() noexcept = default;
+
+    CompressionDictionary::CompressionDictionary(
+        std::vector<std::byte> content,
+        [[maybe_unused]] int32_t level) noexcept
+        : m_Content{ std::move(content) }
+        , m_State{}
+    {
+#if GX_SDKS_WITH_ZSTD
+        if (!m_Content.empty())
+        {
+            ZSTD_CDict* const compress = ZSTD_createCDict(
+                m_Content.data(),
+                m_Content.size(),
+                (level != 0) ? level : ZSTD_CLEVEL_DEFAULT);
+
+            ZSTD_DDict* const decompress = ZSTD_createDDict(
+                m_Content.data(),
+                m_Content.size());
+
+            if (compress != nullptr && decompress != nullptr)
+            {
+                m_State = std::make_unique<Impl::CompressionDictionaryState>(Impl::CompressionDictionaryState{
+                    .Compress   = compress,
+                    .Decompress = decompress,
+                });
+            }
+            else
+            {
+                GX_LOG_ERROR(LogPlatform, "Cannot create compression dictionary\n");
+                ZSTD_freeCDict(compress);
+                ZSTD_freeDDict(decompress);
+            }
+        }
+#endif
+    }
+
+    CompressionDictionary::~CompressionDictionary() noexcept
+    {
+#if GX_SDKS_WITH_ZSTD
+        if (m_State != nullptr)
+        {
+            ZSTD_freeCDict(m_State->Compress);
+            ZSTD_freeDDict(m_State->Decompress);
+        }
+#endif
+    }
+
+    CompressionDictionary::CompressionDictionary(CompressionDictionary&& other) noexcept = default;
+
+    CompressionDictionary& CompressionDictionary::operator=(CompressionDictionary&& other) noexcept
+    {
+        if (this != &other)
+        {
+            CompressionDictionary temporary{ std::move(other) };
+            std::swap(m_Content, temporary.m_Content);
+            std::swap(m_State, temporary.m_State);
+        }
+
+        return *this;
+    }
+
+    uint32_t CompressionDictionary::GetId() const noexcept
+    {
+#if GX_SDKS_WITH_ZSTD
+        return ZDICT_getDictID(m_Content.data(), m_Content.size());
+#else
+        return 0;
+#endif
+    }
+
+    bool TrainDictionary(
+        [[maybe_unused]] std::vector<std::byte>& output,
+        [[maybe_unused]] std::span<const std::span<const std::byte>> samples,
+        [[maybe_unused]] size_t capacity) noexcept
+    {
+#if GX_SDKS_WITH_ZSTD
+        //
+        // Trainer requires samples stored in single buffer.
+        //
+
+        std::vector<std::byte> buffer{};
+        std::vector<size_t> sizes{};
+
+        sizes.reserve(samples.size());
+
+        for (auto const& sample : samples)
+        {
+            buffer.insert(buffer.end(), sample.begin(), sample.end());
+            sizes.push_back(sample.size());
+        }
+
+        output.resize(capacity);
+
+        size_t const result = ZDICT_trainFromBuffer(
+            output.data(),
+            output.size(),
+            buffer.data(),
+            sizes.data(),
+            static_cast<unsigned>(sizes.size()));
+
+        if (ZDICT_isError(result))
+        {
+            GX_LOG_ERROR(LogPlatform, "Cannot train compression dictionary: {}\n", ZDICT_getErrorName(result));
+            output.clear();
+            return false;
+        }
+
+        output.resize(result);
+        return true;
+#else
+        GX_LOG_ERROR(LogPlatform, "Compression dictionaries are not supported\n");
+        return false;
+#endif
+    }
+
+    bool CompressBlock(
+        const CompressionDictionary& dictionary,
+        [[maybe_unused]] void* output_buffer,
+        size_t& output_size,
+        [[maybe_unused]] const void* input_buffer,
+        [[maybe_unused]] size_t input_size) noexcept
+    {
+        if (dictionary.IsValid())
+        {
+#if GX_SDKS_WITH_ZSTD
+            return Impl::ZstdHelper::CompressMemory(
+                output_buffer,
+                output_size,
+                input_buffer,
+                input_size,
+                CompressionParameters{},
+                dictionary.GetState());
+#endif
+        }
+
+        output_size = 0;
+        return false;
+    }
+
+    bool DecompressBlock(
+        const CompressionDictionary& dictionary,
+        [[maybe_unused]] void* output_buffer,
+        [[maybe_unused]] size_t output_size,
+        [[maybe_unused]] const void* input_buffer,
+        [[maybe_unused]] size_t input_size) noexcept
+    {
+        if (dictionary.IsValid())
+        {
+#if GX_SDKS_WITH_ZSTD
+            return Impl::ZstdHelper::DecompressMemory(
+                output_buffer,
+                output_size,
+                input_buffer,
+                input_size,
+                dictionary.GetState());
+#endif
+        }
+
+        return false;
+    }
 }
@@ -0,0 +1,616 @@
+#include <GxBase/Compression/CompressedStream.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+#include "Frame.Impl.hxx"
+
+namespace Graphyte::Compression
+{
+    CompressedStreamWriter::CompressedStreamWriter(
+        std::unique_ptr<Storage::IStream> stream,
+        const FrameOptions& options) noexcept
+        : m_Stream{ std::move(stream) }
+        , m_Options{ options }
+        , m_ContentHash{ 0 }
+        , m_Pending{}
+        , m_Available{}
+        , m_Current{}
+        , m_FrameStart{}
+        , m_ContentSize{}
+        , m_Status{ Status::Success }
+        , m_Finished{ false }
+    {
+        GX_ASSERT(m_Stream != nullptr);
+
+        Impl::FrameHeader const header = Impl::MakeFrameHeader(m_Options);
+
+        m_Options.BlockSize = size_t{ 1 } << header.BlockSizeLog2;
+
+        if (m_Options.Concurrency == 0)
+        {
+            m_Options.Concurrency = std::max<size_t>(Threading::TaskDispatcher::GetInstance().GetWorkerCount(), 1) * 2;
+        }
+
+        m_FrameStart = m_Stream->GetPosition();
+
+        std::array<std::byte, Impl::FrameHeaderSize> buffer;
+        Impl::WriteFrameHeader(buffer, header);
+        WriteOutput(buffer);
+    }
+
+    CompressedStreamWriter::~CompressedStreamWriter() noexcept
+    {
+        if (!m_Finished)
+        {
+            [[maybe_unused]] Status const status = Finish();
+        }
+    }
+
+    Status CompressedStreamWriter::Finish() noexcept
+    {
+        if (m_Finished)
+        {
+            return m_Status;
+        }
+
+        m_Finished = true;
+
+        if (m_Current != nullptr && !m_Current->Input.empty())
+        {
+            SubmitBlock();
+        }
+
+        while (!m_Pending.empty())
+        {
+            WriteBlock();
+        }
+
+        std::array<std::byte, sizeof(uint32_t) + Impl::FrameChecksumSize> end;
+        size_t end_size = sizeof(uint32_t);
+
+        Impl::StoreFrameValue<uint32_t>(&end[0], 0);
+
+        if (m_Options.ContentChecksum)
+        {
+            Impl::StoreFrameValue<uint64_t>(&end[sizeof(uint32_t)], m_ContentHash.GetValue());
+            end_size += Impl::FrameChecksumSize;
+        }
+
+        WriteOutput({ end.data(), end_size });
+
+        if (m_Status == Status::Success)
+        {
+            //
+            // Content size is not known until frame ends. Header is updated only when underlying
+            // stream supports seeking.
+            //
+
+            int64_t const position = m_Stream->GetPosition();
+
+            if (m_Stream->SetPosition(m_FrameStart) == Status::Success)
+            {
+                Impl::FrameHeader header = Impl::MakeFrameHeader(m_Options);
+                header.Flags |= Impl::FrameFlagContentSize;
+                header.ContentSize = m_ContentSize;
+
+                std::array<std::byte, Impl::FrameHeaderSize> buffer;
+                Impl::WriteFrameHeader(buffer, header);
+                WriteOutput(buffer);
+
+                if (m_Stream->SetPosition(position) != Status::Success)
+                {
+                    m_Status = Status::WriteFault;
+                }
+            }
+        }
+
+        if (m_Status == Status::Success)
+        {
+            m_Status = m_Stream->Flush();
+        }
+
+        return m_Status;
+    }
+
+    Status CompressedStreamWriter::Flush() noexcept
+    {
+        //
+        // Waiting for blocks being compressed would serialize compression when flushed frequently.
+        //
+
+        while (!m_Pending.empty() && (!m_Pending.front()->Task.IsValid() || m_Pending.front()->Task.IsCompleted()))
+        {
+            WriteBlock();
+        }
+
+        if (m_Status != Status::Success)
+        {
+            return m_Status;
+        }
+
+        return m_Stream->Flush();
+    }
+
+    Status CompressedStreamWriter::Read(
+        [[maybe_unused]] std::span<std::byte> buffer,
+        size_t& processed) noexcept
+    {
+        processed = 0;
+        return Status::NotSupported;
+    }
+
+    Status CompressedStreamWriter::Write(
+        std::span<const std::byte> buffer,
+        size_t& processed) noexcept
+    {
+        processed = 0;
+
+        if (m_Finished)
+        {
+            return Status::WriteFault;
+        }
+
+        if (m_Status != Status::Success)
+        {
+            return m_Status;
+        }
+
+        if (m_Options.ContentChecksum)
+        {
+            m_ContentHash.Update(buffer.data(), buffer.size());
+        }
+
+        while (!buffer.empty())
+        {
+            if (m_Current == nullptr)
+            {
+                if (m_Available.empty())
+                {
+                    m_Current = std::make_unique<Block>();
+                    m_Current->Input.reserve(m_Options.BlockSize);
+                }
+                else
+                {
+                    m_Current = std::move(m_Available.back());
+                    m_Available.pop_back();
+                }
+            }
+
+            size_t const count = std::min(buffer.size(), m_Options.BlockSize - m_Current->Input.size());
+
+            m_Current->Input.insert(m_Current->Input.end(), buffer.begin(), buffer.begin() + static_cast<ptrdiff_t>(count));
+
+            buffer = buffer.subspan(count);
+            processed += count;
+            m_ContentSize += count;
+
+            if (m_Current->Input.size() == m_Options.BlockSize)
+            {
+                SubmitBlock();
+            }
+        }
+
+        return m_Status;
+    }
+
+    int64_t CompressedStreamWriter::GetSize() noexcept
+    {
+        return static_cast<int64_t>(m_ContentSize);
+    }
+
+    int64_t CompressedStreamWriter::GetPosition() noexcept
+    {
+        return static_cast<int64_t>(m_ContentSize);
+    }
+
+    Status CompressedStreamWriter::SetPosition(
+        [[maybe_unused]] int64_t value,
+        [[maybe_unused]] Storage::SeekOrigin origin) noexcept
+    {
+        return Status::NotSupported;
+    }
+
+    Status CompressedStreamWriter::SetPosition(
+        [[maybe_unused]] int64_t value) noexcept
+    {
+        return Status::NotSupported;
+    }
+
+    void CompressedStreamWriter::SubmitBlock() noexcept
+    {
+        if (m_Pending.size() >= m_Options.Concurrency)
+        {
+            WriteBlock();
+        }
+
+        Block* const block = m_Current.get();
+
+        CompressionMethod const method         = m_Options.Method;
+        CompressionParameters const parameters = m_Options.Parameters;
+        bool const checksum                    = m_Options.BlockChecksum;
+
+        Threading::TaskDispatcher& dispatcher = Threading::TaskDispatcher::GetInstance();
+
+        if (dispatcher.GetWorkerCount() != 0)
+        {
+            block->Task = dispatcher.Schedule([block, method, parameters, checksum]() {
+                block->Result = Impl::EncodeFrameBlock(block->Output, method, parameters, block->Input, checksum);
+            });
+        }
+        else
+        {
+            block->Result = Impl::EncodeFrameBlock(block->Output, method, parameters, block->Input, checksum);
+        }
+
+        m_Pending.push_back(std::move(m_Current));
+    }
+
+    void CompressedStreamWriter::WriteBlock() noexcept
+    {
+        std::unique_ptr<Block> block = std::move(m_Pending.front());
+        m_Pending.pop_front();
+
+        if (block->Task.IsValid())
+        {
+            block->Task.Wait();
+            block->Task = Threading::TaskHandle{};
+        }
+
+        if (block->Result)
+        {
+            WriteOutput(block->Output);
+        }
+        else if (m_Status == Status::Success)
+        {
+            GX_LOG_ERROR(LogPlatform, "Failed to compress block\n");
+            m_Status = Status::Failure;
+        }
+
+        block->Input.clear();
+        m_Available.push_back(std::move(block));
+    }
+
+    void CompressedStreamWriter::WriteOutput(
+        std::span<const std::byte> buffer) noexcept
+    {
+        if (m_Status == Status::Success)
+        {
+            size_t processed{};
+
+            if (Status const status = m_Stream->Write(buffer, processed); status != Status::Success)
+            {
+                m_Status = status;
+            }
+            else if (processed != buffer.size())
+            {
+                m_Status = Status::WriteFault;
+            }
+        }
+    }
+}
+
+namespace Graphyte::Compression
+{
+    CompressedStreamReader::CompressedStreamReader(
+        std::unique_ptr<Storage::IStream> stream) noexcept
+        : m_Stream{ std::move(stream) }
+        , m_ContentHash{ 0 }
+        , m_Compressed{}
+        , m_Block{}
+        , m_BlockPosition{}
+        , m_FrameStart{}
+        , m_Position{}
+        , m_ContentSize{}
+        , m_BlockSize{}
+        , m_Method{}
+        , m_Flags{}
+        , m_Status{ Status::Success }
+        , m_End{ false }
+        , m_Hashing{ true }
+    {
+        GX_ASSERT(m_Stream != nullptr);
+
+        m_FrameStart = m_Stream->GetPosition();
+
+        std::array<std::byte, Impl::FrameHeaderSize> buffer;
+        Impl::FrameHeader header{};
+
+        m_Status = ReadExact(buffer);
+
+        if (m_Status == Status::Success)
+        {
+            m_Status = Impl::ReadFrameHeader(header, buffer);
+        }
+        else
+        {
+            m_Status = Status::InvalidFormat;
+        }
+
+        if (m_Status == Status::Success)
+        {
+            m_Method      = header.Method;
+            m_Flags       = header.Flags;
+            m_BlockSize   = size_t{ 1 } << header.BlockSizeLog2;
+            m_ContentSize = header.ContentSize;
+        }
+    }
+
+    CompressedStreamReader::~CompressedStreamReader() noexcept
+    {
+    }
+
+    Status CompressedStreamReader::Flush() noexcept
+    {
+        return Status::Success;
+    }
+
+    Status CompressedStreamReader::Read(
+        std::span<std::byte> buffer,
+        size_t& processed) noexcept
+    {
+        processed = 0;
+
+        if (m_Status != Status::Success)
+        {
+            return m_Status;
+        }
+
+        while (!buffer.empty())
+        {
+            if (m_BlockPosition == m_Block.size())
+            {
+                if (m_End)
+                {
+                    return Status::EndOfStream;
+                }
+
+                if (Status const status = NextBlock(-1); status != Status::Success)
+                {
+                    m_Status = status;
+                    return status;
+                }
+
+                continue;
+            }
+
+            size_t const count = std::min(buffer.size(), m_Block.size() - m_BlockPosition);
+
+            std::memcpy(buffer.data(), m_Block.data() + m_BlockPosition, count);
+
+            buffer = buffer.subspan(count);
+            processed += count;
+            m_BlockPosition += count;
+            m_Position += static_cast<int64_t>(count);
+        }
+
+        return Status::Success;
+    }
+
+    Status CompressedStreamReader::Write(
+        [[maybe_unused]] std::span<const std::byte> buffer,
+        size_t& processed) noexcept
+    {
+        processed = 0;
+        return Status::NotSupported;
+    }
+
+    int64_t CompressedStreamReader::GetSize() noexcept
+    {
+        if ((m_Flags & Impl::FrameFlagContentSize) != 0)
+        {
+            return static_cast<int64_t>(m_ContentSize);
+        }
+
+        return -1;
+    }
+
+    int64_t CompressedStreamReader::GetPosition() noexcept
+    {
+        return m_Position;
+    }
+
+    Status CompressedStreamReader::SetPosition(
+        int64_t value,
+        Storage::SeekOrigin origin) noexcept
+    {
+        switch (origin)
+        {
+            case Storage::SeekOrigin::Begin:
+                return SetPosition(value);
+
+            case Storage::SeekOrigin::Current:
+                return SetPosition(m_Position + value);
+
+            case Storage::SeekOrigin::End:
+            {
+                int64_t const size = GetSize();
+
+                if (size < 0)
+                {
+                    return Status::NotSupported;
+                }
+
+                return SetPosition(size + value);
+            }
+        }
+
+        return Status::InvalidArgument;
+    }
+
+    Status CompressedStreamReader::SetPosition(
+        int64_t value) noexcept
+    {
+        if (m_Status != Status::Success)
+        {
+            return m_Status;
+        }
+
+        if (value < 0)
+        {
+            return Status::InvalidArgument;
+        }
+
+        if (value < (m_Position - static_cast<int64_t>(m_BlockPosition)))
+        {
+            if (Status const status = Restart(); status != Status::Success)
+            {
+                return status;
+            }
+        }
+
+        while (true)
+        {
+            int64_t const block_start = m_Position - static_cast<int64_t>(m_BlockPosition);
+            int64_t const block_end   = block_start + static_cast<int64_t>(m_Block.size());
+
+            if (value <= block_end)
+            {
+                m_BlockPosition = static_cast<size_t>(value - block_start);
+                m_Position      = value;
+                return Status::Success;
+            }
+
+            if (m_End)
+            {
+                return Status::EndOfStream;
+            }
+
+            m_Position      = block_end;
+            m_BlockPosition = m_Block.size();
+
+            if (Status const status = NextBlock(value); status != Status::Success)
+            {
+                m_Status = status;
+                return status;
+            }
+        }
+    }
+
+    Status CompressedStreamReader::Restart() noexcept
+    {
+        if (Status const status = m_Stream->SetPosition(m_FrameStart + static_cast<int64_t>(Impl::FrameHeaderSize)); status != Status::Success)
+        {
+            return status;
+        }
+
+        m_ContentHash   = Hash::XXHash64{ 0 };
+        m_Hashing       = true;
+        m_End           = false;
+        m_Position      = 0;
+        m_BlockPosition = 0;
+        m_Block.clear();
+
+        return Status::Success;
+    }
+
+    Status CompressedStreamReader::ReadExact(
+        std::span<std::byte> buffer) noexcept
+    {
+        size_t processed{};
+
+        Status const status = m_Stream->Read(buffer, processed);
+
+        if (status == Status::Success && processed != buffer.size())
+        {
+            return Status::EndOfStream;
+        }
+
+        return status;
+    }
+
+    Status CompressedStreamReader::NextBlock(
+        int64_t skip_until) noexcept
+    {
+        m_Block.clear();
+        m_BlockPosition = 0;
+
+        std::array<std::byte, Impl::FrameBlockHeaderSize> header;
+
+        if (Status const status = ReadExact({ header.data(), sizeof(uint32_t) }); status != Status::Success)
+        {
+            return status;
+        }
+
+        uint32_t const compressed = Impl::LoadFrameValue<uint32_t>(&header[0]);
+
+        if (compressed == 0)
+        {
+            m_End = true;
+
+            if ((m_Flags & Impl::FrameFlagContentChecksum) != 0)
+            {
+                std::array<std::byte, Impl::FrameChecksumSize> checksum;
+
+                if (Status const status = ReadExact(checksum); status != Status::Success)
+                {
+                    return status;
+                }
+
+                if (m_Hashing && (Impl::LoadFrameValue<uint64_t>(checksum.data()) != m_ContentHash.GetValue()))
+                {
+                    GX_LOG_ERROR(LogPlatform, "Compressed frame content checksum mismatch\n");
+                    return Status::InvalidFormat;
+                }
+            }
+
+            return Status::Success;
+        }
+
+        if (Status const status = ReadExact({ header.data() + sizeof(uint32_t), sizeof(uint32_t) }); status != Status::Success)
+        {
+            return status;
+        }
+
+        uint32_t const decompressed = Impl::LoadFrameValue<uint32_t>(&header[4]);
+        size_t const size           = compressed & ~Impl::FrameBlockStored;
+        size_t const checksum_size  = ((m_Flags & Impl::FrameFlagBlockChecksum) != 0) ? Impl::FrameChecksumSize : 0;
+
+        if (decompressed > m_BlockSize)
+        {
+            return Status::InvalidFormat;
+        }
+
+        if ((m_Position + static_cast<int64_t>(decompressed)) <= skip_until)
+        {
+            //
+            // Block is skipped entirely, content checksum can't be validated anymore.
+            //
+
+            m_Hashing = false;
+            m_Position += decompressed;
+            return m_Stream->SetPosition(m_Stream->GetPosition() + static_cast<int64_t>(size + checksum_size), Storage::SeekOrigin::Begin);
+        }
+
+        m_Compressed.resize(size + checksum_size);
+
+        if (Status const status = ReadExact(m_Compressed); status != Status::Success)
+        {
+            return status;
+        }
+
+        if (checksum_size != 0)
+        {
+            uint64_t const expected = Impl::LoadFrameValue<uint64_t>(m_Compressed.data() + size);
+
+            if (Hash::XXHash64::Hash(m_Compressed.data(), size, 0) != expected)
+            {
+                GX_LOG_ERROR(LogPlatform, "Compressed frame block checksum mismatch\n");
+                return Status::InvalidFormat;
+            }
+        }
+
+        m_Block.resize(decompressed);
+
+        if (Status const status = Impl::DecodeFrameBlock(m_Block, m_Method, { m_Compressed.data(), size }, (compressed & Impl::FrameBlockStored) != 0); status != Status::Success)
+        {
+            m_Block.clear();
+            return status;
+        }
+
+        if (m_Hashing && ((m_Flags & Impl::FrameFlagContentChecksum) != 0))
+        {
+            m_ContentHash.Update(m_Block.data(), m_Block.size());
+        }
+
+        return Status::Success;
+    }
+}
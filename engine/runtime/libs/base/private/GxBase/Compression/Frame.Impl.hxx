@@ -0,0 +1,101 @@
+#pragma once
+#include <GxBase/Compression.hxx>
+
+// =================================================================================================
+//
+// Compressed frame format.
+//
+// Layout:
+//
+//  header: signature (u32), version (u8), method (u8), flags (u8), block size log2 (u8),
+//          content size (u64)
+//
+//  blocks: compressed size (u32), decompressed size (u32), data, checksum (u64, optional)
+//
+//  end:    zero (u32), content checksum (u64, optional)
+//
+//  Highest bit of compressed size marks block stored without compression. Block checksum is
+//  computed from stored data. Content size is valid only when flag is set.
+//
+
+namespace Graphyte::Compression::Impl
+{
+    constexpr const uint32_t FrameSignature = 0x46435847;
+    constexpr const uint8_t FrameVersion    = 1;
+
+    constexpr const uint8_t FrameFlagBlockChecksum   = 1 << 0;
+    constexpr const uint8_t FrameFlagContentChecksum = 1 << 1;
+    constexpr const uint8_t FrameFlagContentSize     = 1 << 2;
+
+    constexpr const uint32_t FrameBlockStored = 0x8000'0000;
+
+    constexpr const size_t FrameHeaderSize      = 16;
+    constexpr const size_t FrameBlockHeaderSize = 8;
+    constexpr const size_t FrameChecksumSize    = 8;
+
+    constexpr const uint32_t FrameMinBlockSizeLog2 = 16;
+    constexpr const uint32_t FrameMaxBlockSizeLog2 = 26;
+
+    struct FrameHeader final
+    {
+        CompressionMethod Method;
+        uint8_t Flags;
+        uint8_t BlockSizeLog2;
+        uint64_t ContentSize;
+    };
+
+    [[nodiscard]] FrameHeader MakeFrameHeader(
+        const FrameOptions& options) noexcept;
+
+    void WriteFrameHeader(
+        std::span<std::byte, FrameHeaderSize> output,
+        const FrameHeader& header) noexcept;
+
+    Status ReadFrameHeader(
+        FrameHeader& header,
+        std::span<const std::byte, FrameHeaderSize> input) noexcept;
+
+    /// @brief Compresses single block with block header and optional checksum.
+    ///
+    /// @param output     Returns encoded block.
+    /// @param method     Provides compression method.
+    /// @param parameters Provides compression parameters.
+    /// @param input      Provides block data.
+    /// @param checksum   Specifies whether block checksum is written.
+    ///
+    /// @return Value indicating whether block was compressed successfully.
+    [[nodiscard]] bool EncodeFrameBlock(
+        std::vector<std::byte>& output,
+        CompressionMethod method,
+        const CompressionParameters& parameters,
+        std::span<const std::byte> input,
+        bool checksum) noexcept;
+
+    /// @brief Decompresses block data.
+    ///
+    /// @param output Provides buffer of block decompressed size.
+    /// @param method Provides compression method.
+    /// @param input  Provides block data.
+    /// @param stored Specifies whether block data is stored without compression.
+    ///
+    /// @return The status code.
+    Status DecodeFrameBlock(
+        std::span<std::byte> output,
+        CompressionMethod method,
+        std::span<const std::byte> input,
+        bool stored) noexcept;
+
+    template <typename T>
+    T LoadFrameValue(const std::byte* input) noexcept
+    {
+        T result;
+        std::memcpy(&result, input, sizeof(T));
+        return result;
+    }
+
+    template <typename T>
+    void StoreFrameValue(std::byte* output, T value) noexcept
+    {
+        std::memcpy(output, &value, sizeof(T));
+    }
+}
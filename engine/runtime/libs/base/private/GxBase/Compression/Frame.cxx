@@ -0,0 +1,372 @@
+#include <GxBase/Compression.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+#include "Frame.Impl.hxx"
+
+namespace Graphyte::Compression::Impl
+{
+    FrameHeader MakeFrameHeader(
+        const FrameOptions& options) noexcept
+    {
+        uint8_t flags = 0;
+
+        if (options.BlockChecksum)
+        {
+            flags |= FrameFlagBlockChecksum;
+        }
+
+        if (options.ContentChecksum)
+        {
+            flags |= FrameFlagContentChecksum;
+        }
+
+        uint32_t const block_size_log2 = std::clamp<uint32_t>(
+            static_cast<uint32_t>(std::bit_width(std::max<size_t>(options.BlockSize, 1) - 1)),
+            FrameMinBlockSizeLog2,
+            FrameMaxBlockSizeLog2);
+
+        return FrameHeader{
+            .Method        = options.Method,
+            .Flags         = flags,
+            .BlockSizeLog2 = static_cast<uint8_t>(block_size_log2),
+            .ContentSize   = 0,
+        };
+    }
+
+    void WriteFrameHeader(
+        std::span<std::byte, FrameHeaderSize> output,
+        const FrameHeader& header) noexcept
+    {
+        StoreFrameValue<uint32_t>(&output[0], FrameSignature);
+        StoreFrameValue<uint8_t>(&output[4], FrameVersion);
+        StoreFrameValue<uint8_t>(&output[5], static_cast<uint8_t>(header.Method));
+        StoreFrameValue<uint8_t>(&output[6], header.Flags);
+        StoreFrameValue<uint8_t>(&output[7], header.BlockSizeLog2);
+        StoreFrameValue<uint64_t>(&output[8], header.ContentSize);
+    }
+
+    Status ReadFrameHeader(
+        FrameHeader& header,
+        std::span<const std::byte, FrameHeaderSize> input) noexcept
+    {
+        if (LoadFrameValue<uint32_t>(&input[0]) != FrameSignature)
+        {
+            return Status::InvalidFormat;
+        }
+
+        if (LoadFrameValue<uint8_t>(&input[4]) != FrameVersion)
+        {
+            return Status::NotSupported;
+        }
+
+        header.Method        = static_cast<CompressionMethod>(LoadFrameValue<uint8_t>(&input[5]));
+        header.Flags         = LoadFrameValue<uint8_t>(&input[6]);
+        header.BlockSizeLog2 = LoadFrameValue<uint8_t>(&input[7]);
+        header.ContentSize   = LoadFrameValue<uint64_t>(&input[8]);
+
+        if (header.BlockSizeLog2 < FrameMinBlockSizeLog2 || header.BlockSizeLog2 > FrameMaxBlockSizeLog2)
+        {
+            return Status::InvalidFormat;
+        }
+
+        if (MemoryBound(header.Method, 0) == 0)
+        {
+            return Status::NotSupported;
+        }
+
+        return Status::Success;
+    }
+
+    bool EncodeFrameBlock(
+        std::vector<std::byte>& output,
+        CompressionMethod method,
+        const CompressionParameters& parameters,
+        std::span<const std::byte> input,
+        bool checksum) noexcept
+    {
+        size_t const bound = MemoryBound(method, input.size());
+
+        if (bound == 0)
+        {
+            return false;
+        }
+
+        output.resize(FrameBlockHeaderSize + std::max(bound, input.size()) + FrameChecksumSize);
+
+        std::byte* const data = output.data() + FrameBlockHeaderSize;
+
+        size_t size    = bound;
+        uint32_t flags = 0;
+
+        if (!CompressBlock(method, parameters, data, size, input.data(), input.size()) || size >= input.size())
+        {
+            //
+            // Incompressible block is stored as is, so it is not expanded and decompression is
+            // simple copy.
+            //
+
+            std::memcpy(data, input.data(), input.size());
+            size  = input.size();
+            flags = FrameBlockStored;
+        }
+
+        StoreFrameValue<uint32_t>(output.data(), static_cast<uint32_t>(size) | flags);
+        StoreFrameValue<uint32_t>(output.data() + 4, static_cast<uint32_t>(input.size()));
+
+        size_t encoded = FrameBlockHeaderSize + size;
+
+        if (checksum)
+        {
+            StoreFrameValue<uint64_t>(output.data() + encoded, Hash::XXHash64::Hash(data, size, 0));
+            encoded += FrameChecksumSize;
+        }
+
+        output.resize(encoded);
+        return true;
+    }
+
+    Status DecodeFrameBlock(
+        std::span<std::byte> output,
+        CompressionMethod method,
+        std::span<const std::byte> input,
+        bool stored) noexcept
+    {
+        if (stored)
+        {
+            if (input.size() != output.size())
+            {
+                return Status::InvalidFormat;
+            }
+
+            std::memcpy(output.data(), input.data(), input.size());
+            return Status::Success;
+        }
+
+        if (output.empty() || !DecompressBlock(method, output.data(), output.size(), input.data(), input.size()))
+        {
+            return Status::InvalidFormat;
+        }
+
+        return Status::Success;
+    }
+}
+
+namespace Graphyte::Compression
+{
+    bool CompressFrame(
+        std::vector<std::byte>& output,
+        std::span<const std::byte> input,
+        const FrameOptions& options) noexcept
+    {
+        Impl::FrameHeader header = Impl::MakeFrameHeader(options);
+        header.Flags |= Impl::FrameFlagContentSize;
+        header.ContentSize = input.size();
+
+        size_t const block_size  = size_t{ 1 } << header.BlockSizeLog2;
+        size_t const block_count = (input.size() + block_size - 1) / block_size;
+
+        std::vector<std::vector<std::byte>> blocks(block_count);
+        std::atomic<bool> failed{ false };
+
+        Threading::ParallelForRange(
+            0,
+            block_count,
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    size_t const offset = i * block_size;
+
+                    if (!Impl::EncodeFrameBlock(blocks[i], options.Method, options.Parameters, input.subspan(offset, std::min(block_size, input.size() - offset)), options.BlockChecksum))
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            },
+            1);
+
+        if (failed.load())
+        {
+            output.clear();
+            return false;
+        }
+
+        size_t size = Impl::FrameHeaderSize + sizeof(uint32_t);
+
+        if (options.ContentChecksum)
+        {
+            size += Impl::FrameChecksumSize;
+        }
+
+        for (auto const& block : blocks)
+        {
+            size += block.size();
+        }
+
+        output.resize(size);
+
+        Impl::WriteFrameHeader(std::span<std::byte, Impl::FrameHeaderSize>{ output.data(), Impl::FrameHeaderSize }, header);
+
+        std::byte* it = output.data() + Impl::FrameHeaderSize;
+
+        for (auto const& block : blocks)
+        {
+            std::memcpy(it, block.data(), block.size());
+            it += block.size();
+        }
+
+        Impl::StoreFrameValue<uint32_t>(it, 0);
+        it += sizeof(uint32_t);
+
+        if (options.ContentChecksum)
+        {
+            Impl::StoreFrameValue<uint64_t>(it, Hash::XXHash64::Hash(input.data(), input.size(), 0));
+        }
+
+        return true;
+    }
+
+    Status DecompressFrame(
+        std::vector<std::byte>& output,
+        std::span<const std::byte> input) noexcept
+    {
+        output.clear();
+
+        if (input.size() < Impl::FrameHeaderSize)
+        {
+            return Status::InvalidFormat;
+        }
+
+        Impl::FrameHeader header{};
+
+        if (Status const status = Impl::ReadFrameHeader(header, input.first<Impl::FrameHeaderSize>()); status != Status::Success)
+        {
+            return status;
+        }
+
+        //
+        // Scan block headers first, so blocks may be decompressed in parallel directly to output.
+        //
+
+        struct BlockInfo final
+        {
+            size_t Source;
+            size_t Target;
+            uint32_t CompressedSize;
+            uint32_t DecompressedSize;
+            bool Stored;
+        };
+
+        std::vector<BlockInfo> blocks{};
+
+        size_t const block_size    = size_t{ 1 } << header.BlockSizeLog2;
+        size_t const checksum_size = ((header.Flags & Impl::FrameFlagBlockChecksum) != 0) ? Impl::FrameChecksumSize : 0;
+        size_t position            = Impl::FrameHeaderSize;
+        size_t content_size        = 0;
+
+        while (true)
+        {
+            if ((input.size() - position) < sizeof(uint32_t))
+            {
+                return Status::EndOfStream;
+            }
+
+            uint32_t const compressed = Impl::LoadFrameValue<uint32_t>(&input[position]);
+
+            if (compressed == 0)
+            {
+                position += sizeof(uint32_t);
+                break;
+            }
+
+            if ((input.size() - position) < Impl::FrameBlockHeaderSize)
+            {
+                return Status::EndOfStream;
+            }
+
+            BlockInfo const block{
+                .Source           = position + Impl::FrameBlockHeaderSize,
+                .Target           = content_size,
+                .CompressedSize   = compressed & ~Impl::FrameBlockStored,
+                .DecompressedSize = Impl::LoadFrameValue<uint32_t>(&input[position + 4]),
+                .Stored           = (compressed & Impl::FrameBlockStored) != 0,
+            };
+
+            if (block.DecompressedSize > block_size)
+            {
+                return Status::InvalidFormat;
+            }
+
+            if ((input.size() - block.Source) < (block.CompressedSize + checksum_size))
+            {
+                return Status::EndOfStream;
+            }
+
+            blocks.push_back(block);
+
+            position = block.Source + block.CompressedSize + checksum_size;
+            content_size += block.DecompressedSize;
+        }
+
+        if (((header.Flags & Impl::FrameFlagContentSize) != 0) && (header.ContentSize != content_size))
+        {
+            return Status::InvalidFormat;
+        }
+
+        output.resize(content_size);
+
+        std::atomic<bool> failed{ false };
+
+        Threading::ParallelForRange(
+            0,
+            blocks.size(),
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    BlockInfo const& block = blocks[i];
+
+                    std::span<const std::byte> const source = input.subspan(block.Source, block.CompressedSize);
+
+                    if (checksum_size != 0)
+                    {
+                        uint64_t const expected = Impl::LoadFrameValue<uint64_t>(&input[block.Source + block.CompressedSize]);
+
+                        if (Hash::XXHash64::Hash(source.data(), source.size(), 0) != expected)
+                        {
+                            failed.store(true, std::memory_order_relaxed);
+                            continue;
+                        }
+                    }
+
+                    if (Impl::DecodeFrameBlock({ output.data() + block.Target, block.DecompressedSize }, header.Method, source, block.Stored) != Status::Success)
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            },
+            1);
+
+        if (!failed.load() && ((header.Flags & Impl::FrameFlagContentChecksum) != 0))
+        {
+            if ((input.size() - position) < Impl::FrameChecksumSize)
+            {
+                output.clear();
+                return Status::EndOfStream;
+            }
+
+            uint64_t const expected = Impl::LoadFrameValue<uint64_t>(&input[position]);
+
+            failed = Hash::XXHash64::Hash(output.data(), output.size(), 0) != expected;
+        }
+
+        if (failed.load())
+        {
+            GX_LOG_ERROR(LogPlatform, "Compressed frame is corrupted\n");
+            output.clear();
+            return Status::InvalidFormat;
+        }
+
+        return Status::Success;
+    }
+}
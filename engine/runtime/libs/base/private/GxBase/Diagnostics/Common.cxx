@@ -48,6 +48,13 @@ namespace Graphyte::Diagnostics::Impl
 
     void FinishLogOutput() noexcept
     {
+        //
+        // Write pending messages.
+        //
+
+        Impl::StopLogWriter();
+
+
         //
         // Flush file log.
         //
@@ -188,11 +195,17 @@ namespace Graphyte::Diagnostics
 
             if (Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(log_path) == Status::Success)
             {
+                //
+                // Binary log defers formatting of messages to decoder tool.
+                //
+
+                bool const binary = CommandLine::Get("--log-binary").has_value();
+
                 std::string const& executable = System::GetExecutableName();
                 std::string timestamp{};
                 ToString(timestamp, DateTime::Now(), DateTimeFormat::FileSafe);
 
-                Storage::AppendPath(log_path, fmt::format("{}-{}.txt", executable, timestamp));
+                Storage::AppendPath(log_path, fmt::format("{}-{}.{}", executable, timestamp, binary ? "gxlog" : "txt"));
 
                 Status status = Storage::IFileSystem::GetPlatformNative().OpenWrite(
                     Impl::g_LogOutputFile,
@@ -201,8 +214,44 @@ namespace Graphyte::Diagnostics
                     true);
 
                 GX_ABORT_UNLESS(status == Status::Success, "Failed to initialize output log {}", log_path);
+
+                if (binary)
+                {
+                    Impl::StartBinaryLog();
+                }
             }
         }
+
+
+        //
+        // Check log overflow policy.
+        //
+
+        if (auto overflow = CommandLine::Get("--log-overflow"); overflow.has_value())
+        {
+            if (*overflow == "drop")
+            {
+                SetLogOverflowPolicy(LogOverflowPolicy::Drop);
+            }
+            else if (*overflow == "block")
+            {
+                SetLogOverflowPolicy(LogOverflowPolicy::Block);
+            }
+            else
+            {
+                GX_LOG_WARN(LogPlatform, "Unknown log overflow policy: {}\n", *overflow);
+            }
+        }
+
+
+        //
+        // Write log asynchronously, unless application wants synchronous log.
+        //
+
+        if (!CommandLine::Get("--log-sync").has_value())
+        {
+            Impl::StartLogWriter();
+        }
     }
 
     BASE_API void Finalize() noexcept
@@ -41,6 +41,56 @@ namespace Graphyte::Diagnostics::Impl
     extern void DebugOutput(LogLevel level, const char* text) noexcept;
 
     extern Threading::CriticalSection& GetDiagnosticsLock() noexcept;
+
+    /// @brief Switches log file to binary deferred-format mode and writes header to empty file.
+    extern void StartBinaryLog() noexcept;
+
+    /// @brief Starts thread writing log messages asynchronously.
+    extern void StartLogWriter() noexcept;
+
+    /// @brief Stops log writer thread and writes all pending messages.
+    ///
+    /// @remarks Messages logged afterwards are written synchronously.
+    extern void StopLogWriter() noexcept;
+
+    /// @brief Writes all pending messages from crash handler.
+    ///
+    /// @remarks Messages logged afterwards are written synchronously.
+    extern void FlushLogOnCrash() noexcept;
+}
+
+
+// =================================================================================================
+//
+// Binary log format.
+//
+// Layout:
+//
+//  header: signature (u64), version (u32), reserved (u32), timestamp resolution (u64),
+//          start timestamp (u64)
+//
+//  records: type (u8), followed by record data:
+//
+//  Descriptor: id (varint), level (u8), line (varint), category, format, file
+//  Message:    id (varint), timestamp delta (zigzag varint), encoded arguments
+//  Text:       level (u8), timestamp delta (zigzag varint), text
+//
+//  Strings and encoded arguments are stored as length (varint) followed by bytes. Timestamp delta
+//  is relative to previous record, or start timestamp for first record. Descriptor is always
+//  written before first message using it.
+//
+
+namespace Graphyte::Diagnostics::Impl
+{
+    constexpr const uint64_t BinaryLogSignature = 0x0000474F4C584721;
+    constexpr const uint32_t BinaryLogVersion   = 1;
+
+    enum class BinaryLogRecord : uint8_t
+    {
+        Descriptor = 1,
+        Message    = 2,
+        Text       = 3,
+    };
 }
 
 
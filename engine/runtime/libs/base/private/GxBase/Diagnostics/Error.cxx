@@ -149,6 +149,8 @@ namespace Graphyte::Diagnostics
                 return "InvalidInstruction";
             case Status::FloatingPointError:
                 return "FloatingPointError";
+            case Status::Cancelled:
+                return "Cancelled";
         }
 
         return "<unknown>";
@@ -1,6 +1,8 @@
 #include <GxBase/Diagnostics.hxx>
 #include <GxBase/System.hxx>
 
+#include "../Diagnostics.Impl.hxx"
+
 namespace Graphyte::Diagnostics
 {
     static void LogProcessorContext(ucontext_t* context) noexcept
@@ -50,6 +52,13 @@ namespace Graphyte::Diagnostics
     {
         (void)signal_info;
         (void)context;
+
+        //
+        // Write pending log messages. Crash report is logged synchronously.
+        //
+
+        Impl::FlushLogOnCrash();
+
         GX_LOG_ERROR(LogPlatform, "Application crashed:\n");
 
         if (context != nullptr)
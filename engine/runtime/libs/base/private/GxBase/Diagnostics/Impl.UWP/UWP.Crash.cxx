@@ -2,6 +2,8 @@
 #include <GxBase/System/Impl.Windows/Windows.Helpers.hxx>
 #include <GxBase/System.hxx>
 
+#include "../Diagnostics.Impl.hxx"
+
 #include <ErrorRep.h>
 
 namespace Graphyte::Diagnostics
@@ -9,6 +11,12 @@ namespace Graphyte::Diagnostics
     BASE_API void OnCrash(
         EXCEPTION_POINTERS* exception) noexcept
     {
+        //
+        // Write pending log messages.
+        //
+
+        Impl::FlushLogOnCrash();
+
         (void)exception;
         Diagnostics::FailFast();
     }
@@ -2,6 +2,8 @@
 #include <GxBase/System/Impl.Windows/Windows.Helpers.hxx>
 #include <GxBase/System.hxx>
 
+#include "../Diagnostics.Impl.hxx"
+
 #include <ErrorRep.h>
 #include <CommCtrl.h>
 
@@ -52,6 +54,12 @@ namespace Graphyte::Diagnostics
     BASE_API void OnCrash(
         EXCEPTION_POINTERS* exception) noexcept
     {
+        //
+        // Write pending log messages. Crash report is logged synchronously.
+        //
+
+        Impl::FlushLogOnCrash();
+
         GX_LOG_ERROR(LogPlatform, "Application crashed:\n");
 
 
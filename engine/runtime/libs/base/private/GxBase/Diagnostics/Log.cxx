@@ -1,5 +1,8 @@
 #include <GxBase/Diagnostics.hxx>
 #include <GxBase/App.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/Thread.hxx>
 
 #include "Diagnostics.Impl.hxx"
 
@@ -15,6 +18,15 @@ namespace Graphyte::Diagnostics::Impl
     BASE_API LogLevel g_LogLevel{ LogLevel::Trace };
 #endif
 
+    BASE_API std::atomic<bool> g_LogBinary{ false };
+
+    //
+    // Format of current log file. Guarded by global log lock. Records carry their own format, so
+    // records produced before switch are converted to format of file.
+    //
+
+    static bool g_LogFileBinary{ false };
+
     static Threading::CriticalSection& GetGlobalLogLock() noexcept
     {
         static Threading::CriticalSection s_LogLock;
@@ -22,6 +34,878 @@ namespace Graphyte::Diagnostics::Impl
     }
 }
 
+
+// =================================================================================================
+//
+// Asynchronous log output.
+//
+// Each logging thread owns single-producer ring of formatted records. Writer thread drains all
+// rings, restores global order of records using sequence numbers and writes them in batches.
+//
+
+namespace Graphyte::Diagnostics::Impl
+{
+    constexpr const size_t LogRingCapacity = 64 * 1024;
+
+    //
+    // Records are aligned, so there is always space for padding record at end of ring.
+    //
+
+    constexpr const size_t LogRecordAlignment = 16;
+
+    //
+    // Longer messages are truncated.
+    //
+
+    constexpr const size_t LogRecordMaxLength = LogRingCapacity / 4;
+
+    //
+    // Writer thread wakes up at least at this interval (in milliseconds). Producers wake it up
+    // earlier when their ring becomes half full.
+    //
+
+    constexpr const uint32_t LogWriterInterval = 10;
+
+    //
+    // Marks padding record which skips to beginning of ring.
+    //
+
+    constexpr const uint32_t LogRecordPadding = ~uint32_t{};
+
+    enum class LogRecordKind : uint16_t
+    {
+        /// Formatted text.
+        Text,
+
+        /// Formatted text prefixed with timestamp.
+        TimedText,
+
+        /// Descriptor identifier, timestamp and encoded arguments.
+        Message,
+    };
+
+    struct LogRecordHeader final
+    {
+        uint64_t Sequence;
+        uint32_t Size;
+        uint8_t Level;
+        LogRecordKind Kind;
+    };
+
+    struct LogRecord final
+    {
+        LogLevel Level;
+        LogRecordKind Kind;
+        std::span<const std::byte> Payload;
+    };
+
+    static_assert(sizeof(LogRecordHeader) == LogRecordAlignment);
+
+    struct LogRing final
+    {
+        std::unique_ptr<std::byte[]> Buffer{ std::make_unique<std::byte[]>(LogRingCapacity) };
+
+        /// Written by owning thread.
+        alignas(GX_CACHELINE_SIZE) std::atomic<uint64_t> Head{};
+
+        /// Written by thread draining log.
+        alignas(GX_CACHELINE_SIZE) std::atomic<uint64_t> Tail{};
+
+        /// Set when owning thread exits; ring is released by writer once drained.
+        std::atomic<bool> Abandoned{};
+    };
+
+    struct LogRingOwner final
+    {
+        LogRing* Ring{};
+
+        ~LogRingOwner() noexcept
+        {
+            if (Ring != nullptr)
+            {
+                Ring->Abandoned.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    class LogWriter final : public Threading::IRunnable
+    {
+    private:
+        Threading::CriticalSection m_WakeupLock;
+        Threading::ConditionVariable m_Wakeup;
+        bool m_WakeupRequested{};
+        bool m_Running{};
+
+    public:
+        /// Guards list of rings.
+        Threading::SpinLock RingsLock;
+        std::vector<std::unique_ptr<LogRing>> Rings;
+
+        /// Held by thread draining rings.
+        Threading::CriticalSection DrainLock;
+
+        /// Global order of records.
+        std::atomic<uint64_t> Sequence{};
+
+        /// Number of dropped records.
+        std::atomic<uint64_t> Dropped{};
+        uint64_t DroppedReported{};
+
+        std::atomic<LogOverflowPolicy> OverflowPolicy{ LogOverflowPolicy::Block };
+
+        /// Enabled while writer thread runs.
+        std::atomic<bool> Enabled{};
+
+        /// Declared last, so thread is stopped before other members are destroyed.
+        Threading::Thread Thread{};
+
+    public:
+        uint32_t OnRun() noexcept override;
+
+        void OnStop() noexcept override
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_WakeupLock };
+            m_Running = false;
+            m_Wakeup.Notify();
+        }
+
+        bool Start() noexcept
+        {
+            {
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_WakeupLock };
+                m_Running = true;
+            }
+
+            return Thread.Start(this, "Log Writer");
+        }
+
+        void Wakeup() noexcept
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_WakeupLock };
+            m_WakeupRequested = true;
+            m_Wakeup.Notify();
+        }
+
+    public:
+        void Drain() noexcept;
+    };
+
+    static LogWriter& GetLogWriter() noexcept
+    {
+        static LogWriter s_LogWriter;
+        return s_LogWriter;
+    }
+
+    static thread_local LogRingOwner g_LogRingOwner{};
+    static thread_local bool g_LogIsWriterThread{};
+
+    static LogRing& GetLogRing() noexcept
+    {
+        LogRing* ring = g_LogRingOwner.Ring;
+
+        if (ring == nullptr) [[unlikely]]
+        {
+            LogWriter& writer = GetLogWriter();
+
+            auto instance = std::make_unique<LogRing>();
+            ring          = instance.get();
+
+            Threading::ScopedLock<Threading::SpinLock> lock{ writer.RingsLock };
+            writer.Rings.push_back(std::move(instance));
+
+            g_LogRingOwner.Ring = ring;
+        }
+
+        return *ring;
+    }
+
+    enum class LogRingWriteResult
+    {
+        Success,
+        SuccessHalfFull,
+        Full,
+    };
+
+    static LogRingWriteResult LogRingWrite(
+        LogRing& ring,
+        uint64_t sequence,
+        const LogRecord& record) noexcept
+    {
+        size_t const length = std::min(record.Payload.size(), LogRecordMaxLength);
+        size_t const size   = AlignUp(sizeof(LogRecordHeader) + length, LogRecordAlignment);
+
+        uint64_t const start = ring.Head.load(std::memory_order_relaxed);
+        uint64_t const tail  = ring.Tail.load(std::memory_order_acquire);
+        uint64_t head        = start;
+
+        size_t const offset     = static_cast<size_t>(head % LogRingCapacity);
+        size_t const contiguous = LogRingCapacity - offset;
+        size_t const required   = (contiguous < size) ? (contiguous + size) : size;
+
+        if ((LogRingCapacity - static_cast<size_t>(head - tail)) < required)
+        {
+            return LogRingWriteResult::Full;
+        }
+
+        if (contiguous < size)
+        {
+            //
+            // Record does not fit at end of ring; skip to beginning.
+            //
+
+            LogRecordHeader const padding{
+                .Sequence = 0,
+                .Size     = LogRecordPadding,
+                .Level    = 0,
+                .Kind     = record.Kind,
+            };
+
+            std::memcpy(ring.Buffer.get() + offset, &padding, sizeof(padding));
+            head += contiguous;
+        }
+
+        std::byte* const destination = ring.Buffer.get() + (head % LogRingCapacity);
+
+        LogRecordHeader const header{
+            .Sequence = sequence,
+            .Size     = static_cast<uint32_t>(length),
+            .Level    = static_cast<uint8_t>(record.Level),
+            .Kind     = record.Kind,
+        };
+
+        std::memcpy(destination, &header, sizeof(header));
+        std::memcpy(destination + sizeof(header), record.Payload.data(), length);
+
+        head += size;
+
+        ring.Head.store(head, std::memory_order_release);
+
+        //
+        // Report only crossing of half capacity, so writer is not woken up on every record.
+        //
+
+        bool const half_full = (static_cast<size_t>(start - tail) <= (LogRingCapacity / 2))
+                               && (static_cast<size_t>(head - tail) > (LogRingCapacity / 2));
+
+        return half_full ? LogRingWriteResult::SuccessHalfFull : LogRingWriteResult::Success;
+    }
+
+    //
+    // Registry of log message descriptors. Identifier zero is reserved.
+    //
+
+    struct LogDescriptorRegistry final
+    {
+        Threading::SpinLock Lock;
+        std::vector<LogMessageDescriptor*> Items{ nullptr };
+
+        /// Descriptors already written to log file. Guarded by global log lock.
+        std::vector<bool> Written;
+
+        /// Timestamp of last record written to log file. Guarded by global log lock.
+        uint64_t LastTimestamp;
+    };
+
+    static LogDescriptorRegistry& GetLogDescriptorRegistry() noexcept
+    {
+        static LogDescriptorRegistry s_Registry;
+        return s_Registry;
+    }
+
+    static uint32_t LogRegisterDescriptor(LogMessageDescriptor& descriptor) noexcept
+    {
+        uint32_t id = descriptor.Id.load(std::memory_order_acquire);
+
+        if (id == 0) [[unlikely]]
+        {
+            LogDescriptorRegistry& registry = GetLogDescriptorRegistry();
+
+            Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+            id = descriptor.Id.load(std::memory_order_relaxed);
+
+            if (id == 0)
+            {
+                id = static_cast<uint32_t>(registry.Items.size());
+                registry.Items.push_back(&descriptor);
+                descriptor.Id.store(id, std::memory_order_release);
+            }
+        }
+
+        return id;
+    }
+
+    static const LogMessageDescriptor* LogGetDescriptor(uint32_t id) noexcept
+    {
+        LogDescriptorRegistry& registry = GetLogDescriptorRegistry();
+
+        Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+        return (id < registry.Items.size()) ? registry.Items[id] : nullptr;
+    }
+
+    template <typename T>
+    static void LogAppendValue(std::string& output, T value) noexcept
+    {
+        output.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static void LogAppendVarInt(std::string& output, uint64_t value) noexcept
+    {
+        std::array<std::byte, LogArgumentEncoder::MaxVarIntSize> buffer;
+        size_t const size = LogArgumentEncoder::WriteVarInt(buffer.data(), value);
+        output.append(reinterpret_cast<const char*>(buffer.data()), size);
+    }
+
+    static void LogAppendString(std::string& output, std::string_view value) noexcept
+    {
+        LogAppendVarInt(output, value.size());
+        output.append(value);
+    }
+
+    //
+    // Timestamps are stored as difference from previous record. Records are sorted by sequence
+    // number, so difference may be negative.
+    //
+
+    static void LogAppendTimestamp(std::string& output, uint64_t timestamp) noexcept
+    {
+        uint64_t& last = GetLogDescriptorRegistry().LastTimestamp;
+        LogAppendVarInt(output, LogArgumentEncoder::ZigZagEncode(static_cast<int64_t>(timestamp - last)));
+        last = timestamp;
+    }
+
+    static std::string_view LogGetText(const LogRecord& record) noexcept
+    {
+        std::string_view const payload{ reinterpret_cast<const char*>(record.Payload.data()), record.Payload.size() };
+
+        return (record.Kind == LogRecordKind::TimedText) ? payload.substr(sizeof(uint64_t)) : payload;
+    }
+
+    //
+    // Appends record as formatted text. Deferred messages are formatted here, on writer thread.
+    //
+
+    static void LogAppendText(std::string& output, const LogRecord& record) noexcept
+    {
+        switch (record.Kind)
+        {
+            case LogRecordKind::Text:
+            case LogRecordKind::TimedText:
+            {
+                output.append(LogGetText(record));
+                break;
+            }
+
+            case LogRecordKind::Message:
+            {
+                uint32_t id;
+                std::memcpy(&id, record.Payload.data(), sizeof(id));
+
+                if (const LogMessageDescriptor* const descriptor = LogGetDescriptor(id); descriptor != nullptr)
+                {
+                    std::string message{};
+
+                    [[maybe_unused]] bool const decoded = FormatLogArguments(
+                        message,
+                        descriptor->Format,
+                        record.Payload.subspan(sizeof(uint32_t) + sizeof(uint64_t)));
+
+                    output.append(message);
+                }
+
+                break;
+            }
+        }
+    }
+
+    //
+    // Appends record to output in log file format. Global log lock must be held, so descriptors
+    // are written to file before first message using them.
+    //
+
+    static void LogAppendFileRecord(std::string& output, const LogRecord& record) noexcept
+    {
+        std::string_view const payload{ reinterpret_cast<const char*>(record.Payload.data()), record.Payload.size() };
+
+        if (!g_LogFileBinary)
+        {
+            LogAppendText(output, record);
+            return;
+        }
+
+        switch (record.Kind)
+        {
+            case LogRecordKind::Text:
+            case LogRecordKind::TimedText:
+            {
+                //
+                // Text produced before binary mode was enabled has no timestamp.
+                //
+
+                uint64_t timestamp = System::GetTimestamp();
+
+                if (record.Kind == LogRecordKind::TimedText)
+                {
+                    std::memcpy(&timestamp, payload.data(), sizeof(timestamp));
+                }
+
+                LogAppendValue<BinaryLogRecord>(output, BinaryLogRecord::Text);
+                LogAppendValue<uint8_t>(output, static_cast<uint8_t>(record.Level));
+                LogAppendTimestamp(output, timestamp);
+                LogAppendString(output, LogGetText(record));
+                break;
+            }
+
+            case LogRecordKind::Message:
+            {
+                uint32_t id;
+                std::memcpy(&id, payload.data(), sizeof(id));
+
+                uint64_t timestamp;
+                std::memcpy(&timestamp, payload.data() + sizeof(id), sizeof(timestamp));
+
+                std::vector<bool>& written = GetLogDescriptorRegistry().Written;
+
+                if (id >= written.size())
+                {
+                    written.resize(id + 1);
+                }
+
+                if (!written[id])
+                {
+                    const LogMessageDescriptor* const descriptor = LogGetDescriptor(id);
+                    GX_ASSERT(descriptor != nullptr);
+
+                    LogAppendValue<BinaryLogRecord>(output, BinaryLogRecord::Descriptor);
+                    LogAppendVarInt(output, id);
+                    LogAppendValue<uint8_t>(output, static_cast<uint8_t>(descriptor->Level));
+                    LogAppendVarInt(output, descriptor->Line);
+                    LogAppendString(output, descriptor->Category);
+                    LogAppendString(output, descriptor->Format);
+                    LogAppendString(output, descriptor->File);
+
+                    written[id] = true;
+                }
+
+                LogAppendValue<BinaryLogRecord>(output, BinaryLogRecord::Message);
+                LogAppendVarInt(output, id);
+                LogAppendTimestamp(output, timestamp);
+                LogAppendString(output, payload.substr(sizeof(uint32_t) + sizeof(uint64_t)));
+                break;
+            }
+        }
+    }
+
+    static void LogDebugOutput(const LogRecord& record) noexcept
+    {
+        // Guarantee nul character at end.
+        std::string buffer{};
+        LogAppendText(buffer, record);
+
+        Impl::DebugOutput(record.Level, buffer.c_str());
+    }
+
+    static void LogWriteFile(std::string_view content) noexcept
+    {
+        size_t processed{};
+
+        auto const status = Impl::g_LogOutputFile->Write(
+            { reinterpret_cast<const std::byte*>(content.data()), content.size() },
+            processed);
+
+        GX_ABORT_UNLESS(status == Status::Success, "Failed to write to log file");
+    }
+
+    static void LogWriteOutputs(const LogRecord& record) noexcept
+    {
+        if (Impl::g_LogOutputFile != nullptr)
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ GetGlobalLogLock() };
+
+            if (!g_LogFileBinary && record.Kind == LogRecordKind::Text)
+            {
+                LogWriteFile({ reinterpret_cast<const char*>(record.Payload.data()), record.Payload.size() });
+            }
+            else
+            {
+                std::string buffer{};
+                LogAppendFileRecord(buffer, record);
+                LogWriteFile(buffer);
+            }
+        }
+
+        if (Impl::g_LogOutputDebugger)
+        {
+            LogDebugOutput(record);
+        }
+    }
+
+    void LogWriter::Drain() noexcept
+    {
+        struct PendingRecord final
+        {
+            uint64_t Sequence;
+            LogRecord Record;
+        };
+
+        struct PendingRing final
+        {
+            LogRing* Ring;
+            uint64_t Head;
+        };
+
+        std::vector<PendingRing> rings{};
+
+        {
+            Threading::ScopedLock<Threading::SpinLock> lock{ RingsLock };
+
+            rings.reserve(Rings.size());
+
+            for (auto const& ring : Rings)
+            {
+                rings.push_back(PendingRing{
+                    .Ring = ring.get(),
+                    .Head = 0,
+                });
+            }
+        }
+
+        std::vector<PendingRecord> records{};
+
+        for (auto& pending : rings)
+        {
+            LogRing& ring = *pending.Ring;
+
+            uint64_t const head = ring.Head.load(std::memory_order_acquire);
+            uint64_t position   = ring.Tail.load(std::memory_order_relaxed);
+
+            while (position < head)
+            {
+                std::byte const* const record = ring.Buffer.get() + (position % LogRingCapacity);
+
+                LogRecordHeader header;
+                std::memcpy(&header, record, sizeof(header));
+
+                if (header.Size == LogRecordPadding)
+                {
+                    position += LogRingCapacity - (position % LogRingCapacity);
+                    continue;
+                }
+
+                records.push_back(PendingRecord{
+                    .Sequence = header.Sequence,
+                    .Record   = {
+                        .Level   = static_cast<LogLevel>(header.Level),
+                        .Kind    = header.Kind,
+                        .Payload = { record + sizeof(header), header.Size },
+                    },
+                });
+
+                position += AlignUp(sizeof(header) + header.Size, LogRecordAlignment);
+            }
+
+            pending.Head = head;
+        }
+
+        std::sort(records.begin(), records.end(), [](const PendingRecord& lhs, const PendingRecord& rhs) {
+            return lhs.Sequence < rhs.Sequence;
+        });
+
+        uint64_t const dropped = Dropped.load(std::memory_order_relaxed);
+
+        std::string report{};
+
+        if (dropped != DroppedReported)
+        {
+            fmt::format_to(std::back_inserter(report), "Log overflow: {} messages dropped\n", dropped - DroppedReported);
+            DroppedReported = dropped;
+
+            records.push_back(PendingRecord{
+                .Sequence = ~uint64_t{},
+                .Record   = {
+                    .Level   = LogLevel::Warn,
+                    .Kind    = LogRecordKind::Text,
+                    .Payload = { reinterpret_cast<const std::byte*>(report.data()), report.size() },
+                },
+            });
+        }
+
+        //
+        // Write whole batch to file at once.
+        //
+
+        if (!records.empty() && Impl::g_LogOutputFile != nullptr)
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ GetGlobalLogLock() };
+
+            std::string batch{};
+
+            for (auto const& pending : records)
+            {
+                LogAppendFileRecord(batch, pending.Record);
+            }
+
+            LogWriteFile(batch);
+        }
+
+        if (Impl::g_LogOutputDebugger)
+        {
+            for (auto const& pending : records)
+            {
+                LogDebugOutput(pending.Record);
+            }
+        }
+
+        //
+        // Release space to producers and free rings of exited threads.
+        //
+
+        bool has_abandoned = false;
+
+        for (auto const& pending : rings)
+        {
+            pending.Ring->Tail.store(pending.Head, std::memory_order_release);
+
+            has_abandoned |= pending.Ring->Abandoned.load(std::memory_order_acquire);
+        }
+
+        if (has_abandoned)
+        {
+            Threading::ScopedLock<Threading::SpinLock> lock{ RingsLock };
+
+            std::erase_if(Rings, [](const std::unique_ptr<LogRing>& ring) {
+                return ring->Abandoned.load(std::memory_order_acquire)
+                       && ring->Tail.load(std::memory_order_relaxed) == ring->Head.load(std::memory_order_acquire);
+            });
+        }
+    }
+
+    uint32_t LogWriter::OnRun() noexcept
+    {
+        g_LogIsWriterThread = true;
+
+        for (;;)
+        {
+            {
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_WakeupLock };
+
+                if (!m_Running)
+                {
+                    break;
+                }
+
+                if (!m_WakeupRequested)
+                {
+                    m_Wakeup.Wait(m_WakeupLock, LogWriterInterval);
+                }
+
+                m_WakeupRequested = false;
+            }
+
+            Threading::ScopedLock<Threading::CriticalSection> lock{ DrainLock };
+            Drain();
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ DrainLock };
+        Drain();
+
+        return 0;
+    }
+
+    //
+    // Returns false when record must be written synchronously.
+    //
+
+    static bool LogDispatchAsync(const LogRecord& record) noexcept
+    {
+        LogWriter& writer = GetLogWriter();
+
+        if (!writer.Enabled.load(std::memory_order_acquire) || g_LogIsWriterThread)
+        {
+            return false;
+        }
+
+        LogRing& ring           = GetLogRing();
+        uint64_t const sequence = writer.Sequence.fetch_add(1, std::memory_order_relaxed);
+
+        for (;;)
+        {
+            switch (LogRingWrite(ring, sequence, record))
+            {
+                case LogRingWriteResult::Success:
+                    return true;
+
+                case LogRingWriteResult::SuccessHalfFull:
+                    writer.Wakeup();
+                    return true;
+
+                case LogRingWriteResult::Full:
+                    break;
+            }
+
+            if (writer.OverflowPolicy.load(std::memory_order_relaxed) == LogOverflowPolicy::Drop)
+            {
+                writer.Dropped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            if (!writer.Enabled.load(std::memory_order_acquire))
+            {
+                //
+                // Writer stopped while waiting for space.
+                //
+
+                return false;
+            }
+
+            writer.Wakeup();
+            Threading::YieldThread();
+        }
+    }
+
+    static bool LogDispatchRecord(const LogRecord& record) noexcept
+    {
+        if (!LogDispatchAsync(record))
+        {
+            LogWriteOutputs(record);
+        }
+
+        return true;
+    }
+
+    //
+    // Global log lock must be held.
+    //
+
+    static void LogStartBinaryFile() noexcept
+    {
+        GX_ASSERT(g_LogOutputFile != nullptr);
+
+        uint64_t const start = System::GetTimestamp();
+
+        //
+        // Binary log may be appended to existing file, when previous log output is restored.
+        // Descriptors are written again, so each file part can be decoded.
+        //
+
+        if (g_LogOutputFile->GetSize() == 0)
+        {
+            std::string header{};
+            LogAppendValue<uint64_t>(header, BinaryLogSignature);
+            LogAppendValue<uint32_t>(header, BinaryLogVersion);
+            LogAppendValue<uint32_t>(header, 0);
+            LogAppendValue<uint64_t>(header, System::GetTimestampResolution());
+            LogAppendValue<uint64_t>(header, start);
+
+            LogWriteFile(header);
+            GetLogDescriptorRegistry().LastTimestamp = start;
+        }
+
+        GetLogDescriptorRegistry().Written.clear();
+
+        g_LogFileBinary = true;
+    }
+
+    void StartBinaryLog() noexcept
+    {
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ GetGlobalLogLock() };
+            LogStartBinaryFile();
+        }
+
+        g_LogBinary.store(true, std::memory_order_relaxed);
+    }
+
+    void StartLogWriter() noexcept
+    {
+        LogWriter& writer = GetLogWriter();
+
+        GX_ASSERT(!writer.Enabled.load());
+
+        if (writer.Start())
+        {
+            writer.Enabled.store(true, std::memory_order_release);
+        }
+    }
+
+    void StopLogWriter() noexcept
+    {
+        LogWriter& writer = GetLogWriter();
+
+        bool const was_enabled = writer.Enabled.exchange(false, std::memory_order_acq_rel);
+
+        if (g_LogIsWriterThread)
+        {
+            //
+            // Writer thread is terminating process, probably while draining rings. It cannot wait
+            // for itself.
+            //
+
+            return;
+        }
+
+        if (was_enabled)
+        {
+            //
+            // Writer drains all rings before exiting.
+            //
+
+            writer.Thread.Stop(true);
+
+            Threading::ScopedLock<Threading::CriticalSection> lock{ writer.DrainLock };
+            writer.Drain();
+        }
+        else if (writer.DrainLock.TryEnter())
+        {
+            //
+            // Writer was stopped by crash handler, which already drained rings. Drain lock may be
+            // still held by crashed writer thread.
+            //
+
+            writer.Drain();
+            writer.DrainLock.Leave();
+        }
+    }
+
+    void FlushLogOnCrash() noexcept
+    {
+        LogWriter& writer = GetLogWriter();
+
+        //
+        // Crash handler cannot rely on writer thread anymore. Switch to synchronous output and
+        // drain rings on this thread. Writer thread may have crashed while holding drain lock, so
+        // wait for it only for bounded time.
+        //
+
+        writer.Enabled.store(false, std::memory_order_release);
+
+        bool locked = false;
+
+        for (uint32_t i = 0; i < 100 && !locked; ++i)
+        {
+            locked = writer.DrainLock.TryEnter();
+
+            if (!locked)
+            {
+                Threading::SleepThread(1);
+            }
+        }
+
+        writer.Drain();
+
+        if (locked)
+        {
+            writer.DrainLock.Leave();
+        }
+
+        if (Impl::g_LogOutputFile != nullptr)
+        {
+            [[maybe_unused]] auto const status = Impl::g_LogOutputFile->Flush();
+        }
+    }
+}
+
 namespace Graphyte::Diagnostics
 {
     BASE_API bool LogDispatchArgs(
@@ -32,6 +916,18 @@ namespace Graphyte::Diagnostics
     {
         fmt::memory_buffer buffer{};
 
+        //
+        // Binary log stores timestamp before text.
+        //
+
+        size_t const prefix = Impl::g_LogBinary.load(std::memory_order_relaxed) ? sizeof(uint64_t) : 0;
+
+        if (prefix != 0)
+        {
+            uint64_t const timestamp = System::GetTimestamp();
+            buffer.append(reinterpret_cast<const char*>(&timestamp), reinterpret_cast<const char*>(&timestamp) + sizeof(timestamp));
+        }
+
         constexpr bool outputLogLevelAndCategory = false;
 
         if constexpr (outputLogLevelAndCategory)
@@ -45,7 +941,7 @@ namespace Graphyte::Diagnostics
 
         fmt::vformat_to(buffer, format, args);
 
-        if (buffer.size() != 0)
+        if (buffer.size() != prefix)
         {
             if constexpr (System::CurrentPlatformKind == System::PlatformKind::Desktop)
             {
@@ -58,44 +954,123 @@ namespace Graphyte::Diagnostics
 
                 if (Impl::g_LogOutputTerminal && is_error && is_terminal)
                 {
-                    std::fwrite(buffer.data(), buffer.size(), 1, stderr);
+                    std::fwrite(buffer.data() + prefix, buffer.size() - prefix, 1, stderr);
                 }
             }
 
 
             //
-            // Forward to file.
+            // Forward to writer thread, or write to outputs directly when it is not running.
             //
 
-            if (Impl::g_LogOutputFile != nullptr)
-            {
-                Threading::ScopedLock<Threading::CriticalSection> lock{ Impl::GetGlobalLogLock() };
+            return Impl::LogDispatchRecord(Impl::LogRecord{
+                .Level   = level,
+                .Kind    = (prefix != 0) ? Impl::LogRecordKind::TimedText : Impl::LogRecordKind::Text,
+                .Payload = { reinterpret_cast<const std::byte*>(buffer.data()), buffer.size() },
+            });
+        }
+
+        return false;
+    }
+
+    BASE_API bool LogDispatchBinary(
+        LogMessageDescriptor& descriptor,
+        std::span<const std::byte> arguments) noexcept
+    {
+        uint32_t const id        = Impl::LogRegisterDescriptor(descriptor);
+        uint64_t const timestamp = System::GetTimestamp();
+
+        std::array<std::byte, sizeof(id) + sizeof(timestamp) + LogArgumentEncoder::Capacity> payload;
+        std::memcpy(&payload[0], &id, sizeof(id));
+        std::memcpy(&payload[sizeof(id)], &timestamp, sizeof(timestamp));
+        std::memcpy(&payload[sizeof(id) + sizeof(timestamp)], arguments.data(), arguments.size());
+
+        return Impl::LogDispatchRecord(Impl::LogRecord{
+            .Level   = descriptor.Level,
+            .Kind    = Impl::LogRecordKind::Message,
+            .Payload = { payload.data(), sizeof(id) + sizeof(timestamp) + arguments.size() },
+        });
+    }
+
+    BASE_API void SetLogOverflowPolicy(
+        LogOverflowPolicy policy) noexcept
+    {
+        Impl::GetLogWriter().OverflowPolicy.store(policy, std::memory_order_relaxed);
+    }
+
+    BASE_API LogOverflowPolicy GetLogOverflowPolicy() noexcept
+    {
+        return Impl::GetLogWriter().OverflowPolicy.load(std::memory_order_relaxed);
+    }
+
+    BASE_API uint64_t GetLogDroppedCount() noexcept
+    {
+        return Impl::GetLogWriter().Dropped.load(std::memory_order_relaxed);
+    }
 
-                size_t processed{};
+    BASE_API void FlushLog() noexcept
+    {
+        Impl::LogWriter& writer = Impl::GetLogWriter();
 
-                auto const status = Impl::g_LogOutputFile->Write(
-                    { reinterpret_cast<const std::byte*>(buffer.data()), buffer.size() },
-                    processed);
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ writer.DrainLock };
+            writer.Drain();
+        }
+
+        if (Impl::g_LogOutputFile != nullptr)
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ Impl::GetGlobalLogLock() };
+            [[maybe_unused]] auto const status = Impl::g_LogOutputFile->Flush();
+        }
+    }
 
-                GX_ABORT_UNLESS(status == Status::Success, "Failed to write to log file");
+    BASE_API void SetLogAsync(bool enabled) noexcept
+    {
+        if (enabled != IsLogAsync())
+        {
+            if (enabled)
+            {
+                Impl::StartLogWriter();
             }
+            else
+            {
+                Impl::StopLogWriter();
+            }
+        }
+    }
 
+    BASE_API bool IsLogAsync() noexcept
+    {
+        return Impl::GetLogWriter().Enabled.load(std::memory_order_acquire);
+    }
 
+    BASE_API std::unique_ptr<Storage::IStream> SetLogOutputFile(
+        std::unique_ptr<Storage::IStream> stream,
+        bool binary) noexcept
+    {
+        FlushLog();
+
+        std::unique_ptr<Storage::IStream> previous{};
+
+        {
             //
-            // Forward log message to debugger first.
+            // Records still pending are converted to format of new file when written.
             //
 
-            if (Impl::g_LogOutputDebugger)
-            {
-                // Guarantee nul character at end.
-                buffer.push_back(0);
+            Threading::ScopedLock<Threading::CriticalSection> lock{ Impl::GetGlobalLogLock() };
+            previous              = std::exchange(Impl::g_LogOutputFile, std::move(stream));
+            Impl::g_LogFileBinary = false;
 
-                Impl::DebugOutput(level, buffer.data());
-            }
+            binary = binary && (Impl::g_LogOutputFile != nullptr);
 
-            return true;
+            if (binary)
+            {
+                Impl::LogStartBinaryFile();
+            }
         }
 
-        return false;
+        Impl::g_LogBinary.store(binary, std::memory_order_relaxed);
+
+        return previous;
     }
 }
@@ -0,0 +1,376 @@
+#include <GxBase/Diagnostics.hxx>
+
+#include "Diagnostics.Impl.hxx"
+
+namespace Graphyte::Diagnostics::Impl
+{
+    class BinaryLogReader final
+    {
+    private:
+        std::span<const std::byte> m_Content;
+        size_t m_Position{};
+        bool m_Failed{};
+
+    public:
+        explicit BinaryLogReader(std::span<const std::byte> content) noexcept
+            : m_Content{ content }
+        {
+        }
+
+    public:
+        [[nodiscard]] bool IsFailed() const noexcept
+        {
+            return m_Failed;
+        }
+
+        [[nodiscard]] bool IsEnd() const noexcept
+        {
+            return m_Position >= m_Content.size();
+        }
+
+        [[nodiscard]] std::span<const std::byte> ReadBytes(size_t size) noexcept
+        {
+            if (size > (m_Content.size() - m_Position))
+            {
+                m_Failed   = true;
+                m_Position = m_Content.size();
+                return {};
+            }
+
+            auto const result = m_Content.subspan(m_Position, size);
+            m_Position += size;
+            return result;
+        }
+
+        template <typename T>
+        [[nodiscard]] T Read() noexcept
+        {
+            T value{};
+
+            if (auto const bytes = ReadBytes(sizeof(T)); !bytes.empty())
+            {
+                std::memcpy(&value, bytes.data(), sizeof(T));
+            }
+
+            return value;
+        }
+
+        [[nodiscard]] uint64_t ReadVarInt() noexcept
+        {
+            uint64_t result = 0;
+
+            for (uint32_t shift = 0; shift < 64; shift += 7)
+            {
+                uint8_t const value = Read<uint8_t>();
+
+                result |= static_cast<uint64_t>(value & 0x7F) << shift;
+
+                if ((value & 0x80) == 0)
+                {
+                    return result;
+                }
+            }
+
+            m_Failed = true;
+            return result;
+        }
+
+        [[nodiscard]] std::string_view ReadString() noexcept
+        {
+            uint64_t const length = ReadVarInt();
+            auto const bytes      = ReadBytes(static_cast<size_t>(length));
+            return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+        }
+    };
+
+    struct BinaryLogDescriptor final
+    {
+        std::string Format;
+        std::string Category;
+        std::string File;
+        uint32_t Line;
+        LogLevel Level;
+    };
+
+    //
+    // Placeholder of argument not present in encoded arguments. Format spec written for original
+    // argument type is ignored.
+    //
+
+    struct LogTruncatedArgument final
+    {
+    };
+}
+
+template <>
+struct fmt::formatter<Graphyte::Diagnostics::Impl::LogTruncatedArgument>
+{
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& context)
+    {
+        auto it = context.begin();
+
+        while (it != context.end() && *it != '}')
+        {
+            ++it;
+        }
+
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(Graphyte::Diagnostics::Impl::LogTruncatedArgument const&, FormatContext& context)
+    {
+        return format_to(context.out(), "<truncated>");
+    }
+};
+
+namespace Graphyte::Diagnostics
+{
+    BASE_API bool FormatLogArguments(
+        std::string& output,
+        std::string_view format,
+        std::span<const std::byte> arguments) noexcept
+    {
+        Impl::BinaryLogReader reader{ arguments };
+
+        size_t const count = reader.Read<uint8_t>();
+
+        //
+        // String arguments are referenced directly from encoded arguments.
+        //
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store{};
+
+        size_t decoded = 0;
+        bool valid     = true;
+
+        for (; decoded < count && valid && !reader.IsEnd(); ++decoded)
+        {
+            uint8_t const type = reader.Read<uint8_t>();
+
+            if ((type & LogArgumentSkippedFlag) != 0)
+            {
+                store.push_back(Impl::LogTruncatedArgument{});
+                continue;
+            }
+
+            switch (static_cast<LogArgumentType>(type))
+            {
+                case LogArgumentType::Bool:
+                    store.push_back(reader.Read<uint8_t>() != 0);
+                    break;
+
+                case LogArgumentType::Char:
+                    store.push_back(reader.Read<char>());
+                    break;
+
+                case LogArgumentType::Int32:
+                    store.push_back(static_cast<int32_t>(LogArgumentEncoder::ZigZagDecode(reader.ReadVarInt())));
+                    break;
+
+                case LogArgumentType::UInt32:
+                    store.push_back(static_cast<uint32_t>(reader.ReadVarInt()));
+                    break;
+
+                case LogArgumentType::Int64:
+                    store.push_back(LogArgumentEncoder::ZigZagDecode(reader.ReadVarInt()));
+                    break;
+
+                case LogArgumentType::UInt64:
+                    store.push_back(reader.ReadVarInt());
+                    break;
+
+                case LogArgumentType::Float:
+                    store.push_back(reader.Read<float>());
+                    break;
+
+                case LogArgumentType::Double:
+                    store.push_back(reader.Read<double>());
+                    break;
+
+                case LogArgumentType::Pointer:
+                    store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(reader.ReadVarInt())));
+                    break;
+
+                case LogArgumentType::String:
+                    store.push_back(reader.ReadString());
+                    break;
+
+                default:
+                    valid = false;
+                    break;
+            }
+        }
+
+        valid &= !reader.IsFailed();
+
+        //
+        // Arguments not decoded are replaced with placeholders, so format string stays valid.
+        //
+
+        for (; decoded < count; ++decoded)
+        {
+            store.push_back(Impl::LogTruncatedArgument{});
+        }
+
+        try
+        {
+            output = fmt::vformat(format, store);
+        }
+        catch (fmt::format_error const& error)
+        {
+            //
+            // Format spec may not match type of encoded argument, eg. enum formatted to string at
+            // call site. Raw format string is kept instead.
+            //
+
+            bool const newline = format.ends_with('\n');
+
+            output.assign(newline ? format.substr(0, format.size() - 1) : format);
+            fmt::format_to(std::back_inserter(output), " <format error: {}>", error.what());
+
+            if (newline)
+            {
+                output.push_back('\n');
+            }
+
+            valid = false;
+        }
+
+        return valid;
+    }
+
+    BASE_API Status DecodeBinaryLog(
+        std::string& output,
+        std::span<const std::byte> content,
+        bool timestamps) noexcept
+    {
+        Impl::BinaryLogReader reader{ content };
+
+        if (reader.Read<uint64_t>() != Impl::BinaryLogSignature)
+        {
+            return Status::InvalidFormat;
+        }
+
+        if (reader.Read<uint32_t>() != Impl::BinaryLogVersion)
+        {
+            return Status::NotSupported;
+        }
+
+        [[maybe_unused]] uint32_t const reserved = reader.Read<uint32_t>();
+        uint64_t const resolution                = reader.Read<uint64_t>();
+        uint64_t const start                     = reader.Read<uint64_t>();
+
+        if (reader.IsFailed() || resolution == 0)
+        {
+            return Status::InvalidFormat;
+        }
+
+        std::unordered_map<uint32_t, Impl::BinaryLogDescriptor> descriptors{};
+
+        std::string message{};
+
+        uint64_t last = start;
+
+        auto read_timestamp = [&]() {
+            last += static_cast<uint64_t>(LogArgumentEncoder::ZigZagDecode(reader.ReadVarInt()));
+            return last;
+        };
+
+        auto append_timestamp = [&](uint64_t timestamp) {
+            if (timestamps)
+            {
+                double const seconds = static_cast<double>(timestamp - std::min(timestamp, start)) / static_cast<double>(resolution);
+                fmt::format_to(std::back_inserter(output), "[{:12.6f}] ", seconds);
+            }
+        };
+
+        while (!reader.IsEnd())
+        {
+            switch (static_cast<Impl::BinaryLogRecord>(reader.Read<uint8_t>()))
+            {
+                case Impl::BinaryLogRecord::Descriptor:
+                {
+                    uint32_t const id               = static_cast<uint32_t>(reader.ReadVarInt());
+                    LogLevel const level            = static_cast<LogLevel>(reader.Read<uint8_t>());
+                    uint32_t const line             = static_cast<uint32_t>(reader.ReadVarInt());
+                    std::string_view const category = reader.ReadString();
+                    std::string_view const format   = reader.ReadString();
+                    std::string_view const file     = reader.ReadString();
+
+                    descriptors[id] = Impl::BinaryLogDescriptor{
+                        .Format   = std::string{ format },
+                        .Category = std::string{ category },
+                        .File     = std::string{ file },
+                        .Line     = line,
+                        .Level    = level,
+                    };
+
+                    break;
+                }
+
+                case Impl::BinaryLogRecord::Message:
+                {
+                    uint32_t const id          = static_cast<uint32_t>(reader.ReadVarInt());
+                    uint64_t const timestamp   = read_timestamp();
+                    std::string_view const raw = reader.ReadString();
+
+                    if (reader.IsFailed())
+                    {
+                        break;
+                    }
+
+                    auto const it = descriptors.find(id);
+
+                    if (it == descriptors.end())
+                    {
+                        return Status::InvalidFormat;
+                    }
+
+                    [[maybe_unused]] bool const decoded = FormatLogArguments(
+                        message,
+                        it->second.Format,
+                        { reinterpret_cast<const std::byte*>(raw.data()), raw.size() });
+
+                    append_timestamp(timestamp);
+                    output.append(message);
+                    break;
+                }
+
+                case Impl::BinaryLogRecord::Text:
+                {
+                    [[maybe_unused]] uint8_t const level = reader.Read<uint8_t>();
+                    uint64_t const timestamp             = read_timestamp();
+                    std::string_view const text          = reader.ReadString();
+
+                    if (reader.IsFailed())
+                    {
+                        break;
+                    }
+
+                    append_timestamp(timestamp);
+                    output.append(text);
+                    break;
+                }
+
+                default:
+                {
+                    return Status::InvalidFormat;
+                }
+            }
+
+            if (reader.IsFailed())
+            {
+                //
+                // Log file may be cut off when application terminated abruptly. Messages decoded
+                // so far are still returned.
+                //
+
+                return Status::EndOfStream;
+            }
+        }
+
+        return Status::Success;
+    }
+}
@@ -1,48 +1,719 @@
 #include <GxBase/Diagnostics/Profiler.hxx>
+#include <GxBase/CommandLine.hxx>
+#include <GxBase/Storage/ArchiveMemoryWriter.hxx>
+#include <GxBase/Storage/BinaryFormat.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/Sync.hxx>
 
 #if defined(ENABLE_NSIGHT_PROFILER)
 #include <nvToolsExt.h>
 #endif
 
+#if (GX_CPU_X86_32 || GX_CPU_X86_64) && !GX_COMPILER_MSVC
+#include <x86intrin.h>
+#endif
+
+
+namespace Graphyte::Diagnostics::Impl
+{
+    enum class ProfilerEventType : uint8_t
+    {
+        Begin,
+        End,
+        Mark,
+    };
+
+    //
+    // Events are timestamped with TSC where available. TSC frequency is calibrated against system
+    // timestamp at capture time.
+    //
+
+    __forceinline uint64_t ProfilerGetTimestamp() noexcept
+    {
+#if GX_CPU_X86_32 || GX_CPU_X86_64
+        return __rdtsc();
+#else
+        return System::GetTimestamp();
+#endif
+    }
+
+    struct ProfilerEvent final
+    {
+        uint64_t Timestamp;
+        ProfilerRegionId Id;
+        ProfilerEventType Type;
+    };
+
+    static_assert(sizeof(ProfilerEvent) == 16);
+
+    //
+    // Maximum number of registered descriptors, including reserved unknown descriptor.
+    //
+
+    constexpr const size_t ProfilerDescriptorCapacity = size_t{ 1 } << 16;
+
+    static const ProfilerRegionDescriptor g_ProfilerUnknownDescriptor{
+        .Name  = "<unknown>",
+        .File  = nullptr,
+        .Line  = 0,
+        .Color = 0,
+    };
+
+    //
+    // Pool of interned runtime names. Strings are packed into blocks which are never freed, so
+    // interned names remain valid as long as descriptors referencing them.
+    //
+
+    constexpr const size_t ProfilerStringPoolBlockSize = 64 * 1024;
+
+    class ProfilerStringPool final
+    {
+    private:
+        std::vector<std::unique_ptr<char[]>> m_Blocks;
+        size_t m_Used{ ProfilerStringPoolBlockSize };
+
+    public:
+        const char* Intern(std::string_view value) noexcept
+        {
+            size_t const required = value.size() + 1;
+
+            if (required > ProfilerStringPoolBlockSize)
+            {
+                //
+                // Oversized strings get dedicated block. Current block stays last, so it is
+                // still filled.
+                //
+
+                auto block = std::make_unique<char[]>(required);
+                std::memcpy(block.get(), value.data(), value.size());
+                block[value.size()] = '\0';
+
+                char* const result = block.get();
+                m_Blocks.insert(m_Blocks.empty() ? m_Blocks.end() : std::prev(m_Blocks.end()), std::move(block));
+                return result;
+            }
+
+            if ((ProfilerStringPoolBlockSize - m_Used) < required)
+            {
+                m_Blocks.emplace_back(std::make_unique<char[]>(ProfilerStringPoolBlockSize));
+                m_Used = 0;
+            }
+
+            char* const result = m_Blocks.back().get() + m_Used;
+            std::memcpy(result, value.data(), value.size());
+            result[value.size()] = '\0';
+
+            m_Used += required;
+            return result;
+        }
+    };
+
+    //
+    // Number of events kept per thread. Older events are overwritten.
+    //
+
+    constexpr const size_t ProfilerThreadBufferCapacity = size_t{ 1 } << 16;
+
+    struct ProfilerThreadBuffer final
+    {
+        /// Events written by owning thread only.
+        std::unique_ptr<ProfilerEvent[]> Events;
+
+        /// Number of events written so far.
+        std::atomic<uint64_t> Head;
+
+        /// Index of first event not discarded by Profiler::Reset.
+        std::atomic<uint64_t> First;
+
+        /// Sequential thread identifier used in captures.
+        uint32_t ThreadId;
+
+        /// Name of thread. Guarded by registry lock.
+        std::string Name;
+    };
+
+    //
+    // Registry of all thread buffers. Buffers of exited threads are kept, so their events are
+    // still available for capture.
+    //
+
+    struct ProfilerRegistry final
+    {
+        Threading::SpinLock Lock;
+        std::vector<std::unique_ptr<ProfilerThreadBuffer>> Threads;
+        std::string CapturePath;
+        uint64_t StartTimestamp{ ProfilerGetTimestamp() };
+        uint64_t StartSystemTimestamp{ System::GetTimestamp() };
+
+        /// Registered descriptors indexed by region identifier.
+        std::unique_ptr<const ProfilerRegionDescriptor*[]> Descriptors{ MakeDescriptorTable() };
+
+        /// Number of registered descriptors.
+        size_t DescriptorCount{ 1 };
+
+        /// Descriptors of interned runtime names.
+        std::deque<ProfilerRegionDescriptor> DynamicDescriptors;
+        std::unordered_map<std::string_view, ProfilerRegionId> DynamicIds;
+        ProfilerStringPool DynamicNames;
+
+        static std::unique_ptr<const ProfilerRegionDescriptor*[]> MakeDescriptorTable() noexcept
+        {
+            auto result = std::make_unique<const ProfilerRegionDescriptor*[]>(ProfilerDescriptorCapacity);
+            result[0]   = &g_ProfilerUnknownDescriptor;
+            return result;
+        }
+
+        ProfilerRegionId AddDescriptor(const ProfilerRegionDescriptor& descriptor) noexcept
+        {
+            if (DescriptorCount >= ProfilerDescriptorCapacity)
+            {
+                return 0;
+            }
+
+            Descriptors[DescriptorCount] = &descriptor;
+            return static_cast<ProfilerRegionId>(DescriptorCount++);
+        }
+    };
+
+    static std::atomic<bool> g_ProfilerEnabled{};
+
+    static ProfilerRegistry& GetProfilerRegistry() noexcept
+    {
+        static ProfilerRegistry instance{};
+        return instance;
+    }
+
+    static thread_local ProfilerThreadBuffer* g_ProfilerThreadBuffer{};
+
+    static ProfilerThreadBuffer& GetProfilerThreadBuffer() noexcept
+    {
+        ProfilerThreadBuffer* buffer = g_ProfilerThreadBuffer;
+
+        if (buffer == nullptr) [[unlikely]]
+        {
+            ProfilerRegistry& registry = GetProfilerRegistry();
+
+            auto instance = std::make_unique<ProfilerThreadBuffer>();
+            buffer        = instance.get();
+
+            Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+            buffer->ThreadId = static_cast<uint32_t>(registry.Threads.size());
+            registry.Threads.push_back(std::move(instance));
+
+            g_ProfilerThreadBuffer = buffer;
+        }
+
+        return *buffer;
+    }
+
+    static void ProfilerRecord(ProfilerEventType type, ProfilerRegionId id) noexcept
+    {
+        ProfilerThreadBuffer& buffer = GetProfilerThreadBuffer();
+
+        if (buffer.Events == nullptr) [[unlikely]]
+        {
+            buffer.Events = std::make_unique<ProfilerEvent[]>(ProfilerThreadBufferCapacity);
+        }
+
+        //
+        // Single producer - only owning thread advances head. Release store publishes event to
+        // capturing thread.
+        //
+
+        uint64_t const head = buffer.Head.load(std::memory_order_relaxed);
+
+        buffer.Events[head & (ProfilerThreadBufferCapacity - 1)] = ProfilerEvent{
+            .Timestamp = ProfilerGetTimestamp(),
+            .Id        = id,
+            .Type      = type,
+        };
+
+        buffer.Head.store(head + 1, std::memory_order_release);
+    }
+
+    struct ProfilerThreadSnapshot final
+    {
+        uint32_t ThreadId;
+        std::string Name;
+        std::vector<ProfilerEvent> Events;
+    };
+
+    struct ProfilerSnapshot final
+    {
+        std::vector<const ProfilerRegionDescriptor*> Descriptors;
+        std::vector<ProfilerThreadSnapshot> Threads;
+    };
+
+    static ProfilerSnapshot ProfilerTakeSnapshot() noexcept
+    {
+        ProfilerRegistry& registry = GetProfilerRegistry();
+
+        ProfilerSnapshot snapshot{};
+
+        Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+        snapshot.Descriptors.assign(registry.Descriptors.get(), registry.Descriptors.get() + registry.DescriptorCount);
+
+        std::vector<ProfilerThreadSnapshot>& result = snapshot.Threads;
+        result.reserve(registry.Threads.size());
+
+        for (auto const& buffer : registry.Threads)
+        {
+            ProfilerThreadSnapshot& thread = result.emplace_back();
+            thread.ThreadId                = buffer->ThreadId;
+            thread.Name                    = buffer->Name;
+
+            if (buffer->Events == nullptr)
+            {
+                continue;
+            }
+
+            uint64_t const head = buffer->Head.load(std::memory_order_acquire);
+            uint64_t first      = std::max(
+                buffer->First.load(std::memory_order_relaxed),
+                (head > ProfilerThreadBufferCapacity) ? (head - ProfilerThreadBufferCapacity) : 0);
+
+            thread.Events.reserve(static_cast<size_t>(head - first));
+
+            for (uint64_t index = first; index < head; ++index)
+            {
+                thread.Events.push_back(buffer->Events[index & (ProfilerThreadBufferCapacity - 1)]);
+            }
+
+            //
+            // Owning thread may have overwritten oldest events while they were copied. Discard
+            // them.
+            //
+
+            uint64_t const end   = buffer->Head.load(std::memory_order_acquire);
+            uint64_t const valid = (end > ProfilerThreadBufferCapacity) ? (end - ProfilerThreadBufferCapacity) : 0;
+
+            if (valid > first)
+            {
+                size_t const discard = static_cast<size_t>(std::min(valid - first, head - first));
+                thread.Events.erase(thread.Events.begin(), thread.Events.begin() + static_cast<ptrdiff_t>(discard));
+            }
+        }
+
+        return snapshot;
+    }
+
+    static uint64_t ProfilerGetResolution() noexcept
+    {
+#if GX_CPU_X86_32 || GX_CPU_X86_64
+        ProfilerRegistry& registry = GetProfilerRegistry();
+
+        uint64_t const elapsed_system = System::GetTimestamp() - registry.StartSystemTimestamp;
+        uint64_t const elapsed        = ProfilerGetTimestamp() - registry.StartTimestamp;
+
+        if (elapsed_system != 0)
+        {
+            double const ratio = static_cast<double>(elapsed) / static_cast<double>(elapsed_system);
+            return static_cast<uint64_t>(ratio * static_cast<double>(System::GetTimestampResolution()));
+        }
+#endif
+
+        return System::GetTimestampResolution();
+    }
+
+    static void ProfilerAppendJsonString(std::string& output, std::string_view value) noexcept
+    {
+        output.push_back('"');
+
+        for (char const c : value)
+        {
+            switch (c)
+            {
+                case '"':
+                    output.append("\\\"");
+                    break;
+                case '\\':
+                    output.append("\\\\");
+                    break;
+                case '\n':
+                    output.append("\\n");
+                    break;
+                case '\t':
+                    output.append("\\t");
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        fmt::format_to(std::back_inserter(output), "\\u{:04x}", static_cast<unsigned>(c));
+                    }
+                    else
+                    {
+                        output.push_back(c);
+                    }
+                    break;
+            }
+        }
+
+        output.push_back('"');
+    }
+
+    static std::string ProfilerWriteChromeTrace(
+        const ProfilerSnapshot& snapshot,
+        uint64_t start,
+        uint64_t end,
+        uint64_t resolution) noexcept
+    {
+        double const scale = 1'000'000.0 / static_cast<double>(resolution);
+
+        auto to_microseconds = [&](uint64_t timestamp) {
+            return static_cast<double>(timestamp - std::min(timestamp, start)) * scale;
+        };
+
+        std::string output{};
+        output.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+        auto descriptor_of = [&](const ProfilerEvent& event) -> const ProfilerRegionDescriptor& {
+            return (event.Id < snapshot.Descriptors.size()) ? *snapshot.Descriptors[event.Id] : g_ProfilerUnknownDescriptor;
+        };
+
+        auto append_source = [&](const ProfilerRegionDescriptor& descriptor) {
+            if (descriptor.File != nullptr)
+            {
+                output.append(",\"args\":{\"file\":");
+                ProfilerAppendJsonString(output, descriptor.File);
+                fmt::format_to(std::back_inserter(output), ",\"line\":{}}}", descriptor.Line);
+            }
+        };
+
+        bool first = true;
+
+        auto separator = [&]() {
+            if (!first)
+            {
+                output.append(",\n");
+            }
+
+            first = false;
+        };
+
+        for (auto const& thread : snapshot.Threads)
+        {
+            if (!thread.Name.empty())
+            {
+                separator();
+                fmt::format_to(
+                    std::back_inserter(output),
+                    "{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":",
+                    thread.ThreadId);
+                ProfilerAppendJsonString(output, thread.Name);
+                output.append("}}");
+            }
+
+            //
+            // Match begin and end events into complete events. End events whose begin was
+            // overwritten are dropped; regions still open are closed at capture time.
+            //
+
+            std::vector<const ProfilerEvent*> stack{};
+
+            auto emit_region = [&](const ProfilerEvent& begin, uint64_t timestamp) {
+                const ProfilerRegionDescriptor& descriptor = descriptor_of(begin);
+
+                separator();
+                output.append("{\"ph\":\"X\",\"name\":");
+                ProfilerAppendJsonString(output, descriptor.Name);
+                fmt::format_to(
+                    std::back_inserter(output),
+                    ",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                    thread.ThreadId,
+                    to_microseconds(begin.Timestamp),
+                    to_microseconds(timestamp) - to_microseconds(begin.Timestamp));
+                append_source(descriptor);
+                output.push_back('}');
+            };
+
+            for (auto const& event : thread.Events)
+            {
+                switch (event.Type)
+                {
+                    case ProfilerEventType::Begin:
+                        stack.push_back(&event);
+                        break;
+
+                    case ProfilerEventType::End:
+                        if (!stack.empty())
+                        {
+                            emit_region(*stack.back(), event.Timestamp);
+                            stack.pop_back();
+                        }
+                        break;
+
+                    case ProfilerEventType::Mark:
+                    {
+                        const ProfilerRegionDescriptor& descriptor = descriptor_of(event);
+
+                        separator();
+                        output.append("{\"ph\":\"i\",\"s\":\"t\",\"name\":");
+                        ProfilerAppendJsonString(output, descriptor.Name);
+                        fmt::format_to(
+                            std::back_inserter(output),
+                            ",\"pid\":1,\"tid\":{},\"ts\":{:.3f}",
+                            thread.ThreadId,
+                            to_microseconds(event.Timestamp));
+                        append_source(descriptor);
+                        output.push_back('}');
+                        break;
+                    }
+                }
+            }
+
+            while (!stack.empty())
+            {
+                emit_region(*stack.back(), end);
+                stack.pop_back();
+            }
+        }
+
+        output.append("\n]}\n");
+        return output;
+    }
+
+    static std::vector<std::byte> ProfilerWriteBinary(
+        const ProfilerSnapshot& snapshot,
+        uint64_t start,
+        uint64_t resolution) noexcept
+    {
+        //
+        // Layout:
+        //
+        //  signature, version, timestamp resolution, start timestamp
+        //  descriptor count, descriptors: name, file, line, color
+        //  thread count, threads: id, name, event count, events: timestamp, region id, type
+        //
+
+        std::vector<std::byte> output{};
+        Storage::ArchiveMemoryWriter writer{ output };
+
+        Storage::BinarySignature signature{ 0x465250584647ULL };
+        Storage::BinaryFormatVersion version{ 2, 0 };
+        uint64_t timestamp_resolution = resolution;
+        uint64_t start_timestamp      = start;
+
+        writer << signature << version << timestamp_resolution << start_timestamp;
+
+        uint32_t descriptor_count = static_cast<uint32_t>(snapshot.Descriptors.size());
+        writer << descriptor_count;
+
+        for (auto const* descriptor : snapshot.Descriptors)
+        {
+            std::string name = descriptor->Name;
+            std::string file = (descriptor->File != nullptr) ? descriptor->File : "";
+            uint32_t line    = descriptor->Line;
+            uint32_t color   = descriptor->Color;
+
+            writer << name << file << line << color;
+        }
+
+        uint32_t thread_count = static_cast<uint32_t>(snapshot.Threads.size());
+        writer << thread_count;
+
+        for (auto const& thread : snapshot.Threads)
+        {
+            uint32_t thread_id   = thread.ThreadId;
+            std::string name     = thread.Name;
+            uint64_t event_count = thread.Events.size();
+
+            writer << thread_id << name << event_count;
+
+            for (auto const& event : thread.Events)
+            {
+                uint64_t timestamp = event.Timestamp;
+                uint16_t id        = event.Id;
+                uint8_t type       = static_cast<uint8_t>(event.Type);
+
+                writer << timestamp << id << type;
+            }
+        }
+
+        return output;
+    }
+}
 
 namespace Graphyte::Diagnostics
 {
     void Profiler::Initialize() noexcept
     {
+        Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+
+        if (auto option = CommandLine::Get("--profile"); option.has_value())
+        {
+            if (!option->empty())
+            {
+                registry.CapturePath = *option;
+            }
+            else
+            {
+                registry.CapturePath = Storage::GetProfilingDirectory();
+                Storage::AppendPath(registry.CapturePath, "capture.json");
+            }
+
+            Profiler::Enable(true);
+        }
     }
 
     void Profiler::Finalize() noexcept
     {
+        Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+
+        Profiler::Enable(false);
+
+        if (!registry.CapturePath.empty())
+        {
+            ProfilerCaptureFormat const format = (Storage::GetExtension(registry.CapturePath) == "json")
+                                                     ? ProfilerCaptureFormat::ChromeTrace
+                                                     : ProfilerCaptureFormat::Binary;
+
+            [[maybe_unused]] Status const status = Profiler::Capture(registry.CapturePath, format);
+            GX_ASSERT(status == Status::Success);
+
+            registry.CapturePath.clear();
+        }
     }
 
-    void Profiler::ThreadName(
-        [[maybe_unused]] const char* name) noexcept
+    void Profiler::Enable(
+        bool enable) noexcept
     {
-#if defined(ENABLE_NSIGHT_PROFILER)
-        nvtxNameOsThreadA(GetCurrentThreadId(), name);
-#endif
+        Impl::g_ProfilerEnabled.store(enable, std::memory_order_relaxed);
     }
 
-    void Profiler::PushRange(
+    bool Profiler::IsEnabled() noexcept
+    {
+        return Impl::g_ProfilerEnabled.load(std::memory_order_relaxed);
+    }
+
+    Status Profiler::Capture(
+        std::string_view path,
+        ProfilerCaptureFormat format) noexcept
+    {
+        uint64_t const end        = Impl::ProfilerGetTimestamp();
+        uint64_t const start      = Impl::GetProfilerRegistry().StartTimestamp;
+        uint64_t const resolution = Impl::ProfilerGetResolution();
+
+        auto const snapshot = Impl::ProfilerTakeSnapshot();
+
+        switch (format)
+        {
+            case ProfilerCaptureFormat::ChromeTrace:
+                return Storage::WriteText(Impl::ProfilerWriteChromeTrace(snapshot, start, end, resolution), path);
+
+            case ProfilerCaptureFormat::Binary:
+                return Storage::WriteBinary(Impl::ProfilerWriteBinary(snapshot, start, resolution), path);
+        }
+
+        return Status::InvalidArgument;
+    }
+
+    void Profiler::Reset() noexcept
+    {
+        Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+
+        Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+        for (auto const& buffer : registry.Threads)
+        {
+            buffer->First.store(buffer->Head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+    }
+
+    ProfilerRegionId Profiler::Register(
+        const ProfilerRegionDescriptor& descriptor) noexcept
+    {
+        Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+
+        Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+        return registry.AddDescriptor(descriptor);
+    }
+
+    ProfilerRegionId Profiler::InternName(
+        std::string_view name,
+        uint32_t color) noexcept
+    {
+        Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+
+        Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+
+        if (auto const it = registry.DynamicIds.find(name); it != registry.DynamicIds.end())
+        {
+            return it->second;
+        }
+
+        if (registry.DescriptorCount >= Impl::ProfilerDescriptorCapacity)
+        {
+            return 0;
+        }
+
+        const char* const interned = registry.DynamicNames.Intern(name);
+
+        auto const& descriptor = registry.DynamicDescriptors.emplace_back(ProfilerRegionDescriptor{
+            .Name  = interned,
+            .File  = nullptr,
+            .Line  = 0,
+            .Color = color,
+        });
+
+        ProfilerRegionId const id = registry.AddDescriptor(descriptor);
+        registry.DynamicIds.emplace(std::string_view{ interned, name.size() }, id);
+
+        return id;
+    }
+
+    const ProfilerRegionDescriptor& Profiler::GetDescriptor(
+        ProfilerRegionId id) noexcept
+    {
+        Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+
+        //
+        // Descriptors are never removed, so lookup of published identifier does not need lock.
+        //
+
+        const ProfilerRegionDescriptor* const descriptor = registry.Descriptors[id];
+        return (descriptor != nullptr) ? *descriptor : Impl::g_ProfilerUnknownDescriptor;
+    }
+
+    void Profiler::ThreadName(
         [[maybe_unused]] const char* name) noexcept
     {
+        Impl::ProfilerThreadBuffer& buffer = Impl::GetProfilerThreadBuffer();
+
+        {
+            Impl::ProfilerRegistry& registry = Impl::GetProfilerRegistry();
+            Threading::ScopedLock<Threading::SpinLock> lock{ registry.Lock };
+            buffer.Name = name;
+        }
+
 #if defined(ENABLE_NSIGHT_PROFILER)
-        nvtxRangePushA(name);
+        nvtxNameOsThreadA(GetCurrentThreadId(), name);
 #endif
     }
 
     void Profiler::PushRange(
-        [[maybe_unused]] const char* name,
-        [[maybe_unused]] uint32_t color) noexcept
+        ProfilerRegionId id) noexcept
     {
+        if (Impl::g_ProfilerEnabled.load(std::memory_order_relaxed))
+        {
+            Impl::ProfilerRecord(Impl::ProfilerEventType::Begin, id);
+        }
+
 #if defined(ENABLE_NSIGHT_PROFILER)
+        const ProfilerRegionDescriptor& descriptor = Profiler::GetDescriptor(id);
+
         nvtxEventAttributes_t event_attr{
             .version       = NVTX_VERSION,
             .size          = NVTX_EVENT_ATTRIB_STRUCT_SIZE,
             .colorType     = NVTX_COLOR_ARGB,
-            .color         = color,
+            .color         = descriptor.Color,
             .messageType   = NVTX_MESSAGE_TYPE_ASCII,
-            .message.ascii = name,
+            .message.ascii = descriptor.Name,
         };
 
         nvtxRangePushEx(&event_attr);
@@ -51,31 +722,39 @@ namespace Graphyte::Diagnostics
 
     void Profiler::PopRange() noexcept
     {
+        //
+        // Regions interrupted by enabling or disabling profiler are unbalanced. Export drops
+        // unmatched end events and closes regions still open at capture time.
+        //
+
+        if (Impl::g_ProfilerEnabled.load(std::memory_order_relaxed))
+        {
+            Impl::ProfilerRecord(Impl::ProfilerEventType::End, 0);
+        }
+
 #if defined(ENABLE_NSIGHT_PROFILER)
         nvtxRangePop();
 #endif
     }
 
     void Profiler::MarkEvent(
-        [[maybe_unused]] const char* name) noexcept
+        ProfilerRegionId id) noexcept
     {
-#if defined(ENABLE_NSIGHT_PROFILER)
-        nvtxMarkA(name);
-#endif
-    }
+        if (Impl::g_ProfilerEnabled.load(std::memory_order_relaxed))
+        {
+            Impl::ProfilerRecord(Impl::ProfilerEventType::Mark, id);
+        }
 
-    void Profiler::MarkEvent(
-        [[maybe_unused]] const char* name,
-        [[maybe_unused]] uint32_t color) noexcept
-    {
 #if defined(ENABLE_NSIGHT_PROFILER)
+        const ProfilerRegionDescriptor& descriptor = Profiler::GetDescriptor(id);
+
         nvtxEventAttributes_t event_attr{
             .version       = NVTX_VERSION,
             .size          = NVTX_EVENT_ATTRIB_STRUCT_SIZE,
             .colorType     = NVTX_COLOR_ARGB,
-            .color         = color,
+            .color         = descriptor.Color,
             .messageType   = NVTX_MESSAGE_TYPE_ASCII,
-            .message.ascii = name,
+            .message.ascii = descriptor.Name,
         };
 
         nvtxMarkEx(&event_attr);
@@ -0,0 +1 @@
+#include <GxBase/HashContainers.hxx>
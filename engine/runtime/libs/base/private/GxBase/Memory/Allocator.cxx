@@ -0,0 +1,539 @@
+#include <GxBase/Memory/Allocator.hxx>
+#include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Bitwise.hxx>
+#include <GxBase/System.hxx>
+
+namespace Graphyte::Memory::Impl
+{
+    //
+    // Size classes grow by 16 bytes up to 128 bytes, then in four steps per power of two, which
+    // bounds internal fragmentation to 25%.
+    //
+
+    constexpr const size_t AllocatorMinBlockSize  = 32;
+    constexpr const size_t AllocatorMaxBlockSize  = 32 << 10;
+    constexpr const size_t AllocatorLinearClasses = 7;
+    constexpr const size_t AllocatorClassCount    = 39;
+
+    constexpr const size_t AllocatorPageSize = 4096;
+
+    static_assert(MaxAlignment <= AllocatorPageSize);
+
+    [[nodiscard]] constexpr size_t GetAllocatorClass(size_t size) noexcept
+    {
+        if (size <= AllocatorMinBlockSize)
+        {
+            return 0;
+        }
+
+        if (size <= 128)
+        {
+            return (AlignUp<size_t>(size, 16) - AllocatorMinBlockSize) / 16;
+        }
+
+        size_t const order = static_cast<size_t>(std::bit_width(size - 1)) - 1;
+        size_t const step  = (size_t{ 1 } << order) / 4;
+
+        return AllocatorLinearClasses + ((order - 7) * 4) + ((size - 1 - (size_t{ 1 } << order)) / step);
+    }
+
+    [[nodiscard]] constexpr size_t GetAllocatorBlockSize(size_t index) noexcept
+    {
+        if (index < AllocatorLinearClasses)
+        {
+            return AllocatorMinBlockSize + (index * 16);
+        }
+
+        size_t const order = 7 + ((index - AllocatorLinearClasses) / 4);
+        size_t const step  = (size_t{ 1 } << order) / 4;
+
+        return (size_t{ 1 } << order) + (step * (((index - AllocatorLinearClasses) % 4) + 1));
+    }
+
+    static_assert(GetAllocatorBlockSize(AllocatorClassCount - 1) == AllocatorMaxBlockSize);
+    static_assert(GetAllocatorClass(AllocatorMaxBlockSize) == AllocatorClassCount - 1);
+
+    [[nodiscard]] constexpr bool ValidateAllocatorClasses() noexcept
+    {
+        for (size_t index = 0; index < AllocatorClassCount; ++index)
+        {
+            size_t const size = GetAllocatorBlockSize(index);
+
+            if (GetAllocatorClass(size) != index || (index != 0 && GetAllocatorClass(GetAllocatorBlockSize(index - 1) + 1) != index))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(ValidateAllocatorClasses());
+
+    //
+    // Spans hold at least eight blocks, so large classes do not allocate from OS too often.
+    //
+
+    [[nodiscard]] constexpr size_t GetAllocatorSpanSize(size_t index) noexcept
+    {
+        return std::max<size_t>(64 << 10, GetAllocatorBlockSize(index) * 8);
+    }
+
+    //
+    // Number of blocks moved between thread cache and depot at once.
+    //
+
+    [[nodiscard]] constexpr size_t GetAllocatorBatchSize(size_t index) noexcept
+    {
+        return std::clamp<size_t>((16 << 10) / GetAllocatorBlockSize(index), 4, 64);
+    }
+
+    //
+    // Header precedes every allocation.
+    //
+
+    constexpr const uint16_t AllocationLargeClass = 0xFFFF;
+    constexpr const uint8_t AllocationMarker      = 0xA5;
+    constexpr const uint8_t AllocationFreedMarker = 0xDD;
+
+    struct AllocationHeader final
+    {
+        /// Size of allocation, as requested.
+        uint64_t Size;
+
+        /// Distance from start of block to allocated memory.
+        uint32_t Offset;
+
+        /// Size class of block.
+        uint16_t Class;
+
+        /// Tag of allocation.
+        uint8_t Tag;
+
+        /// Detects invalid pointers and double frees.
+        uint8_t Marker;
+    };
+
+    static_assert(sizeof(AllocationHeader) == DefaultAlignment);
+    static_assert(MemoryPoolTagCount <= 256);
+
+    [[nodiscard]] static AllocationHeader* GetAllocationHeader(const void* memory) noexcept
+    {
+        AllocationHeader* const header = reinterpret_cast<AllocationHeader*>(const_cast<void*>(memory)) - 1;
+        GX_ASSERTF(header->Marker == AllocationMarker, "Invalid or freed memory: {}", memory);
+        return header;
+    }
+
+    struct AllocatorBlock final
+    {
+        /// Next block in list.
+        AllocatorBlock* Next;
+
+        /// Next batch in depot. Valid for first block of batch.
+        AllocatorBlock* NextBatch;
+
+        /// Number of blocks in batch. Valid for first block of batch.
+        size_t BatchCount;
+    };
+
+    static_assert(sizeof(AllocatorBlock) <= AllocatorMinBlockSize);
+
+    class AllocatorDepot final
+    {
+    private:
+        struct alignas(GX_CACHELINE_SIZE) ClassDepot final
+        {
+            Threading::SpinLock Lock;
+            AllocatorBlock* Batches;
+        };
+
+    private:
+        ClassDepot m_Classes[AllocatorClassCount];
+        std::atomic<uint64_t> m_Reserved;
+        std::atomic<uint64_t> m_Large;
+        std::atomic<uint64_t> m_SpanAllocations;
+        std::atomic<uint64_t> m_BatchTransfers;
+
+    public:
+        AllocatorDepot() noexcept
+            : m_Classes{}
+            , m_Reserved{}
+            , m_Large{}
+            , m_SpanAllocations{}
+            , m_BatchTransfers{}
+        {
+        }
+
+    public:
+        AllocatorBlock* AcquireBatch(size_t index, size_t& count) noexcept
+        {
+            m_BatchTransfers.fetch_add(1, std::memory_order_relaxed);
+
+            ClassDepot& depot = m_Classes[index];
+
+            {
+                Threading::ScopedLock<Threading::SpinLock> lock{ depot.Lock };
+
+                if (AllocatorBlock* batch = depot.Batches; batch != nullptr)
+                {
+                    depot.Batches = batch->NextBatch;
+                    count         = batch->BatchCount;
+                    return batch;
+                }
+            }
+
+            return AllocateSpan(index, count);
+        }
+
+        void ReleaseBatch(size_t index, AllocatorBlock* batch, size_t count) noexcept
+        {
+            GX_ASSERT(batch != nullptr);
+            GX_ASSERT(count != 0);
+
+            m_BatchTransfers.fetch_add(1, std::memory_order_relaxed);
+
+            ClassDepot& depot = m_Classes[index];
+
+            batch->BatchCount = count;
+
+            Threading::ScopedLock<Threading::SpinLock> lock{ depot.Lock };
+            batch->NextBatch = depot.Batches;
+            depot.Batches    = batch;
+        }
+
+        void* AllocateLarge(size_t size) noexcept
+        {
+            void* const result = System::OsVirtualAlloc(size);
+
+            if (result != nullptr)
+            {
+                m_Large.fetch_add(size, std::memory_order_relaxed);
+            }
+
+            return result;
+        }
+
+        void FreeLarge(void* memory, size_t size) noexcept
+        {
+            m_Large.fetch_sub(size, std::memory_order_relaxed);
+            System::OsVirtualFree(memory, size);
+        }
+
+        AllocatorStatistics GetStatistics() const noexcept
+        {
+            return AllocatorStatistics{
+                .Reserved        = m_Reserved.load(std::memory_order_relaxed),
+                .Large           = m_Large.load(std::memory_order_relaxed),
+                .SpanAllocations = m_SpanAllocations.load(std::memory_order_relaxed),
+                .BatchTransfers  = m_BatchTransfers.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+        AllocatorBlock* AllocateSpan(size_t index, size_t& count) noexcept
+        {
+            size_t const span_size = GetAllocatorSpanSize(index);
+
+            std::byte* const span = static_cast<std::byte*>(System::OsVirtualAlloc(span_size));
+
+            if (span == nullptr)
+            {
+                count = 0;
+                return nullptr;
+            }
+
+            m_SpanAllocations.fetch_add(1, std::memory_order_relaxed);
+            m_Reserved.fetch_add(span_size, std::memory_order_relaxed);
+
+            //
+            // Split span into batches. First batch is returned to caller, remaining ones are
+            // stored in depot.
+            //
+
+            size_t const block_size  = GetAllocatorBlockSize(index);
+            size_t const block_count = span_size / block_size;
+            size_t const batch_size  = GetAllocatorBatchSize(index);
+
+            AllocatorBlock* result{};
+
+            for (size_t first = 0; first < block_count; first += batch_size)
+            {
+                size_t const last = std::min(first + batch_size, block_count);
+
+                for (size_t i = first; i < last; ++i)
+                {
+                    auto* block = reinterpret_cast<AllocatorBlock*>(span + (i * block_size));
+                    block->Next = (i + 1 < last)
+                                      ? reinterpret_cast<AllocatorBlock*>(span + ((i + 1) * block_size))
+                                      : nullptr;
+                }
+
+                auto* batch = reinterpret_cast<AllocatorBlock*>(span + (first * block_size));
+
+                if (result == nullptr)
+                {
+                    result = batch;
+                    count  = last - first;
+                }
+                else
+                {
+                    ReleaseBatch(index, batch, last - first);
+                }
+            }
+
+            return result;
+        }
+    };
+
+    //
+    // Depot and its spans are never released, because memory may be freed by static destructors
+    // running after this module is finalized.
+    //
+
+    static AllocatorDepot& GetAllocatorDepot() noexcept
+    {
+        alignas(AllocatorDepot) static std::byte storage[sizeof(AllocatorDepot)];
+        static AllocatorDepot* const instance = new (storage) AllocatorDepot{};
+        return *instance;
+    }
+
+    //
+    // Set when thread cache is destroyed, so allocations made later during thread exit go straight
+    // to depot.
+    //
+
+    static thread_local bool t_AllocatorCacheReleased = false;
+
+    class AllocatorCache final
+    {
+    private:
+        AllocatorBlock* m_Head[AllocatorClassCount];
+        size_t m_Count[AllocatorClassCount];
+        AllocatorDepot& m_Depot;
+
+    public:
+        AllocatorCache() noexcept
+            : m_Head{}
+            , m_Count{}
+            , m_Depot{ GetAllocatorDepot() }
+        {
+        }
+
+        ~AllocatorCache() noexcept
+        {
+            for (size_t index = 0; index < AllocatorClassCount; ++index)
+            {
+                if (m_Head[index] != nullptr)
+                {
+                    m_Depot.ReleaseBatch(index, m_Head[index], m_Count[index]);
+                }
+            }
+
+            t_AllocatorCacheReleased = true;
+        }
+
+    public:
+        void* Allocate(size_t index) noexcept
+        {
+            if (m_Head[index] == nullptr)
+            {
+                m_Head[index] = m_Depot.AcquireBatch(index, m_Count[index]);
+
+                if (m_Head[index] == nullptr)
+                {
+                    return nullptr;
+                }
+            }
+
+            AllocatorBlock* const block = m_Head[index];
+            m_Head[index]               = block->Next;
+            --m_Count[index];
+
+            return block;
+        }
+
+        void Deallocate(void* memory, size_t index) noexcept
+        {
+            auto* const block = static_cast<AllocatorBlock*>(memory);
+            block->Next       = m_Head[index];
+            m_Head[index]     = block;
+
+            size_t const batch_size = GetAllocatorBatchSize(index);
+
+            if (++m_Count[index] >= (batch_size * 2))
+            {
+                //
+                // Keep most recently used blocks in cache and move surplus to depot.
+                //
+
+                AllocatorBlock* keep = m_Head[index];
+
+                for (size_t i = 1; i < batch_size; ++i)
+                {
+                    keep = keep->Next;
+                }
+
+                AllocatorBlock* const batch = keep->Next;
+                keep->Next                  = nullptr;
+
+                size_t const count = m_Count[index] - batch_size;
+                m_Count[index]     = batch_size;
+
+                m_Depot.ReleaseBatch(index, batch, count);
+            }
+        }
+    };
+
+    static AllocatorCache& GetAllocatorCache() noexcept
+    {
+        static thread_local AllocatorCache instance{};
+        return instance;
+    }
+
+    static void* AllocateBlock(size_t index) noexcept
+    {
+        if (!t_AllocatorCacheReleased)
+        {
+            return GetAllocatorCache().Allocate(index);
+        }
+
+        AllocatorDepot& depot = GetAllocatorDepot();
+
+        size_t count{};
+        AllocatorBlock* const batch = depot.AcquireBatch(index, count);
+
+        if (batch != nullptr && count > 1)
+        {
+            depot.ReleaseBatch(index, batch->Next, count - 1);
+        }
+
+        return batch;
+    }
+
+    static void DeallocateBlock(void* memory, size_t index) noexcept
+    {
+        if (!t_AllocatorCacheReleased)
+        {
+            GetAllocatorCache().Deallocate(memory, index);
+            return;
+        }
+
+        auto* const block = static_cast<AllocatorBlock*>(memory);
+        block->Next       = nullptr;
+
+        GetAllocatorDepot().ReleaseBatch(index, block, 1);
+    }
+}
+
+namespace Graphyte::Memory
+{
+    BASE_API void* Allocate(
+        MemoryPoolTag tag,
+        size_t size,
+        size_t alignment) noexcept
+    {
+        GX_ASSERT(IsPowerOf2(alignment));
+        GX_ASSERT(alignment <= MaxAlignment);
+
+        alignment = std::max(alignment, DefaultAlignment);
+
+        if (size > (std::numeric_limits<size_t>::max() - Impl::AllocatorPageSize - alignment))
+        {
+            return nullptr;
+        }
+
+        //
+        // Blocks are aligned to header size. Larger alignment is satisfied by skipping part of
+        // block before header.
+        //
+
+        size_t const required = size + alignment;
+
+        std::byte* block{};
+        uint16_t index{};
+
+        if (required <= Impl::AllocatorMaxBlockSize)
+        {
+            index = static_cast<uint16_t>(Impl::GetAllocatorClass(required));
+            block = static_cast<std::byte*>(Impl::AllocateBlock(index));
+        }
+        else
+        {
+            index = Impl::AllocationLargeClass;
+            block = static_cast<std::byte*>(Impl::GetAllocatorDepot().AllocateLarge(AlignUp<size_t>(required, Impl::AllocatorPageSize)));
+        }
+
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+
+        std::byte* const memory = AlignUp(block + sizeof(Impl::AllocationHeader), std::align_val_t{ alignment });
+
+        auto* const header = reinterpret_cast<Impl::AllocationHeader*>(memory) - 1;
+        header->Size       = size;
+        header->Offset     = static_cast<uint32_t>(memory - block);
+        header->Class      = index;
+        header->Tag        = static_cast<uint8_t>(tag);
+        header->Marker     = Impl::AllocationMarker;
+
+        //
+        // Pages are aligned to any supported alignment, so large allocations always skip exactly
+        // alignment bytes and their size is recomputed on free.
+        //
+
+        GX_ASSERT(index != Impl::AllocationLargeClass || header->Offset == alignment);
+
+        MemoryTracker::Track(tag, size);
+
+        return memory;
+    }
+
+    BASE_API void Free(
+        void* memory) noexcept
+    {
+        if (memory == nullptr)
+        {
+            return;
+        }
+
+        Impl::AllocationHeader* const header = Impl::GetAllocationHeader(memory);
+
+        MemoryTracker::Untrack(static_cast<MemoryPoolTag>(header->Tag), header->Size);
+
+        header->Marker = Impl::AllocationFreedMarker;
+
+        std::byte* const block = static_cast<std::byte*>(memory) - header->Offset;
+
+        if (header->Class == Impl::AllocationLargeClass)
+        {
+            Impl::GetAllocatorDepot().FreeLarge(block, AlignUp<size_t>(header->Offset + header->Size, Impl::AllocatorPageSize));
+        }
+        else
+        {
+            Impl::DeallocateBlock(block, header->Class);
+        }
+    }
+
+    BASE_API size_t GetAllocationSize(
+        const void* memory) noexcept
+    {
+        GX_ASSERT(memory != nullptr);
+
+        return Impl::GetAllocationHeader(memory)->Size;
+    }
+
+    BASE_API MemoryPoolTag GetAllocationTag(
+        const void* memory) noexcept
+    {
+        GX_ASSERT(memory != nullptr);
+
+        return static_cast<MemoryPoolTag>(Impl::GetAllocationHeader(memory)->Tag);
+    }
+
+    BASE_API AllocatorStatistics GetAllocatorStatistics() noexcept
+    {
+        return Impl::GetAllocatorDepot().GetStatistics();
+    }
+}
@@ -0,0 +1,247 @@
+#include <GxBase/Memory/Arena.hxx>
+#include <GxBase/Bitwise.hxx>
+
+namespace Graphyte::Memory::Impl
+{
+#if GX_ENABLE_MEMORY_GUARDS
+
+    constexpr const std::byte ArenaAllocatedPattern{ 0xCD };
+    constexpr const std::byte ArenaReleasedPattern{ 0xDD };
+    constexpr const std::byte ArenaGuardPattern{ 0xFD };
+
+    constexpr const size_t ArenaGuardSize     = 16;
+    constexpr const size_t ArenaInvalidOffset = std::numeric_limits<size_t>::max();
+
+    //
+    // Allocations are linked from last to first, so guards of released allocations are checked
+    // without separate bookkeeping.
+    //
+
+    struct ArenaGuardHeader final
+    {
+        size_t Size;
+        size_t Previous;
+    };
+
+    [[nodiscard]] static bool IsGuardValid(const std::byte* memory, size_t offset) noexcept
+    {
+        auto const* const header = reinterpret_cast<const ArenaGuardHeader*>(memory + offset);
+        std::byte const* const guard = memory + offset + sizeof(ArenaGuardHeader) + header->Size;
+
+        return std::all_of(guard, guard + ArenaGuardSize, [](std::byte value) {
+            return value == ArenaGuardPattern;
+        });
+    }
+
+#endif
+}
+
+namespace Graphyte::Memory
+{
+    LinearArena::LinearArena() noexcept
+        : m_Memory{}
+        , m_Capacity{}
+        , m_Offset{}
+        , m_Peak{}
+        , m_Tag{ MemoryPoolTag::General }
+        , m_Owned{}
+#if GX_ENABLE_MEMORY_GUARDS
+        , m_Last{ Impl::ArenaInvalidOffset }
+#endif
+    {
+    }
+
+    LinearArena::LinearArena(
+        size_t capacity,
+        MemoryPoolTag tag) noexcept
+        : LinearArena{}
+    {
+        m_Memory = static_cast<std::byte*>(Memory::Allocate(tag, capacity, GX_CACHELINE_SIZE));
+        GX_ASSERTF(m_Memory != nullptr, "Cannot allocate arena (tag: {}, capacity: {})", ToString(tag), capacity);
+
+        if (m_Memory != nullptr)
+        {
+            m_Capacity = capacity;
+            m_Tag      = tag;
+            m_Owned    = true;
+
+#if GX_ENABLE_MEMORY_GUARDS
+            std::memset(m_Memory, static_cast<int>(Impl::ArenaReleasedPattern), m_Capacity);
+#endif
+        }
+    }
+
+    LinearArena::LinearArena(
+        std::span<std::byte> memory) noexcept
+        : LinearArena{}
+    {
+        m_Memory   = memory.data();
+        m_Capacity = memory.size();
+
+#if GX_ENABLE_MEMORY_GUARDS
+        std::memset(m_Memory, static_cast<int>(Impl::ArenaReleasedPattern), m_Capacity);
+#endif
+    }
+
+    LinearArena::LinearArena(LinearArena&& other) noexcept
+        : m_Memory{ std::exchange(other.m_Memory, nullptr) }
+        , m_Capacity{ std::exchange(other.m_Capacity, 0) }
+        , m_Offset{ std::exchange(other.m_Offset, 0) }
+        , m_Peak{ std::exchange(other.m_Peak, 0) }
+        , m_Tag{ other.m_Tag }
+        , m_Owned{ std::exchange(other.m_Owned, false) }
+#if GX_ENABLE_MEMORY_GUARDS
+        , m_Last{ std::exchange(other.m_Last, Impl::ArenaInvalidOffset) }
+#endif
+    {
+    }
+
+    LinearArena& LinearArena::operator=(LinearArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+
+            m_Memory   = std::exchange(other.m_Memory, nullptr);
+            m_Capacity = std::exchange(other.m_Capacity, 0);
+            m_Offset   = std::exchange(other.m_Offset, 0);
+            m_Peak     = std::exchange(other.m_Peak, 0);
+            m_Tag      = other.m_Tag;
+            m_Owned    = std::exchange(other.m_Owned, false);
+#if GX_ENABLE_MEMORY_GUARDS
+            m_Last = std::exchange(other.m_Last, Impl::ArenaInvalidOffset);
+#endif
+        }
+
+        return *this;
+    }
+
+    LinearArena::~LinearArena() noexcept
+    {
+        Destroy();
+    }
+
+    void* LinearArena::Allocate(
+        size_t size,
+        size_t alignment) noexcept
+    {
+        GX_ASSERT(IsPowerOf2(alignment));
+
+        uintptr_t const base = reinterpret_cast<uintptr_t>(m_Memory);
+
+#if GX_ENABLE_MEMORY_GUARDS
+        alignment = std::max(alignment, alignof(Impl::ArenaGuardHeader));
+
+        size_t const header = sizeof(Impl::ArenaGuardHeader);
+        size_t const guard  = Impl::ArenaGuardSize;
+#else
+        size_t const header = 0;
+        size_t const guard  = 0;
+#endif
+
+        size_t const start = AlignUp<uintptr_t>(base + m_Offset + header, alignment) - base;
+
+        if (start > m_Capacity || guard > (m_Capacity - start) || size > (m_Capacity - start - guard))
+        {
+            return nullptr;
+        }
+
+        std::byte* const memory = m_Memory + start;
+
+#if GX_ENABLE_MEMORY_GUARDS
+        size_t const header_offset = start - header;
+
+        auto* const guard_header = reinterpret_cast<Impl::ArenaGuardHeader*>(m_Memory + header_offset);
+        guard_header->Size       = size;
+        guard_header->Previous   = m_Last;
+        m_Last                   = header_offset;
+
+        std::memset(memory, static_cast<int>(Impl::ArenaAllocatedPattern), size);
+        std::memset(memory + size, static_cast<int>(Impl::ArenaGuardPattern), guard);
+#endif
+
+        m_Offset = start + size + guard;
+        m_Peak   = std::max(m_Peak, m_Offset);
+
+        return memory;
+    }
+
+    void LinearArena::Release(
+        ArenaMarker marker) noexcept
+    {
+        size_t const offset = static_cast<size_t>(marker);
+        GX_ASSERT(offset <= m_Offset);
+
+#if GX_ENABLE_MEMORY_GUARDS
+        while (m_Last != Impl::ArenaInvalidOffset && m_Last >= offset)
+        {
+            GX_ASSERTF(Impl::IsGuardValid(m_Memory, m_Last),
+                "Arena allocation overrun (address: {}, size: {})",
+                static_cast<void*>(m_Memory + m_Last + sizeof(Impl::ArenaGuardHeader)),
+                reinterpret_cast<const Impl::ArenaGuardHeader*>(m_Memory + m_Last)->Size);
+
+            m_Last = reinterpret_cast<const Impl::ArenaGuardHeader*>(m_Memory + m_Last)->Previous;
+        }
+
+        std::memset(m_Memory + offset, static_cast<int>(Impl::ArenaReleasedPattern), m_Offset - offset);
+#endif
+
+        m_Offset = offset;
+    }
+
+    bool LinearArena::Validate() const noexcept
+    {
+#if GX_ENABLE_MEMORY_GUARDS
+        for (size_t last = m_Last; last != Impl::ArenaInvalidOffset;)
+        {
+            if (!Impl::IsGuardValid(m_Memory, last))
+            {
+                return false;
+            }
+
+            last = reinterpret_cast<const Impl::ArenaGuardHeader*>(m_Memory + last)->Previous;
+        }
+#endif
+
+        return true;
+    }
+
+    void LinearArena::Destroy() noexcept
+    {
+        if (m_Memory != nullptr)
+        {
+            GX_ASSERT(Validate());
+
+            if (m_Owned)
+            {
+                Memory::Free(m_Memory);
+            }
+
+            m_Memory = nullptr;
+        }
+    }
+
+    FrameArena::FrameArena(
+        size_t frames,
+        size_t capacity,
+        MemoryPoolTag tag) noexcept
+        : m_Arenas{}
+        , m_Frames{ std::clamp<size_t>(frames, 1, MaxFrames) }
+        , m_Current{}
+    {
+        GX_ASSERT(frames >= 1 && frames <= MaxFrames);
+
+        for (size_t i = 0; i < m_Frames; ++i)
+        {
+            m_Arenas[i] = LinearArena{ capacity, tag };
+        }
+    }
+
+    FrameArena::~FrameArena() noexcept = default;
+
+    void FrameArena::BeginFrame() noexcept
+    {
+        m_Current = (m_Current + 1) % m_Frames;
+        m_Arenas[m_Current].Reset();
+    }
+}
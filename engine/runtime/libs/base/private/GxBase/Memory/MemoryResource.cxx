@@ -0,0 +1,71 @@
+#include <GxBase/Memory/MemoryResource.hxx>
+
+namespace Graphyte::Memory
+{
+    TaggedMemoryResource::TaggedMemoryResource(
+        MemoryPoolTag tag) noexcept
+        : m_Tag{ tag }
+    {
+    }
+
+    TaggedMemoryResource::~TaggedMemoryResource() noexcept = default;
+
+    void* TaggedMemoryResource::do_allocate(size_t size, size_t alignment) noexcept
+    {
+        void* const result = Memory::Allocate(m_Tag, size, std::max(alignment, DefaultAlignment));
+        GX_ABORT_UNLESS(result != nullptr, "Out of memory (tag: {}, size: {})", ToString(m_Tag), size);
+        return result;
+    }
+
+    void TaggedMemoryResource::do_deallocate(void* memory, [[maybe_unused]] size_t size, [[maybe_unused]] size_t alignment) noexcept
+    {
+        Memory::Free(memory);
+    }
+
+    bool TaggedMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        //
+        // Memory is freed regardless of tag, so all tagged resources are interchangeable.
+        //
+
+        return dynamic_cast<const TaggedMemoryResource*>(&other) != nullptr;
+    }
+
+    ArenaMemoryResource::ArenaMemoryResource(
+        LinearArena& arena,
+        std::pmr::memory_resource* upstream) noexcept
+        : m_Arena{ arena }
+        , m_Upstream{ upstream }
+        , m_Overflows{}
+    {
+    }
+
+    ArenaMemoryResource::~ArenaMemoryResource() noexcept = default;
+
+    void* ArenaMemoryResource::do_allocate(size_t size, size_t alignment) noexcept
+    {
+        if (void* const result = m_Arena.Allocate(size, alignment); result != nullptr)
+        {
+            return result;
+        }
+
+        GX_ABORT_UNLESS(m_Upstream != nullptr, "Arena exhausted (used: {}, capacity: {}, requested: {})", m_Arena.GetUsed(), m_Arena.GetCapacity(), size);
+
+        ++m_Overflows;
+        return m_Upstream->allocate(size, alignment);
+    }
+
+    void ArenaMemoryResource::do_deallocate(void* memory, size_t size, size_t alignment) noexcept
+    {
+        if (!m_Arena.Contains(memory))
+        {
+            GX_ASSERT(m_Upstream != nullptr);
+            m_Upstream->deallocate(memory, size, alignment);
+        }
+    }
+
+    bool ArenaMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+}
@@ -0,0 +1,161 @@
+#include <GxBase/Memory/MemoryTracker.hxx>
+
+GX_DEFINE_LOG_CATEGORY(LogMemory);
+
+namespace Graphyte::Memory::Impl
+{
+    //
+    // Counters of each tag live in separate cache line, so subsystems allocating concurrently do not
+    // contend on shared line.
+    //
+
+    struct alignas(GX_CACHELINE_SIZE) MemoryPoolCounters final
+    {
+        std::atomic<uint64_t> Allocated;
+        std::atomic<uint64_t> Peak;
+        std::atomic<uint64_t> Allocations;
+        std::atomic<uint64_t> TotalAllocations;
+    };
+
+    static MemoryPoolCounters g_MemoryPoolCounters[MemoryPoolTagCount]{};
+
+    static MemoryPoolCounters& GetCounters(MemoryPoolTag tag) noexcept
+    {
+        size_t const index = static_cast<size_t>(tag);
+        GX_ASSERT(index < MemoryPoolTagCount);
+        return g_MemoryPoolCounters[index];
+    }
+}
+
+namespace Graphyte::Memory
+{
+    constexpr std::string_view g_MemoryPoolTagNames[] = {
+        "General",
+        "Strings",
+        "Containers",
+        "Storage",
+        "Threading",
+        "Network",
+        "Diagnostics",
+        "Graphics",
+        "Rendering",
+        "Geometry",
+        "Audio",
+        "Physics",
+        "Assets",
+        "Scripting",
+    };
+
+    static_assert(std::size(g_MemoryPoolTagNames) == MemoryPoolTagCount);
+
+    BASE_API std::string_view ToString(MemoryPoolTag value) noexcept
+    {
+        size_t const index = static_cast<size_t>(value);
+
+        if (index < MemoryPoolTagCount)
+        {
+            return g_MemoryPoolTagNames[index];
+        }
+
+        return {};
+    }
+
+    void MemoryTracker::Track(
+        MemoryPoolTag tag,
+        size_t size) noexcept
+    {
+        Impl::MemoryPoolCounters& counters = Impl::GetCounters(tag);
+
+        uint64_t const allocated = counters.Allocated.fetch_add(size, std::memory_order_relaxed) + size;
+        counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t peak = counters.Peak.load(std::memory_order_relaxed);
+
+        while (allocated > peak && !counters.Peak.compare_exchange_weak(peak, allocated, std::memory_order_relaxed))
+        {
+            ;
+        }
+    }
+
+    void MemoryTracker::Untrack(
+        MemoryPoolTag tag,
+        size_t size) noexcept
+    {
+        Impl::MemoryPoolCounters& counters = Impl::GetCounters(tag);
+
+        [[maybe_unused]] uint64_t const allocated = counters.Allocated.fetch_sub(size, std::memory_order_relaxed);
+        GX_ASSERT(allocated >= size);
+
+        [[maybe_unused]] uint64_t const allocations = counters.Allocations.fetch_sub(1, std::memory_order_relaxed);
+        GX_ASSERT(allocations != 0);
+    }
+
+    uint64_t MemoryTracker::GetUsage(
+        MemoryPoolTag tag) noexcept
+    {
+        return Impl::GetCounters(tag).Allocated.load(std::memory_order_relaxed);
+    }
+
+    MemoryPoolUsage MemoryTracker::GetStatistics(
+        MemoryPoolTag tag) noexcept
+    {
+        Impl::MemoryPoolCounters const& counters = Impl::GetCounters(tag);
+
+        return MemoryPoolUsage{
+            .Allocated        = counters.Allocated.load(std::memory_order_relaxed),
+            .Peak             = counters.Peak.load(std::memory_order_relaxed),
+            .Allocations      = counters.Allocations.load(std::memory_order_relaxed),
+            .TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed),
+        };
+    }
+
+    void MemoryTracker::ResetPeak(
+        MemoryPoolTag tag) noexcept
+    {
+        Impl::MemoryPoolCounters& counters = Impl::GetCounters(tag);
+        counters.Peak.store(counters.Allocated.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::LogUsage() noexcept
+    {
+        GX_LOG_INFO(LogMemory, "{:<12} {:>16} {:>16} {:>12} {:>12}\n", "Tag", "Allocated", "Peak", "Live", "Total");
+
+        for (size_t index = 0; index < MemoryPoolTagCount; ++index)
+        {
+            MemoryPoolTag const tag     = static_cast<MemoryPoolTag>(index);
+            MemoryPoolUsage const usage = GetStatistics(tag);
+
+            GX_LOG_INFO(LogMemory, "{:<12} {:>16} {:>16} {:>12} {:>12}\n",
+                ToString(tag),
+                usage.Allocated,
+                usage.Peak,
+                usage.Allocations,
+                usage.TotalAllocations);
+        }
+    }
+
+    uint64_t MemoryTracker::ReportLeaks() noexcept
+    {
+        uint64_t leaked{};
+
+        for (size_t index = 0; index < MemoryPoolTagCount; ++index)
+        {
+            MemoryPoolTag const tag     = static_cast<MemoryPoolTag>(index);
+            MemoryPoolUsage const usage = GetStatistics(tag);
+
+            if (usage.Allocations != 0)
+            {
+                GX_LOG_ERROR(LogMemory, "Memory leak: {} bytes in {} allocations of `{}` (peak: {} bytes)\n",
+                    usage.Allocated,
+                    usage.Allocations,
+                    ToString(tag),
+                    usage.Peak);
+
+                leaked += usage.Allocated;
+            }
+        }
+
+        return leaked;
+    }
+}
@@ -0,0 +1,59 @@
+#include <GxBase/ObjectPool.hxx>
+
+namespace Graphyte::Impl
+{
+    static_assert(PoolThreadSlotCount == 64, "Slots are tracked in single 64-bit mask");
+
+    static std::atomic<uint64_t> g_PoolThreadSlots{};
+
+    class PoolThreadSlotOwner final
+    {
+    private:
+        size_t m_Slot;
+
+    public:
+        PoolThreadSlotOwner() noexcept
+            : m_Slot{ PoolThreadSlotInvalid }
+        {
+            uint64_t slots = g_PoolThreadSlots.load(std::memory_order_relaxed);
+
+            while (slots != ~uint64_t{})
+            {
+                size_t const slot = static_cast<size_t>(BitCountTrailingOnes(slots));
+
+                if (g_PoolThreadSlots.compare_exchange_weak(slots, slots | (uint64_t{ 1 } << slot), std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    m_Slot = slot;
+                    break;
+                }
+            }
+        }
+
+        ~PoolThreadSlotOwner() noexcept
+        {
+            //
+            // Caches of this slot keep their items; next owner of slot continues to use them.
+            //
+
+            if (m_Slot != PoolThreadSlotInvalid)
+            {
+                g_PoolThreadSlots.fetch_and(~(uint64_t{ 1 } << m_Slot), std::memory_order_release);
+            }
+        }
+
+        PoolThreadSlotOwner(const PoolThreadSlotOwner&) = delete;
+        PoolThreadSlotOwner& operator=(const PoolThreadSlotOwner&) = delete;
+
+    public:
+        size_t GetSlot() const noexcept
+        {
+            return m_Slot;
+        }
+    };
+
+    size_t GetPoolThreadSlot() noexcept
+    {
+        static thread_local PoolThreadSlotOwner owner{};
+        return owner.GetSlot();
+    }
+}
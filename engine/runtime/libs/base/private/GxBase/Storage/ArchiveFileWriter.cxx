@@ -2,25 +2,203 @@
 #include <GxBase/Storage/IStream.hxx>
 #include <GxBase/Diagnostics.hxx>
 #include <GxBase/Bitwise.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Threading/Thread.hxx>
+
+namespace Graphyte::Storage::Impl
+{
+    //
+    // Writes submitted buffers on background thread. Single buffer is in flight at time, so
+    // writer fills second one meanwhile.
+    //
+
+    class ArchiveWriteBehind final : public Threading::IRunnable
+    {
+    private:
+        IStream& m_Stream;
+        Threading::CriticalSection m_Lock;
+        Threading::ConditionVariable m_Submitted;
+        Threading::ConditionVariable m_Completed;
+        std::unique_ptr<std::byte[]> m_Buffer;
+        size_t m_Pending;
+        StreamSync m_Sync;
+        Status m_Status;
+        bool m_Running;
+        Threading::Thread m_Thread;
+
+    public:
+        ArchiveWriteBehind(
+            IStream& stream,
+            size_t buffer_size,
+            StreamSync sync) noexcept
+            : m_Stream{ stream }
+            , m_Lock{}
+            , m_Submitted{}
+            , m_Completed{}
+            , m_Buffer{ std::make_unique<std::byte[]>(buffer_size) }
+            , m_Pending{ 0 }
+            , m_Sync{ sync }
+            , m_Status{ Status::Success }
+            , m_Running{ true }
+            , m_Thread{}
+        {
+        }
+
+        virtual ~ArchiveWriteBehind() noexcept
+        {
+            {
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+                m_Running = false;
+                m_Submitted.NotifyAll();
+            }
+
+            m_Thread.Join();
+        }
+
+    public:
+        bool Start() noexcept
+        {
+            return m_Thread.Start(this, "Archive Writer");
+        }
+
+        /// @brief Exchanges filled buffer with buffer already written.
+        ///
+        /// @param buffer Provides filled buffer and returns buffer available for writing.
+        /// @param size   Provides number of bytes in buffer.
+        ///
+        /// @return The status of previous writes.
+        Status Submit(
+            std::unique_ptr<std::byte[]>& buffer,
+            size_t size) noexcept
+        {
+            GX_ASSERT(size != 0);
+
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            while (m_Pending != 0)
+            {
+                m_Completed.Wait(m_Lock);
+            }
+
+            std::swap(m_Buffer, buffer);
+            m_Pending = size;
+            m_Submitted.Notify();
+
+            return std::exchange(m_Status, Status::Success);
+        }
+
+        /// @brief Waits for submitted buffer to be written.
+        ///
+        /// @return The status of previous writes.
+        Status Wait() noexcept
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            while (m_Pending != 0)
+            {
+                m_Completed.Wait(m_Lock);
+            }
+
+            return std::exchange(m_Status, Status::Success);
+        }
+
+        uint32_t OnRun() noexcept override
+        {
+            for (;;)
+            {
+                size_t size{};
+
+                {
+                    Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+                    while (m_Running && m_Pending == 0)
+                    {
+                        m_Submitted.Wait(m_Lock);
+                    }
+
+                    if (m_Pending == 0)
+                    {
+                        break;
+                    }
+
+                    size = m_Pending;
+                }
+
+                size_t processed{};
+                Status status = m_Stream.Write({ m_Buffer.get(), size }, processed);
+
+                if (status == Status::Success)
+                {
+                    status = m_Stream.Sync(m_Sync);
+                }
+
+                {
+                    Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+                    if (status != Status::Success)
+                    {
+                        m_Status = status;
+                    }
+
+                    m_Pending = 0;
+                    m_Completed.NotifyAll();
+                }
+            }
+
+            return 0;
+        }
+    };
+}
 
 namespace Graphyte::Storage
 {
     ArchiveFileWriter::ArchiveFileWriter(
         std::unique_ptr<IStream> stream,
         int64_t position) noexcept
+        : ArchiveFileWriter{ std::move(stream), ArchiveFileWriterOptions{}, position }
+    {
+    }
+
+    ArchiveFileWriter::ArchiveFileWriter(
+        std::unique_ptr<IStream> stream,
+        const ArchiveFileWriterOptions& options,
+        int64_t position) noexcept
         : Archive()
         , m_Stream{ std::move(stream) }
-        , m_Position{ position }
-        , m_BufferCount{ 0 }
+        , m_WriteBehind{}
         , m_Buffer{}
+        , m_BufferSize{ std::max<size_t>(options.BufferSize, 4096) }
+        , m_BufferCount{ 0 }
+        , m_Position{ position }
+        , m_BufferSync{ options.BufferSync }
+        , m_FlushSync{ options.FlushSync }
     {
         GX_ASSERT(m_Stream != nullptr);
         m_IsSaving = true;
+
+        m_Buffer = std::make_unique<std::byte[]>(m_BufferSize);
+
+        if (options.WriteBehind)
+        {
+            m_WriteBehind = std::make_unique<Impl::ArchiveWriteBehind>(*m_Stream, m_BufferSize, m_BufferSync);
+
+            if (!m_WriteBehind->Start())
+            {
+                GX_LOG_WARN(LogStorage, "Cannot start write behind thread, writing synchronously\n");
+                m_WriteBehind.reset();
+            }
+        }
     }
 
     ArchiveFileWriter::~ArchiveFileWriter() noexcept
     {
         Flush();
+
+        //
+        // Stop background writes before stream is closed.
+        //
+
+        m_WriteBehind.reset();
     }
 
     void ArchiveFileWriter::Serialize(
@@ -29,39 +207,32 @@ namespace Graphyte::Storage
     {
         m_Position += size;
 
-        if (size > m_Buffer.size())
+        if (size >= m_BufferSize)
         {
-            Flush();
-            size_t processed{};
-
-            if (m_Stream->Write({ reinterpret_cast<std::byte*>(buffer), size }, processed) != Status::Success)
-            {
-                GX_LOG_ERROR(LogStorage, "Write failure: request = {}, processed = {}\n", size, processed);
-                m_Error = true;
-            }
+            WriteDirect({ static_cast<const std::byte*>(buffer), size });
         }
         else
         {
             size_t copied;
 
-            while (size > (copied = (m_Buffer.size() - m_BufferCount)))
+            while (size > (copied = (m_BufferSize - m_BufferCount)))
             {
-                std::memcpy(m_Buffer.data() + m_BufferCount, buffer, copied);
+                std::memcpy(m_Buffer.get() + m_BufferCount, buffer, copied);
                 m_BufferCount += copied;
 
-                GX_ASSERT(m_BufferCount <= m_Buffer.size());
+                GX_ASSERT(m_BufferCount <= m_BufferSize);
 
                 size -= copied;
                 buffer = AdvancePointer(buffer, static_cast<ptrdiff_t>(copied));
-                Flush();
+                SubmitBuffer();
             }
 
             if (size != 0)
             {
-                std::memcpy(m_Buffer.data() + m_BufferCount, buffer, size);
+                std::memcpy(m_Buffer.get() + m_BufferCount, buffer, size);
                 m_BufferCount += size;
 
-                GX_ASSERT(m_BufferCount <= m_Buffer.size());
+                GX_ASSERT(m_BufferCount <= m_BufferSize);
             }
         }
     }
@@ -73,14 +244,14 @@ namespace Graphyte::Storage
 
     int64_t ArchiveFileWriter::GetSize() noexcept
     {
-        Flush();
+        Drain();
         return m_Stream->GetSize();
     }
 
     void ArchiveFileWriter::SetPosition(
         int64_t value) noexcept
     {
-        Flush();
+        Drain();
         if (m_Stream->SetPosition(value) != Status::Success)
         {
             GX_LOG_ERROR(LogStorage, "Set position failed: position = {}\n", value);
@@ -92,25 +263,96 @@ namespace Graphyte::Storage
 
     void ArchiveFileWriter::Flush() noexcept
     {
-        if (m_BufferCount != 0)
+        Drain();
+
+        if (m_Stream != nullptr)
+        {
+            [[maybe_unused]] auto status = m_Stream->Sync(m_FlushSync);
+        }
+    }
+
+    void ArchiveFileWriter::SubmitBuffer() noexcept
+    {
+        if (m_BufferCount == 0)
         {
-            GX_ASSERT(0 < m_BufferCount);
-            GX_ASSERT(m_BufferCount <= m_Buffer.size());
+            return;
+        }
 
+        GX_ASSERT(m_BufferCount <= m_BufferSize);
+
+        if (m_WriteBehind != nullptr)
+        {
+            if (m_WriteBehind->Submit(m_Buffer, m_BufferCount) != Status::Success)
+            {
+                GX_LOG_ERROR(LogStorage, "Flush failure\n");
+                m_Error = true;
+            }
+        }
+        else
+        {
             size_t processed{};
 
-            if (m_Stream->Write({ &m_Buffer[0], m_BufferCount }, processed) != Status::Success)
+            if (m_Stream->Write({ m_Buffer.get(), m_BufferCount }, processed) != Status::Success)
             {
                 GX_LOG_ERROR(LogStorage, "Flush failure\n");
                 m_Error = true;
             }
+            else
+            {
+                [[maybe_unused]] auto status = m_Stream->Sync(m_BufferSync);
+            }
+        }
+
+        m_BufferCount = 0;
+    }
+
+    void ArchiveFileWriter::Drain() noexcept
+    {
+        SubmitBuffer();
 
-            m_BufferCount = 0;
+        if (m_WriteBehind != nullptr)
+        {
+            if (m_WriteBehind->Wait() != Status::Success)
+            {
+                GX_LOG_ERROR(LogStorage, "Flush failure\n");
+                m_Error = true;
+            }
         }
+    }
 
-        if (m_Stream != nullptr)
+    void ArchiveFileWriter::WriteDirect(
+        std::span<const std::byte> buffer) noexcept
+    {
+        if (m_WriteBehind != nullptr)
         {
-            [[maybe_unused]] auto status = m_Stream->Flush();
+            if (m_WriteBehind->Wait() != Status::Success)
+            {
+                GX_LOG_ERROR(LogStorage, "Flush failure\n");
+                m_Error = true;
+            }
         }
+
+        //
+        // Buffered data and caller data are written with single request.
+        //
+
+        std::array<std::span<const std::byte>, 2> const buffers{
+            std::span<const std::byte>{ m_Buffer.get(), m_BufferCount },
+            buffer,
+        };
+
+        size_t processed{};
+
+        if (m_Stream->WriteGather(buffers, processed) != Status::Success)
+        {
+            GX_LOG_ERROR(LogStorage, "Write failure: request = {}, processed = {}\n", m_BufferCount + buffer.size(), processed);
+            m_Error = true;
+        }
+        else
+        {
+            [[maybe_unused]] auto status = m_Stream->Sync(m_BufferSync);
+        }
+
+        m_BufferCount = 0;
     }
 }
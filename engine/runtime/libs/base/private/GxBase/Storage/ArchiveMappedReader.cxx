@@ -0,0 +1,94 @@
+#include <GxBase/Storage/ArchiveMappedReader.hxx>
+
+namespace Graphyte::Storage
+{
+    ArchiveMappedReader::ArchiveMappedReader(
+        std::unique_ptr<IMappedFile> file,
+        bool persistent) noexcept
+        : Archive{}
+        , m_File{ std::move(file) }
+        , m_View{}
+        , m_Position{ 0 }
+    {
+        GX_ASSERTF(m_File != nullptr, "Invalid mapped file provided");
+
+        m_IsLoading  = true;
+        m_Persistent = persistent;
+        m_View       = m_File->GetView();
+    }
+
+    ArchiveMappedReader::ArchiveMappedReader(
+        std::span<const std::byte> view,
+        bool persistent) noexcept
+        : Archive{}
+        , m_File{}
+        , m_View{ view }
+        , m_Position{ 0 }
+    {
+        m_IsLoading  = true;
+        m_Persistent = persistent;
+    }
+
+    ArchiveMappedReader::~ArchiveMappedReader() noexcept
+    {
+    }
+
+    void ArchiveMappedReader::Serialize(
+        void* buffer,
+        size_t size) noexcept
+    {
+        std::span<const std::byte> const source = ReadView(size);
+
+        if (!source.empty())
+        {
+            std::memcpy(buffer, source.data(), source.size());
+        }
+    }
+
+    int64_t ArchiveMappedReader::GetPosition() noexcept
+    {
+        return static_cast<int64_t>(m_Position);
+    }
+
+    int64_t ArchiveMappedReader::GetSize() noexcept
+    {
+        return static_cast<int64_t>(m_View.size());
+    }
+
+    void ArchiveMappedReader::SetPosition(
+        int64_t position) noexcept
+    {
+        //
+        // Position may come from loaded data. Seeking outside of view fails archive, so following
+        // reads return nothing.
+        //
+
+        if (position < 0 || position > GetSize())
+        {
+            m_Error    = true;
+            m_Position = m_View.size();
+            return;
+        }
+
+        m_Position = static_cast<size_t>(position);
+    }
+
+    std::span<const std::byte> ArchiveMappedReader::ReadView(
+        size_t size) noexcept
+    {
+        if (size == 0 || m_Error)
+        {
+            return {};
+        }
+
+        if (size > (m_View.size() - m_Position))
+        {
+            m_Error = true;
+            return {};
+        }
+
+        std::span<const std::byte> const result = m_View.subspan(m_Position, size);
+        m_Position += size;
+        return result;
+    }
+}
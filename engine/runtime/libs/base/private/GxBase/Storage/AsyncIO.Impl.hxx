@@ -0,0 +1,184 @@
+#pragma once
+#include <GxBase/Storage/AsyncIO.hxx>
+#include <GxBase/Threading/Sync.hxx>
+
+namespace Graphyte::Storage::Impl
+{
+    //
+    // Maximum number of read operations issued to device at once.
+    //
+
+    constexpr const size_t AsyncIOQueueDepth = 64;
+
+    //
+    // Limits of single coalesced read operation.
+    //
+
+    constexpr const size_t AsyncIOMaxCoalescedSize  = 1 << 20;
+    constexpr const size_t AsyncIOMaxCoalescedCount = 64;
+
+    //
+    // Number of pending requests scanned for adjacent ranges after all operation slots are used.
+    //
+
+    constexpr const size_t AsyncIOCoalesceScanLimit = 256;
+
+    //
+    // Number of threads used by thread pool backend.
+    //
+
+    constexpr const size_t AsyncIOThreadCount = 4;
+
+    constexpr const size_t AsyncIOPriorityCount = 3;
+
+    enum struct AsyncRequestPhase : uint32_t
+    {
+        Pending,
+        Issued,
+        Completed,
+    };
+
+    /// @brief Represents state of single read request.
+    ///
+    /// Request is task with single dependency resolved when read completes. Callback runs as task
+    /// body, so waiting for request waits for its callback too.
+    class AsyncRequestState final : public Threading::Impl::TaskState
+    {
+    public:
+        AsyncIOQueue& Queue;
+        AsyncFile* File;
+        int64_t Offset;
+        std::span<std::byte> Buffer;
+        AsyncReadCallback Callback;
+        AsyncIOPriority Priority;
+
+        /// Changes from pending to issued under queue lock. Completion is stored by backend thread
+        /// without lock, so value is atomic.
+        std::atomic<AsyncRequestPhase> Phase;
+
+        /// Valid after completion.
+        Status Result;
+        size_t Processed;
+
+    public:
+        AsyncRequestState(
+            Threading::TaskDispatcher& dispatcher,
+            AsyncIOQueue& queue,
+            const AsyncReadDesc& desc) noexcept
+            : TaskState{ dispatcher }
+            , Queue{ queue }
+            , File{ desc.File }
+            , Offset{ desc.Offset }
+            , Buffer{ desc.Buffer }
+            , Callback{ desc.Callback }
+            , Priority{ desc.Priority }
+            , Phase{ AsyncRequestPhase::Pending }
+            , Result{ Status::Failure }
+            , Processed{}
+        {
+        }
+
+        virtual ~AsyncRequestState() noexcept = default;
+
+    protected:
+        void Run() noexcept final override
+        {
+            if (Callback)
+            {
+                Callback(Result, Processed);
+            }
+        }
+    };
+
+    /// @brief Represents requests for adjacent ranges of file issued as single vectored read.
+    struct AsyncReadOperation final
+    {
+        AsyncFile* File{};
+        int64_t Offset{};
+        size_t Size{};
+
+        /// Requests ordered by offset.
+        std::vector<AsyncRequestState*> Requests{};
+    };
+
+    /// @brief Queue of pending requests shared by backends.
+    class AsyncIOQueue final
+    {
+    private:
+        Threading::CriticalSection m_Lock;
+        std::array<std::deque<AsyncRequestState*>, AsyncIOPriorityCount> m_Pending;
+        std::atomic<size_t> m_PendingCount;
+
+    public:
+        AsyncIOQueue() noexcept;
+        ~AsyncIOQueue() noexcept;
+
+    public:
+        void Enqueue(std::span<AsyncRequestState* const> requests) noexcept;
+
+        /// @brief Removes request from queue when it was not issued yet.
+        bool Cancel(AsyncRequestState* request) noexcept;
+
+        /// @brief Cancels all pending requests.
+        void CancelAll() noexcept;
+
+        [[nodiscard]] bool HasPending() const noexcept
+        {
+            return m_PendingCount.load(std::memory_order_acquire) != 0;
+        }
+
+        /// @brief Takes pending requests in priority order and groups them into operations.
+        ///
+        /// @param operations Provides free operation slots.
+        ///
+        /// @return The number of filled operation slots.
+        size_t Collect(std::span<AsyncReadOperation> operations) noexcept;
+
+        /// @brief Completes all requests of operation.
+        ///
+        /// @param operation Provides completed operation.
+        /// @param status    Provides status of read.
+        /// @param processed Provides number of bytes read.
+        static void Complete(AsyncReadOperation& operation, Status status, size_t processed) noexcept;
+
+        static void Complete(AsyncRequestState* request, Status status, size_t processed) noexcept;
+
+    private:
+        static bool TryMerge(AsyncReadOperation& operation, AsyncRequestState* request) noexcept;
+    };
+
+    /// @brief Executes issued operations. Backend starts threads on creation and stops them when
+    ///        destroyed, after all issued operations complete.
+    class AsyncIOBackend
+    {
+    public:
+        virtual ~AsyncIOBackend() noexcept = default;
+
+        [[nodiscard]] virtual std::string_view GetName() const noexcept = 0;
+
+        /// @brief Notifies backend about new pending requests.
+        virtual void Notify() noexcept = 0;
+    };
+
+    /// @brief Creates native backend. Returns nullptr when platform has none, or it's unavailable.
+    std::unique_ptr<AsyncIOBackend> CreateAsyncIONativeBackend(
+        AsyncIOQueue& queue) noexcept;
+
+    Status AsyncOpenNative(
+        uintptr_t& handle,
+        int64_t& size,
+        std::string_view path) noexcept;
+
+    void AsyncCloseNative(
+        uintptr_t handle) noexcept;
+
+    /// @brief Reads all buffers of operation with blocking call.
+    Status AsyncReadNative(
+        const AsyncReadOperation& operation,
+        size_t& processed) noexcept;
+
+    void AsyncReadAheadNative(
+        uintptr_t handle,
+        int64_t offset,
+        size_t size) noexcept;
+}
@@ -0,0 +1,628 @@
+#include <GxBase/Storage/AsyncIO.hxx>
+#include <GxBase/Threading/Thread.hxx>
+#include <GxBase/CommandLine.hxx>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Storage/Archive.hxx>
+
+#include "AsyncIO.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    AsyncIOQueue::AsyncIOQueue() noexcept
+        : m_Lock{}
+        , m_Pending{}
+        , m_PendingCount{}
+    {
+    }
+
+    AsyncIOQueue::~AsyncIOQueue() noexcept
+    {
+        GX_ASSERT(m_PendingCount.load() == 0);
+    }
+
+    void AsyncIOQueue::Enqueue(
+        std::span<AsyncRequestState* const> requests) noexcept
+    {
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        for (AsyncRequestState* const request : requests)
+        {
+            m_Pending[static_cast<size_t>(request->Priority)].push_back(request);
+        }
+
+        m_PendingCount.fetch_add(requests.size(), std::memory_order_release);
+    }
+
+    bool AsyncIOQueue::Cancel(
+        AsyncRequestState* request) noexcept
+    {
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            if (request->Phase.load(std::memory_order_relaxed) != AsyncRequestPhase::Pending)
+            {
+                return false;
+            }
+
+            auto& pending = m_Pending[static_cast<size_t>(request->Priority)];
+
+            auto const it = std::find(pending.begin(), pending.end(), request);
+
+            if (it == pending.end())
+            {
+                return false;
+            }
+
+            pending.erase(it);
+            m_PendingCount.fetch_sub(1, std::memory_order_release);
+
+            request->Phase.store(AsyncRequestPhase::Issued, std::memory_order_relaxed);
+        }
+
+        Complete(request, Status::Cancelled, 0);
+        return true;
+    }
+
+    void AsyncIOQueue::CancelAll() noexcept
+    {
+        std::vector<AsyncRequestState*> cancelled{};
+
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            for (auto& pending : m_Pending)
+            {
+                for (AsyncRequestState* const request : pending)
+                {
+                    request->Phase.store(AsyncRequestPhase::Issued, std::memory_order_relaxed);
+                    cancelled.push_back(request);
+                }
+
+                pending.clear();
+            }
+
+            m_PendingCount.store(0, std::memory_order_release);
+        }
+
+        for (AsyncRequestState* const request : cancelled)
+        {
+            Complete(request, Status::Cancelled, 0);
+        }
+    }
+
+    bool AsyncIOQueue::TryMerge(
+        AsyncReadOperation& operation,
+        AsyncRequestState* request) noexcept
+    {
+        size_t const size = request->Buffer.size();
+
+        if (operation.File != request->File
+            || operation.Requests.size() >= AsyncIOMaxCoalescedCount
+            || (operation.Size + size) > AsyncIOMaxCoalescedSize)
+        {
+            return false;
+        }
+
+        if ((operation.Offset + static_cast<int64_t>(operation.Size)) == request->Offset)
+        {
+            operation.Requests.push_back(request);
+            operation.Size += size;
+            return true;
+        }
+
+        if ((request->Offset + static_cast<int64_t>(size)) == operation.Offset)
+        {
+            operation.Requests.insert(operation.Requests.begin(), request);
+            operation.Offset = request->Offset;
+            operation.Size += size;
+            return true;
+        }
+
+        return false;
+    }
+
+    size_t AsyncIOQueue::Collect(
+        std::span<AsyncReadOperation> operations) noexcept
+    {
+        size_t count = 0;
+
+        if (operations.empty())
+        {
+            return count;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        size_t taken = 0;
+
+        auto take = [&](AsyncRequestState* request) {
+            request->Phase.store(AsyncRequestPhase::Issued, std::memory_order_relaxed);
+            ++taken;
+        };
+
+        auto merge = [&](AsyncRequestState* request) {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (TryMerge(operations[i], request))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+        //
+        // Take requests from highest priority first. Each request either extends one of collected
+        // operations or starts new one.
+        //
+
+        for (size_t priority = AsyncIOPriorityCount; priority-- > 0;)
+        {
+            auto& pending = m_Pending[priority];
+
+            while (!pending.empty() && count < operations.size())
+            {
+                AsyncRequestState* const request = pending.front();
+                pending.pop_front();
+                take(request);
+
+                if (!merge(request))
+                {
+                    AsyncReadOperation& operation = operations[count++];
+                    operation.File                = request->File;
+                    operation.Offset              = request->Offset;
+                    operation.Size                = request->Buffer.size();
+                    operation.Requests.clear();
+                    operation.Requests.push_back(request);
+                }
+            }
+
+            if (count == operations.size())
+            {
+                //
+                // All slots are used. Look further in same queue for requests adjacent to collected
+                // ones, so streaming of large file issues large reads.
+                //
+
+                size_t scanned = 0;
+
+                for (auto it = pending.begin(); it != pending.end() && scanned < AsyncIOCoalesceScanLimit; ++scanned)
+                {
+                    if (merge(*it))
+                    {
+                        take(*it);
+                        it = pending.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                break;
+            }
+        }
+
+        m_PendingCount.fetch_sub(taken, std::memory_order_release);
+
+        return count;
+    }
+
+    void AsyncIOQueue::Complete(
+        AsyncRequestState* request,
+        Status status,
+        size_t processed) noexcept
+    {
+        request->Result    = status;
+        request->Processed = processed;
+        request->Phase.store(AsyncRequestPhase::Completed, std::memory_order_release);
+
+        //
+        // Dispatches callback task.
+        //
+
+        request->ResolveDependency();
+    }
+
+    void AsyncIOQueue::Complete(
+        AsyncReadOperation& operation,
+        Status status,
+        size_t processed) noexcept
+    {
+        bool const failed = (status != Status::Success) && (status != Status::EndOfStream);
+
+        for (AsyncRequestState* const request : operation.Requests)
+        {
+            size_t const size  = request->Buffer.size();
+            size_t const count = std::min(size, processed);
+            processed -= count;
+
+            if (failed)
+            {
+                Complete(request, status, count);
+            }
+            else
+            {
+                Complete(request, (count == size) ? Status::Success : Status::EndOfStream, count);
+            }
+        }
+
+        operation.Requests.clear();
+    }
+}
+
+namespace Graphyte::Storage::Impl
+{
+    class AsyncIOThreadPoolBackend final : public AsyncIOBackend
+    {
+    private:
+        class Worker final : public Threading::IRunnable
+        {
+        private:
+            AsyncIOThreadPoolBackend& m_Backend;
+
+        public:
+            Threading::Thread Thread{};
+
+        public:
+            explicit Worker(AsyncIOThreadPoolBackend& backend) noexcept
+                : m_Backend{ backend }
+            {
+            }
+
+            uint32_t OnRun() noexcept override
+            {
+                m_Backend.Run();
+                return 0;
+            }
+        };
+
+    private:
+        AsyncIOQueue& m_Queue;
+        Threading::CriticalSection m_Lock;
+        Threading::ConditionVariable m_Wakeup;
+        bool m_Running;
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+
+    public:
+        AsyncIOThreadPoolBackend(
+            AsyncIOQueue& queue,
+            size_t threads) noexcept
+            : m_Queue{ queue }
+            , m_Lock{}
+            , m_Wakeup{}
+            , m_Running{ true }
+            , m_Workers{}
+        {
+            for (size_t i = 0; i < threads; ++i)
+            {
+                auto& worker = m_Workers.emplace_back(std::make_unique<Worker>(*this));
+                worker->Thread.Start(worker.get(), "Async IO");
+            }
+        }
+
+        virtual ~AsyncIOThreadPoolBackend() noexcept
+        {
+            {
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+                m_Running = false;
+                m_Wakeup.NotifyAll();
+            }
+
+            for (auto& worker : m_Workers)
+            {
+                worker->Thread.Join();
+            }
+        }
+
+    public:
+        std::string_view GetName() const noexcept override
+        {
+            return "ThreadPool";
+        }
+
+        void Notify() noexcept override
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+            m_Wakeup.Notify();
+        }
+
+    private:
+        void Run() noexcept
+        {
+            AsyncReadOperation operation{};
+
+            for (;;)
+            {
+                {
+                    Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+                    while (m_Running && !m_Queue.HasPending())
+                    {
+                        m_Wakeup.Wait(m_Lock);
+                    }
+
+                    if (!m_Running)
+                    {
+                        break;
+                    }
+                }
+
+                if (m_Queue.Collect({ &operation, 1 }) == 0)
+                {
+                    continue;
+                }
+
+                if (m_Queue.HasPending())
+                {
+                    //
+                    // Wake up another worker for remaining requests.
+                    //
+
+                    Notify();
+                }
+
+                size_t processed{};
+                Status const status = AsyncReadNative(operation, processed);
+                AsyncIOQueue::Complete(operation, status, processed);
+            }
+        }
+    };
+}
+
+namespace Graphyte::Storage
+{
+    AsyncFile::AsyncFile(
+        uintptr_t handle,
+        int64_t size) noexcept
+        : m_Handle{ handle }
+        , m_Size{ size }
+    {
+    }
+
+    AsyncFile::~AsyncFile() noexcept
+    {
+        Impl::AsyncCloseNative(m_Handle);
+    }
+}
+
+namespace Graphyte::Storage
+{
+    AsyncRequest::AsyncRequest() noexcept
+        : m_State{}
+    {
+    }
+
+    AsyncRequest::AsyncRequest(
+        Impl::AsyncRequestState* state) noexcept
+        : m_State{ state }
+    {
+        if (m_State != nullptr)
+        {
+            m_State->AddReference();
+        }
+    }
+
+    AsyncRequest::AsyncRequest(
+        const AsyncRequest& other) noexcept
+        : AsyncRequest{ other.m_State }
+    {
+    }
+
+    AsyncRequest::AsyncRequest(
+        AsyncRequest&& other) noexcept
+        : m_State{ std::exchange(other.m_State, nullptr) }
+    {
+    }
+
+    AsyncRequest& AsyncRequest::operator=(
+        const AsyncRequest& other) noexcept
+    {
+        AsyncRequest{ other }.Swap(*this);
+        return *this;
+    }
+
+    AsyncRequest& AsyncRequest::operator=(
+        AsyncRequest&& other) noexcept
+    {
+        AsyncRequest{ std::move(other) }.Swap(*this);
+        return *this;
+    }
+
+    AsyncRequest::~AsyncRequest() noexcept
+    {
+        if (m_State != nullptr)
+        {
+            m_State->ReleaseReference();
+        }
+    }
+
+    bool AsyncRequest::IsCompleted() const noexcept
+    {
+        GX_ASSERT(m_State != nullptr);
+        return m_State->IsCompleted();
+    }
+
+    Status AsyncRequest::GetStatus() const noexcept
+    {
+        GX_ASSERT(m_State != nullptr);
+        GX_ASSERT(m_State->IsCompleted());
+        return m_State->Result;
+    }
+
+    size_t AsyncRequest::GetProcessed() const noexcept
+    {
+        GX_ASSERT(m_State != nullptr);
+        GX_ASSERT(m_State->IsCompleted());
+        return m_State->Processed;
+    }
+
+    void AsyncRequest::Wait() const noexcept
+    {
+        GX_ASSERT(m_State != nullptr);
+        m_State->GetDispatcher().Wait(Threading::TaskHandle{ m_State });
+    }
+
+    bool AsyncRequest::Cancel() const noexcept
+    {
+        GX_ASSERT(m_State != nullptr);
+        return m_State->Queue.Cancel(m_State);
+    }
+
+    Threading::TaskHandle AsyncRequest::GetTask() const noexcept
+    {
+        return Threading::TaskHandle{ m_State };
+    }
+}
+
+namespace Graphyte::Storage
+{
+    AsyncIO::AsyncIO() noexcept
+        : m_Queue{ std::make_unique<Impl::AsyncIOQueue>() }
+        , m_Backend{}
+        , m_Dispatcher{}
+    {
+    }
+
+    AsyncIO::~AsyncIO() noexcept
+    {
+        Stop();
+    }
+
+    AsyncIO& AsyncIO::GetInstance() noexcept
+    {
+        static AsyncIO instance{};
+        return instance;
+    }
+
+    void AsyncIO::Initialize() noexcept
+    {
+        AsyncIOBackendType type = AsyncIOBackendType::Native;
+
+        if (auto const value = CommandLine::Get("--async-io"); value.has_value() && value.value() == "threads")
+        {
+            type = AsyncIOBackendType::ThreadPool;
+        }
+
+        AsyncIO::GetInstance().Start(Threading::TaskDispatcher::GetInstance(), type);
+    }
+
+    void AsyncIO::Finalize() noexcept
+    {
+        AsyncIO::GetInstance().Stop();
+    }
+
+    void AsyncIO::Start(
+        Threading::TaskDispatcher& dispatcher,
+        AsyncIOBackendType type) noexcept
+    {
+        Stop();
+
+        m_Dispatcher = &dispatcher;
+
+        if (type == AsyncIOBackendType::Native)
+        {
+            m_Backend = Impl::CreateAsyncIONativeBackend(*m_Queue);
+        }
+
+        if (m_Backend == nullptr)
+        {
+            m_Backend = std::make_unique<Impl::AsyncIOThreadPoolBackend>(*m_Queue, Impl::AsyncIOThreadCount);
+        }
+
+        GX_LOG_INFO(LogStorage, "Async IO backend: {}\n", m_Backend->GetName());
+    }
+
+    void AsyncIO::Stop() noexcept
+    {
+        //
+        // Backend completes issued operations before it stops.
+        //
+
+        m_Backend = nullptr;
+        m_Queue->CancelAll();
+    }
+
+    std::string_view AsyncIO::GetBackendName() const noexcept
+    {
+        return (m_Backend != nullptr) ? m_Backend->GetName() : std::string_view{};
+    }
+
+    Status AsyncIO::Open(
+        std::unique_ptr<AsyncFile>& result,
+        std::string_view path) noexcept
+    {
+        result = nullptr;
+
+        uintptr_t handle{};
+        int64_t size{};
+
+        if (Status const status = Impl::AsyncOpenNative(handle, size, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        result = std::make_unique<AsyncFile>(handle, size);
+        return Status::Success;
+    }
+
+    AsyncRequest AsyncIO::Read(
+        const AsyncReadDesc& desc) noexcept
+    {
+        AsyncRequest result{};
+        Read({ &result, 1 }, { &desc, 1 });
+        return result;
+    }
+
+    void AsyncIO::Read(
+        std::span<AsyncRequest> results,
+        std::span<const AsyncReadDesc> descs) noexcept
+    {
+        GX_ASSERT(results.size() == descs.size());
+        GX_ASSERT(m_Dispatcher != nullptr);
+
+        std::vector<Impl::AsyncRequestState*> pending{};
+        pending.reserve(descs.size());
+
+        for (size_t i = 0; i < descs.size(); ++i)
+        {
+            AsyncReadDesc const& desc = descs[i];
+            GX_ASSERT(desc.File != nullptr);
+
+            auto* const state = Threading::BaseTask::Create<Impl::AsyncRequestState>(*m_Dispatcher, *m_Queue, desc);
+            results[i]        = AsyncRequest{ state };
+
+            if (m_Backend == nullptr)
+            {
+                Impl::AsyncIOQueue::Complete(state, Status::NotInitialized, 0);
+            }
+            else if (desc.Buffer.empty())
+            {
+                Impl::AsyncIOQueue::Complete(state, Status::Success, 0);
+            }
+            else
+            {
+                pending.push_back(state);
+            }
+        }
+
+        if (!pending.empty())
+        {
+            //
+            // Whole batch is enqueued at once, so backend may coalesce and submit it together.
+            //
+
+            m_Queue->Enqueue(pending);
+            m_Backend->Notify();
+        }
+    }
+
+    void AsyncIO::ReadAhead(
+        const AsyncFile& file,
+        int64_t offset,
+        size_t size) noexcept
+    {
+        Impl::AsyncReadAheadNative(file.GetHandle(), offset, size);
+    }
+}
@@ -5,6 +5,8 @@
 #include <GxBase/Storage/Path.hxx>
 #include <GxBase/Storage/ArchiveFileReader.hxx>
 #include <GxBase/Storage/ArchiveFileWriter.hxx>
+#include <GxBase/Storage/ArchiveMappedReader.hxx>
+#include <GxBase/Storage/VirtualFileSystem.hxx>
 
 namespace Graphyte::Storage
 {
@@ -181,6 +183,23 @@ namespace Graphyte::Storage
         return result;
     }
 
+    VirtualFileSystem& GetContentFileSystem() noexcept
+    {
+        static VirtualFileSystem s_Instance{};
+
+        [[maybe_unused]] static bool const s_Mounted = []() {
+            IFileSystem& native = IFileSystem::GetPlatformNative();
+
+            MountId engine{};
+            MountId project{};
+
+            return s_Instance.Mount(engine, {}, native, GetEngineContentDirectory(), 0, false) == Status::Success
+                   && s_Instance.Mount(project, {}, native, GetProjectContentDirectory(), 100, true) == Status::Success;
+        }();
+
+        return s_Instance;
+    }
+
     Status OpenRead(
         std::unique_ptr<IStream>& result,
         std::string_view path,
@@ -205,6 +224,17 @@ namespace Graphyte::Storage
             share);
     }
 
+    Status OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        MappedFileAccess access) noexcept
+    {
+        return IFileSystem::GetPlatformNative().OpenMapped(
+            result,
+            path,
+            access);
+    }
+
     Status CreateReader(
         std::unique_ptr<Archive>& archive,
         std::string_view path,
@@ -226,9 +256,40 @@ namespace Graphyte::Storage
         return status;
     }
 
+    Status CreateMappedReader(
+        std::unique_ptr<Archive>& archive,
+        std::string_view path,
+        MappedFileAccess access) noexcept
+    {
+        std::unique_ptr<IMappedFile> handle{};
+
+        auto const status = IFileSystem::GetPlatformNative().OpenMapped(
+            handle,
+            path,
+            access);
+
+        if (status == Status::Success && handle != nullptr)
+        {
+            archive = std::make_unique<ArchiveMappedReader>(std::move(handle));
+            return Status::Success;
+        }
+
+        return status;
+    }
+
+    Status CreateWriter(
+        std::unique_ptr<Archive>& archive,
+        std::string_view path,
+        bool append,
+        bool share) noexcept
+    {
+        return CreateWriter(archive, path, ArchiveFileWriterOptions{}, append, share);
+    }
+
     Status CreateWriter(
         std::unique_ptr<Archive>& archive,
         std::string_view path,
+        const ArchiveFileWriterOptions& options,
         bool append,
         bool share) noexcept
     {
@@ -242,7 +303,7 @@ namespace Graphyte::Storage
 
         if (status == Status::Success && handle != nullptr)
         {
-            archive = std::make_unique<ArchiveFileWriter>(std::move(handle));
+            archive = std::make_unique<ArchiveFileWriter>(std::move(handle), options);
             return Status::Success;
         }
 
@@ -0,0 +1,33 @@
+#pragma once
+#include <GxBase/Storage/FileWatcher.hxx>
+
+namespace Graphyte::Storage::Impl
+{
+    //
+    // Interval between scans of polling backend, in milliseconds.
+    //
+
+    constexpr const uint32_t FileWatcherPollingInterval = 100;
+
+    class FileWatcherBackend
+    {
+    public:
+        virtual ~FileWatcherBackend() noexcept = default;
+
+        [[nodiscard]] virtual std::string_view GetName() const noexcept = 0;
+
+        virtual Status Add(
+            std::string_view path,
+            bool recursive) noexcept = 0;
+
+        /// @brief Waits for changes. Changes are appended to result and may repeat same file.
+        virtual Status Wait(
+            std::vector<FileChange>& changes,
+            uint32_t timeout) noexcept = 0;
+
+        virtual void Cancel() noexcept = 0;
+    };
+
+    /// @brief Creates native backend. Returns nullptr when platform has none, or it's unavailable.
+    std::unique_ptr<FileWatcherBackend> CreateFileWatcherNativeBackend() noexcept;
+}
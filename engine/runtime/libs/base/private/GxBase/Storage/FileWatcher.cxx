@@ -0,0 +1,297 @@
+#include <GxBase/Storage/FileWatcher.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/System.hxx>
+#include "FileWatcher.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    //
+    // Detects changes by comparing snapshots of watched directories.
+    //
+
+    class FileWatcherPollingBackend final : public FileWatcherBackend
+    {
+    private:
+        struct Directory final
+        {
+            std::string Path;
+            bool Recursive;
+        };
+
+        struct FileState final
+        {
+            int64_t ModificationTime;
+            int64_t Size;
+        };
+
+        using Snapshot = std::unordered_map<std::string, FileState>;
+
+        class SnapshotVisitor final : public IDirectoryInfoVisitor
+        {
+        public:
+            Snapshot& Files;
+
+        public:
+            explicit SnapshotVisitor(Snapshot& files) noexcept
+                : Files{ files }
+            {
+            }
+
+            virtual Status Visit(
+                std::string_view path,
+                const FileInfo& info) noexcept override
+            {
+                if (!info.IsDirectory)
+                {
+                    Files.insert_or_assign(std::string{ path }, FileState{ info.ModificationTime.Value, info.FileSize });
+                }
+
+                return Status::Success;
+            }
+        };
+
+    private:
+        Threading::CriticalSection m_Lock;
+        Threading::ConditionVariable m_Wakeup;
+        bool m_Cancelled;
+        std::vector<Directory> m_Directories;
+        Snapshot m_Files;
+
+    public:
+        FileWatcherPollingBackend() noexcept
+            : m_Lock{}
+            , m_Wakeup{}
+            , m_Cancelled{}
+            , m_Directories{}
+            , m_Files{}
+        {
+        }
+
+        virtual ~FileWatcherPollingBackend() noexcept = default;
+
+    public:
+        std::string_view GetName() const noexcept override
+        {
+            return "Polling";
+        }
+
+        Status Add(
+            std::string_view path,
+            bool recursive) noexcept override
+        {
+            auto const it = std::find_if(m_Directories.begin(), m_Directories.end(), [&](Directory const& directory) {
+                return directory.Path == path && directory.Recursive == recursive;
+            });
+
+            if (it != m_Directories.end())
+            {
+                return Status::Success;
+            }
+
+            Directory const& directory = m_Directories.emplace_back(Directory{ std::string{ path }, recursive });
+
+            //
+            // Files present when directory is added are not reported.
+            //
+
+            return Scan(m_Files, directory);
+        }
+
+        Status Wait(
+            std::vector<FileChange>& changes,
+            uint32_t timeout) noexcept override
+        {
+            uint64_t const resolution = System::GetTimestampResolution();
+            uint64_t const started    = System::GetTimestamp();
+
+            for (;;)
+            {
+                Snapshot current{};
+                current.reserve(m_Files.size());
+
+                for (Directory const& directory : m_Directories)
+                {
+                    //
+                    // Directory may be removed while watched, its files are reported as removed.
+                    //
+
+                    [[maybe_unused]] Status const status = Scan(current, directory);
+                }
+
+                size_t const count = changes.size();
+
+                for (auto const& [path, state] : current)
+                {
+                    if (auto const it = m_Files.find(path); it == m_Files.end())
+                    {
+                        changes.push_back(FileChange{ path, FileChangeType::Added });
+                    }
+                    else if (it->second.ModificationTime != state.ModificationTime || it->second.Size != state.Size)
+                    {
+                        changes.push_back(FileChange{ path, FileChangeType::Modified });
+                    }
+                }
+
+                for (auto const& [path, state] : m_Files)
+                {
+                    if (!current.contains(path))
+                    {
+                        changes.push_back(FileChange{ path, FileChangeType::Removed });
+                    }
+                }
+
+                m_Files = std::move(current);
+
+                if (changes.size() != count)
+                {
+                    return Status::Success;
+                }
+
+                uint64_t const elapsed = ((System::GetTimestamp() - started) * 1000) / resolution;
+
+                if (timeout != UINT32_MAX && elapsed >= timeout)
+                {
+                    return Status::Timeout;
+                }
+
+                uint32_t const interval = (timeout == UINT32_MAX)
+                                              ? FileWatcherPollingInterval
+                                              : std::min<uint32_t>(FileWatcherPollingInterval, static_cast<uint32_t>(timeout - elapsed));
+
+                Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+                if (!m_Cancelled)
+                {
+                    (void)m_Wakeup.Wait(m_Lock, interval);
+                }
+
+                if (std::exchange(m_Cancelled, false))
+                {
+                    return Status::Cancelled;
+                }
+            }
+        }
+
+        void Cancel() noexcept override
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+            m_Cancelled = true;
+            m_Wakeup.NotifyAll();
+        }
+
+    private:
+        static Status Scan(
+            Snapshot& files,
+            Directory const& directory) noexcept
+        {
+            SnapshotVisitor visitor{ files };
+
+            IFileSystem& fs = IFileSystem::GetPlatformNative();
+
+            return directory.Recursive
+                       ? fs.EnumerateRecursive(directory.Path, visitor)
+                       : fs.Enumerate(directory.Path, visitor);
+        }
+    };
+}
+
+namespace Graphyte::Storage
+{
+    FileWatcher::FileWatcher(
+        FileWatcherBackendType type) noexcept
+        : m_Backend{}
+    {
+        if (type == FileWatcherBackendType::Native)
+        {
+            m_Backend = Impl::CreateFileWatcherNativeBackend();
+        }
+
+        if (m_Backend == nullptr)
+        {
+            m_Backend = std::make_unique<Impl::FileWatcherPollingBackend>();
+        }
+    }
+
+    FileWatcher::~FileWatcher() noexcept = default;
+
+    std::string_view FileWatcher::GetBackendName() const noexcept
+    {
+        return m_Backend->GetName();
+    }
+
+    Status FileWatcher::Add(
+        std::string_view path,
+        bool recursive) noexcept
+    {
+        std::string normalized = NormalizedPath(path);
+        RemoveDirectorySeparator(normalized);
+
+        return m_Backend->Add(normalized, recursive);
+    }
+
+    Status FileWatcher::Wait(
+        std::vector<FileChange>& changes,
+        uint32_t timeout) noexcept
+    {
+        changes.clear();
+
+        Status const status = m_Backend->Wait(changes, timeout);
+
+        if (status != Status::Success)
+        {
+            changes.clear();
+            return status;
+        }
+
+        //
+        // Coalesce changes of same file. File added and modified is reported as added, file
+        // removed and added again as modified.
+        //
+
+        std::unordered_map<std::string_view, size_t> index{};
+        std::vector<FileChange> result{};
+        result.reserve(changes.size());
+
+        for (FileChange& change : changes)
+        {
+            auto const it = index.find(change.Path);
+
+            if (it == index.end())
+            {
+                //
+                // Result does not reallocate, so keys may refer to its paths.
+                //
+
+                result.push_back(std::move(change));
+                index.emplace(result.back().Path, result.size() - 1);
+                continue;
+            }
+
+            FileChange& previous = result[it->second];
+
+            if (previous.Type == FileChangeType::Added && change.Type == FileChangeType::Modified)
+            {
+                continue;
+            }
+
+            if (previous.Type == FileChangeType::Removed && change.Type == FileChangeType::Added)
+            {
+                previous.Type = FileChangeType::Modified;
+                continue;
+            }
+
+            previous.Type = change.Type;
+        }
+
+        changes = std::move(result);
+        return Status::Success;
+    }
+
+    void FileWatcher::Cancel() noexcept
+    {
+        m_Backend->Cancel();
+    }
+}
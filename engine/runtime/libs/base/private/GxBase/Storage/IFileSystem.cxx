@@ -79,6 +79,67 @@ namespace Graphyte::Storage
         return Status::Success;
     }
 
+    Status IFileSystem::OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        [[maybe_unused]] MappedFileAccess access) noexcept
+    {
+        class BufferedMappedFile final : public IMappedFile
+        {
+        private:
+            std::unique_ptr<std::byte[]> m_Buffer;
+            size_t m_Size;
+
+        public:
+            BufferedMappedFile(
+                std::unique_ptr<std::byte[]> buffer,
+                size_t size) noexcept
+                : m_Buffer{ std::move(buffer) }
+                , m_Size{ size }
+            {
+            }
+
+            virtual std::span<const std::byte> GetView() noexcept override
+            {
+                return { m_Buffer.get(), m_Size };
+            }
+
+            virtual void Prefetch(
+                [[maybe_unused]] size_t offset,
+                [[maybe_unused]] size_t size) noexcept override
+            {
+            }
+        };
+
+        result = nullptr;
+
+        std::unique_ptr<IStream> stream{};
+
+        if (Status const status = OpenRead(stream, path, false); status != Status::Success)
+        {
+            return status;
+        }
+
+        int64_t const size = stream->GetSize();
+
+        if (size < 0)
+        {
+            return Status::ReadFault;
+        }
+
+        auto buffer = std::make_unique<std::byte[]>(static_cast<size_t>(size));
+
+        size_t processed{};
+
+        if (Status const status = stream->Read({ buffer.get(), static_cast<size_t>(size) }, processed); status != Status::Success && size != 0)
+        {
+            return status;
+        }
+
+        result = std::make_unique<BufferedMappedFile>(std::move(buffer), static_cast<size_t>(size));
+        return Status::Success;
+    }
+
     Status IFileSystem::EnumerateRecursive(
         std::string_view path,
         IDirectoryVisitor& visitor) noexcept
@@ -0,0 +1,613 @@
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Threading.hxx>
+#include <GxBase/Threading/Thread.hxx>
+#include <GxBase/Storage/Archive.hxx>
+#include "../AsyncIO.Impl.hxx"
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+
+namespace Graphyte::Storage::Impl
+{
+    static Status AsyncStatusFromErrno(int error) noexcept
+    {
+        switch (error)
+        {
+            case ENOENT:
+                return Status::NotFound;
+
+            case EACCES:
+            case EPERM:
+                return Status::AccessDenied;
+
+            case EISDIR:
+                return Status::InvalidFile;
+
+            default:
+                return Status::Failure;
+        }
+    }
+
+    using AsyncReadVectors = std::array<iovec, AsyncIOMaxCoalescedCount>;
+
+    static size_t AsyncBuildVectors(
+        AsyncReadVectors& vectors,
+        const AsyncReadOperation& operation) noexcept
+    {
+        GX_ASSERT(operation.Requests.size() <= vectors.size());
+
+        size_t count = 0;
+
+        for (AsyncRequestState const* const request : operation.Requests)
+        {
+            vectors[count++] = iovec{
+                .iov_base = request->Buffer.data(),
+                .iov_len  = request->Buffer.size(),
+            };
+        }
+
+        return count;
+    }
+
+    //
+    // Skips fully read vectors and trims partially read one. Returns index of first vector with
+    // data remaining.
+    //
+
+    static size_t AsyncAdvanceVectors(
+        std::span<iovec> vectors,
+        size_t processed) noexcept
+    {
+        size_t index = 0;
+
+        while (index < vectors.size() && processed >= vectors[index].iov_len)
+        {
+            processed -= vectors[index].iov_len;
+            ++index;
+        }
+
+        if (index < vectors.size())
+        {
+            vectors[index].iov_base = static_cast<std::byte*>(vectors[index].iov_base) + processed;
+            vectors[index].iov_len -= processed;
+        }
+
+        return index;
+    }
+
+    Status AsyncOpenNative(
+        uintptr_t& handle,
+        int64_t& size,
+        std::string_view path) noexcept
+    {
+        int const fd = open(std::string{ path }.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd == -1)
+        {
+            return AsyncStatusFromErrno(errno);
+        }
+
+        // clang-format off
+        struct stat fileinfo{};
+        // clang-format on
+
+        if (fstat(fd, &fileinfo) != 0)
+        {
+            Status const status = AsyncStatusFromErrno(errno);
+            close(fd);
+            return status;
+        }
+
+        handle = static_cast<uintptr_t>(fd);
+        size   = static_cast<int64_t>(fileinfo.st_size);
+        return Status::Success;
+    }
+
+    void AsyncCloseNative(
+        uintptr_t handle) noexcept
+    {
+        close(static_cast<int>(handle));
+    }
+
+    Status AsyncReadNative(
+        const AsyncReadOperation& operation,
+        size_t& processed) noexcept
+    {
+        AsyncReadVectors vectors;
+        size_t const count = AsyncBuildVectors(vectors, operation);
+
+        int const fd = static_cast<int>(operation.File->GetHandle());
+
+        processed = 0;
+
+        size_t first = 0;
+
+        while (processed < operation.Size)
+        {
+            ssize_t const result = preadv(
+                fd,
+                &vectors[first],
+                static_cast<int>(count - first),
+                operation.Offset + static_cast<int64_t>(processed));
+
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return Status::ReadFault;
+            }
+
+            if (result == 0)
+            {
+                return Status::EndOfStream;
+            }
+
+            processed += static_cast<size_t>(result);
+            first += AsyncAdvanceVectors({ &vectors[first], count - first }, static_cast<size_t>(result));
+        }
+
+        return Status::Success;
+    }
+
+    void AsyncReadAheadNative(
+        uintptr_t handle,
+        int64_t offset,
+        size_t size) noexcept
+    {
+        posix_fadvise(static_cast<int>(handle), offset, static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+    }
+}
+
+namespace Graphyte::Storage::Impl
+{
+    //
+    // io_uring backend. Single thread submits vectored reads and reaps their completions. Thread
+    // sleeps in io_uring_enter; new requests wake it up through read of eventfd kept in flight.
+    //
+
+    constexpr const uint64_t AsyncUringEventUserData = std::numeric_limits<uint64_t>::max();
+
+    class LinuxUringAsyncIOBackend final
+        : public AsyncIOBackend
+        , public Threading::IRunnable
+    {
+    private:
+        struct Slot final
+        {
+            AsyncReadOperation Operation;
+            AsyncReadVectors Vectors;
+            size_t Count;
+            size_t First;
+            size_t Processed;
+        };
+
+    private:
+        AsyncIOQueue& m_Queue;
+
+        int m_Ring;
+        int m_Event;
+        uint64_t m_EventValue;
+
+        void* m_SqRing;
+        size_t m_SqRingSize;
+        void* m_CqRing;
+        size_t m_CqRingSize;
+        io_uring_sqe* m_Sqes;
+        size_t m_SqesSize;
+
+        uint32_t* m_SqTail;
+        uint32_t* m_SqArray;
+        uint32_t m_SqMask;
+        uint32_t* m_CqHead;
+        uint32_t* m_CqTail;
+        uint32_t m_CqMask;
+        io_uring_cqe* m_Cqes;
+        uint32_t m_ToSubmit;
+
+        std::vector<Slot> m_Slots;
+        std::vector<uint32_t> m_FreeSlots;
+        std::vector<AsyncReadOperation> m_Collected;
+
+        std::atomic<bool> m_Running;
+
+        /// Declared last, so thread is stopped before other members are destroyed.
+        Threading::Thread m_Thread;
+
+    public:
+        explicit LinuxUringAsyncIOBackend(AsyncIOQueue& queue) noexcept
+            : m_Queue{ queue }
+            , m_Ring{ -1 }
+            , m_Event{ -1 }
+            , m_EventValue{}
+            , m_SqRing{ MAP_FAILED }
+            , m_SqRingSize{}
+            , m_CqRing{ MAP_FAILED }
+            , m_CqRingSize{}
+            , m_Sqes{ static_cast<io_uring_sqe*>(MAP_FAILED) }
+            , m_SqesSize{}
+            , m_SqTail{}
+            , m_SqArray{}
+            , m_SqMask{}
+            , m_CqHead{}
+            , m_CqTail{}
+            , m_CqMask{}
+            , m_Cqes{}
+            , m_ToSubmit{}
+            , m_Slots(AsyncIOQueueDepth)
+            , m_FreeSlots{}
+            , m_Collected(AsyncIOQueueDepth)
+            , m_Running{}
+            , m_Thread{}
+        {
+            for (uint32_t i = 0; i < AsyncIOQueueDepth; ++i)
+            {
+                m_FreeSlots.push_back(static_cast<uint32_t>(AsyncIOQueueDepth) - 1 - i);
+            }
+        }
+
+        virtual ~LinuxUringAsyncIOBackend() noexcept
+        {
+            if (m_Running.exchange(false))
+            {
+                Notify();
+                m_Thread.Join();
+            }
+
+            if (m_Sqes != MAP_FAILED)
+            {
+                munmap(m_Sqes, m_SqesSize);
+            }
+
+            if (m_CqRing != MAP_FAILED && m_CqRing != m_SqRing)
+            {
+                munmap(m_CqRing, m_CqRingSize);
+            }
+
+            if (m_SqRing != MAP_FAILED)
+            {
+                munmap(m_SqRing, m_SqRingSize);
+            }
+
+            if (m_Ring != -1)
+            {
+                close(m_Ring);
+            }
+
+            if (m_Event != -1)
+            {
+                close(m_Event);
+            }
+        }
+
+    public:
+        bool Start() noexcept
+        {
+            //
+            // Submission queue holds all operation slots and eventfd read.
+            //
+
+            io_uring_params params{};
+
+            m_Ring = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<uint32_t>(AsyncIOQueueDepth * 2), &params));
+
+            if (m_Ring < 0)
+            {
+                GX_LOG_WARN(LogStorage, "io_uring is not available (errno = {})\n", errno);
+                m_Ring = -1;
+                return false;
+            }
+
+            if (!IsSupported(IORING_OP_READV) || !IsSupported(IORING_OP_READ))
+            {
+                GX_LOG_WARN(LogStorage, "io_uring does not support required operations\n");
+                return false;
+            }
+
+            m_SqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            m_CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            bool const single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+            if (single_mmap)
+            {
+                m_SqRingSize = m_CqRingSize = std::max(m_SqRingSize, m_CqRingSize);
+            }
+
+            m_SqRing = mmap(nullptr, m_SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQ_RING);
+
+            if (m_SqRing == MAP_FAILED)
+            {
+                return false;
+            }
+
+            m_CqRing = single_mmap
+                           ? m_SqRing
+                           : mmap(nullptr, m_CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_CQ_RING);
+
+            if (m_CqRing == MAP_FAILED)
+            {
+                return false;
+            }
+
+            m_SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            m_Sqes     = static_cast<io_uring_sqe*>(mmap(nullptr, m_SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQES));
+
+            if (m_Sqes == MAP_FAILED)
+            {
+                return false;
+            }
+
+            std::byte* const sq = static_cast<std::byte*>(m_SqRing);
+            std::byte* const cq = static_cast<std::byte*>(m_CqRing);
+
+            m_SqTail  = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+            m_SqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+            m_SqMask  = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+            m_CqHead  = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+            m_CqTail  = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+            m_CqMask  = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+            m_Cqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            m_Event = eventfd(0, EFD_CLOEXEC);
+
+            if (m_Event == -1)
+            {
+                return false;
+            }
+
+            m_Running.store(true);
+
+            if (!m_Thread.Start(this, "Async IO"))
+            {
+                m_Running.store(false);
+                return false;
+            }
+
+            return true;
+        }
+
+    public:
+        std::string_view GetName() const noexcept override
+        {
+            return "io_uring";
+        }
+
+        void Notify() noexcept override
+        {
+            uint64_t const value = 1;
+            [[maybe_unused]] ssize_t const result = write(m_Event, &value, sizeof(value));
+        }
+
+        uint32_t OnRun() noexcept override;
+
+    private:
+        //
+        // Operations added after io_uring itself, like IORING_OP_READ in 5.6, fail with -EINVAL on
+        // older kernels. Kernels without probe support lack them too.
+        //
+
+        bool IsSupported(uint8_t opcode) const noexcept
+        {
+            constexpr const size_t MaxOperations = 256;
+
+            std::array<std::byte, sizeof(io_uring_probe) + MaxOperations * sizeof(io_uring_probe_op)> buffer{};
+            io_uring_probe* const probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+
+            if (syscall(__NR_io_uring_register, m_Ring, IORING_REGISTER_PROBE, probe, MaxOperations) < 0)
+            {
+                return false;
+            }
+
+            return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+
+        io_uring_sqe& AcquireEntry() noexcept
+        {
+            uint32_t const tail  = *m_SqTail;
+            uint32_t const index = tail & m_SqMask;
+
+            io_uring_sqe& entry = m_Sqes[index];
+            std::memset(&entry, 0, sizeof(entry));
+
+            m_SqArray[index] = index;
+            std::atomic_ref<uint32_t>{ *m_SqTail }.store(tail + 1, std::memory_order_release);
+
+            ++m_ToSubmit;
+            return entry;
+        }
+
+        void SubmitEventRead() noexcept
+        {
+            io_uring_sqe& entry = AcquireEntry();
+            entry.opcode        = IORING_OP_READ;
+            entry.fd            = m_Event;
+            entry.addr          = reinterpret_cast<uintptr_t>(&m_EventValue);
+            entry.len           = sizeof(m_EventValue);
+            entry.user_data     = AsyncUringEventUserData;
+        }
+
+        void SubmitRead(uint32_t index) noexcept
+        {
+            Slot& slot = m_Slots[index];
+
+            io_uring_sqe& entry = AcquireEntry();
+            entry.opcode        = IORING_OP_READV;
+            entry.fd            = static_cast<int>(slot.Operation.File->GetHandle());
+            entry.off           = static_cast<uint64_t>(slot.Operation.Offset) + slot.Processed;
+            entry.addr          = reinterpret_cast<uintptr_t>(&slot.Vectors[slot.First]);
+            entry.len           = static_cast<uint32_t>(slot.Count - slot.First);
+            entry.user_data     = index;
+        }
+
+        void CompleteSlot(uint32_t index, Status status) noexcept
+        {
+            Slot& slot = m_Slots[index];
+            AsyncIOQueue::Complete(slot.Operation, status, slot.Processed);
+            m_FreeSlots.push_back(index);
+        }
+
+        void ProcessCompletion(const io_uring_cqe& completion) noexcept
+        {
+            uint32_t const index = static_cast<uint32_t>(completion.user_data);
+            Slot& slot           = m_Slots[index];
+
+            if (completion.res < 0)
+            {
+                if (completion.res == -EINTR || completion.res == -EAGAIN)
+                {
+                    SubmitRead(index);
+                }
+                else
+                {
+                    CompleteSlot(index, Status::ReadFault);
+                }
+            }
+            else if (completion.res == 0)
+            {
+                CompleteSlot(index, Status::EndOfStream);
+            }
+            else
+            {
+                size_t const result = static_cast<size_t>(completion.res);
+                slot.Processed += result;
+
+                if (slot.Processed < slot.Operation.Size)
+                {
+                    //
+                    // Short read; issue remaining part.
+                    //
+
+                    slot.First += AsyncAdvanceVectors({ &slot.Vectors[slot.First], slot.Count - slot.First }, result);
+                    SubmitRead(index);
+                }
+                else
+                {
+                    CompleteSlot(index, Status::Success);
+                }
+            }
+        }
+    };
+
+    uint32_t LinuxUringAsyncIOBackend::OnRun() noexcept
+    {
+        bool event_pending = false;
+        bool event_failed  = false;
+
+        for (;;)
+        {
+            bool const running = m_Running.load(std::memory_order_acquire);
+
+            if (running)
+            {
+                if (!event_pending && !event_failed)
+                {
+                    //
+                    // Arm wakeup before collecting requests, so requests enqueued later are not
+                    // missed.
+                    //
+
+                    SubmitEventRead();
+                    event_pending = true;
+                }
+
+                size_t const collected = m_Queue.Collect({ m_Collected.data(), m_FreeSlots.size() });
+
+                for (size_t i = 0; i < collected; ++i)
+                {
+                    uint32_t const index = m_FreeSlots.back();
+                    m_FreeSlots.pop_back();
+
+                    Slot& slot = m_Slots[index];
+                    std::swap(slot.Operation, m_Collected[i]);
+                    slot.Count     = AsyncBuildVectors(slot.Vectors, slot.Operation);
+                    slot.First     = 0;
+                    slot.Processed = 0;
+
+                    SubmitRead(index);
+                }
+            }
+            else if (m_FreeSlots.size() == AsyncIOQueueDepth)
+            {
+                //
+                // All issued operations completed.
+                //
+
+                break;
+            }
+
+            uint32_t wait = 1;
+
+            if (event_failed && m_FreeSlots.size() == AsyncIOQueueDepth)
+            {
+                Threading::SleepThread(1);
+                wait = 0;
+            }
+
+            int const result = static_cast<int>(syscall(__NR_io_uring_enter, m_Ring, m_ToSubmit, wait, IORING_ENTER_GETEVENTS, nullptr, 0));
+
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                GX_LOG_ERROR(LogStorage, "io_uring_enter failed (errno = {})\n", errno);
+                break;
+            }
+
+            m_ToSubmit -= static_cast<uint32_t>(result);
+
+            uint32_t head       = *m_CqHead;
+            uint32_t const tail = std::atomic_ref<uint32_t>{ *m_CqTail }.load(std::memory_order_acquire);
+
+            for (; head != tail; ++head)
+            {
+                io_uring_cqe const& completion = m_Cqes[head & m_CqMask];
+
+                if (completion.user_data == AsyncUringEventUserData)
+                {
+                    if (completion.res < 0 && completion.res != -EINTR && completion.res != -EAGAIN)
+                    {
+                        //
+                        // Rearming failed read would spin. Wake up periodically instead.
+                        //
+
+                        GX_LOG_ERROR(LogStorage, "io_uring wakeup read failed (errno = {})\n", -completion.res);
+                        event_failed = true;
+                    }
+
+                    event_pending = false;
+                }
+                else
+                {
+                    ProcessCompletion(completion);
+                }
+            }
+
+            std::atomic_ref<uint32_t>{ *m_CqHead }.store(head, std::memory_order_release);
+        }
+
+        return 0;
+    }
+
+    std::unique_ptr<AsyncIOBackend> CreateAsyncIONativeBackend(
+        AsyncIOQueue& queue) noexcept
+    {
+        auto backend = std::make_unique<LinuxUringAsyncIOBackend>(queue);
+
+        if (!backend->Start())
+        {
+            return nullptr;
+        }
+
+        return backend;
+    }
+}
@@ -53,21 +53,16 @@ namespace Graphyte::Storage
 
         processed = 0;
 
-
         //
-        // Move file to current position.
+        // Read at tracked offset directly, so file position does not need separate seek for every
+        // request.
         //
 
-        if (lseek(m_Handle, m_Offset, SEEK_SET) == -1)
-        {
-            return Status::ReadFault;
-        }
-
         while (!buffer.empty())
         {
             size_t bytes_requested = std::min<size_t>(BufferSize, buffer.size());
 
-            ssize_t bytes_processed = read(m_Handle, buffer.data(), bytes_requested);
+            ssize_t bytes_processed = pread(m_Handle, buffer.data(), bytes_requested, m_Offset);
 
             if (bytes_processed == 0)
             {
@@ -104,9 +99,9 @@ namespace Graphyte::Storage
 
             ssize_t bytes_processed = write(m_Handle, buffer.data(), bytes_requested);
 
-            if (bytes_processed == 0)
+            if (bytes_processed <= 0)
             {
-                if (errno == EINTR)
+                if (bytes_processed < 0 && errno == EINTR)
                 {
                     continue;
                 }
@@ -121,6 +116,118 @@ namespace Graphyte::Storage
         return Status::Success;
     }
 
+    Status LinuxFileStream::WriteGather(
+        std::span<const std::span<const std::byte>> buffers,
+        size_t& processed) noexcept
+    {
+        GX_ASSERT(IsValid());
+        GX_ASSERT(m_Writing);
+
+        processed = 0;
+
+        //
+        // Buffers are submitted in batches of up to IOV_MAX entries. Partial write resumes from
+        // first unwritten byte.
+        //
+
+        std::array<iovec, 64> vectors{};
+        static_assert(vectors.size() <= IOV_MAX);
+
+        size_t first  = 0;
+        size_t offset = 0;
+
+        while (first < buffers.size())
+        {
+            size_t count = 0;
+
+            for (size_t i = first; i < buffers.size() && count < vectors.size(); ++i)
+            {
+                size_t const skip = (i == first) ? offset : 0;
+
+                if (buffers[i].size() > skip)
+                {
+                    vectors[count].iov_base = const_cast<std::byte*>(buffers[i].data() + skip);
+                    vectors[count].iov_len  = buffers[i].size() - skip;
+                    ++count;
+                }
+            }
+
+            if (count == 0)
+            {
+                break;
+            }
+
+            ssize_t bytes_processed = writev(m_Handle, vectors.data(), static_cast<int>(count));
+
+            if (bytes_processed <= 0)
+            {
+                if (bytes_processed < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                return Status::WriteFault;
+            }
+
+            processed += static_cast<size_t>(bytes_processed);
+
+            size_t remaining = static_cast<size_t>(bytes_processed);
+
+            while (remaining != 0)
+            {
+                size_t const available = buffers[first].size() - offset;
+
+                if (remaining < available)
+                {
+                    offset += remaining;
+                    remaining = 0;
+                }
+                else
+                {
+                    remaining -= available;
+                    offset = 0;
+                    ++first;
+                }
+            }
+
+            while (first < buffers.size() && buffers[first].size() == offset)
+            {
+                offset = 0;
+                ++first;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    Status LinuxFileStream::Sync(
+        StreamSync mode) noexcept
+    {
+        GX_ASSERT(IsValid());
+
+        int result = 0;
+
+        switch (mode)
+        {
+            case StreamSync::None:
+                break;
+
+            case StreamSync::Writeback:
+                result = sync_file_range(m_Handle, 0, 0, SYNC_FILE_RANGE_WRITE);
+                break;
+
+            case StreamSync::Data:
+                result = fdatasync(m_Handle);
+                break;
+
+            case StreamSync::Full:
+                result = fsync(m_Handle);
+                break;
+        }
+
+        return (result == 0) ? Status::Success : Status::Failure;
+    }
+
     int64_t LinuxFileStream::GetSize() noexcept
     {
         GX_ASSERT(IsValid());
@@ -199,6 +306,20 @@ namespace Graphyte::Storage
         }
         else
         {
+            if (origin == SeekOrigin::Current)
+            {
+                value += m_Offset;
+            }
+            else if (origin == SeekOrigin::End)
+            {
+                value += m_Size;
+            }
+
+            if (value < 0)
+            {
+                return Status::InvalidArgument;
+            }
+
             m_Offset = value;
         }
 
@@ -37,6 +37,13 @@ namespace Graphyte::Storage
             std::span<const std::byte> buffer,
             size_t& processed) noexcept override;
 
+        virtual Status WriteGather(
+            std::span<const std::span<const std::byte>> buffers,
+            size_t& processed) noexcept override;
+
+        virtual Status Sync(
+            StreamSync mode) noexcept override;
+
         virtual int64_t GetSize() noexcept override;
 
         virtual int64_t GetPosition() noexcept override;
@@ -4,13 +4,24 @@
 #include <GxBase/Storage/Path.hxx>
 #include "Linux.FileSystem.hxx"
 #include "Linux.FileStream.hxx"
+#include "Linux.MappedFile.hxx"
 
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <dirent.h>
 
 namespace Graphyte::Storage
 {
+    //
+    // File times keep sub-second precision, so changes made within same second are visible.
+    //
+
+    static DateTime FromFileTime(const timespec& value) noexcept
+    {
+        return DateTime::FromUnixTimestamp(value.tv_sec) + TimeSpan{ value.tv_nsec / (1'000'000'000 / Impl::g_TicksInSecond) };
+    }
+
     IFileSystem& IFileSystem::GetPlatformNative() noexcept
     {
         static LinuxFileSystem s_Instance{};
@@ -109,6 +120,70 @@ namespace Graphyte::Storage
         return Status::Failure;
     }
 
+    Status LinuxFileSystem::OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        MappedFileAccess access) noexcept
+    {
+        result = nullptr;
+
+        int32_t handle = open(std::string{ path }.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (handle == -1)
+        {
+            return Status::Failure;
+        }
+
+        // clang-format off
+        struct stat fileinfo{};
+        // clang-format on
+
+        if (fstat(handle, &fileinfo) != 0)
+        {
+            close(handle);
+            return Status::ReadFault;
+        }
+
+        size_t const size = static_cast<size_t>(fileinfo.st_size);
+
+        if (size == 0)
+        {
+            close(handle);
+            result = std::make_unique<LinuxMappedFile>(nullptr, 0);
+            return Status::Success;
+        }
+
+        //
+        // Mapping keeps reference to file, so descriptor is not needed anymore.
+        //
+
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, handle, 0);
+
+        close(handle);
+
+        if (data == MAP_FAILED)
+        {
+            return Status::Failure;
+        }
+
+        switch (access)
+        {
+            case MappedFileAccess::Sequential:
+                madvise(data, size, MADV_SEQUENTIAL);
+                break;
+
+            case MappedFileAccess::Random:
+                madvise(data, size, MADV_RANDOM);
+                break;
+
+            case MappedFileAccess::Normal:
+                break;
+        }
+
+        result = std::make_unique<LinuxMappedFile>(static_cast<std::byte*>(data), size);
+        return Status::Success;
+    }
+
     Status LinuxFileSystem::IsReadonly(
         bool& result,
         const std::string& path) noexcept
@@ -180,11 +255,11 @@ namespace Graphyte::Storage
         struct stat fileinfo{};
         // clang-format on
 
-        if (stat(path.c_str(), &fileinfo) == -1)
+        if (stat(path.c_str(), &fileinfo) != -1)
         {
-            result.CreationTime     = DateTime::FromUnixTimestamp(fileinfo.st_ctime);
-            result.AccessTime       = DateTime::FromUnixTimestamp(fileinfo.st_atime);
-            result.ModificationTime = DateTime::FromUnixTimestamp(fileinfo.st_mtime);
+            result.CreationTime     = FromFileTime(fileinfo.st_ctim);
+            result.AccessTime       = FromFileTime(fileinfo.st_atim);
+            result.ModificationTime = FromFileTime(fileinfo.st_mtim);
             result.FileSize         = static_cast<int64_t>(fileinfo.st_size);
             result.IsDirectory      = S_ISDIR(fileinfo.st_mode);
             result.IsValid          = true;
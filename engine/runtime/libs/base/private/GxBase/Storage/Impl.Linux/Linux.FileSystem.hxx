@@ -12,6 +12,7 @@ namespace Graphyte::Storage
     public:
         virtual Status OpenRead(std::unique_ptr<IStream>& result, const std::string& path, bool share = false) noexcept override;
         virtual Status OpenWrite(std::unique_ptr<IStream>& result, const std::string& path, bool append = false, bool share = false) noexcept override;
+        virtual Status OpenMapped(std::unique_ptr<IMappedFile>& result, std::string_view path, MappedFileAccess access = MappedFileAccess::Normal) noexcept override;
 
     public:
         virtual Status IsReadonly(bool& result, const std::string& path) noexcept override;
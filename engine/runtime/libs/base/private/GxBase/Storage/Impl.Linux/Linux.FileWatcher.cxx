@@ -0,0 +1,345 @@
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Storage/Archive.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+#include "../FileWatcher.Impl.hxx"
+
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <poll.h>
+
+namespace Graphyte::Storage::Impl
+{
+    //
+    // Files are reported when closed after writing, or moved in place, so partially written
+    // content is not reported.
+    //
+
+    constexpr const uint32_t InotifyWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ONLYDIR;
+
+    class LinuxInotifyFileWatcherBackend final : public FileWatcherBackend
+    {
+    private:
+        struct Watch final
+        {
+            std::string Path;
+            bool Recursive;
+        };
+
+        class EntryVisitor final : public IDirectoryVisitor
+        {
+        public:
+            std::vector<std::string> Directories;
+            std::vector<std::string> Files;
+
+        public:
+            virtual Status Visit(
+                std::string_view path,
+                bool is_directory) noexcept override
+            {
+                (is_directory ? Directories : Files).emplace_back(path);
+                return Status::Success;
+            }
+        };
+
+    private:
+        int m_Notify;
+        int m_Cancel;
+        std::unordered_map<int, Watch> m_Watches;
+        std::unordered_set<std::string> m_Created;
+
+    public:
+        LinuxInotifyFileWatcherBackend(
+            int notify,
+            int cancel) noexcept
+            : m_Notify{ notify }
+            , m_Cancel{ cancel }
+            , m_Watches{}
+            , m_Created{}
+        {
+        }
+
+        virtual ~LinuxInotifyFileWatcherBackend() noexcept
+        {
+            close(m_Cancel);
+            close(m_Notify);
+        }
+
+        static std::unique_ptr<FileWatcherBackend> Create() noexcept
+        {
+            int const notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+            if (notify < 0)
+            {
+                GX_LOG_WARN(LogStorage, "Cannot initialize inotify: {}\n", errno);
+                return nullptr;
+            }
+
+            int const cancel = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (cancel < 0)
+            {
+                GX_LOG_WARN(LogStorage, "Cannot create eventfd: {}\n", errno);
+                close(notify);
+                return nullptr;
+            }
+
+            return std::make_unique<LinuxInotifyFileWatcherBackend>(notify, cancel);
+        }
+
+    public:
+        std::string_view GetName() const noexcept override
+        {
+            return "Inotify";
+        }
+
+        Status Add(
+            std::string_view path,
+            bool recursive) noexcept override
+        {
+            if (Status const status = AddWatch(path, recursive); status != Status::Success || !recursive)
+            {
+                return status;
+            }
+
+            EntryVisitor visitor{};
+
+            if (Status const status = IFileSystem::GetPlatformNative().EnumerateRecursive(path, visitor); status != Status::Success)
+            {
+                return status;
+            }
+
+            for (std::string const& directory : visitor.Directories)
+            {
+                if (Status const status = AddWatch(directory, true); status != Status::Success)
+                {
+                    return status;
+                }
+            }
+
+            return Status::Success;
+        }
+
+        Status Wait(
+            std::vector<FileChange>& changes,
+            uint32_t timeout) noexcept override
+        {
+            uint64_t const resolution = System::GetTimestampResolution();
+            uint64_t const started    = System::GetTimestamp();
+
+            size_t const count = changes.size();
+
+            for (;;)
+            {
+                int remaining = -1;
+
+                if (timeout != UINT32_MAX)
+                {
+                    uint64_t const elapsed = ((System::GetTimestamp() - started) * 1000) / resolution;
+                    remaining              = static_cast<int>(std::min<uint64_t>(timeout - std::min<uint64_t>(elapsed, timeout), INT_MAX));
+                }
+
+                std::array<pollfd, 2> descriptors{ {
+                    { .fd = m_Notify, .events = POLLIN, .revents = 0 },
+                    { .fd = m_Cancel, .events = POLLIN, .revents = 0 },
+                } };
+
+                int const result = poll(descriptors.data(), descriptors.size(), remaining);
+
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return Diagnostics::GetStatusFromErrno(errno);
+                }
+
+                if (result == 0)
+                {
+                    return Status::Timeout;
+                }
+
+                if ((descriptors[1].revents & POLLIN) != 0)
+                {
+                    uint64_t value{};
+                    [[maybe_unused]] ssize_t const processed = read(m_Cancel, &value, sizeof(value));
+                    return Status::Cancelled;
+                }
+
+                ReadEvents(changes);
+
+                //
+                // Events of directories themselves are not reported, so wait again.
+                //
+
+                if (changes.size() != count)
+                {
+                    return Status::Success;
+                }
+            }
+        }
+
+        void Cancel() noexcept override
+        {
+            uint64_t const value = 1;
+            [[maybe_unused]] ssize_t const processed = write(m_Cancel, &value, sizeof(value));
+        }
+
+    private:
+        Status AddWatch(
+            std::string_view path,
+            bool recursive) noexcept
+        {
+            std::string const native{ path };
+
+            int const wd = inotify_add_watch(m_Notify, native.c_str(), InotifyWatchMask);
+
+            if (wd < 0)
+            {
+                int const error = errno;
+
+                if (error == ENOSPC)
+                {
+                    GX_LOG_ERROR(LogStorage, "Inotify watch limit reached, increase fs.inotify.max_user_watches\n");
+                }
+
+                return Diagnostics::GetStatusFromErrno(error);
+            }
+
+            //
+            // Same directory gets same descriptor.
+            //
+
+            if (auto const it = m_Watches.find(wd); it != m_Watches.end())
+            {
+                it->second.Recursive |= recursive;
+            }
+            else
+            {
+                m_Watches.emplace(wd, Watch{ native, recursive });
+            }
+
+            return Status::Success;
+        }
+
+        void ReadEvents(
+            std::vector<FileChange>& changes) noexcept
+        {
+            alignas(inotify_event) std::array<char, 64 << 10> buffer;
+
+            for (;;)
+            {
+                ssize_t const processed = read(m_Notify, buffer.data(), buffer.size());
+
+                if (processed < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                for (char const* it = buffer.data(); it < buffer.data() + processed;)
+                {
+                    inotify_event const& event = *reinterpret_cast<inotify_event const*>(it);
+                    it += sizeof(inotify_event) + event.len;
+
+                    ProcessEvent(changes, event);
+                }
+            }
+        }
+
+        void ProcessEvent(
+            std::vector<FileChange>& changes,
+            inotify_event const& event) noexcept
+        {
+            if ((event.mask & IN_Q_OVERFLOW) != 0)
+            {
+                changes.push_back(FileChange{ {}, FileChangeType::Overflow });
+                return;
+            }
+
+            auto const watch = m_Watches.find(event.wd);
+
+            if (watch == m_Watches.end())
+            {
+                return;
+            }
+
+            if ((event.mask & IN_IGNORED) != 0)
+            {
+                m_Watches.erase(watch);
+                return;
+            }
+
+            if (event.len == 0)
+            {
+                return;
+            }
+
+            std::string path     = CombinePath(watch->second.Path, event.name);
+            bool const recursive = watch->second.Recursive;
+
+            if ((event.mask & IN_ISDIR) != 0)
+            {
+                if (recursive && (event.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+                {
+                    //
+                    // Files may be created in new directory before it is watched, so they are
+                    // reported as added.
+                    //
+
+                    [[maybe_unused]] Status const status = Add(path, true);
+
+                    EntryVisitor visitor{};
+
+                    if (IFileSystem::GetPlatformNative().EnumerateRecursive(path, visitor) == Status::Success)
+                    {
+                        for (std::string& file : visitor.Files)
+                        {
+                            changes.push_back(FileChange{ std::move(file), FileChangeType::Added });
+                        }
+                    }
+                }
+
+                return;
+            }
+
+            if ((event.mask & IN_CREATE) != 0)
+            {
+                //
+                // New file is reported as added once it's closed after writing.
+                //
+
+                m_Created.insert(std::move(path));
+            }
+            else if ((event.mask & IN_CLOSE_WRITE) != 0)
+            {
+                FileChangeType const type = (m_Created.erase(path) != 0)
+                                                ? FileChangeType::Added
+                                                : FileChangeType::Modified;
+
+                changes.push_back(FileChange{ std::move(path), type });
+            }
+            else if ((event.mask & IN_MOVED_TO) != 0)
+            {
+                changes.push_back(FileChange{ std::move(path), FileChangeType::Added });
+            }
+            else if ((event.mask & (IN_DELETE | IN_MOVED_FROM)) != 0)
+            {
+                m_Created.erase(path);
+                changes.push_back(FileChange{ std::move(path), FileChangeType::Removed });
+            }
+        }
+    };
+
+    std::unique_ptr<FileWatcherBackend> CreateFileWatcherNativeBackend() noexcept
+    {
+        return LinuxInotifyFileWatcherBackend::Create();
+    }
+}
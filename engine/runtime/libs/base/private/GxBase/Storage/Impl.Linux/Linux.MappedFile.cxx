@@ -0,0 +1,49 @@
+#include <GxBase/Diagnostics.hxx>
+#include "Linux.MappedFile.hxx"
+
+#include <sys/mman.h>
+
+namespace Graphyte::Storage
+{
+    LinuxMappedFile::LinuxMappedFile(
+        std::byte* data,
+        size_t size) noexcept
+        : m_Data{ data }
+        , m_Size{ size }
+    {
+        GX_ASSERT((m_Data != nullptr) || (m_Size == 0));
+    }
+
+    LinuxMappedFile::~LinuxMappedFile() noexcept
+    {
+        if (m_Data != nullptr)
+        {
+            munmap(m_Data, m_Size);
+        }
+    }
+
+    std::span<const std::byte> LinuxMappedFile::GetView() noexcept
+    {
+        return { m_Data, m_Size };
+    }
+
+    void LinuxMappedFile::Prefetch(
+        size_t offset,
+        size_t size) noexcept
+    {
+        if (offset >= m_Size)
+        {
+            return;
+        }
+
+        //
+        // madvise requires page aligned address.
+        //
+
+        size_t const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t const begin     = offset & ~(page_size - 1);
+        size_t const end       = std::min(offset + size, m_Size);
+
+        madvise(m_Data + begin, end - begin, MADV_WILLNEED);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <GxBase/Storage/IMappedFile.hxx>
+
+namespace Graphyte::Storage
+{
+    class BASE_API LinuxMappedFile final : public IMappedFile
+    {
+    private:
+        std::byte* m_Data;
+        size_t m_Size;
+
+    public:
+        LinuxMappedFile(std::byte* data, size_t size) noexcept;
+        virtual ~LinuxMappedFile() noexcept;
+
+    public:
+        virtual std::span<const std::byte> GetView() noexcept override;
+
+        virtual void Prefetch(
+            size_t offset,
+            size_t size) noexcept override;
+    };
+}
@@ -0,0 +1,142 @@
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/System/Impl.Windows/Windows.Helpers.hxx>
+#include <GxBase/System/Impl.Windows/Windows.Types.hxx>
+#include "../AsyncIO.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    std::unique_ptr<AsyncIOBackend> CreateAsyncIONativeBackend(
+        [[maybe_unused]] AsyncIOQueue& queue) noexcept
+    {
+        //
+        // Reads are issued from thread pool.
+        //
+
+        return nullptr;
+    }
+
+    Status AsyncOpenNative(
+        uintptr_t& handle,
+        int64_t& size,
+        std::string_view path) noexcept
+    {
+        System::Impl::WindowsPath wpath{};
+
+        if (!System::Impl::WidenStringPath(wpath, path))
+        {
+            return Status::InvalidArgument;
+        }
+
+        //
+        // Overlapped handle allows concurrent reads of same file from many threads.
+        //
+
+        CREATEFILE2_EXTENDED_PARAMETERS create_parameters{
+            .dwSize               = sizeof(CREATEFILE2_EXTENDED_PARAMETERS),
+            .dwFileAttributes     = FILE_ATTRIBUTE_NORMAL,
+            .dwFileFlags          = FILE_FLAG_OVERLAPPED,
+            .dwSecurityQosFlags   = 0,
+            .lpSecurityAttributes = nullptr,
+            .hTemplateFile        = nullptr,
+        };
+
+        HANDLE file = CreateFile2(
+            wpath.data(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            OPEN_EXISTING,
+            &create_parameters);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return Diagnostics::GetStatusFromSystemError();
+        }
+
+        LARGE_INTEGER li{};
+
+        if (GetFileSizeEx(file, &li) == FALSE)
+        {
+            Status const status = Diagnostics::GetStatusFromSystemError();
+            CloseHandle(file);
+            return status;
+        }
+
+        handle = reinterpret_cast<uintptr_t>(file);
+        size   = li.QuadPart;
+        return Status::Success;
+    }
+
+    void AsyncCloseNative(
+        uintptr_t handle) noexcept
+    {
+        CloseHandle(reinterpret_cast<HANDLE>(handle));
+    }
+
+    Status AsyncReadNative(
+        const AsyncReadOperation& operation,
+        size_t& processed) noexcept
+    {
+        HANDLE const file = reinterpret_cast<HANDLE>(operation.File->GetHandle());
+
+        processed = 0;
+
+        OVERLAPPED overlapped{};
+        overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+        if (overlapped.hEvent == nullptr)
+        {
+            return Diagnostics::GetStatusFromSystemError();
+        }
+
+        Status status = Status::Success;
+
+        for (AsyncRequestState const* const request : operation.Requests)
+        {
+            std::span<std::byte> buffer = request->Buffer;
+
+            while (!buffer.empty() && status == Status::Success)
+            {
+                ULARGE_INTEGER position{
+                    .QuadPart = static_cast<uint64_t>(operation.Offset) + processed,
+                };
+
+                overlapped.Offset     = position.LowPart;
+                overlapped.OffsetHigh = position.HighPart;
+
+                DWORD dwRequested = static_cast<DWORD>(std::min<size_t>(buffer.size(), std::numeric_limits<DWORD>::max()));
+                DWORD dwProcessed = 0;
+
+                if (ReadFile(file, buffer.data(), dwRequested, nullptr, &overlapped) == FALSE && GetLastError() != ERROR_IO_PENDING)
+                {
+                    status = (GetLastError() == ERROR_HANDLE_EOF) ? Status::EndOfStream : Status::ReadFault;
+                }
+                else if (GetOverlappedResult(file, &overlapped, &dwProcessed, TRUE) == FALSE)
+                {
+                    status = (GetLastError() == ERROR_HANDLE_EOF) ? Status::EndOfStream : Status::ReadFault;
+                }
+                else if (dwProcessed == 0)
+                {
+                    status = Status::EndOfStream;
+                }
+                else
+                {
+                    processed += dwProcessed;
+                    buffer = buffer.subspan(dwProcessed);
+                }
+            }
+        }
+
+        CloseHandle(overlapped.hEvent);
+        return status;
+    }
+
+    void AsyncReadAheadNative(
+        [[maybe_unused]] uintptr_t handle,
+        [[maybe_unused]] int64_t offset,
+        [[maybe_unused]] size_t size) noexcept
+    {
+        //
+        // Not supported for file handles; system cache manager reads ahead on its own.
+        //
+    }
+}
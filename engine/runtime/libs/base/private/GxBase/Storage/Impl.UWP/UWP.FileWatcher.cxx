@@ -0,0 +1,13 @@
+#include "../FileWatcher.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    std::unique_ptr<FileWatcherBackend> CreateFileWatcherNativeBackend() noexcept
+    {
+        //
+        // Changes are detected by polling.
+        //
+
+        return nullptr;
+    }
+}
@@ -7,6 +7,7 @@
 #include <GxBase/System.hxx>
 #include "Windows.AsyncFileStream.hxx"
 #include "Windows.FileStream.hxx"
+#include "Windows.MappedFile.hxx"
 #include "Windows.FileSystem.hxx"
 
 namespace Graphyte::Storage
@@ -91,6 +92,91 @@ namespace Graphyte::Storage
         return Status::InvalidArgument;
     }
 
+    Status WindowsFileSystem::OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        MappedFileAccess access) noexcept
+    {
+        result = nullptr;
+
+        System::Impl::WindowsPath wpath{};
+
+        if (!System::Impl::WidenStringPath(wpath, path))
+        {
+            return Status::InvalidArgument;
+        }
+
+        DWORD dwFlags = FILE_ATTRIBUTE_NORMAL;
+
+        if (access == MappedFileAccess::Sequential)
+        {
+            dwFlags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        }
+        else if (access == MappedFileAccess::Random)
+        {
+            dwFlags |= FILE_FLAG_RANDOM_ACCESS;
+        }
+
+        HANDLE handle = CreateFileW(
+            wpath.data(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            dwFlags,
+            nullptr);
+
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return Diagnostics::GetStatusFromSystemError();
+        }
+
+        LARGE_INTEGER li{};
+
+        if (GetFileSizeEx(handle, &li) == FALSE)
+        {
+            Status const status = Diagnostics::GetStatusFromSystemError();
+            CloseHandle(handle);
+            return status;
+        }
+
+        if (li.QuadPart == 0)
+        {
+            //
+            // Empty files cannot be mapped.
+            //
+
+            CloseHandle(handle);
+            result = std::make_unique<WindowsMappedFile>(nullptr, 0);
+            return Status::Success;
+        }
+
+        HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        CloseHandle(handle);
+
+        if (mapping == nullptr)
+        {
+            return Diagnostics::GetStatusFromSystemError();
+        }
+
+        //
+        // View keeps reference to mapping object.
+        //
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        CloseHandle(mapping);
+
+        if (data == nullptr)
+        {
+            return Diagnostics::GetStatusFromSystemError();
+        }
+
+        result = std::make_unique<WindowsMappedFile>(static_cast<std::byte*>(data), static_cast<size_t>(li.QuadPart));
+        return Status::Success;
+    }
+
     Status WindowsFileSystem::IsReadonly(
         bool& result,
         std::string_view path) noexcept
@@ -22,6 +22,11 @@ namespace Graphyte::Storage
             bool append = false,
             bool share  = false) noexcept override;
 
+        virtual Status OpenMapped(
+            std::unique_ptr<IMappedFile>& result,
+            std::string_view path,
+            MappedFileAccess access = MappedFileAccess::Normal) noexcept override;
+
     public:
         virtual Status IsReadonly(
             bool& result,
@@ -0,0 +1,56 @@
+#pragma once
+#include <GxBase/Storage/IMappedFile.hxx>
+#include <GxBase/System/Impl.Windows/Windows.Helpers.hxx>
+#include <GxBase/System/Impl.Windows/Windows.Types.hxx>
+
+namespace Graphyte::Storage
+{
+    class WindowsMappedFile final
+        : public IMappedFile
+    {
+    private:
+        std::byte* m_Data;
+        size_t m_Size;
+
+    public:
+        WindowsMappedFile(
+            std::byte* data,
+            size_t size) noexcept
+            : m_Data{ data }
+            , m_Size{ size }
+        {
+            GX_ASSERT((this->m_Data != nullptr) || (this->m_Size == 0));
+        }
+
+        virtual ~WindowsMappedFile() noexcept
+        {
+            if (this->m_Data != nullptr)
+            {
+                UnmapViewOfFile(this->m_Data);
+            }
+        }
+
+    public:
+        virtual std::span<const std::byte> GetView() noexcept final override
+        {
+            return { this->m_Data, this->m_Size };
+        }
+
+        virtual void Prefetch(
+            size_t offset,
+            size_t size) noexcept final override
+        {
+            if (offset >= this->m_Size)
+            {
+                return;
+            }
+
+            WIN32_MEMORY_RANGE_ENTRY range{
+                .VirtualAddress = this->m_Data + offset,
+                .NumberOfBytes  = std::min(size, this->m_Size - offset),
+            };
+
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+    };
+}
@@ -0,0 +1,677 @@
+#include <GxBase/Storage/MemoryFileSystem.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+#include "VirtualPath.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    namespace
+    {
+        /// @brief Reads snapshot of memory file.
+        class MemoryFileReader final : public IStream
+        {
+        private:
+            std::shared_ptr<const std::vector<std::byte>> m_Content;
+            int64_t m_Position;
+
+        public:
+            explicit MemoryFileReader(
+                std::shared_ptr<const std::vector<std::byte>> content) noexcept
+                : m_Content{ std::move(content) }
+                , m_Position{}
+            {
+            }
+
+            virtual ~MemoryFileReader() noexcept = default;
+
+        public:
+            virtual Status Flush() noexcept override
+            {
+                return Status::Success;
+            }
+
+            virtual Status Read(
+                std::span<std::byte> buffer,
+                size_t& processed) noexcept override
+            {
+                size_t const position = std::min(static_cast<size_t>(m_Position), m_Content->size());
+
+                processed = std::min(buffer.size(), m_Content->size() - position);
+
+                if (processed != 0)
+                {
+                    std::memcpy(buffer.data(), m_Content->data() + position, processed);
+                }
+
+                m_Position += static_cast<int64_t>(processed);
+
+                return (processed == buffer.size()) ? Status::Success : Status::EndOfStream;
+            }
+
+            virtual Status Write(
+                [[maybe_unused]] std::span<const std::byte> buffer,
+                size_t& processed) noexcept override
+            {
+                processed = 0;
+                return Status::NotSupported;
+            }
+
+            virtual int64_t GetSize() noexcept override
+            {
+                return static_cast<int64_t>(m_Content->size());
+            }
+
+            virtual int64_t GetPosition() noexcept override
+            {
+                return m_Position;
+            }
+
+            virtual Status SetPosition(
+                int64_t value,
+                SeekOrigin origin) noexcept override
+            {
+                switch (origin)
+                {
+                    case SeekOrigin::Begin:
+                        return SetPosition(value);
+
+                    case SeekOrigin::Current:
+                        return SetPosition(m_Position + value);
+
+                    case SeekOrigin::End:
+                        return SetPosition(GetSize() + value);
+                }
+
+                return Status::InvalidArgument;
+            }
+
+            virtual Status SetPosition(
+                int64_t value) noexcept override
+            {
+                if (value < 0)
+                {
+                    return Status::InvalidArgument;
+                }
+
+                m_Position = value;
+                return Status::Success;
+            }
+        };
+
+        /// @brief Represents snapshot of memory file as mapped file.
+        class MemoryMappedFile final : public IMappedFile
+        {
+        private:
+            std::shared_ptr<const std::vector<std::byte>> m_Content;
+
+        public:
+            explicit MemoryMappedFile(
+                std::shared_ptr<const std::vector<std::byte>> content) noexcept
+                : m_Content{ std::move(content) }
+            {
+            }
+
+            virtual std::span<const std::byte> GetView() noexcept override
+            {
+                return *m_Content;
+            }
+
+            virtual void Prefetch(
+                [[maybe_unused]] size_t offset,
+                [[maybe_unused]] size_t size) noexcept override
+            {
+            }
+        };
+    }
+
+    /// @brief Writes memory file. Content is published on flush and when writer is destroyed.
+    class MemoryFileWriter final : public IStream
+    {
+    private:
+        MemoryFileSystem& m_FileSystem;
+        std::string m_Path;
+        std::vector<std::byte> m_Content;
+        int64_t m_Position;
+        bool m_Modified;
+
+    public:
+        MemoryFileWriter(
+            MemoryFileSystem& filesystem,
+            std::string path,
+            std::vector<std::byte> content) noexcept
+            : m_FileSystem{ filesystem }
+            , m_Path{ std::move(path) }
+            , m_Content{ std::move(content) }
+            , m_Position{ static_cast<int64_t>(m_Content.size()) }
+            , m_Modified{ true }
+        {
+        }
+
+        virtual ~MemoryFileWriter() noexcept
+        {
+            (void)Flush();
+        }
+
+    public:
+        virtual Status Flush() noexcept override
+        {
+            if (m_Modified)
+            {
+                m_FileSystem.Publish(m_Path, std::make_shared<const std::vector<std::byte>>(m_Content));
+                m_Modified = false;
+            }
+
+            return Status::Success;
+        }
+
+        virtual Status Read(
+            [[maybe_unused]] std::span<std::byte> buffer,
+            size_t& processed) noexcept override
+        {
+            processed = 0;
+            return Status::NotSupported;
+        }
+
+        virtual Status Write(
+            std::span<const std::byte> buffer,
+            size_t& processed) noexcept override
+        {
+            size_t const position = static_cast<size_t>(m_Position);
+
+            if (m_Content.size() < (position + buffer.size()))
+            {
+                m_Content.resize(position + buffer.size());
+            }
+
+            if (!buffer.empty())
+            {
+                std::memcpy(m_Content.data() + position, buffer.data(), buffer.size());
+            }
+
+            processed = buffer.size();
+            m_Position += static_cast<int64_t>(processed);
+            m_Modified = true;
+
+            return Status::Success;
+        }
+
+        virtual int64_t GetSize() noexcept override
+        {
+            return static_cast<int64_t>(m_Content.size());
+        }
+
+        virtual int64_t GetPosition() noexcept override
+        {
+            return m_Position;
+        }
+
+        virtual Status SetPosition(
+            int64_t value,
+            SeekOrigin origin) noexcept override
+        {
+            switch (origin)
+            {
+                case SeekOrigin::Begin:
+                    return SetPosition(value);
+
+                case SeekOrigin::Current:
+                    return SetPosition(m_Position + value);
+
+                case SeekOrigin::End:
+                    return SetPosition(GetSize() + value);
+            }
+
+            return Status::InvalidArgument;
+        }
+
+        virtual Status SetPosition(
+            int64_t value) noexcept override
+        {
+            if (value < 0)
+            {
+                return Status::InvalidArgument;
+            }
+
+            m_Position = value;
+            return Status::Success;
+        }
+    };
+}
+
+namespace Graphyte::Storage
+{
+    MemoryFileSystem::MemoryFileSystem() noexcept
+        : m_Lock{}
+        , m_Files{}
+        , m_Directories{}
+        , m_CreationTime{ DateTime::Now() }
+    {
+    }
+
+    MemoryFileSystem::~MemoryFileSystem() noexcept = default;
+
+    Status MemoryFileSystem::OpenRead(
+        std::unique_ptr<IStream>& result,
+        std::string_view path,
+        [[maybe_unused]] bool share) noexcept
+    {
+        result = nullptr;
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (auto const it = m_Files.find(normalized); it != m_Files.end())
+        {
+            result = std::make_unique<Impl::MemoryFileReader>(it->second.Content);
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status MemoryFileSystem::OpenWrite(
+        std::unique_ptr<IStream>& result,
+        std::string_view path,
+        bool append,
+        [[maybe_unused]] bool share) noexcept
+    {
+        result = nullptr;
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path) || normalized.empty())
+        {
+            return Status::InvalidPath;
+        }
+
+        std::vector<std::byte> content{};
+
+        {
+            Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+            if (IsDirectory(normalized))
+            {
+                return Status::AccessDenied;
+            }
+
+            if (auto const it = m_Files.find(normalized); append && it != m_Files.end())
+            {
+                content = *it->second.Content;
+            }
+        }
+
+        auto writer = std::make_unique<Impl::MemoryFileWriter>(*this, std::move(normalized), std::move(content));
+
+        //
+        // File is visible immediately, as it would be on disk.
+        //
+
+        (void)writer->Flush();
+
+        result = std::move(writer);
+        return Status::Success;
+    }
+
+    Status MemoryFileSystem::OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        [[maybe_unused]] MappedFileAccess access) noexcept
+    {
+        result = nullptr;
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (auto const it = m_Files.find(normalized); it != m_Files.end())
+        {
+            result = std::make_unique<Impl::MemoryMappedFile>(it->second.Content);
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status MemoryFileSystem::IsReadonly(
+        bool& result,
+        std::string_view path) noexcept
+    {
+        result = false;
+        return Exists(path);
+    }
+
+    Status MemoryFileSystem::SetReadonly(
+        [[maybe_unused]] std::string_view path,
+        [[maybe_unused]] bool value) noexcept
+    {
+        return Status::NotSupported;
+    }
+
+    Status MemoryFileSystem::GetFileInfo(
+        FileInfo& result,
+        std::string_view path) noexcept
+    {
+        result = FileInfo{
+            .CreationTime     = m_CreationTime,
+            .AccessTime       = m_CreationTime,
+            .ModificationTime = m_CreationTime,
+            .FileSize         = 0,
+            .IsDirectory      = false,
+            .IsReadonly       = false,
+            .IsValid          = false,
+        };
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (auto const it = m_Files.find(normalized); it != m_Files.end())
+        {
+            result.AccessTime       = it->second.ModificationTime;
+            result.ModificationTime = it->second.ModificationTime;
+            result.FileSize         = static_cast<int64_t>(it->second.Content->size());
+            result.IsValid          = true;
+            return Status::Success;
+        }
+
+        if (IsDirectory(normalized))
+        {
+            result.IsDirectory = true;
+            result.IsValid     = true;
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status MemoryFileSystem::GetFileSize(
+        int64_t& result,
+        std::string_view path) noexcept
+    {
+        result = -1;
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (auto const it = m_Files.find(normalized); it != m_Files.end())
+        {
+            result = static_cast<int64_t>(it->second.Content->size());
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status MemoryFileSystem::Exists(
+        std::string_view path) noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (m_Files.contains(normalized) || IsDirectory(normalized))
+        {
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status MemoryFileSystem::FileMove(
+        std::string_view destination,
+        std::string_view source) noexcept
+    {
+        std::string normalized_destination{};
+        std::string normalized_source{};
+
+        if (!Impl::NormalizeVirtualPath(normalized_destination, destination) || !Impl::NormalizeVirtualPath(normalized_source, source) || normalized_destination.empty())
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        auto node = m_Files.extract(normalized_source);
+
+        if (node.empty())
+        {
+            return Status::NotFound;
+        }
+
+        node.key() = std::move(normalized_destination);
+        m_Files.insert_or_assign(std::move(node.key()), std::move(node.mapped()));
+
+        return Status::Success;
+    }
+
+    Status MemoryFileSystem::FileDelete(
+        std::string_view path) noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        return (m_Files.erase(normalized) != 0) ? Status::Success : Status::NotFound;
+    }
+
+    Status MemoryFileSystem::DirectoryCreate(
+        std::string_view path) noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path) || normalized.empty())
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (m_Files.contains(normalized))
+        {
+            return Status::AlreadyExists;
+        }
+
+        m_Directories.insert(std::move(normalized));
+        return Status::Success;
+    }
+
+    Status MemoryFileSystem::DirectoryDelete(
+        std::string_view path) noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path) || normalized.empty())
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (!IsDirectory(normalized))
+        {
+            return Status::NotFound;
+        }
+
+        std::string const prefix = normalized + '/';
+
+        auto const file = m_Files.lower_bound(prefix);
+        auto const directory = m_Directories.lower_bound(prefix);
+
+        if ((file != m_Files.end() && file->first.starts_with(prefix))
+            || (directory != m_Directories.end() && directory->starts_with(prefix)))
+        {
+            return Status::DirectoryNotEmpty;
+        }
+
+        m_Directories.erase(normalized);
+        return Status::Success;
+    }
+
+    Status MemoryFileSystem::Enumerate(
+        std::string_view path,
+        IDirectoryVisitor& visitor) noexcept
+    {
+        std::vector<std::pair<std::string, bool>> children{};
+
+        if (Status const status = EnumerateChildren(path, children); status != Status::Success)
+        {
+            return status;
+        }
+
+        for (auto const& [child, is_directory] : children)
+        {
+            if (visitor.Visit(child, is_directory) != Status::Success)
+            {
+                return Status::Failure;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    Status MemoryFileSystem::Enumerate(
+        std::string_view path,
+        IDirectoryInfoVisitor& visitor) noexcept
+    {
+        std::vector<std::pair<std::string, bool>> children{};
+
+        if (Status const status = EnumerateChildren(path, children); status != Status::Success)
+        {
+            return status;
+        }
+
+        for (auto const& [child, is_directory] : children)
+        {
+            FileInfo info{};
+
+            if (GetFileInfo(info, child) != Status::Success)
+            {
+                //
+                // Removed since children were collected.
+                //
+
+                continue;
+            }
+
+            if (visitor.Visit(child, info) != Status::Success)
+            {
+                return Status::Failure;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    void MemoryFileSystem::Publish(
+        const std::string& path,
+        std::shared_ptr<const std::vector<std::byte>> content) noexcept
+    {
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        m_Files.insert_or_assign(path, File{ std::move(content), DateTime::Now() });
+    }
+
+    bool MemoryFileSystem::IsDirectory(
+        std::string_view path) const noexcept
+    {
+        if (path.empty() || m_Directories.contains(path))
+        {
+            return true;
+        }
+
+        std::string prefix{ path };
+        prefix.push_back('/');
+
+        auto const file      = m_Files.lower_bound(prefix);
+        auto const directory = m_Directories.lower_bound(prefix);
+
+        return (file != m_Files.end() && file->first.starts_with(prefix))
+               || (directory != m_Directories.end() && directory->starts_with(prefix));
+    }
+
+    Status MemoryFileSystem::EnumerateChildren(
+        std::string_view path,
+        std::vector<std::pair<std::string, bool>>& children) noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedLock<Threading::CriticalSection> lock{ m_Lock };
+
+        if (!IsDirectory(normalized))
+        {
+            return Status::NotFound;
+        }
+
+        std::string const prefix = normalized.empty() ? std::string{} : (normalized + '/');
+
+        //
+        // Files and directories nested deeper contribute their first path component as directory.
+        //
+
+        std::map<std::string, bool, std::less<>> unique{};
+
+        auto const collect = [&](std::string_view key, bool is_directory) {
+            std::string_view const remainder = key.substr(prefix.size());
+            size_t const separator           = remainder.find('/');
+
+            if (separator == std::string_view::npos)
+            {
+                unique.try_emplace(std::string{ key }, is_directory);
+            }
+            else
+            {
+                unique.try_emplace(std::string{ key.substr(0, prefix.size() + separator) }, true);
+            }
+        };
+
+        for (auto it = m_Files.lower_bound(prefix); it != m_Files.end() && it->first.starts_with(prefix); ++it)
+        {
+            collect(it->first, false);
+        }
+
+        for (auto it = m_Directories.lower_bound(prefix); it != m_Directories.end() && it->starts_with(prefix); ++it)
+        {
+            collect(*it, true);
+        }
+
+        children.assign(unique.begin(), unique.end());
+        return Status::Success;
+    }
+}
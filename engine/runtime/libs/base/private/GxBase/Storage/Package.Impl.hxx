@@ -0,0 +1,95 @@
+#pragma once
+#include <GxBase/Storage/PackageFileSystem.hxx>
+#include "VirtualPath.Impl.hxx"
+
+// =================================================================================================
+//
+// Package file format.
+//
+// Layout:
+//
+//  header:  signature (u32), version (u16), alignment log2 (u8), reserved (u8),
+//           entry count (u32), block count (u32), index offset (u64), index size (u64),
+//           timestamp (i64), index checksum (u64), reserved (u64), reserved (u64)
+//
+//  content: entries data, in order of addition
+//
+//  index:   entries sorted by path hash, block table, names
+//
+//  entry:   path hash (u64), offset (u64), size (u64), stored size (u64), first block (u32),
+//           block count (u32), name offset (u32), name length (u16), method (u8),
+//           block size log2 (u8)
+//
+//  block:   end offset relative to entry offset (u64)
+//
+//  Entry without blocks is stored uncompressed and aligned to package alignment, so it may be
+//  mapped directly. Compressed entry is split into blocks of same decompressed size, except last
+//  one. Highest bit of block end offset marks block stored without compression. Path hash is
+//  computed from normalized, lowercase path.
+//
+
+namespace Graphyte::Storage::Impl
+{
+    constexpr const uint32_t PackageSignature = 0x4B505847;
+    constexpr const uint16_t PackageVersion   = 1;
+
+    constexpr const size_t PackageHeaderSize = 64;
+    constexpr const size_t PackageEntrySize  = 48;
+    constexpr const size_t PackageBlockSize  = 8;
+
+    constexpr const uint64_t PackageBlockStored = uint64_t{ 1 } << 63;
+
+    constexpr const uint32_t PackageMinBlockSizeLog2 = 12;
+    constexpr const uint32_t PackageMaxBlockSizeLog2 = 24;
+
+    constexpr const uint32_t PackageMaxAlignmentLog2 = 16;
+
+    constexpr const uint64_t PackageHashSeed = 0x4B505847'00000001;
+
+    struct PackageHeader final
+    {
+        uint32_t Signature;
+        uint16_t Version;
+        uint8_t AlignmentLog2;
+        uint8_t Reserved0;
+        uint32_t EntryCount;
+        uint32_t BlockCount;
+        uint64_t IndexOffset;
+        uint64_t IndexSize;
+        int64_t Timestamp;
+        uint64_t IndexChecksum;
+        uint64_t Reserved1;
+        uint64_t Reserved2;
+    };
+    static_assert(sizeof(PackageHeader) == PackageHeaderSize);
+
+    struct PackageEntry final
+    {
+        uint64_t PathHash;
+        uint64_t Offset;
+        uint64_t Size;
+        uint64_t StoredSize;
+        uint32_t FirstBlock;
+        uint32_t BlockCount;
+        uint32_t NameOffset;
+        uint16_t NameLength;
+        uint8_t Method;
+        uint8_t BlockSizeLog2;
+    };
+    static_assert(sizeof(PackageEntry) == PackageEntrySize);
+
+    //
+    // Package is read directly from mapped memory. Format is little endian.
+    //
+
+    static_assert(std::endian::native == std::endian::little);
+
+    /// @brief Computes hash of normalized path.
+    [[nodiscard]] uint64_t HashPackagePath(
+        std::string_view path) noexcept;
+
+    /// @brief Compares normalized paths ignoring case.
+    [[nodiscard]] bool EqualPackagePath(
+        std::string_view lhs,
+        std::string_view rhs) noexcept;
+}
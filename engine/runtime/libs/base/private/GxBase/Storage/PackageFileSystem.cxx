@@ -0,0 +1,788 @@
+#include <GxBase/Storage/PackageFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/Compression.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+#include "Package.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    namespace
+    {
+        [[nodiscard]] constexpr char ToLowerAscii(char value) noexcept
+        {
+            return (value >= 'A' && value <= 'Z') ? static_cast<char>(value - 'A' + 'a') : value;
+        }
+
+        [[nodiscard]] std::string ToLowerAscii(std::string_view value) noexcept
+        {
+            std::string result{ value };
+
+            for (char& c : result)
+            {
+                c = ToLowerAscii(c);
+            }
+
+            return result;
+        }
+    }
+
+    uint64_t HashPackagePath(
+        std::string_view path) noexcept
+    {
+        std::string const lower = ToLowerAscii(path);
+        return Hash::XXHash64::Hash(lower.data(), lower.size(), PackageHashSeed);
+    }
+
+    bool EqualPackagePath(
+        std::string_view lhs,
+        std::string_view rhs) noexcept
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char l, char r) {
+            return ToLowerAscii(l) == ToLowerAscii(r);
+        });
+    }
+}
+
+namespace Graphyte::Storage::Impl
+{
+    namespace
+    {
+        /// @brief Reads content of package entry.
+        class PackageEntryStream final : public IStream
+        {
+        private:
+            std::shared_ptr<IMappedFile> m_File;
+            std::span<const std::byte> m_Stored;
+            std::span<const uint64_t> m_Blocks;
+            std::vector<std::byte> m_Block;
+            size_t m_BlockIndex;
+            size_t m_BlockSize;
+            int64_t m_Size;
+            int64_t m_Position;
+            Compression::CompressionMethod m_Method;
+
+        public:
+            PackageEntryStream(
+                std::shared_ptr<IMappedFile> file,
+                std::span<const std::byte> stored,
+                std::span<const uint64_t> blocks,
+                const PackageEntry& entry) noexcept
+                : m_File{ std::move(file) }
+                , m_Stored{ stored }
+                , m_Blocks{ blocks }
+                , m_Block{}
+                , m_BlockIndex{ std::numeric_limits<size_t>::max() }
+                , m_BlockSize{ size_t{ 1 } << entry.BlockSizeLog2 }
+                , m_Size{ static_cast<int64_t>(entry.Size) }
+                , m_Position{}
+                , m_Method{ static_cast<Compression::CompressionMethod>(entry.Method) }
+            {
+            }
+
+            virtual ~PackageEntryStream() noexcept = default;
+
+        public:
+            virtual Status Flush() noexcept override
+            {
+                return Status::Success;
+            }
+
+            virtual Status Read(
+                std::span<std::byte> buffer,
+                size_t& processed) noexcept override
+            {
+                processed = 0;
+
+                while (!buffer.empty() && m_Position < m_Size)
+                {
+                    std::span<const std::byte> source{};
+
+                    if (m_Blocks.empty())
+                    {
+                        source = m_Stored.subspan(static_cast<size_t>(m_Position));
+                    }
+                    else
+                    {
+                        size_t const index  = static_cast<size_t>(m_Position) / m_BlockSize;
+                        size_t const offset = static_cast<size_t>(m_Position) % m_BlockSize;
+
+                        if (Status const status = LoadBlock(source, index); status != Status::Success)
+                        {
+                            return status;
+                        }
+
+                        source = source.subspan(offset);
+                    }
+
+                    size_t const count = std::min(source.size(), buffer.size());
+
+                    std::memcpy(buffer.data(), source.data(), count);
+
+                    buffer = buffer.subspan(count);
+                    processed += count;
+                    m_Position += static_cast<int64_t>(count);
+                }
+
+                return buffer.empty() ? Status::Success : Status::EndOfStream;
+            }
+
+            virtual Status Write(
+                [[maybe_unused]] std::span<const std::byte> buffer,
+                size_t& processed) noexcept override
+            {
+                processed = 0;
+                return Status::NotSupported;
+            }
+
+            virtual int64_t GetSize() noexcept override
+            {
+                return m_Size;
+            }
+
+            virtual int64_t GetPosition() noexcept override
+            {
+                return m_Position;
+            }
+
+            virtual Status SetPosition(
+                int64_t value,
+                SeekOrigin origin) noexcept override
+            {
+                switch (origin)
+                {
+                    case SeekOrigin::Begin:
+                        return SetPosition(value);
+
+                    case SeekOrigin::Current:
+                        return SetPosition(m_Position + value);
+
+                    case SeekOrigin::End:
+                        return SetPosition(m_Size + value);
+                }
+
+                return Status::InvalidArgument;
+            }
+
+            virtual Status SetPosition(
+                int64_t value) noexcept override
+            {
+                if (value < 0)
+                {
+                    return Status::InvalidArgument;
+                }
+
+                m_Position = value;
+                return Status::Success;
+            }
+
+        private:
+            Status LoadBlock(std::span<const std::byte>& result, size_t index) noexcept
+            {
+                size_t const decompressed = std::min<size_t>(m_BlockSize, static_cast<size_t>(m_Size) - (index * m_BlockSize));
+                size_t const begin        = (index == 0) ? 0 : static_cast<size_t>(m_Blocks[index - 1] & ~PackageBlockStored);
+                size_t const end          = static_cast<size_t>(m_Blocks[index] & ~PackageBlockStored);
+
+                std::span<const std::byte> const stored = m_Stored.subspan(begin, end - begin);
+
+                if ((m_Blocks[index] & PackageBlockStored) != 0)
+                {
+                    //
+                    // Stored blocks are read directly from mapped package.
+                    //
+
+                    if (stored.size() != decompressed)
+                    {
+                        return Status::InvalidFormat;
+                    }
+
+                    result = stored;
+                    return Status::Success;
+                }
+
+                if (m_BlockIndex != index)
+                {
+                    m_Block.resize(decompressed);
+
+                    if (!Compression::DecompressBlock(m_Method, m_Block.data(), m_Block.size(), stored.data(), stored.size()))
+                    {
+                        m_BlockIndex = std::numeric_limits<size_t>::max();
+                        return Status::InvalidFormat;
+                    }
+
+                    m_BlockIndex = index;
+                }
+
+                result = m_Block;
+                return Status::Success;
+            }
+        };
+
+        /// @brief Represents uncompressed entry mapped in place.
+        class PackageMappedEntry final : public IMappedFile
+        {
+        private:
+            std::shared_ptr<IMappedFile> m_File;
+            std::span<const std::byte> m_View;
+            size_t m_Offset;
+
+        public:
+            PackageMappedEntry(
+                std::shared_ptr<IMappedFile> file,
+                size_t offset,
+                size_t size) noexcept
+                : m_File{ std::move(file) }
+                , m_View{ m_File->GetView().subspan(offset, size) }
+                , m_Offset{ offset }
+            {
+            }
+
+            virtual std::span<const std::byte> GetView() noexcept override
+            {
+                return m_View;
+            }
+
+            virtual void Prefetch(
+                size_t offset,
+                size_t size) noexcept override
+            {
+                if (offset < m_View.size())
+                {
+                    m_File->Prefetch(m_Offset + offset, std::min(size, m_View.size() - offset));
+                }
+            }
+        };
+
+        /// @brief Represents compressed entry decompressed into memory.
+        class PackageBufferedEntry final : public IMappedFile
+        {
+        private:
+            std::vector<std::byte> m_Buffer;
+
+        public:
+            explicit PackageBufferedEntry(
+                std::vector<std::byte> buffer) noexcept
+                : m_Buffer{ std::move(buffer) }
+            {
+            }
+
+            virtual std::span<const std::byte> GetView() noexcept override
+            {
+                return m_Buffer;
+            }
+
+            virtual void Prefetch(
+                [[maybe_unused]] size_t offset,
+                [[maybe_unused]] size_t size) noexcept override
+            {
+            }
+        };
+    }
+}
+
+namespace Graphyte::Storage
+{
+    PackageFileSystem::PackageFileSystem() noexcept = default;
+
+    PackageFileSystem::~PackageFileSystem() noexcept = default;
+
+    Status PackageFileSystem::Open(
+        std::unique_ptr<PackageFileSystem>& result,
+        std::string_view path) noexcept
+    {
+        result = nullptr;
+
+        std::unique_ptr<IMappedFile> file{};
+
+        //
+        // Package is accessed in random order; read ahead is controlled by streams and prefetches.
+        //
+
+        if (Status const status = IFileSystem::GetPlatformNative().OpenMapped(file, path, MappedFileAccess::Random); status != Status::Success)
+        {
+            return status;
+        }
+
+        return Open(result, std::move(file));
+    }
+
+    Status PackageFileSystem::Open(
+        std::unique_ptr<PackageFileSystem>& result,
+        std::unique_ptr<IMappedFile> file) noexcept
+    {
+        result = nullptr;
+
+        auto package = std::make_unique<PackageFileSystem>();
+
+        if (Status const status = package->Load(std::move(file)); status != Status::Success)
+        {
+            return status;
+        }
+
+        result = std::move(package);
+        return Status::Success;
+    }
+
+    Status PackageFileSystem::Load(
+        std::unique_ptr<IMappedFile> file) noexcept
+    {
+        if (file == nullptr)
+        {
+            return Status::InvalidArgument;
+        }
+
+        std::span<const std::byte> const view = file->GetView();
+
+        if (view.size() < Impl::PackageHeaderSize)
+        {
+            return Status::InvalidFormat;
+        }
+
+        Impl::PackageHeader header{};
+        std::memcpy(&header, view.data(), sizeof(header));
+
+        if (header.Signature != Impl::PackageSignature)
+        {
+            return Status::InvalidFormat;
+        }
+
+        if (header.Version != Impl::PackageVersion || header.AlignmentLog2 > Impl::PackageMaxAlignmentLog2)
+        {
+            return Status::NotSupported;
+        }
+
+        uint64_t const entries_size = uint64_t{ header.EntryCount } * Impl::PackageEntrySize;
+        uint64_t const blocks_size  = uint64_t{ header.BlockCount } * Impl::PackageBlockSize;
+
+        if ((header.IndexOffset % alignof(Impl::PackageEntry)) != 0
+            || header.IndexOffset < Impl::PackageHeaderSize
+            || header.IndexOffset > view.size()
+            || header.IndexSize > (view.size() - header.IndexOffset)
+            || header.IndexSize < (entries_size + blocks_size))
+        {
+            return Status::InvalidFormat;
+        }
+
+        std::span<const std::byte> const index = view.subspan(static_cast<size_t>(header.IndexOffset), static_cast<size_t>(header.IndexSize));
+
+        if (Hash::XXHash64::Hash(index.data(), index.size(), Impl::PackageHashSeed) != header.IndexChecksum)
+        {
+            return Status::InvalidFormat;
+        }
+
+        //
+        // Index is aligned in mapped view, so it's used in place.
+        //
+
+        std::span<const Impl::PackageEntry> const entries{
+            reinterpret_cast<const Impl::PackageEntry*>(index.data()),
+            header.EntryCount,
+        };
+
+        std::span<const uint64_t> const blocks{
+            reinterpret_cast<const uint64_t*>(index.data() + entries_size),
+            header.BlockCount,
+        };
+
+        std::string_view const names{
+            reinterpret_cast<const char*>(index.data() + entries_size + blocks_size),
+            static_cast<size_t>(header.IndexSize - entries_size - blocks_size),
+        };
+
+        //
+        // Validate entries once, so lookups and streams may trust them.
+        //
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            Impl::PackageEntry const& entry = entries[i];
+
+            if ((i != 0 && entries[i - 1].PathHash > entry.PathHash)
+                || entry.Offset > header.IndexOffset
+                || entry.StoredSize > (header.IndexOffset - entry.Offset)
+                || entry.NameOffset > names.size()
+                || entry.NameLength > (names.size() - entry.NameOffset)
+                || entry.FirstBlock > blocks.size()
+                || entry.BlockCount > (blocks.size() - entry.FirstBlock))
+            {
+                return Status::InvalidFormat;
+            }
+
+            if (entry.BlockCount == 0)
+            {
+                if (entry.StoredSize != entry.Size)
+                {
+                    return Status::InvalidFormat;
+                }
+            }
+            else
+            {
+                if (entry.BlockSizeLog2 < Impl::PackageMinBlockSizeLog2 || entry.BlockSizeLog2 > Impl::PackageMaxBlockSizeLog2)
+                {
+                    return Status::InvalidFormat;
+                }
+
+                if (Compression::MemoryBound(static_cast<Compression::CompressionMethod>(entry.Method), 0) == 0)
+                {
+                    return Status::NotSupported;
+                }
+
+                uint64_t const block_size = uint64_t{ 1 } << entry.BlockSizeLog2;
+
+                if (((entry.Size + block_size - 1) / block_size) != entry.BlockCount)
+                {
+                    return Status::InvalidFormat;
+                }
+
+                uint64_t previous = 0;
+
+                for (uint64_t const block : blocks.subspan(entry.FirstBlock, entry.BlockCount))
+                {
+                    uint64_t const end = block & ~Impl::PackageBlockStored;
+
+                    if (end < previous)
+                    {
+                        return Status::InvalidFormat;
+                    }
+
+                    previous = end;
+                }
+
+                if (previous != entry.StoredSize)
+                {
+                    return Status::InvalidFormat;
+                }
+            }
+        }
+
+        m_File      = std::move(file);
+        m_Entries   = entries;
+        m_Blocks    = blocks;
+        m_Names     = names;
+        m_Timestamp = DateTime{ header.Timestamp };
+
+        //
+        // Build directory tree. Directory paths are prefixes of entry names, so children reference
+        // names table directly.
+        //
+
+        m_Directories.clear();
+        m_Directories.try_emplace(std::string{});
+
+        for (Impl::PackageEntry const& entry : m_Entries)
+        {
+            std::string_view const name = GetName(entry);
+
+            std::string parent{};
+
+            for (size_t separator = name.find(DirectorySeparator); separator != std::string_view::npos; separator = name.find(DirectorySeparator, separator + 1))
+            {
+                std::string_view const directory = name.substr(0, separator);
+                std::string key                  = Impl::ToLowerAscii(directory);
+
+                if (m_Directories.try_emplace(key).second)
+                {
+                    m_Directories[parent].push_back(DirectoryChild{ directory, true });
+                }
+
+                parent = std::move(key);
+            }
+
+            m_Directories[parent].push_back(DirectoryChild{ name, false });
+        }
+
+        return Status::Success;
+    }
+
+    const Impl::PackageEntry* PackageFileSystem::FindEntry(
+        std::string_view path) const noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return nullptr;
+        }
+
+        uint64_t const hash = Impl::HashPackagePath(normalized);
+
+        auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), hash, [](const Impl::PackageEntry& entry, uint64_t value) {
+            return entry.PathHash < value;
+        });
+
+        for (; it != m_Entries.end() && it->PathHash == hash; ++it)
+        {
+            if (Impl::EqualPackagePath(GetName(*it), normalized))
+            {
+                return &(*it);
+            }
+        }
+
+        return nullptr;
+    }
+
+    const std::vector<PackageFileSystem::DirectoryChild>* PackageFileSystem::FindDirectory(
+        std::string_view path) const noexcept
+    {
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return nullptr;
+        }
+
+        if (auto const it = m_Directories.find(Impl::ToLowerAscii(normalized)); it != m_Directories.end())
+        {
+            return &it->second;
+        }
+
+        return nullptr;
+    }
+
+    std::string_view PackageFileSystem::GetName(
+        const Impl::PackageEntry& entry) const noexcept
+    {
+        return m_Names.substr(entry.NameOffset, entry.NameLength);
+    }
+
+    std::span<const std::byte> PackageFileSystem::GetStoredContent(
+        const Impl::PackageEntry& entry) const noexcept
+    {
+        return m_File->GetView().subspan(static_cast<size_t>(entry.Offset), static_cast<size_t>(entry.StoredSize));
+    }
+
+    Status PackageFileSystem::OpenRead(
+        std::unique_ptr<IStream>& result,
+        std::string_view path,
+        [[maybe_unused]] bool share) noexcept
+    {
+        result = nullptr;
+
+        Impl::PackageEntry const* const entry = FindEntry(path);
+
+        if (entry == nullptr)
+        {
+            return Status::NotFound;
+        }
+
+        result = std::make_unique<Impl::PackageEntryStream>(
+            m_File,
+            GetStoredContent(*entry),
+            m_Blocks.subspan(entry->FirstBlock, entry->BlockCount),
+            *entry);
+
+        return Status::Success;
+    }
+
+    Status PackageFileSystem::OpenWrite(
+        std::unique_ptr<IStream>& result,
+        [[maybe_unused]] std::string_view path,
+        [[maybe_unused]] bool append,
+        [[maybe_unused]] bool share) noexcept
+    {
+        result = nullptr;
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        MappedFileAccess access) noexcept
+    {
+        result = nullptr;
+
+        Impl::PackageEntry const* const entry = FindEntry(path);
+
+        if (entry == nullptr)
+        {
+            return Status::NotFound;
+        }
+
+        if (entry->BlockCount == 0)
+        {
+            auto mapped = std::make_unique<Impl::PackageMappedEntry>(m_File, static_cast<size_t>(entry->Offset), static_cast<size_t>(entry->Size));
+
+            if (access == MappedFileAccess::Sequential)
+            {
+                mapped->Prefetch(0, static_cast<size_t>(entry->Size));
+            }
+
+            result = std::move(mapped);
+            return Status::Success;
+        }
+
+        std::vector<std::byte> buffer(static_cast<size_t>(entry->Size));
+
+        Impl::PackageEntryStream stream{
+            m_File,
+            GetStoredContent(*entry),
+            m_Blocks.subspan(entry->FirstBlock, entry->BlockCount),
+            *entry,
+        };
+
+        size_t processed{};
+
+        if (Status const status = stream.Read(buffer, processed); status != Status::Success && !buffer.empty())
+        {
+            return status;
+        }
+
+        result = std::make_unique<Impl::PackageBufferedEntry>(std::move(buffer));
+        return Status::Success;
+    }
+
+    Status PackageFileSystem::IsReadonly(
+        bool& result,
+        std::string_view path) noexcept
+    {
+        result = true;
+        return Exists(path);
+    }
+
+    Status PackageFileSystem::SetReadonly(
+        [[maybe_unused]] std::string_view path,
+        [[maybe_unused]] bool value) noexcept
+    {
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::GetFileInfo(
+        FileInfo& result,
+        std::string_view path) noexcept
+    {
+        result = FileInfo{
+            .CreationTime     = m_Timestamp,
+            .AccessTime       = m_Timestamp,
+            .ModificationTime = m_Timestamp,
+            .FileSize         = 0,
+            .IsDirectory      = false,
+            .IsReadonly       = true,
+            .IsValid          = false,
+        };
+
+        if (Impl::PackageEntry const* const entry = FindEntry(path); entry != nullptr)
+        {
+            result.FileSize = static_cast<int64_t>(entry->Size);
+            result.IsValid  = true;
+            return Status::Success;
+        }
+
+        if (FindDirectory(path) != nullptr)
+        {
+            result.IsDirectory = true;
+            result.IsValid     = true;
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status PackageFileSystem::GetFileSize(
+        int64_t& result,
+        std::string_view path) noexcept
+    {
+        if (Impl::PackageEntry const* const entry = FindEntry(path); entry != nullptr)
+        {
+            result = static_cast<int64_t>(entry->Size);
+            return Status::Success;
+        }
+
+        result = -1;
+        return Status::NotFound;
+    }
+
+    Status PackageFileSystem::Exists(
+        std::string_view path) noexcept
+    {
+        if (FindEntry(path) != nullptr || FindDirectory(path) != nullptr)
+        {
+            return Status::Success;
+        }
+
+        return Status::NotFound;
+    }
+
+    Status PackageFileSystem::FileCopy(
+        [[maybe_unused]] std::string_view destination,
+        [[maybe_unused]] std::string_view source) noexcept
+    {
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::FileMove(
+        [[maybe_unused]] std::string_view destination,
+        [[maybe_unused]] std::string_view source) noexcept
+    {
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::FileDelete(
+        [[maybe_unused]] std::string_view path) noexcept
+    {
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::DirectoryCreate(
+        [[maybe_unused]] std::string_view path) noexcept
+    {
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::DirectoryDelete(
+        [[maybe_unused]] std::string_view path) noexcept
+    {
+        return Status::AccessDenied;
+    }
+
+    Status PackageFileSystem::Enumerate(
+        std::string_view path,
+        IDirectoryVisitor& visitor) noexcept
+    {
+        auto const* const children = FindDirectory(path);
+
+        if (children == nullptr)
+        {
+            return Status::NotFound;
+        }
+
+        for (DirectoryChild const& child : *children)
+        {
+            if (Status const status = visitor.Visit(child.Path, child.IsDirectory); status != Status::Success)
+            {
+                return Status::Failure;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    Status PackageFileSystem::Enumerate(
+        std::string_view path,
+        IDirectoryInfoVisitor& visitor) noexcept
+    {
+        auto const* const children = FindDirectory(path);
+
+        if (children == nullptr)
+        {
+            return Status::NotFound;
+        }
+
+        for (DirectoryChild const& child : *children)
+        {
+            FileInfo info{};
+
+            if (Status const status = GetFileInfo(info, child.Path); status != Status::Success)
+            {
+                return status;
+            }
+
+            if (Status const status = visitor.Visit(child.Path, info); status != Status::Success)
+            {
+                return Status::Failure;
+            }
+        }
+
+        return Status::Success;
+    }
+}
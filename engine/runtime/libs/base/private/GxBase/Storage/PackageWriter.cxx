@@ -0,0 +1,388 @@
+#include <GxBase/Storage/PackageWriter.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+#include "Package.Impl.hxx"
+
+namespace Graphyte::Storage
+{
+    PackageWriter::PackageWriter(
+        std::unique_ptr<IStream> stream,
+        const PackageWriterOptions& options) noexcept
+        : m_Stream{ std::move(stream) }
+        , m_Options{ options }
+        , m_Entries{}
+        , m_Blocks{}
+        , m_Names{}
+        , m_Paths{}
+        , m_Position{}
+        , m_AlignmentLog2{}
+        , m_BlockSizeLog2{}
+        , m_Status{ Status::Success }
+        , m_Finished{ false }
+    {
+        GX_ASSERT(m_Stream != nullptr);
+        GX_ASSERT(std::has_single_bit(options.Alignment));
+
+        m_AlignmentLog2 = std::min<uint32_t>(
+            static_cast<uint32_t>(std::countr_zero(std::max<uint32_t>(options.Alignment, 1))),
+            Impl::PackageMaxAlignmentLog2);
+
+        m_BlockSizeLog2 = std::clamp<uint32_t>(
+            static_cast<uint32_t>(std::bit_width(std::max<size_t>(options.BlockSize, 1) - 1)),
+            Impl::PackageMinBlockSizeLog2,
+            Impl::PackageMaxBlockSizeLog2);
+
+        //
+        // Header is written by Finish, after index location is known.
+        //
+
+        std::array<std::byte, Impl::PackageHeaderSize> const header{};
+        WriteOutput(header);
+    }
+
+    PackageWriter::~PackageWriter() noexcept
+    {
+        if (!m_Finished)
+        {
+            (void)Finish();
+        }
+    }
+
+    Status PackageWriter::Create(
+        std::unique_ptr<PackageWriter>& result,
+        std::string_view path,
+        const PackageWriterOptions& options) noexcept
+    {
+        result = nullptr;
+
+        std::unique_ptr<IStream> stream{};
+
+        if (Status const status = IFileSystem::GetPlatformNative().OpenWrite(stream, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        result = std::make_unique<PackageWriter>(std::move(stream), options);
+        return result->GetStatus();
+    }
+
+    Status PackageWriter::Add(
+        std::string_view path,
+        std::span<const std::byte> content,
+        std::optional<Compression::CompressionMethod> method) noexcept
+    {
+        if (m_Status != Status::Success)
+        {
+            return m_Status;
+        }
+
+        if (m_Finished)
+        {
+            return Status::InvalidArgument;
+        }
+
+        if (method.has_value() && !Compression::IsSupported(*method))
+        {
+            //
+            // Entry would be silently stored uncompressed.
+            //
+
+            return Status::NotSupported;
+        }
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, path) || normalized.empty() || normalized.size() > std::numeric_limits<uint16_t>::max())
+        {
+            return Status::InvalidPath;
+        }
+
+        std::string key{ normalized };
+        std::transform(key.begin(), key.end(), key.begin(), [](char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        });
+
+        if (!m_Paths.insert(std::move(key)).second)
+        {
+            return Status::AlreadyExists;
+        }
+
+        Impl::PackageEntry entry{
+            .PathHash      = Impl::HashPackagePath(normalized),
+            .Offset        = 0,
+            .Size          = content.size(),
+            .StoredSize    = content.size(),
+            .FirstBlock    = static_cast<uint32_t>(m_Blocks.size()),
+            .BlockCount    = 0,
+            .NameOffset    = static_cast<uint32_t>(m_Names.size()),
+            .NameLength    = static_cast<uint16_t>(normalized.size()),
+            .Method        = 0,
+            .BlockSizeLog2 = 0,
+        };
+
+        if (method.has_value() && !content.empty())
+        {
+            //
+            // Blocks are compressed independently, so readers may decompress any of them without
+            // preceding ones.
+            //
+
+            size_t const block_size  = size_t{ 1 } << m_BlockSizeLog2;
+            size_t const block_count = (content.size() + block_size - 1) / block_size;
+
+            std::vector<std::vector<std::byte>> blocks(block_count);
+
+            Threading::ParallelForRange(
+                0,
+                block_count,
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        std::span<const std::byte> const input = content.subspan(i * block_size, std::min(block_size, content.size() - (i * block_size)));
+
+                        std::vector<std::byte>& output = blocks[i];
+                        output.resize(Compression::MemoryBound(*method, input.size()));
+
+                        size_t size = output.size();
+
+                        if (Compression::CompressBlock(*method, m_Options.Parameters, output.data(), size, input.data(), input.size()) && size < input.size())
+                        {
+                            output.resize(size);
+                        }
+                        else
+                        {
+                            //
+                            // Incompressible block is stored as is.
+                            //
+
+                            output.clear();
+                        }
+                    }
+                },
+                1);
+
+            size_t stored_size = 0;
+
+            for (size_t i = 0; i < block_count; ++i)
+            {
+                stored_size += blocks[i].empty()
+                                   ? std::min(block_size, content.size() - (i * block_size))
+                                   : blocks[i].size();
+            }
+
+            if (stored_size < content.size())
+            {
+                WritePadding(alignof(uint64_t));
+
+                entry.Offset        = m_Position;
+                entry.StoredSize    = stored_size;
+                entry.BlockCount    = static_cast<uint32_t>(block_count);
+                entry.Method        = static_cast<uint8_t>(*method);
+                entry.BlockSizeLog2 = static_cast<uint8_t>(m_BlockSizeLog2);
+
+                uint64_t end = 0;
+
+                for (size_t i = 0; i < block_count; ++i)
+                {
+                    if (blocks[i].empty())
+                    {
+                        std::span<const std::byte> const input = content.subspan(i * block_size, std::min(block_size, content.size() - (i * block_size)));
+
+                        WriteOutput(input);
+                        end += input.size();
+                        m_Blocks.push_back(end | Impl::PackageBlockStored);
+                    }
+                    else
+                    {
+                        WriteOutput(blocks[i]);
+                        end += blocks[i].size();
+                        m_Blocks.push_back(end);
+                    }
+                }
+            }
+        }
+
+        if (entry.BlockCount == 0)
+        {
+            //
+            // Uncompressed entries are aligned, so they may be mapped in place.
+            //
+
+            WritePadding(uint64_t{ 1 } << m_AlignmentLog2);
+
+            entry.Offset = m_Position;
+            WriteOutput(content);
+        }
+
+        m_Names.append(normalized);
+        m_Entries.push_back(entry);
+
+        return m_Status;
+    }
+
+    Status PackageWriter::AddFile(
+        std::string_view path,
+        std::string_view source,
+        std::optional<Compression::CompressionMethod> method) noexcept
+    {
+        std::vector<std::byte> content{};
+
+        if (Status const status = Storage::ReadBinary(content, source); status != Status::Success)
+        {
+            return status;
+        }
+
+        return Add(path, content, method);
+    }
+
+    size_t PackageWriter::GetEntryCount() const noexcept
+    {
+        return m_Entries.size();
+    }
+
+    Status PackageWriter::Finish() noexcept
+    {
+        if (m_Finished)
+        {
+            return m_Status;
+        }
+
+        m_Finished = true;
+
+        if (m_Status != Status::Success)
+        {
+            return m_Status;
+        }
+
+        if (m_Entries.size() > std::numeric_limits<uint32_t>::max()
+            || m_Blocks.size() > std::numeric_limits<uint32_t>::max()
+            || m_Names.size() > std::numeric_limits<uint32_t>::max())
+        {
+            m_Status = Status::NotSupported;
+            return m_Status;
+        }
+
+        //
+        // Index is sorted by path hash. Entries with same hash are ordered by name, so output does
+        // not depend on order of addition.
+        //
+
+        std::sort(m_Entries.begin(), m_Entries.end(), [&](const Impl::PackageEntry& lhs, const Impl::PackageEntry& rhs) {
+            if (lhs.PathHash != rhs.PathHash)
+            {
+                return lhs.PathHash < rhs.PathHash;
+            }
+
+            return std::string_view{ m_Names }.substr(lhs.NameOffset, lhs.NameLength) < std::string_view{ m_Names }.substr(rhs.NameOffset, rhs.NameLength);
+        });
+
+        WritePadding(alignof(Impl::PackageEntry));
+
+        std::vector<std::byte> index(
+            (m_Entries.size() * Impl::PackageEntrySize)
+            + (m_Blocks.size() * Impl::PackageBlockSize)
+            + m_Names.size());
+
+        std::byte* it = index.data();
+
+        if (!m_Entries.empty())
+        {
+            std::memcpy(it, m_Entries.data(), m_Entries.size() * Impl::PackageEntrySize);
+            it += m_Entries.size() * Impl::PackageEntrySize;
+        }
+
+        if (!m_Blocks.empty())
+        {
+            std::memcpy(it, m_Blocks.data(), m_Blocks.size() * Impl::PackageBlockSize);
+            it += m_Blocks.size() * Impl::PackageBlockSize;
+        }
+
+        if (!m_Names.empty())
+        {
+            std::memcpy(it, m_Names.data(), m_Names.size());
+        }
+
+        Impl::PackageHeader const header{
+            .Signature     = Impl::PackageSignature,
+            .Version       = Impl::PackageVersion,
+            .AlignmentLog2 = static_cast<uint8_t>(m_AlignmentLog2),
+            .Reserved0     = 0,
+            .EntryCount    = static_cast<uint32_t>(m_Entries.size()),
+            .BlockCount    = static_cast<uint32_t>(m_Blocks.size()),
+            .IndexOffset   = m_Position,
+            .IndexSize     = index.size(),
+            .Timestamp     = DateTime::Now().Value,
+            .IndexChecksum = Hash::XXHash64::Hash(index.data(), index.size(), Impl::PackageHashSeed),
+            .Reserved1     = 0,
+            .Reserved2     = 0,
+        };
+
+        WriteOutput(index);
+
+        if (m_Status == Status::Success)
+        {
+            if (Status const status = m_Stream->SetPosition(0); status != Status::Success)
+            {
+                m_Status = status;
+                return m_Status;
+            }
+
+            std::array<std::byte, Impl::PackageHeaderSize> encoded{};
+            std::memcpy(encoded.data(), &header, sizeof(header));
+
+            size_t processed{};
+
+            if (Status const status = m_Stream->Write(encoded, processed); status != Status::Success)
+            {
+                m_Status = status;
+            }
+            else if (Status const flushed = m_Stream->Flush(); flushed != Status::Success)
+            {
+                m_Status = flushed;
+            }
+        }
+
+        return m_Status;
+    }
+
+    void PackageWriter::WriteOutput(
+        std::span<const std::byte> buffer) noexcept
+    {
+        if (m_Status != Status::Success || buffer.empty())
+        {
+            return;
+        }
+
+        size_t processed{};
+
+        if (Status const status = m_Stream->Write(buffer, processed); status != Status::Success)
+        {
+            m_Status = status;
+        }
+        else if (processed != buffer.size())
+        {
+            m_Status = Status::WriteFault;
+        }
+
+        m_Position += processed;
+    }
+
+    void PackageWriter::WritePadding(
+        uint64_t alignment) noexcept
+    {
+        static constexpr std::array<std::byte, 4096> const zeros{};
+
+        uint64_t padding = (alignment - (m_Position % alignment)) % alignment;
+
+        while (padding != 0)
+        {
+            size_t const count = static_cast<size_t>(std::min<uint64_t>(padding, zeros.size()));
+            WriteOutput({ zeros.data(), count });
+            padding -= count;
+        }
+    }
+}
@@ -0,0 +1,464 @@
+#include <GxBase/Storage/VersionedArchive.hxx>
+#include <GxBase/Bitwise.hxx>
+
+// =================================================================================================
+//
+// Versioned archive format.
+//
+// Layout:
+//
+//  stream:  signature (u32), format version (u32), root value
+//
+//  object:  version (u32), size of fields (u32), fields
+//
+//  field:   tag (u32), size of payload (u32), payload
+//
+//  Payload of trivially copyable value or vector of them is raw memory of elements. Strings are
+//  stored without terminator. Vectors of other types are stored as element count (u32) followed
+//  by sequence of fields with zero tag.
+//
+//  Stream is written in host byte order. Reader detects byte order from signature and swaps
+//  scalars when needed.
+//
+
+namespace Graphyte::Storage::Impl
+{
+    constexpr const uint32_t VersionedArchiveSignature = 0x53565847;
+    constexpr const uint32_t VersionedArchiveFormat    = 1;
+
+    constexpr const size_t VersionedArchiveHeaderSize = 8;
+
+    namespace
+    {
+        template <typename T>
+        void ByteSwapScalars(
+            std::byte* data,
+            size_t count) noexcept
+        {
+            size_t i = 0;
+
+#if GX_HW_AVX2 || GX_HW_AVX
+
+            //
+            // Shuffle reverses bytes within each lane of given width.
+            //
+
+            alignas(16) std::array<uint8_t, 16> mask{};
+
+            for (size_t j = 0; j < mask.size(); ++j)
+            {
+                mask[j] = static_cast<uint8_t>((j - (j % sizeof(T))) + (sizeof(T) - 1 - (j % sizeof(T))));
+            }
+
+            __m128i const mask128 = _mm_load_si128(reinterpret_cast<const __m128i*>(mask.data()));
+
+#if GX_HW_AVX2
+            __m256i const mask256 = _mm256_broadcastsi128_si256(mask128);
+
+            for (; (i + (32 / sizeof(T))) <= count; i += (32 / sizeof(T)))
+            {
+                __m256i* const address = reinterpret_cast<__m256i*>(data + (i * sizeof(T)));
+                _mm256_storeu_si256(address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), mask256));
+            }
+#endif
+
+            for (; (i + (16 / sizeof(T))) <= count; i += (16 / sizeof(T)))
+            {
+                __m128i* const address = reinterpret_cast<__m128i*>(data + (i * sizeof(T)));
+                _mm_storeu_si128(address, _mm_shuffle_epi8(_mm_loadu_si128(address), mask128));
+            }
+
+#elif GX_HW_NEON
+
+            for (; (i + (16 / sizeof(T))) <= count; i += (16 / sizeof(T)))
+            {
+                uint8_t* const address = reinterpret_cast<uint8_t*>(data + (i * sizeof(T)));
+                uint8x16_t const value = vld1q_u8(address);
+
+                if constexpr (sizeof(T) == 2)
+                {
+                    vst1q_u8(address, vrev16q_u8(value));
+                }
+                else if constexpr (sizeof(T) == 4)
+                {
+                    vst1q_u8(address, vrev32q_u8(value));
+                }
+                else
+                {
+                    vst1q_u8(address, vrev64q_u8(value));
+                }
+            }
+
+#endif
+
+            for (; i < count; ++i)
+            {
+                T value;
+                std::memcpy(&value, data + (i * sizeof(T)), sizeof(T));
+                value = ByteSwap<T>(value);
+                std::memcpy(data + (i * sizeof(T)), &value, sizeof(T));
+            }
+        }
+    }
+
+    void ByteSwapBuffer(
+        void* buffer,
+        size_t count,
+        size_t scalar_size) noexcept
+    {
+        std::byte* const data = static_cast<std::byte*>(buffer);
+
+        switch (scalar_size)
+        {
+            case 2:
+                ByteSwapScalars<uint16_t>(data, count);
+                break;
+
+            case 4:
+                ByteSwapScalars<uint32_t>(data, count);
+                break;
+
+            case 8:
+                ByteSwapScalars<uint64_t>(data, count);
+                break;
+
+            default:
+                GX_ASSERT(scalar_size == 1);
+                break;
+        }
+    }
+}
+
+namespace Graphyte::Storage
+{
+    VersionedArchive::VersionedArchive(
+        std::vector<std::byte>&& output) noexcept
+        : m_Output{ std::move(output) }
+        , m_Input{}
+        , m_Fields{}
+        , m_Scopes{}
+        , m_Position{}
+        , m_Status{ Status::Success }
+        , m_IsLoading{ false }
+        , m_SwapBytes{ false }
+    {
+        m_Output.clear();
+
+        WriteUInt32(Impl::VersionedArchiveSignature);
+        WriteUInt32(Impl::VersionedArchiveFormat);
+    }
+
+    VersionedArchive::VersionedArchive(
+        std::span<const std::byte> input) noexcept
+        : m_Output{}
+        , m_Input{ input }
+        , m_Fields{}
+        , m_Scopes{}
+        , m_Position{}
+        , m_Status{ Status::Success }
+        , m_IsLoading{ true }
+        , m_SwapBytes{ false }
+    {
+        uint32_t const signature = ReadUInt32();
+
+        if (signature == ByteSwap(Impl::VersionedArchiveSignature))
+        {
+            m_SwapBytes = true;
+        }
+        else if (signature != Impl::VersionedArchiveSignature)
+        {
+            m_Status = Status::InvalidFormat;
+        }
+
+        if (ReadUInt32() != Impl::VersionedArchiveFormat)
+        {
+            m_Status = Status::InvalidFormat;
+        }
+    }
+
+    VersionedArchive::~VersionedArchive() noexcept = default;
+
+    uint32_t VersionedArchive::Version(
+        uint32_t current) noexcept
+    {
+        if (m_Scopes.empty())
+        {
+            return current;
+        }
+
+        Scope& scope = m_Scopes.back();
+
+        if (!m_IsLoading)
+        {
+            scope.Version = current;
+        }
+
+        return scope.Version;
+    }
+
+    void VersionedArchive::ProcessBulk(
+        void* data,
+        size_t count,
+        size_t element_size,
+        size_t scalar_size,
+        size_t size) noexcept
+    {
+        if (m_Status != Status::Success)
+        {
+            return;
+        }
+
+        size_t const bytes = count * element_size;
+
+        if (!m_IsLoading)
+        {
+            if (bytes != 0)
+            {
+                std::byte const* const first = static_cast<const std::byte*>(data);
+                m_Output.insert(m_Output.end(), first, first + bytes);
+            }
+
+            return;
+        }
+
+        if (bytes != size || size > (m_Input.size() - m_Position))
+        {
+            m_Status = Status::InvalidFormat;
+            return;
+        }
+
+        if (bytes != 0)
+        {
+            std::memcpy(data, m_Input.data() + m_Position, bytes);
+
+            if (m_SwapBytes && scalar_size > 1)
+            {
+                Impl::ByteSwapBuffer(data, bytes / scalar_size, scalar_size);
+            }
+        }
+
+        m_Position += bytes;
+    }
+
+    size_t VersionedArchive::BeginField(
+        uint32_t tag) noexcept
+    {
+        size_t const header = m_Output.size();
+
+        WriteUInt32(tag);
+        WriteUInt32(0);
+
+        return header;
+    }
+
+    void VersionedArchive::EndField(
+        size_t header) noexcept
+    {
+        size_t const size = m_Output.size() - header - Impl::VersionedArchiveHeaderSize;
+
+        if (size > std::numeric_limits<uint32_t>::max())
+        {
+            m_Status = Status::NotSupported;
+            return;
+        }
+
+        uint32_t const encoded = static_cast<uint32_t>(size);
+        std::memcpy(m_Output.data() + header + sizeof(uint32_t), &encoded, sizeof(encoded));
+    }
+
+    bool VersionedArchive::FindField(
+        uint32_t tag,
+        size_t& size) noexcept
+    {
+        if (m_Scopes.empty())
+        {
+            m_Status = Status::InvalidArgument;
+            return false;
+        }
+
+        Scope const& scope = m_Scopes.back();
+
+        for (size_t i = scope.FirstField; i < m_Fields.size(); ++i)
+        {
+            if (m_Fields[i].Tag == tag)
+            {
+                m_Position = m_Fields[i].Offset;
+                size       = m_Fields[i].Size;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool VersionedArchive::NextElement(
+        size_t end,
+        size_t& size) noexcept
+    {
+        if ((end - m_Position) < Impl::VersionedArchiveHeaderSize)
+        {
+            m_Status = Status::InvalidFormat;
+            return false;
+        }
+
+        [[maybe_unused]] uint32_t const tag = ReadUInt32();
+        size                                = ReadUInt32();
+
+        if (size > (end - m_Position))
+        {
+            m_Status = Status::InvalidFormat;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool VersionedArchive::BeginObject(
+        size_t size) noexcept
+    {
+        if (m_Status != Status::Success)
+        {
+            return false;
+        }
+
+        if (!m_IsLoading)
+        {
+            m_Scopes.push_back(Scope{
+                .Start      = m_Output.size(),
+                .End        = 0,
+                .FirstField = 0,
+                .Version    = 0,
+            });
+
+            WriteUInt32(0);
+            WriteUInt32(0);
+
+            return true;
+        }
+
+        if (size < Impl::VersionedArchiveHeaderSize || size > (m_Input.size() - m_Position))
+        {
+            m_Status = Status::InvalidFormat;
+            return false;
+        }
+
+        size_t const start     = m_Position;
+        uint32_t const version = ReadUInt32();
+        size_t const body      = ReadUInt32();
+
+        if (body > (size - Impl::VersionedArchiveHeaderSize))
+        {
+            m_Status = Status::InvalidFormat;
+            return false;
+        }
+
+        size_t const end = m_Position + body;
+
+        //
+        // Index fields, so they may be read in any order and unknown ones are skipped.
+        //
+
+        size_t const first_field = m_Fields.size();
+
+        while (m_Position < end)
+        {
+            if ((end - m_Position) < Impl::VersionedArchiveHeaderSize)
+            {
+                m_Status = Status::InvalidFormat;
+                return false;
+            }
+
+            uint32_t const tag        = ReadUInt32();
+            uint32_t const field_size = ReadUInt32();
+
+            if (field_size > (end - m_Position))
+            {
+                m_Status = Status::InvalidFormat;
+                return false;
+            }
+
+            m_Fields.push_back(FieldEntry{
+                .Tag    = tag,
+                .Size   = field_size,
+                .Offset = m_Position,
+            });
+
+            m_Position += field_size;
+        }
+
+        m_Scopes.push_back(Scope{
+            .Start      = start,
+            .End        = end,
+            .FirstField = first_field,
+            .Version    = version,
+        });
+
+        return true;
+    }
+
+    void VersionedArchive::EndObject() noexcept
+    {
+        GX_ASSERT(!m_Scopes.empty());
+
+        Scope const scope = m_Scopes.back();
+        m_Scopes.pop_back();
+
+        if (m_IsLoading)
+        {
+            m_Position = scope.End;
+            m_Fields.resize(scope.FirstField);
+            return;
+        }
+
+        size_t const size = m_Output.size() - scope.Start - Impl::VersionedArchiveHeaderSize;
+
+        if (size > std::numeric_limits<uint32_t>::max())
+        {
+            m_Status = Status::NotSupported;
+            return;
+        }
+
+        uint32_t const header[2]{ scope.Version, static_cast<uint32_t>(size) };
+        std::memcpy(m_Output.data() + scope.Start, header, sizeof(header));
+    }
+
+    Status VersionedArchive::FinishSave(
+        std::vector<std::byte>& result) noexcept
+    {
+        GX_ASSERT(m_Scopes.empty());
+
+        if (m_Status == Status::Success)
+        {
+            result = std::move(m_Output);
+        }
+        else
+        {
+            result.clear();
+        }
+
+        return m_Status;
+    }
+
+    void VersionedArchive::WriteUInt32(
+        uint32_t value) noexcept
+    {
+        std::byte const* const first = reinterpret_cast<const std::byte*>(&value);
+        m_Output.insert(m_Output.end(), first, first + sizeof(value));
+    }
+
+    uint32_t VersionedArchive::ReadUInt32() noexcept
+    {
+        uint32_t value{};
+
+        if ((m_Input.size() - m_Position) < sizeof(value))
+        {
+            m_Status = Status::InvalidFormat;
+            return value;
+        }
+
+        std::memcpy(&value, m_Input.data() + m_Position, sizeof(value));
+        m_Position += sizeof(value);
+
+        return m_SwapBytes ? ByteSwap(value) : value;
+    }
+}
@@ -0,0 +1,862 @@
+#include <GxBase/Storage/VirtualFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+#include "VirtualPath.Impl.hxx"
+
+namespace Graphyte::Storage::Impl
+{
+    bool NormalizeVirtualPath(
+        std::string& result,
+        std::string_view path) noexcept
+    {
+        result.clear();
+        result.reserve(path.size());
+
+        while (!path.empty())
+        {
+            size_t const separator = std::find_if(path.begin(), path.end(), Storage::IsDirectorySeparator) - path.begin();
+
+            std::string_view const component = path.substr(0, separator);
+
+            path.remove_prefix(std::min(separator + 1, path.size()));
+
+            if (component.empty() || component == ".")
+            {
+                continue;
+            }
+
+            if (component == "..")
+            {
+                return false;
+            }
+
+            if (!result.empty())
+            {
+                result.push_back(Storage::DirectorySeparator);
+            }
+
+            result.append(component);
+        }
+
+        return true;
+    }
+
+    bool IsVirtualPathWithin(
+        std::string_view path,
+        std::string_view directory,
+        std::string_view& remainder) noexcept
+    {
+        if (directory.empty())
+        {
+            remainder = path;
+            return true;
+        }
+
+        if (!path.starts_with(directory))
+        {
+            return false;
+        }
+
+        if (path.size() == directory.size())
+        {
+            remainder = {};
+            return true;
+        }
+
+        if (path[directory.size()] == Storage::DirectorySeparator)
+        {
+            remainder = path.substr(directory.size() + 1);
+            return true;
+        }
+
+        return false;
+    }
+
+    namespace
+    {
+        //
+        // Marks cached path which was not found in any mount.
+        //
+
+        constexpr const uint32_t UnresolvedMount = std::numeric_limits<uint32_t>::max();
+
+        //
+        // Cache is discarded when it grows above this limit, so lookups of many distinct missing
+        // paths do not grow it indefinitely.
+        //
+
+        constexpr const size_t MaxCacheSize = 64 << 10;
+
+        std::string_view GetFirstComponent(
+            std::string_view path) noexcept
+        {
+            return path.substr(0, path.find(Storage::DirectorySeparator));
+        }
+
+        class ChildrenVisitor final : public IDirectoryVisitor
+        {
+        private:
+            std::map<std::string, FileInfo, std::less<>>& m_Children;
+            FileInfo m_Info;
+
+        public:
+            ChildrenVisitor(
+                std::map<std::string, FileInfo, std::less<>>& children,
+                const FileInfo& info) noexcept
+                : m_Children{ children }
+                , m_Info{ info }
+            {
+            }
+
+            virtual Status Visit(
+                std::string_view path,
+                bool is_directory) noexcept override
+            {
+                FileInfo info = m_Info;
+                info.IsDirectory = is_directory;
+
+                m_Children.try_emplace(std::string{ Storage::GetFilename(path) }, info);
+                return Status::Success;
+            }
+        };
+
+        class ChildrenInfoVisitor final : public IDirectoryInfoVisitor
+        {
+        private:
+            std::map<std::string, FileInfo, std::less<>>& m_Children;
+            bool m_Readonly;
+
+        public:
+            ChildrenInfoVisitor(
+                std::map<std::string, FileInfo, std::less<>>& children,
+                bool readonly) noexcept
+                : m_Children{ children }
+                , m_Readonly{ readonly }
+            {
+            }
+
+            virtual Status Visit(
+                std::string_view path,
+                const FileInfo& info) noexcept override
+            {
+                auto const [it, inserted] = m_Children.try_emplace(std::string{ Storage::GetFilename(path) }, info);
+
+                if (inserted && m_Readonly)
+                {
+                    it->second.IsReadonly = true;
+                }
+
+                return Status::Success;
+            }
+        };
+    }
+}
+
+namespace Graphyte::Storage
+{
+    VirtualFileSystem::VirtualFileSystem() noexcept
+        : m_Lock{}
+        , m_Mounts{}
+        , m_Cache{}
+        , m_Generation{}
+        , m_NextId{ 1 }
+        , m_CreationTime{ DateTime::Now() }
+    {
+    }
+
+    VirtualFileSystem::~VirtualFileSystem() noexcept = default;
+
+    Status VirtualFileSystem::Mount(
+        MountId& result,
+        std::string_view prefix,
+        std::shared_ptr<IFileSystem> filesystem,
+        std::string_view root,
+        int32_t priority,
+        bool writable) noexcept
+    {
+        result = MountId::Invalid;
+
+        if (filesystem == nullptr)
+        {
+            return Status::InvalidArgument;
+        }
+
+        std::string normalized{};
+
+        if (!Impl::NormalizeVirtualPath(normalized, prefix))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+        //
+        // Mounts are kept sorted by priority, so resolution visits them in order. New mount is
+        // placed before mounts with same priority.
+        //
+
+        auto const position = std::find_if(m_Mounts.begin(), m_Mounts.end(), [&](const MountPoint& mount) {
+            return mount.Priority <= priority;
+        });
+
+        result = static_cast<MountId>(m_NextId++);
+
+        m_Mounts.insert(position, MountPoint{
+                                      .Id         = result,
+                                      .Priority   = priority,
+                                      .Writable   = writable,
+                                      .Prefix     = std::move(normalized),
+                                      .Root       = std::string{ root },
+                                      .FileSystem = std::move(filesystem),
+                                  });
+
+        ++m_Generation;
+        m_Cache.clear();
+
+        return Status::Success;
+    }
+
+    Status VirtualFileSystem::Mount(
+        MountId& result,
+        std::string_view prefix,
+        IFileSystem& filesystem,
+        std::string_view root,
+        int32_t priority,
+        bool writable) noexcept
+    {
+        //
+        // Aliasing constructor with empty owner creates non-owning pointer.
+        //
+
+        return Mount(
+            result,
+            prefix,
+            std::shared_ptr<IFileSystem>{ std::shared_ptr<IFileSystem>{}, &filesystem },
+            root,
+            priority,
+            writable);
+    }
+
+    Status VirtualFileSystem::Unmount(
+        MountId id) noexcept
+    {
+        Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+        auto const it = std::find_if(m_Mounts.begin(), m_Mounts.end(), [&](const MountPoint& mount) {
+            return mount.Id == id;
+        });
+
+        if (it == m_Mounts.end())
+        {
+            return Status::NotFound;
+        }
+
+        m_Mounts.erase(it);
+
+        ++m_Generation;
+        m_Cache.clear();
+
+        return Status::Success;
+    }
+
+    void VirtualFileSystem::InvalidateCache() noexcept
+    {
+        Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+        ++m_Generation;
+        m_Cache.clear();
+    }
+
+    Status VirtualFileSystem::OpenRead(
+        std::unique_ptr<IStream>& result,
+        std::string_view path,
+        bool share) noexcept
+    {
+        result = nullptr;
+
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        return resolution.FileSystem->OpenRead(result, resolution.Path, share);
+    }
+
+    Status VirtualFileSystem::OpenWrite(
+        std::unique_ptr<IStream>& result,
+        std::string_view path,
+        bool append,
+        bool share) noexcept
+    {
+        result = nullptr;
+
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = ResolveWritable(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        Status const status = resolution.FileSystem->OpenWrite(result, resolution.Path, append, share);
+
+        if (status == Status::Success)
+        {
+            InvalidatePath(normalized);
+        }
+
+        return status;
+    }
+
+    Status VirtualFileSystem::OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        MappedFileAccess access) noexcept
+    {
+        result = nullptr;
+
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        return resolution.FileSystem->OpenMapped(result, resolution.Path, access);
+    }
+
+    Status VirtualFileSystem::IsReadonly(
+        bool& result,
+        std::string_view path) noexcept
+    {
+        result = true;
+
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            if (status == Status::NotFound && IsMountDirectory(normalized))
+            {
+                return Status::Success;
+            }
+
+            return status;
+        }
+
+        if (!resolution.Writable)
+        {
+            return Status::Success;
+        }
+
+        return resolution.FileSystem->IsReadonly(result, resolution.Path);
+    }
+
+    Status VirtualFileSystem::SetReadonly(
+        std::string_view path,
+        bool value) noexcept
+    {
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        if (!resolution.Writable)
+        {
+            return Status::AccessDenied;
+        }
+
+        return resolution.FileSystem->SetReadonly(resolution.Path, value);
+    }
+
+    Status VirtualFileSystem::GetFileInfo(
+        FileInfo& result,
+        std::string_view path) noexcept
+    {
+        result = FileInfo{
+            .CreationTime     = m_CreationTime,
+            .AccessTime       = m_CreationTime,
+            .ModificationTime = m_CreationTime,
+            .FileSize         = 0,
+            .IsDirectory      = false,
+            .IsReadonly       = true,
+            .IsValid          = false,
+        };
+
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            if (status == Status::NotFound && IsMountDirectory(normalized))
+            {
+                //
+                // Directories leading to mount prefix exist only in virtual file system.
+                //
+
+                result.IsDirectory = true;
+                result.IsValid     = true;
+                return Status::Success;
+            }
+
+            return status;
+        }
+
+        Status const status = resolution.FileSystem->GetFileInfo(result, resolution.Path);
+
+        if (!resolution.Writable)
+        {
+            result.IsReadonly = true;
+        }
+
+        return status;
+    }
+
+    Status VirtualFileSystem::GetFileSize(
+        int64_t& result,
+        std::string_view path) noexcept
+    {
+        result = -1;
+
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        return resolution.FileSystem->GetFileSize(result, resolution.Path);
+    }
+
+    Status VirtualFileSystem::Exists(
+        std::string_view path) noexcept
+    {
+        Resolution resolution{};
+        std::string normalized{};
+
+        Status const status = Resolve(resolution, normalized, path);
+
+        if (status == Status::NotFound && IsMountDirectory(normalized))
+        {
+            return Status::Success;
+        }
+
+        return status;
+    }
+
+    Status VirtualFileSystem::FileMove(
+        std::string_view destination,
+        std::string_view source) noexcept
+    {
+        Resolution resolved_source{};
+        std::string normalized_source{};
+
+        if (Status const status = Resolve(resolved_source, normalized_source, source); status != Status::Success)
+        {
+            return status;
+        }
+
+        if (!resolved_source.Writable)
+        {
+            return Status::AccessDenied;
+        }
+
+        Resolution resolved_destination{};
+        std::string normalized_destination{};
+
+        if (Status const status = ResolveWritable(resolved_destination, normalized_destination, destination); status != Status::Success)
+        {
+            return status;
+        }
+
+        if (resolved_source.Id != resolved_destination.Id)
+        {
+            //
+            // Files are moved only within single mount.
+            //
+
+            return Status::NotSupported;
+        }
+
+        Status const status = resolved_source.FileSystem->FileMove(resolved_destination.Path, resolved_source.Path);
+
+        InvalidatePath(normalized_source);
+        InvalidatePath(normalized_destination);
+
+        return status;
+    }
+
+    Status VirtualFileSystem::FileDelete(
+        std::string_view path) noexcept
+    {
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = Resolve(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        if (!resolution.Writable)
+        {
+            return Status::AccessDenied;
+        }
+
+        //
+        // Deleted file may still be provided by mount with lower priority.
+        //
+
+        Status const status = resolution.FileSystem->FileDelete(resolution.Path);
+
+        InvalidatePath(normalized);
+
+        return status;
+    }
+
+    Status VirtualFileSystem::DirectoryCreate(
+        std::string_view path) noexcept
+    {
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = ResolveWritable(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        Status const status = resolution.FileSystem->DirectoryCreate(resolution.Path);
+
+        InvalidatePath(normalized);
+
+        return status;
+    }
+
+    Status VirtualFileSystem::DirectoryDelete(
+        std::string_view path) noexcept
+    {
+        Resolution resolution{};
+        std::string normalized{};
+
+        if (Status const status = ResolveWritable(resolution, normalized, path); status != Status::Success)
+        {
+            return status;
+        }
+
+        Status const status = resolution.FileSystem->DirectoryDelete(resolution.Path);
+
+        InvalidatePath(normalized);
+
+        return status;
+    }
+
+    Status VirtualFileSystem::Enumerate(
+        std::string_view path,
+        IDirectoryVisitor& visitor) noexcept
+    {
+        std::map<std::string, FileInfo, std::less<>> children{};
+        std::string normalized{};
+
+        if (Status const status = EnumerateChildren(path, normalized, children, false); status != Status::Success)
+        {
+            return status;
+        }
+
+        std::string child{};
+
+        for (auto const& [name, info] : children)
+        {
+            child.assign(normalized);
+            AppendPath(child, name);
+
+            if (visitor.Visit(child, info.IsDirectory) != Status::Success)
+            {
+                return Status::Failure;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    Status VirtualFileSystem::Enumerate(
+        std::string_view path,
+        IDirectoryInfoVisitor& visitor) noexcept
+    {
+        std::map<std::string, FileInfo, std::less<>> children{};
+        std::string normalized{};
+
+        if (Status const status = EnumerateChildren(path, normalized, children, true); status != Status::Success)
+        {
+            return status;
+        }
+
+        std::string child{};
+
+        for (auto const& [name, info] : children)
+        {
+            child.assign(normalized);
+            AppendPath(child, name);
+
+            if (visitor.Visit(child, info) != Status::Success)
+            {
+                return Status::Failure;
+            }
+        }
+
+        return Status::Success;
+    }
+
+    Status VirtualFileSystem::Resolve(
+        Resolution& result,
+        std::string& normalized,
+        std::string_view path) noexcept
+    {
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        std::vector<std::pair<uint32_t, Resolution>> candidates{};
+        uint64_t generation{};
+
+        {
+            Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+            std::string_view remainder{};
+
+            if (auto const it = m_Cache.find(normalized); it != m_Cache.end())
+            {
+                if (it->second == Impl::UnresolvedMount)
+                {
+                    return Status::NotFound;
+                }
+
+                const MountPoint& mount = m_Mounts[it->second];
+
+                [[maybe_unused]] bool const within = Impl::IsVirtualPathWithin(normalized, mount.Prefix, remainder);
+                GX_ASSERT(within);
+
+                result = Resolution{
+                    .FileSystem = mount.FileSystem,
+                    .Path       = Storage::CombinePath(mount.Root, remainder),
+                    .Id         = mount.Id,
+                    .Writable   = mount.Writable,
+                };
+
+                return Status::Success;
+            }
+
+            generation = m_Generation;
+
+            for (size_t i = 0; i < m_Mounts.size(); ++i)
+            {
+                const MountPoint& mount = m_Mounts[i];
+
+                if (Impl::IsVirtualPathWithin(normalized, mount.Prefix, remainder))
+                {
+                    candidates.emplace_back(
+                        static_cast<uint32_t>(i),
+                        Resolution{
+                            .FileSystem = mount.FileSystem,
+                            .Path       = Storage::CombinePath(mount.Root, remainder),
+                            .Id         = mount.Id,
+                            .Writable   = mount.Writable,
+                        });
+                }
+            }
+        }
+
+        //
+        // Mounted file systems are queried without lock held.
+        //
+
+        uint32_t resolved = Impl::UnresolvedMount;
+
+        for (auto& [index, candidate] : candidates)
+        {
+            if (candidate.FileSystem->Exists(candidate.Path) == Status::Success)
+            {
+                resolved = index;
+                result   = std::move(candidate);
+                break;
+            }
+        }
+
+        {
+            Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+            //
+            // Mounts or files changed while resolving; result may be stale.
+            //
+
+            if (m_Generation == generation)
+            {
+                if (m_Cache.size() >= Impl::MaxCacheSize)
+                {
+                    m_Cache.clear();
+                }
+
+                m_Cache.insert_or_assign(normalized, resolved);
+            }
+        }
+
+        return (resolved != Impl::UnresolvedMount) ? Status::Success : Status::NotFound;
+    }
+
+    Status VirtualFileSystem::ResolveWritable(
+        Resolution& result,
+        std::string& normalized,
+        std::string_view path) noexcept
+    {
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+        std::string_view remainder{};
+
+        for (const MountPoint& mount : m_Mounts)
+        {
+            if (mount.Writable && Impl::IsVirtualPathWithin(normalized, mount.Prefix, remainder))
+            {
+                result = Resolution{
+                    .FileSystem = mount.FileSystem,
+                    .Path       = Storage::CombinePath(mount.Root, remainder),
+                    .Id         = mount.Id,
+                    .Writable   = mount.Writable,
+                };
+
+                return Status::Success;
+            }
+        }
+
+        return Status::AccessDenied;
+    }
+
+    bool VirtualFileSystem::IsMountDirectory(
+        std::string_view normalized) noexcept
+    {
+        Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+        std::string_view remainder{};
+
+        return std::any_of(m_Mounts.begin(), m_Mounts.end(), [&](const MountPoint& mount) {
+            return Impl::IsVirtualPathWithin(mount.Prefix, normalized, remainder) && !remainder.empty();
+        });
+    }
+
+    void VirtualFileSystem::InvalidatePath(
+        std::string_view normalized) noexcept
+    {
+        Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+        ++m_Generation;
+
+        //
+        // Creating or removing file may create or remove its parent directories as well.
+        //
+
+        std::string path{ normalized };
+
+        while (true)
+        {
+            m_Cache.erase(path);
+
+            if (path.empty())
+            {
+                break;
+            }
+
+            size_t const separator = path.rfind(Storage::DirectorySeparator);
+            path.resize((separator != std::string::npos) ? separator : 0);
+        }
+    }
+
+    Status VirtualFileSystem::EnumerateChildren(
+        std::string_view path,
+        std::string& normalized,
+        std::map<std::string, FileInfo, std::less<>>& children,
+        bool details) noexcept
+    {
+        if (!Impl::NormalizeVirtualPath(normalized, path))
+        {
+            return Status::InvalidPath;
+        }
+
+        std::vector<Resolution> candidates{};
+        bool synthesized = false;
+
+        FileInfo const directory_info{
+            .CreationTime     = m_CreationTime,
+            .AccessTime       = m_CreationTime,
+            .ModificationTime = m_CreationTime,
+            .FileSize         = 0,
+            .IsDirectory      = true,
+            .IsReadonly       = true,
+            .IsValid          = true,
+        };
+
+        {
+            Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+            std::string_view remainder{};
+
+            for (const MountPoint& mount : m_Mounts)
+            {
+                if (Impl::IsVirtualPathWithin(normalized, mount.Prefix, remainder))
+                {
+                    candidates.push_back(Resolution{
+                        .FileSystem = mount.FileSystem,
+                        .Path       = Storage::CombinePath(mount.Root, remainder),
+                        .Id         = mount.Id,
+                        .Writable   = mount.Writable,
+                    });
+                }
+                else if (Impl::IsVirtualPathWithin(mount.Prefix, normalized, remainder))
+                {
+                    children.try_emplace(std::string{ Impl::GetFirstComponent(remainder) }, directory_info);
+                    synthesized = true;
+                }
+            }
+        }
+
+        //
+        // Mounts are visited in priority order; first one providing name wins.
+        //
+
+        bool found = synthesized;
+
+        for (const Resolution& candidate : candidates)
+        {
+            Status status;
+
+            if (details)
+            {
+                Impl::ChildrenInfoVisitor visitor{ children, !candidate.Writable };
+                status = candidate.FileSystem->Enumerate(candidate.Path, visitor);
+            }
+            else
+            {
+                FileInfo info = directory_info;
+                info.IsReadonly = !candidate.Writable;
+
+                Impl::ChildrenVisitor visitor{ children, info };
+                status = candidate.FileSystem->Enumerate(candidate.Path, visitor);
+            }
+
+            found |= (status == Status::Success);
+        }
+
+        return found ? Status::Success : Status::NotFound;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+
+namespace Graphyte::Storage::Impl
+{
+    /// @brief Normalizes path used by virtual file systems.
+    ///
+    /// Directory separators are unified, leading separators and `.` components are removed. Empty
+    /// path represents root directory.
+    ///
+    /// @param result Returns normalized path.
+    /// @param path   Provides path to normalize.
+    ///
+    /// @return Value indicating whether path is valid. Paths escaping root directory are invalid.
+    [[nodiscard]] bool NormalizeVirtualPath(
+        std::string& result,
+        std::string_view path) noexcept;
+
+    /// @brief Checks whether normalized path is located in specified directory, or is that directory.
+    ///
+    /// @param path      Provides normalized path.
+    /// @param directory Provides normalized directory path.
+    /// @param remainder Returns path relative to directory.
+    [[nodiscard]] bool IsVirtualPathWithin(
+        std::string_view path,
+        std::string_view directory,
+        std::string_view& remainder) noexcept;
+}
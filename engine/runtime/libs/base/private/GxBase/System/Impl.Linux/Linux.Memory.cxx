@@ -108,6 +108,11 @@ namespace Graphyte::System
             -1,
             0);
 
+        if (memory == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
         return memory;
     }
 
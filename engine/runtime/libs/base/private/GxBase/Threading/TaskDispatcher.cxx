@@ -1,19 +1,58 @@
 #include <GxBase/Threading/TaskDispatcher.hxx>
+#include <GxBase/Threading/TaskGraph.hxx>
+#include <GxBase/Threading/WorkStealingQueue.hxx>
+#include <GxBase/Threading.hxx>
 #include <GxBase/String.hxx>
 #include <GxBase/Diagnostics/Profiler.hxx>
 #include <GxBase/System.hxx>
 
+namespace Graphyte::Threading::Impl
+{
+    //
+    // Number of attempts to find task before worker thread gets parked.
+    //
+
+    constexpr const uint32_t TaskWorkerSpinCount = 64;
+
+    //
+    // Maximum number of tasks moved from shared queue to worker queue at once.
+    //
+
+    constexpr const size_t TaskWorkerSharedBatchSize = 16;
+
+    //
+    // Initial capacity of shared task queue.
+    //
+
+    constexpr const size_t TaskSharedQueueCapacity = 1024;
+
+    //
+    // Worker thread running on current thread, if any.
+    //
+
+    thread_local TaskWorkerThread* g_CurrentTaskWorker{};
+}
+
 namespace Graphyte::Threading
 {
     class TaskWorkerThread final : public IRunnable
     {
+        friend class TaskDispatcher;
+
     private:
         TaskDispatcher& m_TaskManager;
+        WorkStealingQueue<BaseTask*> m_Queue;
+        uint32_t m_Index;
+        uint32_t m_Random;
 
     public:
         TaskWorkerThread(
-            TaskDispatcher& task_manager) noexcept
+            TaskDispatcher& task_manager,
+            uint32_t index) noexcept
             : m_TaskManager{ task_manager }
+            , m_Queue{}
+            , m_Index{ index }
+            , m_Random{ index * 0x9E3779B9u + 1u }
         {
         }
 
@@ -21,20 +60,41 @@ namespace Graphyte::Threading
 
         uint32_t OnRun() noexcept final
         {
+            Impl::g_CurrentTaskWorker = this;
+
+            Diagnostics::Profiler::ThreadName(fmt::format("worker-{}", m_Index).c_str());
+
             for (;;)
             {
-                auto task = m_TaskManager.AcquireTask();
+                BaseTask* task = m_TaskManager.AcquireTask(*this);
 
                 if (task != nullptr)
                 {
-                    GX_PROFILE_REGION("Task");
-                    task->Execute();
+                    TaskDispatcher::ExecuteTask(task);
                 }
                 else
                 {
-                    return 0;
+                    break;
                 }
             }
+
+            Impl::g_CurrentTaskWorker = nullptr;
+            return 0;
+        }
+
+    private:
+        uint32_t NextRandom() noexcept
+        {
+            //
+            // xorshift32
+            //
+
+            uint32_t value = m_Random;
+            value ^= value << 13;
+            value ^= value >> 17;
+            value ^= value << 5;
+            m_Random = value;
+            return value;
         }
     };
 }
@@ -42,10 +102,12 @@ namespace Graphyte::Threading
 namespace Graphyte::Threading
 {
     TaskDispatcher::TaskDispatcher() noexcept
-        : m_Tasks{}
-        , m_Workers{}
+        : m_Workers{}
+        , m_Tasks{}
+        , m_TasksHead{}
+        , m_TasksCount{}
         , m_CS{}
-        , m_CV{}
+        , m_Idle{}
         , m_Stop{}
     {
     }
@@ -76,62 +138,376 @@ namespace Graphyte::Threading
         size_t threads) noexcept
     {
         Stop();
-        m_Stop = false;
+        m_Stop.store(false, std::memory_order_release);
 
         m_Workers.resize(threads);
 
-        size_t index{};
+        //
+        // All worker queues must exist before any worker starts stealing.
+        //
+
+        uint32_t index{};
+
+        for (auto& worker : m_Workers)
+        {
+            worker.Runnable = std::make_unique<TaskWorkerThread>(*this, index++);
+        }
+
+        index = 0;
 
         for (auto& worker : m_Workers)
         {
-            worker.Runnable = std::make_unique<TaskWorkerThread>(*this);
             worker.Worker.Start(worker.Runnable.get(), fmt::format("worker-{}", index++));
         }
     }
 
     void TaskDispatcher::Stop() noexcept
     {
-        m_Stop = true;
-        m_CV.NotifyAll();
+        m_Stop.store(true, std::memory_order_release);
+        m_Idle.NotifyAll();
 
         for (auto& worker : m_Workers)
         {
             worker.Worker.Stop(true);
         }
 
+        //
+        // Workers drain all queues before exiting. Release tasks dispatched after that.
+        //
+
+        for (auto& worker : m_Workers)
+        {
+            BaseTask* task{};
+
+            while (worker.Runnable->m_Queue.Pop(task))
+            {
+                BaseTask::Release(task);
+            }
+        }
+
         m_Workers.clear();
+
+        {
+            ScopedLock<CriticalSection> lock{ m_CS };
+
+            while (m_TasksCount.load(std::memory_order_relaxed) != 0)
+            {
+                BaseTask::Release(PopSharedTask());
+            }
+        }
     }
 
     void TaskDispatcher::Dispatch(
         std::unique_ptr<BaseTask> task) noexcept
     {
+        Dispatch(task.release());
+    }
+
+    void TaskDispatcher::Dispatch(
+        BaseTask* task) noexcept
+    {
+        GX_ASSERT(task != nullptr);
+
+        TaskWorkerThread* const worker = GetCurrentWorker();
+
+        if (worker != nullptr)
+        {
+            //
+            // Dispatched from worker thread - push to its local queue.
+            //
+
+            worker->m_Queue.Push(task);
+        }
+        else
+        {
+            ScopedLock<CriticalSection> lock{ m_CS };
+            PushSharedTask(task);
+        }
+
+        m_Idle.Notify();
+    }
+
+    BaseTask* TaskDispatcher::AcquireTask(
+        TaskWorkerThread& worker) noexcept
+    {
+        for (;;)
+        {
+            for (uint32_t spin = 0; spin < Impl::TaskWorkerSpinCount; ++spin)
+            {
+                if (BaseTask* task = TryAcquireTask(&worker); task != nullptr)
+                {
+                    return task;
+                }
+
+                if (m_Stop.load(std::memory_order_acquire))
+                {
+                    return nullptr;
+                }
+
+                SpinWaitHint();
+            }
+
+            //
+            // Nothing to do. Announce intent to park and check all queues once again, so task
+            // dispatched in between is not missed.
+            //
+
+            auto const key = m_Idle.PrepareWait();
+
+            if (BaseTask* task = TryAcquireTask(&worker); task != nullptr)
+            {
+                m_Idle.CancelWait();
+                return task;
+            }
+
+            if (m_Stop.load(std::memory_order_acquire))
+            {
+                m_Idle.CancelWait();
+                return nullptr;
+            }
+
+            m_Idle.Wait(key);
+        }
+    }
+
+    BaseTask* TaskDispatcher::TryAcquireTask(
+        TaskWorkerThread* worker) noexcept
+    {
+        BaseTask* task{};
+
+        if (worker != nullptr)
+        {
+            if (worker->m_Queue.Pop(task))
+            {
+                return task;
+            }
+
+            if ((task = AcquireSharedTask(*worker)) != nullptr)
+            {
+                return task;
+            }
+
+            return StealTask(worker->NextRandom(), worker->m_Index);
+        }
+
+        //
+        // External threads take single task from shared queue and steal from workers.
+        //
+
+        if (m_TasksCount.load(std::memory_order_acquire) != 0)
         {
             ScopedLock<CriticalSection> lock{ m_CS };
-            m_Tasks.push_back(std::move(task));
+
+            if (m_TasksCount.load(std::memory_order_relaxed) != 0)
+            {
+                return PopSharedTask();
+            }
         }
 
-        m_CV.Notify();
+        return StealTask(0, std::numeric_limits<size_t>::max());
     }
 
-    std::unique_ptr<BaseTask> TaskDispatcher::AcquireTask() noexcept
+    BaseTask* TaskDispatcher::AcquireSharedTask(
+        TaskWorkerThread& worker) noexcept
     {
-        std::unique_ptr<BaseTask> task{};
+        if (m_TasksCount.load(std::memory_order_acquire) == 0)
+        {
+            return nullptr;
+        }
+
+        BaseTask* result{};
 
         {
             ScopedLock<CriticalSection> lock{ m_CS };
 
-            while (!m_Stop && m_Tasks.empty())
+            size_t const available = m_TasksCount.load(std::memory_order_relaxed);
+
+            if (available == 0)
+            {
+                return nullptr;
+            }
+
+            //
+            // Take fair share of pending tasks at once. Surplus goes to local queue, where other
+            // workers may steal it from.
+            //
+
+            size_t const count = std::min({
+                available,
+                (available / m_Workers.size()) + 1,
+                Impl::TaskWorkerSharedBatchSize,
+            });
+
+            result = PopSharedTask();
+
+            for (size_t i = 1; i < count; ++i)
             {
-                m_CV.Wait(m_CS);
+                worker.m_Queue.Push(PopSharedTask());
             }
+        }
+
+        return result;
+    }
+
+    BaseTask* TaskDispatcher::StealTask(
+        size_t first,
+        size_t self) noexcept
+    {
+        size_t const count = m_Workers.size();
+
+        if (count != 0)
+        {
+            //
+            // Workers start from random victim to spread contention.
+            //
 
-            if (!m_Stop || !m_Tasks.empty())
+            first %= count;
+
+            for (size_t i = 0; i < count; ++i)
             {
-                task = std::move(m_Tasks.front());
-                m_Tasks.pop_front();
+                size_t const victim = (first + i) % count;
+
+                if (victim != self)
+                {
+                    BaseTask* task{};
+
+                    if (m_Workers[victim].Runnable->m_Queue.Steal(task))
+                    {
+                        return task;
+                    }
+                }
             }
         }
 
+        return nullptr;
+    }
+
+    TaskWorkerThread* TaskDispatcher::GetCurrentWorker() const noexcept
+    {
+        TaskWorkerThread* const worker = Impl::g_CurrentTaskWorker;
+
+        if (worker != nullptr && &worker->m_TaskManager == this)
+        {
+            return worker;
+        }
+
+        return nullptr;
+    }
+
+    size_t TaskDispatcher::GetPendingTaskCount() const noexcept
+    {
+        if (TaskWorkerThread* const worker = GetCurrentWorker(); worker != nullptr)
+        {
+            return worker->m_Queue.GetSize();
+        }
+
+        return m_TasksCount.load(std::memory_order_relaxed);
+    }
+
+    void TaskDispatcher::ExecuteTask(
+        BaseTask* task) noexcept
+    {
+        GX_PROFILE_REGION("Task");
+        task->Execute();
+        BaseTask::Release(task);
+    }
+
+    bool TaskDispatcher::TryExecuteTask() noexcept
+    {
+        if (BaseTask* task = TryAcquireTask(GetCurrentWorker()); task != nullptr)
+        {
+            ExecuteTask(task);
+            return true;
+        }
+
+        return false;
+    }
+
+    void TaskDispatcher::Wait(
+        const TaskHandle& handle) noexcept
+    {
+        Impl::TaskState* const state = handle.m_State;
+        GX_ASSERT(state != nullptr);
+        GX_ASSERT(&state->m_Dispatcher == this);
+
+        TaskWorkerThread* const worker = GetCurrentWorker();
+
+        state->m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+
+        while (!state->m_Completed.load(std::memory_order_seq_cst))
+        {
+            //
+            // Help executing pending tasks instead of blocking.
+            //
+
+            if (BaseTask* task = TryAcquireTask(worker); task != nullptr)
+            {
+                ExecuteTask(task);
+                continue;
+            }
+
+            //
+            // Park until task completes or new task is dispatched.
+            //
+
+            auto const key = m_Idle.PrepareWait();
+
+            if (state->m_Completed.load(std::memory_order_seq_cst))
+            {
+                m_Idle.CancelWait();
+                break;
+            }
+
+            if (BaseTask* task = TryAcquireTask(worker); task != nullptr)
+            {
+                m_Idle.CancelWait();
+                ExecuteTask(task);
+                continue;
+            }
+
+            m_Idle.Wait(key);
+        }
+
+        state->m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void TaskDispatcher::PushSharedTask(
+        BaseTask* task) noexcept
+    {
+        size_t const count    = m_TasksCount.load(std::memory_order_relaxed);
+        size_t const capacity = m_Tasks.size();
+
+        if (count == capacity)
+        {
+            //
+            // Grow ring buffer. Capacity is kept after tasks are consumed, so steady state
+            // dispatch doesn't allocate.
+            //
+
+            std::vector<BaseTask*> tasks(std::max<size_t>(capacity * 2, Impl::TaskSharedQueueCapacity));
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                tasks[i] = m_Tasks[(m_TasksHead + i) & (capacity - 1)];
+            }
+
+            m_Tasks     = std::move(tasks);
+            m_TasksHead = 0;
+        }
+
+        m_Tasks[(m_TasksHead + count) & (m_Tasks.size() - 1)] = task;
+        m_TasksCount.store(count + 1, std::memory_order_release);
+    }
+
+    BaseTask* TaskDispatcher::PopSharedTask() noexcept
+    {
+        size_t const count = m_TasksCount.load(std::memory_order_relaxed);
+        GX_ASSERT(count != 0);
+
+        BaseTask* const task = m_Tasks[m_TasksHead];
+        m_TasksHead          = (m_TasksHead + 1) & (m_Tasks.size() - 1);
+        m_TasksCount.store(count - 1, std::memory_order_relaxed);
+
         return task;
     }
 }
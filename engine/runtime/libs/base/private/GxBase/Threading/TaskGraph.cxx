@@ -0,0 +1,314 @@
+#include <GxBase/Threading/TaskGraph.hxx>
+#include <GxBase/Threading/TaskStorage.hxx>
+
+namespace Graphyte::Threading::Impl
+{
+    struct TaskContinuation final
+    {
+        TaskState* State;
+        TaskContinuation* Next;
+    };
+}
+
+namespace Graphyte::Threading::Impl
+{
+    void TaskState::Execute() noexcept
+    {
+        Run();
+        Complete();
+    }
+
+    void TaskState::Dispose() noexcept
+    {
+        //
+        // Dispatcher releases its reference after task is executed.
+        //
+
+        ReleaseReference();
+    }
+
+    void TaskState::ReleaseReference() noexcept
+    {
+        if (m_References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            GX_ASSERT(m_Continuations == nullptr);
+            BaseTask::Dispose();
+        }
+    }
+
+    void TaskState::AddDependencies(
+        std::span<const TaskHandle> dependencies) noexcept
+    {
+        for (const TaskHandle& dependency : dependencies)
+        {
+            if (TaskState* const state = dependency.GetState(); state != nullptr)
+            {
+                //
+                // Count dependency before it gets registered, so it cannot be resolved early.
+                //
+
+                m_Dependencies.fetch_add(1, std::memory_order_relaxed);
+
+                if (!state->AddContinuation(this))
+                {
+                    //
+                    // Dependency already completed.
+                    //
+
+                    m_Dependencies.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    void TaskState::ResolveDependency() noexcept
+    {
+        if (m_Dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_Dispatcher.Dispatch(this);
+        }
+    }
+
+    bool TaskState::AddContinuation(
+        TaskState* state) noexcept
+    {
+        if (IsCompleted())
+        {
+            return false;
+        }
+
+        auto* const continuation = new (TaskStorage::Allocate(sizeof(TaskContinuation))) TaskContinuation{
+            .State = state,
+            .Next  = nullptr,
+        };
+
+        {
+            ScopedLock<SpinLock> lock{ m_Lock };
+
+            if (!m_Completed.load(std::memory_order_relaxed))
+            {
+                continuation->Next = m_Continuations;
+                m_Continuations    = continuation;
+                return true;
+            }
+        }
+
+        TaskStorage::Deallocate(continuation, sizeof(TaskContinuation));
+        return false;
+    }
+
+    void TaskState::Complete() noexcept
+    {
+        TaskContinuation* continuation{};
+
+        {
+            ScopedLock<SpinLock> lock{ m_Lock };
+            m_Completed.store(true, std::memory_order_seq_cst);
+            continuation = std::exchange(m_Continuations, nullptr);
+        }
+
+        while (continuation != nullptr)
+        {
+            TaskContinuation* const next = continuation->Next;
+            continuation->State->ResolveDependency();
+            TaskStorage::Deallocate(continuation, sizeof(TaskContinuation));
+            continuation = next;
+        }
+
+        //
+        // Wake threads waiting for this task. Waiters are parked together with idle workers.
+        //
+
+        if (m_Waiters.load(std::memory_order_seq_cst) != 0)
+        {
+            m_Dispatcher.m_Idle.NotifyAll();
+        }
+    }
+}
+
+namespace Graphyte::Threading
+{
+    class TaskGraphNodeTask final : public BaseTask
+    {
+    private:
+        TaskGraph& m_Graph;
+        uint32_t m_Index;
+
+    public:
+        TaskGraphNodeTask(TaskGraph& graph, uint32_t index) noexcept
+            : m_Graph{ graph }
+            , m_Index{ index }
+        {
+        }
+
+        virtual ~TaskGraphNodeTask() noexcept = default;
+
+    public:
+        void Execute() noexcept final override
+        {
+            m_Graph.ExecuteNode(m_Index);
+        }
+    };
+}
+
+namespace Graphyte::Threading
+{
+    TaskGraph::TaskGraph() noexcept
+        : m_Nodes{}
+        , m_Pending{}
+        , m_Remaining{}
+        , m_Dispatcher{}
+        , m_Completion{}
+    {
+    }
+
+    TaskGraph::~TaskGraph() noexcept
+    {
+        GX_ASSERT(!m_Completion.IsValid() || m_Completion.IsCompleted());
+    }
+
+    TaskGraph::NodeId TaskGraph::Add(
+        std::function<void()> callable) noexcept
+    {
+        GX_ASSERT(!m_Completion.IsValid() || m_Completion.IsCompleted());
+
+        auto const index = static_cast<uint32_t>(m_Nodes.size());
+
+        m_Nodes.push_back(Node{
+            .Callable     = std::move(callable),
+            .Successors   = {},
+            .Predecessors = 0,
+        });
+
+        return static_cast<NodeId>(index);
+    }
+
+    void TaskGraph::Precede(
+        NodeId before,
+        NodeId after) noexcept
+    {
+        GX_ASSERT(!m_Completion.IsValid() || m_Completion.IsCompleted());
+
+        auto const index_before = static_cast<uint32_t>(before);
+        auto const index_after  = static_cast<uint32_t>(after);
+
+        GX_ASSERT(index_before < m_Nodes.size());
+        GX_ASSERT(index_after < m_Nodes.size());
+        GX_ASSERT(index_before != index_after);
+
+        m_Nodes[index_before].Successors.push_back(index_after);
+        ++m_Nodes[index_after].Predecessors;
+    }
+
+    void TaskGraph::Clear() noexcept
+    {
+        GX_ASSERT(!m_Completion.IsValid() || m_Completion.IsCompleted());
+
+        m_Nodes.clear();
+        m_Pending.clear();
+        m_Completion = {};
+    }
+
+    TaskHandle TaskGraph::Kick(
+        TaskDispatcher& dispatcher,
+        std::span<const TaskHandle> dependencies) noexcept
+    {
+        GX_ASSERT(!m_Completion.IsValid() || m_Completion.IsCompleted());
+
+        m_Dispatcher = &dispatcher;
+
+        if (m_Pending.size() != m_Nodes.size())
+        {
+            //
+            // Counters are allocated once per graph layout.
+            //
+
+            m_Pending = std::vector<std::atomic<uint32_t>>(m_Nodes.size());
+        }
+
+        for (size_t i = 0; i < m_Nodes.size(); ++i)
+        {
+            m_Pending[i].store(m_Nodes[i].Predecessors, std::memory_order_relaxed);
+        }
+
+        //
+        // Starting graph counts as additional node, so graph cannot complete while root nodes are
+        // still being dispatched.
+        //
+
+        m_Remaining.store(static_cast<uint32_t>(m_Nodes.size() + 1), std::memory_order_relaxed);
+
+        //
+        // Completion task is resolved by last executed node.
+        //
+
+        auto* const completion = BaseTask::Create<Impl::TaskState>(dispatcher);
+        m_Completion           = TaskHandle{ completion };
+
+        if (dependencies.empty())
+        {
+            Start();
+        }
+        else
+        {
+            dispatcher.Schedule([this]() { Start(); }, dependencies);
+        }
+
+        return m_Completion;
+    }
+
+    void TaskGraph::Run(
+        TaskDispatcher& dispatcher) noexcept
+    {
+        Kick(dispatcher).Wait();
+    }
+
+    void TaskGraph::Start() noexcept
+    {
+        for (uint32_t i = 0; i < m_Nodes.size(); ++i)
+        {
+            if (m_Nodes[i].Predecessors == 0)
+            {
+                DispatchNode(i);
+            }
+        }
+
+        CompleteNode();
+    }
+
+    void TaskGraph::ExecuteNode(
+        uint32_t index) noexcept
+    {
+        Node const& node = m_Nodes[index];
+
+        node.Callable();
+
+        for (uint32_t successor : node.Successors)
+        {
+            if (m_Pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                DispatchNode(successor);
+            }
+        }
+
+        CompleteNode();
+    }
+
+    void TaskGraph::CompleteNode() noexcept
+    {
+        if (m_Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            //
+            // Graph may be kicked again or destroyed as soon as completion task executes.
+            //
+
+            m_Completion.GetState()->ResolveDependency();
+        }
+    }
+
+    void TaskGraph::DispatchNode(
+        uint32_t index) noexcept
+    {
+        m_Dispatcher->Dispatch(BaseTask::Create<TaskGraphNodeTask>(*this, index));
+    }
+}
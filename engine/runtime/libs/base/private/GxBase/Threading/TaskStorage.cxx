@@ -0,0 +1,290 @@
+#include <GxBase/Threading/TaskStorage.hxx>
+#include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Bitwise.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+namespace Graphyte::Threading::Impl
+{
+    constexpr const size_t TaskStorageClassCount = 4;
+
+    static_assert((TaskStorage::MinBlockSize << (TaskStorageClassCount - 1)) == TaskStorage::MaxBlockSize);
+
+    //
+    // Size of slab allocated from heap when depot runs out of blocks.
+    //
+
+    constexpr const size_t TaskStorageSlabSize = 64 << 10;
+
+    //
+    // Number of blocks moved between thread cache and depot at once.
+    //
+
+    constexpr const size_t TaskStorageBatchSize = 32;
+
+    struct TaskStorageBlock final
+    {
+        /// Next block in list.
+        TaskStorageBlock* Next;
+
+        /// Next batch in depot. Valid for first block of batch.
+        TaskStorageBlock* NextBatch;
+
+        /// Number of blocks in batch. Valid for first block of batch.
+        size_t BatchCount;
+    };
+
+    static_assert(sizeof(TaskStorageBlock) <= TaskStorage::MinBlockSize);
+
+    [[nodiscard]] constexpr size_t GetTaskStorageClass(size_t size) noexcept
+    {
+        size_t index{};
+
+        while ((TaskStorage::MinBlockSize << index) < size)
+        {
+            ++index;
+        }
+
+        return index;
+    }
+
+    class TaskStorageDepot final
+    {
+    private:
+        struct ClassDepot final
+        {
+            SpinLock Lock;
+            TaskStorageBlock* Batches;
+        };
+
+    private:
+        ClassDepot m_Classes[TaskStorageClassCount];
+        SpinLock m_SlabsLock;
+        std::vector<void*> m_Slabs;
+        std::atomic<uint64_t> m_SlabAllocations;
+        std::atomic<uint64_t> m_BatchTransfers;
+
+    public:
+        TaskStorageDepot() noexcept
+            : m_Classes{}
+            , m_SlabsLock{}
+            , m_Slabs{}
+            , m_SlabAllocations{}
+            , m_BatchTransfers{}
+        {
+        }
+
+        ~TaskStorageDepot() noexcept
+        {
+            for (void* slab : m_Slabs)
+            {
+                ::operator delete(slab, std::align_val_t{ TaskStorage::BlockAlignment });
+            }
+        }
+
+    public:
+        TaskStorageBlock* AcquireBatch(size_t index, size_t& count) noexcept
+        {
+            m_BatchTransfers.fetch_add(1, std::memory_order_relaxed);
+
+            ClassDepot& depot = m_Classes[index];
+
+            {
+                ScopedLock<SpinLock> lock{ depot.Lock };
+
+                if (TaskStorageBlock* batch = depot.Batches; batch != nullptr)
+                {
+                    depot.Batches = batch->NextBatch;
+                    count         = batch->BatchCount;
+                    return batch;
+                }
+            }
+
+            return AllocateSlab(index, count);
+        }
+
+        void ReleaseBatch(size_t index, TaskStorageBlock* batch, size_t count) noexcept
+        {
+            GX_ASSERT(batch != nullptr);
+            GX_ASSERT(count != 0);
+
+            m_BatchTransfers.fetch_add(1, std::memory_order_relaxed);
+
+            ClassDepot& depot = m_Classes[index];
+
+            batch->BatchCount = count;
+
+            ScopedLock<SpinLock> lock{ depot.Lock };
+            batch->NextBatch = depot.Batches;
+            depot.Batches    = batch;
+        }
+
+        TaskStorageStatistics GetStatistics() const noexcept
+        {
+            return TaskStorageStatistics{
+                .SlabAllocations = m_SlabAllocations.load(std::memory_order_relaxed),
+                .BatchTransfers  = m_BatchTransfers.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+        TaskStorageBlock* AllocateSlab(size_t index, size_t& count) noexcept
+        {
+            m_SlabAllocations.fetch_add(1, std::memory_order_relaxed);
+
+            std::byte* const slab = static_cast<std::byte*>(::operator new(
+                TaskStorageSlabSize,
+                std::align_val_t{ TaskStorage::BlockAlignment }));
+
+            {
+                ScopedLock<SpinLock> lock{ m_SlabsLock };
+                m_Slabs.push_back(slab);
+            }
+
+            //
+            // Split slab into batches. First batch is returned to caller, remaining ones are
+            // stored in depot.
+            //
+
+            size_t const block_size  = TaskStorage::MinBlockSize << index;
+            size_t const block_count = TaskStorageSlabSize / block_size;
+
+            TaskStorageBlock* result{};
+
+            for (size_t first = 0; first < block_count; first += TaskStorageBatchSize)
+            {
+                size_t const last = std::min(first + TaskStorageBatchSize, block_count);
+
+                for (size_t i = first; i < last; ++i)
+                {
+                    auto* block = reinterpret_cast<TaskStorageBlock*>(slab + (i * block_size));
+                    block->Next = (i + 1 < last)
+                                      ? reinterpret_cast<TaskStorageBlock*>(slab + ((i + 1) * block_size))
+                                      : nullptr;
+                }
+
+                auto* batch = reinterpret_cast<TaskStorageBlock*>(slab + (first * block_size));
+
+                if (result == nullptr)
+                {
+                    result = batch;
+                    count  = last - first;
+                }
+                else
+                {
+                    ReleaseBatch(index, batch, last - first);
+                }
+            }
+
+            return result;
+        }
+    };
+
+    static TaskStorageDepot& GetTaskStorageDepot() noexcept
+    {
+        static TaskStorageDepot instance{};
+        return instance;
+    }
+
+    class TaskStorageCache final
+    {
+    private:
+        TaskStorageBlock* m_Head[TaskStorageClassCount];
+        size_t m_Count[TaskStorageClassCount];
+        TaskStorageDepot& m_Depot;
+
+    public:
+        TaskStorageCache() noexcept
+            : m_Head{}
+            , m_Count{}
+            , m_Depot{ GetTaskStorageDepot() }
+        {
+        }
+
+        ~TaskStorageCache() noexcept
+        {
+            for (size_t index = 0; index < TaskStorageClassCount; ++index)
+            {
+                if (m_Head[index] != nullptr)
+                {
+                    m_Depot.ReleaseBatch(index, m_Head[index], m_Count[index]);
+                }
+            }
+        }
+
+    public:
+        void* Allocate(size_t index) noexcept
+        {
+            if (m_Head[index] == nullptr)
+            {
+                m_Head[index] = m_Depot.AcquireBatch(index, m_Count[index]);
+            }
+
+            TaskStorageBlock* const block = m_Head[index];
+            m_Head[index]                 = block->Next;
+            --m_Count[index];
+
+            return block;
+        }
+
+        void Deallocate(void* pointer, size_t index) noexcept
+        {
+            auto* const block = static_cast<TaskStorageBlock*>(pointer);
+            block->Next       = m_Head[index];
+            m_Head[index]     = block;
+
+            if (++m_Count[index] >= (TaskStorageBatchSize * 2))
+            {
+                //
+                // Keep most recently used blocks in cache and move surplus to depot.
+                //
+
+                TaskStorageBlock* keep = m_Head[index];
+
+                for (size_t i = 1; i < TaskStorageBatchSize; ++i)
+                {
+                    keep = keep->Next;
+                }
+
+                TaskStorageBlock* const batch = keep->Next;
+                keep->Next                    = nullptr;
+
+                size_t const count = m_Count[index] - TaskStorageBatchSize;
+                m_Count[index]     = TaskStorageBatchSize;
+
+                m_Depot.ReleaseBatch(index, batch, count);
+            }
+        }
+    };
+
+    static TaskStorageCache& GetTaskStorageCache() noexcept
+    {
+        static thread_local TaskStorageCache instance{};
+        return instance;
+    }
+}
+
+namespace Graphyte::Threading
+{
+    void* TaskStorage::Allocate(size_t size) noexcept
+    {
+        GX_ASSERT(size != 0);
+        GX_ASSERT(size <= MaxBlockSize);
+
+        return Impl::GetTaskStorageCache().Allocate(Impl::GetTaskStorageClass(size));
+    }
+
+    void TaskStorage::Deallocate(void* pointer, size_t size) noexcept
+    {
+        GX_ASSERT(pointer != nullptr);
+        GX_ASSERT(size <= MaxBlockSize);
+        GX_ASSERT(IsAligned(reinterpret_cast<uintptr_t>(pointer), uintptr_t{ BlockAlignment }));
+
+        Impl::GetTaskStorageCache().Deallocate(pointer, Impl::GetTaskStorageClass(size));
+    }
+
+    TaskStorageStatistics TaskStorage::GetStatistics() noexcept
+    {
+        return Impl::GetTaskStorageDepot().GetStatistics();
+    }
+}
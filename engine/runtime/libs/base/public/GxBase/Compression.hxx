@@ -1,5 +1,6 @@
 #pragma once
 #include <GxBase/Base.module.hxx>
+#include <GxBase/Status.hxx>
 
 namespace Graphyte::Compression
 {
@@ -9,9 +10,23 @@ namespace Graphyte::Compression
         LZ4,
         LZ4HC,
         ZLib,
+        Zstd,
         Default = LZ4,
     };
 
+    /// @brief Tuning parameters of compression method.
+    struct CompressionParameters final
+    {
+        /// Compression level. Zero selects default level of method. Ignored by LZ4.
+        int32_t Level{};
+
+        /// Enables long distance matching. Used by Zstd only.
+        bool LongDistanceMatching{};
+
+        /// Base 2 logarithm of match window size. Zero selects default size. Used by Zstd only.
+        uint32_t WindowLog{};
+    };
+
 
     /// @brief Computes memory bound for given buffer size and compression method.
     ///
@@ -23,6 +38,14 @@ namespace Graphyte::Compression
         CompressionMethod method,
         size_t size) noexcept;
 
+    /// @brief Checks whether compression method is available in this build.
+    ///
+    /// @param method   Provides a compression method.
+    ///
+    /// @return Value indicating whether blocks can be compressed and decompressed with method.
+    [[nodiscard]] extern BASE_API bool IsSupported(
+        CompressionMethod method) noexcept;
+
 
     /// @brief Compresses memory block.
     ///
@@ -41,6 +64,25 @@ namespace Graphyte::Compression
         size_t input_size) noexcept;
 
 
+    /// @brief Compresses memory block with specified parameters.
+    ///
+    /// @param method           Provides a compression method.
+    /// @param parameters       Provides compression parameters.
+    /// @param output_buffer    Provides output buffer for compressed data.
+    /// @param output_size      Provides size of output buffer.
+    /// @param input_buffer     Provides input buffer to compress.
+    /// @param input_size       Provides size of input buffer.
+    ///
+    /// @return Value indicating whether memory block was compressed successfully.
+    [[nodiscard]] extern BASE_API bool CompressBlock(
+        CompressionMethod method,
+        const CompressionParameters& parameters,
+        void* output_buffer,
+        size_t& output_size,
+        const void* input_buffer,
+        size_t input_size) noexcept;
+
+
     /// @brief Decompresses memory block.
     ///
     /// @param method          Provides a compression method.
@@ -113,4 +155,155 @@ namespace Graphyte::Compression
             output,
             std::span<const std::byte>(input));
     }
+
+    namespace Impl
+    {
+        struct CompressionDictionaryState;
+    }
+
+    /// @brief Represents dictionary used to compress many small, similar blocks with Zstd.
+    ///
+    /// Dictionary is prepared once for compression and decompression and may be shared between
+    /// threads. Same dictionary must be used to compress and decompress block.
+    class BASE_API CompressionDictionary final
+    {
+    private:
+        std::vector<std::byte> m_Content;
+        std::unique_ptr<Impl::CompressionDictionaryState> m_State;
+
+    public:
+        CompressionDictionary() noexcept;
+
+        /// @brief Creates dictionary from content.
+        ///
+        /// @param content  Provides dictionary content, usually created by TrainDictionary.
+        /// @param level    Provides compression level used with this dictionary.
+        explicit CompressionDictionary(
+            std::vector<std::byte> content,
+            int32_t level = 0) noexcept;
+
+        ~CompressionDictionary() noexcept;
+
+        CompressionDictionary(CompressionDictionary&& other) noexcept;
+        CompressionDictionary& operator=(CompressionDictionary&& other) noexcept;
+
+    public:
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return m_State != nullptr;
+        }
+
+        /// @brief Gets dictionary identifier stored in content.
+        [[nodiscard]] uint32_t GetId() const noexcept;
+
+        [[nodiscard]] std::span<const std::byte> GetContent() const noexcept
+        {
+            return m_Content;
+        }
+
+        [[nodiscard]] Impl::CompressionDictionaryState* GetState() const noexcept
+        {
+            return m_State.get();
+        }
+    };
+
+
+    /// @brief Trains dictionary from samples.
+    ///
+    /// Samples should be representative for data compressed later. Training requires at least
+    /// few hundred samples, and total size of samples about 100 times larger than dictionary.
+    ///
+    /// @param output   Returns trained dictionary content.
+    /// @param samples  Provides samples.
+    /// @param capacity Provides maximum size of dictionary.
+    ///
+    /// @return Value indicating whether dictionary was trained successfully.
+    [[nodiscard]] extern BASE_API bool TrainDictionary(
+        std::vector<std::byte>& output,
+        std::span<const std::span<const std::byte>> samples,
+        size_t capacity) noexcept;
+
+
+    /// @brief Compresses memory block with dictionary.
+    ///
+    /// @param dictionary       Provides a compression dictionary.
+    /// @param output_buffer    Provides output buffer for compressed data.
+    /// @param output_size      Provides size of output buffer.
+    /// @param input_buffer     Provides input buffer to compress.
+    /// @param input_size       Provides size of input buffer.
+    ///
+    /// @return Value indicating whether memory block was compressed successfully.
+    [[nodiscard]] extern BASE_API bool CompressBlock(
+        const CompressionDictionary& dictionary,
+        void* output_buffer,
+        size_t& output_size,
+        const void* input_buffer,
+        size_t input_size) noexcept;
+
+
+    /// @brief Decompresses memory block compressed with dictionary.
+    ///
+    /// @param dictionary      Provides a compression dictionary.
+    /// @param output_buffer   Points to output buffer for decompressed data.
+    /// @param output_size     Provides size of output buffer.
+    /// @param input_buffer    Points to input buffer to decompress.
+    /// @param input_size      Provides size of input buffer.
+    ///
+    /// @return Value indicating whether memory block was decompressed successfully.
+    [[nodiscard]] extern BASE_API bool DecompressBlock(
+        const CompressionDictionary& dictionary,
+        void* output_buffer,
+        size_t output_size,
+        const void* input_buffer,
+        size_t input_size) noexcept;
+
+    /// @brief Options used to create compressed frame.
+    ///
+    /// Frame is self-describing container of independently compressed blocks. Each block may be
+    /// followed by checksum of compressed data, and whole frame by checksum of uncompressed
+    /// content. Both are computed with XXHash64.
+    struct FrameOptions final
+    {
+        /// Compression method used for all blocks.
+        CompressionMethod Method{ CompressionMethod::Default };
+
+        /// Compression parameters used for all blocks.
+        CompressionParameters Parameters{};
+
+        /// Size of uncompressed block. Rounded up to power of two, in range from 64 KiB to 64 MiB.
+        size_t BlockSize{ 256 << 10 };
+
+        /// Maximal number of blocks compressed concurrently by stream writer. Zero selects
+        /// number based on task dispatcher worker count.
+        size_t Concurrency{};
+
+        /// Stores checksum of each compressed block.
+        bool BlockChecksum{ true };
+
+        /// Stores checksum of uncompressed content.
+        bool ContentChecksum{ true };
+    };
+
+    /// @brief Compresses buffer into frame. Blocks are compressed in parallel.
+    ///
+    /// @param output  Returns compressed frame.
+    /// @param input   Provides data to compress.
+    /// @param options Provides frame options.
+    ///
+    /// @return Value indicating whether data was compressed successfully.
+    [[nodiscard]] extern BASE_API bool CompressFrame(
+        std::vector<std::byte>& output,
+        std::span<const std::byte> input,
+        const FrameOptions& options = {}) noexcept;
+
+    /// @brief Decompresses frame. Blocks are decompressed in parallel.
+    ///
+    /// @param output Returns decompressed data.
+    /// @param input  Provides compressed frame.
+    ///
+    /// @return The status code. InvalidFormat is returned when frame is malformed or checksum does
+    ///         not match.
+    extern BASE_API Status DecompressFrame(
+        std::vector<std::byte>& output,
+        std::span<const std::byte> input) noexcept;
 }
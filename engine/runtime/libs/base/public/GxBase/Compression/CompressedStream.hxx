@@ -0,0 +1,143 @@
+#pragma once
+#include <GxBase/Compression.hxx>
+#include <GxBase/Storage/IStream.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Threading/TaskGraph.hxx>
+
+namespace Graphyte::Compression
+{
+    /// @brief Compresses data written to underlying stream as frame.
+    ///
+    /// Full blocks are compressed in parallel on task dispatcher and written in order. Memory usage
+    /// is bounded by number of concurrently compressed blocks.
+    ///
+    /// Flush writes blocks which are already compressed. Remaining blocks and frame end are written
+    /// by Finish, or when stream is destroyed.
+    class BASE_API CompressedStreamWriter final : public Storage::IStream
+    {
+    private:
+        struct Block final
+        {
+            std::vector<std::byte> Input;
+            std::vector<std::byte> Output;
+            Threading::TaskHandle Task;
+            bool Result;
+        };
+
+    private:
+        std::unique_ptr<Storage::IStream> m_Stream;
+        FrameOptions m_Options;
+        Hash::XXHash64 m_ContentHash;
+        std::deque<std::unique_ptr<Block>> m_Pending;
+        std::vector<std::unique_ptr<Block>> m_Available;
+        std::unique_ptr<Block> m_Current;
+        int64_t m_FrameStart;
+        uint64_t m_ContentSize;
+        Status m_Status;
+        bool m_Finished;
+
+    public:
+        CompressedStreamWriter(
+            std::unique_ptr<Storage::IStream> stream,
+            const FrameOptions& options = {}) noexcept;
+
+        virtual ~CompressedStreamWriter() noexcept;
+
+    public:
+        /// @brief Writes remaining blocks and frame end.
+        ///
+        /// @return The status code.
+        Status Finish() noexcept;
+
+    public:
+        virtual Status Flush() noexcept override;
+
+        virtual Status Read(
+            std::span<std::byte> buffer,
+            size_t& processed) noexcept override;
+
+        virtual Status Write(
+            std::span<const std::byte> buffer,
+            size_t& processed) noexcept override;
+
+        virtual int64_t GetSize() noexcept override;
+
+        virtual int64_t GetPosition() noexcept override;
+
+        virtual Status SetPosition(
+            int64_t value,
+            Storage::SeekOrigin origin) noexcept override;
+
+        virtual Status SetPosition(
+            int64_t value) noexcept override;
+
+    private:
+        void SubmitBlock() noexcept;
+        void WriteBlock() noexcept;
+        void WriteOutput(std::span<const std::byte> buffer) noexcept;
+    };
+
+    /// @brief Decompresses frame read from underlying stream.
+    ///
+    /// Seeking forward skips whole blocks without decompressing them. Seeking backward restarts
+    /// decompression from beginning of frame and requires seekable underlying stream.
+    class BASE_API CompressedStreamReader final : public Storage::IStream
+    {
+    private:
+        std::unique_ptr<Storage::IStream> m_Stream;
+        Hash::XXHash64 m_ContentHash;
+        std::vector<std::byte> m_Compressed;
+        std::vector<std::byte> m_Block;
+        size_t m_BlockPosition;
+        int64_t m_FrameStart;
+        int64_t m_Position;
+        uint64_t m_ContentSize;
+        size_t m_BlockSize;
+        CompressionMethod m_Method;
+        uint8_t m_Flags;
+        Status m_Status;
+        bool m_End;
+        bool m_Hashing;
+
+    public:
+        explicit CompressedStreamReader(
+            std::unique_ptr<Storage::IStream> stream) noexcept;
+
+        virtual ~CompressedStreamReader() noexcept;
+
+    public:
+        /// @brief Gets status of frame decoding.
+        [[nodiscard]] Status GetStatus() const noexcept
+        {
+            return m_Status;
+        }
+
+    public:
+        virtual Status Flush() noexcept override;
+
+        virtual Status Read(
+            std::span<std::byte> buffer,
+            size_t& processed) noexcept override;
+
+        virtual Status Write(
+            std::span<const std::byte> buffer,
+            size_t& processed) noexcept override;
+
+        /// @brief Gets size of uncompressed content, or -1 when frame does not store it.
+        virtual int64_t GetSize() noexcept override;
+
+        virtual int64_t GetPosition() noexcept override;
+
+        virtual Status SetPosition(
+            int64_t value,
+            Storage::SeekOrigin origin) noexcept override;
+
+        virtual Status SetPosition(
+            int64_t value) noexcept override;
+
+    private:
+        Status Restart() noexcept;
+        Status ReadExact(std::span<std::byte> buffer) noexcept;
+        Status NextBlock(int64_t skip_until) noexcept;
+    };
+}
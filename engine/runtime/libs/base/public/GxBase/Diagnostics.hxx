@@ -1,6 +1,7 @@
 #pragma once
 #include <GxBase/Base.module.hxx>
 #include <GxBase/Status.hxx>
+#include <GxBase/Diagnostics/LogArguments.hxx>
 
 
 // =================================================================================================
@@ -380,6 +381,11 @@ namespace Graphyte::Diagnostics
 // Logging.
 //
 
+namespace Graphyte::Storage
+{
+    struct IStream;
+}
+
 namespace Graphyte::Diagnostics
 {
     enum struct LogLevel
@@ -407,6 +413,10 @@ namespace Graphyte::Diagnostics
     {
         BASE_API extern LogLevel g_LogLevel;
 
+        /// Enabled when new messages are produced for binary deferred-format log file. Each
+        /// record keeps format it was produced in.
+        BASE_API extern std::atomic<bool> g_LogBinary;
+
         [[nodiscard]] constexpr bool IsCompiled(LogLevel level) noexcept
         {
             switch (level)
@@ -424,8 +434,58 @@ namespace Graphyte::Diagnostics
     }
 
 
+    /// @brief Specifies what happens when log buffer of thread is full.
+    enum struct LogOverflowPolicy
+    {
+        /// Logging thread waits until writer thread frees space.
+        Block,
+
+        /// Message is dropped. Number of dropped messages is reported in log.
+        Drop,
+    };
+
+    /// @brief Sets overflow policy of asynchronous logger.
+    BASE_API void SetLogOverflowPolicy(LogOverflowPolicy policy) noexcept;
+
+    /// @brief Gets overflow policy of asynchronous logger.
+    [[nodiscard]] BASE_API LogOverflowPolicy GetLogOverflowPolicy() noexcept;
+
+    /// @brief Gets number of messages dropped due to overflow.
+    [[nodiscard]] BASE_API uint64_t GetLogDroppedCount() noexcept;
+
+    /// @brief Writes all pending log messages to outputs.
+    BASE_API void FlushLog() noexcept;
+
+    /// @brief Starts or stops thread writing log messages asynchronously.
+    ///
+    /// @param enabled Provides value indicating whether messages are written by writer thread.
+    ///
+    /// @remarks Pending messages are written before writer thread stops.
+    BASE_API void SetLogAsync(bool enabled) noexcept;
+
+    /// @brief Gets value indicating whether messages are written by writer thread.
+    [[nodiscard]] BASE_API bool IsLogAsync() noexcept;
+
+    /// @brief Replaces log output file.
+    ///
+    /// Pending messages are written to previous file first. Binary log header is written only to
+    /// empty file, so previous binary log output may be restored.
+    ///
+    /// @param stream Provides stream to write log to, or null to disable file output.
+    /// @param binary Provides value indicating whether log is written in binary deferred-format mode.
+    ///
+    /// @return The previous log output stream.
+    ///
+    /// @remarks Messages logged by other threads while output is replaced are written to either
+    ///          file, converted to its format.
+    BASE_API std::unique_ptr<Storage::IStream> SetLogOutputFile(
+        std::unique_ptr<Storage::IStream> stream,
+        bool binary) noexcept;
+
     /// @brief Logs message to logger.
     ///
+    /// Messages are formatted on calling thread and written to outputs by writer thread.
+    ///
     /// @param level    Provides log level.
     /// @param category Provides name of category.
     /// @param format   Provides format string.
@@ -461,6 +521,71 @@ namespace Graphyte::Diagnostics
     }
 }
 
+namespace Graphyte::Diagnostics
+{
+    /// @brief Describes log message call site.
+    ///
+    /// Descriptors are registered on first use. In binary log mode, log file stores each descriptor
+    /// once and messages reference it by identifier.
+    struct LogMessageDescriptor final
+    {
+        const char* Format;
+        const char* Category;
+        const char* File;
+        uint32_t Line;
+        LogLevel Level;
+        std::atomic<uint32_t> Id;
+    };
+
+    /// @brief Logs message with arguments encoded for deferred formatting.
+    ///
+    /// @param descriptor Provides descriptor of call site.
+    /// @param arguments  Provides arguments encoded by LogArgumentEncoder.
+    ///
+    /// @return \c true when successful, \c false otherwise.
+    BASE_API bool LogDispatchBinary(
+        LogMessageDescriptor& descriptor,
+        std::span<const std::byte> arguments) noexcept;
+
+    /// @brief Logs message from call site.
+    ///
+    /// In binary log mode arguments are serialized without formatting. Errors are always formatted,
+    /// so they can be reported on terminal.
+    template <typename... TArgs>
+    bool LogDispatchDeferred(
+        LogMessageDescriptor& descriptor,
+        const TArgs&... args) noexcept
+    {
+        static_assert(sizeof...(TArgs) < LogArgumentEncoder::Capacity && sizeof...(TArgs) <= UINT8_MAX);
+
+        if (Impl::g_LogBinary.load(std::memory_order_relaxed) && descriptor.Level > LogLevel::Error)
+        {
+            LogArgumentEncoder encoder{ sizeof...(TArgs) };
+            (encoder.Encode(args), ...);
+
+            return Diagnostics::LogDispatchBinary(descriptor, encoder.GetArguments());
+        }
+
+        return Diagnostics::LogDispatch(
+            descriptor.Level,
+            descriptor.Category,
+            descriptor.Format,
+            args...);
+    }
+
+    /// @brief Converts binary log file to text.
+    ///
+    /// @param output  Returns decoded log.
+    /// @param content Provides content of binary log file.
+    /// @param timestamps Provides value indicating whether messages are prefixed with timestamp.
+    ///
+    /// @return The status code.
+    BASE_API Status DecodeBinaryLog(
+        std::string& output,
+        std::span<const std::byte> content,
+        bool timestamps) noexcept;
+}
+
 namespace Graphyte::Diagnostics
 {
     struct LogCategoryBase
@@ -523,7 +648,9 @@ namespace Graphyte::Diagnostics
             { \
                 if (level <= ::Graphyte::Diagnostics::Impl::g_LogLevel) \
                 { \
-                    ::Graphyte::Diagnostics::LogDispatch(level, category.Name, format, ##__VA_ARGS__); \
+                    static_assert(std::is_array_v<std::remove_reference_t<decltype(format)>>, "Log format must be string literal"); \
+                    static ::Graphyte::Diagnostics::LogMessageDescriptor gx_log_descriptor{ format, #category, __FILE__, __LINE__, level, {} }; \
+                    ::Graphyte::Diagnostics::LogDispatchDeferred(gx_log_descriptor, ##__VA_ARGS__); \
                 } \
             } \
         } \
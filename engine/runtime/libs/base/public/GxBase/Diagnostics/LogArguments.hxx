@@ -0,0 +1,238 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+
+namespace Graphyte::Diagnostics
+{
+    enum class LogArgumentType : uint8_t
+    {
+        Bool,
+        Char,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float,
+        Double,
+        Pointer,
+        String,
+    };
+
+    /// @brief Marks type tag of argument skipped because it did not fit in buffer.
+    constexpr const uint8_t LogArgumentSkippedFlag = 0x80;
+
+    /// @brief Serializes log message arguments for deferred formatting.
+    ///
+    /// Arithmetic values, pointers and strings are stored as raw bytes. Other types are formatted
+    /// to string at call site. Encoded arguments are formatted later with FormatLogArguments.
+    ///
+    /// Layout: argument count, then type tag and value of each argument. Integers and string
+    /// lengths are stored as variable-length integers, signed integers use zigzag encoding.
+    /// Strings are truncated to fit in buffer. Values of other arguments not fitting in buffer are
+    /// skipped; their type tags are still stored with LogArgumentSkippedFlag, so following
+    /// arguments keep their positions.
+    class LogArgumentEncoder final
+    {
+    public:
+        static constexpr const size_t Capacity = 1024;
+
+    private:
+        std::array<std::byte, Capacity> m_Buffer;
+        size_t m_Size{ 1 };
+        size_t m_Expected{};
+        uint8_t m_Count{};
+
+    public:
+        LogArgumentEncoder() noexcept = default;
+
+        /// @brief Creates encoder reserving space for type tags of all arguments.
+        ///
+        /// @param count Provides number of arguments to encode.
+        explicit LogArgumentEncoder(size_t count) noexcept
+            : m_Expected{ count }
+        {
+        }
+
+    public:
+        /// Maximal size of encoded variable-length integer.
+        static constexpr const size_t MaxVarIntSize = 10;
+
+        [[nodiscard]] static constexpr uint64_t ZigZagEncode(int64_t value) noexcept
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        [[nodiscard]] static constexpr int64_t ZigZagDecode(uint64_t value) noexcept
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        /// @brief Writes variable-length integer.
+        ///
+        /// @param output Provides buffer of at least MaxVarIntSize bytes.
+        /// @param value  Provides value to write.
+        ///
+        /// @return The number of bytes written.
+        static size_t WriteVarInt(std::byte* output, uint64_t value) noexcept
+        {
+            size_t size = 0;
+
+            while (value >= 0x80)
+            {
+                output[size++] = static_cast<std::byte>(value | 0x80);
+                value >>= 7;
+            }
+
+            output[size++] = static_cast<std::byte>(value);
+            return size;
+        }
+
+    private:
+        /// @brief Gets space available for current argument. Single byte is kept for type tag of
+        ///        each following argument.
+        [[nodiscard]] size_t GetAvailable() const noexcept
+        {
+            size_t const reserved = (m_Expected > m_Count) ? (m_Expected - m_Count) : 0;
+            size_t const used     = m_Size + reserved;
+            return (used < Capacity) ? (Capacity - used) : 0;
+        }
+
+        void AppendType(LogArgumentType type) noexcept
+        {
+            m_Buffer[m_Size++] = static_cast<std::byte>(type);
+        }
+
+        void AppendSkipped(LogArgumentType type) noexcept
+        {
+            if (m_Size < Capacity)
+            {
+                m_Buffer[m_Size++] = static_cast<std::byte>(static_cast<uint8_t>(type) | LogArgumentSkippedFlag);
+            }
+        }
+
+        void AppendVarInt(LogArgumentType type, uint64_t value) noexcept
+        {
+            if (1 + MaxVarIntSize <= GetAvailable())
+            {
+                AppendType(type);
+                m_Size += WriteVarInt(&m_Buffer[m_Size], value);
+            }
+            else
+            {
+                AppendSkipped(type);
+            }
+        }
+
+        template <typename T>
+        void AppendValue(LogArgumentType type, T value) noexcept
+        {
+            if (1 + sizeof(T) <= GetAvailable())
+            {
+                AppendType(type);
+                std::memcpy(&m_Buffer[m_Size], &value, sizeof(T));
+                m_Size += sizeof(T);
+            }
+            else
+            {
+                AppendSkipped(type);
+            }
+        }
+
+        void AppendString(std::string_view value) noexcept
+        {
+            if (size_t const available = GetAvailable(); 1 + MaxVarIntSize <= available)
+            {
+                size_t const length = std::min(value.size(), available - 1 - MaxVarIntSize);
+
+                AppendType(LogArgumentType::String);
+                m_Size += WriteVarInt(&m_Buffer[m_Size], length);
+                std::memcpy(&m_Buffer[m_Size], value.data(), length);
+                m_Size += length;
+            }
+            else
+            {
+                AppendSkipped(LogArgumentType::String);
+            }
+        }
+
+    public:
+        template <typename T>
+        void Encode(const T& value) noexcept
+        {
+            ++m_Count;
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                AppendValue<uint8_t>(LogArgumentType::Bool, value ? 1 : 0);
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                AppendValue<char>(LogArgumentType::Char, value);
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                LogArgumentType const type = (sizeof(T) <= sizeof(int32_t)) ? LogArgumentType::Int32 : LogArgumentType::Int64;
+                AppendVarInt(type, ZigZagEncode(static_cast<int64_t>(value)));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                LogArgumentType const type = (sizeof(T) <= sizeof(uint32_t)) ? LogArgumentType::UInt32 : LogArgumentType::UInt64;
+                AppendVarInt(type, static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                AppendValue<float>(LogArgumentType::Float, value);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                AppendValue<double>(LogArgumentType::Double, static_cast<double>(value));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view> && std::is_pointer_v<T>)
+            {
+                //
+                // Constructing view of null string is undefined.
+                //
+
+                AppendString((value != nullptr) ? std::string_view{ value } : std::string_view{ "(null)" });
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                AppendString(std::string_view{ value });
+            }
+            else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+            {
+                AppendVarInt(LogArgumentType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+            }
+            else if constexpr (std::is_enum_v<T> && !fmt::has_formatter<T, fmt::format_context>::value)
+            {
+                //
+                // Enums without formatter are formatted as underlying integer.
+                //
+
+                --m_Count;
+                Encode(static_cast<std::underlying_type_t<T>>(value));
+            }
+            else
+            {
+                AppendString(fmt::format("{}", value));
+            }
+        }
+
+        [[nodiscard]] std::span<const std::byte> GetArguments() noexcept
+        {
+            m_Buffer[0] = static_cast<std::byte>(m_Count);
+            return { m_Buffer.data(), m_Size };
+        }
+    };
+
+    /// @brief Formats message from arguments encoded by LogArgumentEncoder.
+    ///
+    /// @param output    Returns formatted message.
+    /// @param format    Provides format string.
+    /// @param arguments Provides encoded arguments.
+    ///
+    /// @return The value indicating whether arguments were decoded successfully.
+    BASE_API bool FormatLogArguments(
+        std::string& output,
+        std::string_view format,
+        std::span<const std::byte> arguments) noexcept;
+}
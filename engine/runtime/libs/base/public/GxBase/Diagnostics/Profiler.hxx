@@ -1,25 +1,95 @@
 #pragma once
 #include <GxBase/Base.module.hxx>
+#include <GxBase/Status.hxx>
 
 namespace Graphyte::Diagnostics
 {
+    enum class ProfilerCaptureFormat
+    {
+        /// Chrome trace event JSON, viewable in chrome://tracing or Perfetto.
+        ChromeTrace,
+
+        /// Compact binary capture.
+        Binary,
+    };
+
+    /// @brief Identifies interned profiler region. Zero is reserved for unknown region.
+    using ProfilerRegionId = uint16_t;
+
+    /// @brief Describes profiler region or marker.
+    ///
+    /// Descriptors are registered once and referenced by events with 16-bit identifier. Descriptor
+    /// must remain valid for lifetime of process.
+    struct ProfilerRegionDescriptor final
+    {
+        const char* Name;
+        const char* File;
+        uint32_t Line;
+        uint32_t Color;
+    };
+
+    /// @brief Provides hierarchical CPU profiler.
+    ///
+    /// Events are recorded to per-thread ring buffers and exported on demand. Recording is disabled
+    /// by default; it can be enabled at runtime or with `--profile[=path]` command line option.
+    ///
+    /// Call sites using GX_PROFILE_REGION and GX_PROFILE_MARKER register static descriptors on first
+    /// use. Names computed at runtime must be interned explicitly with InternName.
     class BASE_API Profiler final
     {
     public:
         static void Initialize() noexcept;
         static void Finalize() noexcept;
 
+    public:
+        /// @brief Enables or disables recording of events.
+        static void Enable(bool enable) noexcept;
+
+        /// @brief Gets value indicating whether events are being recorded.
+        [[nodiscard]] static bool IsEnabled() noexcept;
+
+        /// @brief Writes recorded events to file.
+        ///
+        /// @param path   Provides path to capture file.
+        /// @param format Provides format of capture file.
+        ///
+        /// @return The status code.
+        static Status Capture(std::string_view path, ProfilerCaptureFormat format) noexcept;
+
+        /// @brief Discards all recorded events.
+        static void Reset() noexcept;
+
+    public:
+        /// @brief Registers static region descriptor.
+        ///
+        /// @param descriptor Provides descriptor with static storage duration.
+        ///
+        /// @return The region identifier, or zero when descriptor table is full.
+        [[nodiscard]] static ProfilerRegionId Register(const ProfilerRegionDescriptor& descriptor) noexcept;
+
+        /// @brief Interns region name computed at runtime.
+        ///
+        /// Names are copied to pooled string table and deduplicated; color of first interned
+        /// region with given name is used.
+        ///
+        /// @param name  Provides name of region.
+        /// @param color Provides color of region.
+        ///
+        /// @return The region identifier, or zero when descriptor table is full.
+        [[nodiscard]] static ProfilerRegionId InternName(std::string_view name, uint32_t color = 0) noexcept;
+
+        /// @brief Gets descriptor of region.
+        [[nodiscard]] static const ProfilerRegionDescriptor& GetDescriptor(ProfilerRegionId id) noexcept;
+
     public:
         static void ThreadName(const char* name) noexcept;
 
     public:
-        static void PushRange(const char* name) noexcept;
-        static void PushRange(const char* name, uint32_t color) noexcept;
+        static void PushRange(ProfilerRegionId id) noexcept;
         static void PopRange() noexcept;
 
     public:
-        static void MarkEvent(const char* name) noexcept;
-        static void MarkEvent(const char* name, uint32_t color) noexcept;
+        static void MarkEvent(ProfilerRegionId id) noexcept;
     };
 }
 
@@ -27,14 +97,9 @@ namespace Graphyte::Diagnostics
 {
     struct ProfilerScopedRegion final
     {
-        ProfilerScopedRegion(const char* name) noexcept
-        {
-            Profiler::PushRange(name);
-        }
-
-        ProfilerScopedRegion(const char* name, uint32_t color) noexcept
+        ProfilerScopedRegion(ProfilerRegionId id) noexcept
         {
-            Profiler::PushRange(name, color);
+            Profiler::PushRange(id);
         }
 
         ~ProfilerScopedRegion() noexcept
@@ -49,6 +114,17 @@ namespace Graphyte::Diagnostics
 #define GX_PROFILE_REGION(name, ...)
 #define GX_PROFILE_MARKER(name, ...)
 #else
-#define GX_PROFILE_REGION(name, ...) ::Graphyte::Diagnostics::ProfilerScopedRegion GX_UNIQUE_NAME(gx_profile_region_)(name, ##__VA_ARGS__)
-#define GX_PROFILE_MARKER(name, ...) ::Graphyte::Diagnostics::Profiler::MarkEvent(name, ##__VA_ARGS__)
+#define GX_PROFILE_REGION(name, ...) \
+    static_assert(std::is_array_v<std::remove_reference_t<decltype(name)>>, "Profile region name must be string literal"); \
+    static const ::Graphyte::Diagnostics::ProfilerRegionDescriptor GX_UNIQUE_NAME(gx_profile_descriptor_){ name, __FILE__, __LINE__, ##__VA_ARGS__ }; \
+    static const ::Graphyte::Diagnostics::ProfilerRegionId GX_UNIQUE_NAME(gx_profile_id_) = ::Graphyte::Diagnostics::Profiler::Register(GX_UNIQUE_NAME(gx_profile_descriptor_)); \
+    ::Graphyte::Diagnostics::ProfilerScopedRegion GX_UNIQUE_NAME(gx_profile_region_)(GX_UNIQUE_NAME(gx_profile_id_))
+#define GX_PROFILE_MARKER(name, ...) \
+    do \
+    { \
+        static_assert(std::is_array_v<std::remove_reference_t<decltype(name)>>, "Profile marker name must be string literal"); \
+        static const ::Graphyte::Diagnostics::ProfilerRegionDescriptor gx_profile_descriptor{ name, __FILE__, __LINE__, ##__VA_ARGS__ }; \
+        static const ::Graphyte::Diagnostics::ProfilerRegionId gx_profile_id = ::Graphyte::Diagnostics::Profiler::Register(gx_profile_descriptor); \
+        ::Graphyte::Diagnostics::Profiler::MarkEvent(gx_profile_id); \
+    } while (false)
 #endif
@@ -0,0 +1,1253 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+
+#define HASH_CONTAINERS_KEY_NOT_FOUND() std::abort()
+
+// -------------------------------------------------------------------------------------------------
+//
+// Open addressing hash containers.
+//
+// Layout follows Swiss tables: each slot has control byte holding 7 bits of hash of its key, or
+// marker of empty or deleted slot. Lookup compares whole group of control bytes at once and
+// inspects only slots with matching hash bits. Control bytes of first group are cloned after last
+// slot, so groups never wrap around.
+//
+// -------------------------------------------------------------------------------------------------
+
+namespace notstd
+{
+    /// @brief Transparent hash of strings, allowing lookup by std::string_view.
+    struct string_hash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] size_t operator()(std::string_view value) const noexcept
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+}
+
+namespace notstd::detail
+{
+    using hash_ctrl_t = int8_t;
+
+    inline constexpr hash_ctrl_t hash_ctrl_empty   = -128;
+    inline constexpr hash_ctrl_t hash_ctrl_deleted = -2;
+
+    [[nodiscard]] constexpr bool hash_ctrl_is_full(hash_ctrl_t value) noexcept
+    {
+        return value >= 0;
+    }
+
+    template <typename Key>
+    inline constexpr bool hash_is_string_key = std::is_same_v<Key, std::string> || std::is_same_v<Key, std::string_view>;
+
+    template <typename Key>
+    using hash_default_hasher = std::conditional_t<hash_is_string_key<Key>, string_hash, std::hash<Key>>;
+
+    template <typename Key>
+    using hash_default_key_equal = std::conditional_t<hash_is_string_key<Key>, std::equal_to<>, std::equal_to<Key>>;
+
+    template <typename T, typename = void>
+    inline constexpr bool hash_is_transparent = false;
+
+    template <typename T>
+    inline constexpr bool hash_is_transparent<T, std::void_t<typename T::is_transparent>> = true;
+
+    /// Determines whether key of type K may be used in lookup without conversion to key type.
+    template <typename K, typename Hash, typename KeyEqual>
+    inline constexpr bool hash_is_heterogeneous = hash_is_transparent<Hash> && hash_is_transparent<KeyEqual>;
+
+    /// @brief Mixes hash, so weak hashes like identity of integers spread over all bits.
+    [[nodiscard]] constexpr size_t hash_mix(size_t value) noexcept
+    {
+        if constexpr (sizeof(size_t) == 8)
+        {
+            value ^= value >> 32;
+            value *= size_t{ 0x9E37'79B9'7F4A'7C15 };
+            value ^= value >> 29;
+        }
+        else
+        {
+            value ^= value >> 16;
+            value *= size_t{ 0x9E37'79B9 };
+            value ^= value >> 15;
+        }
+
+        return value;
+    }
+
+    [[nodiscard]] constexpr size_t hash_h1(size_t hash) noexcept
+    {
+        return hash >> 7;
+    }
+
+    [[nodiscard]] constexpr hash_ctrl_t hash_h2(size_t hash) noexcept
+    {
+        return static_cast<hash_ctrl_t>(hash & 0x7F);
+    }
+
+    /// @brief Represents set of slots within group.
+    ///
+    /// @tparam Width Provides number of slots in group.
+    /// @tparam Shift Provides log2 of number of bits per slot.
+    template <size_t Width, size_t Shift>
+    class hash_group_mask final
+    {
+    private:
+        uint64_t mask_;
+
+    public:
+        explicit constexpr hash_group_mask(uint64_t mask) noexcept
+            : mask_{ mask }
+        {
+        }
+
+        explicit constexpr operator bool() const noexcept
+        {
+            return mask_ != 0;
+        }
+
+        /// @brief Gets index of first slot in set.
+        [[nodiscard]] constexpr size_t lowest() const noexcept
+        {
+            return static_cast<size_t>(std::countr_zero(mask_)) >> Shift;
+        }
+
+        /// @brief Removes first slot from set.
+        constexpr void next() noexcept
+        {
+            mask_ &= mask_ - 1;
+        }
+
+        /// @brief Gets number of slots following last slot in set.
+        [[nodiscard]] constexpr size_t slots_after_last() const noexcept
+        {
+            return static_cast<size_t>(std::countl_zero(mask_) - (64 - (Width << Shift))) >> Shift;
+        }
+    };
+
+#if GX_HW_SSE2
+
+    class hash_group final
+    {
+    public:
+        static constexpr size_t width = 16;
+
+        using mask_type = hash_group_mask<width, 0>;
+
+    private:
+        __m128i ctrl_;
+
+    public:
+        explicit hash_group(const hash_ctrl_t* ctrl) noexcept
+            : ctrl_{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)) }
+        {
+        }
+
+        [[nodiscard]] mask_type match(hash_ctrl_t h2) const noexcept
+        {
+            return mask_type{ static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))) };
+        }
+
+        [[nodiscard]] mask_type match_empty() const noexcept
+        {
+            return match(hash_ctrl_empty);
+        }
+
+        [[nodiscard]] mask_type match_empty_or_deleted() const noexcept
+        {
+            return mask_type{ static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_))) };
+        }
+    };
+
+#elif GX_HW_NEON
+
+    class hash_group final
+    {
+    public:
+        static constexpr size_t width = 8;
+
+        using mask_type = hash_group_mask<width, 3>;
+
+    private:
+        static constexpr uint64_t msbs = 0x8080'8080'8080'8080;
+
+    private:
+        uint8x8_t ctrl_;
+
+    public:
+        explicit hash_group(const hash_ctrl_t* ctrl) noexcept
+            : ctrl_{ vld1_u8(reinterpret_cast<const uint8_t*>(ctrl)) }
+        {
+        }
+
+        [[nodiscard]] mask_type match(hash_ctrl_t h2) const noexcept
+        {
+            return mask_type{ vget_lane_u64(vreinterpret_u64_u8(vceq_u8(ctrl_, vdup_n_u8(static_cast<uint8_t>(h2)))), 0) & msbs };
+        }
+
+        [[nodiscard]] mask_type match_empty() const noexcept
+        {
+            return match(hash_ctrl_empty);
+        }
+
+        [[nodiscard]] mask_type match_empty_or_deleted() const noexcept
+        {
+            return mask_type{ vget_lane_u64(vreinterpret_u64_u8(vclt_s8(vreinterpret_s8_u8(ctrl_), vdup_n_s8(-1))), 0) & msbs };
+        }
+    };
+
+#else
+
+    class hash_group final
+    {
+    public:
+        static constexpr size_t width = 8;
+
+        using mask_type = hash_group_mask<width, 3>;
+
+    private:
+        static constexpr uint64_t lsbs = 0x0101'0101'0101'0101;
+        static constexpr uint64_t msbs = 0x8080'8080'8080'8080;
+
+    private:
+        uint64_t ctrl_;
+
+    public:
+        explicit hash_group(const hash_ctrl_t* ctrl) noexcept
+        {
+            std::memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+        }
+
+        [[nodiscard]] mask_type match(hash_ctrl_t h2) const noexcept
+        {
+            //
+            // May report false positive for slot following matching one; keys are compared anyway.
+            //
+
+            const uint64_t x = ctrl_ ^ (lsbs * static_cast<uint8_t>(h2));
+            return mask_type{ (x - lsbs) & ~x & msbs };
+        }
+
+        [[nodiscard]] mask_type match_empty() const noexcept
+        {
+            return mask_type{ ctrl_ & (~ctrl_ << 6) & msbs };
+        }
+
+        [[nodiscard]] mask_type match_empty_or_deleted() const noexcept
+        {
+            return mask_type{ ctrl_ & (~ctrl_ << 7) & msbs };
+        }
+    };
+
+#endif
+
+    /// @brief Visits groups in triangular sequence, reaching every group of power-of-two table.
+    class hash_probe final
+    {
+    private:
+        size_t mask_;
+        size_t offset_;
+        size_t index_;
+
+    public:
+        hash_probe(size_t hash, size_t mask) noexcept
+            : mask_{ mask }
+            , offset_{ hash & mask }
+            , index_{}
+        {
+        }
+
+        [[nodiscard]] size_t offset() const noexcept
+        {
+            return offset_;
+        }
+
+        [[nodiscard]] size_t offset(size_t slot) const noexcept
+        {
+            return (offset_ + slot) & mask_;
+        }
+
+        void next() noexcept
+        {
+            index_ += hash_group::width;
+            offset_ = (offset_ + index_) & mask_;
+        }
+    };
+
+    //
+    // Key extractors read key from emplace arguments, so lookup does not need to construct value.
+    // Arguments of other forms are not extractable.
+    //
+
+    template <typename Key, typename... Args>
+    struct hash_set_key_extractor final
+    {
+        static constexpr bool extractable = false;
+    };
+
+    template <typename Key>
+    struct hash_set_key_extractor<Key, Key> final
+    {
+        static constexpr bool extractable = true;
+
+        [[nodiscard]] static const Key& key(const Key& key) noexcept
+        {
+            return key;
+        }
+    };
+
+    template <typename Key, typename... Args>
+    struct hash_map_key_extractor final
+    {
+        static constexpr bool extractable = false;
+    };
+
+    template <typename Key, typename K, typename V>
+    struct hash_map_key_extractor<Key, K, V> final
+    {
+        static constexpr bool extractable = std::is_same_v<K, Key>;
+
+        [[nodiscard]] static const Key& key(const Key& key, const V&) noexcept
+        {
+            return key;
+        }
+    };
+
+    template <typename Key, typename K, typename V>
+    struct hash_map_key_extractor<Key, std::pair<K, V>> final
+    {
+        static constexpr bool extractable = std::is_same_v<std::remove_cv_t<K>, Key>;
+
+        [[nodiscard]] static const Key& key(const std::pair<K, V>& value) noexcept
+        {
+            return value.first;
+        }
+    };
+
+    template <typename Key, typename K, typename V>
+    struct hash_map_key_extractor<Key, std::piecewise_construct_t, std::tuple<K>, V> final
+    {
+        static constexpr bool extractable = std::is_same_v<std::remove_cvref_t<K>, Key>;
+
+        [[nodiscard]] static const Key& key(std::piecewise_construct_t, const std::tuple<K>& key, const V&) noexcept
+        {
+            return std::get<0>(key);
+        }
+    };
+
+    template <typename Key>
+    struct hash_set_policy final
+    {
+        using key_type   = Key;
+        using value_type = Key;
+
+        template <typename... Args>
+        using key_extractor = hash_set_key_extractor<Key, std::remove_cvref_t<Args>...>;
+
+        [[nodiscard]] static const key_type& key(const value_type& value) noexcept
+        {
+            return value;
+        }
+    };
+
+    template <typename Key, typename Value>
+    struct hash_map_policy final
+    {
+        using key_type   = Key;
+        using value_type = std::pair<Key, Value>;
+
+        template <typename... Args>
+        using key_extractor = hash_map_key_extractor<Key, std::remove_cvref_t<Args>...>;
+
+        [[nodiscard]] static const key_type& key(const value_type& value) noexcept
+        {
+            return value.first;
+        }
+    };
+
+    template <typename Value>
+    class hash_iterator final
+    {
+        template <typename Policy, typename Hash, typename KeyEqual>
+        friend class raw_hash_table;
+
+        template <typename Other>
+        friend class hash_iterator;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::remove_const_t<Value>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Value*;
+        using reference         = Value&;
+
+    private:
+        const hash_ctrl_t* ctrl_{};
+        const hash_ctrl_t* last_{};
+        Value* slot_{};
+
+    private:
+        hash_iterator(const hash_ctrl_t* ctrl, const hash_ctrl_t* last, Value* slot) noexcept
+            : ctrl_{ ctrl }
+            , last_{ last }
+            , slot_{ slot }
+        {
+        }
+
+        void skip_free() noexcept
+        {
+            while (ctrl_ != last_ && !hash_ctrl_is_full(*ctrl_))
+            {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+    public:
+        hash_iterator() noexcept = default;
+
+        template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value>>>
+        hash_iterator(const hash_iterator<Other>& other) noexcept
+            : ctrl_{ other.ctrl_ }
+            , last_{ other.last_ }
+            , slot_{ other.slot_ }
+        {
+        }
+
+        [[nodiscard]] reference operator*() const noexcept
+        {
+            return *slot_;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept
+        {
+            return slot_;
+        }
+
+        hash_iterator& operator++() noexcept
+        {
+            ++ctrl_;
+            ++slot_;
+            skip_free();
+            return *this;
+        }
+
+        hash_iterator operator++(int) noexcept
+        {
+            hash_iterator result{ *this };
+            ++*this;
+            return result;
+        }
+
+        [[nodiscard]] bool operator==(const hash_iterator& other) const noexcept
+        {
+            return ctrl_ == other.ctrl_;
+        }
+
+        [[nodiscard]] bool operator!=(const hash_iterator& other) const noexcept
+        {
+            return ctrl_ != other.ctrl_;
+        }
+    };
+
+    template <typename Policy, typename Hash, typename KeyEqual>
+    class raw_hash_table
+    {
+    public:
+        using key_type        = typename Policy::key_type;
+        using value_type      = typename Policy::value_type;
+        using size_type       = size_t;
+        using difference_type = std::ptrdiff_t;
+        using hasher          = Hash;
+        using key_equal       = KeyEqual;
+        using reference       = value_type&;
+        using const_reference = const value_type&;
+        using pointer         = value_type*;
+        using const_pointer   = const value_type*;
+        using iterator        = hash_iterator<value_type>;
+        using const_iterator  = hash_iterator<const value_type>;
+
+    protected:
+        static constexpr size_t npos = ~size_t{};
+
+        template <typename K>
+        using enable_if_heterogeneous = std::enable_if_t<hash_is_heterogeneous<K, Hash, KeyEqual>>;
+
+    private:
+        Hash hash_{};
+        KeyEqual key_equal_{};
+        hash_ctrl_t* ctrl_{};
+        value_type* slots_{};
+        size_t capacity_{};
+        size_t size_{};
+        size_t growth_left_{};
+
+    public:
+        raw_hash_table() noexcept = default;
+
+        explicit raw_hash_table(size_type capacity)
+        {
+            reserve(capacity);
+        }
+
+        raw_hash_table(const raw_hash_table& other)
+            : hash_{ other.hash_ }
+            , key_equal_{ other.key_equal_ }
+        {
+            reserve(other.size_);
+
+            for (const value_type& value : other)
+            {
+                const size_t index = prepare_insert(hash_of(Policy::key(value)));
+                new (slots_ + index) value_type(value);
+            }
+        }
+
+        raw_hash_table(raw_hash_table&& other) noexcept
+            : hash_{ std::move(other.hash_) }
+            , key_equal_{ std::move(other.key_equal_) }
+            , ctrl_{ std::exchange(other.ctrl_, nullptr) }
+            , slots_{ std::exchange(other.slots_, nullptr) }
+            , capacity_{ std::exchange(other.capacity_, 0) }
+            , size_{ std::exchange(other.size_, 0) }
+            , growth_left_{ std::exchange(other.growth_left_, 0) }
+        {
+        }
+
+        raw_hash_table& operator=(const raw_hash_table& other)
+        {
+            if (this != &other)
+            {
+                raw_hash_table copy{ other };
+                swap(copy);
+            }
+
+            return *this;
+        }
+
+        raw_hash_table& operator=(raw_hash_table&& other) noexcept
+        {
+            if (this != &other)
+            {
+                raw_hash_table moved{ std::move(other) };
+                swap(moved);
+            }
+
+            return *this;
+        }
+
+        ~raw_hash_table() noexcept
+        {
+            destroy_slots();
+            deallocate();
+        }
+
+    public:
+        [[nodiscard]] iterator begin() noexcept
+        {
+            iterator result{ ctrl_, ctrl_ + capacity_, slots_ };
+            result.skip_free();
+            return result;
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return iterator{ ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_ };
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            const_iterator result{ ctrl_, ctrl_ + capacity_, slots_ };
+            result.skip_free();
+            return result;
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator{ ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_ };
+        }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        [[nodiscard]] const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+    public:
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        /// @brief Gets number of slots.
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        [[nodiscard]] float load_factor() const noexcept
+        {
+            return (capacity_ != 0) ? static_cast<float>(size_) / static_cast<float>(capacity_) : 0.0F;
+        }
+
+        [[nodiscard]] static constexpr float max_load_factor() noexcept
+        {
+            return 0.875F;
+        }
+
+        /// @brief Reserves space for at least specified number of elements without rehashing.
+        void reserve(size_type count)
+        {
+            if (count > (size_ + growth_left_))
+            {
+                resize(capacity_for(count));
+            }
+        }
+
+        /// @brief Rehashes table to at least specified number of slots.
+        ///
+        /// @remarks Rehashing empty table to zero slots releases its memory.
+        void rehash(size_type count)
+        {
+            if (count == 0 && size_ == 0)
+            {
+                deallocate();
+                return;
+            }
+
+            const size_t required = std::max(capacity_for(size_), std::bit_ceil(std::max(count, hash_group::width)));
+
+            if (required != capacity_)
+            {
+                resize(required);
+            }
+        }
+
+        void clear() noexcept
+        {
+            destroy_slots();
+
+            if (capacity_ != 0)
+            {
+                std::memset(ctrl_, hash_ctrl_empty, capacity_ + hash_group::width);
+            }
+
+            size_        = 0;
+            growth_left_ = max_size_for(capacity_);
+        }
+
+        void swap(raw_hash_table& other) noexcept
+        {
+            using std::swap;
+            swap(hash_, other.hash_);
+            swap(key_equal_, other.key_equal_);
+            swap(ctrl_, other.ctrl_);
+            swap(slots_, other.slots_);
+            swap(capacity_, other.capacity_);
+            swap(size_, other.size_);
+            swap(growth_left_, other.growth_left_);
+        }
+
+        [[nodiscard]] hasher hash_function() const
+        {
+            return hash_;
+        }
+
+        [[nodiscard]] key_equal key_eq() const
+        {
+            return key_equal_;
+        }
+
+    public:
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            const auto [index, inserted] = find_or_prepare_insert(Policy::key(value));
+
+            if (inserted)
+            {
+                new (slots_ + index) value_type(value);
+            }
+
+            return { iterator_at(index), inserted };
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            const auto [index, inserted] = find_or_prepare_insert(Policy::key(value));
+
+            if (inserted)
+            {
+                new (slots_ + index) value_type(std::move(value));
+            }
+
+            return { iterator_at(index), inserted };
+        }
+
+        template <typename InputIter>
+        void insert(InputIter first, InputIter last)
+        {
+            for (; first != last; ++first)
+            {
+                insert(*first);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> values)
+        {
+            reserve(size_ + values.size());
+            insert(values.begin(), values.end());
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            using key_extractor = typename Policy::template key_extractor<Args...>;
+
+            if constexpr (key_extractor::extractable)
+            {
+                const auto [index, inserted] = find_or_prepare_insert(key_extractor::key(args...));
+
+                if (inserted)
+                {
+                    new (slots_ + index) value_type(std::forward<Args>(args)...);
+                }
+
+                return { iterator_at(index), inserted };
+            }
+            else
+            {
+                return insert(value_type(std::forward<Args>(args)...));
+            }
+        }
+
+        iterator erase(const_iterator position) noexcept
+        {
+            const size_t index = static_cast<size_t>(position.ctrl_ - ctrl_);
+            erase_at(index);
+
+            iterator result{ ctrl_ + index, ctrl_ + capacity_, slots_ + index };
+            result.skip_free();
+            return result;
+        }
+
+        iterator erase(iterator position) noexcept
+        {
+            return erase(const_iterator{ position });
+        }
+
+        size_type erase(const key_type& key) noexcept
+        {
+            return erase_key(key);
+        }
+
+        template <typename K, typename = enable_if_heterogeneous<K>, typename = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        size_type erase(const K& key) noexcept
+        {
+            return erase_key(key);
+        }
+
+    public:
+        [[nodiscard]] iterator find(const key_type& key) noexcept
+        {
+            return iterator_at(find_index(key));
+        }
+
+        [[nodiscard]] const_iterator find(const key_type& key) const noexcept
+        {
+            return iterator_at(find_index(key));
+        }
+
+        template <typename K, typename = enable_if_heterogeneous<K>>
+        [[nodiscard]] iterator find(const K& key) noexcept
+        {
+            return iterator_at(find_index(key));
+        }
+
+        template <typename K, typename = enable_if_heterogeneous<K>>
+        [[nodiscard]] const_iterator find(const K& key) const noexcept
+        {
+            return iterator_at(find_index(key));
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const noexcept
+        {
+            return find_index(key) != npos;
+        }
+
+        template <typename K, typename = enable_if_heterogeneous<K>>
+        [[nodiscard]] bool contains(const K& key) const noexcept
+        {
+            return find_index(key) != npos;
+        }
+
+        [[nodiscard]] size_type count(const key_type& key) const noexcept
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        template <typename K, typename = enable_if_heterogeneous<K>>
+        [[nodiscard]] size_type count(const K& key) const noexcept
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+    protected:
+        template <typename K>
+        [[nodiscard]] size_t hash_of(const K& key) const noexcept
+        {
+            return hash_mix(hash_(key));
+        }
+
+        [[nodiscard]] value_type& slot_at(size_t index) noexcept
+        {
+            return slots_[index];
+        }
+
+        [[nodiscard]] iterator iterator_at(size_t index) noexcept
+        {
+            return (index != npos) ? iterator{ ctrl_ + index, ctrl_ + capacity_, slots_ + index } : end();
+        }
+
+        [[nodiscard]] const_iterator iterator_at(size_t index) const noexcept
+        {
+            return (index != npos) ? const_iterator{ ctrl_ + index, ctrl_ + capacity_, slots_ + index } : end();
+        }
+
+        /// @brief Finds slot of element with specified key.
+        ///
+        /// @return The index of slot, or npos when key was not found.
+        template <typename K>
+        [[nodiscard]] size_t find_index(const K& key) const noexcept
+        {
+            if (size_ == 0)
+            {
+                return npos;
+            }
+
+            return find_index(key, hash_of(key));
+        }
+
+        /// @brief Finds slot of element with specified key and its hash.
+        ///
+        /// @return The index of slot, or npos when key was not found.
+        template <typename K>
+        [[nodiscard]] size_t find_index(const K& key, size_t hash) const noexcept
+        {
+            if (size_ == 0)
+            {
+                return npos;
+            }
+
+            const hash_ctrl_t h2 = hash_h2(hash);
+
+            hash_probe probe{ hash_h1(hash), capacity_ - 1 };
+
+            while (true)
+            {
+                const hash_group group{ ctrl_ + probe.offset() };
+
+                for (auto match = group.match(h2); match; match.next())
+                {
+                    const size_t index = probe.offset(match.lowest());
+
+                    if (key_equal_(Policy::key(slots_[index]), key))
+                    {
+                        return index;
+                    }
+                }
+
+                if (group.match_empty())
+                {
+                    return npos;
+                }
+
+                probe.next();
+            }
+        }
+
+        /// @brief Finds slot of element with specified key, or prepares slot for new element.
+        ///
+        /// @return The index of slot and value indicating whether slot must be constructed.
+        template <typename K>
+        std::pair<size_t, bool> find_or_prepare_insert(const K& key)
+        {
+            const size_t hash = hash_of(key);
+
+            if (const size_t index = find_index(key, hash); index != npos)
+            {
+                return { index, false };
+            }
+
+            return { prepare_insert(hash), true };
+        }
+
+    private:
+        [[nodiscard]] static constexpr size_t max_size_for(size_t capacity) noexcept
+        {
+            return capacity - (capacity / 8);
+        }
+
+        [[nodiscard]] static size_t capacity_for(size_t count) noexcept
+        {
+            size_t capacity = std::bit_ceil(std::max(count, hash_group::width));
+
+            while (max_size_for(capacity) < count)
+            {
+                capacity *= 2;
+            }
+
+            return capacity;
+        }
+
+        [[nodiscard]] static size_t slots_offset(size_t capacity) noexcept
+        {
+            const size_t alignment = alignof(value_type);
+            return ((capacity + hash_group::width + alignment - 1) / alignment) * alignment;
+        }
+
+        [[nodiscard]] static constexpr std::align_val_t block_alignment() noexcept
+        {
+            return std::align_val_t{ std::max(alignof(value_type), alignof(std::max_align_t)) };
+        }
+
+        void set_ctrl(size_t index, hash_ctrl_t value) noexcept
+        {
+            ctrl_[index] = value;
+
+            if (index < hash_group::width)
+            {
+                ctrl_[capacity_ + index] = value;
+            }
+        }
+
+        size_t find_insert_slot(size_t hash) const noexcept
+        {
+            hash_probe probe{ hash_h1(hash), capacity_ - 1 };
+
+            while (true)
+            {
+                if (const auto match = hash_group{ ctrl_ + probe.offset() }.match_empty_or_deleted(); match)
+                {
+                    return probe.offset(match.lowest());
+                }
+
+                probe.next();
+            }
+        }
+
+        size_t prepare_insert(size_t hash)
+        {
+            if (capacity_ == 0)
+            {
+                resize(hash_group::width);
+            }
+
+            size_t index = find_insert_slot(hash);
+
+            if (growth_left_ == 0 && ctrl_[index] != hash_ctrl_deleted)
+            {
+                //
+                // Table is full. Drop tombstones when they occupy large part of table, grow
+                // otherwise.
+                //
+
+                resize((size_ * 32 <= capacity_ * 25) ? capacity_ : capacity_ * 2);
+                index = find_insert_slot(hash);
+            }
+
+            ++size_;
+            growth_left_ -= (ctrl_[index] == hash_ctrl_empty) ? 1 : 0;
+            set_ctrl(index, hash_h2(hash));
+
+            return index;
+        }
+
+        template <typename K>
+        size_type erase_key(const K& key) noexcept
+        {
+            if (const size_t index = find_index(key); index != npos)
+            {
+                erase_at(index);
+                return 1;
+            }
+
+            return 0;
+        }
+
+        void erase_at(size_t index) noexcept
+        {
+            slots_[index].~value_type();
+            --size_;
+
+            //
+            // Slot may be marked as empty when no probe sequence ever passed over it while full,
+            // that is, when every group containing this slot had empty slot.
+            //
+
+            const auto empty_before = hash_group{ ctrl_ + ((index - hash_group::width) & (capacity_ - 1)) }.match_empty();
+            const auto empty_after  = hash_group{ ctrl_ + index }.match_empty();
+
+            const bool was_never_full = empty_before && empty_after
+                                        && (empty_after.lowest() + empty_before.slots_after_last()) < hash_group::width;
+
+            set_ctrl(index, was_never_full ? hash_ctrl_empty : hash_ctrl_deleted);
+            growth_left_ += was_never_full ? 1 : 0;
+        }
+
+        void resize(size_t capacity)
+        {
+            hash_ctrl_t* const old_ctrl = ctrl_;
+            value_type* const old_slots = slots_;
+            size_t const old_capacity   = capacity_;
+
+            auto* const block = static_cast<std::byte*>(::operator new(
+                slots_offset(capacity) + (capacity * sizeof(value_type)),
+                block_alignment()));
+
+            ctrl_        = reinterpret_cast<hash_ctrl_t*>(block);
+            slots_       = reinterpret_cast<value_type*>(block + slots_offset(capacity));
+            capacity_    = capacity;
+            growth_left_ = max_size_for(capacity) - size_;
+
+            std::memset(ctrl_, hash_ctrl_empty, capacity + hash_group::width);
+
+            for (size_t i = 0; i < old_capacity; ++i)
+            {
+                if (hash_ctrl_is_full(old_ctrl[i]))
+                {
+                    value_type& value = old_slots[i];
+
+                    const size_t hash  = hash_of(Policy::key(value));
+                    const size_t index = find_insert_slot(hash);
+                    set_ctrl(index, hash_h2(hash));
+
+                    new (slots_ + index) value_type(std::move(value));
+                    value.~value_type();
+                }
+            }
+
+            if (old_ctrl != nullptr)
+            {
+                ::operator delete(old_ctrl, block_alignment());
+            }
+        }
+
+        void destroy_slots() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+            {
+                for (size_t i = 0; i < capacity_; ++i)
+                {
+                    if (hash_ctrl_is_full(ctrl_[i]))
+                    {
+                        slots_[i].~value_type();
+                    }
+                }
+            }
+        }
+
+        void deallocate() noexcept
+        {
+            if (ctrl_ != nullptr)
+            {
+                ::operator delete(ctrl_, block_alignment());
+            }
+
+            ctrl_        = nullptr;
+            slots_       = nullptr;
+            capacity_    = 0;
+            size_        = 0;
+            growth_left_ = 0;
+        }
+    };
+}
+
+namespace notstd
+{
+    /// @brief Hash set using open addressing.
+    ///
+    /// @remarks Iterators and references are invalidated by insertion.
+    template <typename Key, typename Hash = detail::hash_default_hasher<Key>, typename KeyEqual = detail::hash_default_key_equal<Key>>
+    class flat_hash_set : public detail::raw_hash_table<detail::hash_set_policy<Key>, Hash, KeyEqual>
+    {
+        using base_type = detail::raw_hash_table<detail::hash_set_policy<Key>, Hash, KeyEqual>;
+
+    public:
+        using base_type::base_type;
+
+        flat_hash_set() noexcept = default;
+
+        flat_hash_set(std::initializer_list<Key> values)
+        {
+            this->insert(values);
+        }
+
+        template <typename InputIter>
+        flat_hash_set(InputIter first, InputIter last)
+        {
+            this->insert(first, last);
+        }
+    };
+
+    /// @brief Hash map using open addressing.
+    ///
+    /// @remarks Iterators and references are invalidated by insertion.
+    template <typename Key, typename Value, typename Hash = detail::hash_default_hasher<Key>, typename KeyEqual = detail::hash_default_key_equal<Key>>
+    class flat_hash_map : public detail::raw_hash_table<detail::hash_map_policy<Key, Value>, Hash, KeyEqual>
+    {
+        using base_type = detail::raw_hash_table<detail::hash_map_policy<Key, Value>, Hash, KeyEqual>;
+
+    public:
+        using mapped_type    = Value;
+        using iterator       = typename base_type::iterator;
+        using const_iterator = typename base_type::const_iterator;
+
+    public:
+        using base_type::base_type;
+
+        flat_hash_map() noexcept = default;
+
+        flat_hash_map(std::initializer_list<typename base_type::value_type> values)
+        {
+            this->insert(values);
+        }
+
+        template <typename InputIter>
+        flat_hash_map(InputIter first, InputIter last)
+        {
+            this->insert(first, last);
+        }
+
+    public:
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+        {
+            const auto [index, inserted] = this->find_or_prepare_insert(key);
+
+            if (inserted)
+            {
+                new (&this->slot_at(index)) typename base_type::value_type(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(std::forward<K>(key)),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            return { this->iterator_at(index), inserted };
+        }
+
+        template <typename K, typename V>
+        std::pair<iterator, bool> insert_or_assign(K&& key, V&& value)
+        {
+            auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+
+            if (!result.second)
+            {
+                result.first->second = std::forward<V>(value);
+            }
+
+            return result;
+        }
+
+        mapped_type& operator[](const Key& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        mapped_type& operator[](Key&& key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        mapped_type& at(const Key& key)
+        {
+            const iterator iter = this->find(key);
+
+            if (iter != this->end())
+            {
+                return iter->second;
+            }
+
+            HASH_CONTAINERS_KEY_NOT_FOUND();
+        }
+
+        const mapped_type& at(const Key& key) const
+        {
+            const const_iterator iter = this->find(key);
+
+            if (iter != this->end())
+            {
+                return iter->second;
+            }
+
+            HASH_CONTAINERS_KEY_NOT_FOUND();
+        }
+    };
+}
+
+namespace notstd
+{
+    template <typename Key, typename Hash, typename KeyEqual>
+    void swap(
+        flat_hash_set<Key, Hash, KeyEqual>& l,
+        flat_hash_set<Key, Hash, KeyEqual>& r) noexcept
+    {
+        l.swap(r);
+    }
+
+    template <typename Key, typename Hash, typename KeyEqual>
+    bool operator==(
+        const flat_hash_set<Key, Hash, KeyEqual>& l,
+        const flat_hash_set<Key, Hash, KeyEqual>& r)
+    {
+        return l.size() == r.size()
+               && std::all_of(l.begin(), l.end(), [&](const Key& key) { return r.contains(key); });
+    }
+
+    template <typename Key, typename Hash, typename KeyEqual>
+    bool operator!=(
+        const flat_hash_set<Key, Hash, KeyEqual>& l,
+        const flat_hash_set<Key, Hash, KeyEqual>& r)
+    {
+        return !(l == r);
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    void swap(
+        flat_hash_map<Key, Value, Hash, KeyEqual>& l,
+        flat_hash_map<Key, Value, Hash, KeyEqual>& r) noexcept
+    {
+        l.swap(r);
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    bool operator==(
+        const flat_hash_map<Key, Value, Hash, KeyEqual>& l,
+        const flat_hash_map<Key, Value, Hash, KeyEqual>& r)
+    {
+        return l.size() == r.size()
+               && std::all_of(l.begin(), l.end(), [&](const std::pair<Key, Value>& item) {
+                      const auto iter = r.find(item.first);
+                      return iter != r.end() && iter->second == item.second;
+                  });
+    }
+
+    template <typename Key, typename Value, typename Hash, typename KeyEqual>
+    bool operator!=(
+        const flat_hash_map<Key, Value, Hash, KeyEqual>& l,
+        const flat_hash_map<Key, Value, Hash, KeyEqual>& r)
+    {
+        return !(l == r);
+    }
+}
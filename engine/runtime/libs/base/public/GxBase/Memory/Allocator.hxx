@@ -0,0 +1,139 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Memory/MemoryTracker.hxx>
+
+namespace Graphyte::Memory
+{
+    /// Alignment of memory returned by allocator when no alignment is specified.
+    constexpr const size_t DefaultAlignment = 16;
+
+    /// Maximum alignment supported by allocator.
+    constexpr const size_t MaxAlignment = 4096;
+
+    struct AllocatorStatistics final
+    {
+        /// Number of bytes of spans allocated from OS for small allocations.
+        uint64_t Reserved;
+
+        /// Number of bytes allocated from OS for large allocations.
+        uint64_t Large;
+
+        /// Number of spans allocated from OS.
+        uint64_t SpanAllocations;
+
+        /// Number of batches moved between thread caches and shared depot.
+        uint64_t BatchTransfers;
+    };
+
+    /// @brief Allocates memory.
+    ///
+    /// Small allocations are served from size classes cached per thread, large ones directly from
+    /// virtual memory. Allocated size is accounted to tag until memory is freed.
+    ///
+    /// @param tag       Provides tag of subsystem owning memory.
+    /// @param size      Provides size of memory.
+    /// @param alignment Provides alignment of memory. Must be power of two, not greater than
+    ///                  MaxAlignment.
+    ///
+    /// @return The pointer to allocated memory, or nullptr when out of memory.
+    [[nodiscard]] BASE_API void* Allocate(
+        MemoryPoolTag tag,
+        size_t size,
+        size_t alignment = DefaultAlignment) noexcept;
+
+    /// @brief Frees memory allocated by Allocate.
+    ///
+    /// @param memory Provides pointer to memory. May be nullptr.
+    BASE_API void Free(
+        void* memory) noexcept;
+
+    /// @brief Gets size of memory, as passed to Allocate.
+    [[nodiscard]] BASE_API size_t GetAllocationSize(
+        const void* memory) noexcept;
+
+    /// @brief Gets tag of memory, as passed to Allocate.
+    [[nodiscard]] BASE_API MemoryPoolTag GetAllocationTag(
+        const void* memory) noexcept;
+
+    [[nodiscard]] BASE_API AllocatorStatistics GetAllocatorStatistics() noexcept;
+
+    template <typename T, typename... TArgs>
+    [[nodiscard]] T* New(
+        MemoryPoolTag tag,
+        TArgs&&... args) noexcept
+    {
+        void* const memory = Allocate(tag, sizeof(T), std::max(alignof(T), DefaultAlignment));
+
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+
+        return new (memory) T(std::forward<TArgs>(args)...);
+    }
+
+    template <typename T>
+    void Delete(
+        T* object) noexcept
+    {
+        if (object != nullptr)
+        {
+            object->~T();
+            Free(object);
+        }
+    }
+
+    /// @brief Adapts allocator to standard containers.
+    ///
+    /// @tparam T   Type of allocated elements.
+    /// @tparam Tag Tag of subsystem owning memory.
+    template <typename T, MemoryPoolTag Tag = MemoryPoolTag::General>
+    class TaggedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind final
+        {
+            using other = TaggedAllocator<U, Tag>;
+        };
+
+    public:
+        constexpr TaggedAllocator() noexcept = default;
+
+        template <typename U>
+        constexpr TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept
+        {
+        }
+
+    public:
+        [[nodiscard]] T* allocate(size_t count) noexcept
+        {
+            GX_ABORT_UNLESS(count <= (std::numeric_limits<size_t>::max() / sizeof(T)), "Allocation size overflow");
+
+            void* const memory = Allocate(Tag, count * sizeof(T), std::max(alignof(T), DefaultAlignment));
+
+            GX_ABORT_UNLESS(memory != nullptr, "Out of memory (tag: {}, size: {})", ToString(Tag), count * sizeof(T));
+
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* memory, [[maybe_unused]] size_t count) noexcept
+        {
+            Free(memory);
+        }
+
+        template <typename U>
+        constexpr bool operator==(const TaggedAllocator<U, Tag>&) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        constexpr bool operator!=(const TaggedAllocator<U, Tag>&) const noexcept
+        {
+            return false;
+        }
+    };
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Memory/Allocator.hxx>
+
+namespace Graphyte::Memory
+{
+    /// @brief Represents position in arena to which it may be released.
+    enum class ArenaMarker : size_t
+    {
+    };
+
+    /// @brief Allocates memory by bumping pointer within fixed block.
+    ///
+    /// Individual allocations are never freed; whole arena is released at once, either to marker
+    /// or completely. Arena never grows, so allocation fails when capacity is exhausted.
+    ///
+    /// When memory guards are enabled, allocated memory is filled with 0xCD, released memory with
+    /// 0xDD and every allocation is followed by guard validated on release.
+    ///
+    /// @remarks Arena is not thread safe.
+    class BASE_API LinearArena final
+    {
+    private:
+        std::byte* m_Memory;
+        size_t m_Capacity;
+        size_t m_Offset;
+        size_t m_Peak;
+        MemoryPoolTag m_Tag;
+        bool m_Owned;
+#if GX_ENABLE_MEMORY_GUARDS
+        size_t m_Last;
+#endif
+
+    public:
+        /// @brief Creates empty arena.
+        LinearArena() noexcept;
+
+        /// @brief Creates arena owning memory allocated with tag.
+        LinearArena(
+            size_t capacity,
+            MemoryPoolTag tag) noexcept;
+
+        /// @brief Creates arena using external memory, for example buffer on stack.
+        explicit LinearArena(
+            std::span<std::byte> memory) noexcept;
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        LinearArena(LinearArena&& other) noexcept;
+        LinearArena& operator=(LinearArena&& other) noexcept;
+
+        ~LinearArena() noexcept;
+
+    public:
+        /// @brief Allocates memory.
+        ///
+        /// @return The pointer to allocated memory, or nullptr when arena is exhausted.
+        [[nodiscard]] void* Allocate(
+            size_t size,
+            size_t alignment = DefaultAlignment) noexcept;
+
+        /// @brief Allocates uninitialized array of trivial objects.
+        template <typename T>
+        [[nodiscard]] T* AllocateArray(
+            size_t count) noexcept
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena does not call destructors");
+
+            if (count > (std::numeric_limits<size_t>::max() / sizeof(T)))
+            {
+                return nullptr;
+            }
+
+            return static_cast<T*>(Allocate(count * sizeof(T), std::max(alignof(T), DefaultAlignment)));
+        }
+
+        [[nodiscard]] ArenaMarker GetMarker() const noexcept
+        {
+            return static_cast<ArenaMarker>(m_Offset);
+        }
+
+        /// @brief Releases all memory allocated since marker was taken.
+        void Release(
+            ArenaMarker marker) noexcept;
+
+        /// @brief Releases all memory.
+        void Reset() noexcept
+        {
+            Release(ArenaMarker{});
+        }
+
+        /// @brief Determines whether memory belongs to arena.
+        [[nodiscard]] bool Contains(
+            const void* memory) const noexcept
+        {
+            std::byte const* const pointer = static_cast<std::byte const*>(memory);
+            return pointer >= m_Memory && pointer < (m_Memory + m_Capacity);
+        }
+
+        /// @brief Checks guards of all allocations.
+        ///
+        /// @return The value indicating whether no allocation was overrun. Always true when memory
+        ///         guards are disabled.
+        [[nodiscard]] bool Validate() const noexcept;
+
+        [[nodiscard]] size_t GetUsed() const noexcept
+        {
+            return m_Offset;
+        }
+
+        [[nodiscard]] size_t GetCapacity() const noexcept
+        {
+            return m_Capacity;
+        }
+
+        [[nodiscard]] MemoryPoolTag GetTag() const noexcept
+        {
+            return m_Tag;
+        }
+
+        /// @brief Gets highest number of bytes used at once.
+        [[nodiscard]] size_t GetPeak() const noexcept
+        {
+            return m_Peak;
+        }
+
+    private:
+        void Destroy() noexcept;
+    };
+
+    /// @brief Releases memory allocated from arena within scope.
+    class ScopedArena final
+    {
+    private:
+        LinearArena& m_Arena;
+        ArenaMarker m_Marker;
+
+    public:
+        explicit ScopedArena(LinearArena& arena) noexcept
+            : m_Arena{ arena }
+            , m_Marker{ arena.GetMarker() }
+        {
+        }
+
+        ~ScopedArena() noexcept
+        {
+            m_Arena.Release(m_Marker);
+        }
+
+        ScopedArena(const ScopedArena&) = delete;
+        ScopedArena& operator=(const ScopedArena&) = delete;
+
+    public:
+        [[nodiscard]] LinearArena& GetArena() const noexcept
+        {
+            return m_Arena;
+        }
+    };
+
+    /// @brief Provides arenas for per-frame temporaries.
+    ///
+    /// Each frame uses its own arena, which is reset when frame starts again. Memory allocated
+    /// during frame stays valid while following frames are recorded, so it may be referenced by
+    /// work still in flight.
+    class BASE_API FrameArena final
+    {
+    public:
+        static constexpr const size_t MaxFrames = 3;
+
+    private:
+        LinearArena m_Arenas[MaxFrames];
+        size_t m_Frames;
+        size_t m_Current;
+
+    public:
+        /// @brief Creates frame arena.
+        ///
+        /// @param frames   Provides number of frames in flight, from 1 to MaxFrames.
+        /// @param capacity Provides capacity of arena of each frame.
+        /// @param tag      Provides tag of memory.
+        FrameArena(
+            size_t frames,
+            size_t capacity,
+            MemoryPoolTag tag) noexcept;
+
+        ~FrameArena() noexcept;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+    public:
+        /// @brief Starts new frame, releasing memory allocated when arena of this frame was last
+        ///        used.
+        void BeginFrame() noexcept;
+
+        [[nodiscard]] LinearArena& GetCurrent() noexcept
+        {
+            return m_Arenas[m_Current];
+        }
+
+        [[nodiscard]] void* Allocate(
+            size_t size,
+            size_t alignment = DefaultAlignment) noexcept
+        {
+            return m_Arenas[m_Current].Allocate(size, alignment);
+        }
+
+        [[nodiscard]] size_t GetFrameCount() const noexcept
+        {
+            return m_Frames;
+        }
+    };
+}
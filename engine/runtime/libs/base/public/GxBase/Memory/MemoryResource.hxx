@@ -0,0 +1,72 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Memory/Arena.hxx>
+
+namespace Graphyte::Memory
+{
+    /// @brief Adapts tagged allocator to polymorphic containers.
+    class BASE_API TaggedMemoryResource final : public std::pmr::memory_resource
+    {
+    private:
+        MemoryPoolTag m_Tag;
+
+    public:
+        explicit TaggedMemoryResource(
+            MemoryPoolTag tag) noexcept;
+
+        virtual ~TaggedMemoryResource() noexcept;
+
+    public:
+        [[nodiscard]] MemoryPoolTag GetTag() const noexcept
+        {
+            return m_Tag;
+        }
+
+    private:
+        void* do_allocate(size_t size, size_t alignment) noexcept override;
+        void do_deallocate(void* memory, size_t size, size_t alignment) noexcept override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    /// @brief Adapts arena to polymorphic containers.
+    ///
+    /// Deallocation is no-op; memory is reclaimed when arena is released. When arena is exhausted,
+    /// memory is allocated from upstream resource and overflow is counted, so undersized arenas
+    /// are visible.
+    class BASE_API ArenaMemoryResource final : public std::pmr::memory_resource
+    {
+    private:
+        LinearArena& m_Arena;
+        std::pmr::memory_resource* m_Upstream;
+        size_t m_Overflows;
+
+    public:
+        /// @brief Creates memory resource.
+        ///
+        /// @param arena    Provides arena from which memory is allocated.
+        /// @param upstream Provides resource used when arena is exhausted. When nullptr, exhausting
+        ///                 arena aborts.
+        explicit ArenaMemoryResource(
+            LinearArena& arena,
+            std::pmr::memory_resource* upstream = nullptr) noexcept;
+
+        virtual ~ArenaMemoryResource() noexcept;
+
+    public:
+        [[nodiscard]] LinearArena& GetArena() const noexcept
+        {
+            return m_Arena;
+        }
+
+        /// @brief Gets number of allocations served by upstream resource.
+        [[nodiscard]] size_t GetOverflowCount() const noexcept
+        {
+            return m_Overflows;
+        }
+
+    private:
+        void* do_allocate(size_t size, size_t alignment) noexcept override;
+        void do_deallocate(void* memory, size_t size, size_t alignment) noexcept override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+}
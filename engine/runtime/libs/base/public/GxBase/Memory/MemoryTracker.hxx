@@ -0,0 +1,84 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+GX_DECLARE_LOG_CATEGORY(LogMemory, Trace, Trace);
+
+namespace Graphyte::Memory
+{
+    /// @brief Identifies subsystem owning allocated memory.
+    enum class MemoryPoolTag : uint32_t
+    {
+        General,
+        Strings,
+        Containers,
+        Storage,
+        Threading,
+        Network,
+        Diagnostics,
+        Graphics,
+        Rendering,
+        Geometry,
+        Audio,
+        Physics,
+        Assets,
+        Scripting,
+    };
+
+    /// Number of memory pool tags.
+    constexpr const size_t MemoryPoolTagCount = static_cast<size_t>(MemoryPoolTag::Scripting) + 1;
+
+    [[nodiscard]] BASE_API std::string_view ToString(MemoryPoolTag value) noexcept;
+
+    struct MemoryPoolUsage final
+    {
+        /// Number of bytes currently allocated.
+        uint64_t Allocated;
+
+        /// Highest number of bytes allocated at once.
+        uint64_t Peak;
+
+        /// Number of live allocations.
+        uint64_t Allocations;
+
+        /// Number of allocations made since start.
+        uint64_t TotalAllocations;
+    };
+
+    /// @brief Tracks memory allocated by subsystems.
+    ///
+    /// Counters are updated with relaxed atomics, so usage reported while other threads allocate is
+    /// approximate.
+    class BASE_API MemoryTracker final
+    {
+    public:
+        /// @brief Records allocation.
+        static void Track(
+            MemoryPoolTag tag,
+            size_t size) noexcept;
+
+        /// @brief Records deallocation.
+        static void Untrack(
+            MemoryPoolTag tag,
+            size_t size) noexcept;
+
+        /// @brief Gets number of bytes currently allocated with tag.
+        [[nodiscard]] static uint64_t GetUsage(
+            MemoryPoolTag tag) noexcept;
+
+        [[nodiscard]] static MemoryPoolUsage GetStatistics(
+            MemoryPoolTag tag) noexcept;
+
+        /// @brief Resets high-water mark to current usage.
+        static void ResetPeak(
+            MemoryPoolTag tag) noexcept;
+
+        /// @brief Logs usage of all tags.
+        static void LogUsage() noexcept;
+
+        /// @brief Logs memory still allocated with any tag.
+        ///
+        /// @return The number of leaked bytes.
+        static uint64_t ReportLeaks() noexcept;
+    };
+}
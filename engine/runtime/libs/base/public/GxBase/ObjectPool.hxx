@@ -1,6 +1,7 @@
 #pragma once
 #include <GxBase/Base.module.hxx>
 #include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/Sync.hxx>
 #include <GxBase/Bitwise.hxx>
 #include <GxBase/Diagnostics.hxx>
 
@@ -669,3 +670,485 @@ namespace Graphyte
         }
     };
 }
+
+namespace Graphyte::Impl
+{
+    /// Number of threads which may own cache in concurrent pool containers at once.
+    constexpr const std::size_t PoolThreadSlotCount = 64;
+
+    /// Value returned when current thread has no slot.
+    constexpr const std::size_t PoolThreadSlotInvalid = ~std::size_t{};
+
+    /// @brief Gets slot of current thread in concurrent pool containers.
+    ///
+    /// Slot is acquired on first use and released when thread exits, so it may be reused by
+    /// another thread later.
+    ///
+    /// @return The slot index, or PoolThreadSlotInvalid when all slots are taken.
+    BASE_API std::size_t GetPoolThreadSlot() noexcept;
+}
+
+namespace Graphyte
+{
+    /// @brief This class is base class for pool containers shared between threads.
+    ///
+    /// Free items are cached per thread and moved between thread caches and shared depot in
+    /// batches. Depot is lock-free stack of batches; address of top batch is packed with tag
+    /// incremented on every update, so stale head is never accepted.
+    ///
+    /// Memory of pool descriptors is retained until container is destroyed, so free items may be
+    /// safely inspected by threads racing for the same batch.
+    ///
+    /// @tparam ElementCount Number of elements within single pool descriptor.
+    template <std::size_t ElementCount>
+    class ConcurrentPoolContainerBase
+    {
+        static_assert(IsPowerOf2(ElementCount));
+
+    public:
+        /// Number of elements within pool descriptor.
+        static constexpr const std::size_t PoolCapacity = ElementCount;
+
+        /// Maximum number of pool descriptors.
+        static constexpr const std::size_t MaxDescriptors = 1024;
+
+        /// Number of items moved between thread cache and depot at once.
+        static constexpr const std::size_t BatchSize = 64;
+
+    private:
+        static_assert((ElementCount * MaxDescriptors) < std::numeric_limits<std::uint32_t>::max());
+
+        /// @brief This type represents allocation address.
+        enum class Address : std::uint32_t
+        {
+            Invalid = ~std::uint32_t{},
+        };
+
+        /// @brief Represents header preceding every item.
+        struct ItemHeader final
+        {
+            /// Address of this item.
+            Address Self;
+        };
+
+        /// @brief Represents free item.
+        struct FreeItem final
+        {
+            /// Address of next item within batch.
+            Address Next;
+
+            /// Number of items in batch. Valid for first item of batch stored in depot.
+            std::uint32_t BatchCount;
+
+            /// Address of next batch in depot. Valid for first item of batch stored in depot.
+            std::atomic<std::uint32_t> NextBatch;
+        };
+
+        /// @brief Represents cache of free items owned by single thread.
+        struct alignas(GX_CACHELINE_SIZE) ThreadCache final
+        {
+            /// Address of first cached item.
+            Address Head;
+
+            /// Number of cached items.
+            std::size_t Count;
+
+            /// Number of items allocated minus number of items deallocated by owning thread.
+            std::atomic<std::ptrdiff_t> Allocated;
+        };
+
+    private:
+        ThreadCache m_Caches[Impl::PoolThreadSlotCount];
+        ThreadCache m_SharedCache;
+        Threading::SpinLock m_SharedLock;
+        alignas(GX_CACHELINE_SIZE) std::atomic<std::uint64_t> m_Depot;
+        alignas(GX_CACHELINE_SIZE) std::atomic<std::size_t> m_DescriptorCount;
+        std::atomic<std::byte*> m_Descriptors[MaxDescriptors];
+        std::size_t m_ItemSize;
+        std::size_t m_ItemOffset;
+        std::size_t m_ItemStride;
+        std::size_t m_Alignment;
+
+    private:
+        /// @brief Packs depot head from address of top batch and tag.
+        static constexpr std::uint64_t MakeDepotHead(
+            Address address,
+            std::uint32_t tag) noexcept
+        {
+            return (std::uint64_t{ tag } << 32) | static_cast<std::uint32_t>(address);
+        }
+
+        static constexpr Address GetDepotAddress(
+            std::uint64_t head) noexcept
+        {
+            return static_cast<Address>(static_cast<std::uint32_t>(head));
+        }
+
+        static constexpr std::uint32_t GetDepotTag(
+            std::uint64_t head) noexcept
+        {
+            return static_cast<std::uint32_t>(head >> 32);
+        }
+
+        /// @brief Gets allocation data for specified address.
+        std::byte* GetPoolItem(
+            Address address) const noexcept
+        {
+            GX_ASSERT(address != Address::Invalid);
+
+            const auto value = static_cast<std::size_t>(address);
+            std::byte* data  = m_Descriptors[value / ElementCount].load(std::memory_order_relaxed);
+            GX_ASSERT(data != nullptr);
+
+            return data + ((value % ElementCount) * m_ItemStride) + m_ItemOffset;
+        }
+
+        /// @brief Gets free item link for specified address.
+        FreeItem* GetPoolFreeItem(
+            Address address) const noexcept
+        {
+            return reinterpret_cast<FreeItem*>(GetPoolItem(address));
+        }
+
+        /// @brief Gets address of allocation data.
+        Address GetPoolAddress(
+            void* pointer) const noexcept
+        {
+            const auto* header    = reinterpret_cast<const ItemHeader*>(static_cast<std::byte*>(pointer) - m_ItemOffset);
+            const Address address = header->Self;
+
+            GX_ASSERTF(GetPoolItem(address) == pointer, "Provided pointer isn't in pool");
+            return address;
+        }
+
+        /// @brief Pushes batch of free items to depot.
+        ///
+        /// @param batch Provides address of first item in batch.
+        /// @param count Provides number of items in batch.
+        void ReleaseBatch(
+            Address batch,
+            std::size_t count) noexcept
+        {
+            GX_ASSERT(batch != Address::Invalid);
+            GX_ASSERT(count != 0);
+
+            FreeItem* item   = GetPoolFreeItem(batch);
+            item->BatchCount = static_cast<std::uint32_t>(count);
+
+            std::uint64_t head = m_Depot.load(std::memory_order_relaxed);
+
+            do
+            {
+                item->NextBatch.store(static_cast<std::uint32_t>(GetDepotAddress(head)), std::memory_order_relaxed);
+            } while (!m_Depot.compare_exchange_weak(
+                head,
+                MakeDepotHead(batch, GetDepotTag(head) + 1),
+                std::memory_order_release,
+                std::memory_order_relaxed));
+        }
+
+        /// @brief Pops batch of free items from depot.
+        ///
+        /// @param count Returns number of items in batch.
+        ///
+        /// @return The address of first item in batch, or Address::Invalid when depot is empty.
+        Address AcquireBatch(
+            std::size_t& count) noexcept
+        {
+            std::uint64_t head = m_Depot.load(std::memory_order_acquire);
+
+            while (GetDepotAddress(head) != Address::Invalid)
+            {
+                //
+                // Batch may be taken and its first item reused by another thread before exchange
+                // below. Read link is then stale, but exchange fails because tag changed.
+                //
+
+                const Address batch = GetDepotAddress(head);
+                const auto next     = static_cast<Address>(GetPoolFreeItem(batch)->NextBatch.load(std::memory_order_relaxed));
+
+                if (m_Depot.compare_exchange_weak(
+                        head,
+                        MakeDepotHead(next, GetDepotTag(head) + 1),
+                        std::memory_order_acquire,
+                        std::memory_order_acquire))
+                {
+                    count = GetPoolFreeItem(batch)->BatchCount;
+                    return batch;
+                }
+            }
+
+            return Address::Invalid;
+        }
+
+        /// @brief Allocates new pool descriptor.
+        ///
+        /// @param count Returns number of items in returned batch.
+        ///
+        /// @return The address of first batch of new descriptor, or Address::Invalid when pool
+        ///         reached its capacity. Remaining batches are released to depot.
+        Address AllocateDescriptor(
+            std::size_t& count) noexcept
+        {
+            std::size_t index = m_DescriptorCount.load(std::memory_order_relaxed);
+
+            do
+            {
+                if (index >= MaxDescriptors)
+                {
+                    return Address::Invalid;
+                }
+            } while (!m_DescriptorCount.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+            //
+            // Allocate buffer and write headers of all items.
+            //
+
+            std::byte* data = static_cast<std::byte*>(::operator new(
+                m_ItemStride * ElementCount,
+                std::align_val_t{ m_Alignment }));
+
+            m_Descriptors[index].store(data, std::memory_order_release);
+
+            const std::size_t base = index * ElementCount;
+
+            for (std::size_t i = 0; i < ElementCount; ++i)
+            {
+                reinterpret_cast<ItemHeader*>(data + (i * m_ItemStride))->Self = static_cast<Address>(base + i);
+            }
+
+            //
+            // Split descriptor into batches. First batch is returned to caller, remaining ones
+            // are stored in depot.
+            //
+
+            Address result{ Address::Invalid };
+
+            for (std::size_t first = 0; first < ElementCount; first += BatchSize)
+            {
+                const std::size_t last = std::min(first + BatchSize, ElementCount);
+
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    GetPoolFreeItem(static_cast<Address>(base + i))->Next = (i + 1 < last)
+                                                                                 ? static_cast<Address>(base + i + 1)
+                                                                                 : Address::Invalid;
+                }
+
+                if (result == Address::Invalid)
+                {
+                    result = static_cast<Address>(base + first);
+                    count  = last - first;
+                }
+                else
+                {
+                    ReleaseBatch(static_cast<Address>(base + first), last - first);
+                }
+            }
+
+            return result;
+        }
+
+        /// @brief Allocates item from thread cache.
+        void* AllocateItem(
+            ThreadCache& cache) noexcept
+        {
+            if (cache.Head == Address::Invalid)
+            {
+                Address batch = AcquireBatch(cache.Count);
+
+                if (batch == Address::Invalid)
+                {
+                    batch = AllocateDescriptor(cache.Count);
+
+                    if (batch == Address::Invalid)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                cache.Head = batch;
+            }
+
+            std::byte* item = GetPoolItem(cache.Head);
+            cache.Head      = reinterpret_cast<FreeItem*>(item)->Next;
+            --cache.Count;
+
+            cache.Allocated.store(cache.Allocated.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            return item;
+        }
+
+        /// @brief Deallocates item to thread cache.
+        void DeallocateItem(
+            ThreadCache& cache,
+            void* pointer) noexcept
+        {
+            const Address address = GetPoolAddress(pointer);
+
+            static_cast<FreeItem*>(pointer)->Next = cache.Head;
+            cache.Head                            = address;
+
+            cache.Allocated.store(cache.Allocated.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+            if (++cache.Count >= (BatchSize * 2))
+            {
+                //
+                // Keep most recently used items in cache and move surplus to depot.
+                //
+
+                FreeItem* keep = GetPoolFreeItem(cache.Head);
+
+                for (std::size_t i = 1; i < BatchSize; ++i)
+                {
+                    keep = GetPoolFreeItem(keep->Next);
+                }
+
+                const Address batch = keep->Next;
+                keep->Next          = Address::Invalid;
+
+                const std::size_t count = cache.Count - BatchSize;
+                cache.Count             = BatchSize;
+
+                ReleaseBatch(batch, count);
+            }
+        }
+
+    public:
+        /// @brief Initializes new instance of ConcurrentPoolContainerBase for specified item size.
+        ///
+        /// @param size      Provides size of item in pool.
+        /// @param alignment Provides alignment of item in pool.
+        ConcurrentPoolContainerBase(
+            std::size_t size,
+            std::size_t alignment) noexcept
+            : m_Caches{}
+            , m_SharedCache{}
+            , m_SharedLock{}
+            , m_Depot{ MakeDepotHead(Address::Invalid, 0) }
+            , m_DescriptorCount{}
+            , m_Descriptors{}
+            , m_ItemSize{ std::max(size, sizeof(FreeItem)) }
+            , m_ItemOffset{}
+            , m_ItemStride{}
+            , m_Alignment{ std::max({ alignment, alignof(FreeItem), alignof(ItemHeader) }) }
+        {
+            GX_ASSERT(IsPowerOf2(alignment));
+
+            m_ItemOffset = AlignUp(sizeof(ItemHeader), m_Alignment);
+            m_ItemStride = AlignUp(m_ItemOffset + m_ItemSize, m_Alignment);
+
+            m_SharedCache.Head = Address::Invalid;
+
+            for (ThreadCache& cache : m_Caches)
+            {
+                cache.Head = Address::Invalid;
+            }
+        }
+
+        ConcurrentPoolContainerBase(const ConcurrentPoolContainerBase&) = delete;
+        ConcurrentPoolContainerBase& operator=(const ConcurrentPoolContainerBase&) = delete;
+
+        ~ConcurrentPoolContainerBase() noexcept
+        {
+            const std::size_t count = std::min(m_DescriptorCount.load(std::memory_order_acquire), MaxDescriptors);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (std::byte* data = m_Descriptors[i].load(std::memory_order_relaxed); data != nullptr)
+                {
+                    ::operator delete(data, std::align_val_t{ m_Alignment });
+                }
+            }
+        }
+
+        /// @brief Allocates new item in pool.
+        ///
+        /// @return The pointer to newly allocated item, or nullptr when pool reached its capacity.
+        void* DoAllocate() noexcept
+        {
+            if (const std::size_t slot = Impl::GetPoolThreadSlot(); slot != Impl::PoolThreadSlotInvalid)
+            {
+                return AllocateItem(m_Caches[slot]);
+            }
+
+            Threading::ScopedLock<Threading::SpinLock> lock{ m_SharedLock };
+            return AllocateItem(m_SharedCache);
+        }
+
+        /// @brief Deallocates item from pool.
+        ///
+        /// @param pointer Provides pointer to item to deallocate. May be allocated by other thread.
+        void DoDeallocate(void* pointer) noexcept
+        {
+            GX_ASSERT(pointer != nullptr);
+
+            if (const std::size_t slot = Impl::GetPoolThreadSlot(); slot != Impl::PoolThreadSlotInvalid)
+            {
+                DeallocateItem(m_Caches[slot], pointer);
+            }
+            else
+            {
+                Threading::ScopedLock<Threading::SpinLock> lock{ m_SharedLock };
+                DeallocateItem(m_SharedCache, pointer);
+            }
+        }
+
+        /// @brief Gets item size.
+        std::size_t GetItemSize() const noexcept
+        {
+            return m_ItemSize;
+        }
+
+        /// @brief Gets number of elements within pool.
+        ///
+        /// @remarks Value is approximate while other threads modify pool.
+        std::size_t GetCount() const noexcept
+        {
+            std::ptrdiff_t result = m_SharedCache.Allocated.load(std::memory_order_relaxed);
+
+            for (const ThreadCache& cache : m_Caches)
+            {
+                result += cache.Allocated.load(std::memory_order_relaxed);
+            }
+
+            return static_cast<std::size_t>(std::max<std::ptrdiff_t>(result, 0));
+        }
+
+        /// @brief Gets capacity of pool collection.
+        std::size_t GetCapacity() const noexcept
+        {
+            return std::min(m_DescriptorCount.load(std::memory_order_relaxed), MaxDescriptors) * ElementCount;
+        }
+    };
+
+    /// @brief This class provides generic pool interface safe to use from multiple threads.
+    ///
+    /// @tparam TType        Provides type of element in pool.
+    /// @tparam ElementCount Number of elements within single pool descriptor.
+    template <typename TType, size_t ElementCount>
+    class ConcurrentPoolContainer final : public ConcurrentPoolContainerBase<ElementCount>
+    {
+    public:
+        ConcurrentPoolContainer() noexcept
+            : ConcurrentPoolContainerBase<ElementCount>{ sizeof(TType), alignof(TType) }
+        {
+        }
+
+        TType* Allocate() noexcept
+        {
+            void* memory = this->DoAllocate();
+            GX_ABORT_UNLESS(memory != nullptr, "Pool capacity exceeded");
+            return new (memory) TType();
+        }
+
+        void Deallocate(TType* pointer) noexcept
+        {
+            if (pointer != nullptr)
+            {
+                pointer->~TType();
+                this->DoDeallocate(pointer);
+            }
+        }
+    };
+}
@@ -705,6 +705,18 @@
 #endif
 
 
+// =================================================================================================
+// Memory debugging
+
+#if !defined(GX_ENABLE_MEMORY_GUARDS)
+#if GX_CONFIG_DEBUG || GX_CONFIG_CHECKED
+#define GX_ENABLE_MEMORY_GUARDS 1
+#else
+#define GX_ENABLE_MEMORY_GUARDS 0
+#endif
+#endif
+
+
 // =================================================================================================
 // Stack trace support
 
@@ -907,3 +919,4 @@
 
 
 #define GX_SDKS_WITH_ZLIB 0
+#define GX_SDKS_WITH_ZSTD 0
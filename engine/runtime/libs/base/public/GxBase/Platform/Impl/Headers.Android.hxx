@@ -36,6 +36,7 @@
 #include <locale>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <new>
 #include <queue>
 #include <set>
@@ -43,6 +44,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string_view>
 #include <optional>
@@ -28,6 +28,7 @@
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/user.h>
 #include <ucontext.h>
 #include <unistd.h>
@@ -44,6 +45,7 @@
 #include <locale>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <new>
 #include <queue>
 #include <set>
@@ -51,6 +53,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string_view>
 #include <atomic>
@@ -121,6 +121,7 @@
 #include <locale>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <new>
 #include <queue>
 #include <set>
@@ -128,6 +129,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <codecvt>
 #include <string_view>
@@ -0,0 +1,467 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Threading/Sync.hxx>
+
+namespace Graphyte
+{
+    /// @brief Represents generational handle to slot map element.
+    ///
+    /// Handle packs slot index in low bits and generation in high bits. Generation of valid handle
+    /// is never zero, so zero-initialized handle is invalid.
+    ///
+    /// @tparam TStorage  Provides underlying unsigned integer type.
+    /// @tparam IndexBits Provides number of bits used by slot index.
+    template <typename TStorage, std::size_t IndexBits>
+    struct BasicSlotHandle final
+    {
+        static_assert(std::is_unsigned_v<TStorage>);
+        static_assert(IndexBits > 0 && IndexBits < (sizeof(TStorage) * 8));
+        static_assert(IndexBits <= 32, "Slot index must fit in 32 bits");
+
+        /// Number of bits used by generation.
+        static constexpr const std::size_t GenerationBits = (sizeof(TStorage) * 8) - IndexBits;
+
+        /// Maximum number of slots addressable by handle.
+        static constexpr const std::size_t MaxSlots = std::size_t{ 1 } << IndexBits;
+
+        /// Mask of index bits.
+        static constexpr const TStorage IndexMask = static_cast<TStorage>(MaxSlots - 1);
+
+        /// Mask of generation bits, after shift.
+        static constexpr const TStorage GenerationMask = static_cast<TStorage>(~TStorage{}) >> IndexBits;
+
+        TStorage Value;
+
+        [[nodiscard]] static constexpr BasicSlotHandle Make(
+            std::uint32_t index,
+            std::uint32_t generation) noexcept
+        {
+            return BasicSlotHandle{
+                .Value = static_cast<TStorage>(
+                    (static_cast<TStorage>(generation & GenerationMask) << IndexBits) | (static_cast<TStorage>(index) & IndexMask)),
+            };
+        }
+
+        [[nodiscard]] constexpr std::uint32_t GetIndex() const noexcept
+        {
+            return static_cast<std::uint32_t>(Value & IndexMask);
+        }
+
+        [[nodiscard]] constexpr std::uint32_t GetGeneration() const noexcept
+        {
+            return static_cast<std::uint32_t>((Value >> IndexBits) & GenerationMask);
+        }
+
+        [[nodiscard]] constexpr bool IsValid() const noexcept
+        {
+            return Value != 0;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const BasicSlotHandle& other) const noexcept = default;
+    };
+
+    /// Handle addressing up to 1M slots, with 4096 generations per slot.
+    using SlotHandle32 = BasicSlotHandle<std::uint32_t, 20>;
+
+    /// Handle addressing up to 4G slots, with 4G generations per slot.
+    using SlotHandle64 = BasicSlotHandle<std::uint64_t, 32>;
+
+    /// @brief This class provides container addressed by generational handles.
+    ///
+    /// Values are stored densely in insertion order, except that erasing element moves last
+    /// element into its place. Slots map handles to values; slot generation is incremented when
+    /// element is erased, so stale handles are detected. Slot whose generation would wrap around
+    /// is retired and never reused.
+    ///
+    /// Insertion, erasure and lookup are O(1). Pointers to values are invalidated by insertion and
+    /// erasure; handles stay valid until element is erased.
+    ///
+    /// @tparam TValue  Provides type of element.
+    /// @tparam THandle Provides handle type.
+    template <typename TValue, typename THandle = SlotHandle64>
+    class SlotMap final
+    {
+    public:
+        using value_type     = TValue;
+        using handle_type    = THandle;
+        using iterator       = typename std::vector<TValue>::iterator;
+        using const_iterator = typename std::vector<TValue>::const_iterator;
+
+    private:
+        static constexpr const std::uint32_t InvalidIndex = ~std::uint32_t{};
+
+        /// @brief Represents slot.
+        struct Slot final
+        {
+            /// Current generation of slot. Zero for retired slot.
+            std::uint32_t Generation;
+
+            /// Index of value when slot is used, index of next free slot otherwise.
+            std::uint32_t Index;
+        };
+
+    private:
+        std::vector<TValue> m_Values;
+        std::vector<std::uint32_t> m_ValueSlots;
+        std::vector<Slot> m_Slots;
+        std::uint32_t m_FreeHead;
+        std::uint32_t m_FreeTail;
+
+    public:
+        SlotMap() noexcept
+            : m_Values{}
+            , m_ValueSlots{}
+            , m_Slots{}
+            , m_FreeHead{ InvalidIndex }
+            , m_FreeTail{ InvalidIndex }
+        {
+        }
+
+    private:
+        /// @brief Finds slot of valid handle.
+        ///
+        /// @return The pointer to slot, or nullptr when handle is stale or invalid.
+        const Slot* Find(
+            THandle handle) const noexcept
+        {
+            const std::uint32_t index = handle.GetIndex();
+
+            if (handle.IsValid() && index < m_Slots.size())
+            {
+                const Slot& slot = m_Slots[index];
+
+                if (slot.Generation == handle.GetGeneration() && slot.Index < m_ValueSlots.size() && m_ValueSlots[slot.Index] == index)
+                {
+                    return &slot;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /// @brief Acquires free slot.
+        ///
+        /// @return The index of slot, or InvalidIndex when all slots are used.
+        std::uint32_t AcquireSlot() noexcept
+        {
+            if (m_FreeHead != InvalidIndex)
+            {
+                //
+                // Reuse oldest free slot, so generations of all slots advance evenly.
+                //
+
+                const std::uint32_t index = m_FreeHead;
+                m_FreeHead                = m_Slots[index].Index;
+
+                if (m_FreeHead == InvalidIndex)
+                {
+                    m_FreeTail = InvalidIndex;
+                }
+
+                return index;
+            }
+
+            if (m_Slots.size() >= std::min<std::size_t>(THandle::MaxSlots, InvalidIndex))
+            {
+                return InvalidIndex;
+            }
+
+            m_Slots.push_back(Slot{ .Generation = 1, .Index = InvalidIndex });
+            return static_cast<std::uint32_t>(m_Slots.size() - 1);
+        }
+
+        /// @brief Releases slot and advances its generation.
+        void ReleaseSlot(
+            std::uint32_t index) noexcept
+        {
+            Slot& slot = m_Slots[index];
+
+            slot.Generation = (slot.Generation + 1) & static_cast<std::uint32_t>(THandle::GenerationMask);
+            slot.Index      = InvalidIndex;
+
+            if (slot.Generation == 0)
+            {
+                //
+                // Generation wrapped around. Retire slot, so stale handles never match.
+                //
+
+                return;
+            }
+
+            if (m_FreeTail != InvalidIndex)
+            {
+                m_Slots[m_FreeTail].Index = index;
+            }
+            else
+            {
+                m_FreeHead = index;
+            }
+
+            m_FreeTail = index;
+        }
+
+    public:
+        /// @brief Inserts new element.
+        ///
+        /// @return The handle to new element, or invalid handle when all slots are used.
+        template <typename... TArgs>
+        THandle Insert(
+            TArgs&&... args) noexcept
+        {
+            const std::uint32_t index = AcquireSlot();
+
+            if (index == InvalidIndex)
+            {
+                return THandle{};
+            }
+
+            Slot& slot = m_Slots[index];
+            slot.Index = static_cast<std::uint32_t>(m_Values.size());
+
+            m_Values.emplace_back(std::forward<TArgs>(args)...);
+            m_ValueSlots.push_back(index);
+
+            return THandle::Make(index, slot.Generation);
+        }
+
+        /// @brief Erases element.
+        ///
+        /// @return The value indicating whether handle referenced existing element.
+        bool Erase(
+            THandle handle) noexcept
+        {
+            const Slot* slot = Find(handle);
+
+            if (slot == nullptr)
+            {
+                return false;
+            }
+
+            const std::uint32_t position = slot->Index;
+            const std::uint32_t last     = static_cast<std::uint32_t>(m_Values.size() - 1);
+
+            if (position != last)
+            {
+                //
+                // Move last value into erased position.
+                //
+
+                m_Values[position]     = std::move(m_Values[last]);
+                m_ValueSlots[position] = m_ValueSlots[last];
+
+                m_Slots[m_ValueSlots[position]].Index = position;
+            }
+
+            m_Values.pop_back();
+            m_ValueSlots.pop_back();
+
+            ReleaseSlot(handle.GetIndex());
+            return true;
+        }
+
+        /// @brief Gets element.
+        ///
+        /// @return The pointer to element, or nullptr when handle is stale or invalid.
+        [[nodiscard]] TValue* Get(
+            THandle handle) noexcept
+        {
+            const Slot* slot = Find(handle);
+            return (slot != nullptr) ? &m_Values[slot->Index] : nullptr;
+        }
+
+        /// @brief Gets element.
+        ///
+        /// @return The pointer to element, or nullptr when handle is stale or invalid.
+        [[nodiscard]] const TValue* Get(
+            THandle handle) const noexcept
+        {
+            const Slot* slot = Find(handle);
+            return (slot != nullptr) ? &m_Values[slot->Index] : nullptr;
+        }
+
+        [[nodiscard]] bool Contains(
+            THandle handle) const noexcept
+        {
+            return Find(handle) != nullptr;
+        }
+
+        /// @brief Gets handle of element at specified position of dense storage.
+        [[nodiscard]] THandle GetHandle(
+            std::size_t position) const noexcept
+        {
+            GX_ASSERT(position < m_ValueSlots.size());
+
+            const std::uint32_t index = m_ValueSlots[position];
+            return THandle::Make(index, m_Slots[index].Generation);
+        }
+
+        /// @brief Erases all elements. Handles to erased elements become stale.
+        void Clear() noexcept
+        {
+            for (std::uint32_t index : m_ValueSlots)
+            {
+                ReleaseSlot(index);
+            }
+
+            m_Values.clear();
+            m_ValueSlots.clear();
+        }
+
+        void Reserve(
+            std::size_t capacity) noexcept
+        {
+            m_Values.reserve(capacity);
+            m_ValueSlots.reserve(capacity);
+            m_Slots.reserve(capacity);
+        }
+
+        [[nodiscard]] std::size_t GetCount() const noexcept
+        {
+            return m_Values.size();
+        }
+
+        [[nodiscard]] bool IsEmpty() const noexcept
+        {
+            return m_Values.empty();
+        }
+
+        /// @brief Gets dense storage of elements.
+        [[nodiscard]] std::span<TValue> GetValues() noexcept
+        {
+            return m_Values;
+        }
+
+        /// @brief Gets dense storage of elements.
+        [[nodiscard]] std::span<const TValue> GetValues() const noexcept
+        {
+            return m_Values;
+        }
+
+    public:
+        [[nodiscard]] iterator begin() noexcept
+        {
+            return m_Values.begin();
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return m_Values.end();
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return m_Values.begin();
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return m_Values.end();
+        }
+    };
+
+    /// @brief This class provides slot map safe to use from multiple threads.
+    ///
+    /// Elements are accessed through callbacks invoked under lock, because pointers to elements
+    /// are invalidated by concurrent insertion and erasure. Lookups share reader lock.
+    ///
+    /// @tparam TValue  Provides type of element.
+    /// @tparam THandle Provides handle type.
+    template <typename TValue, typename THandle = SlotHandle64>
+    class ConcurrentSlotMap final
+    {
+    private:
+        SlotMap<TValue, THandle> m_Map;
+        mutable Threading::ReaderWriterLock m_Lock;
+
+    public:
+        ConcurrentSlotMap() noexcept = default;
+
+    public:
+        /// @brief Inserts new element.
+        ///
+        /// @return The handle to new element, or invalid handle when all slots are used.
+        template <typename... TArgs>
+        THandle Insert(
+            TArgs&&... args) noexcept
+        {
+            Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+            return m_Map.Insert(std::forward<TArgs>(args)...);
+        }
+
+        /// @brief Erases element.
+        ///
+        /// @return The value indicating whether handle referenced existing element.
+        bool Erase(
+            THandle handle) noexcept
+        {
+            Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+            return m_Map.Erase(handle);
+        }
+
+        /// @brief Invokes callback with element referenced by handle.
+        ///
+        /// @return The value indicating whether callback was invoked.
+        template <typename TCallback>
+        bool Visit(
+            THandle handle,
+            TCallback&& callback) const noexcept
+        {
+            Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+            if (const TValue* value = m_Map.Get(handle); value != nullptr)
+            {
+                callback(*value);
+                return true;
+            }
+
+            return false;
+        }
+
+        /// @brief Copies element referenced by handle.
+        ///
+        /// @return The value indicating whether element was copied.
+        bool TryGet(
+            THandle handle,
+            TValue& result) const noexcept
+        {
+            return Visit(handle, [&](const TValue& value) {
+                result = value;
+            });
+        }
+
+        /// @brief Invokes callback with every element and its handle.
+        template <typename TCallback>
+        void ForEach(
+            TCallback&& callback) const noexcept
+        {
+            Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+
+            std::span<const TValue> const values = m_Map.GetValues();
+
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                callback(m_Map.GetHandle(i), values[i]);
+            }
+        }
+
+        [[nodiscard]] bool Contains(
+            THandle handle) const noexcept
+        {
+            Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+            return m_Map.Contains(handle);
+        }
+
+        [[nodiscard]] std::size_t GetCount() const noexcept
+        {
+            Threading::ScopedReaderLock<Threading::ReaderWriterLock> lock{ m_Lock };
+            return m_Map.GetCount();
+        }
+
+        void Clear() noexcept
+        {
+            Threading::ScopedWriterLock<Threading::ReaderWriterLock> lock{ m_Lock };
+            m_Map.Clear();
+        }
+    };
+}
@@ -38,5 +38,6 @@ namespace Graphyte
         StackOverflow,
         InvalidInstruction,
         FloatingPointError,
+        Cancelled,
     };
 }
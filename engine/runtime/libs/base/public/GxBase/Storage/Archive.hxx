@@ -62,6 +62,12 @@ namespace Graphyte::Storage
             return m_Error;
         }
 
+        /// @brief Marks archive as failed, eg. when loaded data is invalid.
+        void SetError() noexcept
+        {
+            m_Error = true;
+        }
+
         bool IsPersistent() const noexcept
         {
             return m_Persistent;
@@ -2,22 +2,53 @@
 #include <GxBase/Storage/Archive.hxx>
 #include <GxBase/Storage/IStream.hxx>
 
+namespace Graphyte::Storage::Impl
+{
+    class ArchiveWriteBehind;
+}
+
 namespace Graphyte::Storage
 {
+    /// @brief Specifies buffering of archive file writer.
+    struct ArchiveFileWriterOptions final
+    {
+        /// @brief Size of write buffer, in bytes.
+        ///
+        /// Writes larger than buffer are submitted directly, together with buffered data.
+        size_t BufferSize{ 64 << 10 };
+
+        /// @brief Writes filled buffer on background thread while next one is filled.
+        bool WriteBehind{ false };
+
+        /// @brief Synchronization requested after each buffer is written.
+        StreamSync BufferSync{ StreamSync::None };
+
+        /// @brief Synchronization requested on flush.
+        StreamSync FlushSync{ StreamSync::Full };
+    };
+
     class BASE_API ArchiveFileWriter : public Archive
     {
     private:
-        static constexpr const size_t BufferSize = 1 * 4096;
         std::unique_ptr<IStream> m_Stream;
-        int64_t m_Position;
+        std::unique_ptr<Impl::ArchiveWriteBehind> m_WriteBehind;
+        std::unique_ptr<std::byte[]> m_Buffer;
+        size_t m_BufferSize;
         size_t m_BufferCount;
-        std::array<std::byte, BufferSize> m_Buffer;
+        int64_t m_Position;
+        StreamSync m_BufferSync;
+        StreamSync m_FlushSync;
 
     public:
         ArchiveFileWriter(
             std::unique_ptr<IStream> stream,
             int64_t position = 0) noexcept;
 
+        ArchiveFileWriter(
+            std::unique_ptr<IStream> stream,
+            const ArchiveFileWriterOptions& options,
+            int64_t position = 0) noexcept;
+
         virtual ~ArchiveFileWriter() noexcept;
 
     public:
@@ -33,5 +64,13 @@ namespace Graphyte::Storage
             int64_t position) noexcept override;
 
         virtual void Flush() noexcept override;
+
+    private:
+        void SubmitBuffer() noexcept;
+
+        void Drain() noexcept;
+
+        void WriteDirect(
+            std::span<const std::byte> buffer) noexcept;
     };
 }
@@ -0,0 +1,57 @@
+#pragma once
+#include <GxBase/Storage/Archive.hxx>
+#include <GxBase/Storage/IMappedFile.hxx>
+
+namespace Graphyte::Storage
+{
+    /// @brief Reads archive directly from memory view.
+    ///
+    /// Data may be referenced in place with ReadView, without copying it to intermediate buffers.
+    class BASE_API ArchiveMappedReader final : public Archive
+    {
+    private:
+        std::unique_ptr<IMappedFile> m_File;
+        std::span<const std::byte> m_View;
+        size_t m_Position;
+
+    public:
+        /// @brief Creates archive reader over mapped file. Reader takes ownership of mapping.
+        explicit ArchiveMappedReader(
+            std::unique_ptr<IMappedFile> file,
+            bool persistent = false) noexcept;
+
+        /// @brief Creates archive reader over memory view. View must outlive reader.
+        explicit ArchiveMappedReader(
+            std::span<const std::byte> view,
+            bool persistent = false) noexcept;
+
+        virtual ~ArchiveMappedReader() noexcept;
+
+    public:
+        virtual void Serialize(
+            void* buffer,
+            size_t size) noexcept override;
+
+        virtual int64_t GetPosition() noexcept override;
+
+        virtual int64_t GetSize() noexcept override;
+
+        virtual void SetPosition(
+            int64_t position) noexcept override;
+
+    public:
+        /// @brief Gets whole view of archive.
+        [[nodiscard]] std::span<const std::byte> GetView() const noexcept
+        {
+            return m_View;
+        }
+
+        /// @brief Gets view of data at current position and advances position past it.
+        ///
+        /// @param size Provides size of data.
+        ///
+        /// @return The view of data, or empty view when archive is too small.
+        [[nodiscard]] std::span<const std::byte> ReadView(
+            size_t size) noexcept;
+    };
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Status.hxx>
+#include <GxBase/Threading/TaskGraph.hxx>
+
+namespace Graphyte::Storage
+{
+    /// @brief Represents priority of asynchronous request.
+    enum struct AsyncIOPriority : uint32_t
+    {
+        Low,
+        Normal,
+        High,
+    };
+
+    /// @brief Represents implementation of asynchronous I/O.
+    enum struct AsyncIOBackendType : uint32_t
+    {
+        /// Native platform API when available, thread pool otherwise.
+        Native,
+
+        /// Blocking reads issued from pool of I/O threads.
+        ThreadPool,
+    };
+
+    /// @brief Callback invoked on task dispatcher when request completes.
+    ///
+    /// Status is EndOfStream when fewer bytes than requested were read.
+    using AsyncReadCallback = std::function<void(Status status, size_t processed)>;
+
+    namespace Impl
+    {
+        class AsyncRequestState;
+        class AsyncIOQueue;
+        class AsyncIOBackend;
+    }
+
+    /// @brief Represents file opened for asynchronous reads.
+    ///
+    /// File must outlive all requests issued for it.
+    class BASE_API AsyncFile final
+    {
+    private:
+        uintptr_t m_Handle;
+        int64_t m_Size;
+
+    public:
+        AsyncFile(uintptr_t handle, int64_t size) noexcept;
+        ~AsyncFile() noexcept;
+
+        AsyncFile(const AsyncFile&) = delete;
+        AsyncFile& operator=(const AsyncFile&) = delete;
+
+    public:
+        [[nodiscard]] uintptr_t GetHandle() const noexcept
+        {
+            return m_Handle;
+        }
+
+        [[nodiscard]] int64_t GetSize() const noexcept
+        {
+            return m_Size;
+        }
+    };
+
+    /// @brief Describes single read request.
+    struct AsyncReadDesc final
+    {
+        AsyncFile* File;
+        int64_t Offset;
+        std::span<std::byte> Buffer;
+        AsyncIOPriority Priority{ AsyncIOPriority::Normal };
+        AsyncReadCallback Callback;
+    };
+
+    /// @brief Represents handle to asynchronous request.
+    ///
+    /// Request completes after its callback returns. Buffer must stay valid until then.
+    class BASE_API AsyncRequest final
+    {
+    private:
+        Impl::AsyncRequestState* m_State;
+
+    public:
+        AsyncRequest() noexcept;
+        explicit AsyncRequest(Impl::AsyncRequestState* state) noexcept;
+        AsyncRequest(const AsyncRequest& other) noexcept;
+        AsyncRequest(AsyncRequest&& other) noexcept;
+        AsyncRequest& operator=(const AsyncRequest& other) noexcept;
+        AsyncRequest& operator=(AsyncRequest&& other) noexcept;
+        ~AsyncRequest() noexcept;
+
+    public:
+        void Swap(AsyncRequest& other) noexcept
+        {
+            std::swap(m_State, other.m_State);
+        }
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return m_State != nullptr;
+        }
+
+        [[nodiscard]] bool IsCompleted() const noexcept;
+
+        /// @brief Gets status of completed request.
+        [[nodiscard]] Status GetStatus() const noexcept;
+
+        /// @brief Gets number of bytes read by completed request.
+        [[nodiscard]] size_t GetProcessed() const noexcept;
+
+        /// @brief Waits for request completion, executing pending tasks in meantime.
+        void Wait() const noexcept;
+
+        /// @brief Cancels request which was not issued to device yet.
+        ///
+        /// Cancelled request completes with Status::Cancelled.
+        ///
+        /// @return The value indicating whether request was cancelled.
+        bool Cancel() const noexcept;
+
+        /// @brief Gets task completed with request. May be used as dependency of other tasks.
+        [[nodiscard]] Threading::TaskHandle GetTask() const noexcept;
+    };
+
+    /// @brief Provides asynchronous file reads.
+    ///
+    /// Pending requests are issued in priority order. Requests for adjacent ranges of same file
+    /// are coalesced into single vectored read. Completion callbacks run on task dispatcher.
+    class BASE_API AsyncIO final
+    {
+    private:
+        std::unique_ptr<Impl::AsyncIOQueue> m_Queue;
+        std::unique_ptr<Impl::AsyncIOBackend> m_Backend;
+        Threading::TaskDispatcher* m_Dispatcher;
+
+    public:
+        AsyncIO() noexcept;
+        ~AsyncIO() noexcept;
+
+        AsyncIO(const AsyncIO&) = delete;
+        AsyncIO& operator=(const AsyncIO&) = delete;
+
+    public:
+        static AsyncIO& GetInstance() noexcept;
+        static void Initialize() noexcept;
+        static void Finalize() noexcept;
+
+    public:
+        /// @brief Starts I/O threads.
+        ///
+        /// @param dispatcher Provides dispatcher running completion callbacks.
+        /// @param type       Provides requested backend type.
+        void Start(Threading::TaskDispatcher& dispatcher, AsyncIOBackendType type = AsyncIOBackendType::Native) noexcept;
+
+        /// @brief Stops I/O threads. Requests which were not issued yet are cancelled.
+        void Stop() noexcept;
+
+        /// @brief Gets name of active backend.
+        [[nodiscard]] std::string_view GetBackendName() const noexcept;
+
+    public:
+        /// @brief Opens file for asynchronous reads.
+        ///
+        /// @param result Returns opened file.
+        /// @param path   Provides path to file.
+        ///
+        /// @return The status code.
+        Status Open(
+            std::unique_ptr<AsyncFile>& result,
+            std::string_view path) noexcept;
+
+        /// @brief Submits single read request.
+        ///
+        /// @param desc Provides request description.
+        ///
+        /// @return The handle to request.
+        AsyncRequest Read(
+            const AsyncReadDesc& desc) noexcept;
+
+        /// @brief Submits batch of read requests at once.
+        ///
+        /// @param results Returns handles to requests. Must be of same size as descriptions.
+        /// @param descs   Provides request descriptions.
+        void Read(
+            std::span<AsyncRequest> results,
+            std::span<const AsyncReadDesc> descs) noexcept;
+
+        /// @brief Hints that specified range of file will be read soon.
+        ///
+        /// @param file   Provides file.
+        /// @param offset Provides offset of range.
+        /// @param size   Provides size of range.
+        void ReadAhead(
+            const AsyncFile& file,
+            int64_t offset,
+            size_t size) noexcept;
+    };
+}
@@ -2,8 +2,15 @@
 #include <GxBase/Base.module.hxx>
 #include <GxBase/Storage/Archive.hxx>
 #include <GxBase/Storage/IStream.hxx>
+#include <GxBase/Storage/IMappedFile.hxx>
 #include <GxBase/Status.hxx>
 
+namespace Graphyte::Storage
+{
+    class VirtualFileSystem;
+    struct ArchiveFileWriterOptions;
+}
+
 namespace Graphyte::Storage
 {
     extern BASE_API std::string GetRootDirectory() noexcept;
@@ -36,6 +43,12 @@ namespace Graphyte::Storage
     extern BASE_API std::string GetUserSettingsDirectory() noexcept;
     extern BASE_API std::string GetApplicationCommonDataDirectory() noexcept;
 
+    /// @brief Gets file system combining engine and project content directories.
+    ///
+    /// Project content overrides engine content and receives written files. Packages, patches and
+    /// mods may be mounted on top of them.
+    extern BASE_API VirtualFileSystem& GetContentFileSystem() noexcept;
+
     extern BASE_API Status OpenRead(
         std::unique_ptr<IStream>& result,
         std::string_view path,
@@ -47,14 +60,31 @@ namespace Graphyte::Storage
         bool append = false,
         bool share  = false) noexcept;
 
+    extern BASE_API Status OpenMapped(
+        std::unique_ptr<IMappedFile>& result,
+        std::string_view path,
+        MappedFileAccess access = MappedFileAccess::Normal) noexcept;
+
     extern BASE_API Status CreateReader(
         std::unique_ptr<Archive>& archive,
         std::string_view path,
         bool share = false) noexcept;
 
+    extern BASE_API Status CreateMappedReader(
+        std::unique_ptr<Archive>& archive,
+        std::string_view path,
+        MappedFileAccess access = MappedFileAccess::Sequential) noexcept;
+
+    extern BASE_API Status CreateWriter(
+        std::unique_ptr<Archive>& archive,
+        std::string_view path,
+        bool append = false,
+        bool share  = false) noexcept;
+
     extern BASE_API Status CreateWriter(
         std::unique_ptr<Archive>& archive,
         std::string_view path,
+        const ArchiveFileWriterOptions& options,
         bool append = false,
         bool share  = false) noexcept;
 
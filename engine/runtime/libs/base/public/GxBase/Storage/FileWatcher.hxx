@@ -0,0 +1,89 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Status.hxx>
+
+namespace Graphyte::Storage
+{
+    enum struct FileChangeType : uint32_t
+    {
+        Added,
+        Removed,
+        Modified,
+
+        /// Changes were lost, content of watched directories must be scanned again.
+        Overflow,
+    };
+
+    /// @brief Describes change of file in watched directory.
+    struct FileChange final
+    {
+        std::string Path;
+        FileChangeType Type;
+    };
+
+    /// @brief Represents implementation of file watcher.
+    enum struct FileWatcherBackendType : uint32_t
+    {
+        /// Native platform notifications when available, polling otherwise.
+        Native,
+
+        /// Periodic scans of watched directories.
+        Polling,
+    };
+
+    namespace Impl
+    {
+        class FileWatcherBackend;
+    }
+
+    /// @brief Reports changes of files in watched directories.
+    ///
+    /// Uses native notifications when platform provides them, and periodically scans watched
+    /// directories otherwise. Changes reported by single wait are coalesced, so each file is
+    /// reported once.
+    class BASE_API FileWatcher final
+    {
+    private:
+        std::unique_ptr<Impl::FileWatcherBackend> m_Backend;
+
+    public:
+        explicit FileWatcher(
+            FileWatcherBackendType type = FileWatcherBackendType::Native) noexcept;
+
+        ~FileWatcher() noexcept;
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+    public:
+        /// @brief Gets name of active backend.
+        [[nodiscard]] std::string_view GetBackendName() const noexcept;
+
+        /// @brief Starts watching directory.
+        ///
+        /// @param path      Provides path to directory.
+        /// @param recursive Specifies whether subdirectories are watched too, including ones
+        ///                  created later.
+        ///
+        /// @return The status code.
+        Status Add(
+            std::string_view path,
+            bool recursive = false) noexcept;
+
+        /// @brief Waits for changes of files.
+        ///
+        /// @param changes Returns changes of files.
+        /// @param timeout Provides timeout in milliseconds. UINT32_MAX waits without timeout.
+        ///
+        /// @return Status::Success when changes were reported, Status::Timeout when nothing
+        ///         changed, Status::Cancelled when wait was cancelled, or error status otherwise.
+        Status Wait(
+            std::vector<FileChange>& changes,
+            uint32_t timeout) noexcept;
+
+        /// @brief Cancels wait in progress, or next one if there is none.
+        ///
+        /// @remarks May be called from any thread.
+        void Cancel() noexcept;
+    };
+}
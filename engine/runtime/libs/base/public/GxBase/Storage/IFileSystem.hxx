@@ -2,6 +2,7 @@
 #include <GxBase/Base.module.hxx>
 #include <GxBase/DateTime.hxx>
 #include <GxBase/Storage/IStream.hxx>
+#include <GxBase/Storage/IMappedFile.hxx>
 #include <GxBase/Status.hxx>
 
 namespace Graphyte::Storage
@@ -91,6 +92,20 @@ namespace Graphyte::Storage
             bool append = false,
             bool share  = false) noexcept = 0;
 
+        /// @brief Maps file into memory for read.
+        ///
+        /// @param result Returns mapped file.
+        /// @param path   Provides file path to map.
+        /// @param access Provides expected access pattern.
+        ///
+        /// @return The status code.
+        ///
+        /// @remarks Default implementation reads whole file into memory buffer.
+        virtual Status OpenMapped(
+            std::unique_ptr<IMappedFile>& result,
+            std::string_view path,
+            MappedFileAccess access = MappedFileAccess::Normal) noexcept;
+
     public:
         /// @brief Checks whether specified file is marked as read only.
         ///
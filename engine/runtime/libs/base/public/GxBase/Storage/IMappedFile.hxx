@@ -0,0 +1,38 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Status.hxx>
+
+namespace Graphyte::Storage
+{
+    /// @brief Represents expected access pattern of mapped file.
+    enum struct MappedFileAccess : uint32_t
+    {
+        /// Default access pattern.
+        Normal,
+
+        /// Mapped file is read sequentially. Pages are read ahead aggressively.
+        Sequential,
+
+        /// Mapped file is read in random order. Read ahead is disabled.
+        Random,
+    };
+
+    /// @brief This interface represents read-only view of file mapped into memory.
+    ///
+    /// View is valid as long as mapped file object is alive.
+    struct IMappedFile
+    {
+        virtual ~IMappedFile() noexcept = default;
+
+        /// @brief Gets view of whole file content.
+        virtual std::span<const std::byte> GetView() noexcept = 0;
+
+        /// @brief Hints that specified range of view will be accessed soon.
+        ///
+        /// @param offset Provides offset of range.
+        /// @param size   Provides size of range.
+        virtual void Prefetch(
+            size_t offset,
+            size_t size) noexcept = 0;
+    };
+}
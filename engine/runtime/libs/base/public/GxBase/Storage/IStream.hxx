@@ -17,6 +17,22 @@ namespace Graphyte::Storage
         End,
     };
 
+    /// @brief Specifies how written data is synchronized with storage device.
+    enum struct StreamSync : uint32_t
+    {
+        /// Data is left in system cache.
+        None,
+
+        /// Starts writeback of data without waiting for completion.
+        Writeback,
+
+        /// Writes data to device, with metadata only when needed to read data back.
+        Data,
+
+        /// Writes data and metadata to device.
+        Full,
+    };
+
     /// @brief This interface represents concept of data stream.
     struct IStream
     {
@@ -47,6 +63,55 @@ namespace Graphyte::Storage
             std::span<const std::byte> buffer,
             size_t& processed) noexcept = 0;
 
+        /// @brief Writes data from multiple buffers, in order.
+        ///
+        /// @param buffers   Provides buffers with data to write.
+        /// @param processed Returns number of bytes written.
+        ///
+        /// @return The status code.
+        ///
+        /// @remarks Default implementation writes each buffer separately. Streams may override it
+        ///          to submit all buffers with single request.
+        virtual Status WriteGather(
+            std::span<const std::span<const std::byte>> buffers,
+            size_t& processed) noexcept
+        {
+            processed = 0;
+
+            for (std::span<const std::byte> buffer : buffers)
+            {
+                size_t written{};
+
+                Status const status = Write(buffer, written);
+                processed += written;
+
+                if (status != Status::Success)
+                {
+                    return status;
+                }
+            }
+
+            return Status::Success;
+        }
+
+        /// @brief Synchronizes written data with storage device.
+        ///
+        /// @param mode Specifies synchronization mode.
+        ///
+        /// @return The status code.
+        ///
+        /// @remarks Default implementation uses Flush for data and full synchronization.
+        virtual Status Sync(
+            StreamSync mode) noexcept
+        {
+            if (mode == StreamSync::Data || mode == StreamSync::Full)
+            {
+                return Flush();
+            }
+
+            return Status::Success;
+        }
+
         /// @brief Gets size of stream.
         virtual int64_t GetSize() noexcept = 0;
 
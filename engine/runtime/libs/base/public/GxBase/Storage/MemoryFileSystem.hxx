@@ -0,0 +1,114 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Threading/Sync.hxx>
+
+namespace Graphyte::Storage
+{
+    namespace Impl
+    {
+        class MemoryFileWriter;
+    }
+
+    /// @brief Provides file system stored in memory.
+    ///
+    /// Content written to stream is published when stream is flushed or destroyed. Streams opened
+    /// for read and mapped files see snapshot of content from the moment they were opened. Parent
+    /// directories of written files are created implicitly.
+    ///
+    /// All methods are thread safe. File system must outlive streams opened for write.
+    class BASE_API MemoryFileSystem final : public IFileSystem
+    {
+        friend class Impl::MemoryFileWriter;
+
+    private:
+        struct File final
+        {
+            std::shared_ptr<const std::vector<std::byte>> Content;
+            DateTime ModificationTime;
+        };
+
+    private:
+        Threading::CriticalSection m_Lock;
+        std::map<std::string, File, std::less<>> m_Files;
+        std::set<std::string, std::less<>> m_Directories;
+        DateTime m_CreationTime;
+
+    public:
+        MemoryFileSystem() noexcept;
+        virtual ~MemoryFileSystem() noexcept;
+
+    public:
+        virtual Status OpenRead(
+            std::unique_ptr<IStream>& result,
+            std::string_view path,
+            bool share = false) noexcept override;
+
+        virtual Status OpenWrite(
+            std::unique_ptr<IStream>& result,
+            std::string_view path,
+            bool append = false,
+            bool share  = false) noexcept override;
+
+        virtual Status OpenMapped(
+            std::unique_ptr<IMappedFile>& result,
+            std::string_view path,
+            MappedFileAccess access = MappedFileAccess::Normal) noexcept override;
+
+    public:
+        virtual Status IsReadonly(
+            bool& result,
+            std::string_view path) noexcept override;
+
+        virtual Status SetReadonly(
+            std::string_view path,
+            bool value) noexcept override;
+
+        virtual Status GetFileInfo(
+            FileInfo& result,
+            std::string_view path) noexcept override;
+
+        virtual Status GetFileSize(
+            int64_t& result,
+            std::string_view path) noexcept override;
+
+        virtual Status Exists(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status FileMove(
+            std::string_view destination,
+            std::string_view source) noexcept override;
+
+        virtual Status FileDelete(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status DirectoryCreate(
+            std::string_view path) noexcept override;
+
+        virtual Status DirectoryDelete(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status Enumerate(
+            std::string_view path,
+            IDirectoryVisitor& visitor) noexcept override;
+
+        virtual Status Enumerate(
+            std::string_view path,
+            IDirectoryInfoVisitor& visitor) noexcept override;
+
+    private:
+        void Publish(
+            const std::string& path,
+            std::shared_ptr<const std::vector<std::byte>> content) noexcept;
+
+        [[nodiscard]] bool IsDirectory(
+            std::string_view path) const noexcept;
+
+        Status EnumerateChildren(
+            std::string_view path,
+            std::vector<std::pair<std::string, bool>>& children) noexcept;
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+
+namespace Graphyte::Storage
+{
+    namespace Impl
+    {
+        struct PackageEntry;
+    }
+
+    /// @brief Provides read-only file system over package file.
+    ///
+    /// Package stores many files in single container, with sorted index of entries keyed by hash of
+    /// normalized path. Paths are relative to package root and are matched ignoring case.
+    ///
+    /// Package file is mapped into memory. Uncompressed entries are mapped in place; compressed
+    /// entries are split into independently compressed blocks, so streams may seek without
+    /// decompressing preceding data.
+    ///
+    /// All methods are thread safe. Streams and mapped files opened from package keep it mapped.
+    class BASE_API PackageFileSystem final : public IFileSystem
+    {
+    private:
+        struct DirectoryChild final
+        {
+            std::string_view Path;
+            bool IsDirectory;
+        };
+
+    private:
+        std::shared_ptr<IMappedFile> m_File;
+        std::span<const Impl::PackageEntry> m_Entries;
+        std::span<const uint64_t> m_Blocks;
+        std::string_view m_Names;
+        DateTime m_Timestamp;
+        std::unordered_map<std::string, std::vector<DirectoryChild>> m_Directories;
+
+    public:
+        PackageFileSystem() noexcept;
+        virtual ~PackageFileSystem() noexcept;
+
+    public:
+        /// @brief Opens package file.
+        ///
+        /// @param result Returns package file system.
+        /// @param path   Provides path to package file.
+        ///
+        /// @return The status code.
+        static Status Open(
+            std::unique_ptr<PackageFileSystem>& result,
+            std::string_view path) noexcept;
+
+        /// @brief Opens package from mapped file.
+        ///
+        /// @param result Returns package file system.
+        /// @param file   Provides mapped package file.
+        ///
+        /// @return The status code.
+        static Status Open(
+            std::unique_ptr<PackageFileSystem>& result,
+            std::unique_ptr<IMappedFile> file) noexcept;
+
+    public:
+        /// @brief Gets number of files stored in package.
+        [[nodiscard]] size_t GetFileCount() const noexcept
+        {
+            return m_Entries.size();
+        }
+
+    public:
+        virtual Status OpenRead(
+            std::unique_ptr<IStream>& result,
+            std::string_view path,
+            bool share = false) noexcept override;
+
+        virtual Status OpenWrite(
+            std::unique_ptr<IStream>& result,
+            std::string_view path,
+            bool append = false,
+            bool share  = false) noexcept override;
+
+        /// @remarks Compressed entries are decompressed into memory buffer.
+        virtual Status OpenMapped(
+            std::unique_ptr<IMappedFile>& result,
+            std::string_view path,
+            MappedFileAccess access = MappedFileAccess::Normal) noexcept override;
+
+    public:
+        virtual Status IsReadonly(
+            bool& result,
+            std::string_view path) noexcept override;
+
+        virtual Status SetReadonly(
+            std::string_view path,
+            bool value) noexcept override;
+
+        virtual Status GetFileInfo(
+            FileInfo& result,
+            std::string_view path) noexcept override;
+
+        virtual Status GetFileSize(
+            int64_t& result,
+            std::string_view path) noexcept override;
+
+        virtual Status Exists(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status FileCopy(
+            std::string_view destination,
+            std::string_view source) noexcept override;
+
+        virtual Status FileMove(
+            std::string_view destination,
+            std::string_view source) noexcept override;
+
+        virtual Status FileDelete(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status DirectoryCreate(
+            std::string_view path) noexcept override;
+
+        virtual Status DirectoryDelete(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status Enumerate(
+            std::string_view path,
+            IDirectoryVisitor& visitor) noexcept override;
+
+        virtual Status Enumerate(
+            std::string_view path,
+            IDirectoryInfoVisitor& visitor) noexcept override;
+
+    private:
+        Status Load(std::unique_ptr<IMappedFile> file) noexcept;
+
+        [[nodiscard]] const Impl::PackageEntry* FindEntry(std::string_view path) const noexcept;
+
+        [[nodiscard]] const std::vector<DirectoryChild>* FindDirectory(std::string_view path) const noexcept;
+
+        [[nodiscard]] std::string_view GetName(const Impl::PackageEntry& entry) const noexcept;
+
+        [[nodiscard]] std::span<const std::byte> GetStoredContent(const Impl::PackageEntry& entry) const noexcept;
+    };
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Compression.hxx>
+#include <GxBase/Storage/IStream.hxx>
+
+namespace Graphyte::Storage
+{
+    namespace Impl
+    {
+        struct PackageEntry;
+    }
+
+    /// @brief Options used to create package.
+    struct PackageWriterOptions final
+    {
+        /// Alignment of uncompressed entries in package file. Must be power of two.
+        uint32_t Alignment{ 4096 };
+
+        /// Size of independently compressed block. Rounded up to power of two.
+        size_t BlockSize{ 64 << 10 };
+
+        /// Compression parameters used for all compressed entries.
+        Compression::CompressionParameters Parameters{};
+    };
+
+    /// @brief Writes package file read by PackageFileSystem.
+    ///
+    /// Entries are compressed in parallel on task dispatcher and written immediately. Index is
+    /// written by Finish.
+    class BASE_API PackageWriter final
+    {
+    private:
+        std::unique_ptr<IStream> m_Stream;
+        PackageWriterOptions m_Options;
+        std::vector<Impl::PackageEntry> m_Entries;
+        std::vector<uint64_t> m_Blocks;
+        std::string m_Names;
+        std::unordered_set<std::string> m_Paths;
+        uint64_t m_Position;
+        uint32_t m_AlignmentLog2;
+        uint32_t m_BlockSizeLog2;
+        Status m_Status;
+        bool m_Finished;
+
+    public:
+        PackageWriter(
+            std::unique_ptr<IStream> stream,
+            const PackageWriterOptions& options = {}) noexcept;
+
+        ~PackageWriter() noexcept;
+
+        PackageWriter(const PackageWriter&) = delete;
+        PackageWriter& operator=(const PackageWriter&) = delete;
+
+    public:
+        /// @brief Creates package file.
+        ///
+        /// @param result  Returns package writer.
+        /// @param path    Provides path to package file.
+        /// @param options Provides package options.
+        ///
+        /// @return The status code.
+        static Status Create(
+            std::unique_ptr<PackageWriter>& result,
+            std::string_view path,
+            const PackageWriterOptions& options = {}) noexcept;
+
+    public:
+        /// @brief Adds entry to package.
+        ///
+        /// @param path    Provides path of entry in package.
+        /// @param content Provides entry content.
+        /// @param method  Provides compression method, or none when entry is stored uncompressed.
+        ///                Entry is stored uncompressed anyway when compression does not reduce its
+        ///                size.
+        ///
+        /// @return The status code. Method not available in this build fails with
+        ///         Status::NotSupported.
+        Status Add(
+            std::string_view path,
+            std::span<const std::byte> content,
+            std::optional<Compression::CompressionMethod> method = Compression::CompressionMethod::Default) noexcept;
+
+        /// @brief Adds content of file to package.
+        ///
+        /// @param path   Provides path of entry in package.
+        /// @param source Provides path to file.
+        /// @param method Provides compression method.
+        ///
+        /// @return The status code.
+        Status AddFile(
+            std::string_view path,
+            std::string_view source,
+            std::optional<Compression::CompressionMethod> method = Compression::CompressionMethod::Default) noexcept;
+
+        /// @brief Writes package index and header.
+        ///
+        /// @return The status code.
+        Status Finish() noexcept;
+
+        [[nodiscard]] Status GetStatus() const noexcept
+        {
+            return m_Status;
+        }
+
+        /// @brief Gets number of entries added to package.
+        [[nodiscard]] size_t GetEntryCount() const noexcept;
+
+        /// @brief Gets number of bytes written to package so far.
+        [[nodiscard]] uint64_t GetSize() const noexcept
+        {
+            return m_Position;
+        }
+
+    private:
+        void WriteOutput(std::span<const std::byte> buffer) noexcept;
+        void WritePadding(uint64_t alignment) noexcept;
+    };
+}
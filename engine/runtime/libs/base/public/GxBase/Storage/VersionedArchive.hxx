@@ -0,0 +1,446 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Storage/Archive.hxx>
+#include <GxBase/Ieee754.hxx>
+#include <GxBase/Status.hxx>
+#include <GxBase/Types.hxx>
+
+
+// =================================================================================================
+//
+// Scalar types of serialized values.
+//
+
+namespace Graphyte::Storage
+{
+    /// @brief Specifies scalar type of trivially copyable value.
+    ///
+    /// Values of types with known scalar type, and vectors of them, are serialized with single copy
+    /// and are byte swapped per scalar when read on host with different endianness.
+    template <typename T>
+    struct SerializationScalar
+    {
+        using Type = void;
+    };
+
+    template <typename T>
+        requires(std::is_arithmetic_v<T>)
+    struct SerializationScalar<T>
+    {
+        using Type = T;
+    };
+
+    template <typename T>
+        requires(std::is_enum_v<T>)
+    struct SerializationScalar<T>
+    {
+        using Type = std::underlying_type_t<T>;
+    };
+
+    // clang-format off
+    template <> struct SerializationScalar<Half> { using Type = uint16_t; };
+    template <> struct SerializationScalar<Half2> { using Type = uint16_t; };
+    template <> struct SerializationScalar<Half3> { using Type = uint16_t; };
+    template <> struct SerializationScalar<Half4> { using Type = uint16_t; };
+    template <> struct SerializationScalar<Float1> { using Type = float; };
+    template <> struct SerializationScalar<Float2> { using Type = float; };
+    template <> struct SerializationScalar<Float3> { using Type = float; };
+    template <> struct SerializationScalar<Float4> { using Type = float; };
+    template <> struct SerializationScalar<Float1A> { using Type = float; };
+    template <> struct SerializationScalar<Float2A> { using Type = float; };
+    template <> struct SerializationScalar<Float3A> { using Type = float; };
+    template <> struct SerializationScalar<Float4A> { using Type = float; };
+    template <> struct SerializationScalar<Float3x3> { using Type = float; };
+    template <> struct SerializationScalar<Float3x4> { using Type = float; };
+    template <> struct SerializationScalar<Float4x3> { using Type = float; };
+    template <> struct SerializationScalar<Float4x4> { using Type = float; };
+    template <> struct SerializationScalar<Float3x3A> { using Type = float; };
+    template <> struct SerializationScalar<Float3x4A> { using Type = float; };
+    template <> struct SerializationScalar<Float4x3A> { using Type = float; };
+    template <> struct SerializationScalar<Float4x4A> { using Type = float; };
+    template <> struct SerializationScalar<UInt1> { using Type = uint32_t; };
+    template <> struct SerializationScalar<UInt2> { using Type = uint32_t; };
+    template <> struct SerializationScalar<UInt3> { using Type = uint32_t; };
+    template <> struct SerializationScalar<UInt4> { using Type = uint32_t; };
+    template <> struct SerializationScalar<SInt1> { using Type = int32_t; };
+    template <> struct SerializationScalar<SInt2> { using Type = int32_t; };
+    template <> struct SerializationScalar<SInt3> { using Type = int32_t; };
+    template <> struct SerializationScalar<SInt4> { using Type = int32_t; };
+    template <> struct SerializationScalar<UByte4> { using Type = uint8_t; };
+    template <> struct SerializationScalar<SByte4> { using Type = int8_t; };
+    template <> struct SerializationScalar<ColorRGBA> { using Type = uint8_t; };
+    template <> struct SerializationScalar<ColorBGRA> { using Type = uint8_t; };
+    // clang-format on
+
+    template <typename T>
+    concept IsBulkSerializable = std::is_trivially_copyable_v<T>
+                                 && !std::is_void_v<typename SerializationScalar<T>::Type>
+                                 && (sizeof(T) % sizeof(typename SerializationScalar<T>::Type)) == 0;
+}
+
+namespace Graphyte::Storage::Impl
+{
+    /// @brief Reverses byte order of each scalar in buffer.
+    ///
+    /// @param buffer      Provides buffer to process in place.
+    /// @param count       Provides number of scalars in buffer.
+    /// @param scalar_size Provides size of scalar, in bytes.
+    BASE_API void ByteSwapBuffer(
+        void* buffer,
+        size_t count,
+        size_t scalar_size) noexcept;
+
+    template <typename T>
+    struct IsStdVector : std::false_type
+    {
+    };
+
+    template <typename T, typename TAllocator>
+    struct IsStdVector<std::vector<T, TAllocator>> : std::true_type
+    {
+    };
+}
+
+
+// =================================================================================================
+//
+// Versioned archive.
+//
+
+namespace Graphyte::Storage
+{
+    /// @brief Serializes objects as tagged, versioned fields.
+    ///
+    /// Object is serialized by free function found by argument dependent lookup:
+    ///
+    /// ```
+    /// void Serialize(VersionedArchive& archive, Material& value) noexcept
+    /// {
+    ///     uint32_t const version = archive.Version(2);
+    ///
+    ///     archive.Field(1, value.Name);
+    ///     archive.Field(2, value.Color);
+    ///
+    ///     if (version >= 2)
+    ///     {
+    ///         archive.Field(3, value.Roughness);
+    ///     }
+    /// }
+    /// ```
+    ///
+    /// Same function is used for saving and loading. Fields are matched by tag, so loading skips
+    /// fields unknown to reader and leaves fields missing in data unchanged. Object version stored
+    /// in data is available to reader for migrations.
+    ///
+    /// Trivially copyable values with known scalar type and vectors of them are copied in bulk.
+    /// Data is written in host byte order and swapped on read when needed.
+    class BASE_API VersionedArchive final
+    {
+    private:
+        struct FieldEntry final
+        {
+            uint32_t Tag;
+            uint32_t Size;
+            size_t Offset;
+        };
+
+        struct Scope final
+        {
+            size_t Start;
+            size_t End;
+            size_t FirstField;
+            uint32_t Version;
+        };
+
+    private:
+        std::vector<std::byte> m_Output;
+        std::span<const std::byte> m_Input;
+        std::vector<FieldEntry> m_Fields;
+        std::vector<Scope> m_Scopes;
+        size_t m_Position;
+        Status m_Status;
+        bool m_IsLoading;
+        bool m_SwapBytes;
+
+    private:
+        explicit VersionedArchive(std::vector<std::byte>&& output) noexcept;
+        explicit VersionedArchive(std::span<const std::byte> input) noexcept;
+
+    public:
+        ~VersionedArchive() noexcept;
+
+        VersionedArchive(const VersionedArchive&) = delete;
+        VersionedArchive& operator=(const VersionedArchive&) = delete;
+
+    public:
+        /// @brief Saves object to buffer.
+        ///
+        /// @param result Returns serialized data.
+        /// @param value  Provides object to save.
+        ///
+        /// @return The status code.
+        template <typename T>
+        static Status Save(
+            std::vector<std::byte>& result,
+            T& value) noexcept
+        {
+            //
+            // Reuse capacity of result buffer.
+            //
+
+            VersionedArchive archive{ std::move(result) };
+            archive.Process(value, 0);
+            return archive.FinishSave(result);
+        }
+
+        /// @brief Loads object from buffer.
+        ///
+        /// @param data  Provides serialized data.
+        /// @param value Provides object to load.
+        ///
+        /// @return The status code.
+        template <typename T>
+        static Status Load(
+            std::span<const std::byte> data,
+            T& value) noexcept
+        {
+            VersionedArchive archive{ data };
+
+            if (archive.m_Status == Status::Success)
+            {
+                archive.Process(value, archive.m_Input.size() - archive.m_Position);
+            }
+
+            return archive.m_Status;
+        }
+
+        /// @brief Saves or loads object as size prefixed block of archive.
+        ///
+        /// @param archive Provides archive.
+        /// @param value   Provides object to serialize.
+        ///
+        /// @return The status code.
+        template <typename T>
+        static Status Transfer(
+            Archive& archive,
+            T& value) noexcept
+        {
+            std::vector<std::byte> buffer{};
+
+            if (archive.IsSaving())
+            {
+                if (Status const status = Save(buffer, value); status != Status::Success)
+                {
+                    return status;
+                }
+            }
+
+            archive << buffer;
+
+            if (archive.IsError())
+            {
+                return Status::Failure;
+            }
+
+            if (archive.IsLoading())
+            {
+                return Load(buffer, value);
+            }
+
+            return Status::Success;
+        }
+
+    public:
+        [[nodiscard]] bool IsLoading() const noexcept
+        {
+            return m_IsLoading;
+        }
+
+        [[nodiscard]] bool IsSaving() const noexcept
+        {
+            return !m_IsLoading;
+        }
+
+        [[nodiscard]] Status GetStatus() const noexcept
+        {
+            return m_Status;
+        }
+
+        /// @brief Exchanges version of currently serialized object.
+        ///
+        /// @param current Provides version written when saving.
+        ///
+        /// @return The version of object in data.
+        uint32_t Version(
+            uint32_t current) noexcept;
+
+        /// @brief Serializes field of current object.
+        ///
+        /// @param tag   Provides field tag, unique within object.
+        /// @param value Provides field value.
+        ///
+        /// @return Value indicating whether field was serialized. When loading, fields missing in
+        ///         data are left unchanged.
+        template <typename T>
+        bool Field(
+            uint32_t tag,
+            T& value) noexcept
+        {
+            if (m_Status != Status::Success)
+            {
+                return false;
+            }
+
+            if (m_IsLoading)
+            {
+                size_t size{};
+
+                if (!FindField(tag, size))
+                {
+                    return false;
+                }
+
+                Process(value, size);
+            }
+            else
+            {
+                size_t const header = BeginField(tag);
+                Process(value, 0);
+                EndField(header);
+            }
+
+            return m_Status == Status::Success;
+        }
+
+    private:
+        template <typename T>
+        void Process(
+            T& value,
+            size_t size) noexcept
+        {
+            if constexpr (IsBulkSerializable<T>)
+            {
+                ProcessBulk(&value, 1, sizeof(T), sizeof(typename SerializationScalar<T>::Type), size);
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+                if (m_IsLoading)
+                {
+                    value.resize(size);
+                }
+
+                ProcessBulk(value.data(), value.size(), 1, 1, size);
+            }
+            else if constexpr (Impl::IsStdVector<T>::value)
+            {
+                using ElementType = typename T::value_type;
+
+                static_assert(!std::is_same_v<ElementType, bool>);
+
+                if constexpr (IsBulkSerializable<ElementType>)
+                {
+                    if (m_IsLoading)
+                    {
+                        if ((size % sizeof(ElementType)) != 0)
+                        {
+                            m_Status = Status::InvalidFormat;
+                            return;
+                        }
+
+                        value.resize(size / sizeof(ElementType));
+                    }
+
+                    ProcessBulk(value.data(), value.size(), sizeof(ElementType), sizeof(typename SerializationScalar<ElementType>::Type), size);
+                }
+                else
+                {
+                    //
+                    // Elements are serialized as sequence of fields with zero tag.
+                    //
+
+                    size_t const end = m_Position + size;
+
+                    uint32_t count = static_cast<uint32_t>(value.size());
+                    Process(count, m_IsLoading ? sizeof(count) : 0);
+
+                    if (m_IsLoading)
+                    {
+                        if (m_Status != Status::Success || count > size)
+                        {
+                            m_Status = Status::InvalidFormat;
+                            return;
+                        }
+
+                        value.resize(count);
+
+                        for (ElementType& element : value)
+                        {
+                            size_t element_size{};
+
+                            if (!NextElement(end, element_size))
+                            {
+                                return;
+                            }
+
+                            size_t const start = m_Position;
+                            Process(element, element_size);
+                            m_Position = start + element_size;
+                        }
+                    }
+                    else
+                    {
+                        for (ElementType& element : value)
+                        {
+                            size_t const header = BeginField(0);
+                            Process(element, 0);
+                            EndField(header);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                if (BeginObject(size))
+                {
+                    Serialize(*this, value);
+                    EndObject();
+                }
+            }
+        }
+
+    private:
+        void ProcessBulk(
+            void* data,
+            size_t count,
+            size_t element_size,
+            size_t scalar_size,
+            size_t size) noexcept;
+
+        size_t BeginField(
+            uint32_t tag) noexcept;
+
+        void EndField(
+            size_t header) noexcept;
+
+        bool FindField(
+            uint32_t tag,
+            size_t& size) noexcept;
+
+        bool NextElement(
+            size_t end,
+            size_t& size) noexcept;
+
+        bool BeginObject(
+            size_t size) noexcept;
+
+        void EndObject() noexcept;
+
+        Status FinishSave(
+            std::vector<std::byte>& result) noexcept;
+
+        void WriteUInt32(
+            uint32_t value) noexcept;
+
+        uint32_t ReadUInt32() noexcept;
+    };
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Threading/Sync.hxx>
+
+namespace Graphyte::Storage
+{
+    /// @brief Identifies file system mounted in virtual file system.
+    enum class MountId : uint32_t
+    {
+        Invalid = 0,
+    };
+
+    /// @brief Provides file system combining several file systems mounted with priorities.
+    ///
+    /// Each file system is mounted at virtual path prefix and translates paths below it to paths
+    /// relative to its root directory. File is read from mount with highest priority which contains
+    /// it, so patches and mods may override content without copying it. Mounts with same priority
+    /// are ordered by time of mounting; latest one wins.
+    ///
+    /// Resolved path to mount mapping is cached, including paths which were not found. Cache is
+    /// invalidated when mounts change and when files are modified through this file system;
+    /// modifications made directly on mounted file systems require explicit invalidation.
+    ///
+    /// Files are written to writable mount with highest priority. Enumeration returns union of
+    /// directory content from all mounts.
+    ///
+    /// All methods are thread safe.
+    class BASE_API VirtualFileSystem final : public IFileSystem
+    {
+    private:
+        struct MountPoint final
+        {
+            MountId Id;
+            int32_t Priority;
+            bool Writable;
+            std::string Prefix;
+            std::string Root;
+            std::shared_ptr<IFileSystem> FileSystem;
+        };
+
+        struct Resolution final
+        {
+            std::shared_ptr<IFileSystem> FileSystem;
+            std::string Path;
+            MountId Id;
+            bool Writable;
+        };
+
+    private:
+        Threading::ReaderWriterLock m_Lock;
+        std::vector<MountPoint> m_Mounts;
+        std::unordered_map<std::string, uint32_t> m_Cache;
+        uint64_t m_Generation;
+        uint32_t m_NextId;
+        DateTime m_CreationTime;
+
+    public:
+        VirtualFileSystem() noexcept;
+        virtual ~VirtualFileSystem() noexcept;
+
+    public:
+        /// @brief Mounts file system.
+        ///
+        /// @param result     Returns identifier of mount.
+        /// @param prefix     Provides virtual path at which file system is mounted.
+        /// @param filesystem Provides file system to mount.
+        /// @param root       Provides path in mounted file system which corresponds to prefix.
+        /// @param priority   Provides mount priority. Mounts with higher priority take precedence.
+        /// @param writable   Specifies whether files may be written to mounted file system.
+        ///
+        /// @return The status code.
+        Status Mount(
+            MountId& result,
+            std::string_view prefix,
+            std::shared_ptr<IFileSystem> filesystem,
+            std::string_view root,
+            int32_t priority,
+            bool writable = false) noexcept;
+
+        /// @brief Mounts file system without taking ownership.
+        ///
+        /// @remarks File system must outlive mount.
+        Status Mount(
+            MountId& result,
+            std::string_view prefix,
+            IFileSystem& filesystem,
+            std::string_view root,
+            int32_t priority,
+            bool writable = false) noexcept;
+
+        /// @brief Unmounts file system.
+        ///
+        /// @param id Provides identifier of mount.
+        ///
+        /// @return The status code.
+        Status Unmount(
+            MountId id) noexcept;
+
+        /// @brief Discards cached path resolutions.
+        void InvalidateCache() noexcept;
+
+    public:
+        virtual Status OpenRead(
+            std::unique_ptr<IStream>& result,
+            std::string_view path,
+            bool share = false) noexcept override;
+
+        virtual Status OpenWrite(
+            std::unique_ptr<IStream>& result,
+            std::string_view path,
+            bool append = false,
+            bool share  = false) noexcept override;
+
+        virtual Status OpenMapped(
+            std::unique_ptr<IMappedFile>& result,
+            std::string_view path,
+            MappedFileAccess access = MappedFileAccess::Normal) noexcept override;
+
+    public:
+        virtual Status IsReadonly(
+            bool& result,
+            std::string_view path) noexcept override;
+
+        virtual Status SetReadonly(
+            std::string_view path,
+            bool value) noexcept override;
+
+        virtual Status GetFileInfo(
+            FileInfo& result,
+            std::string_view path) noexcept override;
+
+        virtual Status GetFileSize(
+            int64_t& result,
+            std::string_view path) noexcept override;
+
+        virtual Status Exists(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status FileMove(
+            std::string_view destination,
+            std::string_view source) noexcept override;
+
+        virtual Status FileDelete(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status DirectoryCreate(
+            std::string_view path) noexcept override;
+
+        virtual Status DirectoryDelete(
+            std::string_view path) noexcept override;
+
+    public:
+        virtual Status Enumerate(
+            std::string_view path,
+            IDirectoryVisitor& visitor) noexcept override;
+
+        virtual Status Enumerate(
+            std::string_view path,
+            IDirectoryInfoVisitor& visitor) noexcept override;
+
+    private:
+        Status Resolve(
+            Resolution& result,
+            std::string& normalized,
+            std::string_view path) noexcept;
+
+        Status ResolveWritable(
+            Resolution& result,
+            std::string& normalized,
+            std::string_view path) noexcept;
+
+        [[nodiscard]] bool IsMountDirectory(
+            std::string_view normalized) noexcept;
+
+        void InvalidatePath(
+            std::string_view normalized) noexcept;
+
+        Status EnumerateChildren(
+            std::string_view path,
+            std::string& normalized,
+            std::map<std::string, FileInfo, std::less<>>& children,
+            bool details) noexcept;
+    };
+}
@@ -149,6 +149,22 @@ namespace Graphyte::Threading
 #endif
     }
 
+    /// @brief Hints processor that current thread is busy-waiting.
+    __forceinline void SpinWaitHint() noexcept
+    {
+#if GX_CPU_X86_32 || GX_CPU_X86_64
+        _mm_pause();
+#elif (GX_CPU_ARM_64 || GX_CPU_ARM_32) && GX_COMPILER_MSVC
+        __yield();
+#elif (GX_CPU_ARM_64 || GX_CPU_ARM_32) && (GX_COMPILER_GCC || GX_COMPILER_CLANG)
+        // clang-format off
+        __asm__ __volatile__("yield" : : : "memory");
+        // clang-format on
+#else
+        YieldThread();
+#endif
+    }
+
     /// @brief Sleeps current thread for specified time in milliseconds.
     ///
     /// @param milliseconds Provides timeout in milliseconds.
@@ -0,0 +1,104 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+
+//
+// ref: http://www.1024cores.net/home/lock-free-algorithms/eventcounts
+//
+
+namespace Graphyte::Threading
+{
+    /// @brief Lightweight event count used to park idle threads.
+    ///
+    /// Waiting thread announces intent to wait, re-checks its condition and then parks:
+    ///
+    ///     auto const key = events.PrepareWait();
+    ///
+    ///     if (condition_satisfied)
+    ///     {
+    ///         events.CancelWait();
+    ///     }
+    ///     else
+    ///     {
+    ///         events.Wait(key);
+    ///     }
+    ///
+    /// Notifying threads pay only for a fence and a load when no thread is parked.
+    class EventCount final
+    {
+    public:
+        enum class Key : uint32_t
+        {
+        };
+
+    private:
+        std::atomic<uint32_t> m_Epoch;
+        std::atomic<uint32_t> m_Waiters;
+
+    public:
+        EventCount() noexcept
+            : m_Epoch{}
+            , m_Waiters{}
+        {
+        }
+
+        EventCount(const EventCount&) = delete;
+
+        EventCount& operator=(const EventCount&) = delete;
+
+    public:
+        /// @brief Registers current thread as waiter.
+        ///
+        /// @return The key used to wait for notification.
+        [[nodiscard]] Key PrepareWait() noexcept
+        {
+            m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return static_cast<Key>(m_Epoch.load(std::memory_order_seq_cst));
+        }
+
+        /// @brief Unregisters current thread as waiter.
+        void CancelWait() noexcept
+        {
+            m_Waiters.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        /// @brief Parks current thread until notification after specified key was issued.
+        ///
+        /// @param key Provides key returned by PrepareWait.
+        void Wait(Key key) noexcept
+        {
+            auto const epoch = static_cast<uint32_t>(key);
+
+            while (m_Epoch.load(std::memory_order_acquire) == epoch)
+            {
+                m_Epoch.wait(epoch, std::memory_order_acquire);
+            }
+
+            m_Waiters.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        /// @brief Wakes single waiting thread, if any.
+        void Notify() noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_Waiters.load(std::memory_order_relaxed) != 0)
+            {
+                m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+                m_Epoch.notify_one();
+            }
+        }
+
+        /// @brief Wakes all waiting threads.
+        void NotifyAll() noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_Waiters.load(std::memory_order_relaxed) != 0)
+            {
+                m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+                m_Epoch.notify_all();
+            }
+        }
+    };
+}
@@ -0,0 +1,273 @@
+#pragma once
+#include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/TaskGraph.hxx>
+
+namespace Graphyte::Threading::Impl
+{
+    //
+    // Range is split further only when current thread has less pending tasks than this. Once
+    // other workers steal queued halves, splitting resumes.
+    //
+
+    constexpr const size_t ParallelRangeSplitThreshold = 2;
+
+    //
+    // Number of leaf ranges per worker used to compute default grain size.
+    //
+
+    constexpr const size_t ParallelRangeChunksPerWorker = 8;
+
+    template <typename TLeaf>
+    struct ParallelRangeContext final
+    {
+        TaskDispatcher& Dispatcher;
+        TLeaf& Leaf;
+        TaskState* Root;
+        size_t Grain;
+    };
+
+    template <typename TLeaf>
+    void ParallelRangeProcess(ParallelRangeContext<TLeaf>& context, size_t begin, size_t end) noexcept;
+
+    template <typename TLeaf>
+    class ParallelRangeTask final : public BaseTask
+    {
+    private:
+        ParallelRangeContext<TLeaf>& m_Context;
+        size_t m_Begin;
+        size_t m_End;
+
+    public:
+        ParallelRangeTask(ParallelRangeContext<TLeaf>& context, size_t begin, size_t end) noexcept
+            : m_Context{ context }
+            , m_Begin{ begin }
+            , m_End{ end }
+        {
+        }
+
+        virtual ~ParallelRangeTask() noexcept = default;
+
+    public:
+        void Execute() noexcept final override
+        {
+            ParallelRangeProcess(m_Context, m_Begin, m_End);
+            m_Context.Root->ResolveDependency();
+        }
+    };
+
+    template <typename TLeaf>
+    void ParallelRangeProcess(ParallelRangeContext<TLeaf>& context, size_t begin, size_t end) noexcept
+    {
+        //
+        // Lazy binary splitting: split off upper half while there is no pending work queued on
+        // current thread. Upper halves are pushed to local queue where idle workers steal them.
+        //
+
+        while ((end - begin) > context.Grain && context.Dispatcher.GetPendingTaskCount() < ParallelRangeSplitThreshold)
+        {
+            size_t const middle = begin + ((end - begin) / 2);
+
+            context.Root->AddDependency();
+            context.Dispatcher.Dispatch(BaseTask::Create<ParallelRangeTask<TLeaf>>(context, middle, end));
+
+            end = middle;
+        }
+
+        context.Leaf(begin, end);
+    }
+
+    [[nodiscard]] inline size_t ParallelRangeGetGrain(TaskDispatcher& dispatcher, size_t count, size_t grain) noexcept
+    {
+        if (grain == 0)
+        {
+            size_t const chunks = std::max<size_t>(dispatcher.GetWorkerCount(), 1) * ParallelRangeChunksPerWorker;
+            grain               = std::max<size_t>(count / chunks, 1);
+        }
+
+        return grain;
+    }
+
+    /// @brief Invokes leaf for disjoint subranges covering [begin, end).
+    template <typename TLeaf>
+    void ParallelRange(TaskDispatcher& dispatcher, size_t begin, size_t end, size_t grain, TLeaf& leaf) noexcept
+    {
+        GX_ASSERT(begin <= end);
+
+        size_t const count = end - begin;
+        grain              = ParallelRangeGetGrain(dispatcher, count, grain);
+
+        if (count <= grain || dispatcher.GetWorkerCount() == 0)
+        {
+            //
+            // Not worth splitting.
+            //
+
+            if (count != 0)
+            {
+                leaf(begin, end);
+            }
+
+            return;
+        }
+
+        auto* const root = BaseTask::Create<TaskState>(dispatcher);
+        TaskHandle const handle{ root };
+
+        ParallelRangeContext<TLeaf> context{
+            .Dispatcher = dispatcher,
+            .Leaf       = leaf,
+            .Root       = root,
+            .Grain      = grain,
+        };
+
+        ParallelRangeProcess(context, begin, end);
+
+        root->ResolveDependency();
+        handle.Wait();
+    }
+
+    template <typename T>
+    struct ParallelPartial final
+    {
+        size_t Begin;
+        size_t End;
+        T Value;
+    };
+
+    template <typename T, typename TLeafValue>
+    std::vector<ParallelPartial<T>> ParallelCollect(TaskDispatcher& dispatcher, size_t begin, size_t end, size_t grain, TLeafValue&& leaf_value) noexcept
+    {
+        std::vector<ParallelPartial<T>> partials{};
+        SpinLock lock{};
+
+        auto leaf = [&](size_t leaf_begin, size_t leaf_end) {
+            T value = leaf_value(leaf_begin, leaf_end);
+
+            ScopedLock<SpinLock> scoped{ lock };
+            partials.push_back(ParallelPartial<T>{
+                .Begin = leaf_begin,
+                .End   = leaf_end,
+                .Value = std::move(value),
+            });
+        };
+
+        ParallelRange(dispatcher, begin, end, grain, leaf);
+
+        //
+        // Leaves complete in any order. Restore range order so non-commutative joins work.
+        //
+
+        std::sort(partials.begin(), partials.end(), [](const ParallelPartial<T>& lhs, const ParallelPartial<T>& rhs) {
+            return lhs.Begin < rhs.Begin;
+        });
+
+        return partials;
+    }
+}
+
+namespace Graphyte::Threading
+{
+    /// @brief Invokes body for disjoint subranges covering [begin, end) in parallel.
+    ///
+    /// Range is split recursively on demand. Ranges smaller than grain are never split. Small
+    /// ranges run on calling thread.
+    ///
+    /// @param begin Provides first index of range.
+    /// @param end   Provides one past last index of range.
+    /// @param body  Provides body invoked as body(begin, end).
+    /// @param grain Provides minimal size of subrange. Zero selects size automatically.
+    template <typename TBody>
+    void ParallelForRange(size_t begin, size_t end, TBody&& body, size_t grain = 0) noexcept
+        requires(std::is_invocable_v<TBody&, size_t, size_t>)
+    {
+        Impl::ParallelRange(TaskDispatcher::GetInstance(), begin, end, grain, body);
+    }
+
+    /// @brief Reduces range in parallel.
+    ///
+    /// @param begin    Provides first index of range.
+    /// @param end      Provides one past last index of range.
+    /// @param identity Provides identity value of reduction.
+    /// @param body     Provides body invoked as body(begin, end, init) returning reduced value.
+    /// @param join     Provides associative join invoked as join(lhs, rhs).
+    /// @param grain    Provides minimal size of subrange. Zero selects size automatically.
+    ///
+    /// @return The reduced value.
+    template <typename T, typename TBody, typename TJoin>
+    [[nodiscard]] T ParallelReduce(size_t begin, size_t end, T identity, TBody&& body, TJoin&& join, size_t grain = 0) noexcept
+        requires(std::is_invocable_r_v<T, TBody&, size_t, size_t, T> && std::is_invocable_r_v<T, TJoin&, T, T>)
+    {
+        auto const partials = Impl::ParallelCollect<T>(
+            TaskDispatcher::GetInstance(),
+            begin,
+            end,
+            grain,
+            [&](size_t leaf_begin, size_t leaf_end) {
+                return body(leaf_begin, leaf_end, identity);
+            });
+
+        T result = identity;
+
+        for (auto const& partial : partials)
+        {
+            result = join(std::move(result), partial.Value);
+        }
+
+        return result;
+    }
+
+    /// @brief Computes prefix scan of range in parallel.
+    ///
+    /// Range is processed in two passes. First pass invokes body(begin, end, identity, false) to
+    /// compute summary of each subrange. Second pass invokes body(begin, end, prefix, true) with
+    /// prefix of all preceding subranges, where body should write final values.
+    ///
+    /// @param begin    Provides first index of range.
+    /// @param end      Provides one past last index of range.
+    /// @param identity Provides identity value of scan.
+    /// @param body     Provides body invoked as body(begin, end, prefix, final) returning summary.
+    /// @param join     Provides associative join invoked as join(lhs, rhs).
+    /// @param grain    Provides minimal size of subrange. Zero selects size automatically.
+    ///
+    /// @return The summary of whole range.
+    template <typename T, typename TBody, typename TJoin>
+    T ParallelScan(size_t begin, size_t end, T identity, TBody&& body, TJoin&& join, size_t grain = 0) noexcept
+        requires(std::is_invocable_r_v<T, TBody&, size_t, size_t, T, bool> && std::is_invocable_r_v<T, TJoin&, T, T>)
+    {
+        TaskDispatcher& dispatcher = TaskDispatcher::GetInstance();
+
+        auto partials = Impl::ParallelCollect<T>(
+            dispatcher,
+            begin,
+            end,
+            grain,
+            [&](size_t leaf_begin, size_t leaf_end) {
+                return body(leaf_begin, leaf_end, identity, false);
+            });
+
+        //
+        // Turn summaries into exclusive prefixes of subranges.
+        //
+
+        T prefix = identity;
+
+        for (auto& partial : partials)
+        {
+            T summary     = std::move(partial.Value);
+            partial.Value = prefix;
+            prefix        = join(std::move(prefix), std::move(summary));
+        }
+
+        auto final_pass = [&](size_t first, size_t last) {
+            for (size_t index = first; index < last; ++index)
+            {
+                auto const& partial = partials[index];
+                body(partial.Begin, partial.End, partial.Value, true);
+            }
+        };
+
+        Impl::ParallelRange(dispatcher, 0, partials.size(), 1, final_pass);
+
+        return prefix;
+    }
+}
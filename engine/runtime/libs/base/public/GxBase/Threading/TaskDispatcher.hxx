@@ -1,12 +1,18 @@
 #pragma once
+#include <GxBase/Threading/EventCount.hxx>
 #include <GxBase/Threading/Runnable.hxx>
 #include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Threading/TaskStorage.hxx>
 #include <GxBase/Threading/Thread.hxx>
 
 namespace Graphyte::Threading
 {
     class BaseTask
     {
+    private:
+        /// Size of pooled storage block holding this task. Zero for tasks allocated on heap.
+        size_t m_StorageSize{};
+
     public:
         BaseTask() noexcept = default;
 
@@ -14,13 +20,96 @@ namespace Graphyte::Threading
 
     public:
         virtual void Execute() noexcept = 0;
+
+    protected:
+        /// @brief Destroys task and releases its storage.
+        ///
+        /// Derived tasks may override it to extend lifetime of task past its execution.
+        virtual void Dispose() noexcept
+        {
+            size_t const size = m_StorageSize;
+
+            if (size != 0)
+            {
+                this->~BaseTask();
+                TaskStorage::Deallocate(this, size);
+            }
+            else
+            {
+                delete this;
+            }
+        }
+
+    public:
+        /// @brief Creates task in pooled task storage.
+        ///
+        /// Tasks which don't fit in pooled storage are allocated on heap.
+        ///
+        /// @param args Provides arguments passed to task constructor.
+        ///
+        /// @return The pointer to task. Must be released with BaseTask::Release.
+        template <typename TTask, typename... TArgs>
+        [[nodiscard]] static TTask* Create(TArgs&&... args) noexcept
+        {
+            static_assert(std::is_base_of_v<BaseTask, TTask>);
+
+            if constexpr (sizeof(TTask) <= TaskStorage::MaxBlockSize && alignof(TTask) <= TaskStorage::BlockAlignment)
+            {
+                void* const storage = TaskStorage::Allocate(sizeof(TTask));
+                TTask* const task   = new (storage) TTask(std::forward<TArgs>(args)...);
+                task->m_StorageSize = sizeof(TTask);
+                return task;
+            }
+            else
+            {
+                return new TTask(std::forward<TArgs>(args)...);
+            }
+        }
+
+        /// @brief Destroys task and releases its storage.
+        ///
+        /// @param task Provides task to release.
+        static void Release(BaseTask* task) noexcept
+        {
+            task->Dispose();
+        }
+    };
+
+    /// @brief Represents task invoking callable object stored inline.
+    template <typename TCallable>
+    class CallableTask final : public BaseTask
+    {
+    private:
+        TCallable m_Callable;
+
+    public:
+        template <typename TArg>
+        explicit CallableTask(TArg&& callable) noexcept
+            : m_Callable{ std::forward<TArg>(callable) }
+        {
+        }
+
+        virtual ~CallableTask() noexcept = default;
+
+    public:
+        void Execute() noexcept final override
+        {
+            m_Callable();
+        }
     };
 
     class TaskWorkerThread;
+    class TaskHandle;
+
+    namespace Impl
+    {
+        class TaskState;
+    }
 
     class BASE_API TaskDispatcher final
     {
         friend class TaskWorkerThread;
+        friend class Impl::TaskState;
 
     private:
         struct WorkerData final
@@ -30,11 +119,20 @@ namespace Graphyte::Threading
         };
 
     private:
-        std::deque<std::unique_ptr<BaseTask>> m_Tasks;
         std::vector<WorkerData> m_Workers;
+
+        //
+        // Ring buffer of tasks dispatched from threads other than workers. Workers dispatch tasks
+        // to their own local queues and steal from each other.
+        //
+
+        std::vector<BaseTask*> m_Tasks;
+        size_t m_TasksHead;
+        std::atomic<size_t> m_TasksCount;
         CriticalSection m_CS;
-        ConditionVariable m_CV;
-        bool m_Stop;
+
+        EventCount m_Idle;
+        std::atomic<bool> m_Stop;
 
     public:
         TaskDispatcher() noexcept;
@@ -50,8 +148,71 @@ namespace Graphyte::Threading
         void Stop() noexcept;
         void Dispatch(std::unique_ptr<BaseTask> task) noexcept;
 
+        /// @brief Dispatches task.
+        ///
+        /// @param task Provides task to dispatch. Dispatcher takes ownership and releases it with
+        ///             BaseTask::Release after execution.
+        void Dispatch(BaseTask* task) noexcept;
+
+        /// @brief Dispatches callable object as task stored in pooled task storage.
+        ///
+        /// @param callable Provides callable object to invoke.
+        template <typename TCallable>
+        void Dispatch(TCallable&& callable) noexcept
+            requires(std::is_invocable_v<std::decay_t<TCallable>&>)
+        {
+            Dispatch(BaseTask::Create<CallableTask<std::decay_t<TCallable>>>(std::forward<TCallable>(callable)));
+        }
+
+        /// @brief Schedules callable object to run after all dependencies complete.
+        ///
+        /// Defined in GxBase/Threading/TaskGraph.hxx.
+        ///
+        /// @param callable     Provides callable object to invoke.
+        /// @param dependencies Provides tasks which must complete first.
+        ///
+        /// @return The handle to scheduled task.
+        template <typename TCallable>
+        TaskHandle Schedule(TCallable&& callable, std::span<const TaskHandle> dependencies = {}) noexcept
+            requires(std::is_invocable_v<std::decay_t<TCallable>&>);
+
+        template <typename TCallable>
+        TaskHandle Schedule(TCallable&& callable, std::initializer_list<TaskHandle> dependencies) noexcept
+            requires(std::is_invocable_v<std::decay_t<TCallable>&>);
+
+        /// @brief Executes pending tasks on current thread until task completes.
+        ///
+        /// Current thread parks only when there is no work available.
+        ///
+        /// @param handle Provides handle to task.
+        void Wait(const TaskHandle& handle) noexcept;
+
+        /// @brief Gets number of worker threads.
+        [[nodiscard]] size_t GetWorkerCount() const noexcept
+        {
+            return m_Workers.size();
+        }
+
+        /// @brief Gets number of tasks waiting in queue of current thread.
+        ///
+        /// For worker threads this is size of local queue. For other threads this is size of shared
+        /// queue. Used to decide whether work should be split further.
+        [[nodiscard]] size_t GetPendingTaskCount() const noexcept;
+
+        /// @brief Executes single pending task on current thread, if any.
+        ///
+        /// @return The value indicating whether task was executed.
+        bool TryExecuteTask() noexcept;
+
     private:
-        [[nodiscard]] std::unique_ptr<BaseTask> AcquireTask() noexcept;
+        [[nodiscard]] BaseTask* AcquireTask(TaskWorkerThread& worker) noexcept;
+        [[nodiscard]] BaseTask* TryAcquireTask(TaskWorkerThread* worker) noexcept;
+        [[nodiscard]] BaseTask* AcquireSharedTask(TaskWorkerThread& worker) noexcept;
+        [[nodiscard]] BaseTask* StealTask(size_t first, size_t self) noexcept;
+        [[nodiscard]] TaskWorkerThread* GetCurrentWorker() const noexcept;
+        static void ExecuteTask(BaseTask* task) noexcept;
+        void PushSharedTask(BaseTask* task) noexcept;
+        [[nodiscard]] BaseTask* PopSharedTask() noexcept;
     };
 
     template <typename TTask>
@@ -69,7 +230,7 @@ namespace Graphyte::Threading
             template <typename... TArgs>
             void Dispatch(TArgs&&... args) noexcept
             {
-                TaskDispatcher::GetInstance().Dispatch(std::move(std::make_unique<Task>(std::forward<TArgs>(args)...)));
+                TaskDispatcher::GetInstance().Dispatch(Task::Create(std::forward<TArgs>(args)...));
             }
         };
 
@@ -85,6 +246,12 @@ namespace Graphyte::Threading
             return std::make_unique<Task>(std::forward<TArgs>(args)...);
         }
 
+        template <typename... TArgs>
+        [[nodiscard]] static Task* Create(TArgs&&... args) noexcept
+        {
+            return BaseTask::Create<Task>(std::forward<TArgs>(args)...);
+        }
+
     public:
         template <typename... TArgs>
         Task(TArgs&&... args) noexcept
@@ -0,0 +1,311 @@
+#pragma once
+#include <GxBase/Threading/SpinLock.hxx>
+#include <GxBase/Threading/TaskDispatcher.hxx>
+
+namespace Graphyte::Threading::Impl
+{
+    struct TaskContinuation;
+
+    /// @brief Represents shared state of task which can be waited for and depended on.
+    ///
+    /// State is reference counted. Dispatcher holds single reference until task is executed, and
+    /// each TaskHandle holds another one.
+    class BASE_API TaskState : public BaseTask
+    {
+        friend class Graphyte::Threading::TaskDispatcher;
+
+    private:
+        TaskDispatcher& m_Dispatcher;
+        std::atomic<uint32_t> m_References;
+        std::atomic<uint32_t> m_Dependencies;
+        std::atomic<uint32_t> m_Waiters;
+        std::atomic<bool> m_Completed;
+        SpinLock m_Lock;
+        TaskContinuation* m_Continuations;
+
+    public:
+        explicit TaskState(TaskDispatcher& dispatcher) noexcept
+            : m_Dispatcher{ dispatcher }
+            , m_References{ 1 }
+            , m_Dependencies{ 1 }
+            , m_Waiters{}
+            , m_Completed{}
+            , m_Lock{}
+            , m_Continuations{}
+        {
+        }
+
+        virtual ~TaskState() noexcept = default;
+
+    public:
+        void Execute() noexcept final override;
+
+    protected:
+        virtual void Run() noexcept
+        {
+        }
+
+        void Dispose() noexcept final override;
+
+    public:
+        TaskDispatcher& GetDispatcher() const noexcept
+        {
+            return m_Dispatcher;
+        }
+
+        bool IsCompleted() const noexcept
+        {
+            return m_Completed.load(std::memory_order_acquire);
+        }
+
+        void AddReference() noexcept
+        {
+            m_References.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void ReleaseReference() noexcept;
+
+        /// @brief Registers dependencies of this task.
+        ///
+        /// Must be called before task is started.
+        void AddDependencies(std::span<const TaskHandle> dependencies) noexcept;
+
+        /// @brief Adds single dependency resolved later with ResolveDependency.
+        ///
+        /// Must be called while at least one other dependency is still unresolved.
+        void AddDependency() noexcept
+        {
+            m_Dependencies.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Resolves single dependency. Dispatches task when all dependencies are resolved.
+        void ResolveDependency() noexcept;
+
+    private:
+        bool AddContinuation(TaskState* state) noexcept;
+        void Complete() noexcept;
+    };
+
+    template <typename TCallable>
+    class CallableTaskState final : public TaskState
+    {
+    private:
+        TCallable m_Callable;
+
+    public:
+        template <typename TArg>
+        CallableTaskState(TaskDispatcher& dispatcher, TArg&& callable) noexcept
+            : TaskState{ dispatcher }
+            , m_Callable{ std::forward<TArg>(callable) }
+        {
+        }
+
+        virtual ~CallableTaskState() noexcept = default;
+
+    protected:
+        void Run() noexcept final override
+        {
+            m_Callable();
+        }
+    };
+}
+
+namespace Graphyte::Threading
+{
+    /// @brief Represents handle to scheduled task.
+    class TaskHandle final
+    {
+        friend class TaskDispatcher;
+
+    private:
+        Impl::TaskState* m_State;
+
+    public:
+        TaskHandle() noexcept
+            : m_State{}
+        {
+        }
+
+        explicit TaskHandle(Impl::TaskState* state) noexcept
+            : m_State{ state }
+        {
+            if (m_State != nullptr)
+            {
+                m_State->AddReference();
+            }
+        }
+
+        TaskHandle(const TaskHandle& other) noexcept
+            : TaskHandle{ other.m_State }
+        {
+        }
+
+        TaskHandle(TaskHandle&& other) noexcept
+            : m_State{ std::exchange(other.m_State, nullptr) }
+        {
+        }
+
+        TaskHandle& operator=(const TaskHandle& other) noexcept
+        {
+            TaskHandle{ other }.Swap(*this);
+            return *this;
+        }
+
+        TaskHandle& operator=(TaskHandle&& other) noexcept
+        {
+            TaskHandle{ std::move(other) }.Swap(*this);
+            return *this;
+        }
+
+        ~TaskHandle() noexcept
+        {
+            if (m_State != nullptr)
+            {
+                m_State->ReleaseReference();
+            }
+        }
+
+    public:
+        void Swap(TaskHandle& other) noexcept
+        {
+            std::swap(m_State, other.m_State);
+        }
+
+        [[nodiscard]] bool IsValid() const noexcept
+        {
+            return m_State != nullptr;
+        }
+
+        [[nodiscard]] bool IsCompleted() const noexcept
+        {
+            GX_ASSERT(m_State != nullptr);
+            return m_State->IsCompleted();
+        }
+
+        [[nodiscard]] Impl::TaskState* GetState() const noexcept
+        {
+            return m_State;
+        }
+
+        /// @brief Waits for task completion, executing pending tasks in meantime.
+        void Wait() const noexcept
+        {
+            GX_ASSERT(m_State != nullptr);
+            m_State->GetDispatcher().Wait(*this);
+        }
+
+        /// @brief Schedules callable object to run after this task completes.
+        ///
+        /// @param callable Provides callable object to invoke.
+        ///
+        /// @return The handle to continuation task.
+        template <typename TCallable>
+        TaskHandle ContinueWith(TCallable&& callable) const noexcept
+        {
+            GX_ASSERT(m_State != nullptr);
+            return m_State->GetDispatcher().Schedule(std::forward<TCallable>(callable), std::span<const TaskHandle>{ this, 1 });
+        }
+    };
+
+    template <typename TCallable>
+    TaskHandle TaskDispatcher::Schedule(TCallable&& callable, std::span<const TaskHandle> dependencies) noexcept
+        requires(std::is_invocable_v<std::decay_t<TCallable>&>)
+    {
+        auto* const state = BaseTask::Create<Impl::CallableTaskState<std::decay_t<TCallable>>>(*this, std::forward<TCallable>(callable));
+
+        TaskHandle result{ state };
+
+        state->AddDependencies(dependencies);
+        state->ResolveDependency();
+
+        return result;
+    }
+
+    template <typename TCallable>
+    TaskHandle TaskDispatcher::Schedule(TCallable&& callable, std::initializer_list<TaskHandle> dependencies) noexcept
+        requires(std::is_invocable_v<std::decay_t<TCallable>&>)
+    {
+        return Schedule(std::forward<TCallable>(callable), std::span<const TaskHandle>{ dependencies.begin(), dependencies.size() });
+    }
+}
+
+namespace Graphyte::Threading
+{
+    /// @brief Represents prebuilt graph of tasks.
+    ///
+    /// Graph is built once and may be kicked many times, e.g. once per frame. Kicking graph does not
+    /// allocate memory from heap. Graph must not contain cycles and must not be modified or kicked
+    /// again before previous run completes.
+    class BASE_API TaskGraph final
+    {
+        friend class TaskGraphNodeTask;
+
+    public:
+        enum class NodeId : uint32_t
+        {
+        };
+
+    private:
+        struct Node final
+        {
+            std::function<void()> Callable;
+            std::vector<uint32_t> Successors;
+            uint32_t Predecessors;
+        };
+
+    private:
+        std::vector<Node> m_Nodes;
+        std::vector<std::atomic<uint32_t>> m_Pending;
+        std::atomic<uint32_t> m_Remaining;
+        TaskDispatcher* m_Dispatcher;
+        TaskHandle m_Completion;
+
+    public:
+        TaskGraph() noexcept;
+        ~TaskGraph() noexcept;
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+    public:
+        /// @brief Adds node to graph.
+        ///
+        /// @param callable Provides callable object invoked when node executes.
+        ///
+        /// @return The identifier of node.
+        NodeId Add(std::function<void()> callable) noexcept;
+
+        /// @brief Adds dependency between two nodes.
+        ///
+        /// @param before Provides node which must complete first.
+        /// @param after  Provides node which executes after.
+        void Precede(NodeId before, NodeId after) noexcept;
+
+        /// @brief Removes all nodes from graph.
+        void Clear() noexcept;
+
+        [[nodiscard]] size_t GetSize() const noexcept
+        {
+            return m_Nodes.size();
+        }
+
+        /// @brief Starts execution of graph.
+        ///
+        /// @param dispatcher   Provides dispatcher executing graph nodes.
+        /// @param dependencies Provides tasks which must complete before graph starts.
+        ///
+        /// @return The handle completed after all nodes of graph complete.
+        TaskHandle Kick(TaskDispatcher& dispatcher, std::span<const TaskHandle> dependencies = {}) noexcept;
+
+        /// @brief Starts execution of graph and waits for its completion.
+        ///
+        /// @param dispatcher Provides dispatcher executing graph nodes.
+        void Run(TaskDispatcher& dispatcher) noexcept;
+
+    private:
+        void Start() noexcept;
+        void ExecuteNode(uint32_t index) noexcept;
+        void CompleteNode() noexcept;
+        void DispatchNode(uint32_t index) noexcept;
+    };
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+
+namespace Graphyte::Threading
+{
+    struct TaskStorageStatistics final
+    {
+        /// Number of slabs allocated from heap for pooled blocks.
+        uint64_t SlabAllocations;
+
+        /// Number of blocks moved between thread caches and shared depot.
+        uint64_t BatchTransfers;
+    };
+
+    /// @brief Provides pooled storage for tasks.
+    ///
+    /// Blocks are grouped in power-of-two size classes and cached per thread. Blocks are returned to
+    /// cache of releasing thread. Surplus blocks are moved in batches through shared depot, so
+    /// steady state task dispatch does not touch the heap.
+    class BASE_API TaskStorage final
+    {
+    public:
+        /// Alignment of every block.
+        static constexpr const size_t BlockAlignment = 64;
+
+        /// Smallest size class.
+        static constexpr const size_t MinBlockSize = 64;
+
+        /// Largest size class. Larger tasks are allocated on heap.
+        static constexpr const size_t MaxBlockSize = 512;
+
+    public:
+        /// @brief Allocates block for task.
+        ///
+        /// @param size Provides size of block. Must not be greater than MaxBlockSize.
+        ///
+        /// @return The pointer to allocated block.
+        [[nodiscard]] static void* Allocate(size_t size) noexcept;
+
+        /// @brief Deallocates block.
+        ///
+        /// @param pointer Provides pointer to block.
+        /// @param size    Provides size of block, as passed to Allocate.
+        static void Deallocate(void* pointer, size_t size) noexcept;
+
+        /// @brief Gets storage statistics.
+        [[nodiscard]] static TaskStorageStatistics GetStatistics() noexcept;
+    };
+}
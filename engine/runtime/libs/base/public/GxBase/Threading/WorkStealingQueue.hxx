@@ -0,0 +1,223 @@
+#pragma once
+#include <GxBase/Base.module.hxx>
+#include <GxBase/Bitwise.hxx>
+#include <GxBase/Diagnostics.hxx>
+
+//
+// ref: N. M. Le, A. Pop, A. Cohen, F. Zappa Nardelli
+//      "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013
+//
+
+namespace Graphyte::Threading
+{
+    /// @brief Single-producer, multi-consumer work stealing deque (Chase-Lev).
+    ///
+    /// Owner thread pushes and pops items at the bottom of queue. Any other thread may steal items
+    /// from the top of queue.
+    ///
+    /// @tparam T Provides type of element. Must be trivially copyable (usually a pointer).
+    template <typename T>
+    class WorkStealingQueue final
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+    private:
+        /// @brief Represents circular buffer of items.
+        struct Buffer final
+        {
+            /// Mask used to wrap indices.
+            int64_t Mask;
+
+            /// Buffer items.
+            std::unique_ptr<std::atomic<T>[]> Items;
+
+            explicit Buffer(int64_t capacity) noexcept
+                : Mask{ capacity - 1 }
+                , Items{ std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)) }
+            {
+            }
+
+            [[nodiscard]] int64_t GetCapacity() const noexcept
+            {
+                return Mask + 1;
+            }
+
+            [[nodiscard]] T Load(int64_t index) const noexcept
+            {
+                return Items[static_cast<size_t>(index & Mask)].load(std::memory_order_relaxed);
+            }
+
+            void Store(int64_t index, T value) noexcept
+            {
+                Items[static_cast<size_t>(index & Mask)].store(value, std::memory_order_relaxed);
+            }
+        };
+
+    private:
+        alignas(GX_CACHELINE_SIZE) std::atomic<int64_t> m_Top;
+        alignas(GX_CACHELINE_SIZE) std::atomic<int64_t> m_Bottom;
+        std::atomic<Buffer*> m_Buffer;
+
+        //
+        // Buffers replaced by growing queue are kept alive until queue is destroyed, because
+        // concurrent thieves may still read from them.
+        //
+
+        std::vector<std::unique_ptr<Buffer>> m_Buffers;
+
+    public:
+        explicit WorkStealingQueue(size_t capacity = 256) noexcept
+            : m_Top{}
+            , m_Bottom{}
+            , m_Buffer{}
+            , m_Buffers{}
+        {
+            GX_ASSERT(IsPowerOf2(capacity));
+
+            m_Buffers.push_back(std::make_unique<Buffer>(static_cast<int64_t>(capacity)));
+            m_Buffer.store(m_Buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+
+        WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+    public:
+        /// @brief Pushes item at bottom of queue. Must be called by owner thread only.
+        ///
+        /// @param value Provides value to push.
+        void Push(T value) noexcept
+        {
+            int64_t const bottom = m_Bottom.load(std::memory_order_relaxed);
+            int64_t const top    = m_Top.load(std::memory_order_acquire);
+            Buffer* buffer       = m_Buffer.load(std::memory_order_relaxed);
+
+            if ((bottom - top) > (buffer->GetCapacity() - 1))
+            {
+                buffer = Grow(buffer, top, bottom);
+            }
+
+            buffer->Store(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /// @brief Pops item from bottom of queue. Must be called by owner thread only.
+        ///
+        /// @param result Returns popped value.
+        ///
+        /// @return The value indicating whether item was popped.
+        [[nodiscard]] bool Pop(T& result) noexcept
+        {
+            int64_t const bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            Buffer* buffer       = m_Buffer.load(std::memory_order_relaxed);
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                //
+                // Queue was empty.
+                //
+
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            result = buffer->Load(bottom);
+
+            if (top != bottom)
+            {
+                //
+                // More than one item left - no race with thieves possible.
+                //
+
+                return true;
+            }
+
+            //
+            // Last item in queue - race against thieves for it.
+            //
+
+            bool const won = m_Top.compare_exchange_strong(
+                top,
+                top + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed);
+
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        /// @brief Steals item from top of queue. May be called by any thread.
+        ///
+        /// @param result Returns stolen value.
+        ///
+        /// @return The value indicating whether item was stolen.
+        [[nodiscard]] bool Steal(T& result) noexcept
+        {
+            for (;;)
+            {
+                int64_t top = m_Top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t const bottom = m_Bottom.load(std::memory_order_acquire);
+
+                if (top >= bottom)
+                {
+                    return false;
+                }
+
+                Buffer* buffer = m_Buffer.load(std::memory_order_acquire);
+                T const value  = buffer->Load(top);
+
+                if (m_Top.compare_exchange_strong(
+                        top,
+                        top + 1,
+                        std::memory_order_seq_cst,
+                        std::memory_order_relaxed))
+                {
+                    result = value;
+                    return true;
+                }
+
+                //
+                // Lost race against other thief or owner. Retry, because queue may still have
+                // items available.
+                //
+            }
+        }
+
+        /// @brief Gets approximate number of items in queue.
+        [[nodiscard]] size_t GetSize() const noexcept
+        {
+            int64_t const bottom = m_Bottom.load(std::memory_order_relaxed);
+            int64_t const top    = m_Top.load(std::memory_order_relaxed);
+            return static_cast<size_t>(std::max<int64_t>(bottom - top, 0));
+        }
+
+        /// @brief Checks whether queue is empty. Result is approximate when called concurrently.
+        [[nodiscard]] bool IsEmpty() const noexcept
+        {
+            return GetSize() == 0;
+        }
+
+    private:
+        Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom) noexcept
+        {
+            auto replacement = std::make_unique<Buffer>(buffer->GetCapacity() * 2);
+
+            for (int64_t index = top; index < bottom; ++index)
+            {
+                replacement->Store(index, buffer->Load(index));
+            }
+
+            Buffer* const result = replacement.get();
+            m_Buffers.push_back(std::move(replacement));
+            m_Buffer.store(result, std::memory_order_release);
+            return result;
+        }
+    };
+}
@@ -71,4 +71,27 @@ namespace Graphyte::Geometry
 
         return archive;
     }
+
+    GEOMETRY_API void Serialize(Storage::VersionedArchive& archive, Mesh& mesh) noexcept
+    {
+        //
+        // Tags of texture coordinate layers start at 16, so other streams may be added before them.
+        //
+
+        archive.Version(1);
+
+        archive.Field(1, mesh.FaceMaterialIndices);
+        archive.Field(2, mesh.FaceSmoothingMasks);
+        archive.Field(3, mesh.VertexPositions);
+        archive.Field(4, mesh.WedgeIndices);
+        archive.Field(5, mesh.WedgeTangentX);
+        archive.Field(6, mesh.WedgeTangentY);
+        archive.Field(7, mesh.WedgeTangentZ);
+        archive.Field(8, mesh.WedgeColors);
+
+        for (uint32_t i = 0; i < Mesh::MaxTextureCoords; ++i)
+        {
+            archive.Field(16 + i, mesh.WedgeTextureCoords[i]);
+        }
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <GxGeometry/Geometry.module.hxx>
 #include <GxBase/Storage/Archive.hxx>
+#include <GxBase/Storage/VersionedArchive.hxx>
 
 namespace Graphyte::Geometry
 {
@@ -117,4 +118,6 @@ namespace Graphyte::Geometry
     };
 
     GEOMETRY_API Storage::Archive& operator<<(Storage::Archive& archive, Mesh& mesh) noexcept;
+
+    GEOMETRY_API void Serialize(Storage::VersionedArchive& archive, Mesh& mesh) noexcept;
 }
@@ -0,0 +1,354 @@
+#include <GxGraphics/Graphics/ShaderLibrary.hxx>
+#include <GxBase/Hash/XXHash.hxx>
+#include <GxBase/Compression.hxx>
+#include <GxBase/Storage/BinaryFormat.hxx>
+
+namespace Graphyte::Graphics
+{
+    namespace
+    {
+        constexpr const uint64_t ShaderLibraryHashSeed = 0;
+
+        auto GetEntryKey(
+            uint64_t permutation,
+            GpuRenderAPI render_api,
+            GpuShaderProfile profile,
+            GpuShaderStage stage) noexcept
+        {
+            return std::tuple{ render_api, profile, stage, permutation };
+        }
+
+        auto GetEntryKey(
+            const ShaderLibraryEntry& entry) noexcept
+        {
+            return GetEntryKey(entry.Permutation, entry.RenderAPI, entry.Profile, entry.Stage);
+        }
+
+        //
+        // LZ4 expands data at most 255 times.
+        //
+
+        constexpr const uint64_t MaxCompressionRatio = 255;
+
+        //
+        // Loads string or vector of trivial elements. Length read from archive is checked against
+        // remaining archive size before allocating memory.
+        //
+
+        template <typename TSize, typename TContainer>
+        void LoadSequence(
+            Storage::Archive& archive,
+            TContainer& value) noexcept
+        {
+            using TElement = typename TContainer::value_type;
+
+            TSize size{};
+            archive << size;
+
+            int64_t const remaining = archive.GetSize() - archive.GetPosition();
+
+            if (archive.IsError() || remaining < 0 || uint64_t{ size } > (static_cast<uint64_t>(remaining) / sizeof(TElement)))
+            {
+                archive.SetError();
+                value.clear();
+                return;
+            }
+
+            value.resize(static_cast<size_t>(size));
+            archive.Serialize(std::data(value), std::size(value) * sizeof(TElement));
+        }
+    }
+
+    ShaderLibrary::ShaderLibrary() noexcept
+        : m_Defines{}
+        , m_Entries{}
+        , m_Blobs{}
+        , m_Pool{}
+        , m_BlobIndex{}
+        , Platform{}
+        , Flags{ ShaderBytecodeFlags::None }
+    {
+    }
+
+    ShaderLibrary::~ShaderLibrary() noexcept = default;
+
+    Status ShaderLibrary::SetDefines(
+        std::vector<std::string> defines) noexcept
+    {
+        if (defines.size() > MaxDefines)
+        {
+            return Status::InvalidArgument;
+        }
+
+        m_Defines = std::move(defines);
+        return Status::Success;
+    }
+
+    bool ShaderLibrary::GetPermutation(
+        uint64_t& result,
+        std::span<const std::string_view> defines) const noexcept
+    {
+        result = 0;
+
+        for (std::string_view const define : defines)
+        {
+            auto const it = std::find(m_Defines.begin(), m_Defines.end(), define);
+
+            if (it == m_Defines.end())
+            {
+                return false;
+            }
+
+            result |= uint64_t{ 1 } << static_cast<size_t>(it - m_Defines.begin());
+        }
+
+        return true;
+    }
+
+    Status ShaderLibrary::Add(
+        uint64_t permutation,
+        GpuRenderAPI render_api,
+        GpuShaderProfile profile,
+        GpuShaderStage stage,
+        std::span<const std::byte> bytecode) noexcept
+    {
+        auto const key = GetEntryKey(permutation, render_api, profile, stage);
+
+        auto const position = std::lower_bound(m_Entries.begin(), m_Entries.end(), key, [](const ShaderLibraryEntry& entry, const auto& value) {
+            return GetEntryKey(entry) < value;
+        });
+
+        if (position != m_Entries.end() && GetEntryKey(*position) == key)
+        {
+            return Status::AlreadyExists;
+        }
+
+        //
+        // Bytecode is compared in full, so hash collisions do not merge distinct blobs.
+        //
+
+        uint64_t const hash = Hash::XXHash64::Hash(bytecode.data(), bytecode.size(), ShaderLibraryHashSeed);
+
+        uint32_t blob = static_cast<uint32_t>(m_Blobs.size());
+
+        auto const [first, last] = m_BlobIndex.equal_range(hash);
+
+        for (auto it = first; it != last; ++it)
+        {
+            BlobRange const& range = m_Blobs[it->second];
+
+            if (range.Size == bytecode.size() && std::equal(bytecode.begin(), bytecode.end(), m_Pool.begin() + range.Offset))
+            {
+                blob = it->second;
+                break;
+            }
+        }
+
+        if (blob == m_Blobs.size())
+        {
+            if ((m_Pool.size() + bytecode.size()) > std::numeric_limits<uint32_t>::max())
+            {
+                return Status::InvalidArgument;
+            }
+
+            m_Blobs.push_back(BlobRange{
+                .Offset = static_cast<uint32_t>(m_Pool.size()),
+                .Size   = static_cast<uint32_t>(bytecode.size()),
+            });
+
+            m_Pool.insert(m_Pool.end(), bytecode.begin(), bytecode.end());
+            m_BlobIndex.emplace(hash, blob);
+        }
+
+        m_Entries.insert(position, ShaderLibraryEntry{
+                                       .Permutation = permutation,
+                                       .RenderAPI   = render_api,
+                                       .Profile     = profile,
+                                       .Stage       = stage,
+                                       .Blob        = blob,
+                                   });
+
+        return Status::Success;
+    }
+
+    const ShaderLibraryEntry* ShaderLibrary::Find(
+        uint64_t permutation,
+        GpuRenderAPI render_api,
+        GpuShaderProfile profile,
+        GpuShaderStage stage) const noexcept
+    {
+        auto const key = GetEntryKey(permutation, render_api, profile, stage);
+
+        auto const it = std::lower_bound(m_Entries.begin(), m_Entries.end(), key, [](const ShaderLibraryEntry& entry, const auto& value) {
+            return GetEntryKey(entry) < value;
+        });
+
+        if (it != m_Entries.end() && GetEntryKey(*it) == key)
+        {
+            return &(*it);
+        }
+
+        return nullptr;
+    }
+
+    GpuShaderBytecode ShaderLibrary::GetBytecode(
+        const ShaderLibraryEntry& entry) const noexcept
+    {
+        GX_ASSERT(entry.Blob < m_Blobs.size());
+
+        BlobRange const& range = m_Blobs[entry.Blob];
+        return { m_Pool.data() + range.Offset, range.Size };
+    }
+
+    void ShaderLibrary::Clear() noexcept
+    {
+        m_Defines.clear();
+        m_Entries.clear();
+        m_Blobs.clear();
+        m_Pool.clear();
+        m_BlobIndex.clear();
+    }
+
+    GRAPHICS_API Storage::Archive& operator<<(Storage::Archive& archive, ShaderLibrary& library) noexcept
+    {
+        //
+        // Bytecode of all permutations is compressed as single block, because permutations share
+        // most of their content.
+        //
+
+        constexpr const Compression::CompressionMethod CompressUsing = Compression::CompressionMethod::LZ4HC;
+
+        Storage::BinaryFormatHeader header{
+            .Signature = Storage::BinarySignature{ ShaderLibrary::FileSignature },
+            .Version   = Storage::BinaryFormatVersion{ 0, 0 },
+            .Encoding  = ByteEncoding::LittleEndian,
+        };
+
+        if (archive.IsLoading())
+        {
+            library.Clear();
+
+            archive << header;
+
+            bool valid = header.Signature == Storage::BinarySignature{ ShaderLibrary::FileSignature }
+                         && header.Version == Storage::BinaryFormatVersion{ 0, 0 }
+                         && header.Encoding == ByteEncoding::LittleEndian;
+
+            archive << library.Platform;
+            archive << library.Flags;
+
+            uint32_t defines_count{};
+            archive << defines_count;
+
+            valid = valid && defines_count <= ShaderLibrary::MaxDefines;
+
+            if (valid)
+            {
+                library.m_Defines.resize(defines_count);
+
+                for (std::string& define : library.m_Defines)
+                {
+                    LoadSequence<uint32_t>(archive, define);
+                }
+            }
+
+            uint64_t pool_checksum{};
+            uint64_t pool_size{};
+
+            std::vector<std::byte> data{};
+
+            if (valid)
+            {
+                LoadSequence<uint64_t>(archive, library.m_Entries);
+                LoadSequence<uint64_t>(archive, library.m_Blobs);
+
+                archive << pool_checksum;
+                archive << pool_size;
+                LoadSequence<uint64_t>(archive, data);
+            }
+
+            //
+            // Pool size comes from file too. It's bounded by compression ratio of stored data before
+            // allocating memory for it.
+            //
+
+            valid = valid
+                    && !archive.IsError()
+                    && pool_size <= std::numeric_limits<uint32_t>::max()
+                    && pool_size <= data.size() * MaxCompressionRatio;
+
+            if (valid)
+            {
+                library.m_Pool.resize(static_cast<size_t>(pool_size));
+
+                valid = (pool_size == 0 || Compression::DecompressBlock(CompressUsing, library.m_Pool, data))
+                        && Hash::XXHash64::Hash(library.m_Pool.data(), library.m_Pool.size(), ShaderLibraryHashSeed) == pool_checksum;
+            }
+
+            for (ShaderLibraryEntry const& entry : library.m_Entries)
+            {
+                valid = valid && entry.Blob < library.m_Blobs.size();
+            }
+
+            for (size_t i = 0; valid && i < library.m_Blobs.size(); ++i)
+            {
+                auto const& range = library.m_Blobs[i];
+
+                valid = (uint64_t{ range.Offset } + range.Size) <= library.m_Pool.size();
+
+                if (valid)
+                {
+                    library.m_BlobIndex.emplace(
+                        Hash::XXHash64::Hash(library.m_Pool.data() + range.Offset, range.Size, ShaderLibraryHashSeed),
+                        static_cast<uint32_t>(i));
+                }
+            }
+
+            if (!valid)
+            {
+                archive.SetError();
+                library.Clear();
+            }
+
+            return archive;
+        }
+
+        archive << header;
+        archive << library.Platform;
+        archive << library.Flags;
+
+        uint32_t defines_count = static_cast<uint32_t>(library.m_Defines.size());
+        archive << defines_count;
+
+        for (std::string& define : library.m_Defines)
+        {
+            archive << define;
+        }
+
+        static_assert(std::has_unique_object_representations_v<ShaderLibrary::BlobRange>);
+
+        archive << library.m_Entries;
+        archive << library.m_Blobs;
+
+        uint64_t pool_size     = library.m_Pool.size();
+        uint64_t pool_checksum = Hash::XXHash64::Hash(library.m_Pool.data(), library.m_Pool.size(), ShaderLibraryHashSeed);
+
+        std::vector<std::byte> data{};
+
+        if (pool_size != 0)
+        {
+            [[maybe_unused]] bool result = Compression::CompressBlock(
+                CompressUsing,
+                data,
+                library.m_Pool);
+
+            GX_ASSERT(result);
+        }
+
+        archive << pool_checksum;
+        archive << pool_size;
+        archive << data;
+
+        return archive;
+    }
+}
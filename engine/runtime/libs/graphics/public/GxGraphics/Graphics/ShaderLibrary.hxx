@@ -0,0 +1,121 @@
+#pragma once
+#include <GxGraphics/Graphics.module.hxx>
+#include <GxGraphics/Graphics/ShaderBytecode.hxx>
+#include <GxBase/Status.hxx>
+
+namespace Graphyte::Graphics
+{
+    /// @brief Describes compiled permutation of shader stored in library.
+    struct ShaderLibraryEntry final
+    {
+        /// @brief Set of defines enabled in permutation. Bit N enables define N of library.
+        uint64_t Permutation;
+        GpuRenderAPI RenderAPI;
+        GpuShaderProfile Profile;
+        GpuShaderStage Stage;
+
+        /// @brief Index of bytecode blob. Permutations producing identical bytecode share blob.
+        uint32_t Blob;
+    };
+
+    static_assert(std::has_unique_object_representations_v<ShaderLibraryEntry>, "Entries are serialized in bulk");
+
+    /// @brief Stores all permutations of shader compiled for multiple targets.
+    ///
+    /// Identical bytecode is stored once. Entries are kept sorted, so permutation is found by binary
+    /// search.
+    class GRAPHICS_API ShaderLibrary final
+    {
+    public:
+        static constexpr const uint64_t FileSignature = 0x5a3c1e8f0b7d4a62;
+
+        /// @brief Maximum number of defines, limited by size of permutation mask.
+        static constexpr const size_t MaxDefines = 64;
+
+    private:
+        struct BlobRange final
+        {
+            uint32_t Offset;
+            uint32_t Size;
+        };
+
+    private:
+        std::vector<std::string> m_Defines;
+        std::vector<ShaderLibraryEntry> m_Entries;
+        std::vector<BlobRange> m_Blobs;
+        std::vector<std::byte> m_Pool;
+        std::unordered_multimap<uint64_t, uint32_t> m_BlobIndex;
+
+    public:
+        System::PlatformType Platform;
+        ShaderBytecodeFlags Flags;
+
+    public:
+        ShaderLibrary() noexcept;
+        ~ShaderLibrary() noexcept;
+
+    public:
+        /// @brief Sets names of defines selected by permutation mask.
+        ///
+        /// @return Status::InvalidArgument when there are too many defines, or Status::Success.
+        Status SetDefines(
+            std::vector<std::string> defines) noexcept;
+
+        [[nodiscard]] std::span<const std::string> GetDefines() const noexcept
+        {
+            return m_Defines;
+        }
+
+        /// @brief Computes permutation mask enabling specified defines.
+        ///
+        /// @return The value indicating whether all defines are known to library.
+        [[nodiscard]] bool GetPermutation(
+            uint64_t& result,
+            std::span<const std::string_view> defines) const noexcept;
+
+        /// @brief Adds compiled permutation.
+        ///
+        /// @return Status::AlreadyExists when library already contains permutation, or
+        ///         Status::Success.
+        Status Add(
+            uint64_t permutation,
+            GpuRenderAPI render_api,
+            GpuShaderProfile profile,
+            GpuShaderStage stage,
+            std::span<const std::byte> bytecode) noexcept;
+
+        /// @brief Finds compiled permutation.
+        ///
+        /// @return The entry, or nullptr when library does not contain permutation.
+        [[nodiscard]] const ShaderLibraryEntry* Find(
+            uint64_t permutation,
+            GpuRenderAPI render_api,
+            GpuShaderProfile profile,
+            GpuShaderStage stage) const noexcept;
+
+        [[nodiscard]] GpuShaderBytecode GetBytecode(
+            const ShaderLibraryEntry& entry) const noexcept;
+
+        [[nodiscard]] std::span<const ShaderLibraryEntry> GetEntries() const noexcept
+        {
+            return m_Entries;
+        }
+
+        /// @brief Gets number of unique bytecode blobs.
+        [[nodiscard]] size_t GetBlobCount() const noexcept
+        {
+            return m_Blobs.size();
+        }
+
+        /// @brief Gets size of unique bytecode, in bytes.
+        [[nodiscard]] size_t GetBlobsSize() const noexcept
+        {
+            return m_Pool.size();
+        }
+
+        void Clear() noexcept;
+
+    public:
+        GRAPHICS_API friend Storage::Archive& operator<<(Storage::Archive& archive, ShaderLibrary& library) noexcept;
+    };
+}
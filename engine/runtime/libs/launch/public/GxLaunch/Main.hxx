@@ -2,9 +2,11 @@
 #include <GxBase/Diagnostics.hxx>
 #include <GxBase/CommandLine.hxx>
 #include <GxBase/Threading/TaskDispatcher.hxx>
+#include <GxBase/Storage/AsyncIO.hxx>
 #include <GxBase/System.hxx>
 #include <GxBase/App.hxx>
 #include <GxBase/Diagnostics/Profiler.hxx>
+#include <GxBase/Memory/MemoryTracker.hxx>
 #include <GxBase/Modules.hxx>
 #include <GxBase/Network.hxx>
 #include <GxBase/System/Process.hxx>
@@ -276,6 +278,8 @@ namespace Graphyte::Launch
 
         Threading::TaskDispatcher::Initialize();
 
+        Storage::AsyncIO::Initialize();
+
         ValidateRequirements();
 
         LogBanner();
@@ -293,6 +297,8 @@ namespace Graphyte::Launch
 
         Graphics::Finalize();
 
+        Storage::AsyncIO::Finalize();
+
         Threading::TaskDispatcher::Finalize();
 
         Network::Finalize();
@@ -303,6 +309,8 @@ namespace Graphyte::Launch
 
         System::Finalize();
 
+        Memory::MemoryTracker::ReportLeaks();
+
         Diagnostics::Profiler::Finalize();
         Diagnostics::Finalize();
 
@@ -1,4 +1,8 @@
 #include <catch2/catch.hpp>
+#include <GxBase/Memory/Allocator.hxx>
+#include <GxBase/Bitwise.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+#include <GxBase/System.hxx>
 
 namespace
 {
@@ -13,43 +17,188 @@ namespace
 
 TEST_CASE("Allocator Test")
 {
+    using namespace Graphyte::Memory;
+
     SECTION("Allocator")
     {
-        //auto* object = Graphyte::Platform::New<SampleClass>();
-        //REQUIRE(object != nullptr);
-        //REQUIRE(object->m_Value1 == uint64_t{ 1337 });
-        //REQUIRE(object->m_Value2 == 21.37F);
-        //REQUIRE(object->m_Value3 == "Hello World!");
-        //REQUIRE(Graphyte::Platform::Allocator::g_Instance.Validate());
-        //Graphyte::Platform::Delete(object);
-        //REQUIRE(Graphyte::Platform::Allocator::g_Instance.Validate());
+        uint64_t const usage = MemoryTracker::GetUsage(MemoryPoolTag::General);
+
+        auto* object = New<SampleClass>(MemoryPoolTag::General);
+        REQUIRE(object != nullptr);
+        REQUIRE(object->m_Value1 == uint64_t{ 1337 });
+        REQUIRE(object->m_Value2 == 21.37F);
+        REQUIRE(object->m_Value3 == "Hello World!");
+        REQUIRE(GetAllocationSize(object) == sizeof(SampleClass));
+        REQUIRE(GetAllocationTag(object) == MemoryPoolTag::General);
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::General) >= usage + sizeof(SampleClass));
+        Delete(object);
+    }
+
+    SECTION("Sizes and alignments")
+    {
+        for (size_t alignment = DefaultAlignment; alignment <= MaxAlignment; alignment *= 4)
+        {
+            for (size_t size : { 1, 16, 17, 100, 129, 1000, 4096, 20000, 32768, 100000, 1 << 20 })
+            {
+                auto* memory = static_cast<std::byte*>(Allocate(MemoryPoolTag::Containers, size, alignment));
+                REQUIRE(memory != nullptr);
+                REQUIRE(Graphyte::IsAligned(memory, std::align_val_t{ alignment }));
+                REQUIRE(GetAllocationSize(memory) == size);
+
+                std::memset(memory, 0xCD, size);
+                REQUIRE(memory[size - 1] == std::byte{ 0xCD });
+
+                Free(memory);
+            }
+        }
+
+        Free(nullptr);
+    }
+
+    SECTION("Freed blocks are reused")
+    {
+        void* first = Allocate(MemoryPoolTag::Containers, 48);
+        Free(first);
+
+        void* second = Allocate(MemoryPoolTag::Containers, 48);
+        REQUIRE(first == second);
+        Free(second);
     }
 
     SECTION("Fail with OOM")
     {
-        //Graphyte::Platform::Memory::Initialize();
-        //void* pointer = Graphyte::Platform::Memory::OSVirtualAlloc(4 << 20);
-        //REQUIRE(pointer != nullptr);
-        //uint64_t volatile* data = reinterpret_cast<uint64_t volatile*>(pointer);
-        //*data = 1337;
-        //REQUIRE(*data == uint64_t{ 1337 });
-        //Graphyte::Platform::Memory::OSVirtualFree(pointer, 4 << 20);
+        void* pointer = Graphyte::System::OsVirtualAlloc(4 << 20);
+        REQUIRE(pointer != nullptr);
+        uint64_t volatile* data = reinterpret_cast<uint64_t volatile*>(pointer);
+        *data                   = 1337;
+        REQUIRE(*data == uint64_t{ 1337 });
+        Graphyte::System::OsVirtualFree(pointer, 4 << 20);
+
+        REQUIRE(Allocate(MemoryPoolTag::Containers, std::numeric_limits<size_t>::max() - 16) == nullptr);
     }
 }
 
-//TEST_CASE("String allocator")
-//{
-//    SECTION("Empty string")
-//    {
-//        Graphyte::string s{};
-//        auto const usage = Graphyte::Platform::MemoryTracker::GetUsage(Graphyte::Platform::MemoryPoolTag::Strings);
-//        REQUIRE(usage == uint64_t{ 0 });
-//    }
-//
-//    SECTION("Very large string")
-//    {
-//        Graphyte::string s{ "this string is initialized with kinda large string. It should be allocated on heap anyway." };
-//        auto const usage = Graphyte::Platform::MemoryTracker::GetUsage(Graphyte::Platform::MemoryPoolTag::Strings);
-//        REQUIRE(usage != uint64_t{ 0 });
-//    }
-//}
+TEST_CASE("Memory tracker")
+{
+    using namespace Graphyte::Memory;
+
+    SECTION("Usage and high-water mark")
+    {
+        MemoryPoolUsage const before = MemoryTracker::GetStatistics(MemoryPoolTag::Scripting);
+        MemoryTracker::ResetPeak(MemoryPoolTag::Scripting);
+
+        void* first  = Allocate(MemoryPoolTag::Scripting, 1000);
+        void* second = Allocate(MemoryPoolTag::Scripting, 50000);
+
+        MemoryPoolUsage const during = MemoryTracker::GetStatistics(MemoryPoolTag::Scripting);
+        REQUIRE(during.Allocated == before.Allocated + 51000);
+        REQUIRE(during.Allocations == before.Allocations + 2);
+        REQUIRE(during.TotalAllocations == before.TotalAllocations + 2);
+        REQUIRE(during.Peak == during.Allocated);
+
+        Free(first);
+        Free(second);
+
+        MemoryPoolUsage const after = MemoryTracker::GetStatistics(MemoryPoolTag::Scripting);
+        REQUIRE(after.Allocated == before.Allocated);
+        REQUIRE(after.Allocations == before.Allocations);
+        REQUIRE(after.Peak == during.Peak);
+
+        MemoryTracker::ResetPeak(MemoryPoolTag::Scripting);
+        REQUIRE(MemoryTracker::GetStatistics(MemoryPoolTag::Scripting).Peak == after.Allocated);
+    }
+
+    SECTION("Concurrent allocations")
+    {
+        uint64_t const before = MemoryTracker::GetUsage(MemoryPoolTag::Physics);
+
+        //
+        // Each task passes its blocks on to whichever task finishes next, which frees them while
+        // other tasks still allocate. Blocks are filled with owner byte, so block handed out twice
+        // or overlapping another one is detected on release.
+        //
+
+        struct Handoff final
+        {
+            std::byte Owner;
+            std::vector<std::span<std::byte>> Blocks;
+        };
+
+        constexpr size_t Tasks       = 64;
+        constexpr size_t Allocations = 500;
+
+        std::vector<Handoff> handoffs(Tasks);
+        std::atomic<Handoff*> pending{};
+        std::atomic<size_t> corrupted{};
+
+        auto const release = [&](Handoff& handoff) {
+            for (std::span<std::byte> const block : handoff.Blocks)
+            {
+                if (!std::all_of(block.begin(), block.end(), [&](std::byte value) { return value == handoff.Owner; }))
+                {
+                    ++corrupted;
+                }
+
+                Free(block.data());
+            }
+
+            handoff.Blocks.clear();
+        };
+
+        Graphyte::Threading::ParallelForRange(0, Tasks, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Handoff& handoff = handoffs[i];
+                handoff.Owner    = static_cast<std::byte>(i);
+
+                for (size_t j = 0; j < Allocations; ++j)
+                {
+                    size_t const size = 16 + ((i * 7919 + j * 104729) % 2048);
+                    auto* memory      = static_cast<std::byte*>(Allocate(MemoryPoolTag::Physics, size));
+                    std::memset(memory, static_cast<int>(handoff.Owner), size);
+                    handoff.Blocks.emplace_back(memory, size);
+                }
+
+                if (Handoff* previous = pending.exchange(&handoff); previous != nullptr)
+                {
+                    release(*previous);
+                }
+            }
+        },
+            1);
+
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Physics) > before);
+
+        release(*pending.exchange(nullptr));
+
+        CHECK(corrupted.load() == 0);
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Physics) == before);
+    }
+}
+
+TEST_CASE("String allocator")
+{
+    using namespace Graphyte::Memory;
+
+    using TaggedString = std::basic_string<char, std::char_traits<char>, TaggedAllocator<char, MemoryPoolTag::Strings>>;
+
+    uint64_t const before = MemoryTracker::GetUsage(MemoryPoolTag::Strings);
+
+    SECTION("Empty string")
+    {
+        TaggedString s{};
+        auto const usage = MemoryTracker::GetUsage(MemoryPoolTag::Strings);
+        REQUIRE(usage == before);
+    }
+
+    SECTION("Very large string")
+    {
+        {
+            TaggedString s{ "this string is initialized with kinda large string. It should be allocated on heap anyway." };
+            auto const usage = MemoryTracker::GetUsage(MemoryPoolTag::Strings);
+            REQUIRE(usage > before);
+        }
+
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Strings) == before);
+    }
+}
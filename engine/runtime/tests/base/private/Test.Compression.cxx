@@ -1,5 +1,13 @@
 #include <catch2/catch.hpp>
 #include <GxBase/Compression.hxx>
+#include <GxBase/Compression/CompressedStream.hxx>
+#include <GxBase/Storage/ArchiveFileReader.hxx>
+#include <GxBase/Storage/ArchiveFileWriter.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/Stopwatch.hxx>
+#include <GxBase/System.hxx>
 
 TEST_CASE("Compression")
 {
@@ -47,9 +55,492 @@ TEST_CASE("Compression")
     SECTION("ZLIB")
     {
         std::vector<std::byte> output{};
-        CHECK(Graphyte::Compression::CompressBlock(Graphyte::Compression::CompressionMethod::Zlib, output, data));
+        CHECK(Graphyte::Compression::CompressBlock(Graphyte::Compression::CompressionMethod::ZLib, output, data));
 
         CHECK(output.size() < data.size());
     }
 #endif
+
+#if GX_SDKS_WITH_ZSTD
+    SECTION("Zstd")
+    {
+        using namespace Graphyte::Compression;
+
+        std::vector<std::byte> output{};
+        CHECK(CompressBlock(CompressionMethod::Zstd, output, data));
+        CHECK(output.size() < data.size());
+
+        for (CompressionParameters const parameters : {
+                 CompressionParameters{ .Level = 1 },
+                 CompressionParameters{ .Level = 19 },
+                 CompressionParameters{ .Level = 3, .LongDistanceMatching = true, .WindowLog = 27 },
+             })
+        {
+            std::vector<std::byte> compressed(MemoryBound(CompressionMethod::Zstd, data.size()));
+            size_t size = compressed.size();
+
+            REQUIRE(CompressBlock(CompressionMethod::Zstd, parameters, compressed.data(), size, data.data(), data.size()));
+
+            std::vector<std::byte> decompressed(data.size());
+            REQUIRE(DecompressBlock(CompressionMethod::Zstd, decompressed.data(), decompressed.size(), compressed.data(), size));
+            REQUIRE(decompressed == data);
+        }
+    }
+#endif
+}
+
+namespace
+{
+    std::vector<std::byte> CompressionTestGenerate(size_t size, bool compressible)
+    {
+        std::vector<std::byte> result(size);
+
+        uint32_t seed = 1337;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+
+            if (compressible && ((seed >> 24) & 15) != 0)
+            {
+                result[i] = static_cast<std::byte>((i / 64) % 7);
+            }
+            else
+            {
+                result[i] = static_cast<std::byte>(seed >> 24);
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> CompressionTestRecords(size_t count)
+    {
+        constexpr std::array<std::string_view, 4> const shaders{ {
+            "shaders/opaque.hlsl",
+            "shaders/masked.hlsl",
+            "shaders/translucent.hlsl",
+            "shaders/terrain.hlsl",
+        } };
+
+        std::vector<std::string> result{};
+
+        uint32_t seed = 1337;
+
+        auto generate = [&]() -> uint32_t {
+            return seed = seed * 1103515245 + 12345;
+        };
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.push_back(fmt::format(
+                "material {{ name = \"materials/level_{:02}/mat_{:05}\"; shader = \"{}\"; albedo = [{:.3f}, {:.3f}, {:.3f}]; roughness = {:.2f}; metallic = {:.2f}; flags = 0x{:08x}; }}",
+                generate() % 16,
+                i,
+                shaders[generate() % shaders.size()],
+                (generate() % 1000) / 1000.0F,
+                (generate() % 1000) / 1000.0F,
+                (generate() % 1000) / 1000.0F,
+                (generate() % 100) / 100.0F,
+                (generate() % 2) * 1.0F,
+                generate() & 0x0F0F));
+        }
+
+        return result;
+    }
+
+    class CompressionTestStream final : public Graphyte::Storage::IStream
+    {
+    private:
+        std::vector<std::byte>& m_Buffer;
+        size_t m_Position{};
+
+    public:
+        explicit CompressionTestStream(std::vector<std::byte>& buffer) noexcept
+            : m_Buffer{ buffer }
+        {
+        }
+
+    public:
+        Graphyte::Status Flush() noexcept override
+        {
+            return Graphyte::Status::Success;
+        }
+
+        Graphyte::Status Read(std::span<std::byte> buffer, size_t& processed) noexcept override
+        {
+            processed = std::min(buffer.size(), m_Buffer.size() - m_Position);
+            std::memcpy(buffer.data(), m_Buffer.data() + m_Position, processed);
+            m_Position += processed;
+            return (processed == buffer.size()) ? Graphyte::Status::Success : Graphyte::Status::EndOfStream;
+        }
+
+        Graphyte::Status Write(std::span<const std::byte> buffer, size_t& processed) noexcept override
+        {
+            m_Buffer.resize(std::max(m_Buffer.size(), m_Position + buffer.size()));
+            std::memcpy(m_Buffer.data() + m_Position, buffer.data(), buffer.size());
+            m_Position += buffer.size();
+            processed = buffer.size();
+            return Graphyte::Status::Success;
+        }
+
+        int64_t GetSize() noexcept override
+        {
+            return static_cast<int64_t>(m_Buffer.size());
+        }
+
+        int64_t GetPosition() noexcept override
+        {
+            return static_cast<int64_t>(m_Position);
+        }
+
+        Graphyte::Status SetPosition(int64_t value, Graphyte::Storage::SeekOrigin origin) noexcept override
+        {
+            switch (origin)
+            {
+                case Graphyte::Storage::SeekOrigin::Current:
+                    value += GetPosition();
+                    break;
+                case Graphyte::Storage::SeekOrigin::End:
+                    value += GetSize();
+                    break;
+                default:
+                    break;
+            }
+
+            return SetPosition(value);
+        }
+
+        Graphyte::Status SetPosition(int64_t value) noexcept override
+        {
+            if (value < 0 || value > GetSize())
+            {
+                return Graphyte::Status::InvalidArgument;
+            }
+
+            m_Position = static_cast<size_t>(value);
+            return Graphyte::Status::Success;
+        }
+    };
+}
+
+TEST_CASE("Compression / Frame")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Compression;
+
+    FrameOptions options{};
+    options.BlockSize = 64 << 10;
+
+    SECTION("Round trip")
+    {
+        for (size_t const size : { size_t{ 0 }, size_t{ 1 }, size_t{ 64 << 10 }, size_t{ 1'000'003 } })
+        {
+            for (bool const compressible : { true, false })
+            {
+                auto const data = CompressionTestGenerate(size, compressible);
+
+                std::vector<std::byte> compressed{};
+                REQUIRE(CompressFrame(compressed, data, options));
+
+                if (!compressible)
+                {
+                    // Incompressible blocks are stored.
+                    REQUIRE(compressed.size() <= data.size() + ((data.size() / options.BlockSize) + 1) * 16 + 32);
+                }
+                else if (size > 1024)
+                {
+                    REQUIRE(compressed.size() < data.size() / 2);
+                }
+
+                std::vector<std::byte> decompressed{};
+                REQUIRE(DecompressFrame(decompressed, compressed) == Status::Success);
+                REQUIRE(decompressed == data);
+            }
+        }
+    }
+
+#if GX_SDKS_WITH_ZSTD
+    SECTION("Zstd round trip")
+    {
+        options.Method           = CompressionMethod::Zstd;
+        options.Parameters.Level = 9;
+
+        auto const data = CompressionTestGenerate(1'000'003, true);
+
+        std::vector<std::byte> compressed{};
+        REQUIRE(CompressFrame(compressed, data, options));
+        REQUIRE(compressed.size() < data.size() / 2);
+
+        std::vector<std::byte> decompressed{};
+        REQUIRE(DecompressFrame(decompressed, compressed) == Status::Success);
+        REQUIRE(decompressed == data);
+    }
+#endif
+
+    SECTION("Corruption is detected")
+    {
+        auto const data = CompressionTestGenerate(300'000, true);
+
+        std::vector<std::byte> compressed{};
+        REQUIRE(CompressFrame(compressed, data, options));
+
+        std::vector<std::byte> decompressed{};
+
+        auto corrupted = compressed;
+        corrupted[corrupted.size() / 2] ^= std::byte{ 0x20 };
+        REQUIRE(DecompressFrame(decompressed, corrupted) != Status::Success);
+        REQUIRE(decompressed.empty());
+
+        auto truncated = compressed;
+        truncated.resize(truncated.size() - 5);
+        REQUIRE(DecompressFrame(decompressed, truncated) == Status::EndOfStream);
+
+        auto invalid = compressed;
+        invalid[0] = std::byte{};
+        REQUIRE(DecompressFrame(decompressed, invalid) == Status::InvalidFormat);
+    }
+}
+
+TEST_CASE("Compression / Streams")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Compression;
+
+    auto const data = CompressionTestGenerate(1'500'000, true);
+
+    FrameOptions options{};
+    options.BlockSize   = 64 << 10;
+    options.Concurrency = 3;
+
+    std::vector<std::byte> compressed{};
+
+    {
+        CompressedStreamWriter writer{ std::make_unique<CompressionTestStream>(compressed), options };
+
+        std::span<const std::byte> remaining{ data };
+        size_t chunk = 1;
+
+        while (!remaining.empty())
+        {
+            size_t const count = std::min(chunk, remaining.size());
+            size_t processed{};
+
+            REQUIRE(writer.Write(remaining.first(count), processed) == Status::Success);
+            REQUIRE(processed == count);
+            REQUIRE(writer.Flush() == Status::Success);
+
+            remaining = remaining.subspan(count);
+            chunk     = (chunk * 7 + 13) % 100'000;
+        }
+
+        REQUIRE(writer.Finish() == Status::Success);
+        REQUIRE(writer.GetSize() == static_cast<int64_t>(data.size()));
+    }
+
+    SECTION("Frame written by stream is decompressed as whole")
+    {
+        std::vector<std::byte> decompressed{};
+        REQUIRE(DecompressFrame(decompressed, compressed) == Status::Success);
+        REQUIRE(decompressed == data);
+    }
+
+    SECTION("Sequential read")
+    {
+        CompressedStreamReader reader{ std::make_unique<CompressionTestStream>(compressed) };
+        REQUIRE(reader.GetStatus() == Status::Success);
+        REQUIRE(reader.GetSize() == static_cast<int64_t>(data.size()));
+
+        std::vector<std::byte> decompressed(data.size());
+        size_t processed{};
+        REQUIRE(reader.Read(decompressed, processed) == Status::Success);
+        REQUIRE(processed == data.size());
+        REQUIRE(decompressed == data);
+
+        std::array<std::byte, 16> tail{};
+        REQUIRE(reader.Read(tail, processed) == Status::EndOfStream);
+        REQUIRE(processed == 0);
+        REQUIRE(reader.GetStatus() == Status::Success);
+    }
+
+    SECTION("Seeking")
+    {
+        CompressedStreamReader reader{ std::make_unique<CompressionTestStream>(compressed) };
+
+        std::array<std::byte, 100> buffer{};
+        size_t processed{};
+
+        for (int64_t const position : { int64_t{ 1'000'000 }, int64_t{ 10 }, int64_t{ 65'530 }, int64_t{ 1'499'900 } })
+        {
+            REQUIRE(reader.SetPosition(position) == Status::Success);
+            REQUIRE(reader.GetPosition() == position);
+            REQUIRE(reader.Read(buffer, processed) == Status::Success);
+            REQUIRE(std::equal(buffer.begin(), buffer.end(), data.begin() + position));
+        }
+
+        REQUIRE(reader.SetPosition(static_cast<int64_t>(data.size()) + 1) == Status::EndOfStream);
+    }
+
+    SECTION("Seeking in file")
+    {
+        //
+        // Skipped blocks are seeked over in underlying file stream.
+        //
+
+        auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+        std::string const path = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.compressed.", ".bin");
+        REQUIRE(Storage::WriteBinary(compressed, path) == Status::Success);
+
+        {
+            std::unique_ptr<Storage::IStream> stream{};
+            REQUIRE(fs.OpenRead(stream, path) == Status::Success);
+
+            CompressedStreamReader reader{ std::move(stream) };
+            REQUIRE(reader.GetStatus() == Status::Success);
+
+            std::array<std::byte, 100> buffer{};
+            size_t processed{};
+
+            for (int64_t const position : { int64_t{ 10 }, int64_t{ 1'000'000 }, int64_t{ 65'530 }, int64_t{ 700'000 }, int64_t{ 1'499'900 } })
+            {
+                REQUIRE(reader.SetPosition(position) == Status::Success);
+                REQUIRE(reader.Read(buffer, processed) == Status::Success);
+                REQUIRE(processed == buffer.size());
+                REQUIRE(std::equal(buffer.begin(), buffer.end(), data.begin() + position));
+            }
+        }
+
+        REQUIRE(fs.FileDelete(path) == Status::Success);
+    }
+
+    SECTION("Archive over compressed stream")
+    {
+        std::vector<std::byte> archived{};
+
+        {
+            Storage::ArchiveFileWriter writer{ std::make_unique<CompressedStreamWriter>(std::make_unique<CompressionTestStream>(archived), options) };
+
+            for (uint32_t i = 0; i < 100'000; ++i)
+            {
+                uint32_t value = i * 3;
+                writer << value;
+            }
+
+            REQUIRE_FALSE(writer.IsError());
+        }
+
+        Storage::ArchiveFileReader reader{ std::make_unique<CompressedStreamReader>(std::make_unique<CompressionTestStream>(archived)) };
+        REQUIRE(reader.GetSize() == 400'000);
+
+        bool valid = true;
+
+        for (uint32_t i = 0; i < 100'000; ++i)
+        {
+            uint32_t value{};
+            reader << value;
+            valid &= (value == i * 3);
+        }
+
+        REQUIRE(valid);
+        REQUIRE_FALSE(reader.IsError());
+    }
+}
+
+#if GX_SDKS_WITH_ZSTD
+TEST_CASE("Compression / Dictionary")
+{
+    using namespace Graphyte::Compression;
+
+    auto const records = CompressionTestRecords(4000);
+
+    std::vector<std::span<const std::byte>> samples{};
+
+    for (size_t i = 0; i < records.size(); i += 2)
+    {
+        samples.push_back(std::as_bytes(std::span{ records[i] }));
+    }
+
+    std::vector<std::byte> content{};
+    REQUIRE(TrainDictionary(content, samples, 16 << 10));
+    REQUIRE(!content.empty());
+
+    CompressionDictionary const dictionary{ std::move(content), 3 };
+    REQUIRE(dictionary.IsValid());
+    REQUIRE(dictionary.GetId() != 0);
+
+    size_t plain_size      = 0;
+    size_t dictionary_size = 0;
+
+    std::vector<std::byte> compressed(MemoryBound(CompressionMethod::Zstd, 4096));
+    std::vector<std::byte> decompressed{};
+
+    bool valid = true;
+
+    for (size_t i = 1; i < records.size(); i += 2)
+    {
+        auto const record = std::as_bytes(std::span{ records[i] });
+
+        size_t size = compressed.size();
+        REQUIRE(CompressBlock(CompressionMethod::Zstd, compressed.data(), size, record.data(), record.size()));
+        plain_size += size;
+
+        size = compressed.size();
+        REQUIRE(CompressBlock(dictionary, compressed.data(), size, record.data(), record.size()));
+        dictionary_size += size;
+
+        decompressed.resize(record.size());
+        valid &= DecompressBlock(dictionary, decompressed.data(), decompressed.size(), compressed.data(), size);
+        valid &= std::equal(decompressed.begin(), decompressed.end(), record.begin());
+    }
+
+    REQUIRE(valid);
+    REQUIRE(dictionary_size * 2 < plain_size);
+}
+#endif
+
+TEST_CASE("Compression / Ratio and throughput", "[.][performance]")
+{
+    using namespace Graphyte::Compression;
+    using Graphyte::Diagnostics::Stopwatch;
+
+    auto const data = CompressionTestGenerate(64 << 20, true);
+
+    std::vector<std::byte> compressed{};
+    std::vector<std::byte> decompressed(data.size());
+
+    for (auto const& [method, name] : {
+             std::pair{ CompressionMethod::LZ4, "LZ4" },
+             std::pair{ CompressionMethod::LZ4HC, "LZ4HC" },
+#if GX_SDKS_WITH_ZLIB
+             std::pair{ CompressionMethod::ZLib, "ZLib" },
+#endif
+#if GX_SDKS_WITH_ZSTD
+             std::pair{ CompressionMethod::Zstd, "Zstd" },
+#endif
+         })
+    {
+        Stopwatch compress_watch{};
+        Stopwatch decompress_watch{};
+
+        compress_watch.Start();
+        REQUIRE(CompressBlock(method, compressed, data));
+        compress_watch.Stop();
+
+        decompress_watch.Start();
+        REQUIRE(DecompressBlock(method, decompressed, compressed));
+        decompress_watch.Stop();
+
+        REQUIRE(decompressed == data);
+
+        double const ratio      = static_cast<double>(data.size()) / static_cast<double>(compressed.size());
+        double const compress   = static_cast<double>(data.size()) / compress_watch.GetElapsedTime<double>() / 1.0e6;
+        double const decompress = static_cast<double>(data.size()) / decompress_watch.GetElapsedTime<double>() / 1.0e6;
+
+        WARN(fmt::format("{:<6} ratio {:>6.2f}, compress {:>8.0f} MB/s, decompress {:>8.0f} MB/s",
+            name,
+            ratio,
+            compress,
+            decompress));
+    }
 }
@@ -0,0 +1,738 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Diagnostics.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/String.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Threading.hxx>
+#include <GxBase/Threading/Sync.hxx>
+#include <GxBase/Threading/Thread.hxx>
+
+#if GX_PLATFORM_LINUX
+#include <sys/wait.h>
+#endif
+
+GX_DECLARE_LOG_CATEGORY(LogTestBinary, Trace, Trace);
+GX_DEFINE_LOG_CATEGORY(LogTestBinary);
+
+namespace
+{
+    enum class LogTestEnum
+    {
+        First  = 1,
+        Second = 2,
+    };
+
+    struct LogTestValue final
+    {
+        int32_t X;
+        int32_t Y;
+    };
+
+    template <typename... TArgs>
+    std::string LogTestEncodeAndFormat(std::string_view format, const TArgs&... args)
+    {
+        Graphyte::Diagnostics::LogArgumentEncoder encoder{ sizeof...(TArgs) };
+        (encoder.Encode(args), ...);
+
+        std::string result{};
+        REQUIRE(Graphyte::Diagnostics::FormatLogArguments(result, format, encoder.GetArguments()));
+        return result;
+    }
+
+    //
+    // Captures log output in memory. Writer thread may be held inside Write, so records pile up
+    // in rings of logging threads.
+    //
+
+    struct LogTestOutput final
+    {
+        Graphyte::Threading::CriticalSection Lock{};
+        std::string Content{};
+        std::atomic<bool> Blocked{};
+        std::atomic<bool> Waiting{};
+
+        std::string GetContent() noexcept
+        {
+            Graphyte::Threading::ScopedLock<Graphyte::Threading::CriticalSection> lock{ Lock };
+            return Content;
+        }
+    };
+
+    class LogTestStream final : public Graphyte::Storage::IStream
+    {
+    private:
+        LogTestOutput& m_Output;
+
+    public:
+        explicit LogTestStream(LogTestOutput& output) noexcept
+            : m_Output{ output }
+        {
+        }
+
+    public:
+        Graphyte::Status Flush() noexcept override
+        {
+            return Graphyte::Status::Success;
+        }
+
+        Graphyte::Status Read(std::span<std::byte>, size_t& processed) noexcept override
+        {
+            processed = 0;
+            return Graphyte::Status::NotSupported;
+        }
+
+        Graphyte::Status Write(std::span<const std::byte> buffer, size_t& processed) noexcept override
+        {
+            while (m_Output.Blocked.load())
+            {
+                m_Output.Waiting = true;
+                Graphyte::Threading::SleepThread(1);
+            }
+
+            m_Output.Waiting = false;
+
+            Graphyte::Threading::ScopedLock<Graphyte::Threading::CriticalSection> lock{ m_Output.Lock };
+            m_Output.Content.append(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+            processed = buffer.size();
+            return Graphyte::Status::Success;
+        }
+
+        int64_t GetSize() noexcept override
+        {
+            Graphyte::Threading::ScopedLock<Graphyte::Threading::CriticalSection> lock{ m_Output.Lock };
+            return static_cast<int64_t>(m_Output.Content.size());
+        }
+
+        int64_t GetPosition() noexcept override
+        {
+            return GetSize();
+        }
+
+        Graphyte::Status SetPosition(int64_t, Graphyte::Storage::SeekOrigin) noexcept override
+        {
+            return Graphyte::Status::NotSupported;
+        }
+
+        Graphyte::Status SetPosition(int64_t) noexcept override
+        {
+            return Graphyte::Status::NotSupported;
+        }
+    };
+
+    //
+    // Logs numbered messages, optionally padded to make them large.
+    //
+
+    class LogTestProducer final : public Graphyte::Threading::IRunnable
+    {
+    private:
+        size_t m_Id;
+        size_t m_Count;
+        std::string m_Padding;
+
+    public:
+        std::atomic<bool> Finished{};
+
+    public:
+        LogTestProducer(size_t id, size_t count, size_t padding = 0) noexcept
+            : m_Id{ id }
+            , m_Count{ count }
+            , m_Padding(padding, '.')
+        {
+        }
+
+        virtual uint32_t OnRun() noexcept override
+        {
+            for (size_t i = 0; i < m_Count; ++i)
+            {
+                GX_LOG_INFO(LogTestBinary, "producer {} {} {}\n", m_Id, i, m_Padding);
+            }
+
+            Finished = true;
+            return 0;
+        }
+    };
+
+    //
+    // Parses messages of producers, grouped by producer.
+    //
+
+    std::vector<std::vector<size_t>> LogTestParseProducers(std::string_view content, size_t producers)
+    {
+        std::vector<std::vector<size_t>> result(producers);
+
+        for (std::string_view const line : Graphyte::Split(content, '\n'))
+        {
+            size_t id{};
+            size_t index{};
+
+            if (std::sscanf(std::string{ line }.c_str(), "producer %zu %zu", &id, &index) == 2 && id < producers)
+            {
+                result[id].push_back(index);
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<size_t> LogTestSequence(size_t count)
+    {
+        std::vector<size_t> result(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            result[i] = i;
+        }
+
+        return result;
+    }
+
+    //
+    // Holds writer thread inside write of its next batch.
+    //
+
+    void LogTestBlockWriter(LogTestOutput& output)
+    {
+        output.Blocked = true;
+
+        GX_LOG_INFO(LogTestBinary, "blocker\n");
+
+        for (size_t i = 0; i < 5000 && !output.Waiting.load(); ++i)
+        {
+            Graphyte::Threading::SleepThread(1);
+        }
+
+        REQUIRE(output.Waiting.load());
+    }
+}
+
+template <>
+struct fmt::formatter<LogTestValue> : fmt::formatter<std::string_view>
+{
+    template <typename FormatContext>
+    auto format(const LogTestValue& value, FormatContext& context)
+    {
+        return format_to(context.out(), "({}, {})", value.X, value.Y);
+    }
+};
+
+TEST_CASE("Diagnostics / Log / Deferred arguments")
+{
+    using namespace Graphyte::Diagnostics;
+
+    SECTION("Arithmetic types")
+    {
+        REQUIRE(LogTestEncodeAndFormat("{} {} {}", true, 'c', false) == "true c false");
+        REQUIRE(LogTestEncodeAndFormat("{} {} {}", int8_t{ -8 }, int16_t{ -16 }, int32_t{ -32 }) == "-8 -16 -32");
+        REQUIRE(LogTestEncodeAndFormat("{} {}", int64_t{ -64 }, uint64_t{ 0xFFFF'FFFF'FFFF'FFFF }) == "-64 18446744073709551615");
+        REQUIRE(LogTestEncodeAndFormat("{:08x}", uint32_t{ 0xC0FFEE }) == "00c0ffee");
+        REQUIRE(LogTestEncodeAndFormat("{:.2f} {}", 1.5f, 2.25) == "1.50 2.25");
+    }
+
+    SECTION("Strings")
+    {
+        std::string const value{ "string" };
+        std::string_view const view{ "view" };
+        const char* pointer = "pointer";
+
+        REQUIRE(LogTestEncodeAndFormat("{} {} {} {}", value, view, pointer, "literal") == "string view pointer literal");
+        REQUIRE(LogTestEncodeAndFormat("[{:>6}]", "ab") == "[    ab]");
+    }
+
+    SECTION("Null strings")
+    {
+        const char* pointer = nullptr;
+
+        REQUIRE(LogTestEncodeAndFormat("{}", pointer) == "(null)");
+    }
+
+    SECTION("Pointers")
+    {
+        const void* pointer = reinterpret_cast<const void*>(uintptr_t{ 0x1234 });
+
+        REQUIRE(LogTestEncodeAndFormat("{}", pointer) == "0x1234");
+    }
+
+    SECTION("Enums and formatted types")
+    {
+        REQUIRE(LogTestEncodeAndFormat("{}", LogTestEnum::Second) == "2");
+        REQUIRE(LogTestEncodeAndFormat("{}", LogTestValue{ 1, 2 }) == "(1, 2)");
+    }
+
+    SECTION("Arguments exceeding buffer are truncated")
+    {
+        std::string const large(LogArgumentEncoder::Capacity * 2, 'x');
+
+        LogArgumentEncoder encoder{};
+        encoder.Encode(large);
+        encoder.Encode(42);
+
+        REQUIRE(encoder.GetArguments().size() <= LogArgumentEncoder::Capacity);
+
+        std::string result{};
+        REQUIRE(FormatLogArguments(result, "{} {}", encoder.GetArguments()));
+        REQUIRE(result.ends_with("x <truncated>"));
+    }
+
+    SECTION("Skipped arguments keep positions and ignore format spec")
+    {
+        //
+        // String leaves no space for 64-bit value, but following character still fits.
+        //
+
+        std::string const large(LogArgumentEncoder::Capacity - 14, 'x');
+
+        LogArgumentEncoder encoder{ 3 };
+        encoder.Encode(large);
+        encoder.Encode(uint64_t{ 0xFFFF'FFFF'FFFF'FFFF });
+        encoder.Encode('c');
+
+        std::string result{};
+        REQUIRE(FormatLogArguments(result, "{} {:016x} {}", encoder.GetArguments()));
+        REQUIRE(result == large + " <truncated> c");
+    }
+
+    SECTION("Truncated arguments with numeric format spec")
+    {
+        std::string const large(LogArgumentEncoder::Capacity * 2, 'x');
+
+        LogArgumentEncoder encoder{ 3 };
+        encoder.Encode(large);
+        encoder.Encode(1.5);
+        encoder.Encode(2.5);
+
+        std::string result{};
+        REQUIRE(FormatLogArguments(result, "{} {:.3f} {:.3f}", encoder.GetArguments()));
+        REQUIRE(result.ends_with("x 1.500 <truncated>"));
+    }
+
+    SECTION("Format spec not matching encoded argument")
+    {
+        //
+        // Types with custom formatter are encoded as strings.
+        //
+
+        LogArgumentEncoder encoder{ 1 };
+        encoder.Encode(LogTestValue{ 1, 2 });
+
+        std::string result{};
+        REQUIRE_FALSE(FormatLogArguments(result, "value {:x}\n", encoder.GetArguments()));
+        REQUIRE(result.starts_with("value {:x} <format error: "));
+        REQUIRE(result.ends_with(">\n"));
+    }
+}
+
+TEST_CASE("Diagnostics / Log / Binary log")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Diagnostics;
+
+    auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+    std::string const path = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.log.", ".gxlog");
+
+    std::unique_ptr<Storage::IStream> stream{};
+    REQUIRE(fs.OpenWrite(stream, path, false, true) == Status::Success);
+
+    std::string const large(LogArgumentEncoder::Capacity * 2, 'x');
+    const char* pointer = nullptr;
+
+    bool const binary = Diagnostics::Impl::g_LogBinary.load();
+    std::unique_ptr<Storage::IStream> previous = SetLogOutputFile(std::move(stream), true);
+
+    GX_LOG_INFO(LogTestBinary, "first {} {:.2f} {}\n", 42, 1.5, "text");
+    GX_LOG_INFO(LogTestBinary, "first {} {:.2f} {}\n", -1, 0.25, std::string{ "other" });
+    GX_LOG_WARN(LogTestBinary, "second {}\n", pointer);
+    GX_LOG_INFO(LogTestBinary, "third {} {:.3f} {:.3f}\n", large, 2.0, 3.0);
+
+    stream = SetLogOutputFile(std::move(previous), binary);
+    stream.reset();
+
+    std::vector<std::byte> content{};
+    REQUIRE(Storage::ReadBinary(content, path) == Status::Success);
+
+    std::string const expected = "first 42 1.50 text\n"
+                                 "first -1 0.25 other\n"
+                                 "second (null)\n";
+
+    SECTION("Messages are decoded")
+    {
+        std::string output{};
+        REQUIRE(DecodeBinaryLog(output, content, false) == Status::Success);
+        REQUIRE(output.starts_with(expected));
+        REQUIRE(output.ends_with("x 2.000 <truncated>\n"));
+    }
+
+    SECTION("Messages are decoded with timestamps")
+    {
+        std::string output{};
+        REQUIRE(DecodeBinaryLog(output, content, true) == Status::Success);
+        REQUIRE(output.starts_with("["));
+        REQUIRE(output.find("] first 42 1.50 text\n") != std::string::npos);
+    }
+
+    SECTION("Truncated file")
+    {
+        content.pop_back();
+
+        std::string output{};
+        REQUIRE(DecodeBinaryLog(output, content, false) == Status::EndOfStream);
+        REQUIRE(output == expected);
+    }
+
+    SECTION("Invalid signature")
+    {
+        content[0] = std::byte{};
+
+        std::string output{};
+        REQUIRE(DecodeBinaryLog(output, content, false) == Status::InvalidFormat);
+    }
+
+    REQUIRE(fs.FileDelete(path) == Status::Success);
+}
+
+TEST_CASE("Diagnostics / Log / Switching format while logging")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Diagnostics;
+
+    //
+    // Records queued before switch keep format they were produced in, and are converted to format
+    // of file they are written to.
+    //
+
+    class Producer final : public Threading::IRunnable
+    {
+    private:
+        size_t m_Id;
+        std::atomic<bool>* m_Stop;
+
+    public:
+        size_t Count{};
+
+    public:
+        Producer(size_t id, std::atomic<bool>* stop) noexcept
+            : m_Id{ id }
+            , m_Stop{ stop }
+        {
+        }
+
+        virtual uint32_t OnRun() noexcept override
+        {
+            while (!m_Stop->load())
+            {
+                GX_LOG_INFO(LogTestBinary, "switch {} {}\n", m_Id, Count);
+                ++Count;
+            }
+
+            return 0;
+        }
+    };
+
+    constexpr size_t Producers = 4;
+    constexpr size_t Switches  = 64;
+
+    auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+    LogOverflowPolicy const policy = GetLogOverflowPolicy();
+    SetLogOverflowPolicy(LogOverflowPolicy::Block);
+
+    bool const binary = Diagnostics::Impl::g_LogBinary.load();
+
+    std::vector<std::pair<std::string, bool>> files{};
+
+    auto const open = [&](bool is_binary) {
+        std::string const path = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.log.", is_binary ? ".gxlog" : ".txt");
+
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(fs.OpenWrite(stream, path, false, true) == Status::Success);
+
+        files.emplace_back(path, is_binary);
+        return SetLogOutputFile(std::move(stream), is_binary);
+    };
+
+    std::unique_ptr<Storage::IStream> previous = open(false);
+
+    std::atomic<bool> stop{};
+    std::vector<std::unique_ptr<Producer>> producers{};
+    std::vector<std::unique_ptr<Threading::Thread>> threads{};
+
+    for (size_t i = 0; i < Producers; ++i)
+    {
+        producers.push_back(std::make_unique<Producer>(i, &stop));
+        threads.push_back(std::make_unique<Threading::Thread>());
+        REQUIRE(threads[i]->Start(producers[i].get(), "Log Producer"));
+    }
+
+    for (size_t i = 0; i < Switches; ++i)
+    {
+        Threading::YieldThread();
+        open((i % 2) == 0).reset();
+    }
+
+    stop = true;
+
+    for (auto& thread : threads)
+    {
+        thread->Stop(true);
+    }
+
+    SetLogOutputFile(std::move(previous), binary).reset();
+    SetLogOverflowPolicy(policy);
+
+    //
+    // Every message is written exactly once and intact, whichever file it ended in.
+    //
+
+    size_t expected = 0;
+
+    for (auto const& producer : producers)
+    {
+        expected += producer->Count;
+    }
+
+    std::set<std::string> lines{};
+    size_t count = 0;
+
+    for (auto const& [path, is_binary] : files)
+    {
+        std::string text{};
+
+        if (is_binary)
+        {
+            std::vector<std::byte> content{};
+            REQUIRE(Storage::ReadBinary(content, path) == Status::Success);
+            REQUIRE(DecodeBinaryLog(text, content, false) == Status::Success);
+        }
+        else
+        {
+            REQUIRE(Storage::ReadText(text, path) == Status::Success);
+        }
+
+        for (std::string_view const line : Split(text, '\n'))
+        {
+            lines.emplace(line);
+            ++count;
+        }
+
+        REQUIRE(fs.FileDelete(path) == Status::Success);
+    }
+
+    CHECK(count == expected);
+    CHECK(lines.size() == expected);
+
+    for (size_t i = 0; i < Producers; ++i)
+    {
+        CHECK(lines.contains(fmt::format("switch {} 0", i)));
+        CHECK(lines.contains(fmt::format("switch {} {}", i, producers[i]->Count - 1)));
+    }
+
+    CHECK(std::all_of(lines.begin(), lines.end(), [](const std::string& line) {
+        return line.starts_with("switch ");
+    }));
+}
+
+TEST_CASE("Diagnostics / Log / Asynchronous writer")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Diagnostics;
+
+    bool const async               = IsLogAsync();
+    bool const binary              = Diagnostics::Impl::g_LogBinary.load();
+    LogOverflowPolicy const policy = GetLogOverflowPolicy();
+
+    SetLogAsync(true);
+    REQUIRE(IsLogAsync());
+
+    SetLogOverflowPolicy(LogOverflowPolicy::Block);
+
+    LogTestOutput output{};
+    std::unique_ptr<Storage::IStream> previous = SetLogOutputFile(std::make_unique<LogTestStream>(output), false);
+
+    SECTION("Flush writes pending messages")
+    {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            GX_LOG_INFO(LogTestBinary, "producer 0 {}\n", i);
+        }
+
+        FlushLog();
+
+        std::vector<size_t> const expected = LogTestSequence(100);
+
+        CHECK(LogTestParseProducers(output.GetContent(), 1)[0] == expected);
+    }
+
+    SECTION("Messages of each thread keep their order")
+    {
+        constexpr size_t Producers = 8;
+        constexpr size_t Messages  = 2000;
+
+        std::vector<std::unique_ptr<LogTestProducer>> producers{};
+        std::vector<std::unique_ptr<Threading::Thread>> threads{};
+
+        for (size_t i = 0; i < Producers; ++i)
+        {
+            producers.push_back(std::make_unique<LogTestProducer>(i, Messages));
+            threads.push_back(std::make_unique<Threading::Thread>());
+            REQUIRE(threads[i]->Start(producers[i].get(), "Log Producer"));
+        }
+
+        for (auto& thread : threads)
+        {
+            thread->Stop(true);
+        }
+
+        FlushLog();
+
+        std::vector<size_t> const expected = LogTestSequence(Messages);
+
+        for (std::vector<size_t> const& indices : LogTestParseProducers(output.GetContent(), Producers))
+        {
+            CHECK(indices == expected);
+        }
+    }
+
+    SECTION("Drop policy discards and counts messages")
+    {
+        constexpr size_t Messages = 200;
+
+        SetLogOverflowPolicy(LogOverflowPolicy::Drop);
+        LogTestBlockWriter(output);
+
+        uint64_t const dropped = GetLogDroppedCount();
+
+        //
+        // Ring of this thread overflows, writer thread can't free space.
+        //
+
+        LogTestProducer producer{ 0, Messages, 1000 };
+        producer.OnRun();
+
+        output.Blocked = false;
+        FlushLog();
+
+        std::string const content         = output.GetContent();
+        std::vector<size_t> const written = LogTestParseProducers(content, 1)[0];
+
+        std::vector<size_t> const expected = LogTestSequence(written.size());
+
+        REQUIRE(written.size() < Messages);
+        CHECK(written == expected);
+        CHECK(GetLogDroppedCount() - dropped == Messages - written.size());
+        CHECK(content.find(fmt::format("Log overflow: {} messages dropped\n", Messages - written.size())) != std::string::npos);
+    }
+
+    SECTION("Block policy waits for writer")
+    {
+        constexpr size_t Messages = 200;
+
+        LogTestBlockWriter(output);
+
+        uint64_t const dropped = GetLogDroppedCount();
+
+        LogTestProducer producer{ 0, Messages, 1000 };
+        Threading::Thread thread{};
+        REQUIRE(thread.Start(&producer, "Log Producer"));
+
+        Threading::SleepThread(50);
+        CHECK_FALSE(producer.Finished.load());
+
+        output.Blocked = false;
+        thread.Stop(true);
+        FlushLog();
+
+        std::vector<size_t> const expected = LogTestSequence(Messages);
+
+        CHECK(producer.Finished.load());
+        CHECK(GetLogDroppedCount() == dropped);
+        CHECK(LogTestParseProducers(output.GetContent(), 1)[0] == expected);
+    }
+
+    output.Blocked = false;
+
+    SetLogOutputFile(std::move(previous), binary).reset();
+    SetLogOverflowPolicy(policy);
+    SetLogAsync(async);
+}
+
+#if GX_PLATFORM_LINUX
+
+TEST_CASE("Diagnostics / Log / Crash handler writes pending messages")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Diagnostics;
+
+    auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+    std::string const path = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.log.", ".txt");
+
+    std::unique_ptr<Storage::IStream> stream{};
+    REQUIRE(fs.OpenWrite(stream, path, false, true) == Status::Success);
+
+    bool const async  = IsLogAsync();
+    bool const binary = Diagnostics::Impl::g_LogBinary.load();
+
+    SetLogAsync(true);
+
+    std::unique_ptr<Storage::IStream> previous = SetLogOutputFile(std::move(stream), false);
+    FlushLog();
+
+    LogOverflowPolicy const policy = GetLogOverflowPolicy();
+
+    pid_t const child = fork();
+    REQUIRE(child >= 0);
+
+    if (child == 0)
+    {
+        //
+        // Writer thread does not exist in child process, so messages stay in ring until it is
+        // full. Crash report fits only when crash handler writes pending messages and switches to
+        // synchronous output first. Crash handler terminates process.
+        //
+
+        SetLogOverflowPolicy(LogOverflowPolicy::Drop);
+
+        uint64_t const dropped = GetLogDroppedCount();
+
+        for (size_t i = 0; GetLogDroppedCount() == dropped; ++i)
+        {
+            GX_LOG_INFO(LogTestBinary, "producer 0 {}\n", i);
+        }
+
+        OnCrash(nullptr, nullptr);
+    }
+
+    int status{};
+    REQUIRE(waitpid(child, &status, 0) == child);
+    CHECK(WIFSIGNALED(status));
+
+    SetLogOutputFile(std::move(previous), binary).reset();
+    SetLogOverflowPolicy(policy);
+    SetLogAsync(async);
+
+    std::string content{};
+    REQUIRE(Storage::ReadText(content, path) == Status::Success);
+
+    std::vector<size_t> const written = LogTestParseProducers(content, 1)[0];
+
+    std::vector<size_t> const expected = LogTestSequence(written.size());
+
+    REQUIRE_FALSE(written.empty());
+    CHECK(written == expected);
+
+    //
+    // Pending messages are written before crash report.
+    //
+
+    size_t const crash = content.find("Application crashed:\n");
+    REQUIRE(crash != std::string::npos);
+    CHECK(content.find(fmt::format("producer 0 {}\n", written.back())) < crash);
+    CHECK(content.find("Log overflow: 1 messages dropped\n") < crash);
+
+    REQUIRE(fs.FileDelete(path) == Status::Success);
+}
+
+#endif
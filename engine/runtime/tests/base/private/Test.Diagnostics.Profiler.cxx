@@ -0,0 +1,188 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Diagnostics/Profiler.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Threading/Thread.hxx>
+#include <GxBase/Stopwatch.hxx>
+
+namespace
+{
+    class ProfiledThread final : public Graphyte::Threading::IRunnable
+    {
+    public:
+        uint32_t OnRun() noexcept override
+        {
+            Graphyte::Diagnostics::Profiler::ThreadName("profiled-thread");
+
+            for (uint32_t i = 0; i < 100; ++i)
+            {
+                GX_PROFILE_REGION("thread-outer");
+                GX_PROFILE_REGION("thread-inner");
+            }
+
+            return 0;
+        }
+    };
+}
+
+TEST_CASE("Diagnostics / Profiler / Capture")
+{
+    using namespace Graphyte;
+    using namespace Graphyte::Diagnostics;
+
+    Profiler::Reset();
+    Profiler::Enable(true);
+
+    {
+        GX_PROFILE_REGION("main-outer");
+
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            GX_PROFILE_REGION("main \"quoted\" inner");
+        }
+
+        GX_PROFILE_MARKER("main-marker");
+    }
+
+    ProfiledThread runnable{};
+    Threading::Thread thread{};
+    thread.Start(&runnable, "profiled");
+    thread.Stop(true);
+
+    Profiler::Enable(false);
+
+    {
+        GX_PROFILE_REGION("not-recorded");
+    }
+
+    auto const temp_dir = System::GetUserTemporaryDirectory();
+
+    SECTION("Chrome trace")
+    {
+        auto const path = Storage::CreateTemporaryFilePath(temp_dir, "test.profiler", ".json");
+
+        REQUIRE(Profiler::Capture(path, ProfilerCaptureFormat::ChromeTrace) == Status::Success);
+
+        std::string content{};
+        REQUIRE(Storage::ReadText(content, path) == Status::Success);
+
+        REQUIRE(content.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        REQUIRE(content.find("\"name\":\"main-outer\"") != std::string::npos);
+        REQUIRE(content.find("\"name\":\"main \\\"quoted\\\" inner\"") != std::string::npos);
+        REQUIRE(content.find("\"name\":\"main-marker\"") != std::string::npos);
+        REQUIRE(content.find("\"name\":\"thread-inner\"") != std::string::npos);
+        REQUIRE(content.find("{\"name\":\"profiled-thread\"}") != std::string::npos);
+        REQUIRE(content.find("not-recorded") == std::string::npos);
+        REQUIRE(content.find("Test.Diagnostics.Profiler.cxx") != std::string::npos);
+
+        REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(path) == Status::Success);
+    }
+
+    SECTION("Binary capture")
+    {
+        auto const path = Storage::CreateTemporaryFilePath(temp_dir, "test.profiler", ".gxprof");
+
+        REQUIRE(Profiler::Capture(path, ProfilerCaptureFormat::Binary) == Status::Success);
+
+        std::vector<std::byte> content{};
+        REQUIRE(Storage::ReadBinary(content, path) == Status::Success);
+
+        //
+        // Each region is two events of 11 bytes.
+        //
+
+        REQUIRE(content.size() > ((10 + 1 + 200) * 2 * 11));
+
+        REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(path) == Status::Success);
+    }
+}
+
+TEST_CASE("Diagnostics / Profiler / Descriptors")
+{
+    using namespace Graphyte::Diagnostics;
+
+    SECTION("Static descriptors")
+    {
+        static const ProfilerRegionDescriptor descriptor{ "static-region", __FILE__, __LINE__, 0xFF00FF00 };
+
+        ProfilerRegionId const id = Profiler::Register(descriptor);
+        REQUIRE(id != 0);
+        REQUIRE(&Profiler::GetDescriptor(id) == &descriptor);
+    }
+
+    SECTION("Interned names")
+    {
+        std::string name{ "dynamic-" };
+        name.append(std::to_string(42));
+
+        ProfilerRegionId const first = Profiler::InternName(name, 0xFFFF0000);
+        REQUIRE(first != 0);
+
+        std::string const copy = name;
+        name.clear();
+
+        ProfilerRegionId const second = Profiler::InternName(copy);
+        REQUIRE(first == second);
+
+        const ProfilerRegionDescriptor& descriptor = Profiler::GetDescriptor(first);
+        REQUIRE(std::string_view{ descriptor.Name } == "dynamic-42");
+        REQUIRE(descriptor.File == nullptr);
+        REQUIRE(descriptor.Color == 0xFFFF0000);
+
+        REQUIRE(Profiler::InternName("dynamic-43") != first);
+    }
+
+    SECTION("Unknown descriptor")
+    {
+        REQUIRE(std::string_view{ Profiler::GetDescriptor(0).Name } == "<unknown>");
+    }
+}
+
+TEST_CASE("Diagnostics / Profiler / Region overhead", "[.][performance]")
+{
+    using namespace Graphyte::Diagnostics;
+
+    constexpr uint32_t const Count = 1'000'000;
+
+    Stopwatch watch{};
+    std::string_view name{};
+
+    SECTION("Disabled")
+    {
+        name = "disabled";
+        Profiler::Enable(false);
+
+        watch.Start();
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            GX_PROFILE_REGION("overhead");
+        }
+
+        watch.Stop();
+    }
+
+    SECTION("Enabled")
+    {
+        name = "enabled";
+        Profiler::Enable(true);
+
+        watch.Start();
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            GX_PROFILE_REGION("overhead");
+        }
+
+        watch.Stop();
+
+        Profiler::Enable(false);
+        Profiler::Reset();
+    }
+
+    WARN(fmt::format("{:<10} {:>8.1f} ns per region",
+        name,
+        (watch.GetElapsedTime<double>() * 1.0e9) / Count));
+}
@@ -0,0 +1,261 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Memory/Arena.hxx>
+#include <GxBase/Memory/MemoryResource.hxx>
+#include <GxBase/Bitwise.hxx>
+
+TEST_CASE("Linear arena")
+{
+    using namespace Graphyte::Memory;
+
+    SECTION("Alignment and exhaustion")
+    {
+        LinearArena arena{ 4096, MemoryPoolTag::Rendering };
+        REQUIRE(arena.GetCapacity() == 4096);
+        REQUIRE(arena.GetTag() == MemoryPoolTag::Rendering);
+
+        for (size_t alignment : { 1, 8, 16, 64, 256 })
+        {
+            void* memory = arena.Allocate(3, alignment);
+            REQUIRE(memory != nullptr);
+            REQUIRE(Graphyte::IsAligned(memory, std::align_val_t{ alignment }));
+            REQUIRE(arena.Contains(memory));
+        }
+
+        REQUIRE(arena.Allocate(8192) == nullptr);
+
+        size_t count = 0;
+        while (arena.Allocate(64) != nullptr)
+        {
+            ++count;
+        }
+
+        REQUIRE(count > 0);
+        REQUIRE(arena.GetUsed() <= arena.GetCapacity());
+        REQUIRE(arena.GetPeak() == arena.GetUsed());
+
+        arena.Reset();
+        REQUIRE(arena.GetUsed() == 0);
+        REQUIRE(arena.GetPeak() > 0);
+        REQUIRE(arena.Allocate(64) != nullptr);
+    }
+
+    SECTION("Markers")
+    {
+        LinearArena arena{ 4096, MemoryPoolTag::Rendering };
+
+        void* first = arena.Allocate(100);
+        REQUIRE(first != nullptr);
+
+        ArenaMarker const marker = arena.GetMarker();
+        size_t const used        = arena.GetUsed();
+
+        void* second = arena.Allocate(200);
+        REQUIRE(second != nullptr);
+        REQUIRE(arena.GetUsed() > used);
+
+        arena.Release(marker);
+        REQUIRE(arena.GetUsed() == used);
+
+        void* third = arena.Allocate(200);
+        REQUIRE(third == second);
+    }
+
+    SECTION("Scoped arena")
+    {
+        LinearArena arena{ 4096, MemoryPoolTag::Rendering };
+
+        std::ignore = arena.Allocate(100);
+        size_t const used = arena.GetUsed();
+
+        {
+            ScopedArena scope{ arena };
+            int* values = scope.GetArena().AllocateArray<int>(100);
+            REQUIRE(values != nullptr);
+            REQUIRE(Graphyte::IsAligned(values, std::align_val_t{ alignof(int) }));
+
+            {
+                ScopedArena nested{ arena };
+                REQUIRE(arena.AllocateArray<double>(50) != nullptr);
+            }
+
+            REQUIRE(arena.GetUsed() > used);
+        }
+
+        REQUIRE(arena.GetUsed() == used);
+        REQUIRE(arena.AllocateArray<uint64_t>(std::numeric_limits<size_t>::max() / 4) == nullptr);
+    }
+
+    SECTION("External memory")
+    {
+        uint64_t const before = MemoryTracker::GetUsage(MemoryPoolTag::Rendering);
+
+        alignas(64) std::byte buffer[1024];
+        LinearArena arena{ std::span<std::byte>{ buffer } };
+
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Rendering) == before);
+
+        void* memory = arena.Allocate(128);
+        REQUIRE(memory != nullptr);
+        REQUIRE(memory >= std::begin(buffer));
+        REQUIRE(memory < std::end(buffer));
+        REQUIRE(arena.Allocate(2048) == nullptr);
+    }
+
+    SECTION("Move")
+    {
+        LinearArena first{ 1024, MemoryPoolTag::Rendering };
+        void* memory = first.Allocate(16);
+
+        LinearArena second{ std::move(first) };
+        REQUIRE(second.Contains(memory));
+        REQUIRE(first.GetCapacity() == 0);
+        REQUIRE(first.Allocate(16) == nullptr);
+    }
+}
+
+TEST_CASE("Frame arena")
+{
+    using namespace Graphyte::Memory;
+
+    uint64_t const before = MemoryTracker::GetUsage(MemoryPoolTag::Rendering);
+
+    {
+        FrameArena arena{ 2, 1024, MemoryPoolTag::Rendering };
+        REQUIRE(arena.GetFrameCount() == 2);
+
+        uint64_t const reserved = MemoryTracker::GetUsage(MemoryPoolTag::Rendering);
+        REQUIRE(reserved >= before + 2048);
+
+        void* frame0 = arena.Allocate(100);
+        REQUIRE(frame0 != nullptr);
+
+        arena.BeginFrame();
+        void* frame1 = arena.Allocate(100);
+        REQUIRE(frame1 != nullptr);
+        REQUIRE(frame1 != frame0);
+        REQUIRE_FALSE(arena.GetCurrent().Contains(frame0));
+
+        //
+        // Arena of first frame is reused after all frames in flight were started.
+        //
+
+        arena.BeginFrame();
+        REQUIRE(arena.GetCurrent().GetUsed() == 0);
+        REQUIRE(arena.Allocate(100) == frame0);
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            arena.BeginFrame();
+            REQUIRE(arena.Allocate(512) != nullptr);
+        }
+
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Rendering) == reserved);
+    }
+
+    REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Rendering) == before);
+}
+
+TEST_CASE("Arena memory resource")
+{
+    using namespace Graphyte::Memory;
+
+    SECTION("Containers allocate from arena")
+    {
+        LinearArena arena{ 64 << 10, MemoryPoolTag::Assets };
+        ArenaMemoryResource resource{ arena };
+
+        uint64_t const before = MemoryTracker::GetStatistics(MemoryPoolTag::Assets).TotalAllocations;
+
+        {
+            std::pmr::vector<int> values{ &resource };
+            for (int i = 0; i < 1000; ++i)
+            {
+                values.push_back(i);
+            }
+
+            std::pmr::string text{ "this string is long enough to be allocated outside of string object", &resource };
+
+            REQUIRE(arena.Contains(values.data()));
+            REQUIRE(arena.Contains(text.data()));
+            REQUIRE(values[999] == 999);
+        }
+
+        REQUIRE(MemoryTracker::GetStatistics(MemoryPoolTag::Assets).TotalAllocations == before);
+        REQUIRE(resource.GetOverflowCount() == 0);
+    }
+
+    SECTION("Overflow to upstream")
+    {
+        uint64_t const before = MemoryTracker::GetUsage(MemoryPoolTag::Assets);
+
+        TaggedMemoryResource upstream{ MemoryPoolTag::Assets };
+        LinearArena arena{ 256, MemoryPoolTag::Rendering };
+        ArenaMemoryResource resource{ arena, &upstream };
+
+        {
+            std::pmr::vector<uint64_t> values{ &resource };
+            values.resize(1000);
+
+            REQUIRE_FALSE(arena.Contains(values.data()));
+            REQUIRE(resource.GetOverflowCount() > 0);
+            REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Assets) >= before + sizeof(uint64_t) * 1000);
+        }
+
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Assets) == before);
+    }
+
+    SECTION("Tagged resource")
+    {
+        uint64_t const before = MemoryTracker::GetUsage(MemoryPoolTag::Assets);
+
+        TaggedMemoryResource resource{ MemoryPoolTag::Assets };
+        TaggedMemoryResource other{ MemoryPoolTag::Geometry };
+        REQUIRE(resource.is_equal(other));
+
+        {
+            std::pmr::vector<float> values{ 100, &resource };
+            REQUIRE(GetAllocationTag(values.data()) == MemoryPoolTag::Assets);
+            REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Assets) > before);
+        }
+
+        REQUIRE(MemoryTracker::GetUsage(MemoryPoolTag::Assets) == before);
+    }
+}
+
+#if GX_ENABLE_MEMORY_GUARDS
+
+TEST_CASE("Arena memory guards")
+{
+    using namespace Graphyte::Memory;
+
+    LinearArena arena{ 1024, MemoryPoolTag::Rendering };
+
+    SECTION("Poisoning")
+    {
+        ArenaMarker const marker = arena.GetMarker();
+
+        auto* memory = static_cast<std::byte*>(arena.Allocate(32));
+        REQUIRE(memory != nullptr);
+        REQUIRE(memory[0] == std::byte{ 0xCD });
+        REQUIRE(memory[31] == std::byte{ 0xCD });
+
+        arena.Release(marker);
+        REQUIRE(memory[0] == std::byte{ 0xDD });
+        REQUIRE(memory[31] == std::byte{ 0xDD });
+    }
+
+    SECTION("Overflow detection")
+    {
+        auto* memory = static_cast<std::byte*>(arena.Allocate(32));
+        REQUIRE(arena.Validate());
+
+        std::byte const saved = memory[32];
+        memory[32]            = std::byte{ 0 };
+        REQUIRE_FALSE(arena.Validate());
+
+        memory[32] = saved;
+        REQUIRE(arena.Validate());
+    }
+}
+
+#endif
@@ -2,6 +2,10 @@
 #include <GxBase/Base.module.hxx>
 #include <GxBase/System.hxx>
 #include <GxBase/ObjectPool.hxx>
+#include <GxBase/Bitwise.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+#include <GxBase/Threading/Thread.hxx>
+#include <GxBase/Stopwatch.hxx>
 
 #include <random>
 
@@ -199,3 +203,238 @@ TEST_CASE("Object pool")
         CHECK(allocations.empty());
     }
 }
+
+TEST_CASE("Concurrent object pool")
+{
+    struct SomeObject final
+    {
+        uint64_t Owner;
+        uint64_t Index;
+    };
+
+    using SomeObjectPool = Graphyte::ConcurrentPoolContainer<SomeObject, 1024>;
+
+    SomeObjectPool pool{};
+
+    SECTION("Predictable results")
+    {
+        CHECK(pool.GetCount() == 0);
+        CHECK(pool.GetCapacity() == 0);
+
+        auto object1 = pool.Allocate();
+        auto object2 = pool.Allocate();
+
+        CHECK(object1 != object2);
+        CHECK(pool.GetCount() == 2);
+        CHECK(pool.GetCapacity() == SomeObjectPool::PoolCapacity);
+        CHECK(Graphyte::IsAligned(object1, std::align_val_t{ alignof(SomeObject) }));
+
+        pool.Deallocate(object1);
+        CHECK(pool.GetCount() == 1);
+
+        //
+        // Most recently freed item is reused first.
+        //
+
+        auto object3 = pool.Allocate();
+        CHECK(object3 == object1);
+
+        pool.Deallocate(object2);
+        pool.Deallocate(object3);
+
+        CHECK(pool.GetCount() == 0);
+        CHECK(pool.GetCapacity() == SomeObjectPool::PoolCapacity);
+    }
+
+    SECTION("Concurrent alloc/dealloc")
+    {
+        //
+        // Tasks churn through pool with random mix of allocations and deallocations, keeping
+        // bounded number of live objects each. Objects are stamped on allocation and checked
+        // before release, so item handed out twice is detected.
+        //
+
+        static constexpr const size_t Tasks      = 32;
+        static constexpr const size_t Operations = 20000;
+        static constexpr const size_t MaxLive    = 256;
+
+        std::vector<std::vector<SomeObject*>> live(Tasks);
+        std::atomic<size_t> corrupted{};
+
+        for (size_t round = 0; round < 3; ++round)
+        {
+            Graphyte::Threading::ParallelForRange(0, Tasks, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    std::mt19937 random{ static_cast<uint32_t>(round * Tasks + i) };
+
+                    std::vector<SomeObject*>& objects = live[i];
+                    std::vector<uint64_t> stamps{};
+
+                    for (size_t j = 0; j < Operations; ++j)
+                    {
+                        if (objects.size() < MaxLive && (objects.empty() || (random() & 1) != 0))
+                        {
+                            SomeObject* object = pool.Allocate();
+                            object->Owner      = i;
+                            object->Index      = j;
+                            objects.push_back(object);
+                            stamps.push_back(j);
+                        }
+                        else
+                        {
+                            size_t const index = random() % objects.size();
+                            SomeObject* object = objects[index];
+
+                            if (object->Owner != i || object->Index != stamps[index])
+                            {
+                                ++corrupted;
+                            }
+
+                            objects[index] = objects.back();
+                            objects.pop_back();
+                            stamps[index] = stamps.back();
+                            stamps.pop_back();
+
+                            pool.Deallocate(object);
+                        }
+                    }
+                }
+            },
+                1);
+
+            CHECK(corrupted.load() == 0);
+
+            std::set<SomeObject*> unique{};
+            size_t count = 0;
+
+            for (size_t i = 0; i < Tasks; ++i)
+            {
+                for (SomeObject* object : live[i])
+                {
+                    CHECK(object->Owner == i);
+                    unique.insert(object);
+                    ++count;
+                }
+            }
+
+            CHECK(unique.size() == count);
+            CHECK(pool.GetCount() == count);
+
+            //
+            // Survivors are freed on this thread, away from caches of threads which allocated them.
+            //
+
+            for (std::vector<SomeObject*>& objects : live)
+            {
+                for (SomeObject* object : objects)
+                {
+                    pool.Deallocate(object);
+                }
+
+                objects.clear();
+            }
+
+            CHECK(pool.GetCount() == 0);
+        }
+
+        //
+        // Freed items are reused instead of growing pool.
+        //
+
+        CHECK(pool.GetCapacity() <= (2 * Tasks * MaxLive));
+    }
+}
+
+TEST_CASE("Concurrent object pool / throughput", "[.][performance]")
+{
+    using Graphyte::Diagnostics::Stopwatch;
+    using namespace Graphyte::Threading;
+
+    struct SomeObject final
+    {
+        uint64_t Owner;
+        uint64_t Index;
+    };
+
+    using SomeObjectPool = Graphyte::ConcurrentPoolContainer<SomeObject, 1024>;
+
+    //
+    // Each thread repeatedly allocates small burst of objects and frees them, like transient
+    // per-frame objects. Throughput should grow with number of threads up to number of cores.
+    //
+
+    class Churn final : public IRunnable
+    {
+    private:
+        SomeObjectPool* m_Pool;
+        size_t m_Operations;
+
+    public:
+        Churn(SomeObjectPool* pool, size_t operations) noexcept
+            : m_Pool{ pool }
+            , m_Operations{ operations }
+        {
+        }
+
+        virtual uint32_t OnRun() noexcept override
+        {
+            std::array<SomeObject*, 64> objects{};
+
+            for (size_t i = 0; i < m_Operations; i += objects.size())
+            {
+                for (SomeObject*& object : objects)
+                {
+                    object        = m_Pool->Allocate();
+                    object->Index = i;
+                }
+
+                for (SomeObject* object : objects)
+                {
+                    m_Pool->Deallocate(object);
+                }
+            }
+
+            return 0;
+        }
+    };
+
+    constexpr size_t Operations = 1u << 22;
+
+    for (size_t threads = 1; threads <= 32; threads *= 2)
+    {
+        SomeObjectPool pool{};
+
+        std::vector<std::unique_ptr<Churn>> runnables{};
+        std::vector<std::unique_ptr<Thread>> workers{};
+
+        for (size_t i = 0; i < threads; ++i)
+        {
+            runnables.push_back(std::make_unique<Churn>(&pool, Operations));
+            workers.push_back(std::make_unique<Thread>());
+        }
+
+        Stopwatch watch{};
+        watch.Start();
+
+        for (size_t i = 0; i < threads; ++i)
+        {
+            REQUIRE(workers[i]->Start(runnables[i].get(), "Pool Churn"));
+        }
+
+        for (std::unique_ptr<Thread>& worker : workers)
+        {
+            worker->Stop(true);
+        }
+
+        watch.Stop();
+
+        REQUIRE(pool.GetCount() == 0);
+
+        double const seconds = watch.GetElapsedTime<double>();
+
+        WARN(fmt::format("{} threads: {:.1f} M alloc/free pairs per second",
+            threads,
+            static_cast<double>(threads * Operations) / seconds / 1'000'000.0));
+    }
+}
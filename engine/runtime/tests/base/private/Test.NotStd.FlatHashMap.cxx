@@ -0,0 +1,383 @@
+#include <catch2/catch.hpp>
+#include <GxBase/HashContainers.hxx>
+#include <GxBase/FlatContainers.hxx>
+#include <GxBase/Stopwatch.hxx>
+
+namespace
+{
+    struct CollidingHash final
+    {
+        size_t operator()(int) const noexcept
+        {
+            return 42;
+        }
+    };
+
+    struct CountingHash final
+    {
+        static inline size_t Calls{};
+
+        size_t operator()(int value) const noexcept
+        {
+            ++Calls;
+            return std::hash<int>{}(value);
+        }
+    };
+
+    struct CountedValue final
+    {
+        static inline size_t Constructions{};
+
+        int Value;
+
+        CountedValue(int value) noexcept
+            : Value{ value }
+        {
+            ++Constructions;
+        }
+    };
+
+    std::vector<std::string> HashContainersTestKeys(size_t count)
+    {
+        std::vector<std::string> result{};
+        result.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.push_back(fmt::format("content/models/group_{}/asset_{}.mesh", i % 97, i));
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("notstd::flat_hash_map")
+{
+    REQUIRE(notstd::flat_hash_map<int, int>{}.empty());
+
+    notstd::flat_hash_map<int, int> items{ {
+        // clang-format off
+        { 1, 2 },
+        { 3, 4 },
+        { 5, 6 },
+        // clang-format on
+    } };
+
+    REQUIRE(items.size() == 3);
+    REQUIRE(items.capacity() >= items.size());
+    REQUIRE(items[1] == 2);
+    REQUIRE(items[3] == 4);
+    REQUIRE(items[5] == 6);
+    REQUIRE(items.at(5) == 6);
+
+    SECTION("Insert and emplace")
+    {
+        REQUIRE(items.insert({ 7, 8 }).second);
+        REQUIRE_FALSE(items.insert({ 7, 9 }).second);
+        REQUIRE(items[7] == 8);
+
+        REQUIRE(items.emplace(9, 10).second);
+        REQUIRE(items.try_emplace(11, 12).second);
+        REQUIRE_FALSE(items.try_emplace(11, 13).second);
+        REQUIRE(items[11] == 12);
+
+        REQUIRE_FALSE(items.insert_or_assign(11, 14).second);
+        REQUIRE(items[11] == 14);
+
+        REQUIRE(items.size() == 6);
+    }
+
+    SECTION("Erase")
+    {
+        REQUIRE(items.erase(3) == 1);
+        REQUIRE(items.erase(3) == 0);
+        REQUIRE_FALSE(items.contains(3));
+        REQUIRE(items.size() == 2);
+
+        auto const next = items.erase(items.find(1));
+        REQUIRE(items.size() == 1);
+        REQUIRE((next == items.end() || next->first == 5));
+
+        items.clear();
+        REQUIRE(items.empty());
+        REQUIRE(items.find(5) == items.end());
+    }
+
+    SECTION("Copy, move and compare")
+    {
+        auto copy = items;
+        REQUIRE(copy == items);
+
+        copy[1] = 100;
+        REQUIRE(copy != items);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved[1] == 100);
+        REQUIRE(moved.size() == 3);
+    }
+
+    SECTION("Many elements against reference")
+    {
+        std::unordered_map<int, int> reference{};
+        uint32_t seed = 2137;
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            seed           = seed * 1664525u + 1013904223u;
+            int const key  = static_cast<int>(seed >> 16);
+            bool const add = (seed & 3) != 0;
+
+            if (add)
+            {
+                items.insert_or_assign(key, i);
+                reference[key] = i;
+            }
+            else
+            {
+                REQUIRE(items.erase(key) == reference.erase(key));
+            }
+        }
+
+        reference.insert({ { 1, 2 }, { 3, 4 }, { 5, 6 } });
+
+        REQUIRE(items.size() == reference.size());
+        REQUIRE(items.load_factor() <= items.max_load_factor());
+
+        for (auto const& [key, value] : reference)
+        {
+            auto const it = items.find(key);
+            REQUIRE(it != items.end());
+            REQUIRE(it->second == value);
+        }
+
+        size_t visited = 0;
+
+        for (auto const& [key, value] : items)
+        {
+            REQUIRE(reference.at(key) == value);
+            ++visited;
+        }
+
+        REQUIRE(visited == reference.size());
+    }
+}
+
+TEST_CASE("notstd::flat_hash_map / string keys")
+{
+    notstd::flat_hash_map<std::string, int> items{};
+
+    items["first"]  = 1;
+    items["second"] = 2;
+
+    std::string_view const key{ "second" };
+
+    REQUIRE(items.contains(key));
+    REQUIRE(items.find(key)->second == 2);
+    REQUIRE(items.count("first") == 1);
+    REQUIRE_FALSE(items.contains(std::string_view{ "third" }));
+
+    REQUIRE(items.erase(key) == 1);
+    REQUIRE(items.size() == 1);
+}
+
+TEST_CASE("notstd::flat_hash_map / collisions and tombstones")
+{
+    //
+    // All keys share single probe sequence.
+    //
+
+    notstd::flat_hash_map<int, int, CollidingHash> items{};
+
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            REQUIRE(items.try_emplace(i, i * round).second);
+        }
+
+        for (int i = 0; i < 200; i += 2)
+        {
+            REQUIRE(items.erase(i) == 1);
+        }
+
+        for (int i = 1; i < 200; i += 2)
+        {
+            REQUIRE(items.at(i) == i * round);
+            REQUIRE(items.erase(i) == 1);
+        }
+
+        REQUIRE(items.empty());
+    }
+
+    //
+    // Repeated inserts and erases reuse space instead of growing.
+    //
+
+    REQUIRE(items.capacity() <= 512);
+}
+
+TEST_CASE("notstd::flat_hash_map / insertion hashes key once")
+{
+    notstd::flat_hash_map<int, CountedValue, CountingHash> items{};
+    items.reserve(16);
+
+    CountingHash::Calls         = 0;
+    CountedValue::Constructions = 0;
+
+    SECTION("Emplace with key and value")
+    {
+        REQUIRE(items.emplace(1, 2).second);
+        CHECK(CountingHash::Calls == 1);
+        CHECK(CountedValue::Constructions == 1);
+
+        //
+        // Value is not constructed when key exists.
+        //
+
+        REQUIRE_FALSE(items.emplace(1, 3).second);
+        CHECK(CountingHash::Calls == 2);
+        CHECK(CountedValue::Constructions == 1);
+        CHECK(items.at(1).Value == 2);
+    }
+
+    SECTION("Emplace with piecewise construction")
+    {
+        REQUIRE(items.emplace(std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2)).second);
+        REQUIRE_FALSE(items.emplace(std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(3)).second);
+        CHECK(CountingHash::Calls == 2);
+        CHECK(CountedValue::Constructions == 1);
+    }
+
+    SECTION("Emplace with pair")
+    {
+        const std::pair<int, CountedValue> value{ 1, 2 };
+        CountedValue::Constructions = 0;
+
+        REQUIRE(items.emplace(value).second);
+        REQUIRE_FALSE(items.emplace(value).second);
+        CHECK(CountingHash::Calls == 2);
+        CHECK(CountedValue::Constructions == 0);
+    }
+
+    SECTION("Insert and try emplace")
+    {
+        REQUIRE(items.insert({ 1, 2 }).second);
+        REQUIRE(items.try_emplace(2, 3).second);
+        REQUIRE_FALSE(items.try_emplace(2, 4).second);
+        CHECK(CountingHash::Calls == 3);
+    }
+}
+
+TEST_CASE("notstd::flat_hash_map / reserve and rehash")
+{
+    notstd::flat_hash_map<int, std::string> items{};
+    REQUIRE(items.capacity() == 0);
+
+    items.reserve(1000);
+    size_t const capacity = items.capacity();
+    REQUIRE(capacity * items.max_load_factor() >= 1000);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        items.emplace(i, std::to_string(i));
+    }
+
+    REQUIRE(items.capacity() == capacity);
+
+    items.rehash(capacity * 4);
+    REQUIRE(items.capacity() == capacity * 4);
+    REQUIRE(items.at(999) == "999");
+
+    items.clear();
+    items.rehash(0);
+    REQUIRE(items.capacity() == 0);
+}
+
+TEST_CASE("notstd::flat_hash_set")
+{
+    notstd::flat_hash_set<std::string> items{ "a", "b", "c" };
+
+    REQUIRE(items.size() == 3);
+    REQUIRE(items.contains("a"));
+    REQUIRE(items.contains(std::string_view{ "b" }));
+    REQUIRE_FALSE(items.contains("d"));
+
+    REQUIRE_FALSE(items.insert("a").second);
+    REQUIRE(items.insert("d").second);
+    REQUIRE(items.erase("a") == 1);
+
+    REQUIRE(items == notstd::flat_hash_set<std::string>{ "b", "c", "d" });
+}
+
+TEST_CASE("notstd::flat_hash_map / benchmark", "[.][performance]")
+{
+    using Graphyte::Diagnostics::Stopwatch;
+
+    constexpr size_t Count = 1u << 18;
+
+    auto const keys = HashContainersTestKeys(Count);
+
+    std::vector<uint64_t> numbers(Count);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        numbers[i] = (static_cast<uint64_t>(i) * 0x9E37'79B9'7F4A'7C15) >> 7;
+    }
+
+    auto run = [&](auto& container, auto const& input, std::string_view name) {
+        Stopwatch insert_watch{};
+        Stopwatch lookup_watch{};
+
+        insert_watch.Start();
+
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            container.emplace(input[i], i);
+        }
+
+        insert_watch.Stop();
+
+        size_t found = 0;
+
+        lookup_watch.Start();
+
+        for (size_t round = 0; round < 4; ++round)
+        {
+            for (auto const& key : input)
+            {
+                found += (container.find(key) != container.end()) ? 1 : 0;
+            }
+        }
+
+        lookup_watch.Stop();
+
+        REQUIRE(found == input.size() * 4);
+
+        WARN(fmt::format("{}: insert {:.2f} ms, lookup {:.2f} ms",
+            name,
+            insert_watch.GetElapsedTime<double>() * 1000.0,
+            lookup_watch.GetElapsedTime<double>() * 1000.0));
+    };
+
+    SECTION("Integer keys")
+    {
+        notstd::flat_hash_map<uint64_t, size_t> hash_map{};
+        std::unordered_map<uint64_t, size_t> unordered_map{};
+        notstd::flat_map<uint64_t, size_t> flat_map{};
+
+        run(hash_map, numbers, "flat_hash_map<uint64_t>");
+        run(unordered_map, numbers, "unordered_map<uint64_t>");
+        run(flat_map, numbers, "flat_map<uint64_t>");
+    }
+
+    SECTION("String keys")
+    {
+        notstd::flat_hash_map<std::string, size_t> hash_map{};
+        std::unordered_map<std::string, size_t> unordered_map{};
+        notstd::flat_map<std::string, size_t> flat_map{};
+
+        run(hash_map, keys, "flat_hash_map<string>");
+        run(unordered_map, keys, "unordered_map<string>");
+        run(flat_map, keys, "flat_map<string>");
+    }
+}
@@ -0,0 +1,248 @@
+#include <catch2/catch.hpp>
+#include <GxBase/SlotMap.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
+
+TEST_CASE("Slot handles")
+{
+    using Graphyte::SlotHandle32;
+    using Graphyte::SlotHandle64;
+
+    static_assert(sizeof(SlotHandle32) == sizeof(uint32_t));
+    static_assert(sizeof(SlotHandle64) == sizeof(uint64_t));
+
+    CHECK_FALSE(SlotHandle32{}.IsValid());
+    CHECK_FALSE(SlotHandle64{}.IsValid());
+
+    auto const handle32 = SlotHandle32::Make(0xABCDE, 0x123);
+    CHECK(handle32.GetIndex() == 0xABCDE);
+    CHECK(handle32.GetGeneration() == 0x123);
+
+    auto const handle64 = SlotHandle64::Make(0xFFFFFFFE, 0xCAFEBABE);
+    CHECK(handle64.GetIndex() == 0xFFFFFFFE);
+    CHECK(handle64.GetGeneration() == 0xCAFEBABE);
+    CHECK(handle64 == SlotHandle64::Make(0xFFFFFFFE, 0xCAFEBABE));
+}
+
+TEST_CASE("Slot map")
+{
+    using Map = Graphyte::SlotMap<std::string>;
+
+    Map map{};
+
+    SECTION("Insert, lookup and erase")
+    {
+        CHECK(map.IsEmpty());
+
+        auto const first  = map.Insert("first");
+        auto const second = map.Insert("second");
+        auto const third  = map.Insert("third");
+
+        CHECK(map.GetCount() == 3);
+        REQUIRE(map.Get(first) != nullptr);
+        CHECK(*map.Get(first) == "first");
+        CHECK(*map.Get(second) == "second");
+        CHECK(*map.Get(third) == "third");
+
+        CHECK(map.Erase(first));
+        CHECK_FALSE(map.Erase(first));
+        CHECK_FALSE(map.Contains(first));
+        CHECK(map.Get(first) == nullptr);
+
+        //
+        // Storage stays dense.
+        //
+
+        CHECK(map.GetCount() == 2);
+        CHECK(map.GetValues()[0] == "third");
+        CHECK(map.GetHandle(0) == third);
+        CHECK(*map.Get(third) == "third");
+        CHECK(*map.Get(second) == "second");
+
+        CHECK_FALSE(map.Contains(Map::handle_type{}));
+    }
+
+    SECTION("Stale handles are detected")
+    {
+        auto const first = map.Insert("first");
+        CHECK(map.Erase(first));
+
+        auto const second = map.Insert("second");
+        CHECK(second.GetIndex() == first.GetIndex());
+        CHECK(second.GetGeneration() != first.GetGeneration());
+
+        CHECK(map.Get(first) == nullptr);
+        CHECK(*map.Get(second) == "second");
+    }
+
+    SECTION("Clear")
+    {
+        std::vector<Map::handle_type> handles{};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            handles.push_back(map.Insert(std::to_string(i)));
+        }
+
+        map.Clear();
+        CHECK(map.IsEmpty());
+
+        for (auto const handle : handles)
+        {
+            CHECK_FALSE(map.Contains(handle));
+        }
+    }
+
+    SECTION("Randomized against reference")
+    {
+        std::vector<std::pair<Map::handle_type, std::string>> live{};
+        std::vector<Map::handle_type> dead{};
+
+        uint32_t seed = 1337;
+
+        auto next = [&]() {
+            seed = seed * 1664525u + 1013904223u;
+            return seed >> 8;
+        };
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            if (live.empty() || (next() % 3) != 0)
+            {
+                std::string value = std::to_string(next());
+                live.emplace_back(map.Insert(value), value);
+            }
+            else
+            {
+                size_t const index = next() % live.size();
+                CHECK(map.Erase(live[index].first));
+                dead.push_back(live[index].first);
+                live[index] = live.back();
+                live.pop_back();
+            }
+        }
+
+        CHECK(map.GetCount() == live.size());
+
+        for (auto const& [handle, value] : live)
+        {
+            auto const* stored = map.Get(handle);
+            REQUIRE(stored != nullptr);
+            CHECK(*stored == value);
+        }
+
+        for (auto const handle : dead)
+        {
+            CHECK_FALSE(map.Contains(handle));
+        }
+
+        for (size_t i = 0; i < map.GetCount(); ++i)
+        {
+            CHECK(map.Get(map.GetHandle(i)) == &map.GetValues()[i]);
+        }
+    }
+}
+
+TEST_CASE("Slot map generation wrap-around")
+{
+    //
+    // Slot is retired when its generation would wrap, so old handles never become valid again.
+    //
+
+    Graphyte::SlotMap<int, Graphyte::SlotHandle32> map{};
+
+    auto const first = map.Insert(0);
+    CHECK(map.Erase(first));
+
+    for (uint32_t i = 1; i < Graphyte::SlotHandle32::GenerationMask; ++i)
+    {
+        auto const handle = map.Insert(static_cast<int>(i));
+        CHECK(handle.GetIndex() == first.GetIndex());
+        CHECK(map.Erase(handle));
+    }
+
+    auto const handle = map.Insert(42);
+    CHECK(handle.GetIndex() != first.GetIndex());
+    CHECK_FALSE(map.Contains(first));
+    CHECK(*map.Get(handle) == 42);
+}
+
+TEST_CASE("Concurrent slot map")
+{
+    Graphyte::ConcurrentSlotMap<uint64_t, Graphyte::SlotHandle32> map{};
+
+    //
+    // Tasks erase every third element they inserted while other tasks keep inserting, so freed
+    // slots are reused across tasks. Handles to erased elements must stay stale afterwards.
+    //
+
+    constexpr size_t Tasks = 16;
+    constexpr size_t Items = 1000;
+
+    std::vector<std::vector<Graphyte::SlotHandle32>> live(Tasks);
+    std::vector<std::vector<Graphyte::SlotHandle32>> erased(Tasks);
+
+    Graphyte::Threading::ParallelForRange(0, Tasks, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (size_t j = 0; j < Items; ++j)
+            {
+                Graphyte::SlotHandle32 const handle = map.Insert(uint64_t{ (i << 32) | j });
+
+                if ((j % 3) == 0)
+                {
+                    map.Erase(handle);
+                    erased[i].push_back(handle);
+                }
+                else
+                {
+                    live[i].push_back(handle);
+                }
+            }
+        }
+    },
+        1);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < Tasks; ++i)
+    {
+        for (auto const handle : live[i])
+        {
+            uint64_t value{};
+            CHECK(map.TryGet(handle, value));
+            CHECK((value >> 32) == i);
+            ++count;
+        }
+
+        for (auto const handle : erased[i])
+        {
+            CHECK_FALSE(map.Contains(handle));
+        }
+    }
+
+    CHECK(map.GetCount() == count);
+
+    //
+    // Remaining elements are erased by tasks other than inserting ones.
+    //
+
+    Graphyte::Threading::ParallelForRange(0, Tasks, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (auto const handle : live[(i + 1) % Tasks])
+            {
+                map.Erase(handle);
+            }
+        }
+    },
+        1);
+
+    CHECK(map.GetCount() == 0);
+
+    size_t visited = 0;
+    map.ForEach([&](Graphyte::SlotHandle32, uint64_t) {
+        ++visited;
+    });
+
+    CHECK(visited == 0);
+}
@@ -0,0 +1,200 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Storage/AsyncIO.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+#include <GxBase/Threading/TaskDispatcher.hxx>
+
+TEST_CASE("Storage / Async IO")
+{
+    using namespace Graphyte;
+
+    auto temp_dir  = System::GetUserTemporaryDirectory();
+    auto temp_file = Storage::CreateTemporaryFilePath(temp_dir, "test.base", ".bin");
+
+    std::vector<std::byte> original(4 << 20);
+
+    for (size_t i = 0; i < original.size(); ++i)
+    {
+        original[i] = static_cast<std::byte>((i * 31) ^ (i >> 8));
+    }
+
+    REQUIRE(Storage::WriteBinary(original, temp_file) == Status::Success);
+
+    Threading::TaskDispatcher dispatcher{};
+    dispatcher.Start(4);
+
+    auto const type = GENERATE(Storage::AsyncIOBackendType::Native, Storage::AsyncIOBackendType::ThreadPool);
+
+    Storage::AsyncIO io{};
+    io.Start(dispatcher, type);
+    REQUIRE_FALSE(io.GetBackendName().empty());
+
+    std::unique_ptr<Storage::AsyncFile> file{};
+    REQUIRE(io.Open(file, temp_file) == Status::Success);
+    REQUIRE(file != nullptr);
+    REQUIRE(file->GetSize() == static_cast<int64_t>(original.size()));
+
+    SECTION("Opening missing file")
+    {
+        std::unique_ptr<Storage::AsyncFile> missing{};
+        REQUIRE(io.Open(missing, temp_file + ".missing") != Status::Success);
+        REQUIRE(missing == nullptr);
+    }
+
+    SECTION("Batch of adjacent and scattered reads")
+    {
+        //
+        // Blocks of varying size; every third block is skipped, so some ranges coalesce and
+        // some don't.
+        //
+
+        std::vector<std::vector<std::byte>> buffers{};
+        std::vector<Storage::AsyncReadDesc> descs{};
+        std::vector<int64_t> offsets{};
+        std::atomic<size_t> callbacks{};
+
+        int64_t offset = 0;
+
+        for (size_t i = 0; offset < static_cast<int64_t>(original.size()); ++i)
+        {
+            size_t const size = std::min<size_t>(4096 + (i % 7) * 1000, original.size() - static_cast<size_t>(offset));
+
+            if (i % 3 != 2)
+            {
+                buffers.emplace_back(size);
+                offsets.push_back(offset);
+            }
+
+            offset += static_cast<int64_t>(size);
+        }
+
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            descs.push_back(Storage::AsyncReadDesc{
+                .File     = file.get(),
+                .Offset   = offsets[i],
+                .Buffer   = buffers[i],
+                .Priority = static_cast<Storage::AsyncIOPriority>(i % 3),
+                .Callback = [&callbacks](Status status, size_t) {
+                    if (status == Status::Success)
+                    {
+                        callbacks.fetch_add(1);
+                    }
+                },
+            });
+        }
+
+        std::vector<Storage::AsyncRequest> requests(descs.size());
+        io.Read(requests, descs);
+
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            requests[i].Wait();
+
+            REQUIRE(requests[i].IsCompleted());
+            REQUIRE(requests[i].GetStatus() == Status::Success);
+            REQUIRE(requests[i].GetProcessed() == buffers[i].size());
+            REQUIRE(std::equal(buffers[i].begin(), buffers[i].end(), original.begin() + offsets[i]));
+        }
+
+        REQUIRE(callbacks.load() == requests.size());
+    }
+
+    SECTION("Reading past end of file")
+    {
+        std::vector<std::byte> buffer(8192);
+
+        io.ReadAhead(*file, static_cast<int64_t>(original.size()) - 4096, 8192);
+
+        auto request = io.Read(Storage::AsyncReadDesc{
+            .File   = file.get(),
+            .Offset = static_cast<int64_t>(original.size()) - 4096,
+            .Buffer = buffer,
+        });
+
+        request.Wait();
+        REQUIRE(request.GetStatus() == Status::EndOfStream);
+        REQUIRE(request.GetProcessed() == 4096);
+        REQUIRE(std::equal(buffer.begin(), buffer.begin() + 4096, original.end() - 4096));
+    }
+
+    SECTION("Empty buffer")
+    {
+        auto request = io.Read(Storage::AsyncReadDesc{
+            .File   = file.get(),
+            .Offset = 0,
+            .Buffer = {},
+        });
+
+        request.Wait();
+        REQUIRE(request.GetStatus() == Status::Success);
+        REQUIRE(request.GetProcessed() == 0);
+    }
+
+    SECTION("Cancellation")
+    {
+        std::vector<std::byte> buffer(original.size());
+        std::vector<Storage::AsyncReadDesc> descs{};
+
+        constexpr size_t const BlockSize = 4096;
+
+        for (size_t i = 0; i < buffer.size() / BlockSize; ++i)
+        {
+            descs.push_back(Storage::AsyncReadDesc{
+                .File     = file.get(),
+                .Offset   = static_cast<int64_t>(i * BlockSize * 7 % buffer.size()),
+                .Buffer   = std::span<std::byte>{ buffer }.subspan(i * BlockSize, BlockSize),
+                .Priority = Storage::AsyncIOPriority::Low,
+            });
+        }
+
+        std::vector<Storage::AsyncRequest> requests(descs.size());
+        io.Read(requests, descs);
+
+        //
+        // Requests already issued can't be cancelled and complete normally.
+        //
+
+        std::vector<bool> cancelled(requests.size());
+
+        for (size_t i = requests.size(); i-- > 0;)
+        {
+            cancelled[i] = requests[i].Cancel();
+        }
+
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            requests[i].Wait();
+            REQUIRE(requests[i].GetStatus() == (cancelled[i] ? Status::Cancelled : Status::Success));
+            REQUIRE_FALSE(requests[i].Cancel());
+        }
+    }
+
+    SECTION("Request as task dependency")
+    {
+        std::vector<std::byte> buffer(65536);
+        std::atomic<bool> verified{};
+
+        auto request = io.Read(Storage::AsyncReadDesc{
+            .File   = file.get(),
+            .Offset = 12345,
+            .Buffer = buffer,
+        });
+
+        auto task = dispatcher.Schedule(
+            [&]() {
+                verified = std::equal(buffer.begin(), buffer.end(), original.begin() + 12345);
+            },
+            { request.GetTask() });
+
+        dispatcher.Wait(task);
+        REQUIRE(verified.load());
+    }
+
+    file = nullptr;
+    io.Stop();
+
+    REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(temp_file) == Status::Success);
+}
@@ -4,6 +4,9 @@
 #include <GxBase/App.hxx>
 #include <GxBase/System.hxx>
 #include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/ArchiveMappedReader.hxx>
+#include <GxBase/Storage/ArchiveFileWriter.hxx>
+#include <GxBase/Stopwatch.hxx>
 //#include <Graphyte/Crypto/HashAlgorithm.hxx>
 
 TEST_CASE("Checking if commmon paths exist")
@@ -231,6 +234,254 @@ TEST_CASE("File stream reading and writing")
     }
 }
 
+TEST_CASE("Mapped file reading")
+{
+    using namespace Graphyte;
+
+    auto temp_dir  = System::GetUserTemporaryDirectory();
+    auto temp_file = Storage::CreateTemporaryFilePath(temp_dir, "test.base", ".bin");
+
+    std::vector<std::byte> original(1 << 20);
+
+    for (size_t i = 0; i < original.size(); ++i)
+    {
+        original[i] = static_cast<std::byte>((i * 31) ^ (i >> 8));
+    }
+
+    SECTION("Empty file")
+    {
+        REQUIRE(Storage::WriteBinary(std::vector<std::byte>{}, temp_file) == Status::Success);
+
+        std::unique_ptr<Storage::IMappedFile> file{};
+        REQUIRE(Storage::OpenMapped(file, temp_file) == Status::Success);
+        REQUIRE(file != nullptr);
+        REQUIRE(file->GetView().empty());
+    }
+
+    SECTION("View matches file content")
+    {
+        REQUIRE(Storage::WriteBinary(original, temp_file) == Status::Success);
+
+        for (auto const access : { Storage::MappedFileAccess::Normal, Storage::MappedFileAccess::Sequential, Storage::MappedFileAccess::Random })
+        {
+            std::unique_ptr<Storage::IMappedFile> file{};
+            REQUIRE(Storage::OpenMapped(file, temp_file, access) == Status::Success);
+            REQUIRE(file != nullptr);
+
+            file->Prefetch(4096 + 17, 65536);
+            file->Prefetch(original.size() - 1, 65536);
+            file->Prefetch(original.size(), 1);
+
+            auto const view = file->GetView();
+            REQUIRE(view.size() == original.size());
+            REQUIRE(std::equal(view.begin(), view.end(), original.begin()));
+        }
+    }
+
+    SECTION("Archive over mapped file")
+    {
+        {
+            std::unique_ptr<Storage::Archive> writer{};
+            REQUIRE(Storage::CreateWriter(writer, temp_file) == Status::Success);
+
+            uint32_t value{ 1337 };
+            std::string text{ "Sample text" };
+
+            (*writer) << value;
+            (*writer) << text;
+            writer->Serialize(original.data(), original.size());
+
+            REQUIRE_FALSE(writer->IsError());
+        }
+
+        std::unique_ptr<Storage::IMappedFile> file{};
+        REQUIRE(Storage::OpenMapped(file, temp_file, Storage::MappedFileAccess::Sequential) == Status::Success);
+
+        auto const base = file->GetView().data();
+
+        Storage::ArchiveMappedReader reader{ std::move(file) };
+        REQUIRE(reader.IsLoading());
+        REQUIRE(reader.GetSize() == static_cast<int64_t>(4 + 4 + 11 + original.size()));
+
+        uint32_t value{};
+        std::string text{};
+
+        reader << value;
+        reader << text;
+
+        REQUIRE(value == 1337);
+        REQUIRE(text == "Sample text");
+
+        //
+        // Payload is referenced in place.
+        //
+
+        auto const payload = reader.ReadView(original.size());
+        REQUIRE(payload.data() == base + 19);
+        REQUIRE(std::equal(payload.begin(), payload.end(), original.begin()));
+        REQUIRE(reader.GetPosition() == reader.GetSize());
+        REQUIRE_FALSE(reader.IsError());
+
+        REQUIRE(reader.ReadView(1).empty());
+        REQUIRE(reader.IsError());
+    }
+
+    REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(temp_file) == Status::Success);
+}
+
+TEST_CASE("Mapped archive reader seeking outside of view")
+{
+    using namespace Graphyte;
+
+    std::array<std::byte, 16> const data{};
+
+    SECTION("Past end")
+    {
+        Storage::ArchiveMappedReader reader{ std::span{ data } };
+        reader.SetPosition(17);
+
+        REQUIRE(reader.IsError());
+        REQUIRE(reader.GetPosition() == reader.GetSize());
+        REQUIRE(reader.ReadView(1).empty());
+    }
+
+    SECTION("Before start")
+    {
+        Storage::ArchiveMappedReader reader{ std::span{ data } };
+        reader.SetPosition(-1);
+
+        REQUIRE(reader.IsError());
+        REQUIRE(reader.ReadView(1).empty());
+    }
+
+    SECTION("End of view")
+    {
+        Storage::ArchiveMappedReader reader{ std::span{ data } };
+        reader.SetPosition(16);
+
+        REQUIRE_FALSE(reader.IsError());
+        REQUIRE(reader.ReadView(1).empty());
+        REQUIRE(reader.IsError());
+    }
+}
+
+TEST_CASE("Archive file writer")
+{
+    using namespace Graphyte;
+
+    auto temp_dir  = System::GetUserTemporaryDirectory();
+    auto temp_file = Storage::CreateTemporaryFilePath(temp_dir, "test.base", ".bin");
+
+    std::vector<std::byte> original(3 << 20);
+
+    for (size_t i = 0; i < original.size(); ++i)
+    {
+        original[i] = static_cast<std::byte>((i * 31) ^ (i >> 8));
+    }
+
+    Storage::ArchiveFileWriterOptions options{};
+    options.BufferSize  = GENERATE(size_t{ 4096 }, size_t{ 64 << 10 });
+    options.WriteBehind = GENERATE(false, true);
+    options.BufferSync  = GENERATE(Storage::StreamSync::None, Storage::StreamSync::Writeback);
+    options.FlushSync   = Storage::StreamSync::Data;
+
+    {
+        std::unique_ptr<Storage::Archive> writer{};
+        REQUIRE(Storage::CreateWriter(writer, temp_file, options) == Status::Success);
+
+        //
+        // Mix of small writes filling buffers and large writes bypassing them.
+        //
+
+        uint32_t header{};
+        (*writer) << header;
+
+        size_t offset = sizeof(header);
+        size_t step   = 1;
+
+        while (offset < original.size())
+        {
+            size_t const size = std::min(step, original.size() - offset);
+            writer->Serialize(original.data() + offset, size);
+            offset += size;
+            step = (step * 7 + 3) % (300 << 10);
+        }
+
+        REQUIRE(writer->GetPosition() == static_cast<int64_t>(original.size()));
+        REQUIRE(writer->GetSize() == static_cast<int64_t>(original.size()));
+
+        //
+        // Seeking back drains pending writes first.
+        //
+
+        writer->SetPosition(0);
+        writer->Serialize(original.data(), sizeof(header));
+
+        REQUIRE_FALSE(writer->IsError());
+    }
+
+    std::vector<std::byte> content{};
+    REQUIRE(Storage::ReadBinary(content, temp_file) == Status::Success);
+    REQUIRE(content.size() == original.size());
+    REQUIRE(std::equal(content.begin(), content.end(), original.begin()));
+
+    REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(temp_file) == Status::Success);
+}
+
+TEST_CASE("Archive file writer throughput", "[.][performance]")
+{
+    using namespace Graphyte;
+    using Graphyte::Diagnostics::Stopwatch;
+
+    auto temp_dir  = System::GetUserTemporaryDirectory();
+    auto temp_file = Storage::CreateTemporaryFilePath(temp_dir, "test.base", ".bin");
+
+    constexpr size_t TotalSize = 256 << 20;
+
+    std::vector<std::byte> chunk(1000);
+
+    auto measure = [&](const char* name, const Storage::ArchiveFileWriterOptions& options) {
+        Stopwatch watch{};
+        watch.Restart();
+
+        {
+            std::unique_ptr<Storage::Archive> writer{};
+            REQUIRE(Storage::CreateWriter(writer, temp_file, options) == Status::Success);
+
+            for (size_t written = 0; written < TotalSize; written += chunk.size())
+            {
+                writer->Serialize(chunk.data(), chunk.size());
+            }
+
+            REQUIRE_FALSE(writer->IsError());
+        }
+
+        watch.Stop();
+
+        WARN(fmt::format(
+            "{:<24} {:>10.2f} MiB/s",
+            name,
+            (static_cast<double>(TotalSize) / (1024.0 * 1024.0)) / watch.GetElapsedTime<double>()));
+    };
+
+    measure("buffered 4 KiB", Storage::ArchiveFileWriterOptions{
+                                  .BufferSize = 4096,
+                              });
+
+    measure("buffered 4 MiB", Storage::ArchiveFileWriterOptions{
+                                  .BufferSize = 4 << 20,
+                              });
+
+    measure("write behind 4 MiB", Storage::ArchiveFileWriterOptions{
+                                      .BufferSize  = 4 << 20,
+                                      .WriteBehind = true,
+                                      .BufferSync  = Storage::StreamSync::Writeback,
+                                      .FlushSync   = Storage::StreamSync::Data,
+                                  });
+
+    REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(temp_file) == Status::Success);
+}
+
 #if false
 TEST_CASE("Reading large files byte by byte; checking file consistency")
 {
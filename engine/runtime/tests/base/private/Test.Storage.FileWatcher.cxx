@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Storage/FileWatcher.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/IFileSystem.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+
+namespace
+{
+    //
+    // Collects changes until expected change of file is reported. Unrelated changes may be
+    // reported first.
+    //
+
+    bool WaitForChange(
+        Graphyte::Storage::FileWatcher& watcher,
+        std::string_view path,
+        std::initializer_list<Graphyte::Storage::FileChangeType> types) noexcept
+    {
+        std::vector<Graphyte::Storage::FileChange> changes{};
+
+        for (size_t i = 0; i < 20; ++i)
+        {
+            if (watcher.Wait(changes, 1000) != Graphyte::Status::Success)
+            {
+                return false;
+            }
+
+            for (auto const& change : changes)
+            {
+                if (change.Path == path && std::find(types.begin(), types.end(), change.Type) != types.end())
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
+
+TEST_CASE("Storage / File watcher")
+{
+    using namespace Graphyte;
+
+    auto& fs = Storage::IFileSystem::GetPlatformNative();
+
+    auto root = Storage::CreateTemporaryFilePath(System::GetUserTemporaryDirectory(), "test.watcher.", "");
+    REQUIRE(fs.DirectoryTreeCreate(root) == Status::Success);
+
+    auto const type = GENERATE(Storage::FileWatcherBackendType::Native, Storage::FileWatcherBackendType::Polling);
+
+    Storage::FileWatcher watcher{ type };
+    REQUIRE_FALSE(watcher.GetBackendName().empty());
+
+    auto const existing = Storage::CombinePath(root, "existing.txt");
+    REQUIRE(Storage::WriteText("existing", existing) == Status::Success);
+
+    REQUIRE(watcher.Add(root, true) == Status::Success);
+
+    SECTION("Nothing changed")
+    {
+        std::vector<Storage::FileChange> changes{};
+        REQUIRE(watcher.Wait(changes, 50) == Status::Timeout);
+        REQUIRE(changes.empty());
+    }
+
+    SECTION("Cancelled wait")
+    {
+        watcher.Cancel();
+
+        std::vector<Storage::FileChange> changes{};
+        REQUIRE(watcher.Wait(changes, UINT32_MAX) == Status::Cancelled);
+    }
+
+    SECTION("Added, modified and removed files")
+    {
+        auto const added = Storage::CombinePath(root, "added.txt");
+        REQUIRE(Storage::WriteText("added", added) == Status::Success);
+        REQUIRE(WaitForChange(watcher, added, { Storage::FileChangeType::Added }));
+
+        REQUIRE(Storage::WriteText("modified content", existing) == Status::Success);
+        REQUIRE(WaitForChange(watcher, existing, { Storage::FileChangeType::Modified }));
+
+        REQUIRE(fs.FileDelete(added) == Status::Success);
+        REQUIRE(WaitForChange(watcher, added, { Storage::FileChangeType::Removed }));
+    }
+
+    SECTION("Files in new subdirectory")
+    {
+        auto const directory = Storage::CombinePath(root, "nested");
+        REQUIRE(fs.DirectoryCreate(directory) == Status::Success);
+
+        auto const file = Storage::CombinePath(directory, "file.txt");
+        REQUIRE(Storage::WriteText("nested", file) == Status::Success);
+
+        //
+        // File may be reported as added when directory is discovered, or as modified when written
+        // after directory is watched.
+        //
+
+        std::vector<Storage::FileChange> changes{};
+        bool found = false;
+
+        for (size_t i = 0; i < 20 && !found; ++i)
+        {
+            REQUIRE(watcher.Wait(changes, 1000) == Status::Success);
+
+            found = std::any_of(changes.begin(), changes.end(), [&](auto const& change) {
+                return change.Path == file;
+            });
+        }
+
+        REQUIRE(found);
+    }
+
+    [[maybe_unused]] auto status = fs.DirectoryTreeDelete(root);
+}
@@ -0,0 +1,248 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Storage/PackageFileSystem.hxx>
+#include <GxBase/Storage/PackageWriter.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/Random.hxx>
+#include <GxBase/System.hxx>
+
+namespace
+{
+    struct PackageTestVisitor final : public Graphyte::Storage::IDirectoryVisitor
+    {
+        std::vector<std::pair<std::string, bool>> Entries;
+
+        virtual Graphyte::Status Visit(std::string_view path, bool is_directory) noexcept override
+        {
+            Entries.emplace_back(std::string{ path }, is_directory);
+            return Graphyte::Status::Success;
+        }
+    };
+
+    std::vector<std::byte> ReadPackageEntry(Graphyte::Storage::IFileSystem& fs, std::string_view path)
+    {
+        std::unique_ptr<Graphyte::Storage::IStream> stream{};
+        REQUIRE(fs.OpenRead(stream, path) == Graphyte::Status::Success);
+
+        std::vector<std::byte> result(static_cast<size_t>(stream->GetSize()));
+
+        size_t processed{};
+        REQUIRE(stream->Read(result, processed) == Graphyte::Status::Success);
+        REQUIRE(processed == result.size());
+
+        return result;
+    }
+}
+
+TEST_CASE("Storage / Package")
+{
+    using namespace Graphyte;
+
+    auto temp_dir  = System::GetUserTemporaryDirectory();
+    auto temp_file = Storage::CreateTemporaryFilePath(temp_dir, "test.base", ".pak");
+
+    //
+    // Compressible text-like content spanning many blocks, random content and small files.
+    //
+
+    std::vector<std::byte> compressible(300'000);
+
+    for (size_t i = 0; i < compressible.size(); ++i)
+    {
+        compressible[i] = static_cast<std::byte>("lorem ipsum dolor sit amet "[i % 27] + ((i / 4096) % 3));
+    }
+
+    std::vector<std::byte> incompressible(100'000);
+    {
+        Random::RandomState state{};
+        Random::Initialize(state, 1337);
+        Random::Generate(state, incompressible);
+    }
+
+    std::vector<std::byte> const small{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 } };
+
+    {
+        std::unique_ptr<Storage::PackageWriter> writer{};
+        REQUIRE(Storage::PackageWriter::Create(writer, temp_file, Storage::PackageWriterOptions{ .BlockSize = 16 << 10 }) == Status::Success);
+
+        REQUIRE(writer->Add("textures/Stone.dds", incompressible) == Status::Success);
+        REQUIRE(writer->Add("levels/intro/geometry.bin", compressible, Compression::CompressionMethod::LZ4HC) == Status::Success);
+        REQUIRE(writer->Add("./levels//intro/small.bin", small) == Status::Success);
+        REQUIRE(writer->Add("levels/intro/raw.bin", compressible, std::nullopt) == Status::Success);
+        REQUIRE(writer->Add("empty.txt", {}) == Status::Success);
+
+        REQUIRE(writer->Add("Levels/Intro/Geometry.bin", small) == Status::AlreadyExists);
+        REQUIRE(writer->Add("../outside.bin", small) == Status::InvalidPath);
+        REQUIRE(writer->Add("", small) == Status::InvalidPath);
+
+        if (!Compression::IsSupported(Compression::CompressionMethod::Zstd))
+        {
+            REQUIRE(writer->Add("unsupported.bin", small, Compression::CompressionMethod::Zstd) == Status::NotSupported);
+        }
+
+        REQUIRE(writer->GetEntryCount() == 5);
+        REQUIRE(writer->Finish() == Status::Success);
+    }
+
+    std::unique_ptr<Storage::PackageFileSystem> package{};
+    REQUIRE(Storage::PackageFileSystem::Open(package, temp_file) == Status::Success);
+    REQUIRE(package != nullptr);
+    REQUIRE(package->GetFileCount() == 5);
+
+    SECTION("Reading entries")
+    {
+        REQUIRE(ReadPackageEntry(*package, "textures/Stone.dds") == incompressible);
+        REQUIRE(ReadPackageEntry(*package, "levels/intro/geometry.bin") == compressible);
+        REQUIRE(ReadPackageEntry(*package, "levels/intro/small.bin") == small);
+        REQUIRE(ReadPackageEntry(*package, "levels/intro/raw.bin") == compressible);
+        REQUIRE(ReadPackageEntry(*package, "empty.txt").empty());
+
+        //
+        // Paths are normalized and matched ignoring case.
+        //
+
+        REQUIRE(ReadPackageEntry(*package, "/LEVELS\\Intro/./Small.bin") == small);
+
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(package->OpenRead(stream, "levels/missing.bin") == Status::NotFound);
+        REQUIRE(package->OpenRead(stream, "levels") == Status::NotFound);
+        REQUIRE(package->OpenRead(stream, "../textures/Stone.dds") == Status::NotFound);
+    }
+
+    SECTION("Seeking in compressed entry")
+    {
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(package->OpenRead(stream, "levels/intro/geometry.bin") == Status::Success);
+        REQUIRE(stream->GetSize() == static_cast<int64_t>(compressible.size()));
+
+        Random::RandomState state{};
+        Random::Initialize(state, 42);
+
+        std::vector<std::byte> buffer(40'000);
+
+        for (size_t i = 0; i < 64; ++i)
+        {
+            size_t const position = Random::NextUInt32(state) % compressible.size();
+            size_t const size     = std::min(buffer.size(), compressible.size() - position);
+
+            REQUIRE(stream->SetPosition(static_cast<int64_t>(position)) == Status::Success);
+
+            size_t processed{};
+            REQUIRE(stream->Read({ buffer.data(), size }, processed) == Status::Success);
+            REQUIRE(processed == size);
+            REQUIRE(std::equal(buffer.begin(), buffer.begin() + size, compressible.begin() + position));
+            REQUIRE(stream->GetPosition() == static_cast<int64_t>(position + size));
+        }
+
+        REQUIRE(stream->SetPosition(-10, Storage::SeekOrigin::End) == Status::Success);
+
+        size_t processed{};
+        REQUIRE(stream->Read(buffer, processed) == Status::EndOfStream);
+        REQUIRE(processed == 10);
+
+        REQUIRE(stream->Write(buffer, processed) == Status::NotSupported);
+    }
+
+    SECTION("Mapping entries")
+    {
+        std::unique_ptr<Storage::IMappedFile> mapped{};
+
+        //
+        // Uncompressed entries are aligned and mapped in place.
+        //
+
+        REQUIRE(package->OpenMapped(mapped, "levels/intro/raw.bin") == Status::Success);
+        REQUIRE(mapped->GetView().size() == compressible.size());
+        REQUIRE((reinterpret_cast<uintptr_t>(mapped->GetView().data()) % 4096) == 0);
+        REQUIRE(std::equal(mapped->GetView().begin(), mapped->GetView().end(), compressible.begin()));
+
+        mapped->Prefetch(0, compressible.size());
+
+        REQUIRE(package->OpenMapped(mapped, "textures/stone.dds", Storage::MappedFileAccess::Sequential) == Status::Success);
+        REQUIRE((reinterpret_cast<uintptr_t>(mapped->GetView().data()) % 4096) == 0);
+        REQUIRE(std::equal(mapped->GetView().begin(), mapped->GetView().end(), incompressible.begin(), incompressible.end()));
+
+        REQUIRE(package->OpenMapped(mapped, "levels/intro/geometry.bin") == Status::Success);
+        REQUIRE(std::equal(mapped->GetView().begin(), mapped->GetView().end(), compressible.begin(), compressible.end()));
+
+        //
+        // Mapped entry keeps package mapped.
+        //
+
+        package = nullptr;
+        REQUIRE(std::equal(mapped->GetView().begin(), mapped->GetView().end(), compressible.begin(), compressible.end()));
+    }
+
+    SECTION("Directories")
+    {
+        PackageTestVisitor visitor{};
+
+        REQUIRE(package->Enumerate("", visitor) == Status::Success);
+        std::sort(visitor.Entries.begin(), visitor.Entries.end());
+        REQUIRE(visitor.Entries == std::vector<std::pair<std::string, bool>>{
+                                       { "empty.txt", false },
+                                       { "levels", true },
+                                       { "textures", true },
+                                   });
+
+        visitor.Entries.clear();
+        REQUIRE(package->Enumerate("LEVELS/intro/", visitor) == Status::Success);
+        std::sort(visitor.Entries.begin(), visitor.Entries.end());
+        REQUIRE(visitor.Entries == std::vector<std::pair<std::string, bool>>{
+                                       { "levels/intro/geometry.bin", false },
+                                       { "levels/intro/raw.bin", false },
+                                       { "levels/intro/small.bin", false },
+                                   });
+
+        REQUIRE(package->Enumerate("levels/outro", visitor) == Status::NotFound);
+
+        REQUIRE(package->Exists("levels") == Status::Success);
+        REQUIRE(package->Exists("levels/intro/raw.bin") == Status::Success);
+        REQUIRE(package->Exists("levels/outro") == Status::NotFound);
+
+        Storage::FileInfo info{};
+        REQUIRE(package->GetFileInfo(info, "levels/intro") == Status::Success);
+        REQUIRE(info.IsDirectory);
+        REQUIRE(info.IsReadonly);
+
+        REQUIRE(package->GetFileInfo(info, "levels/intro/geometry.bin") == Status::Success);
+        REQUIRE_FALSE(info.IsDirectory);
+        REQUIRE(info.FileSize == static_cast<int64_t>(compressible.size()));
+
+        int64_t size{};
+        REQUIRE(package->GetFileSize(size, "textures/stone.dds") == Status::Success);
+        REQUIRE(size == static_cast<int64_t>(incompressible.size()));
+    }
+
+    SECTION("Package is read only")
+    {
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(package->OpenWrite(stream, "new.bin") == Status::AccessDenied);
+        REQUIRE(package->FileDelete("empty.txt") == Status::AccessDenied);
+        REQUIRE(package->DirectoryCreate("new") == Status::AccessDenied);
+
+        bool readonly{};
+        REQUIRE(package->IsReadonly(readonly, "empty.txt") == Status::Success);
+        REQUIRE(readonly);
+    }
+
+    SECTION("Corrupted index")
+    {
+        package = nullptr;
+
+        std::vector<std::byte> content{};
+        REQUIRE(Storage::ReadBinary(content, temp_file) == Status::Success);
+
+        content[content.size() - 4] ^= std::byte{ 0x20 };
+        REQUIRE(Storage::WriteBinary(content, temp_file) == Status::Success);
+        REQUIRE(Storage::PackageFileSystem::Open(package, temp_file) == Status::InvalidFormat);
+
+        content.resize(32);
+        REQUIRE(Storage::WriteBinary(content, temp_file) == Status::Success);
+        REQUIRE(Storage::PackageFileSystem::Open(package, temp_file) == Status::InvalidFormat);
+    }
+
+    package = nullptr;
+
+    REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(temp_file) == Status::Success);
+}
@@ -0,0 +1,449 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Storage/VersionedArchive.hxx>
+#include <GxBase/Storage/ArchiveMemoryReader.hxx>
+#include <GxBase/Storage/ArchiveMemoryWriter.hxx>
+#include <GxBase/Bitwise.hxx>
+#include <GxBase/Stopwatch.hxx>
+
+namespace
+{
+    enum class TestShape : uint16_t
+    {
+        Box    = 1,
+        Sphere = 2,
+    };
+
+    struct TestPartV1 final
+    {
+        std::string Name;
+        Graphyte::Float3 Position;
+    };
+
+    void Serialize(Graphyte::Storage::VersionedArchive& archive, TestPartV1& value) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, value.Name);
+        archive.Field(2, value.Position);
+    }
+
+    struct TestModelV1 final
+    {
+        std::string Name;
+        std::vector<Graphyte::Float3> Vertices;
+        std::vector<uint32_t> Indices;
+        std::vector<TestPartV1> Parts;
+    };
+
+    void Serialize(Graphyte::Storage::VersionedArchive& archive, TestModelV1& value) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, value.Name);
+        archive.Field(2, value.Vertices);
+        archive.Field(3, value.Indices);
+        archive.Field(4, value.Parts);
+    }
+
+    //
+    // Second version drops indices, adds shape, bounds and part tags.
+    //
+
+    struct TestPartV2 final
+    {
+        std::string Name;
+        Graphyte::Float3 Position;
+        std::vector<std::string> Tags;
+    };
+
+    void Serialize(Graphyte::Storage::VersionedArchive& archive, TestPartV2& value) noexcept
+    {
+        archive.Version(2);
+        archive.Field(1, value.Name);
+        archive.Field(2, value.Position);
+        archive.Field(3, value.Tags);
+    }
+
+    struct TestModelV2 final
+    {
+        uint32_t LoadedVersion{};
+        std::string Name;
+        std::vector<Graphyte::Float3> Vertices;
+        std::vector<TestPartV2> Parts;
+        TestShape Shape{ TestShape::Box };
+        Graphyte::Float4x4 Transform{};
+    };
+
+    void Serialize(Graphyte::Storage::VersionedArchive& archive, TestModelV2& value) noexcept
+    {
+        value.LoadedVersion = archive.Version(2);
+        archive.Field(1, value.Name);
+        archive.Field(2, value.Vertices);
+        archive.Field(4, value.Parts);
+        archive.Field(5, value.Shape);
+        archive.Field(6, value.Transform);
+    }
+
+    void AppendBigEndian(std::vector<std::byte>& buffer, uint32_t value)
+    {
+        value = Graphyte::ToBigEndian(value);
+        auto const* first = reinterpret_cast<const std::byte*>(&value);
+        buffer.insert(buffer.end(), first, first + sizeof(value));
+    }
+
+    //
+    // Mesh-like streams serialized by Archive operators, as Geometry::Mesh does.
+    //
+
+    struct TestMeshStreams final
+    {
+        std::vector<int32_t> FaceMaterialIndices;
+        std::vector<uint32_t> FaceSmoothingMasks;
+        std::vector<Graphyte::Float3> VertexPositions;
+        std::vector<uint32_t> WedgeIndices;
+        std::vector<Graphyte::Float3> WedgeTangentX;
+        std::vector<Graphyte::Float3> WedgeTangentY;
+        std::vector<Graphyte::Float3> WedgeTangentZ;
+        std::vector<Graphyte::Float2> WedgeTextureCoords;
+        std::vector<Graphyte::ColorBGRA> WedgeColors;
+    };
+
+    Graphyte::Storage::Archive& operator<<(Graphyte::Storage::Archive& archive, TestMeshStreams& mesh) noexcept
+    {
+        return archive
+               << mesh.FaceMaterialIndices
+               << mesh.FaceSmoothingMasks
+               << mesh.VertexPositions
+               << mesh.WedgeIndices
+               << mesh.WedgeTangentX
+               << mesh.WedgeTangentY
+               << mesh.WedgeTangentZ
+               << mesh.WedgeTextureCoords
+               << mesh.WedgeColors;
+    }
+
+    void Serialize(Graphyte::Storage::VersionedArchive& archive, TestMeshStreams& mesh) noexcept
+    {
+        archive.Version(1);
+        archive.Field(1, mesh.FaceMaterialIndices);
+        archive.Field(2, mesh.FaceSmoothingMasks);
+        archive.Field(3, mesh.VertexPositions);
+        archive.Field(4, mesh.WedgeIndices);
+        archive.Field(5, mesh.WedgeTangentX);
+        archive.Field(6, mesh.WedgeTangentY);
+        archive.Field(7, mesh.WedgeTangentZ);
+        archive.Field(8, mesh.WedgeColors);
+        archive.Field(16, mesh.WedgeTextureCoords);
+    }
+}
+
+TEST_CASE("Storage / Versioned Archive / Byte swap")
+{
+    using namespace Graphyte;
+
+    //
+    // Sizes cover vectorized loops and scalar tail.
+    //
+
+    size_t const count = GENERATE(0, 1, 7, 8, 15, 16, 17, 63, 100);
+
+    std::vector<uint16_t> values16(count);
+    std::vector<uint32_t> values32(count);
+    std::vector<uint64_t> values64(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        values16[i] = static_cast<uint16_t>(0x0102 + i * 0x1111);
+        values32[i] = static_cast<uint32_t>(0x01020304 + i * 0x11111111);
+        values64[i] = 0x0102030405060708 + i * 0x1111111111111111;
+    }
+
+    auto swapped16 = values16;
+    auto swapped32 = values32;
+    auto swapped64 = values64;
+
+    Storage::Impl::ByteSwapBuffer(swapped16.data(), count, sizeof(uint16_t));
+    Storage::Impl::ByteSwapBuffer(swapped32.data(), count, sizeof(uint32_t));
+    Storage::Impl::ByteSwapBuffer(swapped64.data(), count, sizeof(uint64_t));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        REQUIRE(swapped16[i] == ByteSwap(values16[i]));
+        REQUIRE(swapped32[i] == ByteSwap(values32[i]));
+        REQUIRE(swapped64[i] == ByteSwap(values64[i]));
+    }
+}
+
+TEST_CASE("Storage / Versioned Archive")
+{
+    using namespace Graphyte;
+
+    TestModelV1 source{
+        .Name     = "model",
+        .Vertices = { { 1.0F, 2.0F, 3.0F }, { 4.0F, 5.0F, 6.0F }, { 7.0F, 8.0F, 9.0F } },
+        .Indices  = { 0, 1, 2 },
+        .Parts    = {
+            { .Name = "root", .Position = { 0.0F, 0.0F, 0.0F } },
+            { .Name = "child", .Position = { 1.0F, 0.5F, 0.25F } },
+        },
+    };
+
+    std::vector<std::byte> data{};
+    REQUIRE(Storage::VersionedArchive::Save(data, source) == Status::Success);
+
+    SECTION("Round trip")
+    {
+        TestModelV1 loaded{};
+        REQUIRE(Storage::VersionedArchive::Load(data, loaded) == Status::Success);
+
+        REQUIRE(loaded.Name == source.Name);
+        REQUIRE(loaded.Vertices.size() == 3);
+        REQUIRE(loaded.Vertices[2].Z == 9.0F);
+        REQUIRE(loaded.Indices == source.Indices);
+        REQUIRE(loaded.Parts.size() == 2);
+        REQUIRE(loaded.Parts[1].Name == "child");
+        REQUIRE(loaded.Parts[1].Position.Z == 0.25F);
+    }
+
+    SECTION("Newer reader loads older data")
+    {
+        TestModelV2 loaded{};
+        loaded.Shape = TestShape::Sphere;
+
+        REQUIRE(Storage::VersionedArchive::Load(data, loaded) == Status::Success);
+
+        REQUIRE(loaded.LoadedVersion == 1);
+        REQUIRE(loaded.Name == "model");
+        REQUIRE(loaded.Vertices.size() == 3);
+        REQUIRE(loaded.Parts.size() == 2);
+        REQUIRE(loaded.Parts[0].Name == "root");
+        REQUIRE(loaded.Parts[0].Tags.empty());
+
+        //
+        // Missing fields keep their values.
+        //
+
+        REQUIRE(loaded.Shape == TestShape::Sphere);
+    }
+
+    SECTION("Older reader loads newer data")
+    {
+        TestModelV2 newer{
+            .Name     = "newer",
+            .Vertices = { { 1.0F, 1.0F, 1.0F } },
+            .Parts    = {
+                { .Name = "tagged", .Position = { 2.0F, 3.0F, 4.0F }, .Tags = { "a", "bb", "" } },
+            },
+            .Shape     = TestShape::Sphere,
+            .Transform = { { { 1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 5.0F, 6.0F, 7.0F, 1.0F } } },
+        };
+
+        std::vector<std::byte> newer_data{};
+        REQUIRE(Storage::VersionedArchive::Save(newer_data, newer) == Status::Success);
+
+        TestModelV1 older{};
+        older.Indices = { 42 };
+
+        REQUIRE(Storage::VersionedArchive::Load(newer_data, older) == Status::Success);
+        REQUIRE(older.Name == "newer");
+        REQUIRE(older.Indices == std::vector<uint32_t>{ 42 });
+        REQUIRE(older.Parts.size() == 1);
+        REQUIRE(older.Parts[0].Position.Y == 3.0F);
+
+        TestModelV2 reloaded{};
+        REQUIRE(Storage::VersionedArchive::Load(newer_data, reloaded) == Status::Success);
+        REQUIRE(reloaded.LoadedVersion == 2);
+        REQUIRE(reloaded.Shape == TestShape::Sphere);
+        REQUIRE(reloaded.Transform.M[3][2] == 7.0F);
+        REQUIRE(reloaded.Parts[0].Tags == std::vector<std::string>{ "a", "bb", "" });
+    }
+
+    SECTION("Embedded in archive")
+    {
+        std::vector<std::byte> buffer{};
+
+        {
+            Storage::ArchiveMemoryWriter writer{ buffer };
+            uint32_t marker = 0xC0DE;
+            writer << marker;
+            REQUIRE(Storage::VersionedArchive::Transfer(writer, source) == Status::Success);
+            writer << marker;
+        }
+
+        Storage::ArchiveMemoryReader reader{ buffer };
+
+        uint32_t marker{};
+        reader << marker;
+        REQUIRE(marker == 0xC0DE);
+
+        TestModelV1 loaded{};
+        REQUIRE(Storage::VersionedArchive::Transfer(reader, loaded) == Status::Success);
+        REQUIRE(loaded.Parts.size() == 2);
+
+        marker = 0;
+        reader << marker;
+        REQUIRE(marker == 0xC0DE);
+    }
+
+    SECTION("Malformed data")
+    {
+        TestModelV1 loaded{};
+
+        std::vector<std::byte> truncated{ data.begin(), data.begin() + (data.size() / 2) };
+        REQUIRE(Storage::VersionedArchive::Load(truncated, loaded) == Status::InvalidFormat);
+
+        std::vector<std::byte> garbage(64, std::byte{ 0x5A });
+        REQUIRE(Storage::VersionedArchive::Load(garbage, loaded) == Status::InvalidFormat);
+
+        REQUIRE(Storage::VersionedArchive::Load({}, loaded) == Status::InvalidFormat);
+    }
+}
+
+TEST_CASE("Storage / Versioned Archive / Foreign byte order")
+{
+    using namespace Graphyte;
+
+    //
+    // Stream written by big endian host.
+    //
+
+    std::vector<std::byte> data{};
+    AppendBigEndian(data, 0x53565847);
+    AppendBigEndian(data, 1);
+
+    // object: version, size
+    AppendBigEndian(data, 1);
+    AppendBigEndian(data, 8 + 12 + 8 + 8 + 8 + 12 + 8 + 5);
+
+    // field 3: indices
+    AppendBigEndian(data, 3);
+    AppendBigEndian(data, 12);
+    AppendBigEndian(data, 0x01020304);
+    AppendBigEndian(data, 2);
+    AppendBigEndian(data, 3);
+
+    // field 99: unknown
+    AppendBigEndian(data, 99);
+    AppendBigEndian(data, 8);
+    AppendBigEndian(data, 0xFFFFFFFF);
+    AppendBigEndian(data, 0xFFFFFFFF);
+
+    // field 2: vertices
+    AppendBigEndian(data, 2);
+    AppendBigEndian(data, 12);
+    AppendBigEndian(data, BitCast<uint32_t>(1.5F));
+    AppendBigEndian(data, BitCast<uint32_t>(-2.0F));
+    AppendBigEndian(data, BitCast<uint32_t>(4.0F));
+
+    // field 1: name
+    AppendBigEndian(data, 1);
+    AppendBigEndian(data, 5);
+
+    for (char c : std::string_view{ "hello" })
+    {
+        data.push_back(static_cast<std::byte>(c));
+    }
+
+    TestModelV1 loaded{};
+    REQUIRE(Storage::VersionedArchive::Load(data, loaded) == Status::Success);
+
+    REQUIRE(loaded.Name == "hello");
+    REQUIRE(loaded.Indices == std::vector<uint32_t>{ 0x01020304, 2, 3 });
+    REQUIRE(loaded.Vertices.size() == 1);
+    REQUIRE(loaded.Vertices[0].X == 1.5F);
+    REQUIRE(loaded.Vertices[0].Y == -2.0F);
+    REQUIRE(loaded.Vertices[0].Z == 4.0F);
+}
+
+TEST_CASE("Storage / Versioned Archive / Mesh throughput", "[.][performance]")
+{
+    using namespace Graphyte;
+    using Graphyte::Diagnostics::Stopwatch;
+
+    constexpr size_t WedgeCount = 3 << 20;
+    constexpr int Iterations    = 10;
+
+    TestMeshStreams mesh{};
+    mesh.FaceMaterialIndices.resize(WedgeCount / 3, 1);
+    mesh.FaceSmoothingMasks.resize(WedgeCount / 3, 2);
+    mesh.VertexPositions.resize(WedgeCount / 2, Float3{ 1.0F, 2.0F, 3.0F });
+    mesh.WedgeIndices.resize(WedgeCount, 7);
+    mesh.WedgeTangentX.resize(WedgeCount, Float3{ 1.0F, 0.0F, 0.0F });
+    mesh.WedgeTangentY.resize(WedgeCount, Float3{ 0.0F, 1.0F, 0.0F });
+    mesh.WedgeTangentZ.resize(WedgeCount, Float3{ 0.0F, 0.0F, 1.0F });
+    mesh.WedgeTextureCoords.resize(WedgeCount, Float2{ 0.5F, 0.5F });
+    mesh.WedgeColors.resize(WedgeCount, ColorBGRA{ .Value = 0xFFFFFFFF });
+
+    Stopwatch watch{};
+
+    double archive_save{};
+    double archive_load{};
+    double versioned_save{};
+    double versioned_load{};
+    double versioned_swap{};
+
+    size_t archive_size{};
+    size_t versioned_size{};
+
+    for (int i = 0; i < Iterations; ++i)
+    {
+        std::vector<std::byte> buffer{};
+
+        watch.Restart();
+        {
+            Storage::ArchiveMemoryWriter writer{ buffer };
+            writer << mesh;
+        }
+        watch.Stop();
+        archive_save += watch.GetElapsedTime<double>();
+
+        archive_size = buffer.size();
+
+        watch.Restart();
+        {
+            TestMeshStreams loaded{};
+            Storage::ArchiveMemoryReader reader{ buffer };
+            reader << loaded;
+            REQUIRE(loaded.WedgeIndices.size() == WedgeCount);
+        }
+        watch.Stop();
+        archive_load += watch.GetElapsedTime<double>();
+
+        watch.Restart();
+        REQUIRE(Storage::VersionedArchive::Save(buffer, mesh) == Status::Success);
+        watch.Stop();
+        versioned_save += watch.GetElapsedTime<double>();
+
+        versioned_size = buffer.size();
+
+        watch.Restart();
+        {
+            TestMeshStreams loaded{};
+            REQUIRE(Storage::VersionedArchive::Load(buffer, loaded) == Status::Success);
+            REQUIRE(loaded.WedgeIndices.size() == WedgeCount);
+        }
+        watch.Stop();
+        versioned_load += watch.GetElapsedTime<double>();
+
+        std::vector<uint32_t> scalars(buffer.size() / sizeof(uint32_t));
+
+        watch.Restart();
+        Storage::Impl::ByteSwapBuffer(scalars.data(), scalars.size(), sizeof(uint32_t));
+        watch.Stop();
+        versioned_swap += watch.GetElapsedTime<double>();
+    }
+
+    auto report = [&](const char* name, double elapsed, size_t size) {
+        double const seconds = elapsed / Iterations;
+
+        WARN(fmt::format(
+            "{:<16} {:>10} bytes {:>10.2f} MiB/s",
+            name,
+            size,
+            (static_cast<double>(size) / (1024.0 * 1024.0)) / seconds));
+    };
+
+    report("archive save", archive_save, archive_size);
+    report("archive load", archive_load, archive_size);
+    report("versioned save", versioned_save, versioned_size);
+    report("versioned load", versioned_load, versioned_size);
+    report("byte swap", versioned_swap, versioned_size);
+}
@@ -0,0 +1,322 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Storage/VirtualFileSystem.hxx>
+#include <GxBase/Storage/MemoryFileSystem.hxx>
+#include <GxBase/Storage/PackageFileSystem.hxx>
+#include <GxBase/Storage/PackageWriter.hxx>
+#include <GxBase/Storage/FileManager.hxx>
+#include <GxBase/Storage/Path.hxx>
+#include <GxBase/System.hxx>
+
+namespace
+{
+    struct VirtualTestVisitor final : public Graphyte::Storage::IDirectoryVisitor
+    {
+        std::vector<std::pair<std::string, bool>> Entries;
+
+        virtual Graphyte::Status Visit(std::string_view path, bool is_directory) noexcept override
+        {
+            Entries.emplace_back(std::string{ path }, is_directory);
+            return Graphyte::Status::Success;
+        }
+    };
+
+    std::vector<std::byte> ToBytes(std::string_view value)
+    {
+        auto const* first = reinterpret_cast<const std::byte*>(value.data());
+        return { first, first + value.size() };
+    }
+
+    void WriteVirtualFile(Graphyte::Storage::IFileSystem& fs, std::string_view path, std::string_view content)
+    {
+        std::unique_ptr<Graphyte::Storage::IStream> stream{};
+        REQUIRE(fs.OpenWrite(stream, path) == Graphyte::Status::Success);
+
+        size_t processed{};
+        REQUIRE(stream->Write(ToBytes(content), processed) == Graphyte::Status::Success);
+        REQUIRE(processed == content.size());
+    }
+
+    std::string ReadVirtualFile(Graphyte::Storage::IFileSystem& fs, std::string_view path)
+    {
+        std::unique_ptr<Graphyte::Storage::IStream> stream{};
+        REQUIRE(fs.OpenRead(stream, path) == Graphyte::Status::Success);
+
+        std::string result(static_cast<size_t>(stream->GetSize()), '\0');
+
+        size_t processed{};
+        REQUIRE(stream->Read(std::as_writable_bytes(std::span{ result }), processed) == Graphyte::Status::Success);
+        REQUIRE(processed == result.size());
+
+        return result;
+    }
+}
+
+TEST_CASE("Storage / Memory File System")
+{
+    using namespace Graphyte;
+
+    Storage::MemoryFileSystem fs{};
+
+    WriteVirtualFile(fs, "config/engine.ini", "[engine]");
+    WriteVirtualFile(fs, "config\\input.ini", "[input]");
+    REQUIRE(fs.DirectoryCreate("saved") == Status::Success);
+
+    SECTION("Reading files")
+    {
+        REQUIRE(ReadVirtualFile(fs, "./config//engine.ini") == "[engine]");
+        REQUIRE(ReadVirtualFile(fs, "config/input.ini") == "[input]");
+
+        int64_t size{};
+        REQUIRE(fs.GetFileSize(size, "config/input.ini") == Status::Success);
+        REQUIRE(size == 7);
+
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(fs.OpenRead(stream, "config/missing.ini") == Status::NotFound);
+        REQUIRE(fs.OpenRead(stream, "../config/engine.ini") == Status::InvalidPath);
+    }
+
+    SECTION("Readers see snapshot")
+    {
+        std::unique_ptr<Storage::IStream> reader{};
+        REQUIRE(fs.OpenRead(reader, "config/engine.ini") == Status::Success);
+
+        {
+            std::unique_ptr<Storage::IStream> writer{};
+            REQUIRE(fs.OpenWrite(writer, "config/engine.ini", true) == Status::Success);
+
+            size_t processed{};
+            REQUIRE(writer->Write(ToBytes("\nvalue=1"), processed) == Status::Success);
+        }
+
+        REQUIRE(reader->GetSize() == 8);
+        REQUIRE(ReadVirtualFile(fs, "config/engine.ini") == "[engine]\nvalue=1");
+    }
+
+    SECTION("Directories")
+    {
+        Storage::FileInfo info{};
+        REQUIRE(fs.GetFileInfo(info, "config") == Status::Success);
+        REQUIRE(info.IsDirectory);
+        REQUIRE(fs.Exists("saved") == Status::Success);
+        REQUIRE(fs.Exists("") == Status::Success);
+
+        VirtualTestVisitor visitor{};
+        REQUIRE(fs.Enumerate("", visitor) == Status::Success);
+        REQUIRE(visitor.Entries == std::vector<std::pair<std::string, bool>>{
+                                       { "config", true },
+                                       { "saved", true },
+                                   });
+
+        REQUIRE(fs.DirectoryDelete("config") == Status::DirectoryNotEmpty);
+        REQUIRE(fs.FileMove("saved/engine.ini", "config/engine.ini") == Status::Success);
+        REQUIRE(fs.FileDelete("config/input.ini") == Status::Success);
+        REQUIRE(fs.Exists("config") == Status::NotFound);
+        REQUIRE(ReadVirtualFile(fs, "saved/engine.ini") == "[engine]");
+    }
+}
+
+TEST_CASE("Storage / Virtual File System")
+{
+    using namespace Graphyte;
+
+    auto base  = std::make_shared<Storage::MemoryFileSystem>();
+    auto patch = std::make_shared<Storage::MemoryFileSystem>();
+    auto user  = std::make_shared<Storage::MemoryFileSystem>();
+
+    WriteVirtualFile(*base, "content/shaders/common.hlsl", "base common");
+    WriteVirtualFile(*base, "content/shaders/lighting.hlsl", "base lighting");
+    WriteVirtualFile(*base, "content/readme.txt", "readme");
+    WriteVirtualFile(*patch, "shaders/lighting.hlsl", "patched lighting");
+    WriteVirtualFile(*patch, "shaders/fog.hlsl", "patched fog");
+
+    Storage::VirtualFileSystem vfs{};
+
+    Storage::MountId base_id{};
+    Storage::MountId patch_id{};
+    Storage::MountId user_id{};
+
+    REQUIRE(vfs.Mount(base_id, "", base, "content", 0) == Status::Success);
+    REQUIRE(vfs.Mount(patch_id, "", patch, "", 10) == Status::Success);
+    REQUIRE(vfs.Mount(user_id, "", user, "", 5, true) == Status::Success);
+
+    REQUIRE(base_id != Storage::MountId::Invalid);
+    REQUIRE(base_id != patch_id);
+
+    SECTION("Higher priority overrides")
+    {
+        REQUIRE(ReadVirtualFile(vfs, "shaders/common.hlsl") == "base common");
+        REQUIRE(ReadVirtualFile(vfs, "shaders/lighting.hlsl") == "patched lighting");
+        REQUIRE(ReadVirtualFile(vfs, "shaders/fog.hlsl") == "patched fog");
+
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(vfs.OpenRead(stream, "shaders/missing.hlsl") == Status::NotFound);
+        REQUIRE(vfs.OpenRead(stream, "../shaders/fog.hlsl") == Status::InvalidPath);
+
+        //
+        // Same priority: latest mount wins.
+        //
+
+        auto mod = std::make_shared<Storage::MemoryFileSystem>();
+        WriteVirtualFile(*mod, "shaders/lighting.hlsl", "mod lighting");
+
+        Storage::MountId mod_id{};
+        REQUIRE(vfs.Mount(mod_id, "", mod, "", 10) == Status::Success);
+        REQUIRE(ReadVirtualFile(vfs, "shaders/lighting.hlsl") == "mod lighting");
+
+        REQUIRE(vfs.Unmount(mod_id) == Status::Success);
+        REQUIRE(vfs.Unmount(mod_id) == Status::NotFound);
+        REQUIRE(ReadVirtualFile(vfs, "shaders/lighting.hlsl") == "patched lighting");
+    }
+
+    SECTION("Writes go to writable mount")
+    {
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(vfs.OpenRead(stream, "saved/settings.ini") == Status::NotFound);
+
+        WriteVirtualFile(vfs, "saved/settings.ini", "settings");
+
+        REQUIRE(user->Exists("saved/settings.ini") == Status::Success);
+        REQUIRE(ReadVirtualFile(vfs, "saved/settings.ini") == "settings");
+        REQUIRE(vfs.Exists("saved") == Status::Success);
+
+        //
+        // File written to user mount is shadowed by patch, which has higher priority.
+        //
+
+        WriteVirtualFile(vfs, "shaders/fog.hlsl", "user fog");
+        REQUIRE(ReadVirtualFile(vfs, "shaders/fog.hlsl") == "patched fog");
+
+        REQUIRE(vfs.FileDelete("shaders/fog.hlsl") == Status::AccessDenied);
+        REQUIRE(vfs.FileDelete("readme.txt") == Status::AccessDenied);
+
+        bool readonly{};
+        REQUIRE(vfs.IsReadonly(readonly, "readme.txt") == Status::Success);
+        REQUIRE(readonly);
+        REQUIRE(vfs.IsReadonly(readonly, "saved/settings.ini") == Status::Success);
+        REQUIRE_FALSE(readonly);
+
+        REQUIRE(vfs.FileMove("saved/renamed.ini", "saved/settings.ini") == Status::Success);
+        REQUIRE(vfs.Exists("saved/settings.ini") == Status::NotFound);
+        REQUIRE(ReadVirtualFile(vfs, "saved/renamed.ini") == "settings");
+
+        REQUIRE(vfs.FileDelete("saved/renamed.ini") == Status::Success);
+        REQUIRE(vfs.Exists("saved/renamed.ini") == Status::NotFound);
+        REQUIRE(vfs.Exists("saved") == Status::NotFound);
+    }
+
+    SECTION("Cache invalidation")
+    {
+        REQUIRE(vfs.Exists("shaders/late.hlsl") == Status::NotFound);
+
+        //
+        // Change made directly on mounted file system is not visible until cache is invalidated.
+        //
+
+        WriteVirtualFile(*base, "content/shaders/late.hlsl", "late");
+        REQUIRE(vfs.Exists("shaders/late.hlsl") == Status::NotFound);
+
+        vfs.InvalidateCache();
+        REQUIRE(ReadVirtualFile(vfs, "shaders/late.hlsl") == "late");
+
+        REQUIRE(vfs.Unmount(patch_id) == Status::Success);
+        REQUIRE(ReadVirtualFile(vfs, "shaders/lighting.hlsl") == "base lighting");
+        REQUIRE(vfs.Exists("shaders/fog.hlsl") == Status::NotFound);
+    }
+
+    SECTION("Enumeration returns union")
+    {
+        WriteVirtualFile(vfs, "shaders/user.hlsl", "user");
+
+        VirtualTestVisitor visitor{};
+        REQUIRE(vfs.Enumerate("shaders", visitor) == Status::Success);
+        REQUIRE(visitor.Entries == std::vector<std::pair<std::string, bool>>{
+                                       { "shaders/common.hlsl", false },
+                                       { "shaders/fog.hlsl", false },
+                                       { "shaders/lighting.hlsl", false },
+                                       { "shaders/user.hlsl", false },
+                                   });
+
+        VirtualTestVisitor root{};
+        REQUIRE(vfs.Enumerate("", root) == Status::Success);
+        REQUIRE(root.Entries == std::vector<std::pair<std::string, bool>>{
+                                    { "readme.txt", false },
+                                    { "shaders", true },
+                                });
+
+        VirtualTestVisitor missing{};
+        REQUIRE(vfs.Enumerate("textures", missing) == Status::NotFound);
+    }
+
+    SECTION("Mount prefixes")
+    {
+        //
+        // Package is built in memory file system and mounted below prefix.
+        //
+
+        {
+            std::unique_ptr<Storage::IStream> stream{};
+            REQUIRE(user->OpenWrite(stream, "mods/hd.pak") == Status::Success);
+
+            Storage::PackageWriter writer{ std::move(stream) };
+            REQUIRE(writer.Add("textures/stone.dds", ToBytes("hd stone")) == Status::Success);
+            REQUIRE(writer.Add("shaders/lighting.hlsl", ToBytes("hd lighting")) == Status::Success);
+            REQUIRE(writer.Finish() == Status::Success);
+        }
+
+        std::unique_ptr<Storage::IMappedFile> mapped{};
+        REQUIRE(user->OpenMapped(mapped, "mods/hd.pak") == Status::Success);
+
+        std::unique_ptr<Storage::PackageFileSystem> package{};
+        REQUIRE(Storage::PackageFileSystem::Open(package, std::move(mapped)) == Status::Success);
+
+        Storage::MountId package_id{};
+        REQUIRE(vfs.Mount(package_id, "mods/hd", std::move(package), "", 20) == Status::Success);
+
+        REQUIRE(ReadVirtualFile(vfs, "mods/hd/textures/stone.dds") == "hd stone");
+        REQUIRE(ReadVirtualFile(vfs, "shaders/lighting.hlsl") == "patched lighting");
+
+        Storage::FileInfo info{};
+        REQUIRE(vfs.GetFileInfo(info, "mods/hd") == Status::Success);
+        REQUIRE(info.IsDirectory);
+
+        //
+        // Mount prefix directory is merged with content of user mount.
+        //
+
+        VirtualTestVisitor visitor{};
+        REQUIRE(vfs.Enumerate("mods", visitor) == Status::Success);
+        REQUIRE(visitor.Entries == std::vector<std::pair<std::string, bool>>{
+                                       { "mods/hd", true },
+                                       { "mods/hd.pak", false },
+                                   });
+
+        std::unique_ptr<Storage::IStream> stream{};
+        REQUIRE(vfs.OpenWrite(stream, "mods/hd/textures/new.dds") == Status::Success);
+        stream = nullptr;
+        REQUIRE(user->Exists("mods/hd/textures/new.dds") == Status::Success);
+        REQUIRE(ReadVirtualFile(vfs, "mods/hd/textures/stone.dds") == "hd stone");
+    }
+
+    SECTION("Native file system")
+    {
+        auto temp_dir = Storage::CombinePath(System::GetUserTemporaryDirectory(), "test.base.vfs");
+        REQUIRE(Storage::IFileSystem::GetPlatformNative().DirectoryTreeCreate(Storage::CombinePath(temp_dir, "shaders")) == Status::Success);
+        REQUIRE(Storage::WriteText("native", Storage::CombinePath(temp_dir, "shaders/native.hlsl")) == Status::Success);
+
+        Storage::MountId native_id{};
+        REQUIRE(vfs.Mount(native_id, "", Storage::IFileSystem::GetPlatformNative(), temp_dir, 1) == Status::Success);
+
+        REQUIRE(ReadVirtualFile(vfs, "shaders/native.hlsl") == "native");
+        REQUIRE(ReadVirtualFile(vfs, "shaders/common.hlsl") == "base common");
+
+        VirtualTestVisitor visitor{};
+        REQUIRE(vfs.Enumerate("shaders", visitor) == Status::Success);
+        REQUIRE(visitor.Entries.size() == 4);
+        REQUIRE(visitor.Entries[3] == std::pair<std::string, bool>{ "shaders/native.hlsl", false });
+
+        REQUIRE(vfs.Unmount(native_id) == Status::Success);
+        REQUIRE(Storage::IFileSystem::GetPlatformNative().FileDelete(Storage::CombinePath(temp_dir, "shaders/native.hlsl")) == Status::Success);
+        REQUIRE(Storage::IFileSystem::GetPlatformNative().DirectoryDelete(Storage::CombinePath(temp_dir, "shaders")) == Status::Success);
+        REQUIRE(Storage::IFileSystem::GetPlatformNative().DirectoryDelete(temp_dir) == Status::Success);
+    }
+}
@@ -0,0 +1,506 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Threading.hxx>
+#include <GxBase/Threading/TaskDispatcher.hxx>
+#include <GxBase/Threading/TaskStorage.hxx>
+#include <GxBase/Threading/Thread.hxx>
+#include <GxBase/Threading/WorkStealingQueue.hxx>
+#include <GxBase/Stopwatch.hxx>
+
+//
+// Global allocation functions are replaced to count heap allocations made by test process. All
+// forms allocate aligned memory, so every form of delete releases it the same way.
+//
+
+namespace
+{
+    std::atomic<uint64_t> g_TaskDispatcherTestAllocations{};
+
+    void* TaskDispatcherTestAllocate(size_t size, size_t alignment) noexcept
+    {
+        g_TaskDispatcherTestAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        size      = std::max<size_t>(size, 1);
+        alignment = std::max<size_t>(alignment, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+#if GX_PLATFORM_WINDOWS || GX_PLATFORM_UWP
+        return _aligned_malloc(size, alignment);
+#else
+        void* result{};
+        return (posix_memalign(&result, alignment, size) == 0) ? result : nullptr;
+#endif
+    }
+
+    void TaskDispatcherTestDeallocate(void* pointer) noexcept
+    {
+#if GX_PLATFORM_WINDOWS || GX_PLATFORM_UWP
+        _aligned_free(pointer);
+#else
+        free(pointer);
+#endif
+    }
+
+    void* TaskDispatcherTestAllocateOrThrow(size_t size, size_t alignment)
+    {
+        if (void* const result = TaskDispatcherTestAllocate(size, alignment); result != nullptr)
+        {
+            return result;
+        }
+
+        throw std::bad_alloc{};
+    }
+}
+
+void* operator new(size_t size)
+{
+    return TaskDispatcherTestAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return TaskDispatcherTestAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return TaskDispatcherTestAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return TaskDispatcherTestAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+    TaskDispatcherTestDeallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    TaskDispatcherTestDeallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    TaskDispatcherTestDeallocate(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept
+{
+    TaskDispatcherTestDeallocate(pointer);
+}
+
+TEST_CASE("Threading / Work Stealing Queue / Single thread")
+{
+    using namespace Graphyte::Threading;
+
+    WorkStealingQueue<uintptr_t> queue{ 4 };
+
+    uintptr_t value{};
+
+    REQUIRE(queue.IsEmpty());
+    REQUIRE_FALSE(queue.Pop(value));
+    REQUIRE_FALSE(queue.Steal(value));
+
+    SECTION("Owner pops in LIFO order")
+    {
+        queue.Push(1);
+        queue.Push(2);
+        queue.Push(3);
+
+        REQUIRE(queue.GetSize() == 3);
+
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == 3);
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == 2);
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == 1);
+        REQUIRE_FALSE(queue.Pop(value));
+    }
+
+    SECTION("Thieves steal in FIFO order")
+    {
+        queue.Push(1);
+        queue.Push(2);
+        queue.Push(3);
+
+        REQUIRE(queue.Steal(value));
+        REQUIRE(value == 1);
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == 3);
+        REQUIRE(queue.Steal(value));
+        REQUIRE(value == 2);
+        REQUIRE_FALSE(queue.Steal(value));
+    }
+
+    SECTION("Queue grows past initial capacity")
+    {
+        for (uintptr_t i = 0; i < 1000; ++i)
+        {
+            queue.Push(i);
+        }
+
+        REQUIRE(queue.GetSize() == 1000);
+
+        for (uintptr_t i = 0; i < 500; ++i)
+        {
+            REQUIRE(queue.Steal(value));
+            REQUIRE(value == i);
+        }
+
+        for (uintptr_t i = 1000; i > 500; --i)
+        {
+            REQUIRE(queue.Pop(value));
+            REQUIRE(value == i - 1);
+        }
+
+        REQUIRE(queue.IsEmpty());
+    }
+}
+
+TEST_CASE("Threading / Work Stealing Queue / Concurrent steal")
+{
+    using namespace Graphyte::Threading;
+
+    constexpr uintptr_t const Count   = 200'000;
+    constexpr size_t const ThiefCount = 3;
+
+    WorkStealingQueue<uintptr_t> queue{};
+    std::vector<std::atomic<uint32_t>> taken(Count);
+    std::atomic<bool> done{};
+
+    class Thief final : public IRunnable
+    {
+    private:
+        WorkStealingQueue<uintptr_t>& m_Queue;
+        std::vector<std::atomic<uint32_t>>& m_Taken;
+        std::atomic<bool>& m_Done;
+
+    public:
+        Thief(
+            WorkStealingQueue<uintptr_t>& queue,
+            std::vector<std::atomic<uint32_t>>& taken,
+            std::atomic<bool>& done) noexcept
+            : m_Queue{ queue }
+            , m_Taken{ taken }
+            , m_Done{ done }
+        {
+        }
+
+        uint32_t OnRun() noexcept override
+        {
+            uintptr_t value{};
+
+            while (!m_Done.load())
+            {
+                if (m_Queue.Steal(value))
+                {
+                    ++m_Taken[value];
+                }
+            }
+
+            while (m_Queue.Steal(value))
+            {
+                ++m_Taken[value];
+            }
+
+            return 0;
+        }
+    };
+
+    std::vector<std::unique_ptr<Thief>> thieves{};
+    std::vector<Thread> threads(ThiefCount);
+
+    for (size_t i = 0; i < ThiefCount; ++i)
+    {
+        thieves.push_back(std::make_unique<Thief>(queue, taken, done));
+        threads[i].Start(thieves.back().get(), "Thief");
+    }
+
+    uintptr_t value{};
+
+    for (uintptr_t i = 0; i < Count; ++i)
+    {
+        queue.Push(i);
+
+        if ((i % 3) == 0 && queue.Pop(value))
+        {
+            ++taken[value];
+        }
+    }
+
+    while (queue.Pop(value))
+    {
+        ++taken[value];
+    }
+
+    done.store(true);
+
+    for (auto& thread : threads)
+    {
+        thread.Stop(true);
+    }
+
+    bool all_taken_once = true;
+
+    for (auto& item : taken)
+    {
+        all_taken_once &= (item.load() == 1);
+    }
+
+    REQUIRE(all_taken_once);
+}
+
+namespace
+{
+    struct CountingTask final
+    {
+        std::atomic<uint32_t>& Counter;
+
+        CountingTask(std::atomic<uint32_t>& counter) noexcept
+            : Counter{ counter }
+        {
+        }
+
+        void DoTask() noexcept
+        {
+            ++Counter;
+        }
+    };
+
+    struct SpawningTask final
+    {
+        Graphyte::Threading::TaskDispatcher& Dispatcher;
+        std::atomic<uint32_t>& Counter;
+        uint32_t Depth;
+
+        SpawningTask(
+            Graphyte::Threading::TaskDispatcher& dispatcher,
+            std::atomic<uint32_t>& counter,
+            uint32_t depth) noexcept
+            : Dispatcher{ dispatcher }
+            , Counter{ counter }
+            , Depth{ depth }
+        {
+        }
+
+        void DoTask() noexcept
+        {
+            using namespace Graphyte::Threading;
+
+            ++Counter;
+
+            if (Depth != 0)
+            {
+                Dispatcher.Dispatch(Task<SpawningTask>::Make(Dispatcher, Counter, Depth - 1));
+                Dispatcher.Dispatch(Task<SpawningTask>::Make(Dispatcher, Counter, Depth - 1));
+            }
+        }
+    };
+
+    void WaitForCounter(const std::atomic<uint32_t>& counter, uint32_t expected) noexcept
+    {
+        while (counter.load() != expected)
+        {
+            Graphyte::Threading::YieldThread();
+        }
+    }
+}
+
+TEST_CASE("Threading / Task Dispatcher")
+{
+    using namespace Graphyte::Threading;
+
+    TaskDispatcher dispatcher{};
+    dispatcher.Start(4);
+
+    std::atomic<uint32_t> counter{};
+
+    SECTION("Tasks dispatched from external thread")
+    {
+        constexpr uint32_t const Count = 10'000;
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            dispatcher.Dispatch(Task<CountingTask>::Make(counter));
+        }
+
+        WaitForCounter(counter, Count);
+        REQUIRE(counter.load() == Count);
+    }
+
+    SECTION("Tasks dispatched from worker threads")
+    {
+        constexpr uint32_t const Depth = 12;
+
+        dispatcher.Dispatch(Task<SpawningTask>::Make(dispatcher, counter, Depth));
+
+        WaitForCounter(counter, (1u << (Depth + 1)) - 1);
+        REQUIRE(counter.load() == (1u << (Depth + 1)) - 1);
+    }
+
+    SECTION("Callable tasks")
+    {
+        constexpr uint32_t const Count = 1'000;
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            dispatcher.Dispatch([&counter]() {
+                ++counter;
+            });
+        }
+
+        WaitForCounter(counter, Count);
+        REQUIRE(counter.load() == Count);
+    }
+
+    SECTION("Parked workers wake up")
+    {
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            SleepThread(5);
+
+            dispatcher.Dispatch(Task<CountingTask>::Make(counter));
+            WaitForCounter(counter, i + 1);
+        }
+
+        REQUIRE(counter.load() == 16);
+    }
+
+    dispatcher.Stop();
+}
+
+TEST_CASE("Threading / Task Storage")
+{
+    using namespace Graphyte::Threading;
+
+    SECTION("Blocks are aligned and reused")
+    {
+        for (size_t size : { 1, 24, 64, 65, 128, 200, 256, 511, 512 })
+        {
+            void* const block = TaskStorage::Allocate(size);
+
+            REQUIRE(block != nullptr);
+            REQUIRE((reinterpret_cast<uintptr_t>(block) % TaskStorage::BlockAlignment) == 0);
+
+            std::memset(block, 0xCC, size);
+
+            TaskStorage::Deallocate(block, size);
+
+            REQUIRE(TaskStorage::Allocate(size) == block);
+            TaskStorage::Deallocate(block, size);
+        }
+    }
+
+    SECTION("Steady state dispatch makes no heap allocations")
+    {
+        TaskDispatcher dispatcher{};
+        dispatcher.Start(4);
+
+        constexpr uint32_t const Rounds = 64;
+        constexpr uint32_t const Count  = 512;
+
+        std::atomic<uint32_t> counter{};
+
+        auto dispatch_round = [&]() {
+            counter.store(0);
+
+            for (uint32_t i = 0; i < Count; ++i)
+            {
+                dispatcher.Dispatch([&counter]() {
+                    ++counter;
+                });
+            }
+
+            WaitForCounter(counter, Count);
+        };
+
+        for (uint32_t round = 0; round < Rounds; ++round)
+        {
+            dispatch_round();
+        }
+
+        auto const warm              = TaskStorage::GetStatistics();
+        uint64_t const allocations = g_TaskDispatcherTestAllocations.load();
+
+        for (uint32_t round = 0; round < Rounds; ++round)
+        {
+            dispatch_round();
+        }
+
+        uint64_t const steady_allocations = g_TaskDispatcherTestAllocations.load();
+        auto const steady                 = TaskStorage::GetStatistics();
+
+        REQUIRE(warm.SlabAllocations == steady.SlabAllocations);
+        REQUIRE(steady_allocations == allocations);
+
+        dispatcher.Stop();
+    }
+}
+
+TEST_CASE("Threading / Task Dispatcher / Dispatch overhead", "[.][performance]")
+{
+    using namespace Graphyte::Threading;
+    using Graphyte::Diagnostics::Stopwatch;
+
+    constexpr uint32_t const Count = 1'000'000;
+
+    TaskDispatcher dispatcher{};
+    dispatcher.Start(4);
+
+    std::atomic<uint32_t> counter{};
+
+    Stopwatch watch{};
+    std::string_view name{};
+
+    SECTION("Heap allocated tasks")
+    {
+        name = "heap allocated tasks";
+        watch.Start();
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            dispatcher.Dispatch(Task<CountingTask>::Make(counter));
+        }
+
+        WaitForCounter(counter, Count);
+        watch.Stop();
+    }
+
+    SECTION("Pooled tasks")
+    {
+        name = "pooled tasks";
+        watch.Start();
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            dispatcher.Dispatch(Task<CountingTask>::Create(counter));
+        }
+
+        WaitForCounter(counter, Count);
+        watch.Stop();
+    }
+
+    SECTION("Pooled callable tasks")
+    {
+        name = "pooled callable tasks";
+        watch.Start();
+
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            dispatcher.Dispatch([&counter]() {
+                ++counter;
+            });
+        }
+
+        WaitForCounter(counter, Count);
+        watch.Stop();
+    }
+
+    dispatcher.Stop();
+
+    WARN(fmt::format("{:<24} {:>8.1f} ns per task",
+        name,
+        (watch.GetElapsedTime<double>() * 1.0e9) / Count));
+}
@@ -0,0 +1,261 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Threading.hxx>
+#include <GxBase/Threading/TaskGraph.hxx>
+#include <GxBase/Threading/TaskStorage.hxx>
+
+TEST_CASE("Threading / Task Handle")
+{
+    using namespace Graphyte::Threading;
+
+    TaskDispatcher dispatcher{};
+    dispatcher.Start(4);
+
+    SECTION("Wait for single task")
+    {
+        std::atomic<uint32_t> counter{};
+
+        TaskHandle handle = dispatcher.Schedule([&counter]() {
+            ++counter;
+        });
+
+        REQUIRE(handle.IsValid());
+
+        handle.Wait();
+
+        REQUIRE(handle.IsCompleted());
+        REQUIRE(counter.load() == 1);
+    }
+
+    SECTION("Task runs after all dependencies")
+    {
+        std::atomic<uint32_t> a{};
+        std::atomic<uint32_t> c{};
+        bool dependencies_completed{};
+
+        TaskHandle const handle_a = dispatcher.Schedule([&a]() {
+            SleepThread(5);
+            a.store(1);
+        });
+
+        TaskHandle const handle_c = dispatcher.Schedule([&c]() {
+            c.store(1);
+        });
+
+        TaskHandle const handle_b = dispatcher.Schedule([&]() {
+            dependencies_completed = (a.load() == 1) && (c.load() == 1);
+        },
+            { handle_a, handle_c });
+
+        handle_b.Wait();
+
+        REQUIRE(handle_a.IsCompleted());
+        REQUIRE(handle_c.IsCompleted());
+        REQUIRE(dependencies_completed);
+    }
+
+    SECTION("Continuations form chain")
+    {
+        std::vector<uint32_t> order{};
+
+        TaskHandle handle = dispatcher.Schedule([&order]() {
+            order.push_back(0);
+        });
+
+        for (uint32_t i = 1; i < 64; ++i)
+        {
+            handle = handle.ContinueWith([&order, i]() {
+                order.push_back(i);
+            });
+        }
+
+        handle.Wait();
+
+        REQUIRE(order.size() == 64);
+
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            REQUIRE(order[i] == i);
+        }
+    }
+
+    SECTION("Dependency on completed task")
+    {
+        TaskHandle const first = dispatcher.Schedule([]() {});
+        first.Wait();
+
+        std::atomic<uint32_t> counter{};
+
+        TaskHandle const second = first.ContinueWith([&counter]() {
+            ++counter;
+        });
+
+        second.Wait();
+
+        REQUIRE(counter.load() == 1);
+    }
+
+    SECTION("Nested waits inside tasks")
+    {
+        std::atomic<uint32_t> counter{};
+
+        TaskHandle const outer = dispatcher.Schedule([&]() {
+            std::vector<TaskHandle> inner{};
+
+            for (uint32_t i = 0; i < 64; ++i)
+            {
+                inner.push_back(dispatcher.Schedule([&counter]() {
+                    ++counter;
+                }));
+            }
+
+            for (auto const& handle : inner)
+            {
+                handle.Wait();
+            }
+        });
+
+        outer.Wait();
+
+        REQUIRE(counter.load() == 64);
+    }
+
+    dispatcher.Stop();
+}
+
+TEST_CASE("Threading / Task Handle / Waiting helps executing tasks")
+{
+    using namespace Graphyte::Threading;
+
+    //
+    // Dispatcher without workers - waiting thread must execute everything by itself.
+    //
+
+    TaskDispatcher dispatcher{};
+
+    std::atomic<uint32_t> counter{};
+
+    TaskHandle const first = dispatcher.Schedule([&counter]() {
+        ++counter;
+    });
+
+    TaskHandle const second = first.ContinueWith([&counter]() {
+        ++counter;
+    });
+
+    second.Wait();
+
+    REQUIRE(counter.load() == 2);
+}
+
+TEST_CASE("Threading / Task Graph")
+{
+    using namespace Graphyte::Threading;
+
+    TaskDispatcher dispatcher{};
+    dispatcher.Start(4);
+
+    SECTION("Empty graph completes")
+    {
+        TaskGraph graph{};
+
+        graph.Kick(dispatcher).Wait();
+
+        REQUIRE(graph.GetSize() == 0);
+    }
+
+    SECTION("Diamond graph respects dependencies")
+    {
+        //
+        //       +-> b -+
+        //   a --+      +--> d
+        //       +-> c -+
+        //
+
+        std::atomic<uint32_t> sequence{};
+        uint32_t order[4]{};
+
+        TaskGraph graph{};
+
+        auto const a = graph.Add([&]() { order[0] = ++sequence; });
+        auto const b = graph.Add([&]() { order[1] = ++sequence; });
+        auto const c = graph.Add([&]() { order[2] = ++sequence; });
+        auto const d = graph.Add([&]() { order[3] = ++sequence; });
+
+        graph.Precede(a, b);
+        graph.Precede(a, c);
+        graph.Precede(b, d);
+        graph.Precede(c, d);
+
+        graph.Run(dispatcher);
+
+        REQUIRE(sequence.load() == 4);
+        REQUIRE(order[0] == 1);
+        REQUIRE(order[1] > order[0]);
+        REQUIRE(order[2] > order[0]);
+        REQUIRE(order[3] == 4);
+    }
+
+    SECTION("Graph can be kicked many times without allocation")
+    {
+        constexpr uint32_t const Width = 32;
+        constexpr uint32_t const Rounds = 256;
+
+        std::atomic<uint32_t> update{};
+        std::atomic<uint32_t> render{};
+        bool ordered = true;
+
+        TaskGraph graph{};
+
+        auto const begin = graph.Add([]() {});
+        auto const end   = graph.Add([&]() {
+            ordered &= (update.load() == render.load());
+        });
+
+        for (uint32_t i = 0; i < Width; ++i)
+        {
+            auto const node_update = graph.Add([&update]() { ++update; });
+            auto const node_render = graph.Add([&render]() { ++render; });
+
+            graph.Precede(begin, node_update);
+            graph.Precede(node_update, node_render);
+            graph.Precede(node_render, end);
+        }
+
+        graph.Run(dispatcher);
+
+        auto const warm = TaskStorage::GetStatistics();
+
+        for (uint32_t round = 1; round < Rounds; ++round)
+        {
+            graph.Run(dispatcher);
+        }
+
+        auto const steady = TaskStorage::GetStatistics();
+
+        REQUIRE(ordered);
+        REQUIRE(update.load() == Width * Rounds);
+        REQUIRE(render.load() == Width * Rounds);
+        REQUIRE(warm.SlabAllocations == steady.SlabAllocations);
+    }
+
+    SECTION("Graph waits for external dependencies")
+    {
+        std::atomic<uint32_t> value{};
+        uint32_t observed{};
+
+        TaskGraph graph{};
+        graph.Add([&]() { observed = value.load(); });
+
+        TaskHandle const producer = dispatcher.Schedule([&value]() {
+            SleepThread(5);
+            value.store(42);
+        });
+
+        TaskHandle const handle = graph.Kick(dispatcher, std::span<const TaskHandle>{ &producer, 1 });
+        handle.Wait();
+
+        REQUIRE(observed == 42);
+    }
+
+    dispatcher.Stop();
+}
@@ -4,6 +4,7 @@
 #include <GxBase/Threading/Runnable.hxx>
 #include <GxBase/Threading/Sync.hxx>
 #include <GxBase/Threading.hxx>
+#include <GxBase/Threading/ParallelFor.hxx>
 #include <GxBase/Stopwatch.hxx>
 
 TEST_CASE("Threading / Parallel For")
@@ -24,6 +25,233 @@ TEST_CASE("Threading / Parallel For")
     REQUIRE(counter == N);
 }
 
+TEST_CASE("Threading / Parallel For / Ranges")
+{
+    using namespace Graphyte::Threading;
+
+    SECTION("Every index is visited once")
+    {
+        for (size_t count : { 0, 1, 2, 3, 7, 64, 1000, 100'003 })
+        {
+            for (size_t grain : { 0, 1, 16, 1024 })
+            {
+                std::vector<std::atomic<uint32_t>> visited(count);
+                std::atomic<bool> empty_range{};
+
+                ParallelForRange(
+                    0, count, [&](size_t begin, size_t end) {
+                        if (begin >= end)
+                        {
+                            empty_range.store(true);
+                        }
+
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            ++visited[i];
+                        }
+                    },
+                    grain);
+
+                bool all_visited_once = true;
+
+                for (auto& item : visited)
+                {
+                    all_visited_once &= (item.load() == 1);
+                }
+
+                REQUIRE(all_visited_once);
+                REQUIRE_FALSE(empty_range.load());
+            }
+        }
+    }
+
+    SECTION("Subranges respect grain size")
+    {
+        constexpr size_t const Count = 10'000;
+        constexpr size_t const Grain = 100;
+
+        std::atomic<size_t> smallest{ Count };
+        std::atomic<size_t> total{};
+
+        ParallelForRange(
+            0, Count, [&](size_t begin, size_t end) {
+                size_t const size = end - begin;
+                size_t current    = smallest.load();
+
+                while (size < current && !smallest.compare_exchange_weak(current, size))
+                {
+                }
+
+                total += size;
+            },
+            Grain);
+
+        REQUIRE(total.load() == Count);
+        REQUIRE(smallest.load() >= (Grain / 2));
+    }
+
+    SECTION("Nested loops")
+    {
+        std::atomic<uint32_t> counter{};
+
+        ParallelForRange(0, 64, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                ParallelForRange(0, 64, [&](size_t inner_begin, size_t inner_end) {
+                    counter += static_cast<uint32_t>(inner_end - inner_begin);
+                });
+            }
+        });
+
+        REQUIRE(counter.load() == 64 * 64);
+    }
+}
+
+TEST_CASE("Threading / Parallel Reduce")
+{
+    using namespace Graphyte::Threading;
+
+    SECTION("Sum")
+    {
+        constexpr size_t const Count = 1'000'000;
+
+        uint64_t const sum = ParallelReduce(
+            0, Count, uint64_t{}, [](size_t begin, size_t end, uint64_t value) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    value += i;
+                }
+
+                return value;
+            },
+            [](uint64_t lhs, uint64_t rhs) {
+                return lhs + rhs;
+            });
+
+        REQUIRE(sum == (uint64_t{ Count } * (Count - 1)) / 2);
+    }
+
+    SECTION("Join preserves order")
+    {
+        constexpr size_t const Count = 5'000;
+
+        std::string const result = ParallelReduce(
+            0, Count, std::string{}, [](size_t begin, size_t end, std::string value) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    value.push_back(static_cast<char>('a' + (i % 26)));
+                }
+
+                return value;
+            },
+            [](std::string lhs, const std::string& rhs) {
+                return lhs + rhs;
+            },
+            7);
+
+        bool ordered = (result.size() == Count);
+
+        for (size_t i = 0; ordered && i < Count; ++i)
+        {
+            ordered = (result[i] == static_cast<char>('a' + (i % 26)));
+        }
+
+        REQUIRE(ordered);
+    }
+
+    SECTION("Empty range yields identity")
+    {
+        int const result = ParallelReduce(
+            5, 5, 42, [](size_t, size_t, int value) { return value + 1; }, [](int lhs, int rhs) { return lhs + rhs; });
+
+        REQUIRE(result == 42);
+    }
+}
+
+TEST_CASE("Threading / Parallel Scan")
+{
+    using namespace Graphyte::Threading;
+
+    constexpr size_t const Count = 100'000;
+
+    std::vector<uint32_t> input(Count);
+    std::vector<uint64_t> output(Count);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        input[i] = static_cast<uint32_t>((i * 7919) % 13);
+    }
+
+    uint64_t const total = ParallelScan(
+        0, Count, uint64_t{}, [&](size_t begin, size_t end, uint64_t prefix, bool final) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                prefix += input[i];
+
+                if (final)
+                {
+                    output[i] = prefix;
+                }
+            }
+
+            return prefix;
+        },
+        [](uint64_t lhs, uint64_t rhs) {
+            return lhs + rhs;
+        });
+
+    uint64_t expected{};
+    bool matches = true;
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        expected += input[i];
+        matches &= (output[i] == expected);
+    }
+
+    REQUIRE(matches);
+    REQUIRE(total == expected);
+}
+
+TEST_CASE("Threading / Parallel For / Ranges vs per-index", "[.][performance]")
+{
+    using namespace Graphyte::Threading;
+    using Graphyte::Diagnostics::Stopwatch;
+
+    constexpr size_t const Count = 1u << 24;
+
+    std::vector<float> data(Count, 1.0F);
+
+    Stopwatch watch{};
+
+    SECTION("Per-index")
+    {
+        watch.Start();
+
+        ParallelFor(static_cast<uint32_t>(Count), [&](uint32_t index) {
+            data[index] = data[index] * 2.0F + 1.0F;
+        });
+
+        watch.Stop();
+    }
+
+    SECTION("Ranges")
+    {
+        watch.Start();
+
+        ParallelForRange(0, Count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                data[i] = data[i] * 2.0F + 1.0F;
+            }
+        });
+
+        watch.Stop();
+    }
+
+    REQUIRE(data[0] == 3.0F);
+}
+
 TEST_CASE("ReaderWriterLockCase", "[.][performance]")
 {
     using namespace Graphyte::Threading;
@@ -0,0 +1,227 @@
+#include <catch2/catch.hpp>
+#include <GxBase/Storage/ArchiveMemoryReader.hxx>
+#include <GxBase/Storage/ArchiveMemoryWriter.hxx>
+#include <GxGraphics/Graphics/ShaderLibrary.hxx>
+
+namespace
+{
+    std::vector<std::byte> MakeBytecode(std::string_view value) noexcept
+    {
+        auto const bytes = std::as_bytes(std::span{ value });
+        return { bytes.begin(), bytes.end() };
+    }
+
+    bool IsBytecode(Graphyte::Graphics::GpuShaderBytecode const& bytecode, std::string_view expected) noexcept
+    {
+        return bytecode.Size == expected.size() && std::memcmp(bytecode.Bytecode, expected.data(), expected.size()) == 0;
+    }
+}
+
+TEST_CASE("Shader library")
+{
+    using namespace Graphyte::Graphics;
+    using Graphyte::Status;
+
+    ShaderLibrary library{};
+    library.Platform = Graphyte::System::PlatformType::Linux;
+    library.Flags    = ShaderBytecodeFlags::Debug;
+
+    REQUIRE(library.SetDefines({ "SKINNING", "NORMAL_MAP", "ALPHA_TEST" }) == Status::Success);
+
+    SECTION("Permutation masks")
+    {
+        uint64_t permutation{};
+
+        std::array<std::string_view, 2> const known{ "ALPHA_TEST", "SKINNING" };
+        REQUIRE(library.GetPermutation(permutation, known));
+        REQUIRE(permutation == 0b101);
+
+        std::array<std::string_view, 1> const unknown{ "INSTANCING" };
+        REQUIRE_FALSE(library.GetPermutation(permutation, unknown));
+
+        REQUIRE(library.SetDefines(std::vector<std::string>(ShaderLibrary::MaxDefines + 1, "X")) == Status::InvalidArgument);
+    }
+
+    SECTION("Identical bytecode is stored once")
+    {
+        //
+        // Alpha test does not affect vertex shader.
+        //
+
+        REQUIRE(library.Add(0b000, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex, MakeBytecode("vs")) == Status::Success);
+        REQUIRE(library.Add(0b100, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex, MakeBytecode("vs")) == Status::Success);
+        REQUIRE(library.Add(0b001, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex, MakeBytecode("vs-skinned")) == Status::Success);
+        REQUIRE(library.Add(0b000, GpuRenderAPI::OpenGL, GpuShaderProfile::GLSL_4_50, GpuShaderStage::Vertex, MakeBytecode("vs")) == Status::Success);
+        REQUIRE(library.Add(0b000, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex, MakeBytecode("other")) == Status::AlreadyExists);
+
+        REQUIRE(library.GetEntries().size() == 4);
+        REQUIRE(library.GetBlobCount() == 2);
+        REQUIRE(library.GetBlobsSize() == 12);
+
+        auto const* plain   = library.Find(0b000, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex);
+        auto const* alpha   = library.Find(0b100, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex);
+        auto const* skinned = library.Find(0b001, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex);
+
+        REQUIRE(plain != nullptr);
+        REQUIRE(alpha != nullptr);
+        REQUIRE(skinned != nullptr);
+        REQUIRE(plain->Blob == alpha->Blob);
+        REQUIRE(plain->Blob != skinned->Blob);
+        REQUIRE(IsBytecode(library.GetBytecode(*skinned), "vs-skinned"));
+
+        REQUIRE(library.Find(0b010, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Vertex) == nullptr);
+        REQUIRE(library.Find(0b000, GpuRenderAPI::Vulkan, GpuShaderProfile::SPIRV_1_0, GpuShaderStage::Pixel) == nullptr);
+    }
+
+    SECTION("Saving and loading")
+    {
+        for (uint64_t permutation = 0; permutation < 8; ++permutation)
+        {
+            std::string const code = fmt::format("pixel shader {}", permutation & 0b011);
+            REQUIRE(library.Add(permutation, GpuRenderAPI::D3D12, GpuShaderProfile::D3DSM_6_0, GpuShaderStage::Pixel, MakeBytecode(code)) == Status::Success);
+        }
+
+        std::vector<std::byte> buffer{};
+        {
+            Graphyte::Storage::ArchiveMemoryWriter writer{ buffer };
+            writer << library;
+            REQUIRE_FALSE(writer.IsError());
+        }
+
+        ShaderLibrary loaded{};
+        {
+            Graphyte::Storage::ArchiveMemoryReader reader{ buffer };
+            reader << loaded;
+            REQUIRE_FALSE(reader.IsError());
+        }
+
+        REQUIRE(loaded.Platform == Graphyte::System::PlatformType::Linux);
+        REQUIRE(loaded.Flags == ShaderBytecodeFlags::Debug);
+        REQUIRE(loaded.GetDefines().size() == 3);
+        REQUIRE(loaded.GetDefines()[1] == "NORMAL_MAP");
+        REQUIRE(loaded.GetEntries().size() == 8);
+        REQUIRE(loaded.GetBlobCount() == 4);
+
+        for (uint64_t permutation = 0; permutation < 8; ++permutation)
+        {
+            auto const* entry = loaded.Find(permutation, GpuRenderAPI::D3D12, GpuShaderProfile::D3DSM_6_0, GpuShaderStage::Pixel);
+            REQUIRE(entry != nullptr);
+            REQUIRE(IsBytecode(loaded.GetBytecode(*entry), fmt::format("pixel shader {}", permutation & 0b011)));
+        }
+
+        //
+        // Blob index is restored, so loaded library deduplicates added bytecode.
+        //
+
+        REQUIRE(loaded.Add(0, GpuRenderAPI::D3D12, GpuShaderProfile::D3DSM_6_0, GpuShaderStage::Vertex, MakeBytecode("pixel shader 1")) == Status::Success);
+        REQUIRE(loaded.GetBlobCount() == 4);
+    }
+
+    SECTION("Loading corrupted library")
+    {
+        for (uint64_t permutation = 0; permutation < 4; ++permutation)
+        {
+            std::string const code = fmt::format("pixel shader {}", permutation);
+            REQUIRE(library.Add(permutation, GpuRenderAPI::D3D12, GpuShaderProfile::D3DSM_6_0, GpuShaderStage::Pixel, MakeBytecode(code)) == Status::Success);
+        }
+
+        std::vector<std::byte> buffer{};
+        {
+            Graphyte::Storage::ArchiveMemoryWriter writer{ buffer };
+            writer << library;
+            REQUIRE_FALSE(writer.IsError());
+        }
+
+        auto const load = [](std::vector<std::byte> const& content) {
+            ShaderLibrary loaded{};
+            Graphyte::Storage::ArchiveMemoryReader reader{ content };
+            reader << loaded;
+
+            REQUIRE(loaded.GetEntries().empty());
+            REQUIRE(loaded.GetDefines().empty());
+            REQUIRE(loaded.GetBlobCount() == 0);
+            return reader.IsError();
+        };
+
+        auto const write = [&](size_t offset, auto value) {
+            REQUIRE(offset + sizeof(value) <= buffer.size());
+            std::memcpy(buffer.data() + offset, &value, sizeof(value));
+        };
+
+        //
+        // Defines count is stored before first define, which is stored as length and characters.
+        //
+
+        auto const defines = std::search(buffer.begin(), buffer.end(), reinterpret_cast<const std::byte*>("SKINNING"), reinterpret_cast<const std::byte*>("SKINNING") + 8);
+        REQUIRE(defines != buffer.end());
+
+        size_t const defines_offset = static_cast<size_t>(defines - buffer.begin()) - 2 * sizeof(uint32_t);
+
+        //
+        // Compressed pool is stored last, preceded by its size and uncompressed pool size.
+        //
+
+        size_t compressed = 0;
+
+        for (size_t size = 0; size + sizeof(uint64_t) <= buffer.size(); ++size)
+        {
+            uint64_t value{};
+            std::memcpy(&value, buffer.data() + buffer.size() - size - sizeof(uint64_t), sizeof(value));
+
+            if (value == size)
+            {
+                compressed = size;
+                break;
+            }
+        }
+
+        REQUIRE(compressed != 0);
+
+        size_t const pool_size_offset = buffer.size() - compressed - 2 * sizeof(uint64_t);
+
+        SECTION("Truncated")
+        {
+            for (size_t size = 0; size < buffer.size(); ++size)
+            {
+                std::vector<std::byte> const truncated{ buffer.begin(), buffer.begin() + static_cast<ptrdiff_t>(size) };
+                REQUIRE(load(truncated));
+            }
+        }
+
+        SECTION("Invalid signature")
+        {
+            buffer[0] ^= std::byte{ 0xFF };
+            REQUIRE(load(buffer));
+        }
+
+        SECTION("Too many defines")
+        {
+            write(defines_offset, static_cast<uint32_t>(ShaderLibrary::MaxDefines + 1));
+            REQUIRE(load(buffer));
+        }
+
+        SECTION("Define longer than archive")
+        {
+            write(defines_offset + sizeof(uint32_t), uint32_t{ 0xFFFF'FFFF });
+            REQUIRE(load(buffer));
+        }
+
+        SECTION("Pool size exceeding compressed data")
+        {
+            write(pool_size_offset, uint64_t{ 1 } << 40);
+            REQUIRE(load(buffer));
+        }
+
+        SECTION("Pool size not matching compressed data")
+        {
+            write(pool_size_offset, uint64_t{ 8 });
+            REQUIRE(load(buffer));
+        }
+
+        SECTION("Corrupted bytecode")
+        {
+            buffer.back() ^= std::byte{ 0xFF };
+            REQUIRE(load(buffer));
+        }
+    }
+}